@@ -0,0 +1,108 @@
+#!/bin/bash
+# =============================================================================
+# HDC Kernel Benchmark Runner
+# =============================================================================
+# Usage: ./scripts/bench.sh [-o results.csv] [--compare baseline.csv]
+#                           [--tolerance PCT] [env ...]
+#
+# Runs test/test_bench in each PlatformIO environment (default:
+# bench_native bench_native_1024 bench_native_10000 bench_uno) and collects
+# the BENCH rows into one CSV:
+#
+#   kernel,dims,op,param,iters,total_ticks,latency_ticks,unit
+#
+# Units are CPU cycles for bench_uno (simavr, exact) and nanoseconds for
+# the native environments.
+#
+# With --compare, the per-call cost (total_ticks / iters) of every row is
+# checked against the matching row (kernel, dims, op, param, unit) of a
+# previous run; the script exits 1 if any case is slower by more than the
+# tolerance (default 10%, use a wider one for noisy hosts).
+# =============================================================================
+
+set -e
+
+# Navigate to project root
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_ROOT="$(dirname "$SCRIPT_DIR")"
+cd "$PROJECT_ROOT"
+
+OUTPUT="bench_results.csv"
+BASELINE=""
+TOLERANCE=10
+ENVS=()
+
+while [ $# -gt 0 ]; do
+    case "$1" in
+        -o|--output)  OUTPUT="$2"; shift 2 ;;
+        --compare)    BASELINE="$2"; shift 2 ;;
+        --tolerance)  TOLERANCE="$2"; shift 2 ;;
+        -h|--help)    sed -n '2,20p' "$0"; exit 0 ;;
+        *)            ENVS+=("$1"); shift ;;
+    esac
+done
+
+if [ ${#ENVS[@]} -eq 0 ]; then
+    ENVS=(bench_native bench_native_1024 bench_native_10000 bench_uno)
+fi
+
+echo "=============================================="
+echo "Running HDC Benchmarks"
+echo "=============================================="
+
+echo "kernel,dims,op,param,iters,total_ticks,latency_ticks,unit" > "$OUTPUT"
+
+for env in "${ENVS[@]}"; do
+    echo ""
+    echo "[$env]"
+    LOG="$(mktemp)"
+    if ! pio test -e "$env" -v > "$LOG" 2>&1; then
+        cat "$LOG"
+        rm -f "$LOG"
+        echo "Benchmark environment $env failed"
+        exit 1
+    fi
+    # Unity may prefix output lines with the test file location
+    grep -o 'BENCH,[^,]*,[0-9]*,.*' "$LOG" | grep -v '^BENCH,kernel,' \
+        | sed 's/^BENCH,//' | tr -d '\r' >> "$OUTPUT"
+    rm -f "$LOG"
+done
+
+ROWS=$(($(wc -l < "$OUTPUT") - 1))
+echo ""
+echo "$ROWS results written to $OUTPUT"
+
+if [ -z "$BASELINE" ]; then
+    exit 0
+fi
+
+echo ""
+echo "=============================================="
+echo "Comparing against $BASELINE (tolerance ${TOLERANCE}%)"
+echo "=============================================="
+
+awk -F, -v tol="$TOLERANCE" '
+    FNR == 1 { next }
+    NR == FNR {
+        base[$1 FS $2 FS $3 FS $4 FS $8] = $6 / $5
+        next
+    }
+    {
+        key = $1 FS $2 FS $3 FS $4 FS $8
+        if (!(key in base) || base[key] <= 0) {
+            next
+        }
+        cost = $6 / $5
+        change = (cost - base[key]) * 100.0 / base[key]
+        if (change > tol) {
+            printf "REGRESSION %s: %.2f -> %.2f %s/call (+%.1f%%)\n", \
+                   $1 "," $2 "," $3 "," $4, base[key], cost, $8, change
+            failed = 1
+        }
+        compared++
+    }
+    END {
+        printf "%d cases compared\n", compared
+        exit failed
+    }
+' "$BASELINE" "$OUTPUT"
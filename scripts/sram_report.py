@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""
+Static SRAM Usage per Module from the Linker Map
+
+Reads the GNU ld map of an AVR build (env:uno writes
+.pio/build/<env>/firmware.map) and sums the .data, .bss and .noinit input
+sections of every object file, so each module's share of the statics is
+known exactly. Whatever SRAM is left is the stack; its runtime high-water
+mark comes from hal_mem.h (HDC_TLM_MEMORY frames, see telemetry_decode.py).
+
+On AVR, .rodata is linked into .data (it is copied to SRAM), so constant
+tables that are not in PROGMEM show up here too.
+
+USAGE:
+    scripts/sram_report.py .pio/build/uno/firmware.map
+    scripts/sram_report.py --budget 1536 .pio/build/uno/firmware.map
+
+With --budget, the script exits 1 if the statics exceed BYTES.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+# Output sections that occupy SRAM
+SRAM_SECTIONS = (".data", ".bss", ".noinit")
+
+# Input section on one line:   .bss.s_tx_ring  0x0080012a  0x5 path/hal_uart.c.o
+INPUT_RE = re.compile(r"^ (\S+)\s+0x[0-9a-fA-F]+\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+# Long section names wrap: the address, size and file follow on the next line
+WRAPPED_NAME_RE = re.compile(r"^ (\S+)$")
+WRAPPED_REST_RE = re.compile(r"^\s+0x[0-9a-fA-F]+\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+
+
+def module_name(path):
+    """src/hal/hal_uart.c.o -> hal_uart.c, libc.a(strlen.o) -> libc.a(strlen.o)."""
+    name = os.path.basename(path.strip())
+    if name.endswith(".o") and "(" not in name:
+        name = name[:-2]
+    return name
+
+
+def parse_map(lines):
+    """Return {module: {section: bytes}} for the SRAM output sections."""
+    usage = {}
+    section = None
+    pending = None
+
+    for line in lines:
+        line = line.rstrip("\n")
+        if line and not line[0].isspace():
+            # Output section header (or any other top-level line)
+            name = line.split()[0]
+            section = name if name in SRAM_SECTIONS else None
+            pending = None
+            continue
+        if section is None:
+            continue
+
+        if pending is not None:
+            match = WRAPPED_REST_RE.match(line)
+            pending_name, pending = pending, None
+            if match:
+                add(usage, match.group(2), section, int(match.group(1), 16), pending_name)
+                continue
+
+        match = INPUT_RE.match(line)
+        if match:
+            add(usage, match.group(3), section, int(match.group(2), 16), match.group(1))
+            continue
+        match = WRAPPED_NAME_RE.match(line)
+        if match and not match.group(1).startswith("*"):
+            pending = match.group(1)
+
+    return usage
+
+
+def add(usage, path, section, size, input_name):
+    if size == 0 or input_name.startswith("*"):
+        return
+    module = usage.setdefault(module_name(path), {})
+    module[section] = module.get(section, 0) + size
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Static SRAM usage per module from a linker map")
+    parser.add_argument("map", help="linker map file (-Wl,-Map)")
+    parser.add_argument("--sram", type=int, default=2048, help="SRAM size in bytes (default 2048)")
+    parser.add_argument("--budget", type=int,
+                        help="fail if .data + .bss + .noinit exceed BYTES")
+    args = parser.parse_args()
+
+    with open(args.map, "r", errors="replace") as f:
+        usage = parse_map(f)
+
+    rows = sorted(usage.items(), key=lambda item: -sum(item[1].values()))
+    totals = {s: sum(m.get(s, 0) for _, m in rows) for s in SRAM_SECTIONS}
+    total = sum(totals.values())
+
+    print("%-28s %6s %6s %7s %6s" % ("module", "data", "bss", "noinit", "total"))
+    for name, sections in rows:
+        print("%-28s %6u %6u %7u %6u" % (name, sections.get(".data", 0), sections.get(".bss", 0),
+                                         sections.get(".noinit", 0), sum(sections.values())))
+    print("%-28s %6u %6u %7u %6u" % ("TOTAL", totals[".data"], totals[".bss"],
+                                     totals[".noinit"], total))
+    print("stack: %u of %u bytes SRAM left" % (max(args.sram - total, 0), args.sram))
+
+    if args.budget is not None and total > args.budget:
+        sys.stderr.write("static SRAM %u bytes exceeds the budget of %u\n" % (total, args.budget))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+"""
+Host Decoder for Binary HDC Telemetry Frames
+
+Decodes the framed protocol produced by src/hdc/hdc_telemetry.c:
+
+    SYNC(0xA5) | TYPE | LEN | payload (LEN bytes) | CRC-8
+
+CRC-8 uses polynomial 0x07, initial value 0, and covers TYPE, LEN and the
+payload. Multi-byte fields are little-endian. Bytes outside frames (such as
+the ASCII boot banner) are skipped while searching for SYNC.
+
+Record types:
+    0x01 SAMPLE  channel u8, value u16       (batched, 3 bytes each)
+    0x02 HV      offset u16, vector bytes    (one fragment per frame)
+    0x03 RESULT  class u16, distance u16     (batched, 4 bytes each)
+    0x04 PROBE   id u8, count u16, min/max/mean u32  (HDC_PROFILE builds)
+    0x05 MEMORY  region u8, used u16, unused u16      (batched, 5 bytes each)
+    0x06 SNAPSHOT class u8, planes u8, offset u16, image bytes  (one fragment
+                 per frame; merged by the gateway aggregator, gw_agg.h)
+
+Probe durations are CPU cycles on the Uno (divide by 16 for microseconds).
+
+USAGE:
+    scripts/telemetry_decode.py capture.bin
+    cat /dev/ttyACM0 | scripts/telemetry_decode.py -
+    scripts/telemetry_decode.py --port /dev/ttyACM0 --baud 9600   (needs pyserial)
+    scripts/telemetry_decode.py --hv-bytes 32 capture.bin         (256-bit HVs)
+    scripts/telemetry_decode.py --port /dev/ttyACM0 --probes      (request probe dump)
+"""
+
+import argparse
+import struct
+import sys
+
+SYNC = 0xA5
+TYPE_SAMPLE = 0x01
+TYPE_HV = 0x02
+TYPE_RESULT = 0x03
+TYPE_PROBE = 0x04
+TYPE_MEMORY = 0x05
+TYPE_SNAPSHOT = 0x06
+MAX_PAYLOAD = 250
+
+# hdc_probe_id_t order (src/hdc/hdc_probe.h)
+PROBE_NAMES = [
+    "hamming", "permute", "encode_multi", "encode_levels", "counter_add",
+    "am_query", "am_query_levels", "learn_update", "proto_refresh",
+    "adc_sample", "tlm_report",
+]
+
+# hdc_tlm_mem_region_t order (src/hdc/hdc_telemetry.h)
+MEMORY_REGIONS = ["data", "bss", "stack"]
+
+
+def crc8(data, crc=0):
+    """CRC-8, polynomial 0x07, MSB first (matches hdc_tlm_crc8)."""
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+class Decoder:
+    """Incremental frame decoder; feed() bytes, get (type, payload) tuples."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.crc_errors = 0
+        self.skipped = 0
+
+    def feed(self, data):
+        self.buffer.extend(data)
+        frames = []
+        while True:
+            start = self.buffer.find(bytes([SYNC]))
+            if start < 0:
+                self.skipped += len(self.buffer)
+                self.buffer.clear()
+                break
+            if start > 0:
+                self.skipped += start
+                del self.buffer[:start]
+            if len(self.buffer) < 3:
+                break
+            length = self.buffer[2]
+            if length > MAX_PAYLOAD:
+                # Not a real header; resynchronize after this SYNC byte
+                self.skipped += 1
+                del self.buffer[:1]
+                continue
+            total = 3 + length + 1
+            if len(self.buffer) < total:
+                break
+            frame = bytes(self.buffer[:total])
+            if crc8(frame[1:-1]) != frame[-1]:
+                self.crc_errors += 1
+                self.skipped += 1
+                del self.buffer[:1]
+                continue
+            del self.buffer[:total]
+            frames.append((frame[1], frame[3:-1]))
+        return frames
+
+
+class HvAssembler:
+    """Reassembles hypervector fragments by byte offset."""
+
+    def __init__(self, hv_bytes):
+        self.hv_bytes = hv_bytes
+        self.data = bytearray(hv_bytes)
+        self.filled = 0
+
+    def add(self, offset, chunk):
+        """Add a fragment; returns the complete vector or None."""
+        if offset == 0:
+            self.filled = 0
+        if offset != self.filled or offset + len(chunk) > self.hv_bytes:
+            # Out of order or lost fragment: drop the partial vector
+            self.filled = 0
+            return None
+        self.data[offset:offset + len(chunk)] = chunk
+        self.filled += len(chunk)
+        if self.filled == self.hv_bytes:
+            self.filled = 0
+            return bytes(self.data)
+        return None
+
+
+def print_frame(frame_type, payload, assembler, out):
+    if frame_type == TYPE_SAMPLE:
+        for i in range(0, len(payload) - 2, 3):
+            channel, value = struct.unpack_from("<BH", payload, i)
+            out.write("SAMPLE ch=%u value=%u\n" % (channel, value))
+    elif frame_type == TYPE_RESULT:
+        for i in range(0, len(payload) - 3, 4):
+            class_id, distance = struct.unpack_from("<HH", payload, i)
+            out.write("RESULT class=%u distance=%u\n" % (class_id, distance))
+    elif frame_type == TYPE_PROBE:
+        for i in range(0, len(payload) - 14, 15):
+            probe_id, count, low, high, mean = struct.unpack_from("<BHIII", payload, i)
+            name = PROBE_NAMES[probe_id] if probe_id < len(PROBE_NAMES) else "probe%u" % probe_id
+            out.write("PROBE %-16s count=%u min=%u max=%u mean=%u\n"
+                      % (name, count, low, high, mean))
+    elif frame_type == TYPE_MEMORY:
+        for i in range(0, len(payload) - 4, 5):
+            region, used, unused = struct.unpack_from("<BHH", payload, i)
+            name = MEMORY_REGIONS[region] if region < len(MEMORY_REGIONS) else "region%u" % region
+            out.write("MEMORY %-6s used=%u unused=%u\n" % (name, used, unused))
+    elif frame_type == TYPE_SNAPSHOT and len(payload) >= 4:
+        class_id, planes, offset = struct.unpack_from("<BBH", payload, 0)
+        out.write("SNAPSHOT class=%u planes=%u offset=%u bytes=%u\n"
+                  % (class_id, planes, offset, len(payload) - 4))
+    elif frame_type == TYPE_HV and len(payload) >= 2:
+        (offset,) = struct.unpack_from("<H", payload, 0)
+        hv = assembler.add(offset, payload[2:])
+        if hv is not None:
+            out.write("HV %s\n" % hv.hex().upper())
+    else:
+        out.write("UNKNOWN type=0x%02X len=%u\n" % (frame_type, len(payload)))
+
+
+def open_source(args):
+    if args.port:
+        try:
+            import serial
+        except ImportError:
+            sys.exit("--port needs pyserial (pip install pyserial)")
+        port = serial.Serial(args.port, args.baud, timeout=0.5)
+        if args.probes:
+            port.write(b"P")    # main.c command task: dump probe statistics
+        return lambda: port.read(256)
+    stream = sys.stdin.buffer if args.input == "-" else open(args.input, "rb")
+    return lambda: stream.read(256)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode binary HDC telemetry frames")
+    parser.add_argument("input", nargs="?", default="-", help="capture file, or - for stdin")
+    parser.add_argument("--port", help="serial port to read instead of a file")
+    parser.add_argument("--baud", type=int, default=9600, help="serial baud rate (default 9600)")
+    parser.add_argument("--probes", action="store_true",
+                        help="with --port, ask an HDC_PROFILE build for its probe statistics")
+    parser.add_argument("--hv-bytes", type=int, default=16,
+                        help="hypervector size in bytes, HV_DIMENSIONS / 8 (default 16)")
+    args = parser.parse_args()
+
+    read = open_source(args)
+    decoder = Decoder()
+    assembler = HvAssembler(args.hv_bytes)
+
+    try:
+        while True:
+            data = read()
+            if not data:
+                if args.port:
+                    continue
+                break
+            for frame_type, payload in decoder.feed(data):
+                print_frame(frame_type, payload, assembler, sys.stdout)
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+    sys.stderr.write("crc errors: %u, skipped bytes: %u\n" % (decoder.crc_errors, decoder.skipped))
+
+
+if __name__ == "__main__":
+    main()
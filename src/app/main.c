@@ -1,109 +1,561 @@
 /**
  * @file    main.c
- * @brief   Nano-Edge AI Project - ADC Demo with HAL
- * @version 2.0.0
+ * @brief   Nano-Edge AI Project - Scheduled Sense / Encode / Classify Loop
+ * @version 3.1.0
  * @note    Target: ATmega328P (Arduino Uno R3)
  *
- * @details This application demonstrates reading analog values via the
- *          Hardware Abstraction Layer (HAL) and displaying them over UART.
- *          All hardware access goes through the HAL for portability.
+ * @details The application runs as fixed-period tasks on the 1 kHz Timer2
+ *          tick (hal_timer.h) through the cooperative scheduler (sched.h):
+ *
+ *            Task     Period  Phase  Work
+ *            sample    10 ms   0 ms  Take the last scan frame, start the next
+ *            encode   200 ms  95 ms  Window averages -> levels -> query HVs
+ *            infer    200 ms  96 ms  Nearest class of each encoded window
+ *            learn    100 ms  97 ms  Retrain the labelled class on a mistake
+ *            report   500 ms  98 ms  Binary telemetry frames, LED heartbeat
+ *            snapshot 100 ms  50 ms  Class counters for gateway merging
+ *            store     10 ms   5 ms  Advance the EEPROM commit (<= 1 byte)
+ *
+ *          Samples are taken on the tick grid, so each 100 ms window always
+ *          holds the same 10 equally spaced samples. Each sample run starts
+ *          a quiet one-shot ADC scan of every channel (hal_adc.h) and takes
+ *          the frame the previous run started, so no run waits for a
+ *          conversion and all channels of a sample come from one scan. The
+ *          scan converts while the main loop sleeps (see below).
+ *
+ *          Windows flow through a sample pipeline (hdc_pipe.h): every
+ *          APP_WINDOW_SAMPLES frames close one window, and the encode and
+ *          infer tasks each take up to APP_PIPE_BATCH windows per run, so a
+ *          window is classified within two window periods of closing and
+ *          each stage pays its setup once per batch. The learn task
+ *          consumes every classified window. If it falls APP_PIPE_DEPTH
+ *          windows behind, new windows are dropped rather than queued.
+ *
+ *          The label comes from GPIO_PIN_LABEL (D2, active low) and is read
+ *          with each frame, so a window keeps the label it was sampled
+ *          under: released trains class 0, held trains class 1. Inference
+ *          starts once both classes have data. Until then every query is
+ *          bundled into its class; after that the learn task retrains only
+ *          when the infer task got the label wrong:
+ *          the query is added to the labelled class and subtracted from the
+ *          predicted one (hdc_learn.h). Updates only mark the counter words
+ *          they changed (hdc_proto.h): the next inference re-thresholds
+ *          those words of the prototypes, and only the store blocks they
+ *          fall in are marked for the next commit, so learning never
+ *          rebuilds or rewrites a whole class.
+ *          Channel basis vectors are regenerated from APP_ITEM_SEED while
+ *          encoding (hdc_item.h), so they take no SRAM and a gateway can
+ *          reproduce the encoding from the seed alone. Levels come from
+ *          app_level(), generated for ADC_MAX by hdc_encode_fixed.h, so no
+ *          sample goes through a 32-bit divide.
+ *
+ *          The bundling counters and the trained-class mask persist in
+ *          EEPROM (hdc_store.h). At boot, the newest valid slot is loaded
+ *          and the first inference rebuilds the class prototypes from it,
+ *          so learning survives resets and brownouts. A commit starts every
+ *          APP_COMMIT_PERIOD_MS. The store task then writes at most one
+ *          changed byte per run while earlier writes program in the
+ *          background.
+ *
+ *          Every APP_MEMORY_REPORTS reports, an HDC_TLM_MEMORY frame carries
+ *          the static SRAM sizes and the stack high-water mark (hal_mem.h),
+ *          so a model change that eats into the stack headroom shows up
+ *          before it corrupts anything.
+ *
+ *          Every APP_SNAPSHOT_RUNS snapshot runs, the counters of the next
+ *          trained class go out as HDC_TLM_SNAPSHOT frames, so a gateway
+ *          can merge the models of many devices (src/gateway/gw_agg.h).
+ *          All fragments are queued in one run, once the TX ring has room
+ *          for them, so learning never tears an image.
+ *
+ *          HDC_PROFILE builds (env:uno_profile) add a command task: the host
+ *          sends 'P' to receive HDC_TLM_PROBE frames with the hdc_probe.h
+ *          statistics, or 'R' to clear them.
+ *
+ *          When no task is due the CPU sleeps until the next interrupt
+ *          (hal_power_sleep()): in ADC noise reduction mode while a scan
+ *          conversion is waiting and the UART is idle, otherwise in idle
+ *          mode. The boot banner is sent blocking as
+ *          ASCII; telemetry frames (hdc_telemetry.h) are queued with
+ *          hal_uart_write_nb() and decoded by scripts/telemetry_decode.py.
  */
 
 #include <stdint.h>
-#include <util/delay.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <avr/interrupt.h>
 
 #include "hal/hal.h"
+#include "hal/hal_power.h"
+#include "hal/hal_eeprom.h"
+#include "hal/hal_mem.h"
+#include "hdc/hdc.h"
+#include "hdc/hdc_encode_fixed.h"
+#include "sched.h"
+
+/* =============================================================================
+ * Configuration
+ * ========================================================================== */
+
+/** @brief Task periods and phase offsets in ms (see file header) */
+#define SAMPLE_PERIOD_MS    10U
+#define WINDOW_PERIOD_MS    100U
+#define BATCH_PERIOD_MS     200U
+#define REPORT_PERIOD_MS    500U
+#define ENCODE_PHASE_MS     95U
+#define INFER_PHASE_MS      96U
+#define LEARN_PHASE_MS      97U
+#define REPORT_PHASE_MS     98U
+#define COMMAND_PERIOD_MS   50U
+#define STORE_PERIOD_MS     10U
+#define STORE_PHASE_MS      5U
+#define SNAPSHOT_PHASE_MS   50U
+
+/** @brief Report runs per SRAM usage frame (5 s) */
+#define APP_MEMORY_REPORTS  10U
+
+/** @brief Send one class snapshot every this many snapshot runs (2 s) */
+#define APP_SNAPSHOT_RUNS   20U
+
+/** @brief TX ring bytes one counter snapshot takes (every fragment, framed) */
+#define APP_SNAPSHOT_IMAGE      (HDC_COUNTER_PLANES * HV_BYTES)
+#define APP_SNAPSHOT_CHUNK      (HDC_TLM_MAX_PAYLOAD - HDC_TLM_SNAPSHOT_HEADER_BYTES)
+#define APP_SNAPSHOT_FRAMES     ((APP_SNAPSHOT_IMAGE + APP_SNAPSHOT_CHUNK - 1U) / APP_SNAPSHOT_CHUNK)
+#define APP_SNAPSHOT_TX_BYTES   (APP_SNAPSHOT_IMAGE + (APP_SNAPSHOT_FRAMES * \
+                                 (HDC_TLM_HEADER_BYTES + HDC_TLM_SNAPSHOT_HEADER_BYTES + 1U)))
+
+#if APP_SNAPSHOT_TX_BYTES > UART_TX_BUFFER_SIZE
+#error "main.c: a class snapshot does not fit the UART TX ring"
+#endif
+
+/** @brief Sensor channels encoded per window */
+#define APP_NUM_CHANNELS    2U
+
+/** @brief Pipeline: frames per window, windows per encode/infer run, and
+ *         ring slots (a power of two of at least two batches) */
+#define APP_WINDOW_SAMPLES  (WINDOW_PERIOD_MS / SAMPLE_PERIOD_MS)
+#define APP_PIPE_BATCH      (BATCH_PERIOD_MS / WINDOW_PERIOD_MS)
+#define APP_PIPE_DEPTH      4U
+
+#if (APP_NUM_CHANNELS > HDC_PIPE_MAX_CHANNELS) || (APP_NUM_CHANNELS > HAL_FRAME_MAX_VALUES)
+#error "main.c: APP_NUM_CHANNELS exceeds a pipeline window or a scan frame"
+#endif
+
+#if APP_PIPE_DEPTH < (2U * APP_PIPE_BATCH)
+#error "main.c: APP_PIPE_DEPTH must hold a batch in flight and the next one"
+#endif
+
+/** @brief Item memory seed: channel basis vectors are generated from it */
+#define APP_ITEM_SEED       0x4E414E4FUL    /* "NANO" */
+
+/** @brief Classes learned from the label input */
+#define APP_NUM_CLASSES     2U
+
+/** @brief Model persistence: start a commit this often (sched.h periods are
+ *         limited to SCHED_MAX_PERIOD, so the store task counts its runs) */
+#define APP_COMMIT_PERIOD_MS    60000UL
+#define APP_COMMIT_RUNS         ((uint16_t)(APP_COMMIT_PERIOD_MS / STORE_PERIOD_MS))
+
+/** @brief EEPROM layout of the persisted model (bump APP_STORE_SCHEMA when
+ *         app_model_t changes) */
+#define APP_STORE_BASE      0U
+#define APP_STORE_SLOTS     4U
+#define APP_STORE_SCHEMA    1U
+
+/** @brief Label input (internal pull-up, low = class 1) */
+#define GPIO_PIN_LABEL      GPIO_PIN_D2
+
+/** @brief Thermometer level of an ADC average (reciprocal multiply, no divide) */
+HDC_ENCODE_DEFINE_LEVEL(app_level, ADC_MAX)
+
+/* =============================================================================
+ * Application State
+ * ========================================================================== */
+
+/** @brief Persisted part of the model; prototypes are rebuilt from it */
+typedef struct {
+    hdc_counter_t counters[APP_NUM_CLASSES];
+    uint8_t trained_mask;
+} app_model_t;
+
+static const adc_channel_t s_channels[APP_NUM_CHANNELS] = {ADC_CHANNEL_0, ADC_CHANNEL_1};
+
+/** @brief Scan mask of s_channels (ascending, so frame order = s_channels order) */
+#define APP_SCAN_MASK       (ADC_SCAN_MASK(ADC_CHANNEL_0) | ADC_SCAN_MASK(ADC_CHANNEL_1))
+
+static sched_t s_sched;
+
+/* Pipeline */
+static uint16_t s_pipe_values[APP_PIPE_DEPTH * APP_NUM_CHANNELS];
+static hv_t s_pipe_queries[APP_PIPE_DEPTH];
+static hdc_am_match_t s_pipe_matches[APP_PIPE_DEPTH];
+static uint8_t s_pipe_labels[APP_PIPE_DEPTH];
+static hdc_pipe_t s_pipe;
+static uint16_t s_averages[APP_NUM_CHANNELS];
+
+/* Model */
+static hv_t s_class_storage[APP_NUM_CLASSES];
+static hdc_am_t s_am;
+static app_model_t s_model;
+static hdc_am_match_t s_match;
+static bool s_match_valid;
+static hdc_counter_mask_t s_stale[APP_NUM_CLASSES];
+static hdc_counter_mask_t s_unsaved[APP_NUM_CLASSES];
+static hdc_proto_t s_proto;
+static hdc_learn_t s_learn;
+
+/* Persistence */
+static const hdc_store_io_t s_eeprom_io = {hal_eeprom_read, hal_eeprom_write, hal_eeprom_busy};
+static hdc_store_t s_store;
+static bool s_store_ready;
+static uint16_t s_store_runs;
+
+/* Report */
+static uint8_t s_report_runs;
+
+/* Snapshot */
+static uint8_t s_snapshot_runs;
+static uint8_t s_snapshot_class;
+
+/* =============================================================================
+ * Initialization
+ * ========================================================================== */
+
+/**
+ * @brief   Model from EEPROM, or an empty one: one row per class
+ *
+ * @details The prototype cache starts with every word stale, so the first
+ *          inference rebuilds a loaded model from its counters.
+ *          Untrained classes have tie counters, which threshold to zero.
+ *          Without a loaded model the counters are reset and the whole
+ *          image is marked for the first commit.
+ */
+static void init_model(void)
+{
+    hv_t row;
+
+    s_store_ready = (hdc_store_init(&s_store, &s_eeprom_io, APP_STORE_BASE, APP_STORE_SLOTS,
+                                    (uint8_t*)&s_model, (uint16_t)sizeof(s_model),
+                                    APP_STORE_SCHEMA) == HDC_STORE_OK);
+    bool restored = s_store_ready && (hdc_store_load(&s_store) == HDC_STORE_OK);
+
+    if (!restored) {
+        for (uint8_t c = 0U; c < APP_NUM_CLASSES; c++) {
+            hdc_counter_reset(&s_model.counters[c]);
+        }
+        s_model.trained_mask = 0U;
+    }
+
+    hdc_am_init(&s_am, s_class_storage, APP_NUM_CLASSES);
+    hdc_clear(row);
+    for (uint8_t c = 0U; c < APP_NUM_CLASSES; c++) {
+        (void)hdc_am_add(&s_am, row, NULL);
+    }
+    (void)hdc_proto_init(&s_proto, &s_am, s_model.counters, s_stale, s_unsaved, NULL);
+    hdc_learn_init(&s_learn, &s_proto);
+}
+
+/**
+ * @brief   Empty pipeline over the static slot storage
+ */
+static void init_pipeline(void)
+{
+    hdc_pipe_config_t config;
+
+    config.values = s_pipe_values;
+    config.queries = s_pipe_queries;
+    config.matches = s_pipe_matches;
+    config.tags = s_pipe_labels;
+    config.level = app_level;
+    config.item_seed = APP_ITEM_SEED;
+    config.depth = APP_PIPE_DEPTH;
+    config.batch = APP_PIPE_BATCH;
+    config.num_channels = APP_NUM_CHANNELS;
+    config.window = APP_WINDOW_SAMPLES;
+    (void)hdc_pipe_init(&s_pipe, &config);
+}
+
+/* =============================================================================
+ * Tasks
+ * ========================================================================== */
+
+/**
+ * @brief   Sample: add the frame scanned since the last run to the pipeline
+ * @note    The frame is read in place; the next one-shot scan starts after
+ *          it is released
+ */
+static void task_sample(void)
+{
+    HDC_PROBE_BEGIN(HDC_PROBE_ADC_SAMPLE);
+    const hal_frame_t* frame = hal_adc_scan_acquire();
+    if ((frame != NULL) && (frame->count == APP_NUM_CHANNELS)) {
+        uint8_t label = (hal_gpio_read(GPIO_PIN_LABEL) == GPIO_STATE_LOW) ? 1U : 0U;
+        (void)hdc_pipe_put(&s_pipe, frame->values, frame->count, label);
+    }
+    hal_adc_scan_release();
+    (void)hal_adc_scan_start(APP_SCAN_MASK, ADC_SCAN_QUIET_ONE_SHOT);
+    HDC_PROBE_END(HDC_PROBE_ADC_SAMPLE);
+}
+
+/**
+ * @brief   Encode: query hypervectors of the windows closed since the last run
+ */
+static void task_encode(void)
+{
+    (void)hdc_pipe_encode(&s_pipe);
+}
+
+/**
+ * @brief   Infer: nearest class of each encoded window
+ * @note    Windows encoded before both classes have data pass on
+ *          unclassified
+ */
+static void task_infer(void)
+{
+    const uint8_t all_classes = (uint8_t)((1U << APP_NUM_CLASSES) - 1U);
+
+    if (s_model.trained_mask == all_classes) {
+        (void)hdc_proto_refresh(&s_proto);
+        (void)hdc_pipe_classify(&s_pipe, &s_am);
+    } else {
+        (void)hdc_pipe_classify(&s_pipe, NULL);
+    }
+}
+
+/**
+ * @brief   Learn: retrain on each classified window and the label it was
+ *          sampled under
+ *
+ * @details The prediction is the infer task's result for the window, or
+ *          none while a class is untrained (the query is then only added).
+ *          A correct prediction changes nothing. The newest window's
+ *          averages and result are kept for the report task.
+ */
+static void task_learn(void)
+{
+    hdc_pipe_result_t result;
+    bool updated = false;
+
+    while (hdc_pipe_peek(&s_pipe, &result)) {
+        hdc_class_t label = result.tag;
+        hdc_class_t predicted = result.match.class_id;
+
+        for (uint8_t ch = 0U; ch < APP_NUM_CHANNELS; ch++) {
+            s_averages[ch] = result.values[ch];
+        }
+        s_match = result.match;
+        s_match_valid = (predicted != (hdc_class_t)HDC_AM_CLASS_NONE);
+
+        if ((predicted != label) &&
+            (hdc_learn_update(&s_learn, result.query, label, predicted) == HDC_LEARN_OK)) {
+            s_model.trained_mask |= (uint8_t)(1U << label);
+            updated = true;
+        }
+        (void)hdc_pipe_release(&s_pipe);
+    }
+
+    if (updated && s_store_ready) {
+        (void)hdc_proto_persist(&s_proto, &s_store, (uint16_t)offsetof(app_model_t, counters));
+        hdc_store_mark(&s_store, (uint16_t)offsetof(app_model_t, trained_mask), 1U);
+    }
+}
+
+/**
+ * @brief   Store: start a commit every APP_COMMIT_PERIOD_MS and advance it
+ * @note    Each run starts at most one EEPROM write and never waits for one
+ */
+static void task_store(void)
+{
+    if (!s_store_ready) {
+        return;
+    }
+
+    s_store_runs++;
+    if (s_store_runs >= APP_COMMIT_RUNS) {
+        s_store_runs = 0U;
+        (void)hdc_store_commit(&s_store);
+    }
+    (void)hdc_store_step(&s_store);
+}
 
 /**
- * @brief   Print a visual bar graph representation of a value
- * @param   value   ADC value (0-1023)
- * @param   max_val Maximum value for scaling (typically 1024)
- * @pre     hal_uart_init() must be called first
+ * @brief   Report: queue window averages, the latest result and, every
+ *          APP_MEMORY_REPORTS runs, SRAM usage (never blocks)
  */
-static void print_bar_graph(uint16_t value, uint16_t max_val)
+static void task_report(void)
 {
-    const uint8_t BAR_WIDTH = 32U;
-    uint8_t bars = (uint8_t)(((uint32_t)value * BAR_WIDTH) / max_val);
+    hdc_tlm_frame_t frame;
+
+    (void)hal_gpio_toggle(GPIO_PIN_LED);
+
+    HDC_PROBE_BEGIN(HDC_PROBE_TLM_REPORT);
+    hdc_tlm_begin(&frame, HDC_TLM_SAMPLE);
+    for (uint8_t ch = 0U; ch < APP_NUM_CHANNELS; ch++) {
+        (void)hdc_tlm_add_sample(&frame, s_channels[ch], s_averages[ch]);
+    }
+    uint8_t len = hdc_tlm_finish(&frame);
+    (void)hal_uart_write_nb(frame.bytes, len);
+
+    if (s_match_valid) {
+        hdc_tlm_begin(&frame, HDC_TLM_RESULT);
+        (void)hdc_tlm_add_result(&frame, s_match.class_id, s_match.distance);
+        len = hdc_tlm_finish(&frame);
+        (void)hal_uart_write_nb(frame.bytes, len);
+    }
+    HDC_PROBE_END(HDC_PROBE_TLM_REPORT);
+
+    s_report_runs++;
+    if (s_report_runs >= APP_MEMORY_REPORTS) {
+        hal_mem_usage_t usage;
 
-    hal_uart_putc('[');
-    for (uint8_t i = 0U; i < BAR_WIDTH; i++) {
-        hal_uart_putc((i < bars) ? '#' : ' ');
+        s_report_runs = 0U;
+        hal_mem_usage(&usage);
+        hdc_tlm_begin(&frame, HDC_TLM_MEMORY);
+        (void)hdc_tlm_add_memory(&frame, HDC_TLM_MEM_DATA, usage.data_bytes, 0U);
+        (void)hdc_tlm_add_memory(&frame, HDC_TLM_MEM_BSS, usage.bss_bytes, 0U);
+        (void)hdc_tlm_add_memory(&frame, HDC_TLM_MEM_STACK, usage.stack_peak,
+                                 (uint16_t)(usage.stack_bytes - usage.stack_peak));
+        len = hdc_tlm_finish(&frame);
+        (void)hal_uart_write_nb(frame.bytes, len);
     }
-    hal_uart_putc(']');
 }
 
 /**
- * @brief   Print a number with right-alignment padding
- * @param   value   Value to print
- * @param   width   Minimum field width (pads with spaces)
- * @pre     hal_uart_init() must be called first
+ * @brief   Snapshot: the next trained class's counters, every
+ *          APP_SNAPSHOT_RUNS runs
+ * @note    Waits (retrying each run) until the TX ring can take the whole
+ *          image, so every fragment is queued before the next learn run
  */
-static void print_padded_u16(uint16_t value, uint8_t width)
+static void task_snapshot(void)
 {
-    uint8_t digits = 1U;
-    uint16_t temp = value;
+    hdc_tlm_frame_t frame;
 
-    while (temp >= 10U) {
-        temp /= 10U;
-        digits++;
+    if (s_snapshot_runs < APP_SNAPSHOT_RUNS) {
+        s_snapshot_runs++;
+        return;
+    }
+    if ((s_model.trained_mask == 0U) || (hal_uart_tx_free() < APP_SNAPSHOT_TX_BYTES)) {
+        return;
+    }
+
+    while ((s_model.trained_mask & (1U << s_snapshot_class)) == 0U) {
+        s_snapshot_class = (uint8_t)((s_snapshot_class + 1U) % APP_NUM_CLASSES);
     }
 
-    while (digits < width) {
-        hal_uart_putc(' ');
-        digits++;
+    const uint8_t* image = (const uint8_t*)&s_model.counters[s_snapshot_class];
+    uint16_t offset = 0U;
+    while (offset < APP_SNAPSHOT_IMAGE) {
+        offset = hdc_tlm_snapshot_fragment(&frame, s_snapshot_class, HDC_COUNTER_PLANES, image, offset);
+        uint8_t len = hdc_tlm_finish(&frame);
+        (void)hal_uart_write_nb(frame.bytes, len);
     }
 
-    hal_uart_print_u16(value);
+    s_snapshot_class = (uint8_t)((s_snapshot_class + 1U) % APP_NUM_CLASSES);
+    s_snapshot_runs = 0U;
 }
 
+#if HDC_PROBE_ENABLED
+/** @brief Next probe to send; HDC_PROBE_COUNT when no dump is in progress */
+static uint8_t s_probe_next = (uint8_t)HDC_PROBE_COUNT;
+
+/**
+ * @brief   Command: 'P' dumps probe statistics, 'R' clears them
+ * @note    The dump is sent one frame per run, retried while the TX ring is
+ *          too full, so it never overruns the report frames
+ */
+static void task_command(void)
+{
+    hdc_tlm_frame_t frame;
+
+    if (hal_uart_rx_available()) {
+        uint8_t command = hal_uart_getc();
+        if (command == (uint8_t)'R') {
+            hdc_probe_reset();
+        } else if (command == (uint8_t)'P') {
+            s_probe_next = 0U;
+        } else {
+            /* Unknown command: ignored */
+        }
+    }
+
+    if (s_probe_next < (uint8_t)HDC_PROBE_COUNT) {
+        uint8_t first = s_probe_next;
+
+        hdc_tlm_begin(&frame, HDC_TLM_PROBE);
+        while ((s_probe_next < (uint8_t)HDC_PROBE_COUNT) &&
+               (hdc_tlm_add_probe(&frame, (hdc_probe_id_t)s_probe_next,
+                                  hdc_probe_get((hdc_probe_id_t)s_probe_next)) == HDC_TLM_OK)) {
+            s_probe_next++;
+        }
+        uint8_t len = hdc_tlm_finish(&frame);
+        if (hal_uart_write_nb(frame.bytes, len) != UART_OK) {
+            s_probe_next = first;
+        }
+    }
+}
+#endif
+
+/* =============================================================================
+ * Entry Point
+ * ========================================================================== */
+
 /**
  * @brief   Application entry point
  * @return  int (never returns in embedded)
  */
 int main(void)
 {
-    /* Initialize all HAL modules */
+    /* Initialize all HAL modules (the system tick starts with sei()) */
     hal_init();
 
-    /* Configure LED pin as output */
     hal_gpio_set_direction(GPIO_PIN_LED, GPIO_DIR_OUTPUT);
+    hal_gpio_set_direction(GPIO_PIN_LABEL, GPIO_DIR_INPUT);
+    (void)hal_gpio_set_pullup(GPIO_PIN_LABEL, true);
 
     /* Print startup banner */
     hal_uart_newline();
     hal_uart_puts("========================================\r\n");
-    hal_uart_puts("Nano-Edge AI Project v2.0\r\n");
-    hal_uart_puts("ADC Demo - Using HAL Layer\r\n");
+    hal_uart_puts("Nano-Edge AI Project v3.1\r\n");
+    hal_uart_puts("Scheduled HDC - binary telemetry follows\r\n");
     hal_uart_puts("========================================\r\n");
     hal_uart_newline();
 
-    uint16_t count = 0U;
+    init_model();
+    init_pipeline();
+
+    /* Telemetry from here on is interrupt-driven */
+    hal_uart_async_enable();
+    sei();
+
+#if HDC_PROBE_ENABLED
+    hdc_probe_init();
+#endif
+
+    uint16_t start = (uint16_t)hal_timer_millis();
+
+    sched_init(&s_sched);
+    (void)sched_add(&s_sched, task_sample, SAMPLE_PERIOD_MS, start);
+    (void)sched_add(&s_sched, task_encode, BATCH_PERIOD_MS, (uint16_t)(start + ENCODE_PHASE_MS));
+    (void)sched_add(&s_sched, task_infer, BATCH_PERIOD_MS, (uint16_t)(start + INFER_PHASE_MS));
+    (void)sched_add(&s_sched, task_learn, WINDOW_PERIOD_MS, (uint16_t)(start + LEARN_PHASE_MS));
+    (void)sched_add(&s_sched, task_report, REPORT_PERIOD_MS, (uint16_t)(start + REPORT_PHASE_MS));
+    (void)sched_add(&s_sched, task_store, STORE_PERIOD_MS, (uint16_t)(start + STORE_PHASE_MS));
+    (void)sched_add(&s_sched, task_snapshot, WINDOW_PERIOD_MS, (uint16_t)(start + SNAPSHOT_PHASE_MS));
+#if HDC_PROBE_ENABLED
+    (void)sched_add(&s_sched, task_command, COMMAND_PERIOD_MS, start);
+#endif
 
-    /* Main application loop */
     while (1) {
-        /* Toggle LED to show activity */
-        (void)hal_gpio_toggle(GPIO_PIN_LED);
-
-        /* Read ADC with averaging for stability */
-        uint16_t raw = hal_adc_read_averaged(ADC_CHANNEL_0, 4U);
-        uint16_t mv = hal_adc_to_millivolts(raw);
-
-        count++;
-
-        /* Print formatted output */
-        hal_uart_putc('#');
-        print_padded_u16(count, 4U);
-        hal_uart_puts("  Raw:");
-        print_padded_u16(raw, 4U);
-        hal_uart_puts("  (");
-        print_padded_u16(mv, 4U);
-        hal_uart_puts("mV)  ");
-        print_bar_graph(raw, 1024U);
-        hal_uart_newline();
-
-        /* Variable delay based on ADC reading */
-        uint16_t delay = 100U + (raw / 4U);
-        for (uint16_t i = 0U; i < delay; i++) {
-            _delay_ms(1);
+        uint16_t now = (uint16_t)hal_timer_millis();
+
+        if (sched_run(&s_sched, now) == 0U) {
+            /* Nothing is due before the next tick; sleep unless it just came */
+            cli();
+            if ((uint16_t)hal_timer_millis() == now) {
+                hal_power_sleep();
+            } else {
+                sei();
+            }
         }
     }
 
@@ -0,0 +1,111 @@
+/**
+ * @file    sched.c
+ * @brief   Cooperative Fixed-Period Task Scheduler - Implementation
+ * @version 1.0.0
+ */
+
+#include <stddef.h>
+
+#include "sched.h"
+
+/* =============================================================================
+ * Private Helpers
+ * ========================================================================== */
+
+/**
+ * @brief   Whether tick has been reached (modulo 2^16)
+ * @param   now Current tick
+ * @param   tick Release tick
+ * @return  true if now is at or after tick
+ */
+static bool sched_reached(uint16_t now, uint16_t tick)
+{
+    return (uint16_t)(now - tick) <= SCHED_MAX_PERIOD;
+}
+
+/* =============================================================================
+ * Scheduler API
+ * ========================================================================== */
+
+/**
+ * @brief   Initialize an empty scheduler
+ * @param   sched Scheduler
+ */
+void sched_init(sched_t* sched)
+{
+    sched->count = 0U;
+}
+
+/**
+ * @brief   Register a periodic task
+ * @param   sched Scheduler
+ * @param   fn Task body
+ * @param   period Release period in ticks (1 to SCHED_MAX_PERIOD)
+ * @param   first Tick of the first release (sets the task's phase)
+ * @return  SCHED_OK, SCHED_ERROR_FULL, or SCHED_ERROR_INVALID
+ */
+sched_status_t sched_add(sched_t* sched, sched_task_fn_t fn, uint16_t period, uint16_t first)
+{
+    if ((fn == NULL) || (period == 0U) || (period > SCHED_MAX_PERIOD)) {
+        return SCHED_ERROR_INVALID;
+    }
+    if (sched->count >= SCHED_MAX_TASKS) {
+        return SCHED_ERROR_FULL;
+    }
+
+    sched_task_t* task = &sched->tasks[sched->count];
+    task->fn = fn;
+    task->period = period;
+    task->due = first;
+    task->missed = 0U;
+    sched->count++;
+    return SCHED_OK;
+}
+
+/**
+ * @brief   Run every task released at or before now
+ * @param   sched Scheduler
+ * @param   now Current tick
+ * @return  Number of tasks run; 0 means nothing is due before the next tick
+ */
+uint8_t sched_run(sched_t* sched, uint16_t now)
+{
+    uint8_t ran = 0U;
+
+    for (uint8_t i = 0U; i < sched->count; i++) {
+        sched_task_t* task = &sched->tasks[i];
+
+        if (!sched_reached(now, task->due)) {
+            continue;
+        }
+
+        task->fn();
+        ran++;
+
+        /* Next release on the grid; skip releases that are already over */
+        task->due = (uint16_t)(task->due + task->period);
+        while (sched_reached(now, task->due)) {
+            task->due = (uint16_t)(task->due + task->period);
+            if (task->missed != 0xFFFFU) {
+                task->missed++;
+            }
+        }
+    }
+    return ran;
+}
+
+/**
+ * @brief   Whether any task is released at or before now
+ * @param   sched Scheduler
+ * @param   now Current tick
+ * @return  true if sched_run() would run a task
+ */
+bool sched_pending(const sched_t* sched, uint16_t now)
+{
+    for (uint8_t i = 0U; i < sched->count; i++) {
+        if (sched_reached(now, sched->tasks[i].due)) {
+            return true;
+        }
+    }
+    return false;
+}
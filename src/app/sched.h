@@ -0,0 +1,103 @@
+/**
+ * @file    sched.h
+ * @brief   Cooperative Fixed-Period Task Scheduler
+ * @version 1.0.0
+ * @note    Portable: time comes from the caller (hal_timer_millis() on AVR)
+ *
+ * @details Each task has a period and a release time on a fixed grid. A
+ *          task released at tick t is next released at t + period, not at
+ *          "when it finished + period", so periods do not drift with the
+ *          run time of other tasks or with UART traffic.
+ *
+ *          sched_run() runs every released task once, in registration order
+ *          (register the most time-critical task first). A task that falls
+ *          more than a full period behind skips the releases it missed and
+ *          stays on its grid; the skips are counted in sched_task_t.missed.
+ *
+ *          Ticks are 16-bit and compared modulo 2^16, so periods and phase
+ *          offsets must stay below 32768 ticks.
+ */
+
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =============================================================================
+ * Constants
+ * ========================================================================== */
+
+/** @brief Task table size */
+#ifndef SCHED_MAX_TASKS
+#define SCHED_MAX_TASKS     8U
+#endif
+
+/** @brief Longest period / phase offset in ticks */
+#define SCHED_MAX_PERIOD    0x7FFFU
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Task body; runs to completion */
+typedef void (*sched_task_fn_t)(void);
+
+/** @brief Scheduler status codes */
+typedef enum {
+    SCHED_OK = 0,
+    SCHED_ERROR_FULL,
+    SCHED_ERROR_INVALID
+} sched_status_t;
+
+/** @brief One periodic task */
+typedef struct {
+    sched_task_fn_t fn;     /**< Task body */
+    uint16_t period;        /**< Release period in ticks */
+    uint16_t due;           /**< Tick of the next release */
+    uint16_t missed;        /**< Releases skipped while late (saturates) */
+} sched_task_t;
+
+/** @brief Task table */
+typedef struct {
+    sched_task_t tasks[SCHED_MAX_TASKS];
+    uint8_t count;
+} sched_t;
+
+/* =============================================================================
+ * Function Declarations
+ * ========================================================================== */
+
+/**
+ * @brief   Initialize an empty scheduler
+ * @param   sched Scheduler
+ */
+void sched_init(sched_t* sched);
+
+/**
+ * @brief   Register a periodic task
+ * @param   sched Scheduler
+ * @param   fn Task body
+ * @param   period Release period in ticks (1 to SCHED_MAX_PERIOD)
+ * @param   first Tick of the first release (sets the task's phase)
+ * @return  SCHED_OK, SCHED_ERROR_FULL, or SCHED_ERROR_INVALID
+ */
+sched_status_t sched_add(sched_t* sched, sched_task_fn_t fn, uint16_t period, uint16_t first);
+
+/**
+ * @brief   Run every task released at or before now
+ * @param   sched Scheduler
+ * @param   now Current tick
+ * @return  Number of tasks run; 0 means nothing is due before the next tick
+ */
+uint8_t sched_run(sched_t* sched, uint16_t now);
+
+/**
+ * @brief   Whether any task is released at or before now
+ * @param   sched Scheduler
+ * @param   now Current tick
+ * @return  true if sched_run() would run a task
+ */
+bool sched_pending(const sched_t* sched, uint16_t now);
+
+#endif /* SCHED_H */
@@ -0,0 +1,481 @@
+/**
+ * @file    gw_agg.c
+ * @brief   Gateway - Merging Class Snapshots from Many Devices (Implementation)
+ * @version 1.0.0
+ * @note    Host only (POSIX)
+ *
+ * @details The queue is a bounded ring of slots with one sequence number
+ *          each. Slot i % num_slots is free for index i when its sequence
+ *          equals i, and holds a published snapshot when it equals i + 1.
+ *          A producer claims index i by moving head from i to i + 1 with a
+ *          compare-and-swap, fills the slot, and publishes it with a release
+ *          store of the sequence. The consumer acquires the sequence, merges
+ *          the slot, and frees it for index i + num_slots. A producer that
+ *          claimed a slot but has not published yet holds up only the
+ *          consumer, never the other producers.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "gw_agg.h"
+#include "gw_model.h"
+
+#include <errno.h>
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+
+/* =============================================================================
+ * Private Helpers - Queue
+ * ========================================================================== */
+
+static size_t load_acquire(const size_t* p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void store_release(size_t* p, size_t value)
+{
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief   Claim the next free slot
+ * @return  Slot to fill, then publish with sequence = *p_index + 1, or NULL
+ *          if the queue is full
+ */
+static gw_agg_slot_t* queue_claim(gw_agg_t* agg, size_t* p_index)
+{
+    size_t index = __atomic_load_n(&agg->head, __ATOMIC_RELAXED);
+
+    for (;;) {
+        gw_agg_slot_t* slot = &agg->config.slots[index & agg->mask];
+        size_t sequence = load_acquire(&slot->sequence);
+
+        if (sequence == index) {
+            if (__atomic_compare_exchange_n(&agg->head, &index, index + 1U, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *p_index = index;
+                return slot;
+            }
+            /* Lost the race: index now holds the new head */
+        } else if ((ptrdiff_t)(sequence - index) < 0) {
+            /* Full: the slot still holds index - num_slots, not merged yet */
+            __atomic_fetch_add(&agg->waits, 1U, __ATOMIC_RELAXED);
+            return NULL;
+        } else {
+            /* Another producer took this index; retry at the new head */
+            index = __atomic_load_n(&agg->head, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/** @brief Replace a stream's votes for a class in the merged sums */
+static void merge_snapshot(gw_agg_t* agg, const gw_agg_snapshot_t* snapshot)
+{
+    const gw_agg_config_t* cfg = &agg->config;
+    gw_agg_class_t* cls = &cfg->classes[snapshot->class_id];
+    gw_agg_contrib_t* last = &cfg->contribs[((size_t)snapshot->stream * cfg->num_classes) +
+                                            snapshot->class_id];
+
+    if (last->valid) {
+        for (uint32_t d = 0U; d < HV_DIMENSIONS; d++) {
+            cls->sum[d] += (int32_t)snapshot->votes[d] - (int32_t)last->votes[d];
+        }
+    } else {
+        for (uint32_t d = 0U; d < HV_DIMENSIONS; d++) {
+            cls->sum[d] += snapshot->votes[d];
+        }
+        last->valid = true;
+        cls->streams++;
+    }
+    memcpy(last->votes, snapshot->votes, sizeof(last->votes));
+}
+
+/* =============================================================================
+ * Private Helpers - Parser
+ * ========================================================================== */
+
+/** @brief Queue the decoded votes; false (and pending set) if the queue is full */
+static bool parser_flush(gw_agg_parser_t* parser)
+{
+    parser->pending = (gw_agg_try_push(parser->agg, &parser->votes) == GW_AGG_FULL);
+    if (parser->pending) {
+        return false;
+    }
+    parser->snapshots++;
+    return true;
+}
+
+/** @brief Turn the complete image into votes and queue them */
+static void parser_emit(gw_agg_parser_t* parser)
+{
+    gw_agg_snapshot_t* out = &parser->votes;
+    const uint8_t* image = parser->image;
+    uint8_t planes = parser->image_planes;
+
+    out->stream = parser->stream;
+    out->class_id = parser->image_class;
+
+    if (planes == 0U) {
+        for (uint32_t d = 0U; d < HV_DIMENSIONS; d++) {
+            out->votes[d] = (int16_t)((((image[d / 8U] >> (d % 8U)) & 1U) != 0U) ? 1 : -1);
+        }
+    } else {
+        /* Counters start at the tie value 2^(planes-1) - 1 (hdc_counter.h) */
+        int16_t tie = (int16_t)((1 << (planes - 1U)) - 1);
+        for (uint32_t d = 0U; d < HV_DIMENSIONS; d++) {
+            int16_t value = 0;
+            for (uint8_t p = 0U; p < planes; p++) {
+                const uint8_t* plane = &image[(size_t)p * HV_BYTES];
+                value = (int16_t)(value | (int16_t)(((plane[d / 8U] >> (d % 8U)) & 1U) << p));
+            }
+            out->votes[d] = (int16_t)(value - tie);
+        }
+    }
+
+    (void)parser_flush(parser);
+}
+
+/** @brief Add one snapshot fragment; out-of-order or lost fragments drop the image */
+static void parser_fragment(gw_agg_parser_t* parser, const uint8_t* payload, uint8_t len)
+{
+    if (len < HDC_TLM_SNAPSHOT_HEADER_BYTES) {
+        parser->dropped++;
+        return;
+    }
+
+    hdc_class_t class_id = payload[0];
+    uint8_t planes = payload[1];
+    uint16_t offset = (uint16_t)(payload[2] | ((uint16_t)payload[3] << 8));
+    uint8_t chunk = (uint8_t)(len - HDC_TLM_SNAPSHOT_HEADER_BYTES);
+
+    if (offset == 0U) {
+        if (parser->image_bytes != 0U) {
+            parser->dropped++;      /* Previous image never completed */
+        }
+        parser->image_bytes = 0U;
+        if ((planes == 1U) || (planes > GW_AGG_MAX_PLANES) ||
+            (class_id >= parser->agg->config.num_classes)) {
+            parser->dropped++;
+            return;
+        }
+        parser->image_bytes = HDC_TLM_SNAPSHOT_BYTES(planes);
+        parser->image_fill = 0U;
+        parser->image_class = class_id;
+        parser->image_planes = planes;
+    } else if ((parser->image_bytes == 0U) || (offset != parser->image_fill) ||
+               (class_id != parser->image_class) || (planes != parser->image_planes)) {
+        if (parser->image_bytes != 0U) {
+            parser->dropped++;
+        }
+        parser->image_bytes = 0U;
+        return;
+    } else {
+        /* Next fragment of the image in progress */
+    }
+
+    if ((uint32_t)offset + chunk > parser->image_bytes) {
+        parser->image_bytes = 0U;
+        parser->dropped++;
+        return;
+    }
+    memcpy(&parser->image[offset], &payload[HDC_TLM_SNAPSHOT_HEADER_BYTES], chunk);
+    parser->image_fill = (uint16_t)(offset + chunk);
+
+    if (parser->image_fill == parser->image_bytes) {
+        parser->image_bytes = 0U;
+        parser_emit(parser);
+    }
+}
+
+/** @brief Drop the leading SYNC byte and move up to the next one */
+static void parser_resync(gw_agg_parser_t* parser)
+{
+    uint16_t next = 1U;
+
+    while ((next < parser->frame_len) && (parser->frame[next] != HDC_TLM_SYNC)) {
+        next++;
+    }
+    parser->skipped += next;
+    parser->frame_len = (uint16_t)(parser->frame_len - next);
+    memmove(parser->frame, &parser->frame[next], parser->frame_len);
+}
+
+/**
+ * @brief   Handle the buffered bytes once they hold a header or a frame
+ * @return  true if bytes were consumed and the buffer should be rechecked
+ */
+static bool parser_step(gw_agg_parser_t* parser)
+{
+    if (parser->frame_len < HDC_TLM_HEADER_BYTES) {
+        return false;
+    }
+
+    uint8_t len = parser->frame[2];
+    if (len > GW_AGG_MAX_PAYLOAD) {
+        parser_resync(parser);      /* Not a real header */
+        return true;
+    }
+
+    uint16_t total = (uint16_t)(HDC_TLM_HEADER_BYTES + len + 1U);
+    if (parser->frame_len < total) {
+        return false;
+    }
+
+    uint8_t crc = 0U;
+    for (uint16_t i = 1U; i < (uint16_t)(total - 1U); i++) {
+        crc = hdc_tlm_crc8(crc, parser->frame[i]);
+    }
+    if (crc != parser->frame[total - 1U]) {
+        parser->crc_errors++;
+        parser_resync(parser);
+        return true;
+    }
+
+    parser->frames++;
+    if (parser->frame[1] == (uint8_t)HDC_TLM_SNAPSHOT) {
+        parser_fragment(parser, &parser->frame[HDC_TLM_HEADER_BYTES], len);
+    }
+    parser->frame_len = (uint16_t)(parser->frame_len - total);
+    memmove(parser->frame, &parser->frame[total], parser->frame_len);
+    return true;
+}
+
+/**
+ * @brief   Queue a pending snapshot, then handle the buffered bytes
+ * @return  false if a snapshot is waiting for a free slot
+ */
+static bool parser_run(gw_agg_parser_t* parser)
+{
+    if (parser->pending && !parser_flush(parser)) {
+        return false;
+    }
+    while (parser_step(parser)) {
+        /* A frame or a false SYNC was consumed; the rest may hold more */
+        if (parser->pending) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* =============================================================================
+ * Aggregator
+ * ========================================================================== */
+
+/**
+ * @brief   Set up an empty aggregator
+ * @param   agg Aggregator
+ * @param   config Storage and limits
+ * @return  GW_AGG_OK or GW_AGG_ERROR_INVALID
+ */
+gw_agg_status_t gw_agg_init(gw_agg_t* agg, const gw_agg_config_t* config)
+{
+    if ((agg == NULL) || (config == NULL) || (config->slots == NULL) ||
+        (config->classes == NULL) || (config->contribs == NULL) ||
+        (config->num_slots < 2U) || ((config->num_slots & (config->num_slots - 1U)) != 0U) ||
+        (config->num_classes == 0U) || (config->num_streams == 0U)) {
+        return GW_AGG_ERROR_INVALID;
+    }
+
+    memset(agg, 0, sizeof(*agg));
+    agg->config = *config;
+    agg->mask = config->num_slots - 1U;
+    for (size_t i = 0U; i < config->num_slots; i++) {
+        config->slots[i].sequence = i;
+    }
+    memset(config->classes, 0, (size_t)config->num_classes * sizeof(*config->classes));
+    memset(config->contribs, 0,
+           (size_t)config->num_streams * config->num_classes * sizeof(*config->contribs));
+    return GW_AGG_OK;
+}
+
+/**
+ * @brief   Queue one snapshot if a slot is free (any thread)
+ * @param   agg Aggregator
+ * @param   snapshot Votes to merge
+ * @return  GW_AGG_OK, GW_AGG_FULL, or GW_AGG_ERROR_INVALID
+ */
+gw_agg_status_t gw_agg_try_push(gw_agg_t* agg, const gw_agg_snapshot_t* snapshot)
+{
+    if ((agg == NULL) || (snapshot == NULL) || (snapshot->stream >= agg->config.num_streams) ||
+        (snapshot->class_id >= agg->config.num_classes)) {
+        return GW_AGG_ERROR_INVALID;
+    }
+
+    size_t index;
+    gw_agg_slot_t* slot = queue_claim(agg, &index);
+    if (slot == NULL) {
+        return GW_AGG_FULL;
+    }
+    memcpy(&slot->snapshot, snapshot, sizeof(*snapshot));
+    store_release(&slot->sequence, index + 1U);
+    return GW_AGG_OK;
+}
+
+/**
+ * @brief   Queue one snapshot (any thread)
+ * @param   agg Aggregator
+ * @param   snapshot Votes to merge
+ * @return  GW_AGG_OK, or GW_AGG_ERROR_INVALID for an unknown stream or class
+ */
+gw_agg_status_t gw_agg_push(gw_agg_t* agg, const gw_agg_snapshot_t* snapshot)
+{
+    gw_agg_status_t status;
+
+    while ((status = gw_agg_try_push(agg, snapshot)) == GW_AGG_FULL) {
+        (void)sched_yield();
+    }
+    return status;
+}
+
+/**
+ * @brief   Merge every queued snapshot (the merging thread only)
+ * @param   agg Aggregator
+ * @return  Snapshots merged by this call
+ */
+size_t gw_agg_drain(gw_agg_t* agg)
+{
+    size_t count = 0U;
+
+    for (;;) {
+        gw_agg_slot_t* slot = &agg->config.slots[agg->tail & agg->mask];
+        if (load_acquire(&slot->sequence) != (agg->tail + 1U)) {
+            break;                  /* Empty, or claimed but not yet published */
+        }
+        merge_snapshot(agg, &slot->snapshot);
+        store_release(&slot->sequence, agg->tail + agg->config.num_slots);
+        agg->tail++;
+        count++;
+    }
+    agg->merged += count;
+    return count;
+}
+
+/**
+ * @brief   Majority prototypes of the merged votes (the merging thread only)
+ * @param   agg Aggregator
+ * @param   rows num_classes hypervectors
+ * @param   tiebreak Bits used where the vote sum is exactly 0, or NULL for 0
+ */
+void gw_agg_prototypes(const gw_agg_t* agg, hv_t* rows, const hv_t tiebreak)
+{
+    for (hdc_class_t c = 0U; c < agg->config.num_classes; c++) {
+        const gw_agg_class_t* cls = &agg->config.classes[c];
+
+        hdc_clear(rows[c]);
+        if (cls->streams == 0U) {
+            continue;
+        }
+        for (uint32_t d = 0U; d < HV_DIMENSIONS; d++) {
+            uint8_t mask = (uint8_t)(1U << (d % 8U));
+            if ((cls->sum[d] > 0) ||
+                ((cls->sum[d] == 0) && (tiebreak != NULL) && ((tiebreak[d / 8U] & mask) != 0U))) {
+                rows[c][d / 8U] |= mask;
+            }
+        }
+    }
+}
+
+/**
+ * @brief   Write the merged model as a gw_model.h file (the merging thread only)
+ * @param   agg Aggregator
+ * @param   path Output path
+ * @param   rows Scratch for num_classes prototypes
+ * @return  GW_AGG_OK, GW_AGG_ERROR_IO or GW_AGG_ERROR_INVALID
+ */
+gw_agg_status_t gw_agg_write_model(const gw_agg_t* agg, const char* path, hv_t* rows)
+{
+    if ((agg == NULL) || (path == NULL) || (rows == NULL)) {
+        return GW_AGG_ERROR_INVALID;
+    }
+
+    gw_agg_prototypes(agg, rows, NULL);
+    gw_model_status_t status = gw_model_write(path, rows, agg->config.num_classes,
+                                              agg->config.item_seed);
+    if (status == GW_MODEL_OK) {
+        return GW_AGG_OK;
+    }
+    return (status == GW_MODEL_ERROR_IO) ? GW_AGG_ERROR_IO : GW_AGG_ERROR_INVALID;
+}
+
+/* =============================================================================
+ * Stream Parsers
+ * ========================================================================== */
+
+/**
+ * @brief   Start a parser for one stream
+ * @param   parser Parser
+ * @param   agg Aggregator receiving its snapshots
+ * @param   stream Stream index, below config.num_streams
+ * @return  GW_AGG_OK or GW_AGG_ERROR_INVALID
+ */
+gw_agg_status_t gw_agg_parser_init(gw_agg_parser_t* parser, gw_agg_t* agg, uint32_t stream)
+{
+    if ((parser == NULL) || (agg == NULL) || (stream >= agg->config.num_streams)) {
+        return GW_AGG_ERROR_INVALID;
+    }
+
+    memset(parser, 0, sizeof(*parser));
+    parser->agg = agg;
+    parser->stream = stream;
+    return GW_AGG_OK;
+}
+
+/**
+ * @brief   Decode received bytes; complete snapshots are pushed to the queue
+ * @param   parser Parser
+ * @param   data Bytes in stream order
+ * @param   len Number of bytes
+ * @return  Bytes used; the parser stops where a snapshot found the queue full
+ */
+size_t gw_agg_parser_feed(gw_agg_parser_t* parser, const uint8_t* data, size_t len)
+{
+    if (!parser_run(parser)) {
+        return 0U;
+    }
+    for (size_t i = 0U; i < len; i++) {
+        if ((parser->frame_len == 0U) && (data[i] != HDC_TLM_SYNC)) {
+            parser->skipped++;
+            continue;
+        }
+        parser->frame[parser->frame_len] = data[i];
+        parser->frame_len++;
+        if (!parser_run(parser)) {
+            return i + 1U;
+        }
+    }
+    return len;
+}
+
+/**
+ * @brief   Read once from a file descriptor and feed what arrived
+ * @param   parser Parser
+ * @param   fd Open stream
+ * @return  GW_AGG_OK, GW_AGG_FULL, GW_AGG_END at end of stream, or GW_AGG_ERROR_IO
+ */
+gw_agg_status_t gw_agg_parser_read(gw_agg_parser_t* parser, int fd)
+{
+    /* Finish the previous read before reading more */
+    if (parser->pending) {
+        parser->input_at += gw_agg_parser_feed(parser, &parser->input[parser->input_at],
+                                               parser->input_len - parser->input_at);
+        return parser->pending ? GW_AGG_FULL : GW_AGG_OK;
+    }
+
+    ssize_t got = read(fd, parser->input, sizeof(parser->input));
+
+    if (got > 0) {
+        parser->input_len = (size_t)got;
+        parser->input_at = gw_agg_parser_feed(parser, parser->input, parser->input_len);
+        return parser->pending ? GW_AGG_FULL : GW_AGG_OK;
+    }
+    if (got == 0) {
+        return GW_AGG_END;
+    }
+    if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+        return GW_AGG_OK;
+    }
+    return GW_AGG_ERROR_IO;
+}
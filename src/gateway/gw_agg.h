@@ -0,0 +1,254 @@
+/**
+ * @file    gw_agg.h
+ * @brief   Gateway - Merging Class Snapshots from Many Devices
+ * @version 1.0.0
+ * @note    Host only (POSIX); builds with the native environments
+ *
+ * @details Each device stream (serial port, socket, capture file) gets its
+ *          own gw_agg_parser_t. The parser decodes telemetry frames
+ *          (hdc_telemetry.h), reassembles HDC_TLM_SNAPSHOT images and turns
+ *          every complete image into per-dimension votes for its class:
+ *
+ *            - counter image (planes > 0): counter - tie value, i.e. ones
+ *              minus zeros seen by that device (counter addition)
+ *            - prototype image (planes = 0): +1 for a 1 bit, -1 for a 0 bit
+ *              (majority bundling, one vote per device)
+ *
+ *          Parsers push the votes into one bounded multi-producer,
+ *          single-consumer queue. A slot is claimed with a compare-and-swap
+ *          on the head index and published with a per-slot sequence number,
+ *          so streams never share a lock: parsers on hundreds of threads
+ *          only contend on that one atomic index. When the queue is full,
+ *          gw_agg_try_push() returns GW_AGG_FULL and a parser stops at the
+ *          snapshot it could not queue. It keeps that snapshot and the
+ *          rest of its input, and the next call resumes there, so a slow
+ *          merger slows the streams down instead of losing snapshots. One
+ *          thread may also read and drain in turn. gw_agg_push() is the
+ *          blocking form: it yields until the merger frees a slot.
+ *
+ *          One merging thread calls gw_agg_drain(). Per class it keeps the
+ *          sum of the votes of every stream. A device sends its cumulative
+ *          state again and again, so each stream's last votes per class are
+ *          kept too, and a new snapshot replaces them instead of adding to
+ *          them. The merged prototype has a 1 wherever the vote sum is
+ *          positive, the same rule as hdc_counter_threshold(). A single
+ *          device therefore reproduces its own prototype. The result is
+ *          written as a gw_model.h file for the devices and gateways.
+ *
+ *          All storage is supplied by the caller (gw_agg_config_t).
+ */
+
+#ifndef GW_AGG_H
+#define GW_AGG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "hdc_core.h"
+#include "hdc_am.h"
+#include "hdc_telemetry.h"
+
+/* =============================================================================
+ * Configuration
+ * ========================================================================== */
+
+/** @brief Most counter planes accepted in a snapshot image */
+#define GW_AGG_MAX_PLANES       8U
+
+/** @brief Largest snapshot image (GW_AGG_MAX_PLANES counter planes) */
+#define GW_AGG_IMAGE_MAX        (GW_AGG_MAX_PLANES * HV_BYTES)
+
+/** @brief Largest accepted frame payload (the LEN field limit of the decoder) */
+#define GW_AGG_MAX_PAYLOAD      250U
+
+/** @brief Bytes one gw_agg_parser_read() call reads */
+#define GW_AGG_READ_BYTES       4096U
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Aggregator status codes */
+typedef enum {
+    GW_AGG_OK = 0,
+    GW_AGG_END,                 /**< End of stream (gw_agg_parser_read()) */
+    GW_AGG_FULL,                /**< Queue full, nothing queued; drain and retry */
+    GW_AGG_ERROR_IO,            /**< read() or model write failed (see errno) */
+    GW_AGG_ERROR_INVALID        /**< Bad arguments or storage sizes */
+} gw_agg_status_t;
+
+/** @brief One device's votes for one class */
+typedef struct {
+    uint32_t    stream;                 /**< Stream the snapshot came from */
+    hdc_class_t class_id;
+    int16_t     votes[HV_DIMENSIONS];   /**< Per dimension, > 0 means 1 */
+} gw_agg_snapshot_t;
+
+/** @brief Queue slot: sequence == index + 1 once published */
+typedef struct {
+    size_t            sequence;
+    gw_agg_snapshot_t snapshot;
+} gw_agg_slot_t;
+
+/** @brief Merged votes of one class */
+typedef struct {
+    int32_t  sum[HV_DIMENSIONS];        /**< Sum of the latest votes of every stream */
+    uint32_t streams;                   /**< Streams that contributed */
+} gw_agg_class_t;
+
+/** @brief Latest votes of one stream for one class */
+typedef struct {
+    int16_t votes[HV_DIMENSIONS];
+    bool    valid;
+} gw_agg_contrib_t;
+
+/** @brief Caller-owned storage and limits */
+typedef struct {
+    gw_agg_slot_t*    slots;            /**< Queue slots */
+    size_t            num_slots;        /**< Power of two, at least 2 */
+    gw_agg_class_t*   classes;          /**< num_classes */
+    hdc_class_t       num_classes;
+    gw_agg_contrib_t* contribs;         /**< num_streams * num_classes */
+    uint32_t          num_streams;
+    uint32_t          item_seed;        /**< Written to the model file */
+} gw_agg_config_t;
+
+/** @brief Aggregator (must not move after gw_agg_init()) */
+typedef struct {
+    /* Producers: claim slots here */
+    size_t           head __attribute__((aligned(64)));
+    uint64_t         waits;             /**< Pushes that found the queue full */
+
+    /* Consumer: the merging thread only */
+    size_t           tail __attribute__((aligned(64)));
+    uint64_t         merged;            /**< Snapshots merged */
+
+    gw_agg_config_t  config;
+    size_t           mask;
+} gw_agg_t;
+
+/** @brief Per-stream decoder (used by one thread at a time) */
+typedef struct {
+    gw_agg_t* agg;
+    uint32_t  stream;
+
+    /* Frame assembly */
+    uint8_t   frame[HDC_TLM_HEADER_BYTES + GW_AGG_MAX_PAYLOAD + 1U];
+    uint16_t  frame_len;
+
+    /* Snapshot image assembly */
+    uint8_t     image[GW_AGG_IMAGE_MAX];
+    uint16_t    image_fill;
+    uint16_t    image_bytes;            /**< 0 when no image is in progress */
+    hdc_class_t image_class;
+    uint8_t     image_planes;
+    gw_agg_snapshot_t votes;            /**< Decoded image, copied into the queue */
+    bool        pending;                /**< votes found the queue full; input stopped */
+
+    /* gw_agg_parser_read() input not yet fed */
+    uint8_t   input[GW_AGG_READ_BYTES];
+    size_t    input_at;
+    size_t    input_len;
+
+    /* Statistics */
+    uint32_t  frames;                   /**< Frames with a valid CRC */
+    uint32_t  crc_errors;
+    uint32_t  skipped;                  /**< Bytes outside frames */
+    uint32_t  snapshots;                /**< Images queued for merging */
+    uint32_t  dropped;                  /**< Images lost or rejected */
+} gw_agg_parser_t;
+
+/* =============================================================================
+ * Function Declarations - Aggregator
+ * ========================================================================== */
+
+/**
+ * @brief   Set up an empty aggregator
+ * @param   agg Aggregator
+ * @param   config Storage and limits (copied; the arrays must outlive agg)
+ * @return  GW_AGG_OK or GW_AGG_ERROR_INVALID
+ */
+gw_agg_status_t gw_agg_init(gw_agg_t* agg, const gw_agg_config_t* config);
+
+/**
+ * @brief   Queue one snapshot if a slot is free (any thread)
+ * @param   agg Aggregator
+ * @param   snapshot Votes to merge (copied)
+ * @return  GW_AGG_OK, GW_AGG_FULL, or GW_AGG_ERROR_INVALID for an unknown
+ *          stream or class
+ * @note    Never waits
+ */
+gw_agg_status_t gw_agg_try_push(gw_agg_t* agg, const gw_agg_snapshot_t* snapshot);
+
+/**
+ * @brief   Queue one snapshot (any thread)
+ * @param   agg Aggregator
+ * @param   snapshot Votes to merge (copied)
+ * @return  GW_AGG_OK, or GW_AGG_ERROR_INVALID for an unknown stream or class
+ * @note    Waits with sched_yield() while the queue is full, so another
+ *          thread must be draining it
+ */
+gw_agg_status_t gw_agg_push(gw_agg_t* agg, const gw_agg_snapshot_t* snapshot);
+
+/**
+ * @brief   Merge every queued snapshot (the merging thread only)
+ * @param   agg Aggregator
+ * @return  Snapshots merged by this call
+ */
+size_t gw_agg_drain(gw_agg_t* agg);
+
+/**
+ * @brief   Majority prototypes of the merged votes (the merging thread only)
+ * @param   agg Aggregator
+ * @param   rows num_classes hypervectors; classes nobody sent stay all zero
+ * @param   tiebreak Bits used where the vote sum is exactly 0, or NULL for 0
+ */
+void gw_agg_prototypes(const gw_agg_t* agg, hv_t* rows, const hv_t tiebreak);
+
+/**
+ * @brief   Write the merged model as a gw_model.h file (the merging thread only)
+ * @param   agg Aggregator
+ * @param   path Output path (replaced if it exists)
+ * @param   rows Scratch for num_classes prototypes (left holding them)
+ * @return  GW_AGG_OK, GW_AGG_ERROR_IO or GW_AGG_ERROR_INVALID
+ */
+gw_agg_status_t gw_agg_write_model(const gw_agg_t* agg, const char* path, hv_t* rows);
+
+/* =============================================================================
+ * Function Declarations - Stream Parsers
+ * ========================================================================== */
+
+/**
+ * @brief   Start a parser for one stream
+ * @param   parser Parser
+ * @param   agg Aggregator receiving its snapshots
+ * @param   stream Stream index, below config.num_streams
+ * @return  GW_AGG_OK or GW_AGG_ERROR_INVALID
+ */
+gw_agg_status_t gw_agg_parser_init(gw_agg_parser_t* parser, gw_agg_t* agg, uint32_t stream);
+
+/**
+ * @brief   Decode received bytes; complete snapshots are pushed to the queue
+ * @param   parser Parser
+ * @param   data Bytes in stream order (frames may be split anywhere)
+ * @param   len Number of bytes
+ * @return  Bytes used. Fewer than len, or pending set, when a snapshot
+ *          found the queue full: feed the rest once the queue has room
+ *          (len may be 0 to queue just the pending snapshot).
+ * @note    Non-snapshot frames are counted and skipped
+ */
+size_t gw_agg_parser_feed(gw_agg_parser_t* parser, const uint8_t* data, size_t len);
+
+/**
+ * @brief   Read once from a file descriptor and feed what arrived
+ * @param   parser Parser
+ * @param   fd Open stream (blocking or not)
+ * @return  GW_AGG_OK, GW_AGG_FULL, GW_AGG_END at end of stream, or
+ *          GW_AGG_ERROR_IO
+ * @note    After GW_AGG_FULL the parser keeps the unread part of its input,
+ *          and the next call feeds it before it reads again. EAGAIN and
+ *          EINTR count as GW_AGG_OK with nothing read.
+ */
+gw_agg_status_t gw_agg_parser_read(gw_agg_parser_t* parser, int fd);
+
+#endif /* GW_AGG_H */
@@ -0,0 +1,199 @@
+/**
+ * @file    gw_batch.c
+ * @brief   Gateway - Parallel Batch Training and Classification (Implementation)
+ * @version 1.0.0
+ * @note    Host only
+ */
+
+#include "gw_batch.h"
+#include "hdc_item.h"
+
+#include <string.h>
+
+/* =============================================================================
+ * Private Types and Helpers
+ * ========================================================================== */
+
+/** @brief Shared, read-only context of one gw_pool_run() */
+typedef struct {
+    const gw_batch_t* batch;
+    gw_accum_t*       scratch;      /* Training: worker w owns row w */
+    hdc_class_t       num_classes;
+    const hdc_am_t*   am;           /* Classification */
+    hdc_am_match_t*   results;
+} batch_job_t;
+
+/** @brief Encode sample i of a batch */
+static void encode_sample(hv_t hv, const gw_batch_t* batch, size_t i)
+{
+    hdc_encode_multi_channel_seeded(hv, &batch->values[i * batch->num_channels],
+                                    batch->num_channels, batch->item_seed);
+}
+
+/** @brief Pool callback: bundle a chunk into this worker's partials */
+static void train_chunk(void* ctx, uint32_t worker, size_t begin, size_t end)
+{
+    const batch_job_t* job = (const batch_job_t*)ctx;
+    gw_accum_t* mine = &job->scratch[(size_t)worker * job->num_classes];
+    hv_t hv;
+
+    for (size_t i = begin; i < end; i++) {
+        encode_sample(hv, job->batch, i);
+        gw_accum_add(&mine[job->batch->labels[i]], hv);
+    }
+}
+
+/** @brief Pool callback: classify a chunk */
+static void classify_chunk(void* ctx, uint32_t worker, size_t begin, size_t end)
+{
+    const batch_job_t* job = (const batch_job_t*)ctx;
+    hv_t hv;
+
+    (void)worker;
+    for (size_t i = begin; i < end; i++) {
+        encode_sample(hv, job->batch, i);
+        (void)hdc_am_query(job->am, hv, &job->results[i]);
+    }
+}
+
+/** @brief Common batch argument checks */
+static int batch_valid(const gw_pool_t* pool, const gw_batch_t* batch)
+{
+    return (pool != NULL) && (batch != NULL) &&
+           ((batch->num_samples == 0U) ||
+            ((batch->values != NULL) && (batch->num_channels != 0U)));
+}
+
+/* =============================================================================
+ * Accumulators
+ * ========================================================================== */
+
+/**
+ * @brief   Clear accumulators
+ * @param   accum Array of accumulators
+ * @param   num Number of accumulators
+ */
+void gw_accum_reset(gw_accum_t* accum, size_t num)
+{
+    memset(accum, 0, num * sizeof(*accum));
+}
+
+/**
+ * @brief   Add one hypervector to an accumulator
+ * @param   accum Accumulator
+ * @param   hv Pattern
+ */
+void gw_accum_add(gw_accum_t* accum, const hv_t hv)
+{
+    uint32_t* ones = accum->ones;
+
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        uint8_t byte = hv[i];
+        for (uint8_t b = 0U; b < 8U; b++) {
+            ones[b] += (uint32_t)((byte >> b) & 1U);
+        }
+        ones += 8U;
+    }
+    accum->count++;
+}
+
+/**
+ * @brief   Add one accumulator into another
+ * @param   dest Accumulator receiving the counts
+ * @param   src Accumulator to add
+ */
+void gw_accum_merge(gw_accum_t* dest, const gw_accum_t* src)
+{
+    for (uint32_t d = 0U; d < HV_DIMENSIONS; d++) {
+        dest->ones[d] += src->ones[d];
+    }
+    dest->count += src->count;
+}
+
+/**
+ * @brief   Produce the majority hypervector
+ * @param   result Output hypervector
+ * @param   accum Accumulator
+ * @param   tiebreak Bits used where exactly half the samples had a 1, or NULL for 0
+ */
+void gw_accum_threshold(hv_t result, const gw_accum_t* accum, const hv_t tiebreak)
+{
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        uint8_t byte = 0U;
+        for (uint8_t b = 0U; b < 8U; b++) {
+            uint64_t twice = 2ULL * accum->ones[(i * 8U) + b];
+            uint8_t mask = (uint8_t)(1U << b);
+            if ((twice > accum->count) ||
+                ((twice == accum->count) && (tiebreak != NULL) && ((tiebreak[i] & mask) != 0U))) {
+                byte |= mask;
+            }
+        }
+        result[i] = byte;
+    }
+}
+
+/* =============================================================================
+ * Batches
+ * ========================================================================== */
+
+/**
+ * @brief   Encode and bundle a labelled batch in parallel
+ * @param   pool Worker pool
+ * @param   batch Samples and labels
+ * @param   classes Class accumulators (num_classes); counts are added to them
+ * @param   num_classes Number of classes
+ * @param   scratch gw_pool_threads(pool) * num_classes accumulators
+ * @return  GW_BATCH_OK or GW_BATCH_ERROR_INVALID (nothing is added on error)
+ */
+gw_batch_status_t gw_batch_train(gw_pool_t* pool, const gw_batch_t* batch,
+                                 gw_accum_t* classes, hdc_class_t num_classes,
+                                 gw_accum_t* scratch)
+{
+    if (!batch_valid(pool, batch) || (classes == NULL) || (scratch == NULL) ||
+        (num_classes == 0U) || ((batch->num_samples != 0U) && (batch->labels == NULL))) {
+        return GW_BATCH_ERROR_INVALID;
+    }
+    for (size_t i = 0U; i < batch->num_samples; i++) {
+        if (batch->labels[i] >= num_classes) {
+            return GW_BATCH_ERROR_INVALID;
+        }
+    }
+
+    uint32_t workers = gw_pool_threads(pool);
+    batch_job_t job = {batch, scratch, num_classes, NULL, NULL};
+
+    gw_accum_reset(scratch, (size_t)workers * num_classes);
+    (void)gw_pool_run(pool, batch->num_samples, 0U, train_chunk, &job);
+
+    /* Order-independent merge: same counts for any thread count */
+    for (uint32_t w = 0U; w < workers; w++) {
+        for (hdc_class_t c = 0U; c < num_classes; c++) {
+            gw_accum_merge(&classes[c], &scratch[((size_t)w * num_classes) + c]);
+        }
+    }
+    return GW_BATCH_OK;
+}
+
+/**
+ * @brief   Encode and classify a batch in parallel
+ * @param   pool Worker pool
+ * @param   batch Samples (labels are ignored)
+ * @param   am Associative memory, searched concurrently (not modified)
+ * @param   results One best match per sample
+ * @return  GW_BATCH_OK, GW_BATCH_ERROR_INVALID, or GW_BATCH_ERROR_EMPTY
+ */
+gw_batch_status_t gw_batch_classify(gw_pool_t* pool, const gw_batch_t* batch,
+                                    const hdc_am_t* am, hdc_am_match_t* results)
+{
+    if (!batch_valid(pool, batch) || (am == NULL) ||
+        ((batch->num_samples != 0U) && (results == NULL))) {
+        return GW_BATCH_ERROR_INVALID;
+    }
+    if (am->count == 0U) {
+        return GW_BATCH_ERROR_EMPTY;
+    }
+
+    batch_job_t job = {batch, NULL, 0U, am, results};
+    (void)gw_pool_run(pool, batch->num_samples, 0U, classify_chunk, &job);
+    return GW_BATCH_OK;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file    gw_batch.h
+ * @brief   Gateway - Parallel Batch Training and Classification
+ * @version 1.0.0
+ * @note    Host only; runs on a gw_pool.h worker pool. The HDC_PROFILE
+ *          probe accumulators are not thread-safe: profile with one thread.
+ *
+ * @details A batch holds raw multi-channel samples: num_channels ADC values
+ *          per sample, encoded like the device does it with
+ *          hdc_encode_multi_channel_seeded() from item_seed.
+ *
+ *          Training encodes each sample, then adds it to its class in the
+ *          calling worker's own accumulators, so workers share nothing while
+ *          the batch runs. Afterwards the per-worker partials are added into
+ *          the caller's class accumulators. A gw_accum_t keeps exact counts
+ *          (ones seen per dimension, and samples seen), not the device's
+ *          saturating hdc_counter_t. Addition does not depend on order, so
+ *          the trained counts and prototypes are bit-identical for any thread
+ *          count and any chunking the work stealing happens to produce.
+ *
+ *          Classification writes one hdc_am_match_t per sample index. Each
+ *          result depends only on its own sample, so it is deterministic too.
+ */
+
+#ifndef GW_BATCH_H
+#define GW_BATCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "hdc_core.h"
+#include "hdc_am.h"
+#include "gw_pool.h"
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Batch status codes */
+typedef enum {
+    GW_BATCH_OK = 0,
+    GW_BATCH_ERROR_INVALID,     /**< Bad arguments, or a label >= num_classes */
+    GW_BATCH_ERROR_EMPTY        /**< Classification against an empty memory */
+} gw_batch_status_t;
+
+/** @brief A batch of raw samples */
+typedef struct {
+    const uint16_t*    values;      /**< num_samples x num_channels, row-major */
+    const hdc_class_t* labels;      /**< One per sample (training only) */
+    size_t             num_samples;
+    uint8_t            num_channels;
+    uint32_t           item_seed;   /**< Basis vectors, as on the device */
+} gw_batch_t;
+
+/** @brief Exact per-class bundle: ones seen per dimension */
+typedef struct {
+    uint32_t ones[HV_DIMENSIONS];
+    uint32_t count;                 /**< Samples added */
+} gw_accum_t;
+
+/* =============================================================================
+ * Function Declarations - Accumulators
+ * ========================================================================== */
+
+/**
+ * @brief   Clear accumulators
+ * @param   accum Array of accumulators
+ * @param   num Number of accumulators
+ */
+void gw_accum_reset(gw_accum_t* accum, size_t num);
+
+/**
+ * @brief   Add one hypervector to an accumulator
+ * @param   accum Accumulator
+ * @param   hv Pattern
+ */
+void gw_accum_add(gw_accum_t* accum, const hv_t hv);
+
+/**
+ * @brief   Add one accumulator into another
+ * @param   dest Accumulator receiving the counts
+ * @param   src Accumulator to add
+ */
+void gw_accum_merge(gw_accum_t* dest, const gw_accum_t* src);
+
+/**
+ * @brief   Produce the majority hypervector
+ * @param   result Output hypervector
+ * @param   accum Accumulator
+ * @param   tiebreak Bits used where exactly half the samples had a 1, or NULL for 0
+ * @details Same rule as hdc_counter_threshold(): 1 where ones > count / 2.
+ */
+void gw_accum_threshold(hv_t result, const gw_accum_t* accum, const hv_t tiebreak);
+
+/* =============================================================================
+ * Function Declarations - Batches
+ * ========================================================================== */
+
+/**
+ * @brief   Encode and bundle a labelled batch in parallel
+ * @param   pool Worker pool
+ * @param   batch Samples and labels
+ * @param   classes Class accumulators (num_classes); counts are added to them
+ * @param   num_classes Number of classes
+ * @param   scratch gw_pool_threads(pool) * num_classes accumulators, used for
+ *          the per-worker partials
+ * @return  GW_BATCH_OK or GW_BATCH_ERROR_INVALID (nothing is added on error)
+ */
+gw_batch_status_t gw_batch_train(gw_pool_t* pool, const gw_batch_t* batch,
+                                 gw_accum_t* classes, hdc_class_t num_classes,
+                                 gw_accum_t* scratch);
+
+/**
+ * @brief   Encode and classify a batch in parallel
+ * @param   pool Worker pool
+ * @param   batch Samples (labels are ignored)
+ * @param   am Associative memory, searched concurrently (not modified)
+ * @param   results One best match per sample
+ * @return  GW_BATCH_OK, GW_BATCH_ERROR_INVALID, or GW_BATCH_ERROR_EMPTY
+ */
+gw_batch_status_t gw_batch_classify(gw_pool_t* pool, const gw_batch_t* batch,
+                                    const hdc_am_t* am, hdc_am_match_t* results);
+
+#endif /* GW_BATCH_H */
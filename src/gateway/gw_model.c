@@ -0,0 +1,357 @@
+/**
+ * @file    gw_model.c
+ * @brief   Gateway - Binary Model Files, Memory-Mapped (Implementation)
+ * @version 1.1.0
+ * @note    Host only (POSIX mmap)
+ *
+ * @details Writers go through a temporary file and rename(), so a reader
+ *          never maps a half-written model. Readers map the whole file
+ *          PROT_READ / MAP_SHARED and point an hdc_am_init_view() or
+ *          hdc_amt_init_view() memory at the data section.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "gw_model.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* =============================================================================
+ * Private Helpers
+ * ========================================================================== */
+
+/** @brief File magic */
+static const uint8_t s_magic[4] = {'H', 'D', 'C', 'M'};
+
+/** @brief Header byte offsets (see gw_model.h) */
+#define HDR_VERSION         4U
+#define HDR_HEADER_BYTES    6U
+#define HDR_DIMENSIONS      8U
+#define HDR_ROW_BYTES       12U
+#define HDR_CLASS_COUNT     16U
+#define HDR_FLAGS           20U
+#define HDR_DATA_OFFSET     24U
+#define HDR_DATA_BYTES      32U
+#define HDR_ITEM_SEED       40U
+#define HDR_DATA_CRC        44U
+#define HDR_CRC             60U
+
+static void put_u16(uint8_t* p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t* p, uint32_t v)
+{
+    for (uint8_t i = 0U; i < 4U; i++) {
+        p[i] = (uint8_t)(v >> (8U * i));
+    }
+}
+
+static void put_u64(uint8_t* p, uint64_t v)
+{
+    for (uint8_t i = 0U; i < 8U; i++) {
+        p[i] = (uint8_t)(v >> (8U * i));
+    }
+}
+
+static uint16_t get_u16(const uint8_t* p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* p)
+{
+    uint32_t v = 0U;
+    for (uint8_t i = 0U; i < 4U; i++) {
+        v |= (uint32_t)p[i] << (8U * i);
+    }
+    return v;
+}
+
+static uint64_t get_u64(const uint8_t* p)
+{
+    uint64_t v = 0U;
+    for (uint8_t i = 0U; i < 8U; i++) {
+        v |= (uint64_t)p[i] << (8U * i);
+    }
+    return v;
+}
+
+/* =============================================================================
+ * Checksums and Header
+ * ========================================================================== */
+
+/**
+ * @brief   Update a CRC-32 (IEEE 802.3, reflected, poly 0xEDB88320)
+ * @param   crc Running CRC (0 to start)
+ * @param   data Bytes to add
+ * @param   len Number of bytes
+ * @return  Updated CRC
+ *
+ * @details Nibble table (16 entries): two lookups per byte, no table setup.
+ */
+uint32_t gw_model_crc32(uint32_t crc, const uint8_t* data, size_t len)
+{
+    static const uint32_t table[16] = {
+        0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+        0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+        0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+        0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+    };
+
+    crc = ~crc;
+    for (size_t i = 0U; i < len; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ table[crc & 0x0FU];
+        crc = (crc >> 4) ^ table[crc & 0x0FU];
+    }
+    return ~crc;
+}
+
+/**
+ * @brief   Decode and check a header
+ * @param   header GW_MODEL_HEADER_BYTES bytes
+ * @param   file_bytes File size, to check the data section fits
+ * @param   info Receives the decoded fields
+ * @return  GW_MODEL_OK or the reason the header is rejected
+ */
+gw_model_status_t gw_model_parse_header(const uint8_t* header, uint64_t file_bytes,
+                                        gw_model_info_t* info)
+{
+    if ((file_bytes < GW_MODEL_HEADER_BYTES) || (memcmp(header, s_magic, sizeof(s_magic)) != 0)) {
+        return GW_MODEL_ERROR_FORMAT;
+    }
+    if (get_u32(&header[HDR_CRC]) != gw_model_crc32(0U, header, HDR_CRC)) {
+        return GW_MODEL_ERROR_FORMAT;
+    }
+
+    info->version = get_u16(&header[HDR_VERSION]);
+    info->dimensions = get_u32(&header[HDR_DIMENSIONS]);
+    info->row_bytes = get_u32(&header[HDR_ROW_BYTES]);
+    info->class_count = get_u32(&header[HDR_CLASS_COUNT]);
+    info->flags = get_u32(&header[HDR_FLAGS]);
+    info->data_offset = get_u64(&header[HDR_DATA_OFFSET]);
+    info->data_bytes = get_u64(&header[HDR_DATA_BYTES]);
+    info->item_seed = get_u32(&header[HDR_ITEM_SEED]);
+    info->data_crc = get_u32(&header[HDR_DATA_CRC]);
+
+    if ((info->version < GW_MODEL_VERSION_MIN) || (info->version > GW_MODEL_VERSION)) {
+        return GW_MODEL_ERROR_VERSION;
+    }
+
+    /* Blocks of HDC_AMT_LANES classes, HDC_AMT_BLOCK_WORDS words per dimension */
+    bool transposed = ((info->flags & GW_MODEL_FLAG_TRANSPOSED) != 0U);
+    uint64_t expected_bytes = transposed
+        ? ((((uint64_t)info->class_count + HDC_AMT_LANES - 1U) / HDC_AMT_LANES) *
+           info->dimensions * HDC_AMT_BLOCK_WORDS * sizeof(uint64_t))
+        : ((uint64_t)info->class_count * info->row_bytes);
+
+    if ((get_u16(&header[HDR_HEADER_BYTES]) != GW_MODEL_HEADER_BYTES) ||
+        ((info->version == 1U) ? (info->flags != 0U)
+                               : ((info->flags & ~GW_MODEL_FLAG_TRANSPOSED) != 0U)) ||
+        (info->row_bytes != ((info->dimensions + 7U) / 8U)) ||
+        (info->class_count >= HDC_AM_CLASS_NONE) ||
+        (info->data_bytes != expected_bytes) ||
+        (info->data_offset < GW_MODEL_HEADER_BYTES) ||
+        ((info->data_offset % GW_MODEL_ALIGN) != 0U) ||
+        (info->data_offset > file_bytes) ||
+        (info->data_bytes > (file_bytes - info->data_offset))) {
+        return GW_MODEL_ERROR_FORMAT;
+    }
+    if ((info->dimensions != HV_DIMENSIONS) || (info->row_bytes != HV_BYTES)) {
+        return GW_MODEL_ERROR_DIMENSIONS;
+    }
+    return GW_MODEL_OK;
+}
+
+/* =============================================================================
+ * Writing
+ * ========================================================================== */
+
+/**
+ * @brief   Write the header, padding and data section through a temp file
+ * @param   path Output path
+ * @param   data Data section (may be NULL when data_bytes is 0)
+ * @param   data_bytes Data section size
+ * @param   count Number of classes
+ * @param   flags GW_MODEL_FLAG_* for the header
+ * @param   item_seed Item memory seed
+ * @return  GW_MODEL_OK, GW_MODEL_ERROR_IO, or GW_MODEL_ERROR_INVALID
+ */
+static gw_model_status_t model_write(const char* path, const void* data, uint64_t data_bytes,
+                                     hdc_class_t count, uint32_t flags, uint32_t item_seed)
+{
+    uint8_t header[GW_MODEL_HEADER_BYTES];
+    uint8_t pad[GW_MODEL_ALIGN];
+    char tmp_path[4096];
+
+    if (snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path) >= (int)sizeof(tmp_path)) {
+        return GW_MODEL_ERROR_INVALID;
+    }
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, s_magic, sizeof(s_magic));
+    put_u16(&header[HDR_VERSION], (uint16_t)GW_MODEL_VERSION);
+    put_u16(&header[HDR_HEADER_BYTES], (uint16_t)GW_MODEL_HEADER_BYTES);
+    put_u32(&header[HDR_DIMENSIONS], (uint32_t)HV_DIMENSIONS);
+    put_u32(&header[HDR_ROW_BYTES], (uint32_t)HV_BYTES);
+    put_u32(&header[HDR_CLASS_COUNT], (uint32_t)count);
+    put_u32(&header[HDR_FLAGS], flags);
+    put_u64(&header[HDR_DATA_OFFSET], (uint64_t)GW_MODEL_ALIGN);
+    put_u64(&header[HDR_DATA_BYTES], data_bytes);
+    put_u32(&header[HDR_ITEM_SEED], item_seed);
+    put_u32(&header[HDR_DATA_CRC],
+            gw_model_crc32(0U, (const uint8_t*)data, (size_t)data_bytes));
+    put_u32(&header[HDR_CRC], gw_model_crc32(0U, header, HDR_CRC));
+
+    FILE* f = fopen(tmp_path, "wb");
+    if (f == NULL) {
+        return GW_MODEL_ERROR_IO;
+    }
+
+    memset(pad, 0, sizeof(pad));
+    bool ok = (fwrite(header, 1U, sizeof(header), f) == sizeof(header)) &&
+              (fwrite(pad, 1U, GW_MODEL_ALIGN - GW_MODEL_HEADER_BYTES, f) ==
+               (GW_MODEL_ALIGN - GW_MODEL_HEADER_BYTES)) &&
+              ((data_bytes == 0U) ||
+               (fwrite(data, 1U, (size_t)data_bytes, f) == (size_t)data_bytes)) &&
+              (fflush(f) == 0) &&
+              (fsync(fileno(f)) == 0);
+
+    if ((fclose(f) != 0) || !ok || (rename(tmp_path, path) != 0)) {
+        (void)unlink(tmp_path);
+        return GW_MODEL_ERROR_IO;
+    }
+    return GW_MODEL_OK;
+}
+
+/**
+ * @brief   Write a model file
+ * @param   path Output path (replaced if it exists)
+ * @param   rows Class prototypes
+ * @param   count Number of classes
+ * @param   item_seed Item memory seed the prototypes were encoded with
+ * @return  GW_MODEL_OK, GW_MODEL_ERROR_IO, or GW_MODEL_ERROR_INVALID
+ */
+gw_model_status_t gw_model_write(const char* path, const hv_t* rows, hdc_class_t count,
+                                 uint32_t item_seed)
+{
+    if ((path == NULL) || ((rows == NULL) && (count != 0U)) || (count == HDC_AM_CLASS_NONE)) {
+        return GW_MODEL_ERROR_INVALID;
+    }
+    return model_write(path, rows, (uint64_t)count * HV_BYTES, count, 0U, item_seed);
+}
+
+/**
+ * @brief   Write a model file in the transposed layout
+ * @param   path Output path (replaced if it exists)
+ * @param   amt Transposed memory (its first amt->count classes are written)
+ * @param   item_seed Item memory seed the prototypes were encoded with
+ * @return  GW_MODEL_OK, GW_MODEL_ERROR_IO, or GW_MODEL_ERROR_INVALID
+ *
+ * @details The planes are written as they are in memory, which is the
+ *          little-endian file layout on every supported host.
+ */
+gw_model_status_t gw_model_write_transposed(const char* path, const hdc_amt_t* amt,
+                                            uint32_t item_seed)
+{
+    if ((path == NULL) || (amt == NULL) || (amt->count == HDC_AM_CLASS_NONE)) {
+        return GW_MODEL_ERROR_INVALID;
+    }
+    return model_write(path, amt->planes, (uint64_t)HDC_AMT_WORDS(amt->count) * sizeof(uint64_t),
+                       amt->count, GW_MODEL_FLAG_TRANSPOSED, item_seed);
+}
+
+/* =============================================================================
+ * Mapping
+ * ========================================================================== */
+
+/**
+ * @brief   Map a model file and set up its associative memory
+ * @param   model Model to open
+ * @param   path File path
+ * @return  GW_MODEL_OK or an error; on error nothing stays mapped
+ */
+gw_model_status_t gw_model_open(gw_model_t* model, const char* path)
+{
+    struct stat st;
+
+    memset(model, 0, sizeof(*model));
+    if (path == NULL) {
+        return GW_MODEL_ERROR_INVALID;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return GW_MODEL_ERROR_IO;
+    }
+    if (fstat(fd, &st) != 0) {
+        (void)close(fd);
+        return GW_MODEL_ERROR_IO;
+    }
+    if ((uint64_t)st.st_size < GW_MODEL_HEADER_BYTES) {
+        (void)close(fd);
+        return GW_MODEL_ERROR_FORMAT;
+    }
+
+    /* The mapping keeps the file referenced; the descriptor is not needed */
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (map == MAP_FAILED) {
+        return GW_MODEL_ERROR_IO;
+    }
+
+    gw_model_status_t status = gw_model_parse_header((const uint8_t*)map, (uint64_t)st.st_size,
+                                                     &model->info);
+    if (status != GW_MODEL_OK) {
+        (void)munmap(map, (size_t)st.st_size);
+        memset(model, 0, sizeof(*model));
+        return status;
+    }
+
+    model->map = (const uint8_t*)map;
+    model->map_bytes = (size_t)st.st_size;
+    if ((model->info.flags & GW_MODEL_FLAG_TRANSPOSED) != 0U) {
+        /* The data offset is a multiple of 64, so the words are aligned */
+        hdc_amt_init_view(&model->amt,
+                          (const uint64_t*)(const void*)(model->map + model->info.data_offset),
+                          (hdc_class_t)model->info.class_count);
+    } else {
+        hdc_am_init_view(&model->am, (const hv_t*)(model->map + model->info.data_offset),
+                         (hdc_class_t)model->info.class_count);
+    }
+    return GW_MODEL_OK;
+}
+
+/**
+ * @brief   Unmap a model
+ * @param   model Model opened with gw_model_open()
+ */
+void gw_model_close(gw_model_t* model)
+{
+    if (model->map != NULL) {
+        (void)munmap((void*)model->map, model->map_bytes);
+    }
+    memset(model, 0, sizeof(*model));
+}
+
+/**
+ * @brief   Check the data CRC (reads every page; optional, O(model size))
+ * @param   model Open model
+ * @return  GW_MODEL_OK, or GW_MODEL_ERROR_CHECKSUM
+ */
+gw_model_status_t gw_model_verify(const gw_model_t* model)
+{
+    uint32_t crc = gw_model_crc32(0U, model->map + model->info.data_offset,
+                                  (size_t)model->info.data_bytes);
+
+    return (crc == model->info.data_crc) ? GW_MODEL_OK : GW_MODEL_ERROR_CHECKSUM;
+}
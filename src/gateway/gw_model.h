@@ -0,0 +1,183 @@
+/**
+ * @file    gw_model.h
+ * @brief   Gateway - Binary Model Files, Memory-Mapped
+ * @version 1.1.0
+ * @note    Host only (POSIX mmap); builds with the native environments
+ *
+ * @details A model file is a 64-byte header followed by the class
+ *          prototypes, stored in one of two layouts that are both searched
+ *          in place with no parse or copy:
+ *
+ *            - rows (flags 0): packed exactly like an hv_t array, for
+ *              hdc_am.h
+ *            - transposed (GW_MODEL_FLAG_TRANSPOSED): the hdc_amt.h planes,
+ *              HDC_AMT_WORDS(count) 64-bit words, for hdc_amt.h
+ *
+ *          Header:
+ *
+ *            Offset  Size  Field
+ *                 0     4  magic "HDCM"
+ *                 4     2  version (GW_MODEL_VERSION)
+ *                 6     2  header bytes (64)
+ *                 8     4  dimensions (HV_DIMENSIONS of the writer)
+ *                12     4  row bytes (HV_BYTES)
+ *                16     4  class count
+ *                20     4  flags (GW_MODEL_FLAG_*, other bits 0)
+ *                24     8  data offset (multiple of GW_MODEL_ALIGN)
+ *                32     8  data bytes (class count * row bytes, or
+ *                          8 * HDC_AMT_WORDS(class count) transposed)
+ *                40     4  item memory seed (hdc_item.h, 0 if unused)
+ *                44     4  data CRC-32 (checked only by gw_model_verify())
+ *                48    12  reserved (0)
+ *                60     4  header CRC-32 over bytes 0-59
+ *
+ *          All fields are little-endian. The data section starts on a
+ *          GW_MODEL_ALIGN boundary of the file, and so of the page-aligned
+ *          mapping. Rows keep the hv_t stride, so row c starts at data
+ *          offset + c * row bytes. When HV_BYTES is a multiple of 32 (1024,
+ *          2048, ... dimensions), every row is 256-bit aligned for the AVX2
+ *          and NEON kernels. Other widths still work, because the kernels
+ *          use unaligned loads. Transposed plane words are little-endian
+ *          like the header, so they map directly on the x86 and ARM hosts
+ *          the gateway runs on. The 64-byte alignment keeps them aligned.
+ *
+ *          gw_model_open() reads and checks only the header, then maps the
+ *          file read-only and shared. Work at startup does not depend on the
+ *          model size: pages fault in on the first query that touches them,
+ *          and several processes serving the same file share one copy.
+ */
+
+#ifndef GW_MODEL_H
+#define GW_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "hdc_core.h"
+#include "hdc_am.h"
+#include "hdc_amt.h"
+
+/* =============================================================================
+ * Constants
+ * ========================================================================== */
+
+/** @brief File format version written; readers accept 1 up to this */
+#define GW_MODEL_VERSION        2U
+
+/** @brief Oldest version read (version 1 has no flags: rows only) */
+#define GW_MODEL_VERSION_MIN    1U
+
+/** @brief Header flag: the data section holds hdc_amt.h planes */
+#define GW_MODEL_FLAG_TRANSPOSED    0x00000001UL
+
+/** @brief Header size in bytes */
+#define GW_MODEL_HEADER_BYTES   64U
+
+/** @brief Data section alignment within the file (and so in memory) */
+#define GW_MODEL_ALIGN          64U
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Model file status codes */
+typedef enum {
+    GW_MODEL_OK = 0,
+    GW_MODEL_ERROR_IO,          /**< open/read/write/mmap failed (see errno) */
+    GW_MODEL_ERROR_FORMAT,      /**< Bad magic, header size, CRC or layout */
+    GW_MODEL_ERROR_VERSION,     /**< Unsupported format version */
+    GW_MODEL_ERROR_DIMENSIONS,  /**< Written for another HV_DIMENSIONS */
+    GW_MODEL_ERROR_CHECKSUM,    /**< Data CRC mismatch (gw_model_verify()) */
+    GW_MODEL_ERROR_INVALID      /**< Bad arguments */
+} gw_model_status_t;
+
+/** @brief Decoded header fields */
+typedef struct {
+    uint16_t version;
+    uint32_t dimensions;
+    uint32_t row_bytes;
+    uint32_t class_count;
+    uint32_t flags;
+    uint64_t data_offset;
+    uint64_t data_bytes;
+    uint32_t item_seed;
+    uint32_t data_crc;
+} gw_model_info_t;
+
+/** @brief An open, mapped model */
+typedef struct {
+    const uint8_t*  map;        /**< Start of the mapping (file offset 0) */
+    size_t          map_bytes;  /**< Mapping length */
+    gw_model_info_t info;       /**< Header fields */
+    hdc_am_t        am;         /**< Read-only view over mapped rows (empty if transposed) */
+    hdc_amt_t       amt;        /**< Read-only view over mapped planes (empty for rows) */
+} gw_model_t;
+
+/* =============================================================================
+ * Function Declarations
+ * ========================================================================== */
+
+/**
+ * @brief   Write a model file
+ * @param   path Output path (replaced if it exists)
+ * @param   rows Class prototypes
+ * @param   count Number of classes
+ * @param   item_seed Item memory seed the prototypes were encoded with
+ * @return  GW_MODEL_OK, GW_MODEL_ERROR_IO, or GW_MODEL_ERROR_INVALID
+ */
+gw_model_status_t gw_model_write(const char* path, const hv_t* rows, hdc_class_t count,
+                                 uint32_t item_seed);
+
+/**
+ * @brief   Write a model file in the transposed layout
+ * @param   path Output path (replaced if it exists)
+ * @param   amt Transposed memory (its first amt->count classes are written)
+ * @param   item_seed Item memory seed the prototypes were encoded with
+ * @return  GW_MODEL_OK, GW_MODEL_ERROR_IO, or GW_MODEL_ERROR_INVALID
+ */
+gw_model_status_t gw_model_write_transposed(const char* path, const hdc_amt_t* amt,
+                                            uint32_t item_seed);
+
+/**
+ * @brief   Map a model file and set up its associative memory
+ * @param   model Model to open
+ * @param   path File path
+ * @return  GW_MODEL_OK or an error; on error nothing stays mapped
+ * @note    Reads only the header. model->am searches mapped rows, and
+ *          model->amt mapped planes (GW_MODEL_FLAG_TRANSPOSED); the view
+ *          that does not match the file stays empty.
+ */
+gw_model_status_t gw_model_open(gw_model_t* model, const char* path);
+
+/**
+ * @brief   Unmap a model
+ * @param   model Model opened with gw_model_open()
+ */
+void gw_model_close(gw_model_t* model);
+
+/**
+ * @brief   Check the data CRC (reads every page; optional, O(model size))
+ * @param   model Open model
+ * @return  GW_MODEL_OK, or GW_MODEL_ERROR_CHECKSUM
+ */
+gw_model_status_t gw_model_verify(const gw_model_t* model);
+
+/**
+ * @brief   Decode and check a header
+ * @param   header GW_MODEL_HEADER_BYTES bytes
+ * @param   file_bytes File size, to check the data section fits
+ * @param   info Receives the decoded fields
+ * @return  GW_MODEL_OK or the reason the header is rejected
+ */
+gw_model_status_t gw_model_parse_header(const uint8_t* header, uint64_t file_bytes,
+                                        gw_model_info_t* info);
+
+/**
+ * @brief   Update a CRC-32 (IEEE 802.3, reflected, poly 0xEDB88320)
+ * @param   crc Running CRC (0 to start)
+ * @param   data Bytes to add
+ * @param   len Number of bytes
+ * @return  Updated CRC
+ */
+uint32_t gw_model_crc32(uint32_t crc, const uint8_t* data, size_t len);
+
+#endif /* GW_MODEL_H */
@@ -0,0 +1,286 @@
+/**
+ * @file    gw_pool.c
+ * @brief   Gateway - Work-Stealing Thread Pool for Batch Loops (Implementation)
+ * @version 1.0.0
+ * @note    Host only (POSIX threads)
+ *
+ * @details Each slice has its own mutex, held only to move next or end, so
+ *          in the common case a worker locks only its own slice. A worker
+ *          quits when a scan finds every slice empty. A slice that is being
+ *          moved by a thief may be missed by that scan, but the thief itself
+ *          then runs it, so no index is lost.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "gw_pool.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+/* =============================================================================
+ * Private Helpers
+ * ========================================================================== */
+
+/**
+ * @brief   Take the next chunk from a worker's own slice
+ * @return  true with [*p_begin, *p_end) set, false if the slice is empty
+ */
+static bool take_own(gw_pool_t* pool, gw_pool_worker_t* self, size_t* p_begin, size_t* p_end)
+{
+    bool found = false;
+
+    pthread_mutex_lock(&self->lock);
+    if (self->next < self->end) {
+        size_t left = self->end - self->next;
+        *p_begin = self->next;
+        *p_end = self->next + ((left < pool->grain) ? left : pool->grain);
+        self->next = *p_end;
+        found = true;
+    }
+    pthread_mutex_unlock(&self->lock);
+    return found;
+}
+
+/**
+ * @brief   Move the back half of the largest other slice into self
+ * @return  true if self was refilled, false if no work is left anywhere
+ */
+static bool steal(gw_pool_t* pool, gw_pool_worker_t* self)
+{
+    gw_pool_worker_t* victim = NULL;
+    size_t best = 0U;
+
+    /* Each size is read under its lock but may be stale by the take below;
+     * a steal that finds the victim drained just returns to rescan */
+    for (uint32_t i = 1U; i < pool->threads; i++) {
+        gw_pool_worker_t* w = &pool->workers[(self->id + i) % pool->threads];
+        pthread_mutex_lock(&w->lock);
+        size_t left = w->end - w->next;
+        pthread_mutex_unlock(&w->lock);
+        if (left > best) {
+            best = left;
+            victim = w;
+        }
+    }
+    if (victim == NULL) {
+        return false;
+    }
+
+    size_t begin, end;
+    pthread_mutex_lock(&victim->lock);
+    end = victim->end;
+    begin = victim->next + ((end - victim->next) / 2U);
+    if (begin == end) {
+        pthread_mutex_unlock(&victim->lock);
+        return true;            /* Raced with the owner; rescan */
+    }
+    victim->end = begin;
+    pthread_mutex_unlock(&victim->lock);
+
+    pthread_mutex_lock(&self->lock);
+    self->next = begin;
+    self->end = end;
+    self->steals++;
+    pthread_mutex_unlock(&self->lock);
+    return true;
+}
+
+/** @brief Run chunks until no slice has work left */
+static void work(gw_pool_t* pool, gw_pool_worker_t* self)
+{
+    size_t begin, end;
+
+    for (;;) {
+        if (take_own(pool, self, &begin, &end)) {
+            pool->fn(pool->ctx, self->id, begin, end);
+        } else if (!steal(pool, self)) {
+            break;
+        }
+    }
+}
+
+/** @brief Helper thread: wait for a run, work, report back */
+static void* worker_main(void* arg)
+{
+    gw_pool_worker_t* self = (gw_pool_worker_t*)arg;
+    gw_pool_t* pool = self->pool;
+    uint32_t seen = 0U;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while ((pool->generation == seen) && !pool->stop) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->stop) {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        work(pool, self);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->active == 0U) {
+            pthread_cond_signal(&pool->done);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+/** @brief Stop and join helpers 1 .. started-1 */
+static void stop_threads(gw_pool_t* pool, uint32_t started)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (uint32_t i = 1U; i < started; i++) {
+        (void)pthread_join(pool->workers[i].thread, NULL);
+    }
+}
+
+/** @brief Destroy the pool's and every worker's mutexes and condvars */
+static void destroy_sync(gw_pool_t* pool)
+{
+    for (uint32_t i = 0U; i < pool->threads; i++) {
+        pthread_mutex_destroy(&pool->workers[i].lock);
+    }
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->lock);
+    pool->threads = 0U;
+}
+
+/* =============================================================================
+ * Public Functions
+ * ========================================================================== */
+
+/**
+ * @brief   Start a pool
+ * @param   pool Pool to initialize
+ * @param   threads Total workers including the caller (1 to GW_POOL_MAX_THREADS)
+ * @return  GW_POOL_OK, GW_POOL_ERROR_INVALID, or GW_POOL_ERROR_THREAD
+ */
+gw_pool_status_t gw_pool_init(gw_pool_t* pool, uint32_t threads)
+{
+    if ((pool == NULL) || (threads == 0U) || (threads > GW_POOL_MAX_THREADS)) {
+        return GW_POOL_ERROR_INVALID;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+    pool->threads = threads;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    for (uint32_t i = 0U; i < threads; i++) {
+        pthread_mutex_init(&pool->workers[i].lock, NULL);
+        pool->workers[i].id = i;
+        pool->workers[i].pool = pool;
+    }
+
+    /* Every worker's lock exists before a thread starts, so a failure
+     * joins only the started threads but destroys all of them */
+    for (uint32_t i = 1U; i < threads; i++) {
+        if (pthread_create(&pool->workers[i].thread, NULL, worker_main, &pool->workers[i]) != 0) {
+            stop_threads(pool, i);
+            destroy_sync(pool);
+            return GW_POOL_ERROR_THREAD;
+        }
+    }
+    return GW_POOL_OK;
+}
+
+/**
+ * @brief   Stop and join the pool threads
+ * @param   pool Pool from gw_pool_init()
+ */
+void gw_pool_destroy(gw_pool_t* pool)
+{
+    if ((pool == NULL) || (pool->threads == 0U)) {
+        return;
+    }
+
+    stop_threads(pool, pool->threads);
+    destroy_sync(pool);
+}
+
+/**
+ * @brief   Run fn over [0, count) and wait for every chunk to finish
+ * @param   pool Pool
+ * @param   count Number of indices
+ * @param   grain Indices per chunk, or 0 for count / (threads * GW_POOL_AUTO_CHUNKS)
+ * @param   fn Chunk callback, called concurrently from different workers
+ * @param   ctx Passed to fn
+ * @return  GW_POOL_OK or GW_POOL_ERROR_INVALID
+ */
+gw_pool_status_t gw_pool_run(gw_pool_t* pool, size_t count, size_t grain,
+                             gw_pool_fn_t fn, void* ctx)
+{
+    if ((pool == NULL) || (pool->threads == 0U) || (fn == NULL)) {
+        return GW_POOL_ERROR_INVALID;
+    }
+    if (count == 0U) {
+        return GW_POOL_OK;
+    }
+    if (grain == 0U) {
+        grain = count / ((size_t)pool->threads * GW_POOL_AUTO_CHUNKS);
+        grain = (grain == 0U) ? 1U : grain;
+    }
+
+    /* Even initial split; the run lock below publishes it to the helpers */
+    for (uint32_t i = 0U; i < pool->threads; i++) {
+        gw_pool_worker_t* w = &pool->workers[i];
+        pthread_mutex_lock(&w->lock);
+        w->next = (count * i) / pool->threads;
+        w->end = (count * (i + 1U)) / pool->threads;
+        w->steals = 0U;
+        pthread_mutex_unlock(&w->lock);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->ctx = ctx;
+    pool->grain = grain;
+    pool->active = pool->threads - 1U;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    work(pool, &pool->workers[0]);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->active != 0U) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return GW_POOL_OK;
+}
+
+/**
+ * @brief   Number of workers, including the caller
+ * @param   pool Pool
+ * @return  Thread count given to gw_pool_init()
+ */
+uint32_t gw_pool_threads(const gw_pool_t* pool)
+{
+    return pool->threads;
+}
+
+/**
+ * @brief   Slices stolen during the last gw_pool_run() (diagnostics)
+ * @param   pool Pool
+ * @return  Total steals across workers
+ */
+uint32_t gw_pool_steals(const gw_pool_t* pool)
+{
+    uint32_t total = 0U;
+
+    for (uint32_t i = 0U; i < pool->threads; i++) {
+        total += pool->workers[i].steals;
+    }
+    return total;
+}
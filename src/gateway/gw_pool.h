@@ -0,0 +1,138 @@
+/**
+ * @file    gw_pool.h
+ * @brief   Gateway - Work-Stealing Thread Pool for Batch Loops
+ * @version 1.0.0
+ * @note    Host only (POSIX threads); builds with the native environments
+ *
+ * @details gw_pool_run() calls fn(ctx, worker, begin, end) over disjoint
+ *          chunks that together cover indices [0, count) exactly once. The
+ *          calling thread is worker 0 and the pool threads are workers 1 to
+ *          threads-1, so a one-thread pool runs inline with no threads at all.
+ *
+ *          The index range is first split evenly, one slice per worker. A
+ *          worker takes grain-sized chunks from the front of its own slice.
+ *          When the slice is empty, it steals the back half of the largest
+ *          slice still open. Skewed batches therefore rebalance by
+ *          themselves, and a slow chunk holds up only the worker running it.
+ *
+ *          Which worker runs which chunk depends on timing. Callers that need
+ *          results independent of the thread count either write per-index
+ *          outputs, or accumulate per worker and combine the partials with an
+ *          order-independent merge (see gw_batch.h).
+ */
+
+#ifndef GW_POOL_H
+#define GW_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+
+/* =============================================================================
+ * Configuration
+ * ========================================================================== */
+
+/** @brief Most workers in one pool, the caller included */
+#ifndef GW_POOL_MAX_THREADS
+#define GW_POOL_MAX_THREADS     32U
+#endif
+
+/** @brief Chunks per worker when gw_pool_run() is given grain 0 */
+#define GW_POOL_AUTO_CHUNKS     8U
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Pool status codes */
+typedef enum {
+    GW_POOL_OK = 0,
+    GW_POOL_ERROR_INVALID,      /**< Bad thread count or arguments */
+    GW_POOL_ERROR_THREAD        /**< pthread_create() failed */
+} gw_pool_status_t;
+
+/**
+ * @brief   Chunk callback
+ * @param   ctx Caller context
+ * @param   worker Worker index, 0 to gw_pool_threads()-1
+ * @param   begin First index of the chunk
+ * @param   end One past the last index
+ */
+typedef void (*gw_pool_fn_t)(void* ctx, uint32_t worker, size_t begin, size_t end);
+
+struct gw_pool;
+
+/** @brief One worker's open slice [next, end) and its thread */
+typedef struct {
+    pthread_mutex_t lock;
+    size_t          next;       /**< Owner takes chunks from here */
+    size_t          end;        /**< Thieves take the back half from here */
+    uint32_t        steals;     /**< Slices this worker stole in the last run */
+    uint32_t        id;
+    struct gw_pool* pool;
+    pthread_t       thread;
+} gw_pool_worker_t;
+
+/** @brief Thread pool (must not move after gw_pool_init()) */
+typedef struct gw_pool {
+    gw_pool_worker_t workers[GW_POOL_MAX_THREADS];
+    uint32_t         threads;   /**< Workers, including the caller */
+    pthread_mutex_t  lock;
+    pthread_cond_t   start;     /**< Signalled when a run begins or on stop */
+    pthread_cond_t   done;      /**< Signalled when the last helper finishes */
+    uint32_t         generation;
+    uint32_t         active;    /**< Helpers still running */
+    int              stop;
+    gw_pool_fn_t     fn;
+    void*            ctx;
+    size_t           grain;
+} gw_pool_t;
+
+/* =============================================================================
+ * Function Declarations
+ * ========================================================================== */
+
+/**
+ * @brief   Start a pool
+ * @param   pool Pool to initialize
+ * @param   threads Total workers including the caller (1 to GW_POOL_MAX_THREADS)
+ * @return  GW_POOL_OK, GW_POOL_ERROR_INVALID, or GW_POOL_ERROR_THREAD
+ * @note    On GW_POOL_ERROR_THREAD every started thread is joined and all
+ *          locks are destroyed; the pool needs no gw_pool_destroy()
+ */
+gw_pool_status_t gw_pool_init(gw_pool_t* pool, uint32_t threads);
+
+/**
+ * @brief   Stop and join the pool threads
+ * @param   pool Pool from gw_pool_init()
+ */
+void gw_pool_destroy(gw_pool_t* pool);
+
+/**
+ * @brief   Run fn over [0, count) and wait for every chunk to finish
+ * @param   pool Pool
+ * @param   count Number of indices
+ * @param   grain Indices per chunk, or 0 for count / (threads * GW_POOL_AUTO_CHUNKS)
+ * @param   fn Chunk callback, called concurrently from different workers
+ * @param   ctx Passed to fn
+ * @return  GW_POOL_OK or GW_POOL_ERROR_INVALID
+ * @note    Not reentrant: one run per pool at a time, not from inside fn
+ */
+gw_pool_status_t gw_pool_run(gw_pool_t* pool, size_t count, size_t grain,
+                             gw_pool_fn_t fn, void* ctx);
+
+/**
+ * @brief   Number of workers, including the caller
+ * @param   pool Pool
+ * @return  Thread count given to gw_pool_init()
+ */
+uint32_t gw_pool_threads(const gw_pool_t* pool);
+
+/**
+ * @brief   Slices stolen during the last gw_pool_run() (diagnostics)
+ * @param   pool Pool
+ * @return  Total steals across workers
+ */
+uint32_t gw_pool_steals(const gw_pool_t* pool);
+
+#endif /* GW_POOL_H */
@@ -0,0 +1,265 @@
+/**
+ * @file    gw_replay.c
+ * @brief   Gateway - Offline Trace Replay Through the Device Pipeline (Implementation)
+ * @version 1.0.0
+ * @note    Host only
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "gw_replay.h"
+#include "hdc_encode.h"
+#include "hdc_item.h"
+#include "hdc_proto.h"
+#include "hdc_learn.h"
+
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+/* =============================================================================
+ * Private Definitions
+ * ========================================================================== */
+
+/** @brief Device defaults (src/app/main.c): 10 samples per 100 ms window */
+#define REPLAY_DEFAULT_WINDOW   10U
+#define REPLAY_DEFAULT_SEED     0x4E414E4FUL    /* APP_ITEM_SEED, "NANO" */
+
+/** @brief Which pass gw_replay_run() is in */
+typedef enum {
+    PASS_TRAIN = 0,
+    PASS_TEST
+} replay_pass_t;
+
+/** @brief Monotonic time in nanoseconds */
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/** @brief Window n is held out for testing */
+static bool is_test_window(const gw_replay_config_t* config, uint64_t n)
+{
+    return (config->test_every == 0U) || ((n % config->test_every) == (config->test_every - 1U));
+}
+
+/** @brief Is window n used in this pass */
+static bool in_pass(const gw_replay_config_t* config, replay_pass_t pass, uint64_t n)
+{
+    if (pass == PASS_TEST) {
+        return is_test_window(config, n);
+    }
+    return (config->test_every == 0U) || !is_test_window(config, n);
+}
+
+/**
+ * @brief   Class has data: its counters have unsaved words
+ * @note    The replay never persists, so a class's unsaved mask is clear
+ *          until its first update
+ */
+static bool is_trained(const hdc_proto_t* cache, hdc_class_t class_id)
+{
+    for (hdc_index_t i = 0U; i < HDC_COUNTER_MASK_BYTES; i++) {
+        if (cache->unsaved[class_id][i] != 0U) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief   Train on one window with the device's rule (src/app/main.c)
+ * @details The query is only added while a class is untrained. After that
+ *          it is classified against the current prototypes and
+ *          hdc_learn_update() retrains on a wrong prediction.
+ */
+static void learn_window(hdc_learn_t* learn, const hv_t query, hdc_class_t label,
+                         hdc_class_t* p_untrained)
+{
+    hdc_class_t predicted = (hdc_class_t)HDC_AM_CLASS_NONE;
+
+    if (*p_untrained == 0U) {
+        hdc_am_match_t match;
+        (void)hdc_proto_query(learn->cache, query, &match);
+        predicted = match.class_id;
+    } else if (!is_trained(learn->cache, label)) {
+        (*p_untrained)--;
+    }
+    (void)hdc_learn_update(learn, query, label, predicted);
+}
+
+/**
+ * @brief   One pass over the trace
+ * @details Encode, bundle and query are timed one by one. Reading and
+ *          averaging are the remainder of the pass time, which keeps clock
+ *          reads out of the per-record loop. Training bundles every
+ *          window into counters, or goes through learn when it is not NULL.
+ */
+static gw_replay_status_t run_pass(const gw_replay_config_t* config, gw_trace_t* trace,
+                                   replay_pass_t pass, uint8_t channels,
+                                   hdc_counter_t* counters, hdc_learn_t* learn,
+                                   const hdc_am_t* am, gw_replay_report_t* report)
+{
+    gw_trace_record_t record;
+    uint32_t sums[GW_TRACE_MAX_CHANNELS];
+    hdc_level_t levels[GW_TRACE_MAX_CHANNELS];
+    uint16_t fill = 0U;
+    uint16_t label = 0U;
+    uint64_t window = 0U;
+    uint64_t records = 0U;
+    uint64_t skipped = 0U;
+    uint64_t timed = 0U;
+    hdc_class_t untrained = config->num_classes;
+    gw_trace_status_t status;
+    hv_t query;
+
+    gw_trace_rewind(trace);
+    uint64_t start = now_ns();
+
+    while ((status = gw_trace_next(trace, &record)) == GW_TRACE_OK) {
+        records++;
+        if (record.label >= config->num_classes) {
+            skipped++;
+            continue;
+        }
+        if ((fill != 0U) && (record.label != label)) {
+            fill = 0U;          /* Drop a window that spans two labels */
+        }
+        if (fill == 0U) {
+            memset(sums, 0, sizeof(sums));
+            label = record.label;
+        }
+        for (uint8_t ch = 0U; ch < channels; ch++) {
+            sums[ch] += record.values[ch];
+        }
+        if (++fill < config->window) {
+            continue;
+        }
+
+        fill = 0U;
+        if (!in_pass(config, pass, window++)) {
+            continue;
+        }
+
+        uint64_t t0 = now_ns();
+        for (uint8_t ch = 0U; ch < channels; ch++) {
+            levels[ch] = hdc_level_from_value((uint16_t)(sums[ch] / config->window),
+                                              config->max_value);
+        }
+        hdc_encode_levels_seeded(query, levels, channels, config->item_seed);
+        uint64_t t1 = now_ns();
+        report->encode_ns += t1 - t0;
+
+        if ((pass == PASS_TRAIN) && (learn != NULL)) {
+            learn_window(learn, query, (hdc_class_t)label, &untrained);
+            report->bundle_ns += now_ns() - t1;
+            report->trained++;
+        } else if (pass == PASS_TRAIN) {
+            hdc_counter_add(&counters[label], query);
+            report->bundle_ns += now_ns() - t1;
+            report->trained++;
+        } else {
+            hdc_am_match_t best;
+            (void)hdc_am_query(am, query, &best);
+            report->query_ns += now_ns() - t1;
+            report->tested++;
+            report->correct += (best.class_id == label) ? 1U : 0U;
+        }
+        timed += now_ns() - t0;
+    }
+
+    report->read_ns += (now_ns() - start) - timed;
+    report->records = records;
+    report->skipped = skipped;
+    report->windows = window;
+    return (status == GW_TRACE_END) ? GW_REPLAY_OK : GW_REPLAY_ERROR_TRACE;
+}
+
+/* =============================================================================
+ * Public Functions
+ * ========================================================================== */
+
+/**
+ * @brief   Default settings: the device's window, seed, full scale and
+ *          learning rule
+ * @param   config Receives the defaults
+ * @param   num_classes Number of classes
+ */
+void gw_replay_defaults(gw_replay_config_t* config, hdc_class_t num_classes)
+{
+    config->item_seed = REPLAY_DEFAULT_SEED;
+    config->window = REPLAY_DEFAULT_WINDOW;
+    config->test_every = 5U;
+    config->max_value = ADC_MAX;
+    config->channels = 0U;
+    config->num_classes = num_classes;
+    config->learn = true;
+}
+
+/**
+ * @brief   Train on a trace and evaluate the held-out windows
+ * @param   config Settings
+ * @param   trace Open trace (rewound by this call)
+ * @param   counters num_classes counter bundles (reset by this call)
+ * @param   rows num_classes prototype rows, searched in pass 2 (and in
+ *          pass 1 when learning)
+ * @param   masks 2 * num_classes word masks for the prototype cache
+ *          (hdc_proto.h); may be NULL when config->learn is false
+ * @param   report Results
+ * @return  GW_REPLAY_OK, GW_REPLAY_ERROR_INVALID, or GW_REPLAY_ERROR_TRACE
+ */
+gw_replay_status_t gw_replay_run(const gw_replay_config_t* config, gw_trace_t* trace,
+                                 hdc_counter_t* counters, hv_t* rows,
+                                 hdc_counter_mask_t* masks, gw_replay_report_t* report)
+{
+    hdc_am_t am;
+    hdc_proto_t cache;
+    hdc_learn_t learn;
+
+    if ((config == NULL) || (trace == NULL) || (trace->map == NULL) || (counters == NULL) ||
+        (rows == NULL) || (report == NULL) || (config->window == 0U) ||
+        (config->max_value == 0U) || (config->num_classes == 0U) ||
+        (config->num_classes == HDC_AM_CLASS_NONE) || (config->channels > trace->channels) ||
+        (config->learn && (masks == NULL))) {
+        return GW_REPLAY_ERROR_INVALID;
+    }
+
+    uint8_t channels = (config->channels == 0U) ? trace->channels : config->channels;
+    uint64_t start = now_ns();
+
+    memset(report, 0, sizeof(*report));
+    for (hdc_class_t c = 0U; c < config->num_classes; c++) {
+        hdc_counter_reset(&counters[c]);
+    }
+
+    /* Pass 1 prototypes start all zero, like the device's after a reset */
+    if (config->learn) {
+        hv_t zero;
+        hdc_clear(zero);
+        hdc_am_init(&am, rows, config->num_classes);
+        for (hdc_class_t c = 0U; c < config->num_classes; c++) {
+            (void)hdc_am_add(&am, zero, NULL);
+        }
+        (void)hdc_proto_init(&cache, &am, counters, masks, &masks[config->num_classes], NULL);
+        hdc_learn_init(&learn, &cache);
+    }
+
+    gw_replay_status_t status = run_pass(config, trace, PASS_TRAIN, channels, counters,
+                                         config->learn ? &learn : NULL, NULL, report);
+    if (status != GW_REPLAY_OK) {
+        return status;
+    }
+    report->updated = config->learn ? learn.updates : report->trained;
+
+    /* An untrained counter is all ties, so its row is all zero as on the device */
+    for (hdc_class_t c = 0U; c < config->num_classes; c++) {
+        hdc_counter_threshold(rows[c], &counters[c], NULL);
+    }
+    hdc_am_init_view(&am, (const hv_t*)rows, config->num_classes);
+
+    status = run_pass(config, trace, PASS_TEST, channels, counters, NULL, &am, report);
+    report->total_ns = now_ns() - start;
+    return status;
+}
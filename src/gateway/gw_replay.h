@@ -0,0 +1,114 @@
+/**
+ * @file    gw_replay.h
+ * @brief   Gateway - Offline Trace Replay Through the Device Pipeline
+ * @version 1.0.0
+ * @note    Host only; the HDC code is the code built for the Uno
+ *
+ * @details gw_replay_run() feeds a gw_trace.h trace through the same steps
+ *          as src/app/main.c:
+ *
+ *            window average -> hdc_level_from_value() ->
+ *            hdc_encode_levels_seeded() -> hdc_learn_update() ->
+ *            hdc_counter_threshold() -> hdc_am_query()
+ *
+ *          Consecutive records with the same label are averaged over window
+ *          samples into one query, like the device's sample/encode tasks. A
+ *          label change or the end of the trace drops a partial window.
+ *          Windows are numbered in trace order. With test_every = k, every
+ *          k-th window is held out for testing and the others are trained;
+ *          with k = 0, every window is used for both.
+ *
+ *          Pass 1 trains the class counters with the device's rule: every
+ *          training window is bundled into its class until all classes have
+ *          data; after that a window is classified against the prototypes
+ *          (hdc_proto_query) and only a wrong prediction retrains, adding
+ *          the query to its class and subtracting it from the predicted one
+ *          (hdc_learn.h). With config->learn false, every training window is
+ *          bundled instead (hdc_counter_add), which gives the plain
+ *          one-shot model. Pass 2 thresholds the counters into the
+ *          associative memory (untrained classes stay all zero, as on the
+ *          device) and classifies the test windows. The report gives
+ *          accuracy counts and the time spent in each stage.
+ *
+ *          HV_DIMENSIONS and the kernel backend are build-time choices, as
+ *          on the device. Window, level scale, channel subset and seed are
+ *          run-time settings, so a sweep over them needs no rebuild.
+ */
+
+#ifndef GW_REPLAY_H
+#define GW_REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hdc_core.h"
+#include "hdc_am.h"
+#include "hdc_counter.h"
+#include "gw_trace.h"
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Replay status codes */
+typedef enum {
+    GW_REPLAY_OK = 0,
+    GW_REPLAY_ERROR_INVALID,    /**< Bad configuration */
+    GW_REPLAY_ERROR_TRACE       /**< Malformed record at trace->line (CSV) or trace->index */
+} gw_replay_status_t;
+
+/** @brief Replay settings */
+typedef struct {
+    uint32_t    item_seed;      /**< Basis vectors (APP_ITEM_SEED on the device) */
+    uint16_t    window;         /**< Samples averaged per query (>= 1) */
+    uint16_t    test_every;     /**< Hold out every k-th window; 0 = test on all */
+    uint16_t    max_value;      /**< Full-scale input (ADC_MAX for the Uno) */
+    uint8_t     channels;       /**< Leading channels to use; 0 = all in the trace */
+    hdc_class_t num_classes;    /**< Labels at or above this are skipped */
+    bool        learn;          /**< Retrain on mistakes as the device does; false = bundle all */
+} gw_replay_config_t;
+
+/** @brief Replay results; times are CLOCK_MONOTONIC nanoseconds */
+typedef struct {
+    uint64_t records;           /**< Records read in one pass */
+    uint64_t skipped;           /**< Records with a label >= num_classes */
+    uint64_t windows;           /**< Complete windows in one pass */
+    uint64_t trained;           /**< Training windows */
+    uint64_t updated;           /**< Training windows that changed the counters */
+    uint64_t tested;            /**< Windows classified */
+    uint64_t correct;           /**< Classified as their label */
+    uint64_t read_ns;           /**< Trace decode and window averaging */
+    uint64_t encode_ns;         /**< Levels and seeded encoding */
+    uint64_t bundle_ns;         /**< Counter updates, with the pass 1 predictions when learning */
+    uint64_t query_ns;          /**< Associative memory search */
+    uint64_t total_ns;          /**< Both passes, thresholding included */
+} gw_replay_report_t;
+
+/* =============================================================================
+ * Function Declarations
+ * ========================================================================== */
+
+/**
+ * @brief   Default settings: the device's window, seed, full scale and
+ *          learning rule
+ * @param   config Receives the defaults
+ * @param   num_classes Number of classes
+ */
+void gw_replay_defaults(gw_replay_config_t* config, hdc_class_t num_classes);
+
+/**
+ * @brief   Train on a trace and evaluate the held-out windows
+ * @param   config Settings
+ * @param   trace Open trace (rewound by this call)
+ * @param   counters num_classes counter bundles (reset by this call)
+ * @param   rows num_classes prototype rows, searched in pass 2 (and in
+ *          pass 1 when learning)
+ * @param   masks 2 * num_classes word masks for the prototype cache
+ *          (hdc_proto.h); may be NULL when config->learn is false
+ * @param   report Results
+ * @return  GW_REPLAY_OK, GW_REPLAY_ERROR_INVALID, or GW_REPLAY_ERROR_TRACE
+ */
+gw_replay_status_t gw_replay_run(const gw_replay_config_t* config, gw_trace_t* trace,
+                                 hdc_counter_t* counters, hv_t* rows,
+                                 hdc_counter_mask_t* masks, gw_replay_report_t* report);
+
+#endif /* GW_REPLAY_H */
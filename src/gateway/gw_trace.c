@@ -0,0 +1,325 @@
+/**
+ * @file    gw_trace.c
+ * @brief   Gateway - Recorded ADC Traces (Implementation)
+ * @version 1.0.0
+ * @note    Host only (POSIX mmap)
+ *
+ * @details The CSV reader works directly on the mapped bytes, which are not
+ *          NUL-terminated, so every scan is bounded by the end of the line.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "gw_trace.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* =============================================================================
+ * Private Helpers
+ * ========================================================================== */
+
+/** @brief Binary trace magic */
+static const uint8_t s_magic[4] = {'H', 'D', 'C', 'T'};
+
+static uint16_t get_u16(const uint8_t* p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+static void put_u16(uint8_t* p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static bool is_digit(uint8_t c)
+{
+    return (c >= (uint8_t)'0') && (c <= (uint8_t)'9');
+}
+
+/**
+ * @brief   Parse "label,v0,v1,..." between p and stop
+ * @param   fields Receives fields[0] = label, then the values
+ * @return  Number of fields, or 0 if the line is malformed
+ */
+static uint8_t parse_fields(const uint8_t* p, const uint8_t* stop,
+                            uint16_t fields[GW_TRACE_MAX_CHANNELS + 1U])
+{
+    uint8_t n = 0U;
+
+    for (;;) {
+        uint32_t v = 0U;
+
+        while ((p < stop) && ((*p == (uint8_t)' ') || (*p == (uint8_t)'\t'))) {
+            p++;
+        }
+        if ((p == stop) || !is_digit(*p) || (n > GW_TRACE_MAX_CHANNELS)) {
+            return 0U;
+        }
+        while ((p < stop) && is_digit(*p)) {
+            v = (v * 10U) + (uint32_t)(*p - (uint8_t)'0');
+            if (v > 0xFFFFU) {
+                return 0U;
+            }
+            p++;
+        }
+        while ((p < stop) && ((*p == (uint8_t)' ') || (*p == (uint8_t)'\t'))) {
+            p++;
+        }
+        fields[n++] = (uint16_t)v;
+
+        if (p == stop) {
+            return n;
+        }
+        if (*p != (uint8_t)',') {
+            return 0U;
+        }
+        p++;
+    }
+}
+
+/** @brief Next CSV record; sets trace->channels from the first one */
+static gw_trace_status_t next_csv(gw_trace_t* trace, gw_trace_record_t* record)
+{
+    uint16_t fields[GW_TRACE_MAX_CHANNELS + 1U];
+    const uint8_t* end = trace->map + trace->map_bytes;
+
+    while (trace->pos < trace->map_bytes) {
+        const uint8_t* p = trace->map + trace->pos;
+        const uint8_t* eol = (const uint8_t*)memchr(p, '\n', (size_t)(end - p));
+        eol = (eol == NULL) ? end : eol;
+        trace->pos = (size_t)(eol - trace->map) + ((eol < end) ? 1U : 0U);
+        trace->line++;
+
+        const uint8_t* stop = eol;
+        if ((stop > p) && (stop[-1] == (uint8_t)'\r')) {
+            stop--;
+        }
+        if ((p == stop) || (*p == (uint8_t)'#')) {
+            continue;
+        }
+        bool first = !trace->past_header;
+        trace->past_header = true;
+        if (first && !is_digit(*p)) {
+            continue;           /* Column header */
+        }
+
+        uint8_t n = parse_fields(p, stop, fields);
+        if ((n < 2U) || ((trace->channels != 0U) && ((n - 1U) != trace->channels))) {
+            return GW_TRACE_ERROR_FORMAT;
+        }
+        trace->channels = (uint8_t)(n - 1U);
+        record->label = fields[0];
+        memcpy(record->values, &fields[1], trace->channels * sizeof(uint16_t));
+        trace->index++;
+        return GW_TRACE_OK;
+    }
+    return GW_TRACE_END;
+}
+
+/** @brief Next binary record */
+static gw_trace_status_t next_binary(gw_trace_t* trace, gw_trace_record_t* record)
+{
+    if (trace->index >= trace->count) {
+        return GW_TRACE_END;
+    }
+
+    const uint8_t* p = trace->map + trace->pos;
+    record->label = get_u16(p);
+    for (uint8_t ch = 0U; ch < trace->channels; ch++) {
+        record->values[ch] = get_u16(&p[2U + (2U * ch)]);
+    }
+    trace->pos += 2U * (1U + (size_t)trace->channels);
+    trace->index++;
+    return GW_TRACE_OK;
+}
+
+/** @brief Check the binary header against the file size */
+static gw_trace_status_t open_binary(gw_trace_t* trace)
+{
+    if (trace->map_bytes < GW_TRACE_HEADER_BYTES) {
+        return GW_TRACE_ERROR_FORMAT;
+    }
+
+    uint16_t version = get_u16(&trace->map[4]);
+    uint16_t channels = get_u16(&trace->map[6]);
+    uint32_t count = get_u32(&trace->map[8]);
+
+    if ((version != GW_TRACE_VERSION) || (channels == 0U) || (channels > GW_TRACE_MAX_CHANNELS)) {
+        return GW_TRACE_ERROR_FORMAT;
+    }
+    uint64_t need = GW_TRACE_HEADER_BYTES + ((uint64_t)count * 2U * (1U + channels));
+    if (need > trace->map_bytes) {
+        return GW_TRACE_ERROR_FORMAT;
+    }
+
+    trace->kind = GW_TRACE_BINARY;
+    trace->channels = (uint8_t)channels;
+    trace->count = count;
+    trace->start = GW_TRACE_HEADER_BYTES;
+    return GW_TRACE_OK;
+}
+
+/** @brief Find the CSV channel count from the first data line */
+static gw_trace_status_t open_csv(gw_trace_t* trace)
+{
+    gw_trace_record_t first;
+
+    trace->kind = GW_TRACE_CSV;
+    trace->start = 0U;
+    trace->pos = 0U;
+
+    gw_trace_status_t status = next_csv(trace, &first);
+    return (status == GW_TRACE_OK) ? GW_TRACE_OK : GW_TRACE_ERROR_FORMAT;
+}
+
+/* =============================================================================
+ * Public Functions
+ * ========================================================================== */
+
+/**
+ * @brief   Map a trace and check its header or first data line
+ * @param   trace Trace to open
+ * @param   path File path
+ * @return  GW_TRACE_OK, GW_TRACE_ERROR_IO, or GW_TRACE_ERROR_FORMAT
+ */
+gw_trace_status_t gw_trace_open(gw_trace_t* trace, const char* path)
+{
+    struct stat st;
+
+    memset(trace, 0, sizeof(*trace));
+    if (path == NULL) {
+        return GW_TRACE_ERROR_INVALID;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return GW_TRACE_ERROR_IO;
+    }
+    if (fstat(fd, &st) != 0) {
+        (void)close(fd);
+        return GW_TRACE_ERROR_IO;
+    }
+    if (st.st_size == 0) {
+        (void)close(fd);
+        return GW_TRACE_ERROR_FORMAT;
+    }
+
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (map == MAP_FAILED) {
+        return GW_TRACE_ERROR_IO;
+    }
+    trace->map = (const uint8_t*)map;
+    trace->map_bytes = (size_t)st.st_size;
+
+    /* One pass from start to end: tell the kernel to read ahead */
+    (void)posix_madvise(map, trace->map_bytes, POSIX_MADV_SEQUENTIAL);
+
+    bool binary = (trace->map_bytes >= sizeof(s_magic)) &&
+                  (memcmp(trace->map, s_magic, sizeof(s_magic)) == 0);
+    gw_trace_status_t status = binary ? open_binary(trace) : open_csv(trace);
+    if (status != GW_TRACE_OK) {
+        gw_trace_close(trace);
+        return status;
+    }
+
+    gw_trace_rewind(trace);
+    return GW_TRACE_OK;
+}
+
+/**
+ * @brief   Unmap a trace
+ * @param   trace Trace opened with gw_trace_open()
+ */
+void gw_trace_close(gw_trace_t* trace)
+{
+    if (trace->map != NULL) {
+        (void)munmap((void*)trace->map, trace->map_bytes);
+    }
+    memset(trace, 0, sizeof(*trace));
+}
+
+/**
+ * @brief   Go back to the first record
+ * @param   trace Open trace
+ */
+void gw_trace_rewind(gw_trace_t* trace)
+{
+    trace->pos = trace->start;
+    trace->line = 0U;
+    trace->index = 0U;
+    trace->past_header = false;
+}
+
+/**
+ * @brief   Decode the next record
+ * @param   trace Open trace
+ * @param   record Receives the label and trace->channels values
+ * @return  GW_TRACE_OK, GW_TRACE_END, or GW_TRACE_ERROR_FORMAT
+ */
+gw_trace_status_t gw_trace_next(gw_trace_t* trace, gw_trace_record_t* record)
+{
+    return (trace->kind == GW_TRACE_BINARY) ? next_binary(trace, record)
+                                            : next_csv(trace, record);
+}
+
+/**
+ * @brief   Write a binary trace
+ * @param   path Output path (replaced if it exists)
+ * @param   labels One label per record
+ * @param   values count x channels values, row-major
+ * @param   count Number of records
+ * @param   channels Channels per record (1 to GW_TRACE_MAX_CHANNELS)
+ * @return  GW_TRACE_OK, GW_TRACE_ERROR_IO, or GW_TRACE_ERROR_INVALID
+ */
+gw_trace_status_t gw_trace_write(const char* path, const uint16_t* labels,
+                                 const uint16_t* values, uint32_t count, uint8_t channels)
+{
+    uint8_t header[GW_TRACE_HEADER_BYTES];
+    uint8_t record[2U * (1U + GW_TRACE_MAX_CHANNELS)];
+
+    if ((path == NULL) || (channels == 0U) || (channels > GW_TRACE_MAX_CHANNELS) ||
+        ((count != 0U) && ((labels == NULL) || (values == NULL)))) {
+        return GW_TRACE_ERROR_INVALID;
+    }
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, s_magic, sizeof(s_magic));
+    put_u16(&header[4], (uint16_t)GW_TRACE_VERSION);
+    put_u16(&header[6], channels);
+    put_u16(&header[8], (uint16_t)count);
+    put_u16(&header[10], (uint16_t)(count >> 16));
+
+    FILE* f = fopen(path, "wb");
+    if (f == NULL) {
+        return GW_TRACE_ERROR_IO;
+    }
+
+    bool ok = (fwrite(header, 1U, sizeof(header), f) == sizeof(header));
+    size_t record_bytes = 2U * (1U + (size_t)channels);
+    for (uint32_t i = 0U; ok && (i < count); i++) {
+        put_u16(record, labels[i]);
+        for (uint8_t ch = 0U; ch < channels; ch++) {
+            put_u16(&record[2U + (2U * ch)], values[((size_t)i * channels) + ch]);
+        }
+        ok = (fwrite(record, 1U, record_bytes, f) == record_bytes);
+    }
+
+    if ((fclose(f) != 0) || !ok) {
+        return GW_TRACE_ERROR_IO;
+    }
+    return GW_TRACE_OK;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file    gw_trace.h
+ * @brief   Gateway - Recorded ADC Traces (CSV or Binary, Memory-Mapped)
+ * @version 1.0.0
+ * @note    Host only (POSIX mmap); builds with the native environments
+ *
+ * @details A trace is a sequence of labelled multi-channel ADC samples. The
+ *          file is mapped read-only and decoded one record at a time, so a
+ *          trace of any size is replayed with no load step and constant
+ *          memory. Two formats are read, told apart by the first bytes:
+ *
+ *          CSV, one sample per line: "label,ch0,ch1,...". Blank lines and
+ *          lines starting with '#' are skipped. So is the first other line
+ *          if it does not start with a digit (a column header), even when
+ *          comments come before it. The first data line sets the channel
+ *          count, and every other line must match it.
+ *
+ *          Binary, written by gw_trace_write(), all little-endian:
+ *
+ *            Offset  Size  Field
+ *                 0     4  magic "HDCT"
+ *                 4     2  version (GW_TRACE_VERSION)
+ *                 6     2  channels
+ *                 8     4  record count
+ *                12     4  reserved (0)
+ *                16     -  records: u16 label, then u16 value per channel
+ */
+
+#ifndef GW_TRACE_H
+#define GW_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* =============================================================================
+ * Constants
+ * ========================================================================== */
+
+/** @brief Most channels per record */
+#define GW_TRACE_MAX_CHANNELS   16U
+
+/** @brief Binary trace format version */
+#define GW_TRACE_VERSION        1U
+
+/** @brief Binary trace header size in bytes */
+#define GW_TRACE_HEADER_BYTES   16U
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Trace status codes */
+typedef enum {
+    GW_TRACE_OK = 0,
+    GW_TRACE_END,               /**< No more records */
+    GW_TRACE_ERROR_IO,          /**< open/mmap/write failed (see errno) */
+    GW_TRACE_ERROR_FORMAT,      /**< Bad header, or bad record (CSV: at trace->line) */
+    GW_TRACE_ERROR_INVALID      /**< Bad arguments */
+} gw_trace_status_t;
+
+/** @brief Trace file format */
+typedef enum {
+    GW_TRACE_CSV = 0,
+    GW_TRACE_BINARY
+} gw_trace_kind_t;
+
+/** @brief One decoded sample */
+typedef struct {
+    uint16_t label;
+    uint16_t values[GW_TRACE_MAX_CHANNELS];
+} gw_trace_record_t;
+
+/** @brief An open, mapped trace and its read position */
+typedef struct {
+    const uint8_t*  map;        /**< Start of the mapping */
+    size_t          map_bytes;  /**< Mapping length */
+    size_t          start;      /**< Offset of the first record */
+    size_t          pos;        /**< Offset of the next record */
+    gw_trace_kind_t kind;
+    uint8_t         channels;
+    uint32_t        line;       /**< CSV line of the last record read (1-based) */
+    uint32_t        count;      /**< Binary record count (0 for CSV: not known) */
+    uint32_t        index;      /**< Records read */
+    bool            past_header; /**< CSV: the first non-comment line was read */
+} gw_trace_t;
+
+/* =============================================================================
+ * Function Declarations
+ * ========================================================================== */
+
+/**
+ * @brief   Map a trace and check its header or first data line
+ * @param   trace Trace to open
+ * @param   path File path
+ * @return  GW_TRACE_OK, GW_TRACE_ERROR_IO, or GW_TRACE_ERROR_FORMAT
+ */
+gw_trace_status_t gw_trace_open(gw_trace_t* trace, const char* path);
+
+/**
+ * @brief   Unmap a trace
+ * @param   trace Trace opened with gw_trace_open()
+ */
+void gw_trace_close(gw_trace_t* trace);
+
+/**
+ * @brief   Go back to the first record
+ * @param   trace Open trace
+ */
+void gw_trace_rewind(gw_trace_t* trace);
+
+/**
+ * @brief   Decode the next record
+ * @param   trace Open trace
+ * @param   record Receives the label and trace->channels values
+ * @return  GW_TRACE_OK, GW_TRACE_END, or GW_TRACE_ERROR_FORMAT
+ */
+gw_trace_status_t gw_trace_next(gw_trace_t* trace, gw_trace_record_t* record);
+
+/**
+ * @brief   Write a binary trace
+ * @param   path Output path (replaced if it exists)
+ * @param   labels One label per record
+ * @param   values count x channels values, row-major
+ * @param   count Number of records
+ * @param   channels Channels per record (1 to GW_TRACE_MAX_CHANNELS)
+ * @return  GW_TRACE_OK, GW_TRACE_ERROR_IO, or GW_TRACE_ERROR_INVALID
+ */
+gw_trace_status_t gw_trace_write(const char* path, const uint16_t* labels,
+                                 const uint16_t* values, uint32_t count, uint8_t channels);
+
+#endif /* GW_TRACE_H */
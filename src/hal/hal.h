@@ -11,6 +11,7 @@
 #include "hal_gpio.h"
 #include "hal_uart.h"
 #include "hal_adc.h"
+#include "hal_timer.h"
 
 #define HAL_VERSION_MAJOR   1U
 #define HAL_VERSION_MINOR   0U
@@ -25,6 +26,7 @@ static inline void hal_init(void)
     hal_gpio_init();
     hal_uart_init();
     hal_adc_init();
+    hal_timer_init();
 }
 
 #endif /* HAL_H */
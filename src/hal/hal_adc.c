@@ -0,0 +1,457 @@
+/**
+ * @file    hal_adc.c
+ * @brief   HAL - ADC Interrupt-Driven Streaming, Scan Sequencer, Quiet Reads
+ * @version 1.2.0
+ * @note    Target: ATmega328P, free-running mode, ADC_vect producer
+ *
+ * @details In free-running mode the next conversion starts as soon as the
+ *          previous one completes, so when ADC_vect runs the following
+ *          conversion is already sampling with the old MUX setting. A MUX
+ *          write in the ISR therefore takes effect one conversion later.
+ *          The ISR tracks that lag so every sample is tagged with the
+ *          channel it was actually converted from.
+ *
+ *          The scan sequencer shares ADC_vect but uses single conversions:
+ *          the ISR stores the result, programs the next channel and sets
+ *          ADSC, so each conversion samples the channel it is stored under.
+ *          The restart costs a few cycles per conversion against free
+ *          running, and keeps frames exact when the mask changes.
+ *
+ *          Quiet conversions (noise reduction reads and ADC_SCAN_QUIET_*
+ *          scans) are the same single conversions with the ADSC write left
+ *          to hal_power_sleep(): entering noise reduction sleep starts them.
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "hal_adc.h"
+#include "hal_ring.h"
+#include "hal_frame.h"
+#include "hal_timer.h"
+#include "hal_power.h"
+
+/* =============================================================================
+ * Private State
+ * ========================================================================== */
+
+static volatile uint16_t s_buffer[ADC_STREAM_BUFFER_SIZE];
+static hal_ring16_t s_ring;
+
+static adc_channel_t s_channels[ADC_STREAM_MAX_CHANNELS];
+static uint8_t s_num_channels;
+
+/** @brief Scan index of the conversion in progress */
+static volatile uint8_t s_converting;
+
+/** @brief Scan index currently in MUX (used by the next conversion) */
+static volatile uint8_t s_muxed;
+
+static volatile uint16_t s_overruns;
+
+/** @brief Which producer ADC_vect serves */
+typedef enum {
+    ADC_MODE_IDLE = 0,
+    ADC_MODE_STREAM,
+    ADC_MODE_SCAN,
+    ADC_MODE_READ
+} adc_mode_t;
+
+static volatile uint8_t s_mode;
+
+/** @brief ADC clock prescaler set by hal_adc_init() (ADPS = 111) */
+#define ADC_PRESCALER           128UL
+
+/** @brief Timer2 counts paused per noise reduction conversion: 13.5 ADC
+ *         clocks from the halt (single conversion, sample and hold at 1.5) */
+#define ADC_QUIET_TIMER_COUNTS  ((uint8_t)((27UL * ADC_PRESCALER) / (2UL * TIMER_PRESCALER)))
+
+/* Quiet conversions */
+static volatile bool s_quiet;               /**< Conversions wait for a sleep */
+static volatile bool s_quiet_nr;            /**< Pending one runs in noise reduction */
+static volatile uint32_t s_read_sum;
+static volatile uint16_t s_read_remaining;
+
+/* Scan sequencer */
+static adc_channel_t s_scan_channels[ADC_SCAN_MAX_CHANNELS];
+static uint8_t s_scan_count;
+static bool s_scan_continuous;
+static hal_frame_buffer_t s_scan_frames;
+static hal_frame_t* s_scan_frame;
+
+/* =============================================================================
+ * Interrupt Service Routine
+ * ========================================================================== */
+
+/**
+ * @brief   Select a channel and start one conversion (quiet: leave it to
+ *          the next hal_power_sleep())
+ */
+static inline void adc_convert(adc_channel_t channel)
+{
+    ADMUX = (ADMUX & 0xF0U) | (channel & 0x0FU);
+    if (!s_quiet) {
+        ADCSRA |= (1U << ADSC);
+    }
+}
+
+/**
+ * @brief   Quiet read: accumulate until the oversampling count is reached
+ */
+static inline void read_isr(uint16_t value)
+{
+    s_read_sum += value;
+    s_read_remaining--;
+    if (s_read_remaining == 0U) {
+        ADCSRA &= (uint8_t)~(1U << ADIE);
+        s_quiet = false;
+        s_mode = ADC_MODE_IDLE;
+    }
+}
+
+/**
+ * @brief   Scan: store the result, then start the next channel or frame
+ */
+static inline void scan_isr(uint16_t value)
+{
+    (void)hal_frame_put(s_scan_frame, value);
+    if (s_scan_frame->count < s_scan_count) {
+        adc_convert(s_scan_channels[s_scan_frame->count]);
+        return;
+    }
+
+    hal_frame_publish(&s_scan_frames);
+    if (!s_scan_continuous) {
+        ADCSRA &= (uint8_t)~(1U << ADIE);
+        s_quiet = false;
+        s_mode = ADC_MODE_IDLE;
+        return;
+    }
+    s_scan_frame = hal_frame_begin(&s_scan_frames, hal_timer_millis());
+    adc_convert(s_scan_channels[0]);
+}
+
+/**
+ * @brief   Stream: publish the tagged sample, advance the channel list
+ */
+static inline void stream_isr(uint16_t value)
+{
+    adc_channel_t channel = s_channels[s_converting];
+
+    if (!hal_ring16_push(&s_ring, (uint16_t)(((uint16_t)channel << 12) | value))) {
+        if (s_overruns != 0xFFFFU) {
+            s_overruns++;
+        }
+    }
+
+    /* The conversion just started uses the MUX value programmed last time */
+    s_converting = s_muxed;
+
+    uint8_t next = (uint8_t)(s_muxed + 1U);
+    if (next >= s_num_channels) {
+        next = 0U;
+    }
+    s_muxed = next;
+    ADMUX = (ADMUX & 0xF0U) | (s_channels[next] & 0x0FU);
+}
+
+/**
+ * @brief   Conversion complete: hand the result to the active producer
+ */
+ISR(ADC_vect)
+{
+    uint16_t value = ADC;
+
+    if (s_quiet_nr) {
+        s_quiet_nr = false;
+        hal_timer_credit(ADC_QUIET_TIMER_COUNTS);
+    }
+
+    if (s_mode == ADC_MODE_SCAN) {
+        scan_isr(value);
+    } else if (s_mode == ADC_MODE_READ) {
+        read_isr(value);
+    } else {
+        stream_isr(value);
+    }
+}
+
+/**
+ * @brief   Stop either producer after the conversion in progress
+ */
+static void adc_stop(void)
+{
+    ADCSRA &= (uint8_t)~((1U << ADATE) | (1U << ADIE));
+    s_quiet = false;
+    s_quiet_nr = false;
+    s_mode = ADC_MODE_IDLE;
+}
+
+/* =============================================================================
+ * Streaming API
+ * ========================================================================== */
+
+/**
+ * @brief   Start free-running conversions over a channel list
+ * @param   channels Channels to scan, in order (copied)
+ * @param   num_channels Number of channels (1 to ADC_STREAM_MAX_CHANNELS)
+ * @return  ADC_OK, or ADC_ERROR_INVALID_CHANNEL for a bad list
+ */
+adc_status_t hal_adc_stream_start(const adc_channel_t* channels, uint8_t num_channels)
+{
+    if ((channels == NULL) || (num_channels == 0U) || (num_channels > ADC_STREAM_MAX_CHANNELS)) {
+        return ADC_ERROR_INVALID_CHANNEL;
+    }
+    for (uint8_t i = 0U; i < num_channels; i++) {
+        if (channels[i] > ADC_CHANNEL_GND) {
+            return ADC_ERROR_INVALID_CHANNEL;
+        }
+    }
+
+    adc_stop();
+
+    for (uint8_t i = 0U; i < num_channels; i++) {
+        s_channels[i] = channels[i];
+    }
+    s_num_channels = num_channels;
+    s_converting = 0U;
+    s_muxed = 0U;
+    s_overruns = 0U;
+    hal_ring16_init(&s_ring, s_buffer, ADC_STREAM_BUFFER_SIZE);
+
+    /* First two conversions both use channel 0; the scan advances in the ISR */
+    ADMUX = (ADMUX & 0xF0U) | (s_channels[0] & 0x0FU);
+    ADCSRB = 0U;                                    /* ADTS = free running */
+    ADCSRA |= (1U << ADIF);                         /* Clear stale flag */
+    s_mode = ADC_MODE_STREAM;
+    ADCSRA |= (1U << ADATE) | (1U << ADIE) | (1U << ADSC);
+    return ADC_OK;
+}
+
+/**
+ * @brief   Stop streaming after the conversion in progress
+ */
+void hal_adc_stream_stop(void)
+{
+    if (s_mode == ADC_MODE_STREAM) {
+        adc_stop();
+    }
+}
+
+/**
+ * @brief   Take the oldest streamed sample (non-blocking)
+ * @param   p_sample Receives the packed sample
+ * @return  ADC_OK, or ADC_ERROR_EMPTY if no sample is waiting
+ */
+adc_status_t hal_adc_stream_read(uint16_t* p_sample)
+{
+    return hal_ring16_pop(&s_ring, p_sample) ? ADC_OK : ADC_ERROR_EMPTY;
+}
+
+/**
+ * @brief   Number of streamed samples waiting
+ * @return  0 to ADC_STREAM_BUFFER_SIZE
+ */
+uint8_t hal_adc_stream_available(void)
+{
+    return hal_ring16_count(&s_ring);
+}
+
+/**
+ * @brief   Samples dropped because the ring was full
+ * @return  Overrun count since hal_adc_stream_start() (saturates at 0xFFFF)
+ */
+uint16_t hal_adc_stream_overruns(void)
+{
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t overruns = s_overruns;
+    SREG = sreg;
+    return overruns;
+}
+
+/* =============================================================================
+ * Scan Sequencer API
+ * ========================================================================== */
+
+/**
+ * @brief   Start converting every channel in a mask, one frame at a time
+ * @param   channel_mask ADC_SCAN_MASK() bits of channels 0-15
+ * @param   mode One of adc_scan_mode_t
+ * @return  ADC_OK, or ADC_ERROR_INVALID_CHANNEL for an empty or too large mask
+ */
+adc_status_t hal_adc_scan_start(uint16_t channel_mask, adc_scan_mode_t mode)
+{
+    uint8_t count = 0U;
+
+    for (uint8_t ch = 0U; ch <= ADC_CHANNEL_GND; ch++) {
+        if ((channel_mask & ADC_SCAN_MASK(ch)) != 0U) {
+            if (count >= ADC_SCAN_MAX_CHANNELS) {
+                return ADC_ERROR_INVALID_CHANNEL;
+            }
+            s_scan_channels[count] = ch;
+            count++;
+        }
+    }
+    if (count == 0U) {
+        return ADC_ERROR_INVALID_CHANNEL;
+    }
+
+    /* Wait out a conversion still running so its ISR cannot land mid-setup */
+    adc_stop();
+    uint16_t guard = ADC_DEFAULT_TIMEOUT;
+    while (((ADCSRA & (1U << ADSC)) != 0U) && (guard != 0U)) {
+        guard--;
+    }
+
+    s_scan_count = count;
+    s_scan_continuous = (mode == ADC_SCAN_CONTINUOUS) || (mode == ADC_SCAN_QUIET_CONTINUOUS);
+    s_quiet = (mode == ADC_SCAN_QUIET_ONE_SHOT) || (mode == ADC_SCAN_QUIET_CONTINUOUS);
+    hal_frame_init(&s_scan_frames);
+    s_scan_frame = hal_frame_begin(&s_scan_frames, hal_timer_millis());
+
+    ADCSRA |= (1U << ADIF);                         /* Clear stale flag */
+    s_mode = ADC_MODE_SCAN;
+    ADCSRA |= (1U << ADIE);
+    adc_convert(s_scan_channels[0]);
+    return ADC_OK;
+}
+
+/**
+ * @brief   Stop scanning after the conversion in progress
+ */
+void hal_adc_scan_stop(void)
+{
+    if (s_mode == ADC_MODE_SCAN) {
+        adc_stop();
+    }
+}
+
+/**
+ * @brief   Frame conversions are in progress
+ * @return  true until a one-shot frame is published or the scan is stopped
+ */
+bool hal_adc_scan_busy(void)
+{
+    return (s_mode == ADC_MODE_SCAN);
+}
+
+/**
+ * @brief   Borrow the newest complete frame (non-blocking)
+ * @return  Frame valid until hal_adc_scan_release(), or NULL if none is new
+ */
+const hal_frame_t* hal_adc_scan_acquire(void)
+{
+    return hal_frame_acquire(&s_scan_frames);
+}
+
+/**
+ * @brief   Return the borrowed frame to the sequencer
+ */
+void hal_adc_scan_release(void)
+{
+    hal_frame_release(&s_scan_frames);
+}
+
+/**
+ * @brief   Frames replaced before they were acquired
+ * @return  Count since hal_adc_scan_start() (saturates at 0xFFFF)
+ */
+uint16_t hal_adc_scan_dropped(void)
+{
+    return hal_frame_dropped(&s_scan_frames);
+}
+
+/* =============================================================================
+ * Quiet Conversion API
+ * ========================================================================== */
+
+/**
+ * @brief   Oversampled reading with the CPU asleep for every conversion
+ * @param   channel ADC channel (0-15)
+ * @param   extra_bits Bits gained by decimation (0 to ADC_OVERSAMPLE_MAX_BITS)
+ * @param   p_value Receives the decimated result, or ADC_ERROR_VALUE
+ * @return  ADC_OK, ADC_ERROR_INVALID_CHANNEL, ADC_ERROR_BUSY or ADC_ERROR_TIMEOUT
+ */
+adc_status_t hal_adc_read_oversampled(adc_channel_t channel, uint8_t extra_bits, uint16_t* p_value)
+{
+    if (p_value != NULL) {
+        *p_value = ADC_ERROR_VALUE;
+    }
+    if ((channel > ADC_CHANNEL_GND) || (extra_bits > ADC_OVERSAMPLE_MAX_BITS)) {
+        return ADC_ERROR_INVALID_CHANNEL;
+    }
+    if ((ADCSRA & ((1U << ADATE) | (1U << ADIE))) != 0U) {
+        return ADC_ERROR_BUSY;
+    }
+
+    uint16_t conversions = (uint16_t)(1U << (2U * extra_bits));
+    uint16_t sleeps = (uint16_t)(conversions * ADC_QUIET_MAX_WAKES);
+
+    s_read_sum = 0UL;
+    s_read_remaining = conversions;
+    s_quiet = true;
+    s_mode = ADC_MODE_READ;
+    ADMUX = (ADMUX & 0xF0U) | (channel & 0x0FU);
+    ADCSRA |= (1U << ADIF);                         /* Clear stale flag */
+    ADCSRA |= (1U << ADIE);
+
+    /* Same check-then-sleep as the main loop: the ISR cannot slip between */
+    while (true) {
+        cli();
+        if (s_read_remaining == 0U) {
+            sei();
+            break;
+        }
+        if (sleeps == 0U) {
+            sei();
+            adc_stop();
+            return ADC_ERROR_TIMEOUT;
+        }
+        sleeps--;
+        hal_power_sleep();
+    }
+
+    if (p_value != NULL) {
+        *p_value = (uint16_t)(s_read_sum >> extra_bits);
+    }
+    return ADC_OK;
+}
+
+/**
+ * @brief   One conversion with the CPU asleep
+ * @param   channel ADC channel (0-15)
+ * @param   p_value Receives the result (0-1023), or ADC_ERROR_VALUE
+ * @return  As hal_adc_read_oversampled()
+ */
+adc_status_t hal_adc_read_quiet(adc_channel_t channel, uint16_t* p_value)
+{
+    return hal_adc_read_oversampled(channel, 0U, p_value);
+}
+
+/**
+ * @brief   A quiet conversion is waiting for the CPU to halt
+ * @return  true when hal_power_sleep() should start it
+ */
+bool hal_adc_quiet_pending(void)
+{
+    return s_quiet && (s_mode != ADC_MODE_IDLE) &&
+           ((ADCSRA & ((1U << ADEN) | (1U << ADSC))) == (1U << ADEN));
+}
+
+/**
+ * @brief   Hand the waiting quiet conversion to the coming sleep
+ * @param   noise_reduction true: started by entering noise reduction sleep;
+ *          false: started now, then idle sleep
+ */
+void hal_adc_quiet_start(bool noise_reduction)
+{
+    if (noise_reduction) {
+        s_quiet_nr = true;
+    } else {
+        ADCSRA |= (1U << ADSC);
+    }
+}
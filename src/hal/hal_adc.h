@@ -6,6 +6,25 @@
  *
  * @details All blocking functions include timeout guards per Engineer/JPL
  *          coding standard requirement for bounded loops.
+ *
+ *          Streaming mode (hal_adc.c) runs the ADC free-running with the
+ *          conversion-complete interrupt, scanning a channel list and
+ *          pushing tagged samples into a lock-free ring. The main loop
+ *          drains it with the non-blocking hal_adc_stream_read().
+ *
+ *          Scan mode (hal_adc.c) converts a channel mask once per frame in
+ *          the same interrupt and publishes each complete frame, with the
+ *          tick it started on, through a double buffer (hal_frame.h). The
+ *          consumer borrows the newest frame in place: its values array can
+ *          go straight to hdc_encode_multi_channel().
+ *
+ *          Quiet conversions are started by the CPU halting rather than by
+ *          ADSC (hal_power_sleep()): the core and, when the UART is idle,
+ *          the whole I/O clock are stopped while the ADC samples, which
+ *          removes most of the digital noise hal_adc_read_averaged() pays
+ *          for. hal_adc_read_oversampled() adds 4^n quiet conversions in the
+ *          ISR and decimates them to 10 + n bits. ADC_SCAN_QUIET_* scans
+ *          convert only while the scheduler sleeps.
  */
 
 #ifndef HAL_ADC_H
@@ -14,6 +33,9 @@
 #include <avr/io.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
+
+#include "hal_frame.h"
 
 #define ADC_CHANNEL_0       0U
 #define ADC_CHANNEL_1       1U
@@ -39,12 +61,48 @@
 /** @brief Error value returned on timeout (impossible ADC value) */
 #define ADC_ERROR_VALUE     0xFFFFU
 
+/** @brief Channels in one streaming scan list */
+#define ADC_STREAM_MAX_CHANNELS 8U
+
+/** @brief Streaming ring capacity in samples (power of two, <= 128) */
+#ifndef ADC_STREAM_BUFFER_SIZE
+#define ADC_STREAM_BUFFER_SIZE  32U
+#endif
+
+/** @brief Extra bits hal_adc_read_oversampled() can resolve (4^6 conversions) */
+#define ADC_OVERSAMPLE_MAX_BITS 6U
+
+/** @brief Sleeps allowed per quiet conversion before a read gives up */
+#define ADC_QUIET_MAX_WAKES     4U
+
+/** @brief Channels in one scan frame (set bits of the channel mask) */
+#define ADC_SCAN_MAX_CHANNELS   HAL_FRAME_MAX_VALUES
+
+/** @brief Channel mask bit for hal_adc_scan_start() */
+#define ADC_SCAN_MASK(ch)       ((uint16_t)(1U << (ch)))
+
+/** @brief Channel field of a streamed sample (bits 12-15) */
+#define ADC_SAMPLE_CHANNEL(s)   ((adc_channel_t)((uint16_t)(s) >> 12))
+
+/** @brief Conversion result of a streamed sample (bits 0-9) */
+#define ADC_SAMPLE_VALUE(s)     ((uint16_t)((s) & 0x03FFU))
+
 typedef uint8_t adc_channel_t;
 
+/** @brief Scan sequencer modes */
+typedef enum {
+    ADC_SCAN_ONE_SHOT = 0,      /**< One frame, then the ADC is free again */
+    ADC_SCAN_CONTINUOUS,        /**< Frames back to back until stopped */
+    ADC_SCAN_QUIET_ONE_SHOT,    /**< One frame, converted during sleeps */
+    ADC_SCAN_QUIET_CONTINUOUS   /**< Frames converted during sleeps until stopped */
+} adc_scan_mode_t;
+
 typedef enum {
     ADC_OK = 0,
     ADC_ERROR_INVALID_CHANNEL,
-    ADC_ERROR_TIMEOUT
+    ADC_ERROR_TIMEOUT,
+    ADC_ERROR_BUSY,
+    ADC_ERROR_EMPTY
 } adc_status_t;
 
 static inline void hal_adc_init(void)
@@ -63,13 +121,21 @@ static inline void hal_adc_set_reference(uint8_t ref)
  * @param   channel ADC channel to read
  * @param   p_value Pointer to store result
  * @param   timeout Maximum iterations to wait (0 = use default)
- * @return  ADC_OK on success, ADC_ERROR_TIMEOUT if conversion didn't complete
+ * @return  ADC_OK on success, ADC_ERROR_TIMEOUT if conversion didn't complete,
+ *          ADC_ERROR_BUSY while streaming or scanning is active
  * @pre     hal_adc_init() must be called first
  */
 static inline adc_status_t hal_adc_read_timeout(adc_channel_t channel, uint16_t* p_value, uint16_t timeout)
 {
     uint16_t counter = (timeout == 0U) ? ADC_DEFAULT_TIMEOUT : timeout;
 
+    if ((ADCSRA & ((1U << ADATE) | (1U << ADIE))) != 0U) {
+        if (p_value != NULL) {
+            *p_value = ADC_ERROR_VALUE;
+        }
+        return ADC_ERROR_BUSY;
+    }
+
     ADMUX = (ADMUX & 0xF0U) | (channel & 0x0FU);
     ADCSRA |= (1U << ADSC);
 
@@ -102,6 +168,11 @@ static inline uint16_t hal_adc_read(adc_channel_t channel)
     return value;
 }
 
+/**
+ * @brief   Average samples blocking reads
+ * @note    The CPU spins through every conversion; battery builds should
+ *          prefer hal_adc_read_oversampled(), which sleeps through them
+ */
 static inline uint16_t hal_adc_read_averaged(adc_channel_t channel, uint8_t samples)
 {
     uint32_t sum = 0U;
@@ -122,4 +193,149 @@ static inline int16_t hal_adc_to_temp_celsius(uint16_t adc_value)
     return (int16_t)((mv - 500U) / 10U);
 }
 
+/* =============================================================================
+ * Interrupt-Driven Streaming (hal_adc.c)
+ * ========================================================================== */
+
+/**
+ * @brief   Start free-running conversions over a channel list
+ * @param   channels Channels to scan, in order (copied)
+ * @param   num_channels Number of channels (1 to ADC_STREAM_MAX_CHANNELS)
+ * @return  ADC_OK, or ADC_ERROR_INVALID_CHANNEL for a bad list
+ * @pre     hal_adc_init() called; global interrupts enabled (sei())
+ *
+ * @details Samples are produced every 13 ADC clocks (~9.6 kHz total at the
+ *          125 kHz ADC clock) independent of the main loop. Each sample is
+ *          packed as (channel << 12) | value; see ADC_SAMPLE_CHANNEL() and
+ *          ADC_SAMPLE_VALUE(). While streaming, blocking reads return
+ *          ADC_ERROR_BUSY.
+ */
+adc_status_t hal_adc_stream_start(const adc_channel_t* channels, uint8_t num_channels);
+
+/**
+ * @brief   Stop streaming after the conversion in progress
+ * @note    Samples already in the ring remain readable
+ */
+void hal_adc_stream_stop(void);
+
+/**
+ * @brief   Take the oldest streamed sample (non-blocking)
+ * @param   p_sample Receives the packed sample
+ * @return  ADC_OK, or ADC_ERROR_EMPTY if no sample is waiting
+ */
+adc_status_t hal_adc_stream_read(uint16_t* p_sample);
+
+/**
+ * @brief   Number of streamed samples waiting
+ * @return  0 to ADC_STREAM_BUFFER_SIZE
+ */
+uint8_t hal_adc_stream_available(void);
+
+/**
+ * @brief   Samples dropped because the ring was full
+ * @return  Overrun count since hal_adc_stream_start() (saturates at 0xFFFF)
+ */
+uint16_t hal_adc_stream_overruns(void);
+
+/* =============================================================================
+ * Quiet Conversions (hal_adc.c)
+ * ========================================================================== */
+
+/**
+ * @brief   Oversampled reading with the CPU asleep for every conversion
+ * @param   channel ADC channel (0-15)
+ * @param   extra_bits Bits gained by decimation (0 to ADC_OVERSAMPLE_MAX_BITS)
+ * @param   p_value Receives the sum of 4^extra_bits conversions shifted right
+ *          by extra_bits (0 to (1024 << extra_bits) - 1), or ADC_ERROR_VALUE
+ * @return  ADC_OK, ADC_ERROR_INVALID_CHANNEL, ADC_ERROR_BUSY while streaming
+ *          or scanning, or ADC_ERROR_TIMEOUT after ADC_QUIET_MAX_WAKES
+ *          sleeps per conversion
+ * @pre     hal_adc_init() called; main context with interrupts enabled
+ *
+ * @details Each conversion starts when hal_power_sleep() halts the CPU and
+ *          the ISR accumulates it, so nothing polls ADSC. The extra bits are
+ *          real only with at least 1 LSB of noise at the input, which the
+ *          Uno's supply usually provides; decimation then trades 4x the
+ *          conversions for each bit instead of 4x the blocking reads.
+ */
+adc_status_t hal_adc_read_oversampled(adc_channel_t channel, uint8_t extra_bits, uint16_t* p_value);
+
+/**
+ * @brief   One conversion with the CPU asleep
+ * @param   channel ADC channel (0-15)
+ * @param   p_value Receives the result (0-1023), or ADC_ERROR_VALUE
+ * @return  As hal_adc_read_oversampled()
+ */
+adc_status_t hal_adc_read_quiet(adc_channel_t channel, uint16_t* p_value);
+
+/**
+ * @brief   A quiet conversion is waiting for the CPU to halt
+ * @return  true when hal_power_sleep() should start it
+ * @pre     Interrupts disabled
+ */
+bool hal_adc_quiet_pending(void);
+
+/**
+ * @brief   Hand the waiting quiet conversion to the coming sleep
+ * @param   noise_reduction true: started by entering noise reduction sleep
+ *          (the ISR credits Timer2); false: started now, then idle sleep
+ * @pre     Interrupts disabled; hal_adc_quiet_pending()
+ */
+void hal_adc_quiet_start(bool noise_reduction);
+
+/* =============================================================================
+ * Scan Sequencer (hal_adc.c)
+ * ========================================================================== */
+
+/**
+ * @brief   Start converting every channel in a mask, one frame at a time
+ * @param   channel_mask ADC_SCAN_MASK() bits of channels 0-15, at most
+ *          ADC_SCAN_MAX_CHANNELS set; converted from the lowest up
+ * @param   mode One of adc_scan_mode_t
+ * @return  ADC_OK, or ADC_ERROR_INVALID_CHANNEL for an empty or too large mask
+ * @pre     hal_adc_init() and hal_timer_init() called; global interrupts
+ *          enabled; no frame held (hal_adc_scan_release())
+ *
+ * @details Stops streaming or a scan in progress. Each conversion runs in
+ *          single-conversion mode with the MUX set for its own channel
+ *          before it starts, so no sample is taken on a stale MUX setting.
+ *          A frame of n channels takes n x 13 ADC clocks (n x 104 us at
+ *          125 kHz), so its values are at most that far apart; its stamp is
+ *          the hal_timer_millis() tick of the first conversion. In one-shot
+ *          mode, call again for the next frame. Quiet modes leave each
+ *          conversion waiting for hal_power_sleep(), so a frame completes
+ *          over the scheduler's next n sleeps.
+ */
+adc_status_t hal_adc_scan_start(uint16_t channel_mask, adc_scan_mode_t mode);
+
+/**
+ * @brief   Stop scanning after the conversion in progress
+ * @note    A frame already published stays readable; a partial one is lost
+ */
+void hal_adc_scan_stop(void);
+
+/**
+ * @brief   Frame conversions are in progress
+ * @return  true until a one-shot frame is published or the scan is stopped
+ */
+bool hal_adc_scan_busy(void);
+
+/**
+ * @brief   Borrow the newest complete frame (non-blocking)
+ * @return  Frame, values in channel order, valid until
+ *          hal_adc_scan_release(); NULL if none is new since the last call
+ */
+const hal_frame_t* hal_adc_scan_acquire(void);
+
+/**
+ * @brief   Return the borrowed frame to the sequencer
+ */
+void hal_adc_scan_release(void);
+
+/**
+ * @brief   Frames replaced before they were acquired
+ * @return  Count since hal_adc_scan_start() (saturates at 0xFFFF)
+ */
+uint16_t hal_adc_scan_dropped(void);
+
 #endif /* HAL_ADC_H */
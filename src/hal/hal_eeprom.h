@@ -0,0 +1,68 @@
+/**
+ * @file    hal_eeprom.h
+ * @brief   HAL - EEPROM (Non-Blocking Byte Writes)
+ * @version 1.0.0
+ * @note    Target: ATmega328P, 1 KB EEPROM, ~3.4 ms per erase+write
+ *
+ * @details hal_eeprom_write() only starts a write and returns; the cell is
+ *          programmed in the background while the CPU keeps running, and
+ *          hal_eeprom_busy() reports when the next access may start. This
+ *          lets hdc_store.h commit a model one byte per scheduler slot
+ *          instead of stalling for milliseconds per byte.
+ */
+
+#ifndef HAL_EEPROM_H
+#define HAL_EEPROM_H
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief EEPROM size in bytes */
+#define HAL_EEPROM_SIZE     1024U
+
+/**
+ * @brief   Whether a write is still being programmed
+ * @return  true while EEPE is set
+ */
+static inline bool hal_eeprom_busy(void)
+{
+    return ((EECR & (1U << EEPE)) != 0U);
+}
+
+/**
+ * @brief   Read one byte
+ * @param   addr Byte address (0 to HAL_EEPROM_SIZE-1)
+ * @return  Stored value
+ * @pre     !hal_eeprom_busy()
+ */
+static inline uint8_t hal_eeprom_read(uint16_t addr)
+{
+    EEAR = addr;
+    EECR |= (uint8_t)(1U << EERE);
+    return EEDR;
+}
+
+/**
+ * @brief   Start an atomic erase+write of one byte
+ * @param   addr Byte address (0 to HAL_EEPROM_SIZE-1)
+ * @param   value Value to program
+ * @pre     !hal_eeprom_busy()
+ *
+ * @details EEPE must be set within four cycles of EEMPE, so interrupts are
+ *          held off across the pair.
+ */
+static inline void hal_eeprom_write(uint16_t addr, uint8_t value)
+{
+    EEAR = addr;
+    EEDR = value;
+
+    uint8_t sreg = SREG;
+    cli();
+    EECR = (uint8_t)(1U << EEMPE);      /* EEPM = 00: erase and write */
+    EECR |= (uint8_t)(1U << EEPE);
+    SREG = sreg;
+}
+
+#endif /* HAL_EEPROM_H */
@@ -0,0 +1,221 @@
+/**
+ * @file    hal_frame.h
+ * @brief   HAL - Lock-Free Double-Buffered Frame Exchange
+ * @version 1.0.0
+ * @note    Portable (no AVR dependencies); producer is typically an ISR
+ *
+ * @details A producer fills fixed-size frames of 16-bit values and publishes
+ *          each one whole; the consumer borrows the newest complete frame
+ *          in place and hands it back. Two frames are used: while the
+ *          consumer holds one, the producer fills the other, so a frame is
+ *          never read while it is written and nothing is copied.
+ *
+ *          The producer only writes fill, ready and published; the consumer
+ *          only writes held, taken and dropped. Every shared field is a
+ *          single byte, so on the ATmega328P each access is atomic and no
+ *          interrupt masking is needed:
+ *
+ *            - hal_frame_begin() fills the frame the consumer does not hold.
+ *              If that is the unread ready frame, it is withdrawn first.
+ *            - hal_frame_acquire() marks the ready frame held, then checks
+ *              it is still the ready one; if not, the producer may already
+ *              be refilling it and nothing is returned.
+ *
+ *          A consumer slower than the producer keeps only the newest frame;
+ *          the frames it never saw are counted in dropped.
+ *
+ *          Each step is ordered with HDC_BARRIER() (hdc_sync.h). On a host
+ *          that is a full fence, which the store-then-check in
+ *          hal_frame_acquire() needs when the two sides run on different
+ *          cores.
+ */
+
+#ifndef HAL_FRAME_H
+#define HAL_FRAME_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "hdc_sync.h"
+
+/** @brief Values per frame */
+#define HAL_FRAME_MAX_VALUES    8U
+
+/** @brief No frame (ready and held fields) */
+#define HAL_FRAME_NONE          0xFFU
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief One complete set of values from the same pass */
+typedef struct {
+    uint32_t stamp;                         /**< Producer time of the first value */
+    uint16_t values[HAL_FRAME_MAX_VALUES];  /**< Values in producer order */
+    uint8_t  count;                         /**< Values written */
+    uint8_t  sequence;                      /**< Publication number (wraps, never 0) */
+} hal_frame_t;
+
+/** @brief Two frames and their ownership */
+typedef struct {
+    hal_frame_t      frames[2];
+    volatile uint8_t fill;                  /**< Frame being filled (producer only) */
+    volatile uint8_t ready;                 /**< Newest complete frame (producer only) */
+    volatile uint8_t published;             /**< Frames completed, wraps (producer only) */
+    volatile uint8_t held;                  /**< Frame borrowed (consumer only) */
+    uint8_t          taken;                 /**< Sequence last acquired (consumer only) */
+    uint16_t         dropped;               /**< Frames never acquired (consumer only) */
+} hal_frame_buffer_t;
+
+/* =============================================================================
+ * Setup
+ * ========================================================================== */
+
+/**
+ * @brief   Initialize with no frame ready or held
+ * @param   buf Frame buffer
+ * @pre     Neither side may be using the buffer
+ */
+static inline void hal_frame_init(hal_frame_buffer_t* buf)
+{
+    buf->fill = 0U;
+    buf->ready = HAL_FRAME_NONE;
+    buf->published = 0U;
+    buf->held = HAL_FRAME_NONE;
+    buf->taken = 0U;
+    buf->dropped = 0U;
+    buf->frames[0].count = 0U;
+    buf->frames[1].count = 0U;
+}
+
+/* =============================================================================
+ * Producer Side
+ * ========================================================================== */
+
+/**
+ * @brief   Start a frame in the buffer the consumer does not hold
+ * @param   buf Frame buffer
+ * @param   stamp Time of the first value (stored as is)
+ * @return  Frame to fill with hal_frame_put()
+ */
+static inline hal_frame_t* hal_frame_begin(hal_frame_buffer_t* buf, uint32_t stamp)
+{
+    uint8_t held = buf->held;
+    uint8_t fill;
+
+    if (held != HAL_FRAME_NONE) {
+        fill = (uint8_t)(held ^ 1U);
+    } else {
+        fill = (buf->ready == 0U) ? 1U : 0U;
+    }
+    if (buf->ready == fill) {
+        buf->ready = HAL_FRAME_NONE;        /* Unread: withdrawn before reuse */
+    }
+    HDC_BARRIER();
+
+    hal_frame_t* frame = &buf->frames[fill];
+    buf->fill = fill;
+    frame->stamp = stamp;
+    frame->count = 0U;
+    return frame;
+}
+
+/**
+ * @brief   Append a value to the frame being filled
+ * @param   frame Frame from hal_frame_begin()
+ * @param   value Value to append
+ * @return  true on success, false if the frame is full (value dropped)
+ */
+static inline bool hal_frame_put(hal_frame_t* frame, uint16_t value)
+{
+    if (frame->count >= HAL_FRAME_MAX_VALUES) {
+        return false;
+    }
+    frame->values[frame->count] = value;
+    frame->count++;
+    return true;
+}
+
+/**
+ * @brief   Publish the frame being filled as the newest complete frame
+ * @param   buf Frame buffer
+ */
+static inline void hal_frame_publish(hal_frame_buffer_t* buf)
+{
+    uint8_t fill = buf->fill;
+    uint8_t sequence = (uint8_t)(buf->published + 1U);
+
+    if (sequence == 0U) {
+        sequence = 1U;
+    }
+    buf->frames[fill].sequence = sequence;
+    buf->published = sequence;
+    HDC_BARRIER();
+    buf->ready = fill;
+}
+
+/* =============================================================================
+ * Consumer Side
+ * ========================================================================== */
+
+/**
+ * @brief   Borrow the newest complete frame (non-blocking)
+ * @param   buf Frame buffer
+ * @return  Frame, valid until hal_frame_release(); NULL if no frame was
+ *          published since the last one acquired
+ * @note    A frame still held is released first
+ */
+static inline const hal_frame_t* hal_frame_acquire(hal_frame_buffer_t* buf)
+{
+    buf->held = HAL_FRAME_NONE;
+
+    uint8_t ready = buf->ready;
+    if (ready == HAL_FRAME_NONE) {
+        return NULL;
+    }
+    buf->held = ready;
+    HDC_BARRIER();
+    if (buf->ready != ready) {
+        buf->held = HAL_FRAME_NONE;         /* Republished meanwhile: retry later */
+        return NULL;
+    }
+
+    const hal_frame_t* frame = &buf->frames[ready];
+    uint8_t sequence = frame->sequence;
+    if (sequence == buf->taken) {
+        buf->held = HAL_FRAME_NONE;         /* Already seen */
+        return NULL;
+    }
+
+    /* Sequences skip 0, so a gap across the wrap is one smaller */
+    uint8_t gap = (uint8_t)(sequence - buf->taken - 1U);
+    if ((sequence < buf->taken) && (buf->taken != 0U)) {
+        gap--;
+    }
+    uint16_t dropped = (uint16_t)(buf->dropped + gap);
+    buf->dropped = (dropped < buf->dropped) ? 0xFFFFU : dropped;
+    buf->taken = sequence;
+    return frame;
+}
+
+/**
+ * @brief   Hand the borrowed frame back to the producer
+ * @param   buf Frame buffer
+ */
+static inline void hal_frame_release(hal_frame_buffer_t* buf)
+{
+    HDC_BARRIER();
+    buf->held = HAL_FRAME_NONE;
+}
+
+/**
+ * @brief   Frames published but never acquired (consumer side)
+ * @param   buf Frame buffer
+ * @return  Count since hal_frame_init() (saturates at 0xFFFF)
+ */
+static inline uint16_t hal_frame_dropped(const hal_frame_buffer_t* buf)
+{
+    return buf->dropped;
+}
+
+#endif /* HAL_FRAME_H */
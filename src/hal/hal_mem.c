@@ -0,0 +1,86 @@
+/**
+ * @file    hal_mem.c
+ * @brief   HAL - Stack Painting and SRAM Usage
+ * @version 1.0.0
+ * @note    Target: ATmega328P, painting runs from .init3 before main()
+ */
+
+#include <avr/io.h>
+#include <stdint.h>
+
+#include "hal_mem.h"
+
+/* The paint loop below loads the value as an immediate */
+#if HAL_MEM_PAINT != 0xC5U
+#error "hal_mem.c: update the ldi in mem_paint() to match HAL_MEM_PAINT"
+#endif
+
+/* =============================================================================
+ * Linker Symbols
+ * ========================================================================== */
+
+extern uint8_t __data_start;
+extern uint8_t __data_end;
+extern uint8_t __bss_start;
+extern uint8_t __bss_end;
+extern uint8_t _end;
+
+/* =============================================================================
+ * Boot-Time Painting
+ * ========================================================================== */
+
+/**
+ * @brief   Paint _end..RAMEND with HAL_MEM_PAINT
+ * @note    Runs inline in the startup code (.init3): SP and r1 are set up,
+ *          nothing is on the stack yet, and .data/.bss are initialized
+ *          afterwards, so only the free SRAM keeps the paint. Naked and
+ *          assembly only, since there is no frame to run C in.
+ */
+static void __attribute__((naked, used, section(".init3"))) mem_paint(void)
+{
+    __asm__ __volatile__ (
+        "    ldi r30, lo8(_end)      \n"
+        "    ldi r31, hi8(_end)      \n"
+        "    ldi r24, 0xC5           \n"
+        "    ldi r25, hi8(__stack)   \n"
+        "    rjmp 2f                 \n"
+        "1:  st Z+, r24              \n"
+        "2:  cpi r30, lo8(__stack)   \n"
+        "    cpc r31, r25            \n"
+        "    brlo 1b                 \n"
+        "    breq 1b                 \n"
+    );
+}
+
+/* =============================================================================
+ * SRAM Usage API
+ * ========================================================================== */
+
+/**
+ * @brief   Stack bytes never used since reset
+ * @return  Painted bytes left above _end
+ */
+uint16_t hal_mem_stack_unused(void)
+{
+    const uint8_t* p = &_end;
+    const uint8_t* top = (const uint8_t*)RAMEND;
+
+    while ((p <= top) && (*p == HAL_MEM_PAINT)) {
+        p++;
+    }
+    return (uint16_t)((uintptr_t)p - (uintptr_t)&_end);
+}
+
+/**
+ * @brief   Static sizes and the stack high-water mark
+ * @param   usage Filled with the current figures
+ */
+void hal_mem_usage(hal_mem_usage_t* usage)
+{
+    uint16_t end = (uint16_t)(uintptr_t)&_end;
+
+    usage->data_bytes = (uint16_t)((uintptr_t)&__data_end - (uintptr_t)&__data_start);
+    usage->bss_bytes = (uint16_t)((uintptr_t)&__bss_end - (uintptr_t)&__bss_start);
+    usage->stack_bytes = (uint16_t)((RAMEND + 1U) - end);
+    usage->stack_peak = (uint16_t)(usage->stack_bytes - hal_mem_stack_unused());
+}
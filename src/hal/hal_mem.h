@@ -0,0 +1,59 @@
+/**
+ * @file    hal_mem.h
+ * @brief   HAL - Stack Painting and SRAM Usage
+ * @version 1.0.0
+ * @note    Target: ATmega328P (2 KB SRAM, no heap in use)
+ *
+ * @details SRAM as laid out by the avr-libc linker script:
+ *
+ *            0x0100                     _end                    RAMEND
+ *            | .data | .bss |  painted ... <- stack grows down  |
+ *
+ *          Before main() runs (.init3, ahead of the .data copy and the .bss
+ *          clear), every byte from _end up to RAMEND is painted with
+ *          HAL_MEM_PAINT. The stack overwrites the paint as it grows, so the
+ *          painted bytes still left just above _end are headroom the stack
+ *          never reached since reset. A local that happens to hold the
+ *          paint value at the very edge can hide a few bytes of use; size
+ *          budgets with some margin.
+ *
+ *          Static sizes come from the linker symbols. The split per module
+ *          is fixed at link time and read from the linker map by
+ *          scripts/sram_report.py.
+ */
+
+#ifndef HAL_MEM_H
+#define HAL_MEM_H
+
+#include <stdint.h>
+
+/** @brief Value painted over the free SRAM at boot */
+#define HAL_MEM_PAINT       0xC5U
+
+/** @brief SRAM usage since reset */
+typedef struct {
+    uint16_t data_bytes;    /**< Initialized statics (.data) */
+    uint16_t bss_bytes;     /**< Zeroed statics (.bss) */
+    uint16_t stack_bytes;   /**< SRAM left for the stack (_end to RAMEND) */
+    uint16_t stack_peak;    /**< Deepest stack use seen (high-water mark) */
+} hal_mem_usage_t;
+
+/* =============================================================================
+ * SRAM Usage (hal_mem.c)
+ * ========================================================================== */
+
+/**
+ * @brief   Stack bytes never used since reset
+ * @return  Painted bytes left above _end
+ * @note    Scans the headroom (about 6 cycles per byte); call it from a
+ *          slow task, not an ISR
+ */
+uint16_t hal_mem_stack_unused(void);
+
+/**
+ * @brief   Static sizes and the stack high-water mark
+ * @param   usage Filled with the current figures
+ */
+void hal_mem_usage(hal_mem_usage_t* usage);
+
+#endif /* HAL_MEM_H */
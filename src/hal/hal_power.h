@@ -0,0 +1,89 @@
+/**
+ * @file    hal_power.h
+ * @brief   HAL - Sleep Modes
+ * @version 1.1.0
+ * @note    Target: ATmega328P
+ *
+ * @details Idle mode stops the CPU clock only: Timer2, the ADC and the
+ *          USART keep running, and any of their interrupts wakes the core.
+ *          With the 1 kHz system tick the CPU sleeps at most 1 ms at a time.
+ *
+ *          ADC noise reduction mode also stops clk_IO: Timer2, the USART
+ *          and the port logic go quiet while the ADC converts, and the
+ *          conversion-complete interrupt wakes the core. hal_power_sleep()
+ *          picks it whenever the ADC has a quiet conversion waiting
+ *          (hal_adc.h) and the UART has nothing in flight, so the
+ *          scheduler's idle time doubles as the ADC's quiet time.
+ */
+
+#ifndef HAL_POWER_H
+#define HAL_POWER_H
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+#include "hal_adc.h"
+#include "hal_uart.h"
+
+/**
+ * @brief   Enter idle sleep until the next interrupt
+ * @pre     Called with interrupts disabled (cli()) after checking that no
+ *          work is pending; an interrupt that made work pending since that
+ *          check is taken after waking, never lost
+ * @post    Interrupts are enabled
+ *
+ * @details SEI delays interrupts by one instruction, so SEI followed by
+ *          SLEEP cannot be split by an ISR: either the interrupt was already
+ *          pending and wakes the core immediately, or it arrives during sleep.
+ */
+static inline void hal_power_idle(void)
+{
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+}
+
+/**
+ * @brief   Enter ADC noise reduction sleep; a waiting conversion starts
+ *          once the CPU has halted
+ * @pre     As hal_power_idle(); the ADC is enabled with ADIE set, or
+ *          another enabled wake-up source is armed (Timer2 is stopped)
+ * @post    Interrupts are enabled
+ */
+static inline void hal_power_adc_noise_reduction(void)
+{
+    set_sleep_mode(SLEEP_MODE_ADC);
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+}
+
+/**
+ * @brief   Sleep until the next interrupt in the quietest safe mode
+ * @pre     As hal_power_idle()
+ * @post    Interrupts are enabled
+ *
+ * @details Noise reduction when a quiet ADC conversion is waiting and the
+ *          UART is idle: the conversion runs with clk_IO stopped and the
+ *          ADC ISR credits the paused Timer2 counts back to the tick. With
+ *          a byte still shifting out, the conversion is started by hand
+ *          and the CPU idles instead, so the byte is never cut short.
+ */
+static inline void hal_power_sleep(void)
+{
+    if (hal_adc_quiet_pending()) {
+        if (hal_uart_tx_idle()) {
+            hal_adc_quiet_start(true);
+            hal_power_adc_noise_reduction();
+            return;
+        }
+        hal_adc_quiet_start(false);
+    }
+    hal_power_idle();
+}
+
+#endif /* HAL_POWER_H */
@@ -0,0 +1,183 @@
+/**
+ * @file    hal_ring.h
+ * @brief   HAL - Lock-Free Single-Producer / Single-Consumer Ring Buffer
+ * @version 1.0.0
+ * @note    Portable (no AVR dependencies); producer is typically an ISR
+ *
+ * @details One side only ever writes head, the other only ever writes tail,
+ *          and both indices are single bytes, so on the ATmega328P every
+ *          index access is atomic and no interrupt masking is needed.
+ *          Indices run freely modulo 256; the capacity must be a power of
+ *          two no larger than 128 so (head - tail) is always the fill level.
+ *
+ *          The producer writes the slot before publishing head, and the
+ *          consumer reads the slot before releasing tail. The slots are
+ *          volatile so the compiler keeps that order.
+ */
+
+#ifndef HAL_RING_H
+#define HAL_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Largest supported ring capacity (entries) */
+#define HAL_RING_MAX_SIZE   128U
+
+/* =============================================================================
+ * 16-Bit Ring
+ * ========================================================================== */
+
+/** @brief SPSC ring of 16-bit entries over caller storage */
+typedef struct {
+    volatile uint16_t* buffer;  /**< Storage, size entries */
+    volatile uint8_t   head;    /**< Next slot to write (producer only) */
+    volatile uint8_t   tail;    /**< Next slot to read (consumer only) */
+    uint8_t            mask;    /**< size - 1 */
+} hal_ring16_t;
+
+/**
+ * @brief   Initialize an empty ring
+ * @param   ring Ring to initialize
+ * @param   storage Array of size entries
+ * @param   size Capacity, power of two between 2 and HAL_RING_MAX_SIZE
+ * @pre     Neither side may be using the ring
+ */
+static inline void hal_ring16_init(hal_ring16_t* ring, volatile uint16_t* storage, uint8_t size)
+{
+    ring->buffer = storage;
+    ring->head = 0U;
+    ring->tail = 0U;
+    ring->mask = (uint8_t)(size - 1U);
+}
+
+/**
+ * @brief   Number of entries waiting (safe from either side)
+ * @param   ring Ring buffer
+ * @return  Fill level (0 to size)
+ */
+static inline uint8_t hal_ring16_count(const hal_ring16_t* ring)
+{
+    return (uint8_t)(ring->head - ring->tail);
+}
+
+/**
+ * @brief   Append an entry (producer side)
+ * @param   ring Ring buffer
+ * @param   value Entry to append
+ * @return  true on success, false if the ring is full (entry dropped)
+ */
+static inline bool hal_ring16_push(hal_ring16_t* ring, uint16_t value)
+{
+    uint8_t head = ring->head;
+
+    if ((uint8_t)(head - ring->tail) > ring->mask) {
+        return false;
+    }
+    ring->buffer[head & ring->mask] = value;
+    ring->head = (uint8_t)(head + 1U);
+    return true;
+}
+
+/**
+ * @brief   Remove the oldest entry (consumer side)
+ * @param   ring Ring buffer
+ * @param   p_value Receives the entry
+ * @return  true on success, false if the ring is empty
+ */
+static inline bool hal_ring16_pop(hal_ring16_t* ring, uint16_t* p_value)
+{
+    uint8_t tail = ring->tail;
+
+    if (ring->head == tail) {
+        return false;
+    }
+    *p_value = ring->buffer[tail & ring->mask];
+    ring->tail = (uint8_t)(tail + 1U);
+    return true;
+}
+
+/* =============================================================================
+ * Byte Ring
+ * ========================================================================== */
+
+/** @brief SPSC ring of bytes over caller storage */
+typedef struct {
+    volatile uint8_t* buffer;   /**< Storage, size entries */
+    volatile uint8_t  head;     /**< Next slot to write (producer only) */
+    volatile uint8_t  tail;     /**< Next slot to read (consumer only) */
+    uint8_t           mask;     /**< size - 1 */
+} hal_ring8_t;
+
+/**
+ * @brief   Initialize an empty byte ring
+ * @param   ring Ring to initialize
+ * @param   storage Array of size bytes
+ * @param   size Capacity, power of two between 2 and HAL_RING_MAX_SIZE
+ * @pre     Neither side may be using the ring
+ */
+static inline void hal_ring8_init(hal_ring8_t* ring, volatile uint8_t* storage, uint8_t size)
+{
+    ring->buffer = storage;
+    ring->head = 0U;
+    ring->tail = 0U;
+    ring->mask = (uint8_t)(size - 1U);
+}
+
+/**
+ * @brief   Number of bytes waiting (safe from either side)
+ * @param   ring Ring buffer
+ * @return  Fill level (0 to size)
+ */
+static inline uint8_t hal_ring8_count(const hal_ring8_t* ring)
+{
+    return (uint8_t)(ring->head - ring->tail);
+}
+
+/**
+ * @brief   Free space (exact on the producer side, a lower bound elsewhere)
+ * @param   ring Ring buffer
+ * @return  Bytes that can be pushed (0 to size)
+ */
+static inline uint8_t hal_ring8_free(const hal_ring8_t* ring)
+{
+    return (uint8_t)((uint8_t)(ring->mask + 1U) - hal_ring8_count(ring));
+}
+
+/**
+ * @brief   Append a byte (producer side)
+ * @param   ring Ring buffer
+ * @param   value Byte to append
+ * @return  true on success, false if the ring is full (byte dropped)
+ */
+static inline bool hal_ring8_push(hal_ring8_t* ring, uint8_t value)
+{
+    uint8_t head = ring->head;
+
+    if ((uint8_t)(head - ring->tail) > ring->mask) {
+        return false;
+    }
+    ring->buffer[head & ring->mask] = value;
+    ring->head = (uint8_t)(head + 1U);
+    return true;
+}
+
+/**
+ * @brief   Remove the oldest byte (consumer side)
+ * @param   ring Ring buffer
+ * @param   p_value Receives the byte
+ * @return  true on success, false if the ring is empty
+ */
+static inline bool hal_ring8_pop(hal_ring8_t* ring, uint8_t* p_value)
+{
+    uint8_t tail = ring->tail;
+
+    if (ring->head == tail) {
+        return false;
+    }
+    *p_value = ring->buffer[tail & ring->mask];
+    ring->tail = (uint8_t)(tail + 1U);
+    return true;
+}
+
+#endif /* HAL_RING_H */
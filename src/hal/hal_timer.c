@@ -0,0 +1,80 @@
+/**
+ * @file    hal_timer.c
+ * @brief   HAL - System Tick (Timer2)
+ * @version 1.0.0
+ * @note    Target: ATmega328P, TIMER2_COMPA_vect producer
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+
+#include "hal_timer.h"
+
+/* =============================================================================
+ * Private State
+ * ========================================================================== */
+
+static volatile uint32_t s_millis;
+
+/* =============================================================================
+ * Interrupt Service Routine
+ * ========================================================================== */
+
+/**
+ * @brief   Compare match: one millisecond elapsed
+ */
+ISR(TIMER2_COMPA_vect)
+{
+    s_millis++;
+}
+
+/* =============================================================================
+ * System Tick API
+ * ========================================================================== */
+
+/**
+ * @brief   Start the 1 kHz system tick
+ */
+void hal_timer_init(void)
+{
+    TIMSK2 = 0U;
+    TCCR2A = (1U << WGM21);                         /* CTC, TOP = OCR2A */
+    TCCR2B = (1U << CS22);                          /* clk / 64 */
+    OCR2A = TIMER_OCR_VALUE;
+    TCNT2 = 0U;
+    TIFR2 = (1U << OCF2A);                          /* Clear stale flag */
+    s_millis = 0U;
+    TIMSK2 = (1U << OCIE2A);
+}
+
+/**
+ * @brief   Milliseconds since hal_timer_init()
+ * @return  Tick count (wraps after ~49 days)
+ */
+uint32_t hal_timer_millis(void)
+{
+    /* A 32-bit read takes four instructions; keep the ISR out of it */
+    uint8_t sreg = SREG;
+    cli();
+    uint32_t millis = s_millis;
+    SREG = sreg;
+    return millis;
+}
+
+/**
+ * @brief   Credit Timer2 counts lost while the I/O clock was stopped
+ * @param   counts Timer2 counts (4 us each) that elapsed unseen
+ */
+void hal_timer_credit(uint8_t counts)
+{
+    uint16_t count = (uint16_t)TCNT2 + counts;
+
+    /* Writing TCNT2 blocks the compare match for one timer clock, so a
+     * count that reaches OCR2A is turned into the tick here */
+    if (count >= TIMER_OCR_VALUE) {
+        s_millis++;
+        count = (count > TIMER_OCR_VALUE) ? (uint16_t)(count - (TIMER_OCR_VALUE + 1U)) : 0U;
+    }
+    TCNT2 = (uint8_t)count;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file    hal_timer.h
+ * @brief   HAL - System Tick (Timer2)
+ * @version 1.0.0
+ * @note    Target: ATmega328P @ 16MHz, Timer2 CTC, 1 kHz
+ *
+ * @details Timer2 runs in CTC mode with a /64 prescaler and OCR2A = 249,
+ *          so TIMER2_COMPA_vect fires every 1 ms (16 MHz / 64 / 250). The
+ *          ISR only increments a millisecond counter; the application reads
+ *          it with hal_timer_millis() and paces its tasks from it. Timer0
+ *          and Timer1 stay free.
+ */
+
+#ifndef HAL_TIMER_H
+#define HAL_TIMER_H
+
+#include <avr/io.h>
+#include <stdint.h>
+
+/** @brief Tick frequency in Hz */
+#define TIMER_TICK_HZ       1000U
+
+/** @brief Timer2 prescaler selected by CS22 */
+#define TIMER_PRESCALER     64UL
+
+/** @brief Compare value for one tick */
+#define TIMER_OCR_VALUE     ((uint8_t)((F_CPU / (TIMER_PRESCALER * TIMER_TICK_HZ)) - 1UL))
+
+/* =============================================================================
+ * System Tick (hal_timer.c)
+ * ========================================================================== */
+
+/**
+ * @brief   Start the 1 kHz system tick
+ * @note    The counter only advances once global interrupts are enabled
+ */
+void hal_timer_init(void);
+
+/**
+ * @brief   Milliseconds since hal_timer_init()
+ * @return  Tick count (wraps after ~49 days)
+ */
+uint32_t hal_timer_millis(void);
+
+/**
+ * @brief   Credit Timer2 counts lost while the I/O clock was stopped
+ * @param   counts Timer2 counts (4 us each, less than one tick) that
+ *          elapsed unseen
+ * @pre     Interrupts disabled (called from ISRs)
+ * @note    Timer2 runs from clk_IO, which ADC noise reduction sleep stops;
+ *          the ADC ISR calls this after each such conversion (hal_adc.c)
+ */
+void hal_timer_credit(uint8_t counts);
+
+#endif /* HAL_TIMER_H */
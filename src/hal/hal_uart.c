@@ -0,0 +1,131 @@
+/**
+ * @file    hal_uart.c
+ * @brief   HAL - UART Interrupt-Driven Transmit
+ * @version 1.0.0
+ * @note    Target: ATmega328P, USART_UDRE_vect consumer
+ *
+ * @details The main loop produces into a byte ring and sets UDRIE0; the
+ *          data-register-empty ISR moves one byte per interrupt into UDR0
+ *          and clears UDRIE0 once the ring is empty.
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "hal_uart.h"
+#include "hal_ring.h"
+
+/* =============================================================================
+ * Private State
+ * ========================================================================== */
+
+static volatile uint8_t s_tx_buffer[UART_TX_BUFFER_SIZE];
+static hal_ring8_t s_tx_ring;
+static bool s_async;
+
+/* =============================================================================
+ * Interrupt Service Routine
+ * ========================================================================== */
+
+/**
+ * @brief   Data register empty: send the next queued byte
+ */
+ISR(USART_UDRE_vect)
+{
+    uint8_t data;
+
+    if (hal_ring8_pop(&s_tx_ring, &data)) {
+        hal_uart_load(data);
+    } else {
+        UCSR0B &= (uint8_t)~(1U << UDRIE0);
+    }
+}
+
+/* =============================================================================
+ * Buffered Transmit API
+ * ========================================================================== */
+
+/**
+ * @brief   Switch transmission to the interrupt-driven TX ring
+ */
+void hal_uart_async_enable(void)
+{
+    hal_ring8_init(&s_tx_ring, s_tx_buffer, UART_TX_BUFFER_SIZE);
+    s_async = true;
+}
+
+/**
+ * @brief   Whether transmission goes through the TX ring
+ * @return  true after hal_uart_async_enable()
+ */
+bool hal_uart_async_enabled(void)
+{
+    return s_async;
+}
+
+/**
+ * @brief   Queue bytes without waiting (all or nothing)
+ * @param   data Bytes to send
+ * @param   len Number of bytes
+ * @return  UART_OK if all bytes were queued, UART_ERROR_OVERFLOW otherwise
+ *          (also before hal_uart_async_enable())
+ */
+uart_status_t hal_uart_write_nb(const uint8_t* data, uint8_t len)
+{
+    if ((!s_async) || (hal_ring8_free(&s_tx_ring) < len)) {
+        return UART_ERROR_OVERFLOW;
+    }
+
+    for (uint8_t i = 0U; i < len; i++) {
+        (void)hal_ring8_push(&s_tx_ring, data[i]);
+    }
+
+    /* UCSR0B is also written by the ISR; keep the read-modify-write atomic */
+    uint8_t sreg = SREG;
+    cli();
+    UCSR0B |= (1U << UDRIE0);
+    SREG = sreg;
+    return UART_OK;
+}
+
+/**
+ * @brief   Queue a string without waiting (all or nothing)
+ * @param   str NUL-terminated string
+ * @return  UART_OK, or UART_ERROR_OVERFLOW (nothing queued)
+ */
+uart_status_t hal_uart_puts_nb(const char* str)
+{
+    uint8_t len = 0U;
+
+    while (str[len] != '\0') {
+        if (len >= UART_TX_BUFFER_SIZE) {
+            return UART_ERROR_OVERFLOW;
+        }
+        len++;
+    }
+    return hal_uart_write_nb((const uint8_t*)str, len);
+}
+
+/**
+ * @brief   Free space in the TX ring
+ * @return  Bytes that hal_uart_write_nb() would accept now
+ */
+uint8_t hal_uart_tx_free(void)
+{
+    return s_async ? hal_ring8_free(&s_tx_ring) : 0U;
+}
+
+/**
+ * @brief   Nothing queued and the last byte has left the shift register
+ * @return  true when stopping the I/O clock cannot cut a byte short
+ */
+bool hal_uart_tx_idle(void)
+{
+    if (s_async && (hal_ring8_count(&s_tx_ring) != 0U)) {
+        return false;
+    }
+    return ((UCSR0B & (1U << UDRIE0)) == 0U) && ((UCSR0A & (1U << TXC0)) != 0U);
+}
@@ -6,6 +6,12 @@
  *
  * @details All blocking functions include timeout guards per Engineer/JPL
  *          coding standard requirement for bounded loops.
+ *
+ *          Buffered mode (hal_uart.c): after hal_uart_async_enable(), bytes
+ *          are queued in a TX ring drained by the USART data-register-empty
+ *          interrupt. hal_uart_write_nb() / hal_uart_puts_nb() never wait;
+ *          the blocking calls keep working and queue through the same ring,
+ *          so output order is preserved.
  */
 
 #ifndef HAL_UART_H
@@ -26,12 +32,69 @@
 /** @brief Default timeout in loop iterations (~10ms at 16MHz) */
 #define UART_DEFAULT_TIMEOUT    50000U
 
+/** @brief TX ring capacity in bytes (power of two, <= 128) */
+#ifndef UART_TX_BUFFER_SIZE
+#define UART_TX_BUFFER_SIZE     128U
+#endif
+
 typedef enum {
     UART_OK = 0,
     UART_ERROR_TIMEOUT,
     UART_ERROR_OVERFLOW
 } uart_status_t;
 
+/* =============================================================================
+ * Buffered Transmit (hal_uart.c)
+ * ========================================================================== */
+
+/**
+ * @brief   Switch transmission to the interrupt-driven TX ring
+ * @pre     hal_uart_init() called; global interrupts enabled (sei())
+ */
+void hal_uart_async_enable(void);
+
+/**
+ * @brief   Whether transmission goes through the TX ring
+ * @return  true after hal_uart_async_enable()
+ */
+bool hal_uart_async_enabled(void);
+
+/**
+ * @brief   Queue bytes without waiting (all or nothing)
+ * @param   data Bytes to send
+ * @param   len Number of bytes
+ * @return  UART_OK if all bytes were queued, UART_ERROR_OVERFLOW if the ring
+ *          lacks space (nothing is queued, retry later or drop)
+ * @pre     hal_uart_async_enable() must be called first
+ */
+uart_status_t hal_uart_write_nb(const uint8_t* data, uint8_t len);
+
+/**
+ * @brief   Queue a string without waiting (all or nothing)
+ * @param   str NUL-terminated string (at most UART_TX_BUFFER_SIZE chars)
+ * @return  UART_OK, or UART_ERROR_OVERFLOW (nothing queued)
+ * @pre     hal_uart_async_enable() must be called first
+ */
+uart_status_t hal_uart_puts_nb(const char* str);
+
+/**
+ * @brief   Free space in the TX ring
+ * @return  Bytes that hal_uart_write_nb() would accept now
+ */
+uint8_t hal_uart_tx_free(void);
+
+/**
+ * @brief   Nothing queued and the last byte has left the shift register
+ * @return  true when stopping the I/O clock cannot cut a byte short
+ *          (false until the first byte after reset has gone out)
+ * @note    Used by hal_power_sleep() before ADC noise reduction sleep
+ */
+bool hal_uart_tx_idle(void);
+
+/* =============================================================================
+ * Blocking API
+ * ========================================================================== */
+
 static inline void hal_uart_init(void)
 {
     UBRR0H = (uint8_t)(UART_UBRR_VALUE >> 8);
@@ -50,17 +113,39 @@ static inline bool hal_uart_rx_available(void)
     return (UCSR0A & (1U << RXC0)) != 0U;
 }
 
+/**
+ * @brief   Load a byte into UDR0, clearing TXC0 so it tracks this byte
+ * @note    TXC0 is cleared by writing one; FE0, DOR0 and UPE0 must be
+ *          written zero, so only U2X0 and MPCM0 are written back
+ */
+static inline void hal_uart_load(uint8_t data)
+{
+    UCSR0A = (uint8_t)((UCSR0A & ((1U << U2X0) | (1U << MPCM0))) | (1U << TXC0));
+    UDR0 = data;
+}
+
 /**
  * @brief   Send a single byte with timeout
  * @param   data    Byte to transmit
  * @param   timeout Maximum iterations to wait (0 = use default)
  * @return  UART_OK on success, UART_ERROR_TIMEOUT if TX not ready in time
  * @pre     hal_uart_init() must be called first
+ * @note    In buffered mode waits for ring space instead of UDRE0
  */
 static inline uart_status_t hal_uart_putc_timeout(uint8_t data, uint16_t timeout)
 {
     uint16_t counter = (timeout == 0U) ? UART_DEFAULT_TIMEOUT : timeout;
 
+    if (hal_uart_async_enabled()) {
+        while (hal_uart_write_nb(&data, 1U) != UART_OK) {
+            if (counter == 0U) {
+                return UART_ERROR_TIMEOUT;
+            }
+            counter--;
+        }
+        return UART_OK;
+    }
+
     while (!hal_uart_tx_ready()) {
         if (counter == 0U) {
             return UART_ERROR_TIMEOUT;
@@ -68,7 +153,7 @@ static inline uart_status_t hal_uart_putc_timeout(uint8_t data, uint16_t timeout
         counter--;
     }
 
-    UDR0 = data;
+    hal_uart_load(data);
     return UART_OK;
 }
 
@@ -10,6 +10,18 @@
 
 #include "hdc_core.h"
 #include "hdc_encode.h"
+#include "hdc_item.h"
+#include "hdc_seq.h"
+#include "hdc_store.h"
+#include "hdc_counter.h"
+#include "hdc_am.h"
+#include "hdc_amt.h"
+#include "hdc_proto.h"
+#include "hdc_learn.h"
+#include "hdc_pipe.h"
+#include "hdc_pgm.h"
+#include "hdc_probe.h"
+#include "hdc_telemetry.h"
 
 #define HDC_VERSION_MAJOR   1U
 #define HDC_VERSION_MINOR   0U
@@ -0,0 +1,426 @@
+/**
+ * @file    hdc_am.c
+ * @brief   HDC Associative Memory - Implementation
+ * @version 1.0.0
+ * @note    Class prototypes in one contiguous block, nearest / top-k search
+ *
+ * @details Rows are compared with the inlined range kernels from hdc_kernel.h
+ *          so the search loop issues no per-class function call. The bound
+ *          passed in bounded mode is the distance a row must beat: the best
+ *          so far for nearest search, the current k-th result for top-k.
+ *
+ *          Flash-resident rows (HDC_AM_FLAG_FLASH) use the _P kernels on AVR;
+ *          on the host the flag only makes the memory read-only. Views over
+ *          rows owned elsewhere (a mapped model file) are read-only RAM.
+ */
+
+#include "hdc_am.h"
+#include "hdc_pgm.h"
+#include "hdc_kernel.h"
+#include "hdc_probe.h"
+#include <stddef.h>
+
+/* =============================================================================
+ * Private Helpers
+ * ========================================================================== */
+
+/**
+ * @brief   Distance from a query to one class row
+ * @param   am Associative memory (selects the strategy)
+ * @param   query Query hypervector
+ * @param   row Class row
+ * @param   bound Largest distance that could still place
+ * @return  Exact distance, or in bounded mode some value > bound
+ */
+static inline hdc_dist_t am_distance(const hdc_am_t* am, const uint8_t* query,
+                                     const uint8_t* row, hdc_dist_t bound)
+{
+#if HDC_PGM_SEPARATE
+    if ((am->flags & HDC_AM_FLAG_FLASH) != 0U) {
+        if (am->search == HDC_AM_SEARCH_BOUNDED) {
+            return hdc_kernel_hamming_bounded_P(query, row, HV_BYTES, bound);
+        }
+        return hdc_kernel_hamming_P(query, row, HV_BYTES);
+    }
+#endif
+    if (am->search == HDC_AM_SEARCH_BOUNDED) {
+        return hdc_kernel_hamming_bounded(query, row, HV_BYTES, bound);
+    }
+    return hdc_kernel_hamming(query, row, HV_BYTES);
+}
+
+/**
+ * @brief   Load one word of a class row
+ * @param   am Associative memory (selects SRAM or flash)
+ * @param   p Row bytes at the word offset
+ * @param   bytes Bytes in this word (HDC_WORD_BYTES, or fewer for the tail)
+ * @return  Word value, zero padded for the tail
+ */
+static inline hdc_word_t am_load_word(const hdc_am_t* am, const uint8_t* p, uint8_t bytes)
+{
+#if HDC_PGM_SEPARATE
+    if ((am->flags & HDC_AM_FLAG_FLASH) != 0U) {
+        return (bytes == HDC_WORD_BYTES) ? hdc_word_load_P(p) : hdc_word_load_partial_P(p, bytes);
+    }
+#else
+    (void)am;
+#endif
+    return (bytes == HDC_WORD_BYTES) ? hdc_word_load(p) : hdc_word_load_partial(p, bytes);
+}
+
+/**
+ * @brief   Distance a candidate must not exceed to enter a top-k list
+ * @param   list Result list sorted by ascending distance
+ * @param   len Current list length
+ * @param   k List capacity
+ * @return  Bound for am_distance()
+ */
+static inline hdc_dist_t am_topk_bound(const hdc_am_match_t* list, uint8_t len, uint8_t k)
+{
+    return (len == k) ? list[k - 1U].distance : (hdc_dist_t)HV_DIMENSIONS;
+}
+
+/**
+ * @brief   Insert a candidate into a sorted top-k list
+ * @param   list Result list sorted by ascending distance
+ * @param   p_len Current list length (updated)
+ * @param   k List capacity
+ * @param   class_id Candidate class
+ * @param   distance Candidate distance
+ * @note    Candidates arrive in ascending class order; a candidate only
+ *          displaces strictly larger distances, so ties keep the lower ID.
+ */
+static void am_topk_insert(hdc_am_match_t* list, uint8_t* p_len, uint8_t k,
+                           hdc_class_t class_id, hdc_dist_t distance)
+{
+    uint8_t len = *p_len;
+
+    if (len == k) {
+        if (distance >= list[k - 1U].distance) {
+            return;
+        }
+        len--;
+    }
+
+    uint8_t i = len;
+    while ((i > 0U) && (list[i - 1U].distance > distance)) {
+        list[i] = list[i - 1U];
+        i--;
+    }
+
+    list[i].class_id = class_id;
+    list[i].distance = distance;
+    *p_len = (uint8_t)(len + 1U);
+}
+
+/* =============================================================================
+ * Management
+ * ========================================================================== */
+
+/**
+ * @brief   Initialize an empty associative memory over caller storage
+ * @param   am Associative memory to initialize
+ * @param   storage Contiguous array of capacity hypervectors
+ * @param   capacity Number of class rows available in storage
+ * @note    The search strategy defaults to HDC_AM_SEARCH_BOUNDED
+ */
+void hdc_am_init(hdc_am_t* am, hv_t* storage, hdc_class_t capacity)
+{
+    am->classes = storage;
+    am->capacity = capacity;
+    am->count = 0U;
+    am->search = HDC_AM_SEARCH_BOUNDED;
+    am->flags = 0U;
+}
+
+/**
+ * @brief   Initialize a read-only associative memory over a flash class table
+ * @param   am Associative memory to initialize
+ * @param   rows_P Contiguous array of count class hypervectors (HDC_FLASH)
+ * @param   count Number of classes in the table
+ */
+void hdc_am_init_flash(hdc_am_t* am, const hv_t* rows_P, hdc_class_t count)
+{
+    /* Never written through: add/set/get refuse HDC_AM_FLAG_READ_ONLY memories */
+    am->classes = (hv_t*)rows_P;
+    am->capacity = count;
+    am->count = count;
+    am->search = HDC_AM_SEARCH_BOUNDED;
+    am->flags = (uint8_t)(HDC_AM_FLAG_FLASH | HDC_AM_FLAG_READ_ONLY);
+}
+
+/**
+ * @brief   Initialize a read-only associative memory over existing RAM rows
+ * @param   am Associative memory to initialize
+ * @param   rows Contiguous array of count class hypervectors
+ * @param   count Number of classes in the table
+ */
+void hdc_am_init_view(hdc_am_t* am, const hv_t* rows, hdc_class_t count)
+{
+    am->classes = (hv_t*)rows;
+    am->capacity = count;
+    am->count = count;
+    am->search = HDC_AM_SEARCH_BOUNDED;
+    am->flags = HDC_AM_FLAG_READ_ONLY;
+}
+
+/**
+ * @brief   Select the search strategy
+ * @param   am Associative memory
+ * @param   search HDC_AM_SEARCH_EXHAUSTIVE or HDC_AM_SEARCH_BOUNDED
+ */
+void hdc_am_set_search(hdc_am_t* am, hdc_am_search_t search)
+{
+    am->search = search;
+}
+
+/**
+ * @brief   Append a class prototype
+ * @param   am Associative memory
+ * @param   prototype Class hypervector (copied)
+ * @param   p_class_id Receives the new class ID (may be NULL)
+ * @return  HDC_AM_OK, HDC_AM_ERROR_FULL if capacity is reached, or
+ *          HDC_AM_ERROR_READ_ONLY for a flash memory or view
+ */
+hdc_am_status_t hdc_am_add(hdc_am_t* am, const hv_t prototype, hdc_class_t* p_class_id)
+{
+    if ((am->flags & HDC_AM_FLAG_READ_ONLY) != 0U) {
+        return HDC_AM_ERROR_READ_ONLY;
+    }
+    if (am->count >= am->capacity) {
+        return HDC_AM_ERROR_FULL;
+    }
+
+    hdc_copy(am->classes[am->count], prototype);
+    if (p_class_id != NULL) {
+        *p_class_id = am->count;
+    }
+    am->count++;
+    return HDC_AM_OK;
+}
+
+/**
+ * @brief   Overwrite an existing class prototype
+ * @param   am Associative memory
+ * @param   class_id Class to overwrite
+ * @param   prototype New class hypervector (copied)
+ * @return  HDC_AM_OK, HDC_AM_ERROR_INVALID_CLASS, or HDC_AM_ERROR_READ_ONLY
+ */
+hdc_am_status_t hdc_am_set(hdc_am_t* am, hdc_class_t class_id, const hv_t prototype)
+{
+    if ((am->flags & HDC_AM_FLAG_READ_ONLY) != 0U) {
+        return HDC_AM_ERROR_READ_ONLY;
+    }
+    if (class_id >= am->count) {
+        return HDC_AM_ERROR_INVALID_CLASS;
+    }
+
+    hdc_copy(am->classes[class_id], prototype);
+    return HDC_AM_OK;
+}
+
+/**
+ * @brief   Access a class prototype in place
+ * @param   am Associative memory
+ * @param   class_id Class to access
+ * @return  Pointer to the class row, or NULL if class_id is not in use or
+ *          the rows are read-only (use hdc_am_read())
+ */
+hv_t* hdc_am_get(const hdc_am_t* am, hdc_class_t class_id)
+{
+    if ((class_id >= am->count) || ((am->flags & HDC_AM_FLAG_READ_ONLY) != 0U)) {
+        return NULL;
+    }
+    return &am->classes[class_id];
+}
+
+/**
+ * @brief   Copy a class prototype out of SRAM or flash
+ * @param   am Associative memory
+ * @param   class_id Class to read
+ * @param   out Receives the class hypervector
+ * @return  HDC_AM_OK, or HDC_AM_ERROR_INVALID_CLASS
+ */
+hdc_am_status_t hdc_am_read(const hdc_am_t* am, hdc_class_t class_id, hv_t out)
+{
+    if (class_id >= am->count) {
+        return HDC_AM_ERROR_INVALID_CLASS;
+    }
+
+    if ((am->flags & HDC_AM_FLAG_FLASH) != 0U) {
+        hdc_copy_P(out, am->classes[class_id]);
+    } else {
+        hdc_copy(out, am->classes[class_id]);
+    }
+    return HDC_AM_OK;
+}
+
+/* =============================================================================
+ * Search
+ * ========================================================================== */
+
+/**
+ * @brief   Find the nearest class to a query
+ * @param   am Associative memory
+ * @param   query Query hypervector
+ * @param   p_best Receives the best match
+ * @return  HDC_AM_OK, or HDC_AM_ERROR_EMPTY (p_best->class_id = HDC_AM_CLASS_NONE)
+ */
+hdc_am_status_t hdc_am_query(const hdc_am_t* am, const hv_t query, hdc_am_match_t* p_best)
+{
+    p_best->class_id = HDC_AM_CLASS_NONE;
+    p_best->distance = (hdc_dist_t)HV_DIMENSIONS;
+
+    if (am->count == 0U) {
+        return HDC_AM_ERROR_EMPTY;
+    }
+
+    HDC_PROBE_BEGIN(HDC_PROBE_AM_QUERY);
+    for (hdc_class_t c = 0U; c < am->count; c++) {
+        hdc_dist_t distance = am_distance(am, query, am->classes[c], p_best->distance);
+        if ((distance < p_best->distance) || (p_best->class_id == HDC_AM_CLASS_NONE)) {
+            p_best->class_id = c;
+            p_best->distance = distance;
+        }
+    }
+    HDC_PROBE_END(HDC_PROBE_AM_QUERY);
+    return HDC_AM_OK;
+}
+
+/**
+ * @brief   Find the k nearest classes to a query
+ * @param   am Associative memory
+ * @param   query Query hypervector
+ * @param   results Output array of at least k entries, nearest first
+ * @param   k Number of results requested
+ * @return  Number of results written (min(k, class count))
+ */
+uint8_t hdc_am_query_topk(const hdc_am_t* am, const hv_t query,
+                          hdc_am_match_t* results, uint8_t k)
+{
+    uint8_t len = 0U;
+
+    if (k == 0U) {
+        return 0U;
+    }
+
+    for (hdc_class_t c = 0U; c < am->count; c++) {
+        hdc_dist_t distance = am_distance(am, query, am->classes[c],
+                                          am_topk_bound(results, len, k));
+        am_topk_insert(results, &len, k, c, distance);
+    }
+    return len;
+}
+
+/**
+ * @brief   Top-k search for a batch of queries
+ * @param   am Associative memory
+ * @param   queries Array of num_queries query hypervectors
+ * @param   num_queries Number of queries
+ * @param   results Output array of num_queries * k entries; query q's
+ *          results start at results[q * k]
+ * @param   k Number of results per query
+ * @return  Number of results written per query (min(k, class count))
+ */
+uint8_t hdc_am_query_batch(const hdc_am_t* am, const hv_t* queries, uint16_t num_queries,
+                           hdc_am_match_t* results, uint8_t k)
+{
+    uint8_t lens[HDC_AM_QUERY_TILE];
+    uint8_t written = 0U;
+
+    if (k == 0U) {
+        return 0U;
+    }
+
+    /* Counted down, so no index steps past num_queries (up to 0xFFFF) */
+    uint16_t base = 0U;
+    uint16_t remaining = num_queries;
+    while (remaining > 0U) {
+        uint8_t tile = (remaining < HDC_AM_QUERY_TILE) ? (uint8_t)remaining : (uint8_t)HDC_AM_QUERY_TILE;
+
+        for (uint8_t q = 0U; q < tile; q++) {
+            lens[q] = 0U;
+        }
+
+        /* Class-major: each row is scored against the whole tile while hot */
+        for (hdc_class_t c = 0U; c < am->count; c++) {
+            const uint8_t* row = am->classes[c];
+            for (uint8_t q = 0U; q < tile; q++) {
+                hdc_am_match_t* list = &results[(uint32_t)(base + q) * k];
+                hdc_dist_t distance = am_distance(am, queries[base + q], row,
+                                                  am_topk_bound(list, lens[q], k));
+                am_topk_insert(list, &lens[q], k, c, distance);
+            }
+        }
+
+        written = lens[0];
+        base = (uint16_t)(base + tile);
+        remaining = (uint16_t)(remaining - tile);
+    }
+    return written;
+}
+
+/* =============================================================================
+ * Fused Encode and Search
+ * ========================================================================== */
+
+/**
+ * @brief   Score a multi-channel sample against every class without
+ *          materializing its query hypervector
+ * @param   am Associative memory
+ * @param   levels Thermometer level per channel (hdc_level_from_adc())
+ * @param   num_channels Number of channels
+ * @param   basis_vectors Basis vector per channel
+ * @param   distances Output, one Hamming distance per class (am->count entries)
+ * @param   p_best Receives the nearest class (may be NULL)
+ * @return  HDC_AM_OK, or HDC_AM_ERROR_EMPTY
+ */
+hdc_am_status_t hdc_am_query_levels(const hdc_am_t* am, const hdc_level_t* levels,
+                                    uint8_t num_channels, const hv_t* basis_vectors,
+                                    hdc_dist_t* distances, hdc_am_match_t* p_best)
+{
+    hdc_index_t i = 0U;
+
+    if (p_best != NULL) {
+        p_best->class_id = HDC_AM_CLASS_NONE;
+        p_best->distance = (hdc_dist_t)HV_DIMENSIONS;
+    }
+    if (am->count == 0U) {
+        return HDC_AM_ERROR_EMPTY;
+    }
+
+    HDC_PROBE_BEGIN(HDC_PROBE_AM_QUERY_LEVELS);
+    for (hdc_class_t c = 0U; c < am->count; c++) {
+        distances[c] = 0U;
+    }
+
+    /* Word-major: one query word is scored against every class row */
+    for (hdc_index_t w = 0U; w != HDC_HV_WORDS; w++) {
+        hdc_word_t query = hdc_kernel_encode_word(levels, num_channels, basis_vectors,
+                                                  i, HDC_WORD_BYTES);
+        for (hdc_class_t c = 0U; c < am->count; c++) {
+            distances[c] += hdc_word_popcount(query ^ am_load_word(am, &am->classes[c][i], HDC_WORD_BYTES));
+        }
+        i = (hdc_index_t)(i + HDC_WORD_BYTES);
+    }
+
+    if (HDC_HV_TAIL_BYTES > 0U) {
+        hdc_word_t query = hdc_kernel_encode_word(levels, num_channels, basis_vectors,
+                                                  i, HDC_HV_TAIL_BYTES);
+        for (hdc_class_t c = 0U; c < am->count; c++) {
+            distances[c] += hdc_word_popcount(
+                query ^ am_load_word(am, &am->classes[c][i], HDC_HV_TAIL_BYTES));
+        }
+    }
+
+    if (p_best != NULL) {
+        for (hdc_class_t c = 0U; c < am->count; c++) {
+            if ((distances[c] < p_best->distance) || (p_best->class_id == HDC_AM_CLASS_NONE)) {
+                p_best->class_id = c;
+                p_best->distance = distances[c];
+            }
+        }
+    }
+    HDC_PROBE_END(HDC_PROBE_AM_QUERY_LEVELS);
+    return HDC_AM_OK;
+}
@@ -0,0 +1,231 @@
+/**
+ * @file    hdc_am.h
+ * @brief   HDC Associative Memory - Declarations
+ * @version 1.0.0
+ * @note    Class prototypes in one contiguous block, nearest / top-k search
+ *
+ * @details The associative memory (AM) stores N class hypervectors back to
+ *          back in caller-provided storage (no dynamic allocation). Queries
+ *          stream through that block row by row using the selected kernel
+ *          backend. Batched queries are tiled so each class row is compared
+ *          against several queries while it is still in cache.
+ *
+ *          Results are ordered by ascending Hamming distance; equal distances
+ *          keep the lower class ID first, so results are deterministic.
+ *
+ *          In HDC_AM_SEARCH_BOUNDED mode (the default) each class is compared
+ *          with hdc_hamming_bounded() against the distance it would have to
+ *          beat, so most far-away classes are rejected after a few chunks.
+ *          Both modes return the same results.
+ *
+ *          A deployed model can stay in flash: hdc_am_init_flash() searches a
+ *          HDC_FLASH class table in place (hdc_pgm.h) and rejects writes.
+ */
+
+#ifndef HDC_AM_H
+#define HDC_AM_H
+
+#include <stdint.h>
+#include "hdc_core.h"
+#include "hdc_encode.h"
+
+/* =============================================================================
+ * Constants
+ * ========================================================================== */
+
+/** @brief Class ID returned when no class matches (empty memory) */
+#define HDC_AM_CLASS_NONE       0xFFFFU
+
+/** @brief Queries compared per class row in hdc_am_query_batch() */
+#ifndef HDC_AM_QUERY_TILE
+#define HDC_AM_QUERY_TILE       8U
+#endif
+
+/** @brief hdc_am_t.flags: rows are a read-only table in flash */
+#define HDC_AM_FLAG_FLASH       0x01U
+
+/** @brief hdc_am_t.flags: add/set/get are refused (flash tables and views) */
+#define HDC_AM_FLAG_READ_ONLY   0x02U
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Class identifier (index into the associative memory) */
+typedef uint16_t hdc_class_t;
+
+/** @brief Search strategy */
+typedef enum {
+    HDC_AM_SEARCH_EXHAUSTIVE = 0,   /**< Full distance for every class */
+    HDC_AM_SEARCH_BOUNDED           /**< Early exit once a class cannot place */
+} hdc_am_search_t;
+
+/** @brief Associative memory status codes */
+typedef enum {
+    HDC_AM_OK = 0,
+    HDC_AM_ERROR_FULL,
+    HDC_AM_ERROR_INVALID_CLASS,
+    HDC_AM_ERROR_EMPTY,
+    HDC_AM_ERROR_READ_ONLY
+} hdc_am_status_t;
+
+/** @brief One search result */
+typedef struct {
+    hdc_class_t class_id;   /**< Matching class */
+    hdc_dist_t  distance;   /**< Hamming distance to the query */
+} hdc_am_match_t;
+
+/** @brief Associative memory over a contiguous block of class hypervectors */
+typedef struct {
+    hv_t*       classes;    /**< Class storage, capacity entries (caller-owned) */
+    hdc_class_t capacity;   /**< Number of rows in storage */
+    hdc_class_t count;      /**< Number of rows in use */
+    hdc_am_search_t search; /**< Search strategy (results are identical) */
+    uint8_t     flags;      /**< HDC_AM_FLAG_* */
+} hdc_am_t;
+
+/* =============================================================================
+ * Function Declarations - Management
+ * ========================================================================== */
+
+/**
+ * @brief   Initialize an empty associative memory over caller storage
+ * @param   am Associative memory to initialize
+ * @param   storage Contiguous array of capacity hypervectors
+ * @param   capacity Number of class rows available in storage
+ * @note    The search strategy defaults to HDC_AM_SEARCH_BOUNDED
+ */
+void hdc_am_init(hdc_am_t* am, hv_t* storage, hdc_class_t capacity);
+
+/**
+ * @brief   Initialize a read-only associative memory over a flash class table
+ * @param   am Associative memory to initialize
+ * @param   rows_P Contiguous array of count class hypervectors (HDC_FLASH)
+ * @param   count Number of classes in the table
+ * @note    Searches read the rows in place; hdc_am_add() and hdc_am_set()
+ *          return HDC_AM_ERROR_READ_ONLY and hdc_am_get() returns NULL
+ */
+void hdc_am_init_flash(hdc_am_t* am, const hv_t* rows_P, hdc_class_t count);
+
+/**
+ * @brief   Initialize a read-only associative memory over existing RAM rows
+ * @param   am Associative memory to initialize
+ * @param   rows Contiguous array of count class hypervectors (e.g. mapped
+ *          from a model file, gw_model.h)
+ * @param   count Number of classes in the table
+ * @note    Searches read the rows in place; writes are refused as for
+ *          hdc_am_init_flash()
+ */
+void hdc_am_init_view(hdc_am_t* am, const hv_t* rows, hdc_class_t count);
+
+/**
+ * @brief   Select the search strategy
+ * @param   am Associative memory
+ * @param   search HDC_AM_SEARCH_EXHAUSTIVE or HDC_AM_SEARCH_BOUNDED
+ */
+void hdc_am_set_search(hdc_am_t* am, hdc_am_search_t search);
+
+/**
+ * @brief   Append a class prototype
+ * @param   am Associative memory
+ * @param   prototype Class hypervector (copied)
+ * @param   p_class_id Receives the new class ID (may be NULL)
+ * @return  HDC_AM_OK, HDC_AM_ERROR_FULL if capacity is reached, or
+ *          HDC_AM_ERROR_READ_ONLY for a flash memory or view
+ */
+hdc_am_status_t hdc_am_add(hdc_am_t* am, const hv_t prototype, hdc_class_t* p_class_id);
+
+/**
+ * @brief   Overwrite an existing class prototype
+ * @param   am Associative memory
+ * @param   class_id Class to overwrite
+ * @param   prototype New class hypervector (copied)
+ * @return  HDC_AM_OK, HDC_AM_ERROR_INVALID_CLASS, or HDC_AM_ERROR_READ_ONLY
+ */
+hdc_am_status_t hdc_am_set(hdc_am_t* am, hdc_class_t class_id, const hv_t prototype);
+
+/**
+ * @brief   Access a class prototype in place
+ * @param   am Associative memory
+ * @param   class_id Class to access
+ * @return  Pointer to the class row, or NULL if class_id is not in use or
+ *          the rows are read-only (use hdc_am_read())
+ */
+hv_t* hdc_am_get(const hdc_am_t* am, hdc_class_t class_id);
+
+/**
+ * @brief   Copy a class prototype out of SRAM or flash
+ * @param   am Associative memory
+ * @param   class_id Class to read
+ * @param   out Receives the class hypervector
+ * @return  HDC_AM_OK, or HDC_AM_ERROR_INVALID_CLASS
+ */
+hdc_am_status_t hdc_am_read(const hdc_am_t* am, hdc_class_t class_id, hv_t out);
+
+/* =============================================================================
+ * Function Declarations - Search
+ * ========================================================================== */
+
+/**
+ * @brief   Find the nearest class to a query
+ * @param   am Associative memory
+ * @param   query Query hypervector
+ * @param   p_best Receives the best match
+ * @return  HDC_AM_OK, or HDC_AM_ERROR_EMPTY (p_best->class_id = HDC_AM_CLASS_NONE)
+ */
+hdc_am_status_t hdc_am_query(const hdc_am_t* am, const hv_t query, hdc_am_match_t* p_best);
+
+/**
+ * @brief   Find the k nearest classes to a query
+ * @param   am Associative memory
+ * @param   query Query hypervector
+ * @param   results Output array of at least k entries, nearest first
+ * @param   k Number of results requested
+ * @return  Number of results written (min(k, class count))
+ */
+uint8_t hdc_am_query_topk(const hdc_am_t* am, const hv_t query,
+                          hdc_am_match_t* results, uint8_t k);
+
+/**
+ * @brief   Top-k search for a batch of queries
+ * @param   am Associative memory
+ * @param   queries Array of num_queries query hypervectors
+ * @param   num_queries Number of queries
+ * @param   results Output array of num_queries * k entries; query q's
+ *          results start at results[q * k]
+ * @param   k Number of results per query
+ * @return  Number of results written per query (min(k, class count))
+ *
+ * @details Queries are processed in tiles of HDC_AM_QUERY_TILE. For each
+ *          class row the whole tile is scored before moving on, replacing
+ *          an N x M loop of independent searches with one streaming pass
+ *          over the class block per tile.
+ */
+uint8_t hdc_am_query_batch(const hdc_am_t* am, const hv_t* queries, uint16_t num_queries,
+                           hdc_am_match_t* results, uint8_t k);
+
+/* =============================================================================
+ * Function Declarations - Fused Encode and Search
+ * ========================================================================== */
+
+/**
+ * @brief   Score a multi-channel sample against every class without
+ *          materializing its query hypervector
+ * @param   am Associative memory
+ * @param   levels Thermometer level per channel (hdc_level_from_adc())
+ * @param   num_channels Number of channels
+ * @param   basis_vectors Basis vector per channel
+ * @param   distances Output, one Hamming distance per class (am->count entries)
+ * @param   p_best Receives the nearest class (may be NULL)
+ * @return  HDC_AM_OK, or HDC_AM_ERROR_EMPTY
+ *
+ * @details Equivalent to hdc_encode_levels() followed by a Hamming distance
+ *          to each class, but each query word is built in a register and
+ *          scored against all classes before the next word is built.
+ *          The search strategy is ignored: every distance is exact.
+ */
+hdc_am_status_t hdc_am_query_levels(const hdc_am_t* am, const hdc_level_t* levels,
+                                    uint8_t num_channels, const hv_t* basis_vectors,
+                                    hdc_dist_t* distances, hdc_am_match_t* p_best);
+
+#endif /* HDC_AM_H */
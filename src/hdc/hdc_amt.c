@@ -0,0 +1,555 @@
+/**
+ * @file    hdc_amt.c
+ * @brief   HDC Associative Memory - Transposed (Bit-Sliced) Class Store
+ * @version 1.0.0
+ * @note    Meant for gateway-sized tables; portable C with 64-bit words
+ *
+ * @details A block search keeps one bit-sliced counter per block:
+ *          counter.bit[i] holds bit i of the running distance of all 256
+ *          lanes. Sixteen dimensions at a time are folded in with the
+ *          Harley-Seal carry-save tree. Its ones / twos / fours / eights
+ *          words are exactly bits 0-3 of the counter, and the sixteens carry
+ *          ripples into bits 4 and up. So the counter is a plain binary
+ *          number per lane at every group boundary, ready to be compared
+ *          (amt_prune()) or ranked (amt_min()) without reading out lanes.
+ */
+
+#include "hdc_amt.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* =============================================================================
+ * Private Helpers
+ * ========================================================================== */
+
+/** @brief Counter bits needed to hold HV_DIMENSIONS */
+#if HV_DIMENSIONS < 256U
+#define AMT_COUNT_BITS      8U
+#elif HV_DIMENSIONS < 1024U
+#define AMT_COUNT_BITS      10U
+#elif HV_DIMENSIONS < 4096U
+#define AMT_COUNT_BITS      12U
+#elif HV_DIMENSIONS < 16384U
+#define AMT_COUNT_BITS      14U
+#else
+#define AMT_COUNT_BITS      16U
+#endif
+
+/** @brief Dimensions folded in per carry-save step */
+#define AMT_GROUP_DIMS      16U
+
+/** @brief Probe only while it is a small part of each block's scan */
+#define AMT_PROBE_ON        ((HDC_AMT_PROBE_DIMS > 0U) && ((4U * HDC_AMT_PROBE_DIMS) <= HV_DIMENSIONS))
+
+/** @brief Words per dimension (short alias) */
+#define AMT_W               HDC_AMT_BLOCK_WORDS
+
+/** @brief Words per block */
+#define AMT_BLOCK_SPAN      ((uint32_t)HV_DIMENSIONS * AMT_W)
+
+/** @brief Bit-sliced distance of one block's lanes */
+typedef struct {
+    uint64_t bit[AMT_COUNT_BITS][AMT_W];
+} amt_counter_t;
+
+/** @brief Lane mask of one block */
+typedef struct {
+    uint64_t word[AMT_W];
+} amt_lanes_t;
+
+/** @brief One plane row of a block: AMT_W words, bit j of word w is lane 64w + j */
+typedef uint64_t amt_vec_t[AMT_W];
+
+/**
+ * @brief   Carry-save adder: a + b + c = 2 * high + low, per bit
+ * @note    high and low may alias a (never b or c)
+ */
+static inline void amt_csa(amt_vec_t high, amt_vec_t low, const amt_vec_t a, const amt_vec_t b,
+                           const amt_vec_t c)
+{
+    for (uint8_t w = 0U; w < AMT_W; w++) {
+        uint64_t u = a[w] ^ b[w];
+        uint64_t h = (a[w] & b[w]) | (u & c[w]);
+
+        low[w] = u ^ c[w];
+        high[w] = h;
+    }
+}
+
+/**
+ * @brief   Add one group of 16 dimensions into the counter
+ * @param   counter Counter; bits 0-3 are the Harley-Seal ones..eights
+ * @param   planes First plane word of the group
+ * @param   bits Query bits of the group, bit j for dimension j
+ *
+ * @details Every step is a loop over the AMT_W words with no dependency
+ *          between them, so it vectorizes (AVX2, NEON).
+ */
+static inline void amt_accumulate(amt_counter_t* counter, const uint64_t* planes, uint32_t bits)
+{
+    amt_vec_t diff[AMT_GROUP_DIMS];
+    amt_vec_t twos_a, twos_b, fours_a, fours_b, eights_a, eights_b, sixteens;
+    uint64_t (*bit)[AMT_W] = counter->bit;
+
+    for (uint8_t j = 0U; j < AMT_GROUP_DIMS; j++) {
+        uint64_t mask = (uint64_t)0U - (uint64_t)((bits >> j) & 1U);
+        for (uint8_t w = 0U; w < AMT_W; w++) {
+            diff[j][w] = planes[(j * AMT_W) + w] ^ mask;
+        }
+    }
+
+    amt_csa(twos_a, bit[0], bit[0], diff[0], diff[1]);
+    amt_csa(twos_b, bit[0], bit[0], diff[2], diff[3]);
+    amt_csa(fours_a, bit[1], bit[1], twos_a, twos_b);
+    amt_csa(twos_a, bit[0], bit[0], diff[4], diff[5]);
+    amt_csa(twos_b, bit[0], bit[0], diff[6], diff[7]);
+    amt_csa(fours_b, bit[1], bit[1], twos_a, twos_b);
+    amt_csa(eights_a, bit[2], bit[2], fours_a, fours_b);
+
+    amt_csa(twos_a, bit[0], bit[0], diff[8], diff[9]);
+    amt_csa(twos_b, bit[0], bit[0], diff[10], diff[11]);
+    amt_csa(fours_a, bit[1], bit[1], twos_a, twos_b);
+    amt_csa(twos_a, bit[0], bit[0], diff[12], diff[13]);
+    amt_csa(twos_b, bit[0], bit[0], diff[14], diff[15]);
+    amt_csa(fours_b, bit[1], bit[1], twos_a, twos_b);
+    amt_csa(eights_b, bit[2], bit[2], fours_a, fours_b);
+
+    amt_csa(sixteens, bit[3], bit[3], eights_a, eights_b);
+
+    /* Ripple the sixteens into the high bits; the count never overflows */
+    for (uint8_t i = 4U; i < AMT_COUNT_BITS; i++) {
+        for (uint8_t w = 0U; w < AMT_W; w++) {
+            uint64_t carry = bit[i][w] & sixteens[w];
+            bit[i][w] ^= sixteens[w];
+            sixteens[w] = carry;
+        }
+    }
+}
+
+/**
+ * @brief   Drop the lanes whose count is greater than bound
+ * @return  true if any lane is left
+ */
+static inline bool amt_prune(const amt_counter_t* counter, hdc_dist_t bound, amt_lanes_t* alive)
+{
+    uint64_t any = 0U;
+
+    for (uint8_t w = 0U; w < AMT_W; w++) {
+        uint64_t greater = 0U;
+        uint64_t equal = ~(uint64_t)0U;
+
+        for (uint8_t i = AMT_COUNT_BITS; i > 0U; i--) {
+            uint64_t v = counter->bit[i - 1U][w];
+            if (((bound >> (i - 1U)) & 1U) != 0U) {
+                equal &= v;
+            } else {
+                greater |= equal & v;
+                equal &= ~v;
+            }
+        }
+        alive->word[w] &= ~greater;
+        any |= alive->word[w];
+    }
+    return (any != 0U);
+}
+
+/**
+ * @brief   Lanes holding the smallest count among some lanes
+ * @param   counter Counts
+ * @param   lanes Lanes to consider (at least one set)
+ * @param   p_min Receives the smallest count
+ * @return  Every lane of lanes whose count is *p_min
+ *
+ * @details Bit-sliced, from the top bit down: keep the lanes with a 0 bit
+ *          if there are any, else the minimum has a 1 there.
+ */
+static amt_lanes_t amt_min(const amt_counter_t* counter, const amt_lanes_t* lanes,
+                           hdc_dist_t* p_min)
+{
+    amt_lanes_t cand = *lanes;
+    uint32_t value = 0U;
+
+    for (uint8_t i = AMT_COUNT_BITS; i > 0U; i--) {
+        amt_lanes_t zero;
+        uint64_t any = 0U;
+
+        for (uint8_t w = 0U; w < AMT_W; w++) {
+            zero.word[w] = cand.word[w] & ~counter->bit[i - 1U][w];
+            any |= zero.word[w];
+        }
+        if (any != 0U) {
+            cand = zero;
+        } else {
+            value |= 1UL << (i - 1U);
+        }
+    }
+    *p_min = (hdc_dist_t)value;
+    return cand;
+}
+
+/**
+ * @brief   Whether any lane is set
+ */
+static inline bool amt_any(const amt_lanes_t* lanes)
+{
+    uint64_t any = 0U;
+
+    for (uint8_t w = 0U; w < AMT_W; w++) {
+        any |= lanes->word[w];
+    }
+    return (any != 0U);
+}
+
+/**
+ * @brief   Distances of one block's lanes over the first dims dimensions
+ * @param   counter Receives the counts
+ * @param   planes Block planes
+ * @param   query Query hypervector
+ * @param   dims Dimensions to cover (a multiple of AMT_GROUP_DIMS, or all)
+ * @param   alive Lanes holding classes; receives the lanes still within bound
+ * @param   bound Largest distance that could still place; HV_DIMENSIONS
+ *          disables pruning
+ * @return  true if any lane is left (exact counts in counter)
+ */
+static bool amt_scan(amt_counter_t* counter, const uint64_t* planes, const uint8_t* query,
+                     uint32_t dims, amt_lanes_t* alive, hdc_dist_t bound)
+{
+    amt_vec_t tail[AMT_GROUP_DIMS];
+
+    memset(counter, 0, sizeof(*counter));
+    for (uint32_t d = 0U; d < dims; d += AMT_GROUP_DIMS) {
+        const uint64_t* group = &planes[d * AMT_W];
+        uint32_t bits = query[d / 8U];
+
+        if ((d + AMT_GROUP_DIMS) <= HV_DIMENSIONS) {
+            bits |= (uint32_t)query[(d / 8U) + 1U] << 8;
+        } else {
+            /* Last, partial group: zero planes and query bits past the end */
+            uint32_t count = HV_DIMENSIONS - d;
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, group, (size_t)count * sizeof(amt_vec_t));
+            bits &= (1UL << count) - 1UL;
+            group = &tail[0][0];
+        }
+        amt_accumulate(counter, group, bits);
+
+        if ((bound < (hdc_dist_t)HV_DIMENSIONS) && (((d + AMT_GROUP_DIMS) % HDC_AMT_CHUNK_DIMS) == 0U)) {
+            if (!amt_prune(counter, bound, alive)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief   Lanes of a block that hold classes
+ */
+static inline void amt_block_lanes(const hdc_amt_t* amt, uint32_t block, amt_lanes_t* lanes)
+{
+    uint32_t left = (uint32_t)amt->count - (block * HDC_AMT_LANES);
+
+    for (uint8_t w = 0U; w < AMT_W; w++) {
+        uint32_t first = 64U * w;
+        if (left >= (first + 64U)) {
+            lanes->word[w] = ~(uint64_t)0U;
+        } else if (left > first) {
+            lanes->word[w] = ((uint64_t)1U << (left - first)) - 1U;
+        } else {
+            lanes->word[w] = 0U;
+        }
+    }
+}
+
+/**
+ * @brief   Insert a candidate into a top-k list ordered by (distance, class)
+ * @note    Blocks are not searched in class order, so ties compare the ID
+ */
+static void amt_topk_insert(hdc_am_match_t* list, uint8_t* p_len, uint8_t k,
+                            hdc_class_t class_id, hdc_dist_t distance)
+{
+    uint8_t len = *p_len;
+
+    if (len == k) {
+        const hdc_am_match_t* last = &list[k - 1U];
+        if ((distance > last->distance) ||
+            ((distance == last->distance) && (class_id > last->class_id))) {
+            return;
+        }
+        len--;
+    }
+
+    uint8_t i = len;
+    while ((i > 0U) && ((list[i - 1U].distance > distance) ||
+                        ((list[i - 1U].distance == distance) && (list[i - 1U].class_id > class_id)))) {
+        list[i] = list[i - 1U];
+        i--;
+    }
+
+    list[i].class_id = class_id;
+    list[i].distance = distance;
+    *p_len = (uint8_t)(len + 1U);
+}
+
+/**
+ * @brief   Search one block and merge its surviving lanes into the list
+ *
+ * @details Survivors are taken in ascending distance with amt_min(), so
+ *          only lanes that can still place are ever visited one by one.
+ */
+static void amt_search_block(const hdc_amt_t* amt, uint32_t block, const uint8_t* query,
+                             hdc_am_match_t* list, uint8_t* p_len, uint8_t k)
+{
+    amt_counter_t counter;
+    amt_lanes_t alive;
+    hdc_dist_t bound = (hdc_dist_t)HV_DIMENSIONS;
+
+    if ((amt->search == HDC_AM_SEARCH_BOUNDED) && (*p_len == k)) {
+        bound = list[k - 1U].distance;
+    }
+
+    amt_block_lanes(amt, block, &alive);
+    if (!amt_scan(&counter, &amt->planes[block * AMT_BLOCK_SPAN], query,
+                  (uint32_t)HV_DIMENSIONS, &alive, bound)) {
+        return;
+    }
+
+    while (amt_any(&alive)) {
+        hdc_dist_t distance;
+        amt_lanes_t at = amt_min(&counter, &alive, &distance);
+
+        if ((*p_len == k) && (distance > list[k - 1U].distance)) {
+            break;
+        }
+        for (uint8_t w = 0U; w < AMT_W; w++) {
+            alive.word[w] &= ~at.word[w];
+            for (uint8_t j = 0U; at.word[w] != 0U; j++, at.word[w] >>= 1) {
+                if ((at.word[w] & 1U) != 0U) {
+                    amt_topk_insert(list, p_len, k,
+                                    (hdc_class_t)((block * HDC_AMT_LANES) + (64U * w) + j),
+                                    distance);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief   Block with the closest partial match over HDC_AMT_PROBE_DIMS
+ * @return  Block index
+ */
+static uint32_t amt_probe(const hdc_amt_t* amt, const uint8_t* query, uint32_t blocks)
+{
+    uint32_t best_block = 0U;
+    hdc_dist_t best = (hdc_dist_t)HV_DIMENSIONS;
+
+    for (uint32_t b = 0U; b < blocks; b++) {
+        amt_counter_t counter;
+        amt_lanes_t lanes;
+        hdc_dist_t partial;
+
+        amt_block_lanes(amt, b, &lanes);
+        (void)amt_scan(&counter, &amt->planes[b * AMT_BLOCK_SPAN], query, HDC_AMT_PROBE_DIMS,
+                       &lanes, (hdc_dist_t)HV_DIMENSIONS);
+        (void)amt_min(&counter, &lanes, &partial);
+        if (partial < best) {
+            best = partial;
+            best_block = b;
+        }
+    }
+    return best_block;
+}
+
+/**
+ * @brief   Plane word and bit of one class in dimension 0
+ */
+static inline uint32_t amt_offset(hdc_class_t class_id)
+{
+    uint32_t lane = (uint32_t)(class_id % HDC_AMT_LANES);
+
+    return ((uint32_t)(class_id / HDC_AMT_LANES) * AMT_BLOCK_SPAN) + (lane / 64U);
+}
+
+/**
+ * @brief   Write one class's bits into its lane
+ */
+static void amt_write(uint64_t* planes, hdc_class_t class_id, const uint8_t* prototype)
+{
+    uint64_t* word = &planes[amt_offset(class_id)];
+    uint64_t mask = (uint64_t)1U << (class_id % 64U);
+
+    for (uint32_t d = 0U; d < HV_DIMENSIONS; d++) {
+        uint64_t bit = (uint64_t)((prototype[d / 8U] >> (d % 8U)) & 1U);
+        word[d * AMT_W] = (word[d * AMT_W] & ~mask) | (((uint64_t)0U - bit) & mask);
+    }
+}
+
+/* =============================================================================
+ * Management
+ * ========================================================================== */
+
+/**
+ * @brief   Initialize an empty transposed memory over caller storage
+ * @param   amt Memory to initialize
+ * @param   planes HDC_AMT_WORDS(capacity) words (cleared here)
+ * @param   capacity Number of classes the storage holds
+ */
+void hdc_amt_init(hdc_amt_t* amt, uint64_t* planes, hdc_class_t capacity)
+{
+    amt->planes = planes;
+    amt->capacity = capacity;
+    amt->count = 0U;
+    amt->search = HDC_AM_SEARCH_BOUNDED;
+    amt->flags = 0U;
+    memset(planes, 0, (size_t)HDC_AMT_WORDS(capacity) * sizeof(uint64_t));
+}
+
+/**
+ * @brief   Initialize a read-only transposed memory over existing planes
+ * @param   amt Memory to initialize
+ * @param   planes HDC_AMT_WORDS(count) words
+ * @param   count Number of classes in the planes
+ */
+void hdc_amt_init_view(hdc_amt_t* amt, const uint64_t* planes, hdc_class_t count)
+{
+    /* Never written through: add/set refuse HDC_AM_FLAG_READ_ONLY memories */
+    amt->planes = (uint64_t*)planes;
+    amt->capacity = count;
+    amt->count = count;
+    amt->search = HDC_AM_SEARCH_BOUNDED;
+    amt->flags = HDC_AM_FLAG_READ_ONLY;
+}
+
+/**
+ * @brief   Select the search strategy
+ * @param   amt Memory
+ * @param   search HDC_AM_SEARCH_EXHAUSTIVE or HDC_AM_SEARCH_BOUNDED
+ */
+void hdc_amt_set_search(hdc_amt_t* amt, hdc_am_search_t search)
+{
+    amt->search = search;
+}
+
+/**
+ * @brief   Append a class prototype
+ * @param   amt Memory
+ * @param   prototype Class hypervector
+ * @param   p_class_id Receives the new class ID (may be NULL)
+ * @return  HDC_AM_OK, HDC_AM_ERROR_FULL, or HDC_AM_ERROR_READ_ONLY
+ */
+hdc_am_status_t hdc_amt_add(hdc_amt_t* amt, const hv_t prototype, hdc_class_t* p_class_id)
+{
+    if ((amt->flags & HDC_AM_FLAG_READ_ONLY) != 0U) {
+        return HDC_AM_ERROR_READ_ONLY;
+    }
+    if (amt->count >= amt->capacity) {
+        return HDC_AM_ERROR_FULL;
+    }
+
+    amt_write(amt->planes, amt->count, prototype);
+    if (p_class_id != NULL) {
+        *p_class_id = amt->count;
+    }
+    amt->count++;
+    return HDC_AM_OK;
+}
+
+/**
+ * @brief   Overwrite an existing class prototype
+ * @param   amt Memory
+ * @param   class_id Class to overwrite
+ * @param   prototype New class hypervector
+ * @return  HDC_AM_OK, HDC_AM_ERROR_INVALID_CLASS, or HDC_AM_ERROR_READ_ONLY
+ */
+hdc_am_status_t hdc_amt_set(hdc_amt_t* amt, hdc_class_t class_id, const hv_t prototype)
+{
+    if ((amt->flags & HDC_AM_FLAG_READ_ONLY) != 0U) {
+        return HDC_AM_ERROR_READ_ONLY;
+    }
+    if (class_id >= amt->count) {
+        return HDC_AM_ERROR_INVALID_CLASS;
+    }
+
+    amt_write(amt->planes, class_id, prototype);
+    return HDC_AM_OK;
+}
+
+/**
+ * @brief   Gather a class prototype back out of the planes
+ * @param   amt Memory
+ * @param   class_id Class to read
+ * @param   out Receives the class hypervector
+ * @return  HDC_AM_OK, or HDC_AM_ERROR_INVALID_CLASS
+ */
+hdc_am_status_t hdc_amt_read(const hdc_amt_t* amt, hdc_class_t class_id, hv_t out)
+{
+    if (class_id >= amt->count) {
+        return HDC_AM_ERROR_INVALID_CLASS;
+    }
+
+    const uint64_t* word = &amt->planes[amt_offset(class_id)];
+    uint8_t j = (uint8_t)(class_id % 64U);
+
+    hdc_clear(out);
+    for (uint32_t d = 0U; d < HV_DIMENSIONS; d++) {
+        out[d / 8U] |= (uint8_t)(((word[d * AMT_W] >> j) & 1U) << (d % 8U));
+    }
+    return HDC_AM_OK;
+}
+
+/* =============================================================================
+ * Search
+ * ========================================================================== */
+
+/**
+ * @brief   Find the nearest class to a query
+ * @param   amt Memory
+ * @param   query Query hypervector
+ * @param   p_best Receives the best match
+ * @return  HDC_AM_OK, or HDC_AM_ERROR_EMPTY (p_best->class_id = HDC_AM_CLASS_NONE)
+ */
+hdc_am_status_t hdc_amt_query(const hdc_amt_t* amt, const hv_t query, hdc_am_match_t* p_best)
+{
+    if (hdc_amt_query_topk(amt, query, p_best, 1U) == 0U) {
+        p_best->class_id = HDC_AM_CLASS_NONE;
+        p_best->distance = (hdc_dist_t)HV_DIMENSIONS;
+        return HDC_AM_ERROR_EMPTY;
+    }
+    return HDC_AM_OK;
+}
+
+/**
+ * @brief   Find the k nearest classes to a query
+ * @param   amt Memory
+ * @param   query Query hypervector
+ * @param   results Output array of at least k entries, nearest first
+ * @param   k Number of results requested
+ * @return  Number of results written (min(k, class count))
+ *
+ * @details Bounded mode searches the block picked by amt_probe() first,
+ *          then the others in order; exhaustive mode searches in order.
+ */
+uint8_t hdc_amt_query_topk(const hdc_amt_t* amt, const hv_t query,
+                           hdc_am_match_t* results, uint8_t k)
+{
+    uint32_t blocks = HDC_AMT_BLOCKS(amt->count);
+    uint32_t first = 0U;
+    uint8_t len = 0U;
+
+    if ((k == 0U) || (blocks == 0U)) {
+        return 0U;
+    }
+
+    if (AMT_PROBE_ON && (amt->search == HDC_AM_SEARCH_BOUNDED) && (blocks > 1U)) {
+        first = amt_probe(amt, query, blocks);
+    }
+
+    amt_search_block(amt, first, query, results, &len, k);
+    for (uint32_t b = 0U; b < blocks; b++) {
+        if (b != first) {
+            amt_search_block(amt, b, query, results, &len, k);
+        }
+    }
+    return len;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file    hdc_amt.h
+ * @brief   HDC Associative Memory - Transposed (Bit-Sliced) Class Store
+ * @version 1.0.0
+ * @note    Meant for gateway-sized tables; portable C with 64-bit words
+ *
+ * @details hdc_am.h keeps one row per class, so a search reads every bit of
+ *          every class one class at a time. This memory stores the classes
+ *          transposed in blocks of HDC_AMT_LANES = 256 classes, with four
+ *          64-bit words per dimension:
+ *
+ *            planes[((block * HV_DIMENSIONS) + d) * 4 + w], bit j
+ *              = bit d of class 256 * block + 64 * w + j
+ *
+ *          The words of one dimension XOR the broadcast query bit give its
+ *          mismatch for 256 classes at once. The mismatches are added into
+ *          bit-sliced counters with a carry-save adder tree (Harley-Seal).
+ *          That is about 6 word operations per dimension and no popcount,
+ *          and the four independent words vectorize to one AVX2 or two NEON
+ *          registers.
+ *
+ *          In HDC_AM_SEARCH_BOUNDED mode (the default), every
+ *          HDC_AMT_CHUNK_DIMS dimensions the counters are compared,
+ *          bit-sliced, against the distance a class must beat (the current
+ *          k-th result). Lanes past it are dropped, and a block stops once
+ *          no lane is left, so the rest of its planes are never read. A
+ *          first pass over HDC_AMT_PROBE_DIMS dimensions of every block picks
+ *          the block with the closest partial match and searches it first,
+ *          so the bound is tight before the other blocks are scanned.
+ *          Partial distances only grow, so no class that could place is
+ *          ever dropped. Pruning pays off when the k-th result is well
+ *          below the distance of unrelated classes (HV_DIMENSIONS / 2),
+ *          typically k = 1 against a clear match.
+ *
+ *          Results are identical to hdc_am_query_topk() over the same
+ *          classes in either mode: ascending distance, ties lower class ID
+ *          first.
+ *
+ *          A model file can hold this layout (gw_model.h), and
+ *          hdc_amt_init_view() searches the mapped planes in place.
+ */
+
+#ifndef HDC_AMT_H
+#define HDC_AMT_H
+
+#include <stdint.h>
+#include "hdc_core.h"
+#include "hdc_am.h"
+
+/* =============================================================================
+ * Constants
+ * ========================================================================== */
+
+/** @brief 64-bit words per dimension of a block (fixed: part of the file layout) */
+#define HDC_AMT_BLOCK_WORDS     4U
+
+/** @brief Classes per block */
+#define HDC_AMT_LANES           (64U * HDC_AMT_BLOCK_WORDS)
+
+/** @brief Blocks needed for a class count */
+#define HDC_AMT_BLOCKS(count)   (((uint32_t)(count) + HDC_AMT_LANES - 1U) / HDC_AMT_LANES)
+
+/** @brief Plane words of storage for a class count */
+#define HDC_AMT_WORDS(count)    (HDC_AMT_BLOCKS(count) * (uint32_t)HV_DIMENSIONS * HDC_AMT_BLOCK_WORDS)
+
+/** @brief Dimensions between bound checks in bounded mode (multiple of 16) */
+#ifndef HDC_AMT_CHUNK_DIMS
+#define HDC_AMT_CHUNK_DIMS      128U
+#endif
+
+/**
+ * @brief Dimensions of the ranking pass in bounded mode (multiple of 16)
+ * @note  The pass is skipped when it is 0 or more than HV_DIMENSIONS / 4
+ */
+#ifndef HDC_AMT_PROBE_DIMS
+#define HDC_AMT_PROBE_DIMS      128U
+#endif
+
+#if ((HDC_AMT_CHUNK_DIMS % 16U) != 0U) || ((HDC_AMT_PROBE_DIMS % 16U) != 0U) || \
+    (HDC_AMT_CHUNK_DIMS == 0U)
+#error "HDC_AMT_CHUNK_DIMS and HDC_AMT_PROBE_DIMS must be non-zero multiples of 16"
+#endif
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Transposed associative memory over caller-provided planes */
+typedef struct {
+    uint64_t*       planes;     /**< HDC_AMT_WORDS(capacity) words (caller-owned) */
+    hdc_class_t     capacity;   /**< Classes the planes can hold */
+    hdc_class_t     count;      /**< Classes in use */
+    hdc_am_search_t search;     /**< Search strategy (results are identical) */
+    uint8_t         flags;      /**< HDC_AM_FLAG_READ_ONLY for views */
+} hdc_amt_t;
+
+/* =============================================================================
+ * Function Declarations - Management
+ * ========================================================================== */
+
+/**
+ * @brief   Initialize an empty transposed memory over caller storage
+ * @param   amt Memory to initialize
+ * @param   planes HDC_AMT_WORDS(capacity) words (cleared here)
+ * @param   capacity Number of classes the storage holds
+ * @note    The search strategy defaults to HDC_AM_SEARCH_BOUNDED
+ */
+void hdc_amt_init(hdc_amt_t* amt, uint64_t* planes, hdc_class_t capacity);
+
+/**
+ * @brief   Initialize a read-only transposed memory over existing planes
+ * @param   amt Memory to initialize
+ * @param   planes HDC_AMT_WORDS(count) words (e.g. mapped from a model file)
+ * @param   count Number of classes in the planes
+ * @note    hdc_amt_add() and hdc_amt_set() return HDC_AM_ERROR_READ_ONLY
+ */
+void hdc_amt_init_view(hdc_amt_t* amt, const uint64_t* planes, hdc_class_t count);
+
+/**
+ * @brief   Select the search strategy
+ * @param   amt Memory
+ * @param   search HDC_AM_SEARCH_EXHAUSTIVE or HDC_AM_SEARCH_BOUNDED
+ */
+void hdc_amt_set_search(hdc_amt_t* amt, hdc_am_search_t search);
+
+/**
+ * @brief   Append a class prototype
+ * @param   amt Memory
+ * @param   prototype Class hypervector (transposed into the planes)
+ * @param   p_class_id Receives the new class ID (may be NULL)
+ * @return  HDC_AM_OK, HDC_AM_ERROR_FULL, or HDC_AM_ERROR_READ_ONLY
+ */
+hdc_am_status_t hdc_amt_add(hdc_amt_t* amt, const hv_t prototype, hdc_class_t* p_class_id);
+
+/**
+ * @brief   Overwrite an existing class prototype
+ * @param   amt Memory
+ * @param   class_id Class to overwrite
+ * @param   prototype New class hypervector
+ * @return  HDC_AM_OK, HDC_AM_ERROR_INVALID_CLASS, or HDC_AM_ERROR_READ_ONLY
+ */
+hdc_am_status_t hdc_amt_set(hdc_amt_t* amt, hdc_class_t class_id, const hv_t prototype);
+
+/**
+ * @brief   Gather a class prototype back out of the planes
+ * @param   amt Memory
+ * @param   class_id Class to read
+ * @param   out Receives the class hypervector
+ * @return  HDC_AM_OK, or HDC_AM_ERROR_INVALID_CLASS
+ */
+hdc_am_status_t hdc_amt_read(const hdc_amt_t* amt, hdc_class_t class_id, hv_t out);
+
+/* =============================================================================
+ * Function Declarations - Search
+ * ========================================================================== */
+
+/**
+ * @brief   Find the nearest class to a query
+ * @param   amt Memory
+ * @param   query Query hypervector
+ * @param   p_best Receives the best match
+ * @return  HDC_AM_OK, or HDC_AM_ERROR_EMPTY (p_best->class_id = HDC_AM_CLASS_NONE)
+ */
+hdc_am_status_t hdc_amt_query(const hdc_amt_t* amt, const hv_t query, hdc_am_match_t* p_best);
+
+/**
+ * @brief   Find the k nearest classes to a query
+ * @param   amt Memory
+ * @param   query Query hypervector
+ * @param   results Output array of at least k entries, nearest first
+ * @param   k Number of results requested
+ * @return  Number of results written (min(k, class count))
+ */
+uint8_t hdc_amt_query_topk(const hdc_amt_t* amt, const hv_t query,
+                           hdc_am_match_t* results, uint8_t k);
+
+#endif /* HDC_AMT_H */
@@ -2,16 +2,42 @@
  * @file    hdc_core.c
  * @brief   Hyperdimensional Computing Core Operations - Implementation
  * @version 2.0.0
- * @note    128-bit hypervectors (16 bytes), optimized for ATmega328P
+ * @note    128-bit hypervectors (16 bytes) by default, optimized for ATmega328P
  *
  * @details This file contains the implementation of HDC core operations.
  *          Separating implementation from declarations follows Engineer/JPL
  *          coding standards and enables proper code coverage measurement.
+ *
+ *          The bitwise and distance loops delegate to the compile-time
+ *          selected kernel backend in hdc_kernel.h (byte, word, AVX2, NEON,
+ *          AVR assembly).
  */
 
 #include "hdc_core.h"
+#include "hdc_kernel.h"
+#include "hdc_probe.h"
 #include <string.h>
 
+#if (HDC_KERNEL == HDC_KERNEL_AVR)
+#if defined(__AVR__)
+    #define HDC_LUT_ALIGN   __attribute__((aligned(256)))
+#else
+    #define HDC_LUT_ALIGN
+#endif
+
+#define HDC_LUT_B2(n)   (n), (n) + 1U, (n) + 1U, (n) + 2U
+#define HDC_LUT_B4(n)   HDC_LUT_B2(n), HDC_LUT_B2((n) + 1U), HDC_LUT_B2((n) + 1U), HDC_LUT_B2((n) + 2U)
+#define HDC_LUT_B6(n)   HDC_LUT_B4(n), HDC_LUT_B4((n) + 1U), HDC_LUT_B4((n) + 1U), HDC_LUT_B4((n) + 2U)
+
+/**
+ * @brief   Bits set in each byte value (read by hdc_kernel_popcount8() and
+ *          the AVR assembly loops in hdc_kernel.h)
+ */
+const uint8_t hdc_popcount_lut_P[256] HDC_FLASH HDC_LUT_ALIGN = {
+    HDC_LUT_B6(0U), HDC_LUT_B6(1U), HDC_LUT_B6(1U), HDC_LUT_B6(2U)
+};
+#endif
+
 /**
  * @brief   Count set bits in a single byte (population count)
  * @param   byte Input byte
@@ -20,23 +46,17 @@
  */
 uint8_t hdc_popcount8(uint8_t byte)
 {
-    byte = byte - ((byte >> 1) & 0x55U);
-    byte = (byte & 0x33U) + ((byte >> 2) & 0x33U);
-    return (byte + (byte >> 4)) & 0x0FU;
+    return hdc_kernel_popcount8(byte);
 }
 
 /**
  * @brief   Count total set bits in a hypervector
  * @param   hv Input hypervector
- * @return  Total number of bits set to 1 (0-128)
+ * @return  Total number of bits set to 1 (0-HV_DIMENSIONS)
  */
-uint8_t hdc_popcount(const hv_t hv)
+hdc_dist_t hdc_popcount(const hv_t hv)
 {
-    uint8_t count = 0U;
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
-        count += hdc_popcount8(hv[i]);
-    }
-    return count;
+    return hdc_kernel_popcount(hv, HV_BYTES);
 }
 
 /**
@@ -48,9 +68,7 @@ uint8_t hdc_popcount(const hv_t hv)
  */
 void hdc_xor(hv_t result, const hv_t a, const hv_t b)
 {
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
-        result[i] = a[i] ^ b[i];
-    }
+    hdc_kernel_xor(result, a, b, HV_BYTES);
 }
 
 /**
@@ -61,9 +79,7 @@ void hdc_xor(hv_t result, const hv_t a, const hv_t b)
  */
 void hdc_or(hv_t result, const hv_t a, const hv_t b)
 {
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
-        result[i] = a[i] | b[i];
-    }
+    hdc_kernel_or(result, a, b, HV_BYTES);
 }
 
 /**
@@ -74,9 +90,7 @@ void hdc_or(hv_t result, const hv_t a, const hv_t b)
  */
 void hdc_and(hv_t result, const hv_t a, const hv_t b)
 {
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
-        result[i] = a[i] & b[i];
-    }
+    hdc_kernel_and(result, a, b, HV_BYTES);
 }
 
 /**
@@ -87,34 +101,43 @@ void hdc_and(hv_t result, const hv_t a, const hv_t b)
  */
 void hdc_bundle(hv_t memory, const hv_t pattern)
 {
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
-        memory[i] |= pattern[i];
-    }
+    hdc_kernel_or(memory, memory, pattern, HV_BYTES);
 }
 
 /**
  * @brief   Calculate Hamming distance between two hypervectors
  * @param   a First hypervector
  * @param   b Second hypervector
- * @return  Hamming distance (0-128)
+ * @return  Hamming distance (0-HV_DIMENSIONS)
  * @note    Lower distance = more similar
  */
-uint8_t hdc_hamming(const hv_t a, const hv_t b)
+hdc_dist_t hdc_hamming(const hv_t a, const hv_t b)
 {
-    uint8_t distance = 0U;
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
-        distance += hdc_popcount8(a[i] ^ b[i]);
-    }
+    HDC_PROBE_BEGIN(HDC_PROBE_HAMMING);
+    hdc_dist_t distance = hdc_kernel_hamming(a, b, HV_BYTES);
+    HDC_PROBE_END(HDC_PROBE_HAMMING);
     return distance;
 }
 
+/**
+ * @brief   Hamming distance with early exit above a bound
+ * @param   a First hypervector
+ * @param   b Second hypervector
+ * @param   bound Largest distance of interest (e.g. best match so far)
+ * @return  Exact distance if it is <= bound, otherwise some value > bound
+ */
+hdc_dist_t hdc_hamming_bounded(const hv_t a, const hv_t b, hdc_dist_t bound)
+{
+    return hdc_kernel_hamming_bounded(a, b, HV_BYTES, bound);
+}
+
 /**
  * @brief   Calculate similarity between two hypervectors
  * @param   a First hypervector
  * @param   b Second hypervector
- * @return  Similarity score (0-128, higher = more similar)
+ * @return  Similarity score (0-HV_DIMENSIONS, higher = more similar)
  */
-uint8_t hdc_similarity(const hv_t a, const hv_t b)
+hdc_dist_t hdc_similarity(const hv_t a, const hv_t b)
 {
     return HV_DIMENSIONS - hdc_hamming(a, b);
 }
@@ -148,36 +171,71 @@ void hdc_copy(hv_t dest, const hv_t src)
     memcpy(dest, src, HV_BYTES);
 }
 
+/**
+ * @brief   Reverse a byte range in place
+ * @param   p First byte
+ * @param   n Number of bytes
+ */
+static void reverse_bytes(uint8_t* p, hdc_index_t n)
+{
+    hdc_index_t lo = 0U;
+    hdc_index_t hi = n;
+
+    while ((hdc_index_t)(lo + 1U) < hi) {
+        hi--;
+        uint8_t t = p[lo];
+        p[lo] = p[hi];
+        p[hi] = t;
+        lo++;
+    }
+}
+
 /**
  * @brief   Circular permutation of a hypervector
  * @param   hv Hypervector to permute (modified in place)
  * @param   shifts Number of bit positions to shift
  * @note    Permutation creates orthogonal vectors for sequence encoding
+ *
+ * @details Bit j moves to bit (j + shifts) % HV_DIMENSIONS, in place:
+ *          - whole bytes rotate by three reversals (none if shifts < 8)
+ *          - the remaining 1-7 bits move in one carry pass over words,
+ *            skipped when shifts is a multiple of 8
+ *          No temporary vector and no per-byte modulo.
  */
-void hdc_permute(hv_t hv, uint8_t shifts)
+void hdc_permute(hv_t hv, hdc_dist_t shifts)
 {
+    shifts = shifts % HV_DIMENSIONS;
     if (shifts == 0U) {
         return;
     }
 
-    shifts = shifts % HV_DIMENSIONS;
-    uint8_t byte_shift = shifts / 8U;
-    uint8_t bit_shift = shifts % 8U;
+    HDC_PROBE_BEGIN(HDC_PROBE_PERMUTE);
+    hdc_index_t byte_shift = (hdc_index_t)(shifts / 8U);
+    uint8_t bit_shift = (uint8_t)(shifts % 8U);
 
-    hv_t temp;
-    hdc_clear(temp);
+    if (byte_shift != 0U) {
+        /* Rotate right by byte_shift: byte i moves to i + byte_shift */
+        reverse_bytes(hv, HV_BYTES);
+        reverse_bytes(hv, byte_shift);
+        reverse_bytes(&hv[byte_shift], (hdc_index_t)(HV_BYTES - byte_shift));
+    }
 
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
-        uint8_t dest_byte = (i + byte_shift) % HV_BYTES;
+    if (bit_shift != 0U) {
+        /* The top bits of the last byte wrap around into bit 0 */
+        hdc_word_t carry = (hdc_word_t)(hv[HV_BYTES - 1U] >> (8U - bit_shift));
+        hdc_index_t i = 0U;
 
-        if (bit_shift == 0U) {
-            temp[dest_byte] = hv[i];
-        } else {
-            temp[dest_byte] |= (hv[i] << bit_shift);
-            uint8_t next_byte = (dest_byte + 1U) % HV_BYTES;
-            temp[next_byte] |= (hv[i] >> (8U - bit_shift));
+        for (hdc_index_t w = 0U; w != HDC_HV_WORDS; w++) {
+            hdc_word_t word = hdc_word_load(&hv[i]);
+            hdc_word_store(&hv[i], (hdc_word_t)((hdc_word_t)(word << bit_shift) | carry));
+            carry = (hdc_word_t)(word >> (HDC_WORD_BITS - bit_shift));
+            i = (hdc_index_t)(i + HDC_WORD_BYTES);
+        }
+        for (; i < HV_BYTES; i++) {
+            uint8_t byte = hv[i];
+            hv[i] = (uint8_t)((uint8_t)(byte << bit_shift) | (uint8_t)carry);
+            carry = (hdc_word_t)(byte >> (8U - bit_shift));
         }
     }
-
-    hdc_copy(hv, temp);
+    HDC_PROBE_END(HDC_PROBE_PERMUTE);
 }
@@ -2,7 +2,7 @@
  * @file    hdc_core.h
  * @brief   Hyperdimensional Computing Core Operations - Declarations
  * @version 2.0.0
- * @note    128-bit hypervectors (16 bytes), optimized for ATmega328P
+ * @note    128-bit hypervectors (16 bytes) by default, optimized for ATmega328P
  *
  * @details This header provides declarations for HDC core operations.
  *          Implementation is in hdc_core.c (Engineer/JPL standard practice).
@@ -21,19 +21,51 @@
  * Constants
  * ========================================================================== */
 
-/** @brief Number of dimensions in hypervector (bits) */
+/**
+ * @brief Number of dimensions in hypervector (bits)
+ * @note  Build-time parameter: -DHV_DIMENSIONS=1024U in platformio.ini.
+ *        Must be a multiple of 8. The Uno keeps the 128-bit default.
+ */
+#ifndef HV_DIMENSIONS
 #define HV_DIMENSIONS   128U
+#endif
 
 /** @brief Size of hypervector in bytes */
-#define HV_BYTES        16U
+#define HV_BYTES        (HV_DIMENSIONS / 8U)
+
+#if ((HV_DIMENSIONS % 8U) != 0U) || (HV_DIMENSIONS == 0U)
+    #error "HV_DIMENSIONS must be a non-zero multiple of 8"
+#endif
+
+#if (HV_DIMENSIONS > 65528U)
+    #error "HV_DIMENSIONS exceeds the 16-bit distance type"
+#endif
 
 /* =============================================================================
  * Types
  * ========================================================================== */
 
-/** @brief Hypervector type - 128-bit binary vector stored as byte array */
+/** @brief Hypervector type - HV_DIMENSIONS-bit binary vector stored as byte array */
 typedef uint8_t hv_t[HV_BYTES];
 
+/**
+ * @brief Distance / bit-count type (popcount, Hamming, similarity, shifts)
+ * @note  uint8_t while every count fits in 8 bits, so the AVR keeps its
+ *        8-bit arithmetic; uint16_t for wide gateway vectors.
+ */
+#if (HV_DIMENSIONS <= 255U)
+typedef uint8_t hdc_dist_t;
+#else
+typedef uint16_t hdc_dist_t;
+#endif
+
+/** @brief Byte index type covering 0..HV_BYTES */
+#if (HV_BYTES <= 255U)
+typedef uint8_t hdc_index_t;
+#else
+typedef uint16_t hdc_index_t;
+#endif
+
 /* =============================================================================
  * Function Declarations - Population Count
  * ========================================================================== */
@@ -49,9 +81,9 @@ uint8_t hdc_popcount8(uint8_t byte);
 /**
  * @brief   Count total set bits in a hypervector
  * @param   hv Input hypervector
- * @return  Total number of bits set to 1 (0-128)
+ * @return  Total number of bits set to 1 (0-HV_DIMENSIONS)
  */
-uint8_t hdc_popcount(const hv_t hv);
+hdc_dist_t hdc_popcount(const hv_t hv);
 
 /* =============================================================================
  * Function Declarations - Bitwise Operations
@@ -86,7 +118,8 @@ void hdc_and(hv_t result, const hv_t a, const hv_t b);
  * @brief   Bundle (accumulate) a pattern into memory using OR
  * @param   memory Hypervector memory to accumulate into
  * @param   pattern Pattern to add
- * @note    This is a simplified bundling using OR (saturating)
+ * @note    This is a simplified bundling using OR (saturating); use
+ *          hdc_counter_add() / hdc_counter_threshold() for majority bundling
  */
 void hdc_bundle(hv_t memory, const hv_t pattern);
 
@@ -98,18 +131,29 @@ void hdc_bundle(hv_t memory, const hv_t pattern);
  * @brief   Calculate Hamming distance between two hypervectors
  * @param   a First hypervector
  * @param   b Second hypervector
- * @return  Hamming distance (0-128)
+ * @return  Hamming distance (0-HV_DIMENSIONS)
  * @note    Lower distance = more similar
  */
-uint8_t hdc_hamming(const hv_t a, const hv_t b);
+hdc_dist_t hdc_hamming(const hv_t a, const hv_t b);
+
+/**
+ * @brief   Hamming distance with early exit above a bound
+ * @param   a First hypervector
+ * @param   b Second hypervector
+ * @param   bound Largest distance of interest (e.g. best match so far)
+ * @return  Exact distance if it is <= bound, otherwise some value > bound
+ * @note    Stops summing once the partial distance exceeds bound, so
+ *          clearly distant candidates cost only a fraction of hdc_hamming()
+ */
+hdc_dist_t hdc_hamming_bounded(const hv_t a, const hv_t b, hdc_dist_t bound);
 
 /**
  * @brief   Calculate similarity between two hypervectors
  * @param   a First hypervector
  * @param   b Second hypervector
- * @return  Similarity score (0-128, higher = more similar)
+ * @return  Similarity score (0-HV_DIMENSIONS, higher = more similar)
  */
-uint8_t hdc_similarity(const hv_t a, const hv_t b);
+hdc_dist_t hdc_similarity(const hv_t a, const hv_t b);
 
 /* =============================================================================
  * Function Declarations - Memory Operations
@@ -145,6 +189,6 @@ void hdc_copy(hv_t dest, const hv_t src);
  * @param   shifts Number of bit positions to shift
  * @note    Permutation creates orthogonal vectors for sequence encoding
  */
-void hdc_permute(hv_t hv, uint8_t shifts);
+void hdc_permute(hv_t hv, hdc_dist_t shifts);
 
 #endif /* HDC_CORE_H */
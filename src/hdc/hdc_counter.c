@@ -0,0 +1,315 @@
+/**
+ * @file    hdc_counter.c
+ * @brief   HDC Majority Bundling - Implementation
+ * @version 1.1.0
+ * @note    Word-wide ripple-carry over bit-sliced saturating counters
+ *
+ * @details Every operation walks the planes one hdc_word_t at a time. The
+ *          last word of a width that is not a multiple of the word size is
+ *          zero padded on load and only its valid bytes are stored back.
+ *          Subtracting is adding the complemented pattern word; the padding
+ *          bytes it sets are never stored.
+ */
+
+#include "hdc_counter.h"
+#include "hdc_kernel.h"
+#include "hdc_probe.h"
+#include <stddef.h>
+
+/* =============================================================================
+ * Private Helpers
+ * ========================================================================== */
+
+/**
+ * @brief   Add one pattern word to the counters of one word position
+ * @param   planes Counter plane words at this position (updated)
+ * @param   pattern Pattern word
+ *
+ * @details Increment and decrement ripple through the planes together:
+ *          a plane bit flips where a carry (or borrow) arrives; the carry
+ *          continues where the bit was 1, the borrow where it was 0.
+ *          Dimensions already at HDC_COUNTER_MAX do not count up and
+ *          dimensions at 0 do not count down, so counters saturate.
+ */
+static inline void counter_add_word(hdc_word_t planes[HDC_COUNTER_PLANES],
+                                    hdc_word_t pattern)
+{
+    hdc_word_t all_ones = planes[0];
+    hdc_word_t any_ones = planes[0];
+
+    for (uint8_t j = 1U; j < HDC_COUNTER_PLANES; j++) {
+        all_ones &= planes[j];
+        any_ones |= planes[j];
+    }
+
+    hdc_word_t inc = pattern & (hdc_word_t)~all_ones;
+    hdc_word_t dec = (hdc_word_t)~pattern & any_ones;
+
+    for (uint8_t j = 0U; j < HDC_COUNTER_PLANES; j++) {
+        hdc_word_t p = planes[j];
+        planes[j] = p ^ (inc | dec);
+        inc &= p;
+        dec &= (hdc_word_t)~p;
+    }
+}
+
+/**
+ * @brief   Majority bits of one word position
+ * @param   planes Counter plane words at this position
+ * @param   tiebreak Tie-break word (0 when none)
+ * @return  MSB plane, with tied dimensions taken from tiebreak
+ */
+static inline hdc_word_t counter_threshold_word(const hdc_word_t planes[HDC_COUNTER_PLANES],
+                                                hdc_word_t tiebreak)
+{
+    /* Tie value is 0111...: MSB clear, every lower plane set */
+    hdc_word_t tie = (hdc_word_t)~planes[HDC_COUNTER_PLANES - 1U];
+    for (uint8_t j = 0U; j < (HDC_COUNTER_PLANES - 1U); j++) {
+        tie &= planes[j];
+    }
+
+    return planes[HDC_COUNTER_PLANES - 1U] | (tie & tiebreak);
+}
+
+/**
+ * @brief   Add one pattern word to the counters at one word position
+ * @param   counter Counter bundle
+ * @param   i Byte offset of the word position
+ * @param   len HDC_WORD_BYTES, or HDC_HV_TAIL_BYTES for the tail word
+ * @param   pattern Pattern word (complemented to subtract)
+ * @return  Counter bits that changed in any plane (stored bytes only)
+ */
+static inline hdc_word_t counter_apply_word(hdc_counter_t* counter, hdc_index_t i,
+                                            uint8_t len, hdc_word_t pattern)
+{
+    hdc_word_t planes[HDC_COUNTER_PLANES];
+    hdc_word_t before[HDC_COUNTER_PLANES];
+    hdc_word_t diff = 0U;
+
+    for (uint8_t j = 0U; j < HDC_COUNTER_PLANES; j++) {
+        planes[j] = (len == HDC_WORD_BYTES) ? hdc_word_load(&counter->planes[j][i])
+                                            : hdc_word_load_partial(&counter->planes[j][i], len);
+        before[j] = planes[j];
+    }
+    counter_add_word(planes, pattern);
+    for (uint8_t j = 0U; j < HDC_COUNTER_PLANES; j++) {
+        diff |= planes[j] ^ before[j];
+        if (len == HDC_WORD_BYTES) {
+            hdc_word_store(&counter->planes[j][i], planes[j]);
+        } else {
+            hdc_word_store_partial(&counter->planes[j][i], planes[j], len);
+        }
+    }
+
+    /* A complemented pattern counts the zero padding up; it is never stored */
+    if (len != HDC_WORD_BYTES) {
+        diff &= (hdc_word_t)(((hdc_word_t)1U << (8U * len)) - 1U);
+    }
+    return diff;
+}
+
+/**
+ * @brief   Add or subtract a pattern at every word position
+ * @param   counter Counter bundle
+ * @param   pattern Pattern
+ * @param   invert 0 to add, all ones to subtract
+ * @param   changed Receives the word positions that changed, or NULL
+ * @return  Number of word positions that changed
+ */
+static inline hdc_index_t counter_apply(hdc_counter_t* counter, const hv_t pattern,
+                                        hdc_word_t invert, hdc_counter_mask_t changed)
+{
+    hdc_index_t num_changed = 0U;
+    hdc_index_t i = 0U;
+    hdc_index_t w = 0U;
+
+    for (; w != HDC_HV_WORDS; w++) {
+        hdc_word_t diff = counter_apply_word(counter, i, HDC_WORD_BYTES,
+                                             hdc_word_load(&pattern[i]) ^ invert);
+        if ((changed != NULL) && (diff != 0U)) {
+            changed[w / 8U] |= (uint8_t)(1U << (w % 8U));
+            num_changed++;
+        }
+        i = (hdc_index_t)(i + HDC_WORD_BYTES);
+    }
+
+    if (HDC_HV_TAIL_BYTES > 0U) {
+        hdc_word_t diff = counter_apply_word(counter, i, HDC_HV_TAIL_BYTES,
+                                             hdc_word_load_partial(&pattern[i], HDC_HV_TAIL_BYTES) ^ invert);
+        if ((changed != NULL) && (diff != 0U)) {
+            changed[w / 8U] |= (uint8_t)(1U << (w % 8U));
+            num_changed++;
+        }
+    }
+    return num_changed;
+}
+
+/* =============================================================================
+ * Counter Bundle
+ * ========================================================================== */
+
+/**
+ * @brief   Reset all counters to the tie value (empty bundle)
+ * @param   counter Counter bundle
+ */
+void hdc_counter_reset(hdc_counter_t* counter)
+{
+    for (uint8_t j = 0U; j < (HDC_COUNTER_PLANES - 1U); j++) {
+        hdc_fill(counter->planes[j], 0xFFU);
+    }
+    hdc_clear(counter->planes[HDC_COUNTER_PLANES - 1U]);
+}
+
+/**
+ * @brief   Add one pattern to the bundle
+ * @param   counter Counter bundle
+ * @param   pattern Pattern; 1 bits count up, 0 bits count down (saturating)
+ */
+void hdc_counter_add(hdc_counter_t* counter, const hv_t pattern)
+{
+    HDC_PROBE_BEGIN(HDC_PROBE_COUNTER_ADD);
+    (void)counter_apply(counter, pattern, 0U, NULL);
+    HDC_PROBE_END(HDC_PROBE_COUNTER_ADD);
+}
+
+/**
+ * @brief   Take one pattern out of the bundle
+ * @param   counter Counter bundle
+ * @param   pattern Pattern; 1 bits count down, 0 bits count up (saturating)
+ */
+void hdc_counter_sub(hdc_counter_t* counter, const hv_t pattern)
+{
+    (void)counter_apply(counter, pattern, (hdc_word_t)~(hdc_word_t)0U, NULL);
+}
+
+/**
+ * @brief   hdc_counter_add(), recording the word positions that changed
+ * @param   counter Counter bundle
+ * @param   pattern Pattern; 1 bits count up, 0 bits count down (saturating)
+ * @param   changed Word positions where any counter changed are set
+ * @return  Number of word positions that changed
+ */
+hdc_index_t hdc_counter_add_tracked(hdc_counter_t* counter, const hv_t pattern,
+                                    hdc_counter_mask_t changed)
+{
+    return counter_apply(counter, pattern, 0U, changed);
+}
+
+/**
+ * @brief   hdc_counter_sub(), recording the word positions that changed
+ * @param   counter Counter bundle
+ * @param   pattern Pattern; 1 bits count down, 0 bits count up (saturating)
+ * @param   changed Word positions where any counter changed are set
+ * @return  Number of word positions that changed
+ */
+hdc_index_t hdc_counter_sub_tracked(hdc_counter_t* counter, const hv_t pattern,
+                                    hdc_counter_mask_t changed)
+{
+    return counter_apply(counter, pattern, (hdc_word_t)~(hdc_word_t)0U, changed);
+}
+
+/**
+ * @brief   Produce the majority hypervector
+ * @param   result Output hypervector
+ * @param   counter Counter bundle
+ * @param   tiebreak Bits used where a counter is exactly tied, or NULL for 0
+ *
+ * @details A dimension is 1 when it has seen more ones than zeros. Passing
+ *          a random tiebreak vector avoids biasing even-sized bundles
+ *          towards 0.
+ */
+void hdc_counter_threshold(hv_t result, const hdc_counter_t* counter, const hv_t tiebreak)
+{
+    hdc_word_t planes[HDC_COUNTER_PLANES];
+    hdc_word_t tb = 0U;
+    hdc_index_t i = 0U;
+
+    for (hdc_index_t w = 0U; w != HDC_HV_WORDS; w++) {
+        for (uint8_t j = 0U; j < HDC_COUNTER_PLANES; j++) {
+            planes[j] = hdc_word_load(&counter->planes[j][i]);
+        }
+        if (tiebreak != NULL) {
+            tb = hdc_word_load(&tiebreak[i]);
+        }
+        hdc_word_store(&result[i], counter_threshold_word(planes, tb));
+        i = (hdc_index_t)(i + HDC_WORD_BYTES);
+    }
+
+    if (HDC_HV_TAIL_BYTES > 0U) {
+        for (uint8_t j = 0U; j < HDC_COUNTER_PLANES; j++) {
+            planes[j] = hdc_word_load_partial(&counter->planes[j][i], HDC_HV_TAIL_BYTES);
+        }
+        if (tiebreak != NULL) {
+            tb = hdc_word_load_partial(&tiebreak[i], HDC_HV_TAIL_BYTES);
+        }
+        hdc_word_store_partial(&result[i], counter_threshold_word(planes, tb), HDC_HV_TAIL_BYTES);
+    }
+}
+
+/**
+ * @brief   Re-threshold selected word positions of a majority hypervector
+ * @param   result Hypervector to patch; words not in mask are left alone
+ * @param   counter Counter bundle
+ * @param   tiebreak Bits used where a counter is exactly tied, or NULL for 0
+ * @param   mask Word positions to recompute
+ *
+ * @details Mask bytes that are zero skip eight word positions at once, so
+ *          a sparse update costs little more than the words it touched.
+ */
+void hdc_counter_threshold_masked(hv_t result, const hdc_counter_t* counter,
+                                  const hv_t tiebreak, const hdc_counter_mask_t mask)
+{
+    hdc_word_t planes[HDC_COUNTER_PLANES];
+    hdc_word_t tb = 0U;
+
+    /* 16-bit index: skipping to the end of the last mask byte may pass 255 */
+    for (uint16_t w = 0U; w < HDC_COUNTER_WORDS; w++) {
+        if (mask[w / 8U] == 0U) {
+            w = (uint16_t)(w | 7U);
+            continue;
+        }
+        if ((mask[w / 8U] & (uint8_t)(1U << (w % 8U))) == 0U) {
+            continue;
+        }
+
+        hdc_index_t i = (hdc_index_t)(w * HDC_WORD_BYTES);
+        if ((w + 1U) <= HDC_HV_WORDS) {
+            for (uint8_t j = 0U; j < HDC_COUNTER_PLANES; j++) {
+                planes[j] = hdc_word_load(&counter->planes[j][i]);
+            }
+            if (tiebreak != NULL) {
+                tb = hdc_word_load(&tiebreak[i]);
+            }
+            hdc_word_store(&result[i], counter_threshold_word(planes, tb));
+        } else {
+            for (uint8_t j = 0U; j < HDC_COUNTER_PLANES; j++) {
+                planes[j] = hdc_word_load_partial(&counter->planes[j][i], HDC_HV_TAIL_BYTES);
+            }
+            if (tiebreak != NULL) {
+                tb = hdc_word_load_partial(&tiebreak[i], HDC_HV_TAIL_BYTES);
+            }
+            hdc_word_store_partial(&result[i], counter_threshold_word(planes, tb),
+                                   HDC_HV_TAIL_BYTES);
+        }
+    }
+}
+
+/**
+ * @brief   Read one dimension's counter (diagnostics and tests)
+ * @param   counter Counter bundle
+ * @param   dim Dimension index (0 to HV_DIMENSIONS-1)
+ * @return  Counter value, 0 to HDC_COUNTER_MAX
+ */
+uint8_t hdc_counter_get(const hdc_counter_t* counter, hdc_dist_t dim)
+{
+    hdc_index_t byte_idx = (hdc_index_t)(dim / 8U);
+    uint8_t mask = (uint8_t)(1U << (dim % 8U));
+    uint8_t value = 0U;
+
+    for (uint8_t j = 0U; j < HDC_COUNTER_PLANES; j++) {
+        if ((counter->planes[j][byte_idx] & mask) != 0U) {
+            value |= (uint8_t)(1U << j);
+        }
+    }
+    return value;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file    hdc_counter.h
+ * @brief   HDC Majority Bundling - Bit-Sliced Saturating Counters
+ * @version 1.1.0
+ * @note    One small saturating counter per dimension, stored as bit planes
+ *
+ * @details hdc_bundle() accumulates with OR and saturates to all ones after a
+ *          few dozen patterns. A counter bundle instead keeps one up/down
+ *          counter per dimension: a 1 bit in the added pattern counts up, a
+ *          0 bit counts down. Counter bit j of every dimension is stored in
+ *          plane j, so adding a pattern is a word-wide ripple-carry over
+ *          HDC_COUNTER_PLANES planes rather than a per-bit loop.
+ *
+ *          Counters start one below the midpoint, so the majority vector is
+ *          simply the most significant plane: a dimension is 1 when it has
+ *          seen strictly more ones than zeros. Counters saturate at both ends
+ *          instead of wrapping.
+ *
+ *          hdc_counter_sub() counts the other way (1 bits down, 0 bits up),
+ *          which takes a pattern back out of the bundle. The _tracked
+ *          variants also record which word positions (hdc_word_t, see
+ *          hdc_kernel.h) had any counter change, and
+ *          hdc_counter_threshold_masked() re-thresholds only those words,
+ *          so a retrained prototype is patched rather than rebuilt
+ *          (hdc_learn.h).
+ *
+ *          Memory: HDC_COUNTER_PLANES * HV_BYTES (4 planes = 64 bytes/class
+ *          at the default 128-bit width).
+ */
+
+#ifndef HDC_COUNTER_H
+#define HDC_COUNTER_H
+
+#include <stdint.h>
+#include "hdc_core.h"
+#include "hdc_kernel.h"
+
+/* =============================================================================
+ * Configuration
+ * ========================================================================== */
+
+/** @brief Bits per dimension counter (override with -DHDC_COUNTER_PLANES=n) */
+#ifndef HDC_COUNTER_PLANES
+#define HDC_COUNTER_PLANES  4U
+#endif
+
+#if (HDC_COUNTER_PLANES < 2U) || (HDC_COUNTER_PLANES > 8U)
+#error "HDC_COUNTER_PLANES must be between 2 and 8"
+#endif
+
+/** @brief Largest counter value */
+#define HDC_COUNTER_MAX     ((uint8_t)((1U << HDC_COUNTER_PLANES) - 1U))
+
+/** @brief Initial (tie) counter value; the MSB plane is set above it */
+#define HDC_COUNTER_INIT    ((uint8_t)((1U << (HDC_COUNTER_PLANES - 1U)) - 1U))
+
+/** @brief Word positions in one hypervector (whole words, plus the tail) */
+#define HDC_COUNTER_WORDS   ((hdc_index_t)(HDC_HV_WORDS + ((HDC_HV_TAIL_BYTES > 0U) ? 1U : 0U)))
+
+/** @brief Bytes of a word mask (bit w % 8 of byte w / 8 = word position w) */
+#define HDC_COUNTER_MASK_BYTES  ((hdc_index_t)((HDC_COUNTER_WORDS + 7U) / 8U))
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Per-dimension counters, planes[0] = LSB ... planes[PLANES-1] = MSB */
+typedef struct {
+    hv_t planes[HDC_COUNTER_PLANES];
+} hdc_counter_t;
+
+/** @brief One bit per word position of a hypervector */
+typedef uint8_t hdc_counter_mask_t[HDC_COUNTER_MASK_BYTES];
+
+/* =============================================================================
+ * Function Declarations
+ * ========================================================================== */
+
+/**
+ * @brief   Reset all counters to the tie value (empty bundle)
+ * @param   counter Counter bundle
+ */
+void hdc_counter_reset(hdc_counter_t* counter);
+
+/**
+ * @brief   Add one pattern to the bundle
+ * @param   counter Counter bundle
+ * @param   pattern Pattern; 1 bits count up, 0 bits count down (saturating)
+ */
+void hdc_counter_add(hdc_counter_t* counter, const hv_t pattern);
+
+/**
+ * @brief   Take one pattern out of the bundle
+ * @param   counter Counter bundle
+ * @param   pattern Pattern; 1 bits count down, 0 bits count up (saturating)
+ */
+void hdc_counter_sub(hdc_counter_t* counter, const hv_t pattern);
+
+/**
+ * @brief   hdc_counter_add(), recording the word positions that changed
+ * @param   counter Counter bundle
+ * @param   pattern Pattern; 1 bits count up, 0 bits count down (saturating)
+ * @param   changed Word positions where any counter changed are set (others
+ *          are left as they are)
+ * @return  Number of word positions that changed
+ */
+hdc_index_t hdc_counter_add_tracked(hdc_counter_t* counter, const hv_t pattern,
+                                    hdc_counter_mask_t changed);
+
+/**
+ * @brief   hdc_counter_sub(), recording the word positions that changed
+ * @param   counter Counter bundle
+ * @param   pattern Pattern; 1 bits count down, 0 bits count up (saturating)
+ * @param   changed Word positions where any counter changed are set (others
+ *          are left as they are)
+ * @return  Number of word positions that changed
+ */
+hdc_index_t hdc_counter_sub_tracked(hdc_counter_t* counter, const hv_t pattern,
+                                    hdc_counter_mask_t changed);
+
+/**
+ * @brief   Produce the majority hypervector
+ * @param   result Output hypervector
+ * @param   counter Counter bundle
+ * @param   tiebreak Bits used where a counter is exactly tied, or NULL for 0
+ */
+void hdc_counter_threshold(hv_t result, const hdc_counter_t* counter, const hv_t tiebreak);
+
+/**
+ * @brief   Re-threshold selected word positions of a majority hypervector
+ * @param   result Hypervector to patch; words not in mask are left alone
+ * @param   counter Counter bundle
+ * @param   tiebreak Bits used where a counter is exactly tied, or NULL for 0
+ * @param   mask Word positions to recompute
+ * @note    Produces hdc_counter_threshold()'s words for the positions in mask
+ */
+void hdc_counter_threshold_masked(hv_t result, const hdc_counter_t* counter,
+                                  const hv_t tiebreak, const hdc_counter_mask_t mask);
+
+/**
+ * @brief   Read one dimension's counter (diagnostics and tests)
+ * @param   counter Counter bundle
+ * @param   dim Dimension index (0 to HV_DIMENSIONS-1)
+ * @return  Counter value, 0 to HDC_COUNTER_MAX
+ */
+uint8_t hdc_counter_get(const hdc_counter_t* counter, hdc_dist_t dim);
+
+#endif /* HDC_COUNTER_H */
@@ -10,6 +10,133 @@
  */
 
 #include "hdc_encode.h"
+#include "hdc_pgm.h"
+#include "hdc_kernel.h"
+#include "hdc_probe.h"
+
+/* =============================================================================
+ * Level Representation
+ * ========================================================================== */
+
+/**
+ * @brief   Thermometer level of a value
+ * @param   value Input value to encode
+ * @param   max_value Maximum possible input value
+ * @return  Level (THERMO_LEVELS when value >= max_value)
+ */
+hdc_level_t hdc_level_from_value(uint16_t value, uint16_t max_value)
+{
+    if (value >= max_value) {
+        return (hdc_level_t)THERMO_LEVELS;
+    }
+    return (hdc_level_t)(((uint32_t)value * THERMO_LEVELS) / max_value);
+}
+
+/**
+ * @brief   Thermometer level of an ADC value (0-1023)
+ * @param   adc_value 10-bit ADC reading
+ * @return  Level
+ */
+hdc_level_t hdc_level_from_adc(uint16_t adc_value)
+{
+    return hdc_level_from_value(adc_value, ADC_MAX);
+}
+
+/**
+ * @brief   Hamming distance between two thermometer hypervectors
+ * @param   a First level
+ * @param   b Second level
+ * @return  |a - b|
+ */
+hdc_dist_t hdc_level_distance(hdc_level_t a, hdc_level_t b)
+{
+    return (a > b) ? (hdc_dist_t)(a - b) : (hdc_dist_t)(b - a);
+}
+
+/**
+ * @brief   Bundle (OR) two thermometer hypervectors
+ * @param   a First level
+ * @param   b Second level
+ * @return  max(a, b), the level of the OR of both thermometers
+ */
+hdc_level_t hdc_level_bundle(hdc_level_t a, hdc_level_t b)
+{
+    return (a > b) ? a : b;
+}
+
+/**
+ * @brief   Materialize a thermometer hypervector
+ * @param   hv Output hypervector
+ * @param   level Number of low-order bits to set
+ */
+void hdc_level_to_hv(hv_t hv, hdc_level_t level)
+{
+    hdc_index_t full_bytes = (hdc_index_t)(level / 8U);
+    uint8_t remaining_bits = (uint8_t)(level % 8U);
+    hdc_index_t i = 0U;
+
+    for (; i < full_bytes; i++) {
+        hv[i] = 0xFFU;
+    }
+    if (remaining_bits > 0U) {
+        hv[i] = (uint8_t)((1U << remaining_bits) - 1U);
+        i++;
+    }
+    for (; i < HV_BYTES; i++) {
+        hv[i] = 0x00U;
+    }
+}
+
+/**
+ * @brief   Bind (XOR) a thermometer hypervector with an arbitrary one
+ * @param   result Output hypervector (may alias hv)
+ * @param   level Thermometer level
+ * @param   hv Hypervector to bind with (e.g. a channel basis vector)
+ */
+void hdc_level_bind(hv_t result, hdc_level_t level, const hv_t hv)
+{
+    hdc_index_t full_bytes = (hdc_index_t)(level / 8U);
+    uint8_t remaining_bits = (uint8_t)(level % 8U);
+    hdc_index_t i = 0U;
+
+    for (; i < full_bytes; i++) {
+        result[i] = (uint8_t)~hv[i];
+    }
+    if (remaining_bits > 0U) {
+        result[i] = (uint8_t)(hv[i] ^ ((1U << remaining_bits) - 1U));
+        i++;
+    }
+    for (; i < HV_BYTES; i++) {
+        result[i] = hv[i];
+    }
+}
+
+/**
+ * @brief   Hamming distance between a thermometer and an arbitrary hypervector
+ * @param   level Thermometer level
+ * @param   hv Other hypervector
+ * @return  Hamming distance (0-HV_DIMENSIONS)
+ *
+ * @details Below the level every 0 bit of hv differs, above it every 1 bit:
+ *          distance = (level - ones_below) + (total_ones - ones_below).
+ */
+hdc_dist_t hdc_level_hamming(hdc_level_t level, const hv_t hv)
+{
+    hdc_index_t full_bytes = (hdc_index_t)(level / 8U);
+    uint8_t remaining_bits = (uint8_t)(level % 8U);
+    hdc_dist_t ones_below = hdc_kernel_popcount(hv, full_bytes);
+
+    if (remaining_bits > 0U) {
+        ones_below += hdc_kernel_popcount8((uint8_t)(hv[full_bytes] & ((1U << remaining_bits) - 1U)));
+    }
+
+    hdc_dist_t total_ones = hdc_kernel_popcount(hv, HV_BYTES);
+    return (hdc_dist_t)((level - ones_below) + (total_ones - ones_below));
+}
+
+/* =============================================================================
+ * Basic Encoding
+ * ========================================================================== */
 
 /**
  * @brief   Encode a value using thermometer encoding
@@ -30,25 +157,7 @@
  */
 void hdc_encode_thermometer(hv_t hv, uint16_t value, uint16_t max_value)
 {
-    hdc_clear(hv);
-
-    if (value >= max_value) {
-        hdc_fill(hv, 0xFFU);
-        return;
-    }
-
-    uint8_t level = (uint8_t)(((uint32_t)value * THERMO_LEVELS) / max_value);
-
-    uint8_t full_bytes = level / 8U;
-    uint8_t remaining_bits = level % 8U;
-
-    for (uint8_t i = 0U; i < full_bytes; i++) {
-        hv[i] = 0xFFU;
-    }
-
-    if ((full_bytes < HV_BYTES) && (remaining_bits > 0U)) {
-        hv[full_bytes] = (1U << remaining_bits) - 1U;
-    }
+    hdc_level_to_hv(hv, hdc_level_from_value(value, max_value));
 }
 
 /**
@@ -77,6 +186,90 @@ void hdc_encode_bipolar(hv_t hv, int16_t value, int16_t min_val, int16_t max_val
     hdc_encode_thermometer(hv, shifted, range);
 }
 
+/* =============================================================================
+ * Multi-Channel Encoding
+ * ========================================================================== */
+
+/*
+ * The block loop is generated once per basis address space so the load in
+ * hdc_kernel_encode_word{,_P}() stays inlined; hdc_pgm.h declares the _P
+ * entry points.
+ */
+#define HDC_ENCODE_DEFINE_BLOCK(name, ENCODE_WORD)                                  \
+    static void name(hv_t result, const hdc_level_t* levels, uint8_t num_channels,  \
+                     const hv_t* basis_vectors, uint8_t accumulate)                 \
+    {                                                                               \
+        hdc_index_t i = 0U;                                                         \
+                                                                                    \
+        for (hdc_index_t w = 0U; w != HDC_HV_WORDS; w++) {                          \
+            hdc_word_t word = ENCODE_WORD(levels, num_channels, basis_vectors,      \
+                                          i, HDC_WORD_BYTES);                       \
+            if (accumulate != 0U) {                                                 \
+                word |= hdc_word_load(&result[i]);                                  \
+            }                                                                       \
+            hdc_word_store(&result[i], word);                                       \
+            i = (hdc_index_t)(i + HDC_WORD_BYTES);                                  \
+        }                                                                           \
+                                                                                    \
+        if (HDC_HV_TAIL_BYTES > 0U) {                                               \
+            hdc_word_t word = ENCODE_WORD(levels, num_channels, basis_vectors,      \
+                                          i, HDC_HV_TAIL_BYTES);                    \
+            if (accumulate != 0U) {                                                 \
+                word |= hdc_word_load_partial(&result[i], HDC_HV_TAIL_BYTES);       \
+            }                                                                       \
+            hdc_word_store_partial(&result[i], word, HDC_HV_TAIL_BYTES);            \
+        }                                                                           \
+    }
+
+/**
+ * @brief   OR a block of bound channels into result, one word at a time
+ * @param   result Output hypervector
+ * @param   levels Thermometer level per channel
+ * @param   num_channels Number of channels in this block
+ * @param   basis_vectors Basis vector per channel
+ * @param   accumulate 0 to overwrite result, 1 to OR into it
+ */
+HDC_ENCODE_DEFINE_BLOCK(encode_levels_block, hdc_kernel_encode_word)
+
+/**
+ * @brief   encode_levels_block() with the basis vectors in flash
+ */
+HDC_ENCODE_DEFINE_BLOCK(encode_levels_block_P, hdc_kernel_encode_word_P)
+
+/**
+ * @brief   Encode ADC values HDC_ENCODE_CHANNEL_BLOCK channels at a time
+ * @param   result Output combined hypervector
+ * @param   values Array of sensor values
+ * @param   num_channels Number of channels to encode (> 0)
+ * @param   basis_vectors Array of basis vectors for each channel
+ * @param   in_flash 1 when basis_vectors is a flash address
+ */
+static void encode_multi_channel(hv_t result, const uint16_t* values, uint8_t num_channels,
+                                 const hv_t* basis_vectors, uint8_t in_flash)
+{
+    hdc_level_t levels[HDC_ENCODE_CHANNEL_BLOCK];
+    uint8_t accumulate = 0U;
+
+    for (uint8_t base = 0U; base < num_channels; base = (uint8_t)(base + HDC_ENCODE_CHANNEL_BLOCK)) {
+        uint8_t remaining = (uint8_t)(num_channels - base);
+        uint8_t block = (remaining < HDC_ENCODE_CHANNEL_BLOCK) ? remaining : (uint8_t)HDC_ENCODE_CHANNEL_BLOCK;
+
+        for (uint8_t ch = 0U; ch < block; ch++) {
+            levels[ch] = hdc_level_from_adc(values[base + ch]);
+        }
+        if (in_flash != 0U) {
+            encode_levels_block_P(result, levels, block, &basis_vectors[base], accumulate);
+        } else {
+            encode_levels_block(result, levels, block, &basis_vectors[base], accumulate);
+        }
+        accumulate = 1U;
+
+        if (remaining <= HDC_ENCODE_CHANNEL_BLOCK) {
+            break;
+        }
+    }
+}
+
 /**
  * @brief   Encode multiple sensor channels into a single hypervector
  * @param   result Output combined hypervector
@@ -94,12 +287,71 @@ void hdc_encode_multi_channel(
     uint8_t num_channels,
     const hv_t* basis_vectors)
 {
-    hdc_clear(result);
-    hv_t temp;
+    if (num_channels == 0U) {
+        hdc_clear(result);
+        return;
+    }
+
+    HDC_PROBE_BEGIN(HDC_PROBE_ENCODE_MULTI);
+    encode_multi_channel(result, values, num_channels, basis_vectors, 0U);
+    HDC_PROBE_END(HDC_PROBE_ENCODE_MULTI);
+}
 
-    for (uint8_t ch = 0U; ch < num_channels; ch++) {
-        hdc_encode_adc(temp, values[ch]);
-        hdc_xor(temp, temp, basis_vectors[ch]);
-        hdc_bundle(result, temp);
+/**
+ * @brief   hdc_encode_multi_channel() with the basis vectors in flash
+ * @param   result Output combined hypervector
+ * @param   values Array of sensor values
+ * @param   num_channels Number of channels to encode
+ * @param   basis_vectors_P Array of basis vectors for each channel (flash)
+ */
+void hdc_encode_multi_channel_P(
+    hv_t result,
+    const uint16_t* values,
+    uint8_t num_channels,
+    const hv_t* basis_vectors_P)
+{
+    if (num_channels == 0U) {
+        hdc_clear(result);
+        return;
     }
+
+    HDC_PROBE_BEGIN(HDC_PROBE_ENCODE_MULTI);
+    encode_multi_channel(result, values, num_channels, basis_vectors_P, 1U);
+    HDC_PROBE_END(HDC_PROBE_ENCODE_MULTI);
+}
+
+/**
+ * @brief   Fused multi-channel encoding from precomputed levels
+ * @param   result Output combined hypervector
+ * @param   levels Thermometer level per channel
+ * @param   num_channels Number of channels to encode
+ * @param   basis_vectors Array of basis vectors for each channel
+ */
+void hdc_encode_levels(
+    hv_t result,
+    const hdc_level_t* levels,
+    uint8_t num_channels,
+    const hv_t* basis_vectors)
+{
+    HDC_PROBE_BEGIN(HDC_PROBE_ENCODE_LEVELS);
+    encode_levels_block(result, levels, num_channels, basis_vectors, 0U);
+    HDC_PROBE_END(HDC_PROBE_ENCODE_LEVELS);
+}
+
+/**
+ * @brief   hdc_encode_levels() with the basis vectors in flash
+ * @param   result Output combined hypervector
+ * @param   levels Thermometer level per channel
+ * @param   num_channels Number of channels to encode
+ * @param   basis_vectors_P Array of basis vectors for each channel (flash)
+ */
+void hdc_encode_levels_P(
+    hv_t result,
+    const hdc_level_t* levels,
+    uint8_t num_channels,
+    const hv_t* basis_vectors_P)
+{
+    HDC_PROBE_BEGIN(HDC_PROBE_ENCODE_LEVELS);
+    encode_levels_block_P(result, levels, num_channels, basis_vectors_P, 0U);
+    HDC_PROBE_END(HDC_PROBE_ENCODE_LEVELS);
 }
@@ -20,12 +20,30 @@
  * Constants
  * ========================================================================== */
 
-/** @brief Number of thermometer encoding levels (matches HV_DIMENSIONS) */
-#define THERMO_LEVELS       128U
+/** @brief Number of thermometer encoding levels (scales with HV_DIMENSIONS) */
+#define THERMO_LEVELS       HV_DIMENSIONS
 
 /** @brief Maximum ADC value (10-bit ADC) */
 #define ADC_MAX             1023U
 
+/** @brief Channel levels computed per pass in hdc_encode_multi_channel() */
+#ifndef HDC_ENCODE_CHANNEL_BLOCK
+#define HDC_ENCODE_CHANNEL_BLOCK    8U
+#endif
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/**
+ * @brief Thermometer level: number of set low-order bits (0 to THERMO_LEVELS)
+ *
+ * @details A thermometer hypervector is fully described by its level, so
+ *          it can be carried as one small integer and only materialized
+ *          when it meets a non-thermometer vector.
+ */
+typedef hdc_dist_t hdc_level_t;
+
 /* =============================================================================
  * Function Declarations - Basic Encoding
  * ========================================================================== */
@@ -67,6 +85,68 @@ void hdc_encode_adc(hv_t hv, uint16_t adc_value);
  */
 void hdc_encode_bipolar(hv_t hv, int16_t value, int16_t min_val, int16_t max_val);
 
+/* =============================================================================
+ * Function Declarations - Level Representation
+ * ========================================================================== */
+
+/**
+ * @brief   Thermometer level of a value
+ * @param   value Input value to encode
+ * @param   max_value Maximum possible input value
+ * @return  Level (THERMO_LEVELS when value >= max_value)
+ * @note    hdc_encode_thermometer(hv, v, m) == hdc_level_to_hv(hv, level(v, m))
+ */
+hdc_level_t hdc_level_from_value(uint16_t value, uint16_t max_value);
+
+/**
+ * @brief   Thermometer level of an ADC value (0-1023)
+ * @param   adc_value 10-bit ADC reading
+ * @return  Level
+ */
+hdc_level_t hdc_level_from_adc(uint16_t adc_value);
+
+/**
+ * @brief   Hamming distance between two thermometer hypervectors
+ * @param   a First level
+ * @param   b Second level
+ * @return  |a - b|
+ */
+hdc_dist_t hdc_level_distance(hdc_level_t a, hdc_level_t b);
+
+/**
+ * @brief   Bundle (OR) two thermometer hypervectors
+ * @param   a First level
+ * @param   b Second level
+ * @return  max(a, b), the level of the OR of both thermometers
+ */
+hdc_level_t hdc_level_bundle(hdc_level_t a, hdc_level_t b);
+
+/**
+ * @brief   Materialize a thermometer hypervector
+ * @param   hv Output hypervector
+ * @param   level Number of low-order bits to set
+ */
+void hdc_level_to_hv(hv_t hv, hdc_level_t level);
+
+/**
+ * @brief   Bind (XOR) a thermometer hypervector with an arbitrary one
+ * @param   result Output hypervector (may alias hv)
+ * @param   level Thermometer level
+ * @param   hv Hypervector to bind with (e.g. a channel basis vector)
+ *
+ * @details Single pass: bytes below the level are ~hv, bytes above are hv.
+ */
+void hdc_level_bind(hv_t result, hdc_level_t level, const hv_t hv);
+
+/**
+ * @brief   Hamming distance between a thermometer and an arbitrary hypervector
+ * @param   level Thermometer level
+ * @param   hv Other hypervector
+ * @return  Hamming distance (0-HV_DIMENSIONS)
+ * @note    No thermometer vector is materialized
+ */
+hdc_dist_t hdc_level_hamming(hdc_level_t level, const hv_t hv);
+
 /* =============================================================================
  * Function Declarations - Multi-Channel Encoding
  * ========================================================================== */
@@ -81,6 +161,10 @@ void hdc_encode_bipolar(hv_t hv, int16_t value, int16_t min_val, int16_t max_val
  * @details Each channel is encoded with thermometer encoding, then
  *          XORed with its unique basis vector (binding), then all
  *          channels are bundled together using OR.
+ *
+ *          Fused: channel levels are computed HDC_ENCODE_CHANNEL_BLOCK at a
+ *          time and each output word is written once per block, with no
+ *          per-channel temporary vector.
  */
 void hdc_encode_multi_channel(
     hv_t result,
@@ -88,4 +172,19 @@ void hdc_encode_multi_channel(
     uint8_t num_channels,
     const hv_t* basis_vectors);
 
+/**
+ * @brief   Fused multi-channel encoding from precomputed levels
+ * @param   result Output combined hypervector
+ * @param   levels Thermometer level per channel
+ * @param   num_channels Number of channels to encode
+ * @param   basis_vectors Array of basis vectors for each channel
+ * @note    Same output as hdc_encode_multi_channel() for the same levels;
+ *          hdc_am_query_levels() scores it without materializing it
+ */
+void hdc_encode_levels(
+    hv_t result,
+    const hdc_level_t* levels,
+    uint8_t num_channels,
+    const hv_t* basis_vectors);
+
 #endif /* HDC_ENCODE_H */
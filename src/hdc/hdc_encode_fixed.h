@@ -0,0 +1,160 @@
+/**
+ * @file    hdc_encode_fixed.h
+ * @brief   HDC Encoding - Compile-Time Specialized Encoders
+ * @version 1.0.0
+ * @note    Header only: each deployment generates its own encoder
+ *
+ * @details hdc_level_from_value() divides by a run-time max_value, and
+ *          hdc_encode_multi_channel() loops over a run-time channel count.
+ *          On the AVR the 32-bit divide alone is several hundred cycles
+ *          per channel. The macros below generate the same functions for
+ *          a channel count and max_value fixed at build time:
+ *
+ *            - the divide becomes a multiply by a reciprocal constant and
+ *              a shift by HDC_FIXED_SHIFT (on the AVR: take the top byte)
+ *            - every channel loop has a constant trip count, so the word
+ *              kernel is inlined with the count known and the compiler
+ *              unrolls it; there is no run-time num_channels
+ *
+ *          The reciprocal is floor(THERMO_LEVELS * 2^24 / max_value) + 1.
+ *          Its error is below 1 / 2^24 per unit of value, and the fraction
+ *          of value * THERMO_LEVELS / max_value is at most
+ *          (max_value - 1) / max_value. So for max_value * (max_value - 1)
+ *          < 2^24, i.e. up to HDC_FIXED_MAX_VALUE, every level is exactly
+ *          hdc_level_from_value()'s, and the generated encoders produce the
+ *          same outputs as the generic ones.
+ *
+ *          Usage (file scope, once per configuration):
+ *
+ *            HDC_ENCODE_DEFINE_LEVEL(app_level, ADC_MAX)
+ *            HDC_ENCODE_DEFINE_FIXED(app_encode, 2U, ADC_MAX)
+ *            HDC_ENCODE_DEFINE_FIXED_P(app_encode_P, 2U, ADC_MAX)
+ *
+ *            hdc_level_t level = app_level(adc_value);
+ *            app_encode(query, values, basis_vectors);
+ */
+
+#ifndef HDC_ENCODE_FIXED_H
+#define HDC_ENCODE_FIXED_H
+
+#include <stdint.h>
+#include "hdc_core.h"
+#include "hdc_encode.h"
+#include "hdc_kernel.h"
+
+/* =============================================================================
+ * Constants
+ * ========================================================================== */
+
+/** @brief Reciprocal scaling: level = (value * HDC_FIXED_MULT(max)) >> 24 */
+#define HDC_FIXED_SHIFT         24U
+
+/** @brief Largest max_value with exact levels (4096 * 4095 < 2^24) */
+#define HDC_FIXED_MAX_VALUE     4096U
+
+/** @brief Reciprocal of max_value scaled by THERMO_LEVELS << HDC_FIXED_SHIFT */
+#define HDC_FIXED_MULT(max_value) \
+    ((hdc_fixed_acc_t)((((uint64_t)THERMO_LEVELS << HDC_FIXED_SHIFT) / (max_value)) + 1U))
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/**
+ * @brief Product type of the reciprocal multiply
+ * @note  value * HDC_FIXED_MULT stays below THERMO_LEVELS * 2^24 + max_value,
+ *        which fits 32 bits up to 255 levels (every AVR width)
+ */
+#if THERMO_LEVELS <= 255U
+typedef uint32_t hdc_fixed_acc_t;
+#else
+typedef uint64_t hdc_fixed_acc_t;
+#endif
+
+/* =============================================================================
+ * Generators
+ * ========================================================================== */
+
+/**
+ * @brief Generate a level function for a fixed max_value
+ *
+ * Defines  static inline hdc_level_t name(uint16_t value)
+ * with the result of hdc_level_from_value(value, MAX_VALUE). MAX_VALUE must
+ * be a constant from 1 to HDC_FIXED_MAX_VALUE; a different value fails to
+ * compile (negative array size in name##_check_t). The only comparison left
+ * is the saturation at MAX_VALUE.
+ */
+#define HDC_ENCODE_DEFINE_LEVEL(name, MAX_VALUE)                                     \
+    typedef char name##_check_t[(((MAX_VALUE) >= 1U) &&                             \
+                                 ((MAX_VALUE) <= HDC_FIXED_MAX_VALUE)) ? 1 : -1];   \
+                                                                                     \
+    static inline hdc_level_t name(uint16_t value)                                  \
+    {                                                                                \
+        uint16_t clamped = (value < (uint16_t)(MAX_VALUE)) ? value                   \
+                                                           : (uint16_t)(MAX_VALUE);  \
+        return (hdc_level_t)(((hdc_fixed_acc_t)clamped * HDC_FIXED_MULT(MAX_VALUE))  \
+                             >> HDC_FIXED_SHIFT);                                    \
+    }
+
+/*
+ * Shared body of the fixed encoders. ENCODE_WORD is hdc_kernel_encode_word
+ * or hdc_kernel_encode_word_P; both are inline, so CHANNELS reaches the
+ * channel loop as a constant.
+ */
+#define HDC_ENCODE_DEFINE_FIXED_WITH(name, CHANNELS, MAX_VALUE, ENCODE_WORD)          \
+    HDC_ENCODE_DEFINE_LEVEL(name##_level, MAX_VALUE)                                 \
+    typedef char name##_channels_t[(((CHANNELS) >= 1U) && ((CHANNELS) <= 255U)) ? 1 : -1]; \
+                                                                                     \
+    static inline void name##_levels(hv_t result, const hdc_level_t* levels,        \
+                                     const hv_t* basis_vectors)                     \
+    {                                                                                \
+        hdc_index_t i = 0U;                                                          \
+                                                                                     \
+        for (hdc_index_t w = 0U; w != HDC_HV_WORDS; w++) {                           \
+            hdc_word_store(&result[i], ENCODE_WORD(levels, (uint8_t)(CHANNELS),      \
+                                                   basis_vectors, i, HDC_WORD_BYTES)); \
+            i = (hdc_index_t)(i + HDC_WORD_BYTES);                                   \
+        }                                                                            \
+        if (HDC_HV_TAIL_BYTES > 0U) {                                                \
+            hdc_word_store_partial(&result[i],                                       \
+                                   ENCODE_WORD(levels, (uint8_t)(CHANNELS),          \
+                                               basis_vectors, i, HDC_HV_TAIL_BYTES), \
+                                   HDC_HV_TAIL_BYTES);                               \
+        }                                                                            \
+    }                                                                                \
+                                                                                     \
+    static inline void name(hv_t result, const uint16_t* values,                    \
+                            const hv_t* basis_vectors)                              \
+    {                                                                                \
+        hdc_level_t levels[CHANNELS];                                                \
+                                                                                     \
+        for (uint8_t ch = 0U; ch < (uint8_t)(CHANNELS); ch++) {                      \
+            levels[ch] = name##_level(values[ch]);                                   \
+        }                                                                            \
+        name##_levels(result, levels, basis_vectors);                                \
+    }
+
+/**
+ * @brief Generate a fixed multi-channel encoder (basis vectors in SRAM)
+ *
+ * Defines, all static inline:
+ *   - hdc_level_t name_level(uint16_t value)            (HDC_ENCODE_DEFINE_LEVEL)
+ *   - void name_levels(hv_t result, const hdc_level_t* levels, const hv_t* basis)
+ *       same output as hdc_encode_levels(result, levels, CHANNELS, basis)
+ *   - void name(hv_t result, const uint16_t* values, const hv_t* basis)
+ *       same output as hdc_encode_multi_channel() with max_value MAX_VALUE
+ *       (ADC_MAX reproduces it exactly)
+ *
+ * CHANNELS must be a constant from 1 to 255.
+ */
+#define HDC_ENCODE_DEFINE_FIXED(name, CHANNELS, MAX_VALUE) \
+    HDC_ENCODE_DEFINE_FIXED_WITH(name, CHANNELS, MAX_VALUE, hdc_kernel_encode_word)
+
+/**
+ * @brief HDC_ENCODE_DEFINE_FIXED() with the basis vectors in flash
+ * @note  Same outputs as hdc_encode_multi_channel_P() / hdc_encode_levels_P()
+ */
+#define HDC_ENCODE_DEFINE_FIXED_P(name, CHANNELS, MAX_VALUE) \
+    HDC_ENCODE_DEFINE_FIXED_WITH(name, CHANNELS, MAX_VALUE, hdc_kernel_encode_word_P)
+
+#endif /* HDC_ENCODE_FIXED_H */
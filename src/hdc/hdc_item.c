@@ -0,0 +1,234 @@
+/**
+ * @file    hdc_item.c
+ * @brief   HDC Seeded Item Memory - Implementation
+ * @version 1.0.0
+ * @note    Basis / ID hypervectors regenerated on demand instead of stored
+ *
+ * @details Generation works on 32-bit words regardless of the kernel backend
+ *          so the byte stream does not depend on the target; words are split
+ *          into bytes explicitly (little-endian) rather than stored, which
+ *          also keeps the result independent of host byte order.
+ */
+
+#include "hdc_item.h"
+#include "hdc_probe.h"
+
+/* =============================================================================
+ * Private Helpers
+ * ========================================================================== */
+
+/** @brief Bytes produced per generator step */
+#define ITEM_WORD_BYTES     4U
+
+/**
+ * @brief   One xorshift32 step (Marsaglia 13/17/5, period 2^32 - 1)
+ * @param   stream Generator
+ * @return  New state, which is also the output word
+ */
+static inline uint32_t item_step(hdc_item_stream_t* stream)
+{
+    uint32_t x = stream->state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    stream->state = x;
+    return x;
+}
+
+/**
+ * @brief   Thermometer bits of one 32-bit word
+ * @param   level Thermometer level
+ * @param   first_bit Bit index of the word's least significant bit
+ * @return  Word with the low min(level - first_bit, 32) bits set
+ */
+static inline uint32_t item_prefix_mask(uint16_t level, uint16_t first_bit)
+{
+    if (level <= first_bit) {
+        return 0UL;
+    }
+    uint16_t k = (uint16_t)(level - first_bit);
+    if (k >= 32U) {
+        return 0xFFFFFFFFUL;
+    }
+    return (1UL << k) - 1UL;
+}
+
+/**
+ * @brief   OR a block of channels bound with their generated basis vectors
+ * @param   result Output hypervector
+ * @param   levels Thermometer level per channel
+ * @param   num_channels Channels in this block (<= HDC_ENCODE_CHANNEL_BLOCK)
+ * @param   seed Item memory seed
+ * @param   first_id Item ID of the block's first channel
+ * @param   accumulate 0 to overwrite result, 1 to OR into it
+ */
+static void encode_seeded_block(hv_t result, const hdc_level_t* levels, uint8_t num_channels,
+                                uint32_t seed, hdc_item_id_t first_id, uint8_t accumulate)
+{
+    hdc_item_stream_t streams[HDC_ENCODE_CHANNEL_BLOCK];
+
+    for (uint8_t ch = 0U; ch < num_channels; ch++) {
+        hdc_item_begin(&streams[ch], seed, (hdc_item_id_t)(first_id + ch));
+    }
+
+    for (uint16_t i = 0U; i < HV_BYTES; i = (uint16_t)(i + ITEM_WORD_BYTES)) {
+        uint16_t first_bit = (uint16_t)(i * 8U);
+        uint32_t acc = 0UL;
+
+        for (uint8_t ch = 0U; ch < num_channels; ch++) {
+            acc |= item_step(&streams[ch]) ^ item_prefix_mask(levels[ch], first_bit);
+        }
+
+        uint8_t bytes = ((HV_BYTES - i) < ITEM_WORD_BYTES) ? (uint8_t)(HV_BYTES - i)
+                                                           : (uint8_t)ITEM_WORD_BYTES;
+        for (uint8_t k = 0U; k < bytes; k++) {
+            uint8_t byte = (uint8_t)(acc >> (8U * k));
+            result[i + k] = (accumulate != 0U) ? (uint8_t)(result[i + k] | byte) : byte;
+        }
+    }
+}
+
+/* =============================================================================
+ * Generator
+ * ========================================================================== */
+
+/**
+ * @brief   Initial generator state for one item
+ * @param   seed Item memory seed (one per model / deployment)
+ * @param   id Item identifier
+ * @return  Mixed, non-zero xorshift32 state
+ *
+ * @details Golden-ratio spread of the ID followed by the MurmurHash3 32-bit
+ *          finalizer; a zero result (the one fixed point of xorshift) is
+ *          replaced by a constant.
+ */
+uint32_t hdc_item_seed(uint32_t seed, hdc_item_id_t id)
+{
+    uint32_t x = seed ^ ((uint32_t)id * 0x9E3779B9UL);
+
+    x ^= x >> 16;
+    x *= 0x85EBCA6BUL;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35UL;
+    x ^= x >> 16;
+    return (x != 0UL) ? x : 0x6D2B79F5UL;
+}
+
+/**
+ * @brief   Start generating the vector of one item
+ * @param   stream Generator to initialize
+ * @param   seed Item memory seed
+ * @param   id Item identifier
+ */
+void hdc_item_begin(hdc_item_stream_t* stream, uint32_t seed, hdc_item_id_t id)
+{
+    stream->state = hdc_item_seed(seed, id);
+}
+
+/**
+ * @brief   Next 32 bits of the item vector (bytes 4w .. 4w+3, little-endian)
+ * @param   stream Generator
+ * @return  Next word
+ */
+uint32_t hdc_item_next(hdc_item_stream_t* stream)
+{
+    return item_step(stream);
+}
+
+/**
+ * @brief   Materialize the vector of one item
+ * @param   hv Output hypervector
+ * @param   seed Item memory seed
+ * @param   id Item identifier
+ */
+void hdc_item_generate(hv_t hv, uint32_t seed, hdc_item_id_t id)
+{
+    hdc_item_stream_t stream;
+
+    hdc_item_begin(&stream, seed, id);
+    for (uint16_t i = 0U; i < HV_BYTES; i = (uint16_t)(i + ITEM_WORD_BYTES)) {
+        uint32_t word = item_step(&stream);
+        for (uint8_t k = 0U; (k < ITEM_WORD_BYTES) && ((i + k) < HV_BYTES); k++) {
+            hv[i + k] = (uint8_t)(word >> (8U * k));
+        }
+    }
+}
+
+/* =============================================================================
+ * Seeded Encoding
+ * ========================================================================== */
+
+/**
+ * @brief   hdc_encode_multi_channel() against generated basis vectors
+ * @param   result Output combined hypervector
+ * @param   values Array of sensor values
+ * @param   num_channels Number of channels to encode
+ * @param   seed Item memory seed; channel ch binds with item ch
+ */
+void hdc_encode_multi_channel_seeded(
+    hv_t result,
+    const uint16_t* values,
+    uint8_t num_channels,
+    uint32_t seed)
+{
+    hdc_level_t levels[HDC_ENCODE_CHANNEL_BLOCK];
+    uint8_t accumulate = 0U;
+
+    if (num_channels == 0U) {
+        hdc_clear(result);
+        return;
+    }
+
+    HDC_PROBE_BEGIN(HDC_PROBE_ENCODE_MULTI);
+    for (uint8_t base = 0U; base < num_channels; base = (uint8_t)(base + HDC_ENCODE_CHANNEL_BLOCK)) {
+        uint8_t remaining = (uint8_t)(num_channels - base);
+        uint8_t block = (remaining < HDC_ENCODE_CHANNEL_BLOCK) ? remaining : (uint8_t)HDC_ENCODE_CHANNEL_BLOCK;
+
+        for (uint8_t ch = 0U; ch < block; ch++) {
+            levels[ch] = hdc_level_from_adc(values[base + ch]);
+        }
+        encode_seeded_block(result, levels, block, seed, base, accumulate);
+        accumulate = 1U;
+
+        if (remaining <= HDC_ENCODE_CHANNEL_BLOCK) {
+            break;
+        }
+    }
+    HDC_PROBE_END(HDC_PROBE_ENCODE_MULTI);
+}
+
+/**
+ * @brief   hdc_encode_levels() against generated basis vectors
+ * @param   result Output combined hypervector
+ * @param   levels Thermometer level per channel
+ * @param   num_channels Number of channels to encode
+ * @param   seed Item memory seed; channel ch binds with item ch
+ */
+void hdc_encode_levels_seeded(
+    hv_t result,
+    const hdc_level_t* levels,
+    uint8_t num_channels,
+    uint32_t seed)
+{
+    uint8_t accumulate = 0U;
+
+    if (num_channels == 0U) {
+        hdc_clear(result);
+        return;
+    }
+
+    HDC_PROBE_BEGIN(HDC_PROBE_ENCODE_LEVELS);
+    for (uint8_t base = 0U; base < num_channels; base = (uint8_t)(base + HDC_ENCODE_CHANNEL_BLOCK)) {
+        uint8_t remaining = (uint8_t)(num_channels - base);
+        uint8_t block = (remaining < HDC_ENCODE_CHANNEL_BLOCK) ? remaining : (uint8_t)HDC_ENCODE_CHANNEL_BLOCK;
+
+        encode_seeded_block(result, &levels[base], block, seed, base, accumulate);
+        accumulate = 1U;
+
+        if (remaining <= HDC_ENCODE_CHANNEL_BLOCK) {
+            break;
+        }
+    }
+    HDC_PROBE_END(HDC_PROBE_ENCODE_LEVELS);
+}
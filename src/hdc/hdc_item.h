@@ -0,0 +1,112 @@
+/**
+ * @file    hdc_item.h
+ * @brief   HDC Seeded Item Memory - Declarations
+ * @version 1.0.0
+ * @note    Basis / ID hypervectors regenerated on demand instead of stored
+ *
+ * @details An item memory maps an ID (channel, symbol, class) to a fixed
+ *          pseudo-random hypervector. Instead of storing one vector per ID,
+ *          each vector is regenerated from (seed, id) whenever it is needed:
+ *
+ *            state = hdc_item_seed(seed, id)     mixed, never zero
+ *            word  = xorshift32(state)           repeated, one per 4 bytes
+ *            hv[4w + k] = byte k of word w       little-endian
+ *
+ *          Only 32-bit integer arithmetic is used, so the AVR, the host tests
+ *          and a gateway produce bit-identical vectors from the same seed and
+ *          none of them needs a basis table. Level vectors need no memory at
+ *          all: thermometer codes are computed from the level (hdc_encode.h).
+ *
+ *          The _seeded encoders bind against the generated basis word by
+ *          word, so a multi-channel sample is encoded with no basis storage;
+ *          the cost is one xorshift step per channel per 4 output bytes.
+ */
+
+#ifndef HDC_ITEM_H
+#define HDC_ITEM_H
+
+#include <stdint.h>
+#include "hdc_core.h"
+#include "hdc_encode.h"
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Item identifier (channel index, symbol, ...) */
+typedef uint16_t hdc_item_id_t;
+
+/** @brief Generator for one item vector, produced 32 bits at a time */
+typedef struct {
+    uint32_t state;     /**< xorshift32 state (never zero) */
+} hdc_item_stream_t;
+
+/* =============================================================================
+ * Function Declarations - Generator
+ * ========================================================================== */
+
+/**
+ * @brief   Initial generator state for one item
+ * @param   seed Item memory seed (one per model / deployment)
+ * @param   id Item identifier
+ * @return  Mixed, non-zero xorshift32 state
+ * @note    Nearby IDs and seeds give unrelated states (32-bit avalanche mix)
+ */
+uint32_t hdc_item_seed(uint32_t seed, hdc_item_id_t id);
+
+/**
+ * @brief   Start generating the vector of one item
+ * @param   stream Generator to initialize
+ * @param   seed Item memory seed
+ * @param   id Item identifier
+ */
+void hdc_item_begin(hdc_item_stream_t* stream, uint32_t seed, hdc_item_id_t id);
+
+/**
+ * @brief   Next 32 bits of the item vector (bytes 4w .. 4w+3, little-endian)
+ * @param   stream Generator
+ * @return  Next word
+ */
+uint32_t hdc_item_next(hdc_item_stream_t* stream);
+
+/**
+ * @brief   Materialize the vector of one item
+ * @param   hv Output hypervector
+ * @param   seed Item memory seed
+ * @param   id Item identifier
+ */
+void hdc_item_generate(hv_t hv, uint32_t seed, hdc_item_id_t id);
+
+/* =============================================================================
+ * Function Declarations - Seeded Encoding
+ * ========================================================================== */
+
+/**
+ * @brief   hdc_encode_multi_channel() against generated basis vectors
+ * @param   result Output combined hypervector
+ * @param   values Array of sensor values
+ * @param   num_channels Number of channels to encode
+ * @param   seed Item memory seed; channel ch binds with item ch
+ * @note    Same output as hdc_encode_multi_channel() with
+ *          basis[ch] = hdc_item_generate(seed, ch)
+ */
+void hdc_encode_multi_channel_seeded(
+    hv_t result,
+    const uint16_t* values,
+    uint8_t num_channels,
+    uint32_t seed);
+
+/**
+ * @brief   hdc_encode_levels() against generated basis vectors
+ * @param   result Output combined hypervector
+ * @param   levels Thermometer level per channel
+ * @param   num_channels Number of channels to encode
+ * @param   seed Item memory seed; channel ch binds with item ch
+ */
+void hdc_encode_levels_seeded(
+    hv_t result,
+    const hdc_level_t* levels,
+    uint8_t num_channels,
+    uint32_t seed);
+
+#endif /* HDC_ITEM_H */
@@ -0,0 +1,847 @@
+/**
+ * @file    hdc_kernel.h
+ * @brief   HDC Kernel Backends - Compile-Time Selection and Primitives
+ * @version 1.0.0
+ * @note    Internal header used by the HDC modules; applications include hdc.h
+ *
+ * @details The bitwise and distance operations in hdc_core.c are written
+ *          against the range kernels in this header. The backend is chosen
+ *          at compile time with -DHDC_KERNEL=<backend> (see platformio.ini):
+ *
+ *          - HDC_KERNEL_AVR    : 8-bit, flash popcount table, AVR assembly
+ *                                Hamming/XOR loops (default on ATmega328P)
+ *          - HDC_KERNEL_BYTE   : 8-bit loop, SWAR popcount (portable C)
+ *          - HDC_KERNEL_WORD32 : 32-bit word loop
+ *          - HDC_KERNEL_WORD64 : 64-bit word loop
+ *          - HDC_KERNEL_AVX2   : 256-bit AVX2 blocks + POPCNT word tail
+ *          - HDC_KERNEL_NEON   : 128-bit NEON blocks with VCNT
+ *
+ *          When HDC_KERNEL is not defined the widest backend the compiler
+ *          target supports is selected. Word accesses go through memcpy so
+ *          hv_t keeps its byte-array type and alignment; compilers lower
+ *          these copies to single loads/stores.
+ */
+
+#ifndef HDC_KERNEL_H
+#define HDC_KERNEL_H
+
+#include <stdint.h>
+#include <string.h>
+#include "hdc_core.h"
+#include "hdc_pgm.h"
+
+/* =============================================================================
+ * Backend Identifiers
+ * ========================================================================== */
+
+#define HDC_KERNEL_BYTE     1
+#define HDC_KERNEL_WORD32   2
+#define HDC_KERNEL_WORD64   3
+#define HDC_KERNEL_AVX2     4
+#define HDC_KERNEL_NEON     5
+#define HDC_KERNEL_AVR      6
+
+/* =============================================================================
+ * Backend Selection
+ * ========================================================================== */
+
+#ifndef HDC_KERNEL
+    #if defined(__AVR__)
+        #define HDC_KERNEL  HDC_KERNEL_AVR
+    #elif defined(__AVX2__)
+        #define HDC_KERNEL  HDC_KERNEL_AVX2
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define HDC_KERNEL  HDC_KERNEL_NEON
+    #elif defined(UINTPTR_MAX) && (UINTPTR_MAX > 0xFFFFFFFFU)
+        #define HDC_KERNEL  HDC_KERNEL_WORD64
+    #else
+        #define HDC_KERNEL  HDC_KERNEL_WORD32
+    #endif
+#endif
+
+#if (HDC_KERNEL == HDC_KERNEL_AVX2) && !defined(__AVX2__)
+    #error "HDC_KERNEL_AVX2 requires -mavx2 (and -mpopcnt for the word tail)"
+#endif
+
+#if (HDC_KERNEL == HDC_KERNEL_NEON) && !(defined(__ARM_NEON) || defined(__ARM_NEON__))
+    #error "HDC_KERNEL_NEON requires a NEON-capable ARM target"
+#endif
+
+#if (HDC_KERNEL < HDC_KERNEL_BYTE) || (HDC_KERNEL > HDC_KERNEL_AVR)
+    #error "Unknown HDC_KERNEL backend"
+#endif
+
+#if (HDC_KERNEL == HDC_KERNEL_AVX2)
+    #include <immintrin.h>
+#elif (HDC_KERNEL == HDC_KERNEL_NEON)
+    #include <arm_neon.h>
+#endif
+
+/* =============================================================================
+ * Word Type
+ * ========================================================================== */
+
+/** @brief 8-bit backends: one byte per word, no word-merging loops */
+#define HDC_KERNEL_IS_8BIT  ((HDC_KERNEL == HDC_KERNEL_BYTE) || (HDC_KERNEL == HDC_KERNEL_AVR))
+
+/** @brief AVR backend with its assembly loops (the C fallback runs elsewhere) */
+#if (HDC_KERNEL == HDC_KERNEL_AVR) && defined(__AVR__)
+    #define HDC_KERNEL_AVR_ASM  1
+#else
+    #define HDC_KERNEL_AVR_ASM  0
+#endif
+
+#if HDC_KERNEL_IS_8BIT
+    /** @brief Machine word used by the scalar loops */
+    typedef uint8_t hdc_word_t;
+    #if (HDC_KERNEL == HDC_KERNEL_AVR)
+        #define HDC_KERNEL_NAME "avr"
+    #else
+        #define HDC_KERNEL_NAME "byte"
+    #endif
+#elif (HDC_KERNEL == HDC_KERNEL_WORD32)
+    typedef uint32_t hdc_word_t;
+    #define HDC_KERNEL_NAME     "word32"
+#else
+    typedef uint64_t hdc_word_t;
+    #if (HDC_KERNEL == HDC_KERNEL_WORD64)
+        #define HDC_KERNEL_NAME "word64"
+    #elif (HDC_KERNEL == HDC_KERNEL_AVX2)
+        #define HDC_KERNEL_NAME "avx2"
+    #else
+        #define HDC_KERNEL_NAME "neon"
+    #endif
+#endif
+
+/** @brief Size of hdc_word_t in bytes */
+#define HDC_WORD_BYTES      ((uint8_t)sizeof(hdc_word_t))
+
+/** @brief Bits in hdc_word_t */
+#define HDC_WORD_BITS       ((uint8_t)(8U * sizeof(hdc_word_t)))
+
+/* Bit i of a loaded word must be bit (i % 8) of byte (i / 8) for the
+ * thermometer prefix masks below; AVR, x86 and ARM (LE) all qualify. */
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__) && \
+    !HDC_KERNEL_IS_8BIT
+    #error "Word kernels assume little-endian loads; use -DHDC_KERNEL=1"
+#endif
+
+/**
+ * @brief Whole words in one hypervector
+ * @note  0 when HV_BYTES is shorter than a word (only the tail is left), so
+ *        word loops test w != HDC_HV_WORDS: w < 0 would be rejected by
+ *        -Werror=type-limits
+ */
+#define HDC_HV_WORDS        ((hdc_index_t)(HV_BYTES / HDC_WORD_BYTES))
+
+/** @brief Bytes left after the whole words (0 on the byte backend) */
+#define HDC_HV_TAIL_BYTES   ((uint8_t)(HV_BYTES % HDC_WORD_BYTES))
+
+/**
+ * @brief Bytes summed between bound checks in hdc_kernel_hamming_bounded()
+ * @note  One SIMD block / a few words per check keeps the compare off the
+ *        critical path; override with -DHDC_KERNEL_BOUND_CHUNK=<bytes>.
+ */
+#ifndef HDC_KERNEL_BOUND_CHUNK
+    #if HDC_KERNEL_IS_8BIT
+        #define HDC_KERNEL_BOUND_CHUNK  4U
+    #elif (HDC_KERNEL == HDC_KERNEL_WORD32)
+        #define HDC_KERNEL_BOUND_CHUNK  8U
+    #elif (HDC_KERNEL == HDC_KERNEL_WORD64)
+        #define HDC_KERNEL_BOUND_CHUNK  16U
+    #elif (HDC_KERNEL == HDC_KERNEL_AVX2)
+        #define HDC_KERNEL_BOUND_CHUNK  64U
+    #else
+        #define HDC_KERNEL_BOUND_CHUNK  32U
+    #endif
+#endif
+
+/* =============================================================================
+ * AVR Popcount Table
+ * ========================================================================== */
+
+#if (HDC_KERNEL == HDC_KERNEL_AVR)
+/**
+ * @brief Bits set in each byte value, in flash (hdc_core.c)
+ * @note  256-byte aligned on AVR, so the assembly loops index it by loading
+ *        the byte into ZL with ZH fixed. The linker pads up to 255 bytes of
+ *        flash in front of it.
+ */
+extern const uint8_t hdc_popcount_lut_P[256];
+
+/** @brief Bytes per step of the assembly loops (4 XORs, then 4 lookups) */
+#define HDC_AVR_CHUNK_BYTES     4U
+
+/** @brief hdc_hamming() and hdc_xor() are fully unrolled up to this width */
+#ifndef HDC_AVR_UNROLL_BYTES
+#define HDC_AVR_UNROLL_BYTES    32U
+#endif
+#endif
+
+/* =============================================================================
+ * Word Primitives
+ * ========================================================================== */
+
+/**
+ * @brief   Count set bits in a byte
+ * @param   byte Input byte
+ * @return  Number of bits set (0-8)
+ * @note    Flash table lookup on the AVR backend (LPM, 3 cycles), SWAR
+ *          arithmetic otherwise (no table).
+ */
+static inline uint8_t hdc_kernel_popcount8(uint8_t byte)
+{
+#if (HDC_KERNEL == HDC_KERNEL_AVR)
+    return hdc_pgm_read_byte(&hdc_popcount_lut_P[byte]);
+#else
+    byte = byte - ((byte >> 1) & 0x55U);
+    byte = (byte & 0x33U) + ((byte >> 2) & 0x33U);
+    return (byte + (byte >> 4)) & 0x0FU;
+#endif
+}
+
+/**
+ * @brief   Load one word from an unaligned byte pointer
+ * @param   p Source bytes (HDC_WORD_BYTES readable)
+ * @return  Word value in native byte order
+ */
+static inline hdc_word_t hdc_word_load(const uint8_t* p)
+{
+#if HDC_KERNEL_IS_8BIT
+    return *p;
+#else
+    hdc_word_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+#endif
+}
+
+/**
+ * @brief   Store one word to an unaligned byte pointer
+ * @param   p Destination bytes (HDC_WORD_BYTES writable)
+ * @param   w Word value in native byte order
+ */
+static inline void hdc_word_store(uint8_t* p, hdc_word_t w)
+{
+#if HDC_KERNEL_IS_8BIT
+    *p = w;
+#else
+    memcpy(p, &w, sizeof(w));
+#endif
+}
+
+/**
+ * @brief   Load the final, partial word of a range (zero padded)
+ * @param   p Source bytes
+ * @param   n Bytes available (less than HDC_WORD_BYTES)
+ * @return  Word whose missing high-address bytes are zero
+ */
+static inline hdc_word_t hdc_word_load_partial(const uint8_t* p, uint8_t n)
+{
+    hdc_word_t w = 0U;
+    memcpy(&w, p, n);
+    return w;
+}
+
+/**
+ * @brief   Store the final, partial word of a range
+ * @param   p Destination bytes
+ * @param   w Word value
+ * @param   n Bytes to store (less than HDC_WORD_BYTES)
+ */
+static inline void hdc_word_store_partial(uint8_t* p, hdc_word_t w, uint8_t n)
+{
+    memcpy(p, &w, n);
+}
+
+/**
+ * @brief   Load one word from a flash address (see hdc_pgm.h)
+ * @param   p_P Source bytes in flash (HDC_WORD_BYTES readable)
+ * @return  Word value in native byte order
+ */
+static inline hdc_word_t hdc_word_load_P(const uint8_t* p_P)
+{
+#if !HDC_PGM_SEPARATE
+    return hdc_word_load(p_P);
+#elif HDC_KERNEL_IS_8BIT
+    return hdc_pgm_read_byte(p_P);
+#else
+    hdc_word_t w;
+    hdc_pgm_memcpy(&w, p_P, sizeof(w));
+    return w;
+#endif
+}
+
+/**
+ * @brief   Load the final, partial word of a flash range (zero padded)
+ * @param   p_P Source bytes in flash
+ * @param   n Bytes available (less than HDC_WORD_BYTES)
+ * @return  Word whose missing high-address bytes are zero
+ */
+static inline hdc_word_t hdc_word_load_partial_P(const uint8_t* p_P, uint8_t n)
+{
+    hdc_word_t w = 0U;
+    hdc_pgm_memcpy(&w, p_P, n);
+    return w;
+}
+
+/**
+ * @brief   Thermometer bits falling into one word
+ * @param   level Thermometer level (number of low-order bits set)
+ * @param   first_bit Bit index of the word's least significant bit
+ * @return  Word with the low min(level - first_bit, HDC_WORD_BITS) bits set
+ */
+static inline hdc_word_t hdc_word_prefix_mask(uint16_t level, uint16_t first_bit)
+{
+    if (level <= first_bit) {
+        return 0U;
+    }
+    uint16_t k = (uint16_t)(level - first_bit);
+    if (k >= HDC_WORD_BITS) {
+        return (hdc_word_t)~(hdc_word_t)0U;
+    }
+    return (hdc_word_t)(((hdc_word_t)1U << k) - 1U);
+}
+
+/**
+ * @brief   Count set bits in one word
+ * @param   w Input word
+ * @return  Number of bits set (0 to 8 * HDC_WORD_BYTES)
+ * @note    Uses the hardware instruction when the target has one,
+ *          SWAR arithmetic otherwise (no libgcc table call).
+ */
+static inline uint8_t hdc_word_popcount(hdc_word_t w)
+{
+#if HDC_KERNEL_IS_8BIT
+    return hdc_kernel_popcount8(w);
+#elif defined(__POPCNT__) || (HDC_KERNEL == HDC_KERNEL_NEON)
+    return (uint8_t)__builtin_popcountll((unsigned long long)w);
+#elif (HDC_KERNEL == HDC_KERNEL_WORD32)
+    w = w - ((w >> 1) & 0x55555555UL);
+    w = (w & 0x33333333UL) + ((w >> 2) & 0x33333333UL);
+    w = (w + (w >> 4)) & 0x0F0F0F0FUL;
+    return (uint8_t)((w * 0x01010101UL) >> 24);
+#else
+    w = w - ((w >> 1) & 0x5555555555555555ULL);
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (uint8_t)((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/* =============================================================================
+ * AVR Assembly Loops
+ * ========================================================================== */
+
+#if HDC_KERNEL_AVR_ASM
+/*
+ * Each step handles HDC_AVR_CHUNK_BYTES bytes: a[] is read through X and
+ * b[] through Z, and four XORs are kept in registers. Z is then saved with
+ * MOVW and pointed at the popcount table (ZH = table page, ZL = byte) for
+ * four LPMs, or at result[] for four stores. The popcount step is 44 cycles
+ * per 4 bytes (11 per byte, against about 22 for the SWAR C loop); the XOR
+ * step is 32 (8 per byte). Both are emitted either as a counted loop
+ * (DEC/BRNE, 3 more cycles per step) or as a fully unrolled .rept block.
+ */
+
+/** @brief XOR four bytes of X[] and Z[] into t0..t3 */
+#define HDC_AVR_ASM_LOAD_XOR4                               \
+    "ld   %[t0], X+"                "\n\t"                  \
+    "ld   __tmp_reg__, Z+"          "\n\t"                  \
+    "eor  %[t0], __tmp_reg__"       "\n\t"                  \
+    "ld   %[t1], X+"                "\n\t"                  \
+    "ld   __tmp_reg__, Z+"          "\n\t"                  \
+    "eor  %[t1], __tmp_reg__"       "\n\t"                  \
+    "ld   %[t2], X+"                "\n\t"                  \
+    "ld   __tmp_reg__, Z+"          "\n\t"                  \
+    "eor  %[t2], __tmp_reg__"       "\n\t"                  \
+    "ld   %[t3], X+"                "\n\t"                  \
+    "ld   __tmp_reg__, Z+"          "\n\t"                  \
+    "eor  %[t3], __tmp_reg__"       "\n\t"
+
+/** @brief Add the popcounts of t0..t3 to sum (16-bit) */
+#define HDC_AVR_ASM_POPCOUNT4                               \
+    HDC_AVR_ASM_LOAD_XOR4                                   \
+    "movw %[save], r30"             "\n\t"                  \
+    "mov  r31, %[page]"             "\n\t"                  \
+    "mov  r30, %[t0]"               "\n\t"                  \
+    "lpm  %[t0], Z"                 "\n\t"                  \
+    "mov  r30, %[t1]"               "\n\t"                  \
+    "lpm  %[t1], Z"                 "\n\t"                  \
+    "mov  r30, %[t2]"               "\n\t"                  \
+    "lpm  %[t2], Z"                 "\n\t"                  \
+    "mov  r30, %[t3]"               "\n\t"                  \
+    "lpm  %[t3], Z"                 "\n\t"                  \
+    "add  %[t0], %[t1]"             "\n\t"                  \
+    "add  %[t2], %[t3]"             "\n\t"                  \
+    "add  %[t0], %[t2]"             "\n\t"                  \
+    "add  %A[sum], %[t0]"           "\n\t"                  \
+    "adc  %B[sum], __zero_reg__"    "\n\t"                  \
+    "movw r30, %[save]"             "\n\t"
+
+/** @brief Store t0..t3 to result[] (advancing the result pointer) */
+#define HDC_AVR_ASM_XOR4                                    \
+    HDC_AVR_ASM_LOAD_XOR4                                   \
+    "movw %[save], r30"             "\n\t"                  \
+    "movw r30, %[r]"                "\n\t"                  \
+    "st   Z+, %[t0]"                "\n\t"                  \
+    "st   Z+, %[t1]"                "\n\t"                  \
+    "st   Z+, %[t2]"                "\n\t"                  \
+    "st   Z+, %[t3]"                "\n\t"                  \
+    "movw %[r], r30"                "\n\t"                  \
+    "movw r30, %[save]"             "\n\t"
+
+/* Operands shared by both loops. "memory": the loops read (and the XOR
+ * loop writes) through pointers the compiler does not see as operands. */
+#define HDC_AVR_ASM_TEMPS                                   \
+    [save] "=&r" (save), [t0] "=&r" (t0), [t1] "=&r" (t1),  \
+    [t2] "=&r" (t2), [t3] "=&r" (t3), [a] "+x" (a), [b] "+z" (b)
+
+/**
+ * @brief   Bits differing over chunks * 4 bytes (counted loop)
+ * @param   a First input
+ * @param   b Second input
+ * @param   chunks Number of 4-byte steps (1-255)
+ * @return  Number of differing bits
+ */
+static inline uint16_t hdc_avr_hamming_loop(const uint8_t* a, const uint8_t* b, uint8_t chunks)
+{
+    uint16_t sum = 0U;
+    uint16_t save;
+    uint8_t t0, t1, t2, t3;
+
+    __asm__ __volatile__ (
+        "1:"                            "\n\t"
+        HDC_AVR_ASM_POPCOUNT4
+        "dec  %[k]"                     "\n\t"
+        "brne 1b"                       "\n\t"
+        : [sum] "+r" (sum), [k] "+r" (chunks), HDC_AVR_ASM_TEMPS
+        : [page] "r" ((uint8_t)((uintptr_t)hdc_popcount_lut_P >> 8))
+        : "memory");
+    return sum;
+}
+
+/**
+ * @brief   Bits differing over one whole hypervector (fully unrolled)
+ * @param   a First input (HV_BYTES)
+ * @param   b Second input (HV_BYTES)
+ * @return  Number of differing bits over the whole chunks (HV_BYTES & ~3)
+ */
+static inline uint16_t hdc_avr_hamming_hv(const uint8_t* a, const uint8_t* b)
+{
+    uint16_t sum = 0U;
+    uint16_t save;
+    uint8_t t0, t1, t2, t3;
+
+    __asm__ __volatile__ (
+        ".rept %[k]"                    "\n\t"
+        HDC_AVR_ASM_POPCOUNT4
+        ".endr"                         "\n\t"
+        : [sum] "+r" (sum), HDC_AVR_ASM_TEMPS
+        : [page] "r" ((uint8_t)((uintptr_t)hdc_popcount_lut_P >> 8)),
+          [k] "n" (HV_BYTES / HDC_AVR_CHUNK_BYTES)
+        : "memory");
+    return sum;
+}
+
+/**
+ * @brief   result = a ^ b over chunks * 4 bytes (counted loop)
+ * @param   result Output (may alias a or b)
+ * @param   a First input
+ * @param   b Second input
+ * @param   chunks Number of 4-byte steps (1-255)
+ */
+static inline void hdc_avr_xor_loop(uint8_t* result, const uint8_t* a, const uint8_t* b,
+                                    uint8_t chunks)
+{
+    uint16_t save;
+    uint8_t t0, t1, t2, t3;
+
+    __asm__ __volatile__ (
+        "1:"                            "\n\t"
+        HDC_AVR_ASM_XOR4
+        "dec  %[k]"                     "\n\t"
+        "brne 1b"                       "\n\t"
+        : [r] "+r" (result), [k] "+r" (chunks), HDC_AVR_ASM_TEMPS
+        :
+        : "memory");
+}
+
+/**
+ * @brief   result = a ^ b over one whole hypervector (fully unrolled)
+ * @param   result Output (may alias a or b)
+ * @param   a First input
+ * @param   b Second input
+ */
+static inline void hdc_avr_xor_hv(uint8_t* result, const uint8_t* a, const uint8_t* b)
+{
+    uint16_t save;
+    uint8_t t0, t1, t2, t3;
+
+    __asm__ __volatile__ (
+        ".rept %[k]"                    "\n\t"
+        HDC_AVR_ASM_XOR4
+        ".endr"                         "\n\t"
+        : [r] "+r" (result), HDC_AVR_ASM_TEMPS
+        : [k] "n" (HV_BYTES / HDC_AVR_CHUNK_BYTES)
+        : "memory");
+}
+
+/**
+ * @brief   Whole 4-byte steps in n bytes, per asm call (at most 255)
+ */
+static inline uint8_t hdc_avr_chunks(hdc_index_t n)
+{
+    uint16_t chunks = (uint16_t)(n / HDC_AVR_CHUNK_BYTES);
+    return (chunks > 255U) ? 255U : (uint8_t)chunks;
+}
+
+/**
+ * @brief   The range is one whole, unrollable hypervector
+ * @note    Folds to a constant where n is a constant after inlining
+ *          (hdc_hamming(), hdc_xor()); other call sites use the loops.
+ */
+#define HDC_AVR_IS_WHOLE_HV(n)                                          \
+    (__builtin_constant_p(n) && ((n) == HV_BYTES) &&                    \
+     ((HV_BYTES % HDC_AVR_CHUNK_BYTES) == 0U) && (HV_BYTES <= HDC_AVR_UNROLL_BYTES))
+#endif /* HDC_KERNEL_AVR_ASM */
+
+/* =============================================================================
+ * Range Kernels
+ * ========================================================================== */
+
+/*
+ * Every range kernel runs three stages: SIMD blocks (AVX2/NEON only), whole
+ * words, then single bytes. With a compile-time length the unused stages
+ * fold away, so the byte backend compiles to the original uint8_t loop.
+ */
+
+/**
+ * @brief   Count set bits over a byte range
+ * @param   p Input bytes
+ * @param   n Number of bytes
+ * @return  Total number of bits set
+ */
+static inline hdc_dist_t hdc_kernel_popcount(const uint8_t* p, hdc_index_t n)
+{
+    hdc_dist_t count = 0U;
+    hdc_index_t i = 0U;
+
+#if (HDC_KERNEL == HDC_KERNEL_NEON)
+    if (n >= 16U) {
+        uint16x8_t acc = vdupq_n_u16(0U);
+        for (; (hdc_index_t)(n - i) >= 16U; i += 16U) {
+            acc = vpadalq_u8(acc, vcntq_u8(vld1q_u8(&p[i])));
+        }
+        uint64x2_t sum = vpaddlq_u32(vpaddlq_u16(acc));
+        count += (hdc_dist_t)(vgetq_lane_u64(sum, 0) + vgetq_lane_u64(sum, 1));
+    }
+#endif
+
+    for (; (hdc_index_t)(n - i) >= HDC_WORD_BYTES; i += HDC_WORD_BYTES) {
+        count += hdc_word_popcount(hdc_word_load(&p[i]));
+    }
+    for (; i < n; i++) {
+        count += hdc_kernel_popcount8(p[i]);
+    }
+    return count;
+}
+
+/**
+ * @brief   Hamming distance between two byte ranges
+ * @param   a First input
+ * @param   b Second input
+ * @param   n Number of bytes
+ * @return  Number of differing bits
+ */
+static inline hdc_dist_t hdc_kernel_hamming(const uint8_t* a, const uint8_t* b, hdc_index_t n)
+{
+    hdc_dist_t distance = 0U;
+    hdc_index_t i = 0U;
+
+#if (HDC_KERNEL == HDC_KERNEL_AVX2)
+    if (n >= 32U) {
+        /* Nibble lookup (Mula): AVX2 has no vector popcount instruction */
+        const __m256i lut = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low = _mm256_set1_epi8(0x0F);
+        __m256i acc = _mm256_setzero_si256();
+        for (; (hdc_index_t)(n - i) >= 32U; i += 32U) {
+            __m256i x = _mm256_xor_si256(
+                _mm256_loadu_si256((const __m256i*)(const void*)&a[i]),
+                _mm256_loadu_si256((const __m256i*)(const void*)&b[i]));
+            __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(x, low));
+            __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x, 4), low));
+            acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+        }
+        distance += (hdc_dist_t)((uint64_t)_mm256_extract_epi64(acc, 0) + (uint64_t)_mm256_extract_epi64(acc, 1) +
+                              (uint64_t)_mm256_extract_epi64(acc, 2) + (uint64_t)_mm256_extract_epi64(acc, 3));
+    }
+#elif (HDC_KERNEL == HDC_KERNEL_NEON)
+    if (n >= 16U) {
+        uint16x8_t acc = vdupq_n_u16(0U);
+        for (; (hdc_index_t)(n - i) >= 16U; i += 16U) {
+            uint8x16_t x = veorq_u8(vld1q_u8(&a[i]), vld1q_u8(&b[i]));
+            acc = vpadalq_u8(acc, vcntq_u8(x));
+        }
+        uint64x2_t sum = vpaddlq_u32(vpaddlq_u16(acc));
+        distance += (hdc_dist_t)(vgetq_lane_u64(sum, 0) + vgetq_lane_u64(sum, 1));
+    }
+#elif HDC_KERNEL_AVR_ASM
+    if (HDC_AVR_IS_WHOLE_HV(n)) {
+        return (hdc_dist_t)hdc_avr_hamming_hv(a, b);
+    }
+    while ((hdc_index_t)(n - i) >= HDC_AVR_CHUNK_BYTES) {
+        uint8_t chunks = hdc_avr_chunks((hdc_index_t)(n - i));
+        distance += (hdc_dist_t)hdc_avr_hamming_loop(&a[i], &b[i], chunks);
+        i += (hdc_index_t)(chunks * HDC_AVR_CHUNK_BYTES);
+    }
+#endif
+
+    for (; (hdc_index_t)(n - i) >= HDC_WORD_BYTES; i += HDC_WORD_BYTES) {
+        distance += hdc_word_popcount(hdc_word_load(&a[i]) ^ hdc_word_load(&b[i]));
+    }
+    for (; i < n; i++) {
+        distance += hdc_kernel_popcount8(a[i] ^ b[i]);
+    }
+    return distance;
+}
+
+/**
+ * @brief   Hamming distance with early exit above a bound
+ * @param   a First input
+ * @param   b Second input
+ * @param   n Number of bytes
+ * @param   bound Largest distance of interest
+ * @return  Exact distance if it is <= bound, otherwise some value > bound
+ *
+ * @details The range is summed HDC_KERNEL_BOUND_CHUNK bytes at a time and
+ *          abandoned as soon as the partial sum exceeds bound.
+ */
+static inline hdc_dist_t hdc_kernel_hamming_bounded(const uint8_t* a, const uint8_t* b,
+                                                    hdc_index_t n, hdc_dist_t bound)
+{
+    hdc_dist_t distance = 0U;
+    hdc_index_t i = 0U;
+
+    for (; (hdc_index_t)(n - i) > HDC_KERNEL_BOUND_CHUNK; i += HDC_KERNEL_BOUND_CHUNK) {
+        distance += hdc_kernel_hamming(&a[i], &b[i], HDC_KERNEL_BOUND_CHUNK);
+        if (distance > bound) {
+            return distance;
+        }
+    }
+    return (hdc_dist_t)(distance + hdc_kernel_hamming(&a[i], &b[i], (hdc_index_t)(n - i)));
+}
+
+/*
+ * Bitwise range kernels are generated per operation so no operation
+ * selector survives into the loop when the compiler declines to inline
+ * (avr-gcc -Os frequently does).
+ *
+ * name      : kernel function name
+ * OP        : C operator applied to bytes and words
+ * AVX2_OP   : matching _mm256 intrinsic
+ * NEON_OP   : matching NEON intrinsic
+ */
+#if (HDC_KERNEL == HDC_KERNEL_AVX2)
+    #define HDC_KERNEL_BITWISE_SIMD(OP, AVX2_OP, NEON_OP)                           \
+        for (; (hdc_index_t)(n - i) >= 32U; i += 32U) {                                 \
+            __m256i x = _mm256_loadu_si256((const __m256i*)(const void*)&a[i]);     \
+            __m256i y = _mm256_loadu_si256((const __m256i*)(const void*)&b[i]);     \
+            _mm256_storeu_si256((__m256i*)(void*)&result[i], AVX2_OP(x, y));        \
+        }
+#elif (HDC_KERNEL == HDC_KERNEL_NEON)
+    #define HDC_KERNEL_BITWISE_SIMD(OP, AVX2_OP, NEON_OP)                           \
+        for (; (hdc_index_t)(n - i) >= 16U; i += 16U) {                                 \
+            vst1q_u8(&result[i], NEON_OP(vld1q_u8(&a[i]), vld1q_u8(&b[i])));        \
+        }
+#else
+    #define HDC_KERNEL_BITWISE_SIMD(OP, AVX2_OP, NEON_OP)
+#endif
+
+#define HDC_KERNEL_DEFINE_BITWISE(name, OP, AVX2_OP, NEON_OP)                       \
+    static inline void name(uint8_t* result, const uint8_t* a, const uint8_t* b,    \
+                            hdc_index_t n)                                          \
+    {                                                                               \
+        hdc_index_t i = 0U;                                                         \
+        HDC_KERNEL_BITWISE_SIMD(OP, AVX2_OP, NEON_OP)                               \
+        for (; (hdc_index_t)(n - i) >= HDC_WORD_BYTES; i += HDC_WORD_BYTES) {           \
+            hdc_word_store(&result[i],                                              \
+                           (hdc_word_t)(hdc_word_load(&a[i]) OP hdc_word_load(&b[i]))); \
+        }                                                                           \
+        for (; i < n; i++) {                                                        \
+            result[i] = (uint8_t)(a[i] OP b[i]);                                    \
+        }                                                                           \
+    }
+
+#if HDC_KERNEL_AVR_ASM
+/**
+ * @brief   result = a ^ b over n bytes (result may alias a or b)
+ */
+static inline void hdc_kernel_xor(uint8_t* result, const uint8_t* a, const uint8_t* b,
+                                  hdc_index_t n)
+{
+    hdc_index_t i = 0U;
+
+    if (HDC_AVR_IS_WHOLE_HV(n)) {
+        hdc_avr_xor_hv(result, a, b);
+        return;
+    }
+    while ((hdc_index_t)(n - i) >= HDC_AVR_CHUNK_BYTES) {
+        uint8_t chunks = hdc_avr_chunks((hdc_index_t)(n - i));
+        hdc_avr_xor_loop(&result[i], &a[i], &b[i], chunks);
+        i += (hdc_index_t)(chunks * HDC_AVR_CHUNK_BYTES);
+    }
+    for (; i < n; i++) {
+        result[i] = (uint8_t)(a[i] ^ b[i]);
+    }
+}
+#else
+/**
+ * @brief   result = a ^ b over n bytes (result may alias a or b)
+ */
+HDC_KERNEL_DEFINE_BITWISE(hdc_kernel_xor, ^, _mm256_xor_si256, veorq_u8)
+#endif
+
+/**
+ * @brief   result = a | b over n bytes (result may alias a or b)
+ */
+HDC_KERNEL_DEFINE_BITWISE(hdc_kernel_or, |, _mm256_or_si256, vorrq_u8)
+
+/**
+ * @brief   result = a & b over n bytes (result may alias a or b)
+ */
+HDC_KERNEL_DEFINE_BITWISE(hdc_kernel_and, &, _mm256_and_si256, vandq_u8)
+
+/* =============================================================================
+ * Flash Operand Kernels
+ * ========================================================================== */
+
+/*
+ * Same results as the kernels above with the second operand in flash. On the
+ * host (HDC_PGM_SEPARATE == 0) they are the RAM kernels, SIMD included; on
+ * AVR the flash operand is read with LPM through hdc_word_load_P().
+ */
+
+/**
+ * @brief   Hamming distance between a RAM range and a flash range
+ * @param   a First input (SRAM)
+ * @param   b_P Second input (flash)
+ * @param   n Number of bytes
+ * @return  Number of differing bits
+ */
+static inline hdc_dist_t hdc_kernel_hamming_P(const uint8_t* a, const uint8_t* b_P, hdc_index_t n)
+{
+#if HDC_PGM_SEPARATE
+    hdc_dist_t distance = 0U;
+    hdc_index_t i = 0U;
+
+    for (; (hdc_index_t)(n - i) >= HDC_WORD_BYTES; i += HDC_WORD_BYTES) {
+        distance += hdc_word_popcount(hdc_word_load(&a[i]) ^ hdc_word_load_P(&b_P[i]));
+    }
+    for (; i < n; i++) {
+        distance += hdc_kernel_popcount8((uint8_t)(a[i] ^ hdc_pgm_read_byte(&b_P[i])));
+    }
+    return distance;
+#else
+    return hdc_kernel_hamming(a, b_P, n);
+#endif
+}
+
+/**
+ * @brief   hdc_kernel_hamming_bounded() with the second operand in flash
+ * @param   a First input (SRAM)
+ * @param   b_P Second input (flash)
+ * @param   n Number of bytes
+ * @param   bound Largest distance of interest
+ * @return  Exact distance if it is <= bound, otherwise some value > bound
+ */
+static inline hdc_dist_t hdc_kernel_hamming_bounded_P(const uint8_t* a, const uint8_t* b_P,
+                                                      hdc_index_t n, hdc_dist_t bound)
+{
+    hdc_dist_t distance = 0U;
+    hdc_index_t i = 0U;
+
+    for (; (hdc_index_t)(n - i) > HDC_KERNEL_BOUND_CHUNK; i += HDC_KERNEL_BOUND_CHUNK) {
+        distance += hdc_kernel_hamming_P(&a[i], &b_P[i], HDC_KERNEL_BOUND_CHUNK);
+        if (distance > bound) {
+            return distance;
+        }
+    }
+    return (hdc_dist_t)(distance + hdc_kernel_hamming_P(&a[i], &b_P[i], (hdc_index_t)(n - i)));
+}
+
+/**
+ * @brief   result = a ^ b_P over n bytes (result may alias a)
+ * @param   result Output (SRAM)
+ * @param   a First input (SRAM)
+ * @param   b_P Second input (flash)
+ * @param   n Number of bytes
+ */
+static inline void hdc_kernel_xor_P(uint8_t* result, const uint8_t* a, const uint8_t* b_P,
+                                    hdc_index_t n)
+{
+#if HDC_PGM_SEPARATE
+    hdc_index_t i = 0U;
+
+    for (; (hdc_index_t)(n - i) >= HDC_WORD_BYTES; i += HDC_WORD_BYTES) {
+        hdc_word_store(&result[i], (hdc_word_t)(hdc_word_load(&a[i]) ^ hdc_word_load_P(&b_P[i])));
+    }
+    for (; i < n; i++) {
+        result[i] = (uint8_t)(a[i] ^ hdc_pgm_read_byte(&b_P[i]));
+    }
+#else
+    hdc_kernel_xor(result, a, b_P, n);
+#endif
+}
+
+/* =============================================================================
+ * Fused Encoding Kernel
+ * ========================================================================== */
+
+/*
+ * Generated twice so the basis load is resolved at compile time: from SRAM
+ * (hdc_kernel_encode_word) and from flash (hdc_kernel_encode_word_P).
+ *
+ * name         : kernel function name
+ * LOAD         : whole-word basis load
+ * LOAD_PARTIAL : tail-word basis load
+ */
+#define HDC_KERNEL_DEFINE_ENCODE_WORD(name, LOAD, LOAD_PARTIAL)                      \
+    static inline hdc_word_t name(const hdc_dist_t* levels, uint8_t num_channels,   \
+                                  const hv_t* basis_vectors,                         \
+                                  hdc_index_t offset, uint8_t bytes)                 \
+    {                                                                                \
+        uint16_t first_bit = (uint16_t)((uint16_t)offset * 8U);                      \
+        hdc_word_t acc = 0U;                                                         \
+                                                                                     \
+        for (uint8_t ch = 0U; ch < num_channels; ch++) {                             \
+            hdc_word_t basis = (bytes == HDC_WORD_BYTES)                             \
+                             ? LOAD(&basis_vectors[ch][offset])                      \
+                             : LOAD_PARTIAL(&basis_vectors[ch][offset], bytes);      \
+            acc |= (hdc_word_t)(basis ^ hdc_word_prefix_mask(levels[ch], first_bit)); \
+        }                                                                            \
+        return acc;                                                                  \
+    }
+
+/**
+ * @brief   One word of a bound, bundled multi-channel thermometer encoding
+ * @param   levels Thermometer level per channel
+ * @param   num_channels Number of channels
+ * @param   basis_vectors Basis hypervector per channel
+ * @param   offset Byte offset of the word
+ * @param   bytes Bytes in this word (HDC_WORD_BYTES, or fewer for the tail)
+ * @return  OR over channels of (thermometer(level) XOR basis) at offset
+ *
+ * @details Below a channel's level the bound bits are ~basis, above it they
+ *          are basis, so each channel costs one load, one XOR and one OR.
+ */
+HDC_KERNEL_DEFINE_ENCODE_WORD(hdc_kernel_encode_word, hdc_word_load, hdc_word_load_partial)
+
+/**
+ * @brief   hdc_kernel_encode_word() with the basis vectors in flash
+ */
+HDC_KERNEL_DEFINE_ENCODE_WORD(hdc_kernel_encode_word_P, hdc_word_load_P, hdc_word_load_partial_P)
+
+#endif /* HDC_KERNEL_H */
@@ -0,0 +1,82 @@
+/**
+ * @file    hdc_learn.c
+ * @brief   HDC Online Retraining - Implementation
+ * @version 1.1.0
+ * @note    Mistake-driven updates through the prototype cache
+ */
+
+#include "hdc_learn.h"
+#include "hdc_probe.h"
+#include <stddef.h>
+
+/* =============================================================================
+ * Engine
+ * ========================================================================== */
+
+/**
+ * @brief   Attach an engine to a prototype cache
+ * @param   learn Engine to initialize
+ * @param   cache Initialized cache
+ */
+void hdc_learn_init(hdc_learn_t* learn, hdc_proto_t* cache)
+{
+    learn->cache = cache;
+    learn->updates = 0U;
+    learn->mistakes = 0U;
+}
+
+/**
+ * @brief   Retrain with one labelled sample and the class it was predicted as
+ * @param   learn Engine
+ * @param   sample Encoded sample
+ * @param   label Correct class
+ * @param   predicted Class the current prototypes chose, or HDC_AM_CLASS_NONE
+ * @return  HDC_LEARN_OK, or HDC_LEARN_ERROR_INVALID_CLASS
+ *
+ * @details A counter already saturated towards the sample does not move,
+ *          so its word is not marked and its prototype word is not redone.
+ */
+hdc_learn_status_t hdc_learn_update(hdc_learn_t* learn, const hv_t sample,
+                                    hdc_class_t label, hdc_class_t predicted)
+{
+    hdc_class_t num_classes = learn->cache->num_classes;
+
+    if ((label >= num_classes) ||
+        ((predicted != HDC_AM_CLASS_NONE) && (predicted >= num_classes))) {
+        return HDC_LEARN_ERROR_INVALID_CLASS;
+    }
+    if (predicted == label) {
+        return HDC_LEARN_OK;
+    }
+
+    HDC_PROBE_BEGIN(HDC_PROBE_LEARN_UPDATE);
+    (void)hdc_proto_add(learn->cache, label, sample);
+    if (predicted != HDC_AM_CLASS_NONE) {
+        (void)hdc_proto_sub(learn->cache, predicted, sample);
+        learn->mistakes++;
+    }
+    learn->updates++;
+    HDC_PROBE_END(HDC_PROBE_LEARN_UPDATE);
+
+    return HDC_LEARN_OK;
+}
+
+/**
+ * @brief   Predict with the current prototypes, then retrain
+ * @param   learn Engine
+ * @param   sample Encoded sample
+ * @param   label Correct class
+ * @param   p_predicted Receives the prediction made before the update (may be NULL)
+ * @return  As hdc_learn_update()
+ */
+hdc_learn_status_t hdc_learn_step(hdc_learn_t* learn, const hv_t sample, hdc_class_t label,
+                                  hdc_am_match_t* p_predicted)
+{
+    hdc_am_match_t match;
+
+    (void)hdc_proto_query(learn->cache, sample, &match);
+    if (p_predicted != NULL) {
+        *p_predicted = match;
+    }
+    return hdc_learn_update(learn, sample, label, match.class_id);
+}
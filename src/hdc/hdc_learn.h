@@ -0,0 +1,95 @@
+/**
+ * @file    hdc_learn.h
+ * @brief   HDC Online Retraining - Perceptron-Style Counter Updates
+ * @version 1.1.0
+ * @note    Portable; runs on a caller-owned prototype cache (hdc_proto.h)
+ *
+ * @details Bundling every sample into its labelled class (hdc_counter_add)
+ *          never corrects a class that has drifted onto another class's
+ *          patterns. This engine retrains on mistakes instead:
+ *
+ *            predicted == label   nothing changes
+ *            predicted != label   add the sample to the label's counters,
+ *                                 subtract it from the predicted class's
+ *            no prediction        add the sample to the label's counters
+ *                                 (HDC_AM_CLASS_NONE, e.g. while a class
+ *                                 is still untrained)
+ *
+ *          Repeating this over the stream has the effect of several
+ *          training passes, while each step costs at most two counter
+ *          updates.
+ *
+ *          Counters change through the prototype cache (hdc_proto_add /
+ *          hdc_proto_sub), which only marks the changed words stale and
+ *          unsaved. Predictions come from hdc_proto_query(), which
+ *          re-thresholds those words first, so several updates between two
+ *          queries cost one refresh and a step that changed nothing costs
+ *          none.
+ *
+ *          Worst-case step: two counter passes, plus a refresh of two rows
+ *          and the search when hdc_learn_step() makes the prediction. At
+ *          the default 128 dimensions that is a few hundred bytes of plane
+ *          traffic, well inside one 1 ms scheduler tick on the Uno.
+ */
+
+#ifndef HDC_LEARN_H
+#define HDC_LEARN_H
+
+#include <stdint.h>
+#include "hdc_core.h"
+#include "hdc_am.h"
+#include "hdc_proto.h"
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Learning engine status codes */
+typedef enum {
+    HDC_LEARN_OK = 0,
+    HDC_LEARN_ERROR_INVALID_CLASS
+} hdc_learn_status_t;
+
+/** @brief Retraining engine over a prototype cache */
+typedef struct {
+    hdc_proto_t* cache;         /**< Counters and prototypes (caller-owned) */
+    uint32_t     updates;       /**< Steps that changed a class */
+    uint32_t     mistakes;      /**< Steps with a wrong prediction */
+} hdc_learn_t;
+
+/* =============================================================================
+ * Function Declarations
+ * ========================================================================== */
+
+/**
+ * @brief   Attach an engine to a prototype cache
+ * @param   learn Engine to initialize
+ * @param   cache Initialized cache (hdc_proto_init)
+ */
+void hdc_learn_init(hdc_learn_t* learn, hdc_proto_t* cache);
+
+/**
+ * @brief   Retrain with one labelled sample and the class it was predicted as
+ * @param   learn Engine
+ * @param   sample Encoded sample
+ * @param   label Correct class
+ * @param   predicted Class the current prototypes chose, or HDC_AM_CLASS_NONE
+ * @return  HDC_LEARN_OK, or HDC_LEARN_ERROR_INVALID_CLASS (nothing changed)
+ * @note    Prototypes are not touched; changed words are marked in the cache
+ */
+hdc_learn_status_t hdc_learn_update(hdc_learn_t* learn, const hv_t sample,
+                                    hdc_class_t label, hdc_class_t predicted);
+
+/**
+ * @brief   Predict with the current prototypes, then retrain
+ * @param   learn Engine
+ * @param   sample Encoded sample
+ * @param   label Correct class
+ * @param   p_predicted Receives the prediction made before the update
+ *          (may be NULL)
+ * @return  As hdc_learn_update()
+ */
+hdc_learn_status_t hdc_learn_step(hdc_learn_t* learn, const hv_t sample, hdc_class_t label,
+                                  hdc_am_match_t* p_predicted);
+
+#endif /* HDC_LEARN_H */
@@ -0,0 +1,89 @@
+/**
+ * @file    hdc_pgm.c
+ * @brief   HDC Flash-Resident Operands - Implementation
+ * @version 1.0.0
+ * @note    Basis vectors, item memories and trained models in program memory
+ *
+ * @details Core operations with one operand in flash (_P suffix). Each runs
+ *          the flash operand kernels from hdc_kernel.h, which read it with
+ *          LPM on AVR and are the ordinary RAM kernels on the host.
+ */
+
+#include "hdc_pgm.h"
+#include "hdc_kernel.h"
+
+/* =============================================================================
+ * Core Operations
+ * ========================================================================== */
+
+/**
+ * @brief   Copy a hypervector from flash to SRAM
+ * @param   dest Destination hypervector (SRAM)
+ * @param   src_P Source hypervector (flash)
+ */
+void hdc_copy_P(hv_t dest, const hv_t src_P)
+{
+    hdc_pgm_memcpy(dest, src_P, HV_BYTES);
+}
+
+/**
+ * @brief   XOR (bind) a hypervector with one in flash
+ * @param   result Output hypervector (may alias a)
+ * @param   a SRAM operand
+ * @param   b_P Flash operand
+ */
+void hdc_xor_P(hv_t result, const hv_t a, const hv_t b_P)
+{
+    hdc_kernel_xor_P(result, a, b_P, HV_BYTES);
+}
+
+/**
+ * @brief   Hamming distance to a hypervector in flash
+ * @param   a SRAM operand
+ * @param   b_P Flash operand
+ * @return  Hamming distance (0-HV_DIMENSIONS)
+ */
+hdc_dist_t hdc_hamming_P(const hv_t a, const hv_t b_P)
+{
+    return hdc_kernel_hamming_P(a, b_P, HV_BYTES);
+}
+
+/**
+ * @brief   Hamming distance to a hypervector in flash, early exit above a bound
+ * @param   a SRAM operand
+ * @param   b_P Flash operand
+ * @param   bound Largest distance of interest
+ * @return  Exact distance if it is <= bound, otherwise some value > bound
+ */
+hdc_dist_t hdc_hamming_bounded_P(const hv_t a, const hv_t b_P, hdc_dist_t bound)
+{
+    return hdc_kernel_hamming_bounded_P(a, b_P, HV_BYTES, bound);
+}
+
+/* =============================================================================
+ * Encoding
+ * ========================================================================== */
+
+/**
+ * @brief   Bind a thermometer level with a hypervector in flash
+ * @param   result Output hypervector
+ * @param   level Thermometer level
+ * @param   hv_P Hypervector to bind with (flash), e.g. a channel basis vector
+ */
+void hdc_level_bind_P(hv_t result, hdc_level_t level, const hv_t hv_P)
+{
+    hdc_index_t full_bytes = (hdc_index_t)(level / 8U);
+    uint8_t remaining_bits = (uint8_t)(level % 8U);
+    hdc_index_t i = 0U;
+
+    for (; i < full_bytes; i++) {
+        result[i] = (uint8_t)~hdc_pgm_read_byte(&hv_P[i]);
+    }
+    if (remaining_bits > 0U) {
+        result[i] = (uint8_t)(hdc_pgm_read_byte(&hv_P[i]) ^ ((1U << remaining_bits) - 1U));
+        i++;
+    }
+    for (; i < HV_BYTES; i++) {
+        result[i] = hdc_pgm_read_byte(&hv_P[i]);
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * @file    hdc_pgm.h
+ * @brief   HDC Flash-Resident Operands - Declarations
+ * @version 1.0.0
+ * @note    Basis vectors, item memories and trained models in program memory
+ *
+ * @details The ATmega328P has 2 KB of SRAM but 32 KB of flash. Constant
+ *          hypervectors (channel basis vectors, item memories, deployed class
+ *          prototypes) can stay in flash when declared with HDC_FLASH:
+ *
+ *            static const hv_t s_basis[4] HDC_FLASH = { { 0x3A, ... }, ... };
+ *
+ *          Flash is a separate address space on AVR, so such vectors must only
+ *          be passed as the _P operand of the functions below; they read it
+ *          with LPM (pgm_read_byte) while every other operand stays in SRAM.
+ *          The naming follows avr-libc (memcpy_P, strcmp_P). A flash-resident
+ *          associative memory is set up with hdc_am_init_flash() (hdc_am.h).
+ *
+ *          On the host flash and RAM share one address space: HDC_FLASH is
+ *          empty and the _P functions run the ordinary kernels, so native
+ *          tests exercise the same calls the firmware makes.
+ *
+ *          The core operations are implemented in hdc_pgm.c; the encoders
+ *          share the block loop in hdc_encode.c.
+ */
+
+#ifndef HDC_PGM_H
+#define HDC_PGM_H
+
+#include <stdint.h>
+#include <string.h>
+#include "hdc_core.h"
+#include "hdc_encode.h"
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#endif
+
+/* =============================================================================
+ * Address Space
+ * ========================================================================== */
+
+#if defined(__AVR__)
+    /** @brief Place a const object in program memory */
+    #define HDC_FLASH               PROGMEM
+
+    /** @brief 1 when flash needs its own load instructions (Harvard AVR) */
+    #define HDC_PGM_SEPARATE        1
+
+    /** @brief Read one byte from a flash address */
+    #define hdc_pgm_read_byte(p)    pgm_read_byte(p)
+
+    /** @brief Copy n bytes from flash to SRAM */
+    #define hdc_pgm_memcpy(dst, src_P, n)   memcpy_P((dst), (src_P), (n))
+#else
+    #define HDC_FLASH
+    #define HDC_PGM_SEPARATE        0
+    #define hdc_pgm_read_byte(p)    (*(const uint8_t*)(p))
+    #define hdc_pgm_memcpy(dst, src_P, n)   memcpy((dst), (src_P), (n))
+#endif
+
+/* =============================================================================
+ * Function Declarations - Core Operations
+ * ========================================================================== */
+
+/**
+ * @brief   Copy a hypervector from flash to SRAM
+ * @param   dest Destination hypervector (SRAM)
+ * @param   src_P Source hypervector (flash)
+ */
+void hdc_copy_P(hv_t dest, const hv_t src_P);
+
+/**
+ * @brief   XOR (bind) a hypervector with one in flash
+ * @param   result Output hypervector (may alias a)
+ * @param   a SRAM operand
+ * @param   b_P Flash operand
+ */
+void hdc_xor_P(hv_t result, const hv_t a, const hv_t b_P);
+
+/**
+ * @brief   Hamming distance to a hypervector in flash
+ * @param   a SRAM operand
+ * @param   b_P Flash operand
+ * @return  Hamming distance (0-HV_DIMENSIONS)
+ */
+hdc_dist_t hdc_hamming_P(const hv_t a, const hv_t b_P);
+
+/**
+ * @brief   Hamming distance to a hypervector in flash, early exit above a bound
+ * @param   a SRAM operand
+ * @param   b_P Flash operand
+ * @param   bound Largest distance of interest
+ * @return  Exact distance if it is <= bound, otherwise some value > bound
+ */
+hdc_dist_t hdc_hamming_bounded_P(const hv_t a, const hv_t b_P, hdc_dist_t bound);
+
+/* =============================================================================
+ * Function Declarations - Encoding
+ * ========================================================================== */
+
+/**
+ * @brief   Bind a thermometer level with a hypervector in flash
+ * @param   result Output hypervector
+ * @param   level Thermometer level
+ * @param   hv_P Hypervector to bind with (flash), e.g. a channel basis vector
+ */
+void hdc_level_bind_P(hv_t result, hdc_level_t level, const hv_t hv_P);
+
+/**
+ * @brief   hdc_encode_multi_channel() with the basis vectors in flash
+ * @param   result Output combined hypervector
+ * @param   values Array of sensor values
+ * @param   num_channels Number of channels to encode
+ * @param   basis_vectors_P Array of basis vectors for each channel (flash)
+ */
+void hdc_encode_multi_channel_P(
+    hv_t result,
+    const uint16_t* values,
+    uint8_t num_channels,
+    const hv_t* basis_vectors_P);
+
+/**
+ * @brief   hdc_encode_levels() with the basis vectors in flash
+ * @param   result Output combined hypervector
+ * @param   levels Thermometer level per channel
+ * @param   num_channels Number of channels to encode
+ * @param   basis_vectors_P Array of basis vectors for each channel (flash)
+ */
+void hdc_encode_levels_P(
+    hv_t result,
+    const hdc_level_t* levels,
+    uint8_t num_channels,
+    const hv_t* basis_vectors_P);
+
+#endif /* HDC_PGM_H */
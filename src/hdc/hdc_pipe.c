@@ -0,0 +1,255 @@
+/**
+ * @file    hdc_pipe.c
+ * @brief   HDC Sample Pipeline - Implementation
+ * @version 1.0.0
+ * @note    Each stage reads the cursor of the stage before it once, works on
+ *          the slots behind it, then publishes its own cursor
+ */
+
+#include "hdc_pipe.h"
+#include "hdc_item.h"
+#include <stddef.h>
+
+/* =============================================================================
+ * Private Helpers
+ * ========================================================================== */
+
+/**
+ * @brief   Windows one stage may take, capped at the batch size
+ * @param   pipe Pipeline
+ * @param   ahead Cursor of the stage before
+ * @param   own Cursor of the stage
+ * @return  Windows to process
+ */
+static inline uint8_t pipe_take(const hdc_pipe_t* pipe, uint8_t ahead, uint8_t own)
+{
+    uint8_t ready = (uint8_t)(ahead - own);
+    return (ready < pipe->config.batch) ? ready : pipe->config.batch;
+}
+
+/**
+ * @brief   Mark a run of slots unclassified
+ * @param   matches First result of the run
+ * @param   n Slots in the run
+ */
+static void pipe_unclassified(hdc_am_match_t* matches, uint8_t n)
+{
+    for (uint8_t q = 0U; q < n; q++) {
+        matches[q].class_id = HDC_AM_CLASS_NONE;
+        matches[q].distance = (hdc_dist_t)HV_DIMENSIONS;
+    }
+}
+
+/**
+ * @brief   Classify a run of contiguous slots
+ * @param   pipe Pipeline
+ * @param   am Associative memory, or NULL
+ * @param   first Slot index of the run
+ * @param   n Slots in the run
+ */
+static void pipe_classify_run(hdc_pipe_t* pipe, const hdc_am_t* am, uint8_t first, uint8_t n)
+{
+    const hv_t* queries = (const hv_t*)&pipe->config.queries[first];
+    hdc_am_match_t* matches = &pipe->config.matches[first];
+
+    if ((n == 0U) ||
+        ((am != NULL) && (hdc_am_query_batch(am, queries, n, matches, 1U) != 0U))) {
+        return;
+    }
+    pipe_unclassified(matches, n);
+}
+
+/* =============================================================================
+ * Setup
+ * ========================================================================== */
+
+/**
+ * @brief   Initialize an empty pipeline
+ * @param   pipe Pipeline to initialize
+ * @param   config Storage and parameters (copied)
+ * @return  HDC_PIPE_OK, or HDC_PIPE_ERROR_INVALID
+ */
+hdc_pipe_status_t hdc_pipe_init(hdc_pipe_t* pipe, const hdc_pipe_config_t* config)
+{
+    uint8_t depth = config->depth;
+
+    if ((config->values == NULL) || (config->queries == NULL) || (config->matches == NULL) ||
+        (config->tags == NULL) || (config->level == NULL)) {
+        return HDC_PIPE_ERROR_INVALID;
+    }
+    if ((depth == 0U) || (depth > HDC_PIPE_MAX_DEPTH) || ((depth & (depth - 1U)) != 0U) ||
+        (config->batch == 0U) || (config->batch > depth) ||
+        (config->num_channels == 0U) || (config->num_channels > HDC_PIPE_MAX_CHANNELS) ||
+        (config->window == 0U)) {
+        return HDC_PIPE_ERROR_INVALID;
+    }
+
+    pipe->config = *config;
+    for (uint8_t ch = 0U; ch < HDC_PIPE_MAX_CHANNELS; ch++) {
+        pipe->sum[ch] = 0U;
+    }
+    pipe->samples = 0U;
+    pipe->mask = (uint8_t)(depth - 1U);
+    pipe->head = 0U;
+    pipe->encoded = 0U;
+    pipe->classified = 0U;
+    pipe->tail = 0U;
+    pipe->dropped = 0U;
+    return HDC_PIPE_OK;
+}
+
+/* =============================================================================
+ * Stages
+ * ========================================================================== */
+
+/**
+ * @brief   Sample stage: add one sample to the open window
+ * @param   pipe Pipeline
+ * @param   values Sample, at least num_channels values
+ * @param   count Values available
+ * @param   tag Caller tag stored with the window this sample closes
+ * @return  HDC_PIPE_OK, HDC_PIPE_ERROR_CHANNELS or HDC_PIPE_ERROR_FULL
+ */
+hdc_pipe_status_t hdc_pipe_put(hdc_pipe_t* pipe, const uint16_t* values, uint8_t count,
+                               uint8_t tag)
+{
+    const uint8_t num_channels = pipe->config.num_channels;
+
+    if (count < num_channels) {
+        return HDC_PIPE_ERROR_CHANNELS;
+    }
+
+    for (uint8_t ch = 0U; ch < num_channels; ch++) {
+        pipe->sum[ch] += values[ch];
+    }
+    pipe->samples++;
+    if (pipe->samples < pipe->config.window) {
+        return HDC_PIPE_OK;
+    }
+
+    /* Window closed: queue its averages if a slot is free */
+    uint8_t head = pipe->head;
+    bool full = ((uint8_t)(head - hdc_sync_load(&pipe->tail)) >= pipe->config.depth);
+    uint16_t* slot = &pipe->config.values[(uint16_t)(head & pipe->mask) * num_channels];
+
+    for (uint8_t ch = 0U; ch < num_channels; ch++) {
+        if (!full) {
+            slot[ch] = (uint16_t)(pipe->sum[ch] / pipe->samples);
+        }
+        pipe->sum[ch] = 0U;
+    }
+    pipe->samples = 0U;
+
+    if (full) {
+        if (pipe->dropped != 0xFFFFU) {
+            pipe->dropped++;
+        }
+        return HDC_PIPE_ERROR_FULL;
+    }
+    pipe->config.tags[head & pipe->mask] = tag;
+    hdc_sync_store(&pipe->head, (uint8_t)(head + 1U));
+    return HDC_PIPE_OK;
+}
+
+/**
+ * @brief   Encode stage: build the query hypervectors of up to batch
+ *          sampled windows
+ * @param   pipe Pipeline
+ * @return  Windows encoded
+ */
+uint8_t hdc_pipe_encode(hdc_pipe_t* pipe)
+{
+    hdc_level_t levels[HDC_PIPE_MAX_CHANNELS];
+    const uint8_t num_channels = pipe->config.num_channels;
+    uint8_t encoded = pipe->encoded;
+    uint8_t n = pipe_take(pipe, hdc_sync_load(&pipe->head), encoded);
+
+    for (uint8_t q = 0U; q < n; q++) {
+        uint8_t index = (uint8_t)((encoded + q) & pipe->mask);
+        const uint16_t* slot = &pipe->config.values[(uint16_t)index * num_channels];
+
+        for (uint8_t ch = 0U; ch < num_channels; ch++) {
+            levels[ch] = pipe->config.level(slot[ch]);
+        }
+        hdc_encode_levels_seeded(pipe->config.queries[index], levels, num_channels,
+                                 pipe->config.item_seed);
+    }
+    hdc_sync_store(&pipe->encoded, (uint8_t)(encoded + n));
+    return n;
+}
+
+/**
+ * @brief   Classify stage: nearest class of up to batch encoded windows
+ * @param   pipe Pipeline
+ * @param   am Associative memory, or NULL to pass the windows on unclassified
+ * @return  Windows classified
+ */
+uint8_t hdc_pipe_classify(hdc_pipe_t* pipe, const hdc_am_t* am)
+{
+    uint8_t classified = pipe->classified;
+    uint8_t n = pipe_take(pipe, hdc_sync_load(&pipe->encoded), classified);
+    uint8_t first = (uint8_t)(classified & pipe->mask);
+    uint8_t run = (uint8_t)(pipe->config.depth - first);
+
+    if (run > n) {
+        run = n;
+    }
+
+    /* Query rows are contiguous up to the end of the ring */
+    pipe_classify_run(pipe, am, first, run);
+    pipe_classify_run(pipe, am, 0U, (uint8_t)(n - run));
+    hdc_sync_store(&pipe->classified, (uint8_t)(classified + n));
+    return n;
+}
+
+/**
+ * @brief   Result stage: oldest classified window
+ * @param   pipe Pipeline
+ * @param   p_result Receives the window
+ * @return  true if a window was waiting
+ */
+bool hdc_pipe_peek(const hdc_pipe_t* pipe, hdc_pipe_result_t* p_result)
+{
+    uint8_t tail = pipe->tail;
+
+    if (hdc_sync_load(&pipe->classified) == tail) {
+        return false;
+    }
+
+    uint8_t index = (uint8_t)(tail & pipe->mask);
+    p_result->values = &pipe->config.values[(uint16_t)index * pipe->config.num_channels];
+    p_result->query = pipe->config.queries[index];
+    p_result->match = pipe->config.matches[index];
+    p_result->tag = pipe->config.tags[index];
+    return true;
+}
+
+/**
+ * @brief   Result stage: hand the oldest classified window's slot back
+ * @param   pipe Pipeline
+ * @return  true if a window was released
+ */
+bool hdc_pipe_release(hdc_pipe_t* pipe)
+{
+    uint8_t tail = pipe->tail;
+
+    if (hdc_sync_load(&pipe->classified) == tail) {
+        return false;
+    }
+    hdc_sync_store(&pipe->tail, (uint8_t)(tail + 1U));
+    return true;
+}
+
+/* =============================================================================
+ * Status
+ * ========================================================================== */
+
+/**
+ * @brief   Windows queued in any stage
+ * @param   pipe Pipeline
+ * @return  0 to depth
+ */
+uint8_t hdc_pipe_pending(const hdc_pipe_t* pipe)
+{
+    return (uint8_t)(pipe->head - pipe->tail);
+}
@@ -0,0 +1,187 @@
+/**
+ * @file    hdc_pipe.h
+ * @brief   HDC Sample Pipeline - Batched Sample / Encode / Classify Stages
+ * @version 1.0.0
+ * @note    Portable; all storage is caller-owned. The sample stage may run
+ *          in an ISR.
+ *
+ * @details A window moves through four stages, each run by its own caller.
+ *          They share one ring of depth slots, and each slot holds a
+ *          window's values, its query hypervector and its match:
+ *
+ *            Stage     Call                 Cursor      Consumes
+ *            sample    hdc_pipe_put()       head        free slots
+ *            encode    hdc_pipe_encode()    encoded     sampled windows
+ *            classify  hdc_pipe_classify()  classified  encoded windows
+ *            result    hdc_pipe_peek()      tail        classified windows
+ *                      hdc_pipe_release()
+ *
+ *          The queue of a stage is the part of the ring between its own cursor
+ *          and the cursor of the stage before it. A slot changes hands only
+ *          when a cursor passes it, and nothing is copied. Every cursor is
+ *          written by one stage only and is a single byte. No interrupt
+ *          masking is needed on the ATmega328P, so one stage can preempt
+ *          another. Cursors are published with hdc_sync_store() and read
+ *          with hdc_sync_load() (hdc_sync.h), so on a host the stages may
+ *          also run on different threads.
+ *
+ *          The encode and classify stages take up to batch windows per call.
+ *          Classification uses hdc_am_query_batch() over the ring's
+ *          contiguous query rows. The run is split in two where the ring
+ *          wraps. Each stage only waits for the stage before it, so a
+ *          steady stream runs at the rate of the slowest stage, not the
+ *          sum of all of them.
+ *
+ *          Back-pressure comes from the result stage. Once depth windows
+ *          are waiting anywhere in the ring, the sample stage cannot close
+ *          a window. It discards the window and counts it in dropped. The
+ *          sampler never waits, and no window is overwritten after it was
+ *          queued.
+ */
+
+#ifndef HDC_PIPE_H
+#define HDC_PIPE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hdc_core.h"
+#include "hdc_encode.h"
+#include "hdc_am.h"
+#include "hdc_sync.h"
+
+/** @brief Channels per window */
+#define HDC_PIPE_MAX_CHANNELS   8U
+
+/** @brief Largest ring depth (slots); hdc_pipe_init() wants a power of two */
+#define HDC_PIPE_MAX_DEPTH      128U
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Pipeline status codes */
+typedef enum {
+    HDC_PIPE_OK = 0,
+    HDC_PIPE_ERROR_INVALID,     /**< Bad configuration */
+    HDC_PIPE_ERROR_FULL,        /**< Window discarded: every slot is in use */
+    HDC_PIPE_ERROR_CHANNELS     /**< Fewer values than num_channels */
+} hdc_pipe_status_t;
+
+/** @brief Thermometer level of a window average (e.g. HDC_ENCODE_DEFINE_LEVEL) */
+typedef hdc_level_t (*hdc_pipe_level_fn)(uint16_t value);
+
+/** @brief Storage and stage parameters */
+typedef struct {
+    uint16_t*          values;      /**< depth x num_channels window averages */
+    hv_t*              queries;     /**< depth query hypervectors */
+    hdc_am_match_t*    matches;     /**< depth results */
+    uint8_t*           tags;        /**< depth caller tags (e.g. the label) */
+    hdc_pipe_level_fn  level;       /**< Level of an average */
+    uint32_t           item_seed;   /**< Basis vectors: hdc_encode_levels_seeded() */
+    uint8_t            depth;       /**< Slots, power of two up to HDC_PIPE_MAX_DEPTH */
+    uint8_t            batch;       /**< Windows per encode and classify call (1..depth) */
+    uint8_t            num_channels; /**< 1..HDC_PIPE_MAX_CHANNELS */
+    uint8_t            window;      /**< Samples averaged into one window (>= 1) */
+} hdc_pipe_config_t;
+
+/** @brief A classified window, valid until hdc_pipe_release() */
+typedef struct {
+    const uint16_t*    values;      /**< num_channels window averages */
+    const uint8_t*     query;       /**< Query hypervector */
+    hdc_am_match_t     match;       /**< HDC_AM_CLASS_NONE if not classified */
+    uint8_t            tag;         /**< Tag of the window's last sample */
+} hdc_pipe_result_t;
+
+/** @brief Pipeline state */
+typedef struct {
+    hdc_pipe_config_t  config;
+    uint32_t           sum[HDC_PIPE_MAX_CHANNELS]; /**< Open window (sample stage only) */
+    uint8_t            samples;     /**< Samples in the open window (sample stage only) */
+    uint8_t            mask;        /**< depth - 1 */
+    volatile uint8_t   head;        /**< Windows sampled (sample stage only) */
+    volatile uint8_t   encoded;     /**< Windows encoded (encode stage only) */
+    volatile uint8_t   classified;  /**< Windows classified (classify stage only) */
+    volatile uint8_t   tail;        /**< Windows released (result stage only) */
+    uint16_t           dropped;     /**< Windows discarded, saturating (sample stage only) */
+} hdc_pipe_t;
+
+/* =============================================================================
+ * Function Declarations - Setup
+ * ========================================================================== */
+
+/**
+ * @brief   Initialize an empty pipeline
+ * @param   pipe Pipeline to initialize
+ * @param   config Storage and parameters (copied; the storage is kept by
+ *          reference)
+ * @return  HDC_PIPE_OK, or HDC_PIPE_ERROR_INVALID
+ * @pre     No stage may be running
+ */
+hdc_pipe_status_t hdc_pipe_init(hdc_pipe_t* pipe, const hdc_pipe_config_t* config);
+
+/* =============================================================================
+ * Function Declarations - Stages
+ * ========================================================================== */
+
+/**
+ * @brief   Sample stage: add one sample to the open window
+ * @param   pipe Pipeline
+ * @param   values Sample, at least num_channels values in channel order
+ * @param   count Values available
+ * @param   tag Caller tag stored with the window this sample closes
+ * @return  HDC_PIPE_OK, HDC_PIPE_ERROR_CHANNELS (sample ignored), or
+ *          HDC_PIPE_ERROR_FULL (window closed but discarded)
+ * @note    Never blocks. The averages use one divide per channel per window.
+ */
+hdc_pipe_status_t hdc_pipe_put(hdc_pipe_t* pipe, const uint16_t* values, uint8_t count,
+                               uint8_t tag);
+
+/**
+ * @brief   Encode stage: build the query hypervectors of up to batch
+ *          sampled windows
+ * @param   pipe Pipeline
+ * @return  Windows encoded
+ */
+uint8_t hdc_pipe_encode(hdc_pipe_t* pipe);
+
+/**
+ * @brief   Classify stage: nearest class of up to batch encoded windows
+ * @param   pipe Pipeline
+ * @param   am Associative memory, or NULL to pass the windows on
+ *          unclassified (e.g. while the model is incomplete)
+ * @return  Windows classified
+ * @note    The rows are read as they are. Bring cached prototypes up to
+ *          date first (hdc_proto_refresh()).
+ */
+uint8_t hdc_pipe_classify(hdc_pipe_t* pipe, const hdc_am_t* am);
+
+/**
+ * @brief   Result stage: oldest classified window
+ * @param   pipe Pipeline
+ * @param   p_result Receives the window
+ * @return  true if a window was waiting
+ * @note    The window stays queued (and its slot in use) until
+ *          hdc_pipe_release()
+ */
+bool hdc_pipe_peek(const hdc_pipe_t* pipe, hdc_pipe_result_t* p_result);
+
+/**
+ * @brief   Result stage: hand the oldest classified window's slot back to
+ *          the sample stage
+ * @param   pipe Pipeline
+ * @return  true if a window was released
+ */
+bool hdc_pipe_release(hdc_pipe_t* pipe);
+
+/* =============================================================================
+ * Function Declarations - Status
+ * ========================================================================== */
+
+/**
+ * @brief   Windows queued in any stage (safe from any stage)
+ * @param   pipe Pipeline
+ * @return  0 to depth
+ */
+uint8_t hdc_pipe_pending(const hdc_pipe_t* pipe);
+
+#endif /* HDC_PIPE_H */
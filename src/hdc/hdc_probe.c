@@ -0,0 +1,188 @@
+/**
+ * @file    hdc_probe.c
+ * @brief   HDC Probes - Implementation
+ * @version 1.0.0
+ * @note    Empty unless built with -DHDC_PROFILE or -DHDC_PROBE_CLOCK
+ */
+
+#if (defined(HDC_PROFILE) || defined(HDC_PROBE_CLOCK)) && !defined(__AVR__)
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#endif
+
+#include "hdc_probe.h"
+
+#if HDC_PROBE_CLOCK_ENABLED
+
+#include <stddef.h>
+
+#if defined(__AVR__)
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#endif
+
+/** @brief Empty BEGIN/END pairs timed by the calibration */
+#define PROBE_CALIBRATION_RUNS  8U
+
+/* =============================================================================
+ * Private State
+ * ========================================================================== */
+
+#if HDC_PROBE_ENABLED
+static hdc_probe_stats_t s_stats[HDC_PROBE_COUNT];
+#endif
+static hdc_probe_ticks_t s_overhead;
+
+#if defined(__AVR__)
+static volatile uint16_t s_overflows;
+
+/* =============================================================================
+ * Interrupt Service Routine
+ * ========================================================================== */
+
+/**
+ * @brief   Timer1 overflow: upper 16 bits of the cycle counter
+ */
+ISR(TIMER1_OVF_vect)
+{
+    s_overflows++;
+}
+#endif
+
+/* =============================================================================
+ * Time Base
+ * ========================================================================== */
+
+/**
+ * @brief   Current timestamp
+ * @return  Free-running tick count
+ */
+hdc_probe_ticks_t hdc_probe_now(void)
+{
+#if defined(__AVR__)
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t low = TCNT1;
+    uint16_t high = s_overflows;
+
+    /* Overflowed after cli() but before the TCNT1 read: ISR still pending */
+    if (((TIFR1 & (1U << TOV1)) != 0U) && (low < 0x8000U)) {
+        high++;
+    }
+    SREG = sreg;
+    return ((hdc_probe_ticks_t)high << 16) | low;
+#else
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (hdc_probe_ticks_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+#endif
+}
+
+/* =============================================================================
+ * Probe API
+ * ========================================================================== */
+
+/**
+ * @brief   Start the time base, calibrate the probe overhead, clear all stats
+ */
+void hdc_probe_init(void)
+{
+#if defined(__AVR__)
+    TCCR1A = 0U;                                    /* Normal mode, TOP = 0xFFFF */
+    TCCR1B = (1U << CS10);                          /* clk / 1 */
+    TCNT1 = 0U;
+    s_overflows = 0U;
+    TIFR1 = (1U << TOV1);
+    TIMSK1 = (1U << TOIE1);
+#endif
+
+    /* The smallest empty BEGIN/END pair is the fixed cost of a probe */
+    s_overhead = 0U;
+    hdc_probe_ticks_t best = 0U;
+    for (uint8_t i = 0U; i < PROBE_CALIBRATION_RUNS; i++) {
+        hdc_probe_ticks_t start = hdc_probe_now();
+        hdc_probe_ticks_t elapsed = (hdc_probe_ticks_t)(hdc_probe_now() - start);
+        if ((i == 0U) || (elapsed < best)) {
+            best = elapsed;
+        }
+    }
+    s_overhead = best;
+
+#if HDC_PROBE_ENABLED
+    hdc_probe_reset();
+#endif
+}
+
+/**
+ * @brief   Cost of two back-to-back hdc_probe_now() calls
+ * @return  Calibrated overhead, subtracted from every probe sample
+ */
+hdc_probe_ticks_t hdc_probe_overhead(void)
+{
+    return s_overhead;
+}
+
+#if HDC_PROBE_ENABLED
+
+/**
+ * @brief   Clear all statistics (keeps the calibration)
+ */
+void hdc_probe_reset(void)
+{
+    for (uint8_t i = 0U; i < (uint8_t)HDC_PROBE_COUNT; i++) {
+        s_stats[i].count = 0U;
+        s_stats[i].min = 0U;
+        s_stats[i].max = 0U;
+        s_stats[i].total = 0U;
+    }
+}
+
+/**
+ * @brief   Add one sample to a probe
+ * @param   id Probe
+ * @param   elapsed Raw duration (the calibrated overhead is subtracted)
+ */
+void hdc_probe_record(hdc_probe_id_t id, hdc_probe_ticks_t elapsed)
+{
+    if ((uint8_t)id >= (uint8_t)HDC_PROBE_COUNT) {
+        return;
+    }
+
+    hdc_probe_stats_t* stats = &s_stats[id];
+    elapsed = (elapsed > s_overhead) ? (hdc_probe_ticks_t)(elapsed - s_overhead) : 0U;
+
+    if ((stats->count == 0U) || (elapsed < stats->min)) {
+        stats->min = elapsed;
+    }
+    if (elapsed > stats->max) {
+        stats->max = elapsed;
+    }
+    if (stats->count != 0xFFFFFFFFUL) {
+        stats->count++;
+        stats->total += elapsed;
+    }
+}
+
+/**
+ * @brief   Statistics of one probe
+ * @param   id Probe
+ * @return  Accumulated statistics (valid until the next record or reset)
+ */
+const hdc_probe_stats_t* hdc_probe_get(hdc_probe_id_t id)
+{
+    return ((uint8_t)id < (uint8_t)HDC_PROBE_COUNT) ? &s_stats[id] : NULL;
+}
+
+/**
+ * @brief   Mean sample duration
+ * @param   stats Probe statistics
+ * @return  total / count, or 0 for an unused probe
+ */
+hdc_probe_ticks_t hdc_probe_mean(const hdc_probe_stats_t* stats)
+{
+    return (stats->count == 0U) ? 0U : (hdc_probe_ticks_t)(stats->total / stats->count);
+}
+
+#endif /* HDC_PROBE_ENABLED */
+
+#endif /* HDC_PROBE_CLOCK_ENABLED */
@@ -0,0 +1,145 @@
+/**
+ * @file    hdc_probe.h
+ * @brief   HDC Probes - Optional Cycle-Count Instrumentation
+ * @version 1.0.0
+ * @note    Enabled with -DHDC_PROFILE; otherwise the probes compile to nothing.
+ *          -DHDC_PROBE_CLOCK provides only the time base (benchmarks), so
+ *          the timed code carries no probe bookkeeping.
+ *
+ * @details A probe brackets a hot path with HDC_PROBE_BEGIN(id) and
+ *          HDC_PROBE_END(id) in the same scope and accumulates count, min,
+ *          max and total of the elapsed time:
+ *
+ *          - AVR:    CPU cycles from Timer1 (clk/1) extended to 32 bits by
+ *                    the overflow interrupt (62.5 ns resolution at 16 MHz)
+ *          - native: nanoseconds from CLOCK_MONOTONIC
+ *
+ *          hdc_probe_init() measures the cost of an empty BEGIN/END pair and
+ *          subtracts it from every sample. A probe that encloses another
+ *          probe also counts the inner probe's bookkeeping.
+ *
+ *          Statistics are read with hdc_probe_get() and sent to the host as
+ *          HDC_TLM_PROBE telemetry records (hdc_tlm_add_probe()). Probe
+ *          records are not reentrant: do not place probes in ISRs.
+ */
+
+#ifndef HDC_PROBE_H
+#define HDC_PROBE_H
+
+#include <stdint.h>
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/**
+ * @brief   Probe identifiers
+ * @note    scripts/telemetry_decode.py names probes in this order
+ */
+typedef enum {
+    HDC_PROBE_HAMMING = 0,      /**< hdc_hamming() */
+    HDC_PROBE_PERMUTE,          /**< hdc_permute() */
+    HDC_PROBE_ENCODE_MULTI,     /**< hdc_encode_multi_channel() */
+    HDC_PROBE_ENCODE_LEVELS,    /**< hdc_encode_levels() */
+    HDC_PROBE_COUNTER_ADD,      /**< hdc_counter_add() */
+    HDC_PROBE_AM_QUERY,         /**< hdc_am_query() */
+    HDC_PROBE_AM_QUERY_LEVELS,  /**< hdc_am_query_levels() */
+    HDC_PROBE_LEARN_UPDATE,     /**< hdc_learn_update() */
+    HDC_PROBE_PROTO_REFRESH,    /**< hdc_proto_refresh(), hdc_proto_get() */
+    HDC_PROBE_ADC_SAMPLE,       /**< Application: ADC reads for one sample tick */
+    HDC_PROBE_TLM_REPORT,       /**< Application: telemetry framing and queueing */
+    HDC_PROBE_COUNT
+} hdc_probe_id_t;
+
+/** @brief Timestamp / duration (AVR cycles or native nanoseconds) */
+typedef uint32_t hdc_probe_ticks_t;
+
+/** @brief Accumulated statistics of one probe */
+typedef struct {
+    uint32_t count;             /**< Samples recorded */
+    hdc_probe_ticks_t min;      /**< Shortest sample (valid if count > 0) */
+    hdc_probe_ticks_t max;      /**< Longest sample */
+    uint64_t total;             /**< Sum of all samples */
+} hdc_probe_stats_t;
+
+/* =============================================================================
+ * Function Declarations
+ * ========================================================================== */
+
+#if defined(HDC_PROFILE) || defined(HDC_PROBE_CLOCK)
+
+/** @brief Time base is compiled in */
+#define HDC_PROBE_CLOCK_ENABLED 1
+
+/**
+ * @brief   Start the time base, calibrate the probe overhead, clear all stats
+ * @note    AVR: takes over Timer1; global interrupts must be enabled
+ */
+void hdc_probe_init(void);
+
+/**
+ * @brief   Current timestamp
+ * @return  Free-running tick count
+ */
+hdc_probe_ticks_t hdc_probe_now(void);
+
+/**
+ * @brief   Cost of two back-to-back hdc_probe_now() calls
+ * @return  Calibrated overhead, subtracted from every probe sample
+ */
+hdc_probe_ticks_t hdc_probe_overhead(void);
+
+#else
+
+#define HDC_PROBE_CLOCK_ENABLED 0
+
+#endif /* HDC_PROFILE || HDC_PROBE_CLOCK */
+
+#if defined(HDC_PROFILE)
+
+/** @brief Probes are compiled in */
+#define HDC_PROBE_ENABLED   1
+
+/**
+ * @brief   Clear all statistics (keeps the calibration)
+ */
+void hdc_probe_reset(void);
+
+/**
+ * @brief   Add one sample to a probe
+ * @param   id Probe
+ * @param   elapsed Raw duration (the calibrated overhead is subtracted)
+ */
+void hdc_probe_record(hdc_probe_id_t id, hdc_probe_ticks_t elapsed);
+
+/**
+ * @brief   Statistics of one probe
+ * @param   id Probe
+ * @return  Accumulated statistics (valid until the next record or reset)
+ */
+const hdc_probe_stats_t* hdc_probe_get(hdc_probe_id_t id);
+
+/**
+ * @brief   Mean sample duration
+ * @param   stats Probe statistics
+ * @return  total / count, or 0 for an unused probe
+ */
+hdc_probe_ticks_t hdc_probe_mean(const hdc_probe_stats_t* stats);
+
+/** @brief Start timing id (declares the start timestamp in the current scope) */
+#define HDC_PROBE_BEGIN(id) \
+    const hdc_probe_ticks_t hdc_probe_start_##id = hdc_probe_now()
+
+/** @brief Stop timing id and record the sample */
+#define HDC_PROBE_END(id) \
+    hdc_probe_record((id), (hdc_probe_ticks_t)(hdc_probe_now() - hdc_probe_start_##id))
+
+#else
+
+#define HDC_PROBE_ENABLED   0
+#define HDC_PROBE_BEGIN(id) ((void)0)
+#define HDC_PROBE_END(id)   ((void)0)
+
+#endif /* HDC_PROFILE */
+
+#endif /* HDC_PROBE_H */
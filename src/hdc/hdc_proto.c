@@ -0,0 +1,306 @@
+/**
+ * @file    hdc_proto.c
+ * @brief   HDC Prototype Cache - Implementation
+ * @version 1.0.0
+ * @note    Tracked counter updates, masked re-threshold on read
+ *
+ * @details A class whose masks are all zero is passed over after
+ *          HDC_COUNTER_MASK_BYTES byte tests, so classes that were not
+ *          updated cost almost nothing to refresh or persist.
+ */
+
+#include "hdc_proto.h"
+#include "hdc_probe.h"
+#include <stddef.h>
+#include <string.h>
+
+/* =============================================================================
+ * Private Helpers
+ * ========================================================================== */
+
+/**
+ * @brief   Check a word mask for any set position
+ * @param   mask Word mask
+ * @return  true if at least one word position is marked
+ */
+static bool proto_mask_any(const hdc_counter_mask_t mask)
+{
+    for (hdc_index_t b = 0U; b < HDC_COUNTER_MASK_BYTES; b++) {
+        if (mask[b] != 0U) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief   Check one word position of a mask
+ * @param   mask Word mask
+ * @param   w Word position
+ * @return  true if marked
+ */
+static inline bool proto_mask_has(const hdc_counter_mask_t mask, uint16_t w)
+{
+    return (mask[w / 8U] & (uint8_t)(1U << (w % 8U))) != 0U;
+}
+
+/**
+ * @brief   Record the words one update changed in both masks of a class
+ * @param   cache Cache
+ * @param   class_id Class (valid)
+ * @param   changed Words the update changed
+ */
+static void proto_mark(hdc_proto_t* cache, hdc_class_t class_id,
+                       const hdc_counter_mask_t changed)
+{
+    for (hdc_index_t b = 0U; b < HDC_COUNTER_MASK_BYTES; b++) {
+        cache->stale[class_id][b] |= changed[b];
+        cache->unsaved[class_id][b] |= changed[b];
+    }
+}
+
+/**
+ * @brief   Re-threshold the stale words of one class
+ * @param   cache Cache
+ * @param   class_id Class (valid)
+ * @return  true if the class had stale words
+ */
+static bool proto_refresh_class(hdc_proto_t* cache, hdc_class_t class_id)
+{
+    if (!proto_mask_any(cache->stale[class_id])) {
+        return false;
+    }
+
+    /* The rows are writable: hdc_proto_init() refused read-only memories */
+    hdc_counter_threshold_masked(cache->am->classes[class_id], &cache->counters[class_id],
+                                 cache->tiebreak, cache->stale[class_id]);
+    memset(cache->stale[class_id], 0, sizeof(hdc_counter_mask_t));
+    return true;
+}
+
+/* =============================================================================
+ * Management
+ * ========================================================================== */
+
+/**
+ * @brief   Attach a cache to a memory and its counters
+ * @param   cache Cache to initialize
+ * @param   am Writable memory whose rows hold the prototypes
+ * @param   counters am->count counter bundles
+ * @param   stale am->count masks (all set here)
+ * @param   unsaved am->count masks (cleared here)
+ * @param   tiebreak Tie-break hypervector, or NULL for 0
+ * @return  HDC_PROTO_OK, or HDC_PROTO_ERROR_READ_ONLY
+ */
+hdc_proto_status_t hdc_proto_init(hdc_proto_t* cache, hdc_am_t* am, hdc_counter_t* counters,
+                                  hdc_counter_mask_t* stale, hdc_counter_mask_t* unsaved,
+                                  const hv_t tiebreak)
+{
+    cache->am = am;
+    cache->counters = counters;
+    cache->stale = stale;
+    cache->unsaved = unsaved;
+    cache->tiebreak = tiebreak;
+    cache->num_classes = am->count;
+
+    if ((am->flags & HDC_AM_FLAG_READ_ONLY) != 0U) {
+        cache->num_classes = 0U;
+        return HDC_PROTO_ERROR_READ_ONLY;
+    }
+
+    for (hdc_class_t c = 0U; c < cache->num_classes; c++) {
+        memset(stale[c], 0xFF, sizeof(hdc_counter_mask_t));
+        memset(unsaved[c], 0, sizeof(hdc_counter_mask_t));
+    }
+    return HDC_PROTO_OK;
+}
+
+/**
+ * @brief   Add a pattern to a class's counters
+ * @param   cache Cache
+ * @param   class_id Class
+ * @param   pattern Pattern; 1 bits count up, 0 bits count down
+ * @return  Word positions that changed (0 for an invalid class)
+ */
+hdc_index_t hdc_proto_add(hdc_proto_t* cache, hdc_class_t class_id, const hv_t pattern)
+{
+    hdc_counter_mask_t changed;
+
+    if (class_id >= cache->num_classes) {
+        return 0U;
+    }
+    memset(changed, 0, sizeof(changed));
+    hdc_index_t n = hdc_counter_add_tracked(&cache->counters[class_id], pattern, changed);
+    proto_mark(cache, class_id, changed);
+    return n;
+}
+
+/**
+ * @brief   Subtract a pattern from a class's counters
+ * @param   cache Cache
+ * @param   class_id Class
+ * @param   pattern Pattern; 1 bits count down, 0 bits count up
+ * @return  Word positions that changed (0 for an invalid class)
+ */
+hdc_index_t hdc_proto_sub(hdc_proto_t* cache, hdc_class_t class_id, const hv_t pattern)
+{
+    hdc_counter_mask_t changed;
+
+    if (class_id >= cache->num_classes) {
+        return 0U;
+    }
+    memset(changed, 0, sizeof(changed));
+    hdc_index_t n = hdc_counter_sub_tracked(&cache->counters[class_id], pattern, changed);
+    proto_mark(cache, class_id, changed);
+    return n;
+}
+
+/**
+ * @brief   Mark every word of a class changed
+ * @param   cache Cache
+ * @param   class_id Class
+ * @return  HDC_PROTO_OK, or HDC_PROTO_ERROR_INVALID_CLASS
+ */
+hdc_proto_status_t hdc_proto_invalidate(hdc_proto_t* cache, hdc_class_t class_id)
+{
+    hdc_counter_mask_t all;
+
+    if (class_id >= cache->num_classes) {
+        return HDC_PROTO_ERROR_INVALID_CLASS;
+    }
+    memset(all, 0xFF, sizeof(all));
+    proto_mark(cache, class_id, all);
+    return HDC_PROTO_OK;
+}
+
+/* =============================================================================
+ * Access
+ * ========================================================================== */
+
+/**
+ * @brief   Up-to-date prototype of one class
+ * @param   cache Cache
+ * @param   class_id Class
+ * @return  The class row, or NULL for an invalid class
+ */
+const uint8_t* hdc_proto_get(hdc_proto_t* cache, hdc_class_t class_id)
+{
+    if (class_id >= cache->num_classes) {
+        return NULL;
+    }
+
+    HDC_PROBE_BEGIN(HDC_PROBE_PROTO_REFRESH);
+    (void)proto_refresh_class(cache, class_id);
+    HDC_PROBE_END(HDC_PROBE_PROTO_REFRESH);
+
+    return cache->am->classes[class_id];
+}
+
+/**
+ * @brief   Re-threshold the stale words of every class
+ * @param   cache Cache
+ * @return  Number of classes that had stale words
+ */
+hdc_class_t hdc_proto_refresh(hdc_proto_t* cache)
+{
+    hdc_class_t refreshed = 0U;
+
+    HDC_PROBE_BEGIN(HDC_PROBE_PROTO_REFRESH);
+    for (hdc_class_t c = 0U; c < cache->num_classes; c++) {
+        if (proto_refresh_class(cache, c)) {
+            refreshed++;
+        }
+    }
+    HDC_PROBE_END(HDC_PROBE_PROTO_REFRESH);
+
+    return refreshed;
+}
+
+/**
+ * @brief   Nearest class with up-to-date prototypes
+ * @param   cache Cache
+ * @param   query Query hypervector
+ * @param   p_best Receives the best match
+ * @return  As hdc_am_query()
+ */
+hdc_am_status_t hdc_proto_query(hdc_proto_t* cache, const hv_t query, hdc_am_match_t* p_best)
+{
+    (void)hdc_proto_refresh(cache);
+    return hdc_am_query(cache->am, query, p_best);
+}
+
+/**
+ * @brief   Check whether a class's prototype has stale words
+ * @param   cache Cache
+ * @param   class_id Class
+ * @return  true if hdc_proto_get() would re-threshold
+ */
+bool hdc_proto_is_stale(const hdc_proto_t* cache, hdc_class_t class_id)
+{
+    return (class_id < cache->num_classes) && proto_mask_any(cache->stale[class_id]);
+}
+
+/* =============================================================================
+ * Persistence
+ * ========================================================================== */
+
+/**
+ * @brief   Check whether a class has counter words not yet persisted
+ * @param   cache Cache
+ * @param   class_id Class
+ * @return  true if hdc_proto_persist() would mark it
+ */
+bool hdc_proto_is_unsaved(const hdc_proto_t* cache, hdc_class_t class_id)
+{
+    return (class_id < cache->num_classes) && proto_mask_any(cache->unsaved[class_id]);
+}
+
+/**
+ * @brief   Mark the unsaved counter words in a model store and clear them
+ * @param   cache Cache
+ * @param   store Store whose image holds the counters
+ * @param   offset Image offset of counters[0]
+ * @return  Number of hdc_store_mark() ranges issued
+ *
+ * @details Word w of plane j of class c is image bytes
+ *          offset + c * sizeof(hdc_counter_t) + j * HV_BYTES + w * HDC_WORD_BYTES
+ *          (the tail word is shorter). Runs of adjacent words are marked as
+ *          one range per plane.
+ */
+uint16_t hdc_proto_persist(hdc_proto_t* cache, hdc_store_t* store, uint16_t offset)
+{
+    uint16_t ranges = 0U;
+
+    for (hdc_class_t c = 0U; c < cache->num_classes; c++) {
+        const uint8_t* mask = cache->unsaved[c];
+        if (!proto_mask_any(mask)) {
+            continue;
+        }
+
+        uint32_t base = (uint32_t)offset + ((uint32_t)c * sizeof(hdc_counter_t));
+        uint16_t w = 0U;
+        while (w < HDC_COUNTER_WORDS) {
+            if (!proto_mask_has(mask, w)) {
+                w++;
+                continue;
+            }
+            uint16_t first = w;
+            while ((w < HDC_COUNTER_WORDS) && proto_mask_has(mask, w)) {
+                w++;
+            }
+
+            uint32_t start = (uint32_t)first * HDC_WORD_BYTES;
+            uint32_t end = (uint32_t)w * HDC_WORD_BYTES;
+            if (end > HV_BYTES) {
+                end = HV_BYTES;
+            }
+            for (uint8_t j = 0U; j < HDC_COUNTER_PLANES; j++) {
+                uint32_t plane = base + ((uint32_t)j * HV_BYTES);
+                hdc_store_mark(store, (uint16_t)(plane + start), (uint16_t)(end - start));
+                ranges++;
+            }
+        }
+        memset(cache->unsaved[c], 0, sizeof(hdc_counter_mask_t));
+    }
+    return ranges;
+}
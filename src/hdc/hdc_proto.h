@@ -0,0 +1,172 @@
+/**
+ * @file    hdc_proto.h
+ * @brief   HDC Prototype Cache - Lazy Re-Threshold With Dirty Word Tracking
+ * @version 1.0.0
+ * @note    Portable; rows, counters and masks are caller-owned
+ *
+ * @details The thresholded prototype of a class (the majority of its
+ *          hdc_counter_t) is cached as a row of an hdc_am_t. Counter
+ *          updates go through this cache. It records the changed word
+ *          positions (hdc_word_t, hdc_counter_add_tracked) in two masks per
+ *          class:
+ *
+ *            stale    prototype words that no longer match the counters;
+ *                     cleared when the class is re-thresholded
+ *            unsaved  counter words changed since hdc_proto_persist();
+ *                     cleared when they are handed to the model store
+ *
+ *          Nothing is re-thresholded when a counter changes. A class is
+ *          refreshed when it is next read: hdc_proto_get() refreshes one
+ *          class, hdc_proto_query() every class it searches. Only its stale
+ *          words are recomputed, so a burst of updates between two queries
+ *          costs one pass over the words it touched.
+ *
+ *          hdc_proto_persist() turns the unsaved words into hdc_store_mark()
+ *          ranges, one per run of words in each counter plane, so a commit
+ *          copies only the store blocks (HDC_STORE_BLOCK_BYTES) those words
+ *          fall in. The counters must be laid out as an hdc_counter_t array
+ *          inside the store image.
+ */
+
+#ifndef HDC_PROTO_H
+#define HDC_PROTO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hdc_core.h"
+#include "hdc_counter.h"
+#include "hdc_am.h"
+#include "hdc_store.h"
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Prototype cache status codes */
+typedef enum {
+    HDC_PROTO_OK = 0,
+    HDC_PROTO_ERROR_INVALID_CLASS,
+    HDC_PROTO_ERROR_READ_ONLY
+} hdc_proto_status_t;
+
+/** @brief Cache of thresholded prototypes over caller-owned counters */
+typedef struct {
+    hdc_am_t*           am;         /**< One prototype row per class */
+    hdc_counter_t*      counters;   /**< num_classes counter bundles */
+    hdc_counter_mask_t* stale;      /**< num_classes masks: words to re-threshold */
+    hdc_counter_mask_t* unsaved;    /**< num_classes masks: words not yet persisted */
+    const uint8_t*      tiebreak;   /**< Tie-break hypervector, or NULL */
+    hdc_class_t         num_classes; /**< am->count when attached */
+} hdc_proto_t;
+
+/* =============================================================================
+ * Function Declarations - Management
+ * ========================================================================== */
+
+/**
+ * @brief   Attach a cache to a memory and its counters
+ * @param   cache Cache to initialize
+ * @param   am Writable memory whose rows hold the prototypes
+ * @param   counters am->count counter bundles
+ * @param   stale am->count masks (all set here, so every prototype is rebuilt
+ *          from its counters when first read)
+ * @param   unsaved am->count masks (cleared here: loaded counters are saved)
+ * @param   tiebreak Tie-break hypervector, or NULL for 0 (kept by reference)
+ * @return  HDC_PROTO_OK, or HDC_PROTO_ERROR_READ_ONLY for a flash memory or
+ *          view
+ */
+hdc_proto_status_t hdc_proto_init(hdc_proto_t* cache, hdc_am_t* am, hdc_counter_t* counters,
+                                  hdc_counter_mask_t* stale, hdc_counter_mask_t* unsaved,
+                                  const hv_t tiebreak);
+
+/**
+ * @brief   Add a pattern to a class's counters
+ * @param   cache Cache
+ * @param   class_id Class
+ * @param   pattern Pattern; 1 bits count up, 0 bits count down
+ * @return  Word positions that changed (0 for an invalid class)
+ */
+hdc_index_t hdc_proto_add(hdc_proto_t* cache, hdc_class_t class_id, const hv_t pattern);
+
+/**
+ * @brief   Subtract a pattern from a class's counters
+ * @param   cache Cache
+ * @param   class_id Class
+ * @param   pattern Pattern; 1 bits count down, 0 bits count up
+ * @return  Word positions that changed (0 for an invalid class)
+ */
+hdc_index_t hdc_proto_sub(hdc_proto_t* cache, hdc_class_t class_id, const hv_t pattern);
+
+/**
+ * @brief   Mark every word of a class changed after its counters were
+ *          written directly (reset, merge, load)
+ * @param   cache Cache
+ * @param   class_id Class
+ * @return  HDC_PROTO_OK, or HDC_PROTO_ERROR_INVALID_CLASS
+ */
+hdc_proto_status_t hdc_proto_invalidate(hdc_proto_t* cache, hdc_class_t class_id);
+
+/* =============================================================================
+ * Function Declarations - Access
+ * ========================================================================== */
+
+/**
+ * @brief   Up-to-date prototype of one class
+ * @param   cache Cache
+ * @param   class_id Class
+ * @return  The class row after its stale words are re-thresholded, or NULL
+ *          for an invalid class
+ */
+const uint8_t* hdc_proto_get(hdc_proto_t* cache, hdc_class_t class_id);
+
+/**
+ * @brief   Re-threshold the stale words of every class
+ * @param   cache Cache
+ * @return  Number of classes that had stale words
+ */
+hdc_class_t hdc_proto_refresh(hdc_proto_t* cache);
+
+/**
+ * @brief   Nearest class with up-to-date prototypes
+ * @param   cache Cache
+ * @param   query Query hypervector
+ * @param   p_best Receives the best match
+ * @return  As hdc_am_query()
+ * @note    Refreshes every class first
+ */
+hdc_am_status_t hdc_proto_query(hdc_proto_t* cache, const hv_t query, hdc_am_match_t* p_best);
+
+/**
+ * @brief   Check whether a class's prototype has stale words
+ * @param   cache Cache
+ * @param   class_id Class
+ * @return  true if hdc_proto_get() would re-threshold (false for an invalid
+ *          class)
+ */
+bool hdc_proto_is_stale(const hdc_proto_t* cache, hdc_class_t class_id);
+
+/* =============================================================================
+ * Function Declarations - Persistence
+ * ========================================================================== */
+
+/**
+ * @brief   Check whether a class has counter words not yet persisted
+ * @param   cache Cache
+ * @param   class_id Class
+ * @return  true if hdc_proto_persist() would mark it (false for an invalid
+ *          class)
+ */
+bool hdc_proto_is_unsaved(const hdc_proto_t* cache, hdc_class_t class_id);
+
+/**
+ * @brief   Mark the unsaved counter words in a model store and clear them
+ * @param   cache Cache
+ * @param   store Store whose image holds the counters
+ * @param   offset Image offset of counters[0]
+ * @return  Number of hdc_store_mark() ranges issued
+ * @note    Call after every update (hdc_store_mark() must follow each
+ *          change to the image)
+ */
+uint16_t hdc_proto_persist(hdc_proto_t* cache, hdc_store_t* store, uint16_t offset);
+
+#endif /* HDC_PROTO_H */
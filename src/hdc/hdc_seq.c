@@ -0,0 +1,107 @@
+/**
+ * @file    hdc_seq.c
+ * @brief   HDC Sequence (N-gram) Encoding - Implementation
+ * @version 1.0.0
+ * @note    Sliding-window n-grams updated incrementally per sample
+ *
+ * @details Each push costs one permute by n - 1 (the evicted sample's
+ *          contribution) and one by 1 (aging the window); hdc_permute()
+ *          works in place, so the only temporary is one hypervector.
+ */
+
+#include <stddef.h>
+#include "hdc_seq.h"
+
+/**
+ * @brief   Initialize an empty window
+ * @param   seq Window to initialize
+ * @param   history Storage for n sample hypervectors
+ * @param   n Window length (1 to 255)
+ * @return  HDC_SEQ_OK, or HDC_SEQ_ERROR_INVALID
+ */
+hdc_seq_status_t hdc_seq_init(hdc_seq_t* seq, hv_t* history, uint8_t n)
+{
+    if ((n == 0U) || (history == NULL)) {
+        return HDC_SEQ_ERROR_INVALID;
+    }
+
+    seq->history = history;
+    seq->n = n;
+    hdc_seq_reset(seq);
+    return HDC_SEQ_OK;
+}
+
+/**
+ * @brief   Empty the window (e.g. at a gesture boundary)
+ * @param   seq Window
+ */
+void hdc_seq_reset(hdc_seq_t* seq)
+{
+    hdc_clear(seq->gram);
+    seq->oldest = 0U;
+    seq->fill = 0U;
+}
+
+/**
+ * @brief   Add the newest sample and update the n-gram incrementally
+ * @param   seq Window
+ * @param   sample Sample hypervector (copied)
+ * @return  true once the window holds n samples (seq->gram is a full n-gram)
+ */
+bool hdc_seq_push(hdc_seq_t* seq, const hv_t sample)
+{
+    uint8_t slot;
+
+    if (seq->fill == seq->n) {
+        /* Remove the oldest sample, which carries rho^(n-1) */
+        hv_t evicted;
+
+        slot = seq->oldest;
+        hdc_copy(evicted, seq->history[slot]);
+        hdc_permute(evicted, (hdc_dist_t)(seq->n - 1U));
+        hdc_xor(seq->gram, seq->gram, evicted);
+
+        seq->oldest = (uint8_t)((slot + 1U == seq->n) ? 0U : (slot + 1U));
+    } else {
+        slot = (uint8_t)(seq->oldest + seq->fill);
+        if (slot >= seq->n) {
+            slot = (uint8_t)(slot - seq->n);
+        }
+        seq->fill++;
+    }
+
+    /* Age the remaining samples by one position and add the newest */
+    hdc_permute(seq->gram, 1U);
+    hdc_xor(seq->gram, seq->gram, sample);
+    hdc_copy(seq->history[slot], sample);
+
+    return (seq->fill == seq->n);
+}
+
+/**
+ * @brief   Whether the window holds n samples
+ * @param   seq Window
+ * @return  true when seq->gram is a full n-gram
+ */
+bool hdc_seq_ready(const hdc_seq_t* seq)
+{
+    return (seq->fill == seq->n);
+}
+
+/**
+ * @brief   N-gram of a complete sequence (reference, non-incremental)
+ * @param   result Output n-gram
+ * @param   samples Samples, oldest first
+ * @param   n Number of samples
+ *
+ * @details Horner form: result = rho(...rho(rho(x_0) ^ x_1)...) ^ x_(n-1),
+ *          one permute by 1 per sample.
+ */
+void hdc_seq_encode(hv_t result, const hv_t* samples, uint8_t n)
+{
+    hdc_clear(result);
+    for (uint8_t i = 0U; i < n; i++) {
+        hdc_permute(result, 1U);
+        hdc_xor(result, result, samples[i]);
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file    hdc_seq.h
+ * @brief   HDC Sequence (N-gram) Encoding - Declarations
+ * @version 1.0.0
+ * @note    Sliding-window n-grams updated incrementally per sample
+ *
+ * @details An n-gram binds the last n sample hypervectors, each permuted by
+ *          its age (rho = hdc_permute by one bit):
+ *
+ *            G_t = rho^(n-1)(x_(t-n+1)) ^ ... ^ rho(x_(t-1)) ^ x_t
+ *
+ *          Recomputing G_t costs n permutes per sample. hdc_seq_push()
+ *          instead removes the oldest term and ages the rest in one step:
+ *
+ *            G_(t+1) = rho(G_t ^ rho^(n-1)(x_(t-n+1))) ^ x_(t+1)
+ *
+ *          which is two permutes and two XORs per sample for any n. The
+ *          window keeps the last n samples in caller-provided storage (no
+ *          dynamic allocation), like the associative memory.
+ */
+
+#ifndef HDC_SEQ_H
+#define HDC_SEQ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hdc_core.h"
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Sequence encoder status codes */
+typedef enum {
+    HDC_SEQ_OK = 0,
+    HDC_SEQ_ERROR_INVALID       /**< n is 0 or no history storage */
+} hdc_seq_status_t;
+
+/** @brief Sliding n-gram window */
+typedef struct {
+    hv_t*   history;    /**< Last n samples, ring of n entries (caller-owned) */
+    hv_t    gram;       /**< n-gram of the samples in the window */
+    uint8_t n;          /**< Window length */
+    uint8_t oldest;     /**< Ring index of the oldest sample */
+    uint8_t fill;       /**< Samples in the window (0..n) */
+} hdc_seq_t;
+
+/* =============================================================================
+ * Function Declarations
+ * ========================================================================== */
+
+/**
+ * @brief   Initialize an empty window
+ * @param   seq Window to initialize
+ * @param   history Storage for n sample hypervectors
+ * @param   n Window length (1 to 255)
+ * @return  HDC_SEQ_OK, or HDC_SEQ_ERROR_INVALID
+ */
+hdc_seq_status_t hdc_seq_init(hdc_seq_t* seq, hv_t* history, uint8_t n);
+
+/**
+ * @brief   Empty the window (e.g. at a gesture boundary)
+ * @param   seq Window
+ */
+void hdc_seq_reset(hdc_seq_t* seq);
+
+/**
+ * @brief   Add the newest sample and update the n-gram incrementally
+ * @param   seq Window
+ * @param   sample Sample hypervector (copied)
+ * @return  true once the window holds n samples (seq->gram is a full n-gram)
+ * @note    While filling, seq->gram is the n-gram of the samples so far
+ */
+bool hdc_seq_push(hdc_seq_t* seq, const hv_t sample);
+
+/**
+ * @brief   Whether the window holds n samples
+ * @param   seq Window
+ * @return  true when seq->gram is a full n-gram
+ */
+bool hdc_seq_ready(const hdc_seq_t* seq);
+
+/**
+ * @brief   N-gram of a complete sequence (reference, non-incremental)
+ * @param   result Output n-gram
+ * @param   samples Samples, oldest first
+ * @param   n Number of samples
+ */
+void hdc_seq_encode(hv_t result, const hv_t* samples, uint8_t n);
+
+#endif /* HDC_SEQ_H */
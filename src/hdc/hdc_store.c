@@ -0,0 +1,428 @@
+/**
+ * @file    hdc_store.c
+ * @brief   HDC Model Store - Implementation
+ * @version 1.0.0
+ * @note    One device write in flight at a time; no blocking waits
+ */
+
+#include <stddef.h>
+#include "hdc_store.h"
+
+#if defined(__AVR__)
+#include <util/crc16.h>
+#endif
+
+/* =============================================================================
+ * Private Helpers
+ * ========================================================================== */
+
+/** @brief Header magic */
+#define STORE_MAGIC_0       ((uint8_t)'H')
+#define STORE_MAGIC_1       ((uint8_t)'S')
+
+/** @brief Header bytes covered by the CRC (everything before it) */
+#define STORE_CRC_OFFSET    8U
+
+/**
+ * @brief   Device address of a slot's header
+ * @param   store Store
+ * @param   slot Slot index
+ * @return  Address
+ */
+static uint16_t slot_address(const hdc_store_t* store, uint8_t slot)
+{
+    return (uint16_t)(store->base + ((uint16_t)slot * (uint16_t)(HDC_STORE_HEADER_BYTES + store->length)));
+}
+
+/**
+ * @brief   Serial-number comparison of 16-bit sequence numbers
+ * @param   a Sequence number
+ * @param   b Sequence number
+ * @return  true when a was written after b (robust to wrap)
+ */
+static bool seq_newer(uint16_t a, uint16_t b)
+{
+    uint16_t d = (uint16_t)(a - b);
+    return (d != 0U) && (d < 0x8000U);
+}
+
+/**
+ * @brief   Test one bitmap bit
+ * @param   bitmap Bitmap
+ * @param   block Block index
+ * @return  true when set
+ */
+static bool bitmap_test(const uint8_t* bitmap, uint16_t block)
+{
+    return ((bitmap[block >> 3] & (uint8_t)(1U << (block & 7U))) != 0U);
+}
+
+/**
+ * @brief   Whether any bit of a bitmap is set
+ * @param   bitmap Bitmap
+ * @return  true when at least one block is marked
+ */
+static bool bitmap_any(const uint8_t* bitmap)
+{
+    uint8_t acc = 0U;
+
+    for (uint8_t i = 0U; i < (uint8_t)HDC_STORE_BITMAP_BYTES; i++) {
+        acc |= bitmap[i];
+    }
+    return (acc != 0U);
+}
+
+/**
+ * @brief   Set the bits of blocks [first, last] in one bitmap
+ * @param   bitmap Bitmap
+ * @param   first First block
+ * @param   last Last block (inclusive)
+ */
+static void bitmap_set_range(uint8_t* bitmap, uint16_t first, uint16_t last)
+{
+    for (uint16_t b = first; b <= last; b++) {
+        bitmap[b >> 3] |= (uint8_t)(1U << (b & 7U));
+    }
+}
+
+/**
+ * @brief   Clear a bitmap
+ * @param   bitmap Bitmap
+ */
+static void bitmap_clear(uint8_t* bitmap)
+{
+    for (uint8_t i = 0U; i < (uint8_t)HDC_STORE_BITMAP_BYTES; i++) {
+        bitmap[i] = 0U;
+    }
+}
+
+/**
+ * @brief   Build the first STORE_CRC_OFFSET header bytes of a slot
+ * @param   store Store
+ * @param   header Output header
+ * @param   seq Sequence number
+ */
+static void header_build(const hdc_store_t* store, uint8_t* header, uint16_t seq)
+{
+    header[0] = STORE_MAGIC_0;
+    header[1] = STORE_MAGIC_1;
+    header[2] = (uint8_t)HDC_STORE_FORMAT;
+    header[3] = store->schema;
+    header[4] = (uint8_t)seq;
+    header[5] = (uint8_t)(seq >> 8);
+    header[6] = (uint8_t)store->length;
+    header[7] = (uint8_t)(store->length >> 8);
+}
+
+/* =============================================================================
+ * Setup and Load
+ * ========================================================================== */
+
+/**
+ * @brief   Initialize a store; nothing is read until hdc_store_load()
+ * @param   store Store to initialize
+ * @param   io Device operations
+ * @param   base Device address of slot 0
+ * @param   slots Slots in rotation (1 to HDC_STORE_MAX_SLOTS)
+ * @param   image RAM image to persist
+ * @param   length Image bytes (1 to HDC_STORE_MAX_BYTES)
+ * @param   schema Image layout version
+ * @return  HDC_STORE_OK, or HDC_STORE_ERROR_INVALID
+ */
+hdc_store_status_t hdc_store_init(hdc_store_t* store, const hdc_store_io_t* io,
+                                  uint16_t base, uint8_t slots,
+                                  uint8_t* image, uint16_t length, uint8_t schema)
+{
+    if ((io == NULL) || (image == NULL) ||
+        (slots == 0U) || (slots > HDC_STORE_MAX_SLOTS) ||
+        (length == 0U) || (length > HDC_STORE_MAX_BYTES)) {
+        return HDC_STORE_ERROR_INVALID;
+    }
+
+    store->io = io;
+    store->image = image;
+    store->length = length;
+    store->base = base;
+    store->slots = slots;
+    store->schema = schema;
+    store->current = HDC_STORE_NO_SLOT;
+    store->seq = 0U;
+    store->committing = false;
+
+    /* Slot contents are unknown until loaded */
+    for (uint8_t s = 0U; s < HDC_STORE_MAX_SLOTS; s++) {
+        bitmap_clear(store->dirty[s]);
+    }
+    hdc_store_mark_all(store);
+    return HDC_STORE_OK;
+}
+
+/**
+ * @brief   Load the newest valid image into RAM
+ * @param   store Store
+ * @return  HDC_STORE_OK, or HDC_STORE_ERROR_EMPTY
+ *
+ * @details Pass 1 reads only the headers. Pass 2 copies the newest
+ *          candidate and checks its CRC, falling back to the next newest on
+ *          a mismatch, so a clean boot reads each image byte once.
+ */
+hdc_store_status_t hdc_store_load(hdc_store_t* store)
+{
+    const hdc_store_io_t* io = store->io;
+    uint8_t expected[STORE_CRC_OFFSET];
+    uint16_t seqs[HDC_STORE_MAX_SLOTS];
+    uint16_t crcs[HDC_STORE_MAX_SLOTS];
+    uint8_t candidates = 0U;
+
+    store->committing = false;
+    store->current = HDC_STORE_NO_SLOT;
+    store->seq = 0U;
+    hdc_store_mark_all(store);
+
+    /* Pass 1: headers that match this store's format, schema and length */
+    header_build(store, expected, 0U);
+    for (uint8_t s = 0U; s < store->slots; s++) {
+        uint16_t addr = slot_address(store, s);
+        uint8_t header[HDC_STORE_HEADER_BYTES];
+        bool match = true;
+
+        for (uint8_t i = 0U; i < HDC_STORE_HEADER_BYTES; i++) {
+            header[i] = io->read((uint16_t)(addr + i));
+        }
+        for (uint8_t i = 0U; i < STORE_CRC_OFFSET; i++) {
+            if ((i != 4U) && (i != 5U) && (header[i] != expected[i])) {
+                match = false;
+            }
+        }
+        if (match) {
+            seqs[s] = (uint16_t)(header[4] | ((uint16_t)header[5] << 8));
+            crcs[s] = (uint16_t)(header[8] | ((uint16_t)header[9] << 8));
+            candidates |= (uint8_t)(1U << s);
+        }
+    }
+
+    /* Pass 2: newest candidate first */
+    while (candidates != 0U) {
+        uint8_t best = HDC_STORE_NO_SLOT;
+
+        for (uint8_t s = 0U; s < store->slots; s++) {
+            if (((candidates & (1U << s)) != 0U) &&
+                ((best == HDC_STORE_NO_SLOT) || seq_newer(seqs[s], seqs[best]))) {
+                best = s;
+            }
+        }
+        candidates &= (uint8_t)~(1U << best);
+
+        uint16_t addr = (uint16_t)(slot_address(store, best) + HDC_STORE_HEADER_BYTES);
+        uint16_t crc = 0xFFFFU;
+
+        header_build(store, expected, seqs[best]);
+        for (uint8_t i = 0U; i < STORE_CRC_OFFSET; i++) {
+            crc = hdc_store_crc16(crc, expected[i]);
+        }
+        for (uint16_t i = 0U; i < store->length; i++) {
+            uint8_t value = io->read((uint16_t)(addr + i));
+            store->image[i] = value;
+            crc = hdc_store_crc16(crc, value);
+        }
+
+        if (crc == crcs[best]) {
+            store->current = best;
+            store->seq = seqs[best];
+            bitmap_clear(store->dirty[best]);
+            return HDC_STORE_OK;
+        }
+    }
+
+    return HDC_STORE_ERROR_EMPTY;
+}
+
+/* =============================================================================
+ * Change Tracking
+ * ========================================================================== */
+
+/**
+ * @brief   Record that image bytes changed
+ * @param   store Store
+ * @param   offset First changed byte
+ * @param   len Changed bytes
+ *
+ * @details During a commit the block is also marked in the commit's work
+ *          set, so a block the scan has not reached yet is written with its
+ *          new value (and a block already passed is picked up by the next
+ *          commit through the target's own bitmap).
+ */
+void hdc_store_mark(hdc_store_t* store, uint16_t offset, uint16_t len)
+{
+    if ((len == 0U) || (offset >= store->length)) {
+        return;
+    }
+
+    uint16_t end = ((uint16_t)(store->length - offset) < len) ? store->length
+                                                               : (uint16_t)(offset + len);
+    uint16_t first = (uint16_t)(offset / HDC_STORE_BLOCK_BYTES);
+    uint16_t last = (uint16_t)((end - 1U) / HDC_STORE_BLOCK_BYTES);
+
+    for (uint8_t s = 0U; s < store->slots; s++) {
+        bitmap_set_range(store->dirty[s], first, last);
+    }
+    if (store->committing) {
+        bitmap_set_range(store->work, first, last);
+    }
+}
+
+/**
+ * @brief   Record that the whole image changed (e.g. after a model reset)
+ * @param   store Store
+ */
+void hdc_store_mark_all(hdc_store_t* store)
+{
+    hdc_store_mark(store, 0U, store->length);
+}
+
+/* =============================================================================
+ * Commit
+ * ========================================================================== */
+
+/**
+ * @brief   Start committing the image to the next slot
+ * @param   store Store
+ * @return  HDC_STORE_PENDING when started, HDC_STORE_OK when nothing changed
+ *          since the last commit, or HDC_STORE_ERROR_BUSY
+ */
+hdc_store_status_t hdc_store_commit(hdc_store_t* store)
+{
+    if (store->committing) {
+        return HDC_STORE_ERROR_BUSY;
+    }
+    if ((store->current != HDC_STORE_NO_SLOT) && !bitmap_any(store->dirty[store->current])) {
+        return HDC_STORE_OK;
+    }
+
+    uint8_t target = (store->current == HDC_STORE_NO_SLOT) ? 0U : (uint8_t)(store->current + 1U);
+    if (target >= store->slots) {
+        target = 0U;
+    }
+
+    /* Changes from here on belong to the next write of this slot */
+    for (uint8_t i = 0U; i < (uint8_t)HDC_STORE_BITMAP_BYTES; i++) {
+        store->work[i] = store->dirty[target][i];
+    }
+    bitmap_clear(store->dirty[target]);
+
+    header_build(store, store->header, (uint16_t)(store->seq + 1U));
+    store->crc = 0xFFFFU;
+    for (uint8_t i = 0U; i < STORE_CRC_OFFSET; i++) {
+        store->crc = hdc_store_crc16(store->crc, store->header[i]);
+    }
+
+    store->target = target;
+    store->pos = 0U;
+    store->committing = true;
+    return HDC_STORE_PENDING;
+}
+
+/**
+ * @brief   Advance the commit in progress by a bounded amount of work
+ * @param   store Store
+ * @return  HDC_STORE_PENDING while work remains, HDC_STORE_OK when idle
+ *
+ * @details store->pos runs over the image, then over the header. A byte is
+ *          programmed only when the device holds a different value, and the
+ *          function returns right after starting that write.
+ */
+hdc_store_status_t hdc_store_step(hdc_store_t* store)
+{
+    const hdc_store_io_t* io = store->io;
+
+    if (!store->committing) {
+        return HDC_STORE_OK;
+    }
+    if (io->busy()) {
+        return HDC_STORE_PENDING;
+    }
+
+    uint16_t slot = slot_address(store, store->target);
+    uint8_t budget = (uint8_t)HDC_STORE_STEP_BYTES;
+
+    while (budget > 0U) {
+        uint16_t addr;
+        uint8_t value;
+
+        if (store->pos < store->length) {
+            uint16_t block = (uint16_t)(store->pos / HDC_STORE_BLOCK_BYTES);
+
+            if (!bitmap_test(store->work, block)) {
+                /* Clean block: the slot already holds these bytes */
+                uint16_t end = (uint16_t)((block + 1U) * HDC_STORE_BLOCK_BYTES);
+                if (end > store->length) {
+                    end = store->length;
+                }
+                while ((store->pos < end) && (budget > 0U)) {
+                    store->crc = hdc_store_crc16(store->crc, store->image[store->pos]);
+                    store->pos++;
+                    budget--;
+                }
+                continue;
+            }
+
+            value = store->image[store->pos];
+            store->crc = hdc_store_crc16(store->crc, value);
+            addr = (uint16_t)(slot + HDC_STORE_HEADER_BYTES + store->pos);
+        } else {
+            uint16_t h = (uint16_t)(store->pos - store->length);
+
+            if (h == HDC_STORE_HEADER_BYTES) {
+                store->current = store->target;
+                store->seq = (uint16_t)(store->header[4] | ((uint16_t)store->header[5] << 8));
+                store->committing = false;
+                return HDC_STORE_OK;
+            }
+            if (h == 0U) {
+                store->header[STORE_CRC_OFFSET] = (uint8_t)store->crc;
+                store->header[STORE_CRC_OFFSET + 1U] = (uint8_t)(store->crc >> 8);
+            }
+
+            value = store->header[h];
+            addr = (uint16_t)(slot + h);
+        }
+
+        store->pos++;
+        budget--;
+        if (io->read(addr) != value) {
+            io->write(addr, value);
+            return HDC_STORE_PENDING;
+        }
+    }
+
+    return HDC_STORE_PENDING;
+}
+
+/**
+ * @brief   Whether a commit is in progress
+ * @param   store Store
+ * @return  true until the commit's last hdc_store_step()
+ */
+bool hdc_store_busy(const hdc_store_t* store)
+{
+    return store->committing;
+}
+
+/**
+ * @brief   Update a CRC-16/CCITT (poly 0x1021, MSB first) with one byte
+ * @param   crc Current CRC (0xFFFF to start)
+ * @param   data Byte to add
+ * @return  Updated CRC
+ */
+uint16_t hdc_store_crc16(uint16_t crc, uint8_t data)
+{
+#if defined(__AVR__)
+    return _crc_xmodem_update(crc, data);
+#else
+    crc ^= (uint16_t)((uint16_t)data << 8);
+    for (uint8_t bit = 0U; bit < 8U; bit++) {
+        crc = ((crc & 0x8000U) != 0U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+    }
+    return crc;
+#endif
+}
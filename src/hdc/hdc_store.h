@@ -0,0 +1,215 @@
+/**
+ * @file    hdc_store.h
+ * @brief   HDC Model Store - Wear-Levelled Incremental Persistence
+ * @version 1.0.0
+ * @note    Portable; the byte device (EEPROM, I2C memory, RAM in tests) is
+ *          reached through hdc_store_io_t
+ *
+ * @details The store persists one caller-owned RAM image (for example the
+ *          bundling counters of every class) in a ring of slots that are
+ *          written in rotation:
+ *
+ *            base + s * (HDC_STORE_HEADER_BYTES + length)
+ *            +-------+-------+--------+-----+-----+-----+-----------------+
+ *            | 'H''S'| FORMAT| schema | seq | len | CRC | image (len B)   |
+ *            +-------+-------+--------+-----+-----+-----+-----------------+
+ *              2 B     1 B     1 B     u16   u16   u16
+ *
+ *          Multi-byte fields are little-endian. The CRC-16 (CCITT, poly
+ *          0x1021, init 0xFFFF) covers the first eight header bytes and the
+ *          image. The slot with a valid CRC and the newest sequence number
+ *          wins at boot.
+ *
+ *          A commit goes to the slot after the current one and writes the
+ *          image first, then the header. A power loss part way leaves the
+ *          target slot with a bad CRC and the previous slot untouched.
+ *          Across S slots, each cell is written at most once every S commits.
+ *
+ *          Incremental: the image is divided into HDC_STORE_BLOCK_BYTES
+ *          blocks, and every slot has a bitmap of the blocks changed since
+ *          that slot was last written. hdc_store_mark() sets the bits, and a
+ *          commit copies only marked blocks. Within those, it programs only
+ *          bytes that differ from the device. Clean blocks are folded into
+ *          the CRC from RAM without touching the device.
+ *
+ *          Non-blocking: hdc_store_step() does at most HDC_STORE_STEP_BYTES
+ *          of CRC work and starts at most one device write per call. It
+ *          returns at once while the previous write is still programming, so
+ *          it can run from a scheduler task between samples.
+ */
+
+#ifndef HDC_STORE_H
+#define HDC_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =============================================================================
+ * Configuration
+ * ========================================================================== */
+
+/** @brief Largest image in bytes (sizes the dirty bitmaps) */
+#ifndef HDC_STORE_MAX_BYTES
+#define HDC_STORE_MAX_BYTES     256U
+#endif
+
+/** @brief Largest slot count */
+#ifndef HDC_STORE_MAX_SLOTS
+#define HDC_STORE_MAX_SLOTS     4U
+#endif
+
+#if (HDC_STORE_MAX_SLOTS < 1U) || (HDC_STORE_MAX_SLOTS > 8U)
+#error "HDC_STORE_MAX_SLOTS must be between 1 and 8"
+#endif
+
+/** @brief Bytes tracked per dirty bit */
+#ifndef HDC_STORE_BLOCK_BYTES
+#define HDC_STORE_BLOCK_BYTES   8U
+#endif
+
+/** @brief Bytes folded into the CRC per hdc_store_step() call */
+#ifndef HDC_STORE_STEP_BYTES
+#define HDC_STORE_STEP_BYTES    16U
+#endif
+
+/** @brief On-device layout version (bump when the header layout changes) */
+#define HDC_STORE_FORMAT        1U
+
+/** @brief Header size in bytes */
+#define HDC_STORE_HEADER_BYTES  10U
+
+/** @brief Dirty bitmap size in bytes */
+#define HDC_STORE_BLOCKS        ((HDC_STORE_MAX_BYTES + HDC_STORE_BLOCK_BYTES - 1U) / HDC_STORE_BLOCK_BYTES)
+#define HDC_STORE_BITMAP_BYTES  ((HDC_STORE_BLOCKS + 7U) / 8U)
+
+/** @brief No valid slot */
+#define HDC_STORE_NO_SLOT       0xFFU
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Store status codes */
+typedef enum {
+    HDC_STORE_OK = 0,
+    HDC_STORE_PENDING,          /**< Commit in progress, call hdc_store_step() */
+    HDC_STORE_ERROR_INVALID,    /**< Bad slot count, length or parameters */
+    HDC_STORE_ERROR_EMPTY,      /**< No slot holds a valid image */
+    HDC_STORE_ERROR_BUSY        /**< A commit is already in progress */
+} hdc_store_status_t;
+
+/**
+ * @brief   Byte device operations
+ * @note    write() only starts programming; busy() is polled before every
+ *          further access
+ */
+typedef struct {
+    uint8_t (*read)(uint16_t addr);
+    void    (*write)(uint16_t addr, uint8_t value);
+    bool    (*busy)(void);
+} hdc_store_io_t;
+
+/** @brief Store state */
+typedef struct {
+    const hdc_store_io_t* io;
+    uint8_t*  image;        /**< Persisted RAM image (caller-owned) */
+    uint16_t  length;       /**< Image bytes */
+    uint16_t  base;         /**< Device address of slot 0 */
+    uint8_t   slots;        /**< Slots in rotation */
+    uint8_t   schema;       /**< Caller's image layout version */
+    uint8_t   current;      /**< Slot with the newest image, or HDC_STORE_NO_SLOT */
+    uint16_t  seq;          /**< Sequence number of the current slot */
+
+    /** Blocks changed since each slot was last written */
+    uint8_t   dirty[HDC_STORE_MAX_SLOTS][HDC_STORE_BITMAP_BYTES];
+
+    /* Commit in progress */
+    bool      committing;
+    uint8_t   target;
+    uint16_t  pos;          /**< Next image byte, then length + header byte */
+    uint16_t  crc;
+    uint8_t   work[HDC_STORE_BITMAP_BYTES];
+    uint8_t   header[HDC_STORE_HEADER_BYTES];
+} hdc_store_t;
+
+/* =============================================================================
+ * Function Declarations
+ * ========================================================================== */
+
+/**
+ * @brief   Initialize a store; nothing is read until hdc_store_load()
+ * @param   store Store to initialize
+ * @param   io Device operations
+ * @param   base Device address of slot 0
+ * @param   slots Slots in rotation (1 to HDC_STORE_MAX_SLOTS; 2+ for
+ *          power-fail safety)
+ * @param   image RAM image to persist
+ * @param   length Image bytes (1 to HDC_STORE_MAX_BYTES)
+ * @param   schema Image layout version; slots written with another schema
+ *          are ignored
+ * @return  HDC_STORE_OK, or HDC_STORE_ERROR_INVALID
+ * @note    The device needs base + slots * (HDC_STORE_HEADER_BYTES + length)
+ *          bytes
+ */
+hdc_store_status_t hdc_store_init(hdc_store_t* store, const hdc_store_io_t* io,
+                                  uint16_t base, uint8_t slots,
+                                  uint8_t* image, uint16_t length, uint8_t schema);
+
+/**
+ * @brief   Load the newest valid image into RAM
+ * @param   store Store
+ * @return  HDC_STORE_OK, or HDC_STORE_ERROR_EMPTY
+ * @note    Headers are checked first, then only the newest candidate's image
+ *          is read (with the CRC computed during the copy). On
+ *          HDC_STORE_ERROR_EMPTY the RAM image is unspecified and the caller
+ *          reinitializes it.
+ */
+hdc_store_status_t hdc_store_load(hdc_store_t* store);
+
+/**
+ * @brief   Record that image bytes changed
+ * @param   store Store
+ * @param   offset First changed byte
+ * @param   len Changed bytes
+ * @note    Must follow every change to the image, including changes made
+ *          while a commit is in progress
+ */
+void hdc_store_mark(hdc_store_t* store, uint16_t offset, uint16_t len);
+
+/**
+ * @brief   Record that the whole image changed (e.g. after a model reset)
+ * @param   store Store
+ */
+void hdc_store_mark_all(hdc_store_t* store);
+
+/**
+ * @brief   Start committing the image to the next slot
+ * @param   store Store
+ * @return  HDC_STORE_PENDING when started, HDC_STORE_OK when nothing changed
+ *          since the last commit, or HDC_STORE_ERROR_BUSY
+ */
+hdc_store_status_t hdc_store_commit(hdc_store_t* store);
+
+/**
+ * @brief   Advance the commit in progress by a bounded amount of work
+ * @param   store Store
+ * @return  HDC_STORE_PENDING while work remains, HDC_STORE_OK when idle
+ */
+hdc_store_status_t hdc_store_step(hdc_store_t* store);
+
+/**
+ * @brief   Whether a commit is in progress
+ * @param   store Store
+ * @return  true until the commit's last hdc_store_step()
+ */
+bool hdc_store_busy(const hdc_store_t* store);
+
+/**
+ * @brief   Update a CRC-16/CCITT (poly 0x1021, MSB first) with one byte
+ * @param   crc Current CRC (0xFFFF to start)
+ * @param   data Byte to add
+ * @return  Updated CRC
+ */
+uint16_t hdc_store_crc16(uint16_t crc, uint8_t data);
+
+#endif /* HDC_STORE_H */
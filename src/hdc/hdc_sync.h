@@ -0,0 +1,72 @@
+/**
+ * @file    hdc_sync.h
+ * @brief   HDC Sync - Ordering Primitives for Lock-Free Single-Byte Handoff
+ * @version 1.0.0
+ * @note    Portable; needs only the compiler (no HAL)
+ *
+ * @details The sample pipeline (hdc_pipe.h) and the frame exchange
+ *          (hal_frame.h) write slot contents as plain memory, then publish
+ *          them by storing a single-byte index. Readers load the index,
+ *          then read the slot. The index accesses need stronger ordering
+ *          than their volatile qualifier gives:
+ *
+ *            - ATmega328P (one core, byte accesses atomic): only the compiler
+ *              may reorder, so a compiler barrier is enough.
+ *            - Other GCC/Clang targets: another core, especially on a weakly
+ *              ordered ARM host, could see the index before the slot data.
+ *              The primitives use the __atomic builtins: a release store, an
+ *              acquire load and a sequentially consistent fence.
+ *            - C11 compilers with <stdatomic.h>: the same fences from there.
+ *            - Any other compiler: no ordering is enforced. Use there must
+ *              then stay on one thread.
+ */
+
+#ifndef HDC_SYNC_H
+#define HDC_SYNC_H
+
+#include <stdint.h>
+
+#if defined(__AVR__)
+    /** @brief Full barrier: no memory access moves across it */
+    #define HDC_BARRIER()       __asm__ __volatile__ ("" ::: "memory")
+#elif defined(__GNUC__)
+    #define HDC_BARRIER()       __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+    #include <stdatomic.h>
+    #define HDC_BARRIER()       atomic_thread_fence(memory_order_seq_cst)
+#else
+    #define HDC_BARRIER()       ((void)0)
+#endif
+
+/**
+ * @brief   Load an index another side publishes (acquire)
+ * @param   p Index
+ * @return  Index value; slot contents published before it are visible
+ */
+static inline uint8_t hdc_sync_load(const volatile uint8_t* p)
+{
+#if defined(__GNUC__) && !defined(__AVR__)
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#else
+    uint8_t value = *p;
+    HDC_BARRIER();
+    return value;
+#endif
+}
+
+/**
+ * @brief   Publish an index after writing the slots it covers (release)
+ * @param   p Index
+ * @param   value New index value
+ */
+static inline void hdc_sync_store(volatile uint8_t* p, uint8_t value)
+{
+#if defined(__GNUC__) && !defined(__AVR__)
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+#else
+    HDC_BARRIER();
+    *p = value;
+#endif
+}
+
+#endif /* HDC_SYNC_H */
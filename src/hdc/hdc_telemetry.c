@@ -0,0 +1,256 @@
+/**
+ * @file    hdc_telemetry.c
+ * @brief   HDC Telemetry - Implementation
+ * @version 1.2.0
+ * @note    Records are appended in place; finish() writes LEN and CRC
+ */
+
+#include "hdc_telemetry.h"
+
+#if defined(__AVR__)
+#include <util/crc16.h>
+#endif
+
+/* =============================================================================
+ * Private Helpers
+ * ========================================================================== */
+
+/**
+ * @brief   Append a little-endian 16-bit field to the payload
+ * @param   frame Frame (caller checked there is room)
+ * @param   value Field value
+ */
+static void tlm_put_u16(hdc_tlm_frame_t* frame, uint16_t value)
+{
+    frame->bytes[HDC_TLM_HEADER_BYTES + frame->len] = (uint8_t)(value & 0xFFU);
+    frame->bytes[HDC_TLM_HEADER_BYTES + frame->len + 1U] = (uint8_t)(value >> 8);
+    frame->len = (uint8_t)(frame->len + 2U);
+}
+
+/**
+ * @brief   Append a little-endian 32-bit field to the payload
+ * @param   frame Frame (caller checked there is room)
+ * @param   value Field value
+ */
+static void tlm_put_u32(hdc_tlm_frame_t* frame, uint32_t value)
+{
+    tlm_put_u16(frame, (uint16_t)(value & 0xFFFFU));
+    tlm_put_u16(frame, (uint16_t)(value >> 16));
+}
+
+/**
+ * @brief   Check that a record fits a frame of the expected type
+ * @param   frame Frame
+ * @param   type Record type
+ * @param   size Record size in bytes
+ * @return  HDC_TLM_OK, HDC_TLM_ERROR_FULL or HDC_TLM_ERROR_TYPE
+ */
+static hdc_tlm_status_t tlm_reserve(const hdc_tlm_frame_t* frame, hdc_tlm_type_t type, uint8_t size)
+{
+    if (frame->bytes[1] != (uint8_t)type) {
+        return HDC_TLM_ERROR_TYPE;
+    }
+    if ((uint16_t)(frame->len + size) > HDC_TLM_MAX_PAYLOAD) {
+        return HDC_TLM_ERROR_FULL;
+    }
+    return HDC_TLM_OK;
+}
+
+/* =============================================================================
+ * Framing
+ * ========================================================================== */
+
+/**
+ * @brief   Update a CRC-8 (poly 0x07, MSB first) with one byte
+ * @param   crc Current CRC (0 to start)
+ * @param   data Byte to add
+ * @return  Updated CRC
+ */
+uint8_t hdc_tlm_crc8(uint8_t crc, uint8_t data)
+{
+#if defined(__AVR__)
+    return _crc8_ccitt_update(crc, data);
+#else
+    crc ^= data;
+    for (uint8_t bit = 0U; bit < 8U; bit++) {
+        crc = ((crc & 0x80U) != 0U) ? (uint8_t)((crc << 1) ^ 0x07U) : (uint8_t)(crc << 1);
+    }
+    return crc;
+#endif
+}
+
+/**
+ * @brief   Start an empty frame
+ * @param   frame Frame to initialize
+ * @param   type Record type carried by the frame
+ */
+void hdc_tlm_begin(hdc_tlm_frame_t* frame, hdc_tlm_type_t type)
+{
+    frame->bytes[0] = HDC_TLM_SYNC;
+    frame->bytes[1] = (uint8_t)type;
+    frame->bytes[2] = 0U;
+    frame->len = 0U;
+}
+
+/**
+ * @brief   Write LEN and CRC, completing the frame
+ * @param   frame Frame to finish
+ * @return  Total frame length in bytes
+ */
+uint8_t hdc_tlm_finish(hdc_tlm_frame_t* frame)
+{
+    uint8_t end = (uint8_t)(HDC_TLM_HEADER_BYTES + frame->len);
+    uint8_t crc = 0U;
+
+    frame->bytes[2] = frame->len;
+    for (uint8_t i = 1U; i < end; i++) {
+        crc = hdc_tlm_crc8(crc, frame->bytes[i]);
+    }
+    frame->bytes[end] = crc;
+    return (uint8_t)(end + 1U);
+}
+
+/* =============================================================================
+ * Records
+ * ========================================================================== */
+
+/**
+ * @brief   Append a raw sample record
+ * @param   frame Frame started with HDC_TLM_SAMPLE
+ * @param   channel ADC channel
+ * @param   value Sample value
+ * @return  HDC_TLM_OK, HDC_TLM_ERROR_FULL or HDC_TLM_ERROR_TYPE
+ */
+hdc_tlm_status_t hdc_tlm_add_sample(hdc_tlm_frame_t* frame, uint8_t channel, uint16_t value)
+{
+    hdc_tlm_status_t status = tlm_reserve(frame, HDC_TLM_SAMPLE, HDC_TLM_SAMPLE_BYTES);
+
+    if (status == HDC_TLM_OK) {
+        frame->bytes[HDC_TLM_HEADER_BYTES + frame->len] = channel;
+        frame->len++;
+        tlm_put_u16(frame, value);
+    }
+    return status;
+}
+
+/**
+ * @brief   Append a classification result record
+ * @param   frame Frame started with HDC_TLM_RESULT
+ * @param   class_id Class ID
+ * @param   distance Hamming distance
+ * @return  HDC_TLM_OK, HDC_TLM_ERROR_FULL or HDC_TLM_ERROR_TYPE
+ */
+hdc_tlm_status_t hdc_tlm_add_result(hdc_tlm_frame_t* frame, uint16_t class_id, uint16_t distance)
+{
+    hdc_tlm_status_t status = tlm_reserve(frame, HDC_TLM_RESULT, HDC_TLM_RESULT_BYTES);
+
+    if (status == HDC_TLM_OK) {
+        tlm_put_u16(frame, class_id);
+        tlm_put_u16(frame, distance);
+    }
+    return status;
+}
+
+/**
+ * @brief   Append a probe statistics record
+ * @param   frame Frame started with HDC_TLM_PROBE
+ * @param   id Probe identifier
+ * @param   stats Probe statistics (count saturates at 0xFFFF on the wire)
+ * @return  HDC_TLM_OK, HDC_TLM_ERROR_FULL or HDC_TLM_ERROR_TYPE
+ */
+hdc_tlm_status_t hdc_tlm_add_probe(hdc_tlm_frame_t* frame, hdc_probe_id_t id,
+                                   const hdc_probe_stats_t* stats)
+{
+    hdc_tlm_status_t status = tlm_reserve(frame, HDC_TLM_PROBE, HDC_TLM_PROBE_BYTES);
+
+    if (status == HDC_TLM_OK) {
+        uint32_t mean = (stats->count == 0U) ? 0U : (uint32_t)(stats->total / stats->count);
+
+        frame->bytes[HDC_TLM_HEADER_BYTES + frame->len] = (uint8_t)id;
+        frame->len++;
+        tlm_put_u16(frame, (stats->count > 0xFFFFU) ? 0xFFFFU : (uint16_t)stats->count);
+        tlm_put_u32(frame, stats->min);
+        tlm_put_u32(frame, stats->max);
+        tlm_put_u32(frame, mean);
+    }
+    return status;
+}
+
+/**
+ * @brief   Append an SRAM usage record
+ * @param   frame Frame started with HDC_TLM_MEMORY
+ * @param   region SRAM region
+ * @param   used Bytes in use
+ * @param   unused Bytes left
+ * @return  HDC_TLM_OK, HDC_TLM_ERROR_FULL or HDC_TLM_ERROR_TYPE
+ */
+hdc_tlm_status_t hdc_tlm_add_memory(hdc_tlm_frame_t* frame, hdc_tlm_mem_region_t region,
+                                    uint16_t used, uint16_t unused)
+{
+    hdc_tlm_status_t status = tlm_reserve(frame, HDC_TLM_MEMORY, HDC_TLM_MEMORY_BYTES);
+
+    if (status == HDC_TLM_OK) {
+        frame->bytes[HDC_TLM_HEADER_BYTES + frame->len] = (uint8_t)region;
+        frame->len++;
+        tlm_put_u16(frame, used);
+        tlm_put_u16(frame, unused);
+    }
+    return status;
+}
+
+/**
+ * @brief   Fill a frame with one fragment of a hypervector
+ * @param   frame Frame (re-started as HDC_TLM_HV)
+ * @param   hv Hypervector to send
+ * @param   offset First byte of the fragment
+ * @return  Offset of the next fragment; HV_BYTES once the vector is complete
+ */
+uint16_t hdc_tlm_hv_fragment(hdc_tlm_frame_t* frame, const hv_t hv, uint16_t offset)
+{
+    uint16_t remaining = (offset < HV_BYTES) ? (uint16_t)(HV_BYTES - offset) : 0U;
+    uint8_t chunk = (uint8_t)(HDC_TLM_MAX_PAYLOAD - HDC_TLM_HV_HEADER_BYTES);
+
+    if (remaining < chunk) {
+        chunk = (uint8_t)remaining;
+    }
+
+    hdc_tlm_begin(frame, HDC_TLM_HV);
+    tlm_put_u16(frame, offset);
+    for (uint8_t i = 0U; i < chunk; i++) {
+        frame->bytes[HDC_TLM_HEADER_BYTES + frame->len] = hv[offset + i];
+        frame->len++;
+    }
+    return (uint16_t)(offset + chunk);
+}
+
+/**
+ * @brief   Fill a frame with one fragment of a class snapshot
+ * @param   frame Frame (re-started as HDC_TLM_SNAPSHOT)
+ * @param   class_id Class the image belongs to
+ * @param   planes Counter planes in the image, or 0 for a prototype hypervector
+ * @param   image HDC_TLM_SNAPSHOT_BYTES(planes) bytes
+ * @param   offset First byte of the fragment
+ * @return  Offset of the next fragment; the image size once complete
+ */
+uint16_t hdc_tlm_snapshot_fragment(hdc_tlm_frame_t* frame, uint8_t class_id, uint8_t planes,
+                                   const uint8_t* image, uint16_t offset)
+{
+    uint16_t size = HDC_TLM_SNAPSHOT_BYTES(planes);
+    uint16_t remaining = (offset < size) ? (uint16_t)(size - offset) : 0U;
+    uint8_t chunk = (uint8_t)(HDC_TLM_MAX_PAYLOAD - HDC_TLM_SNAPSHOT_HEADER_BYTES);
+
+    if (remaining < chunk) {
+        chunk = (uint8_t)remaining;
+    }
+
+    hdc_tlm_begin(frame, HDC_TLM_SNAPSHOT);
+    frame->bytes[HDC_TLM_HEADER_BYTES] = class_id;
+    frame->bytes[HDC_TLM_HEADER_BYTES + 1U] = planes;
+    frame->len = 2U;
+    tlm_put_u16(frame, offset);
+    for (uint8_t i = 0U; i < chunk; i++) {
+        frame->bytes[HDC_TLM_HEADER_BYTES + frame->len] = image[offset + i];
+        frame->len++;
+    }
+    return (uint16_t)(offset + chunk);
+}
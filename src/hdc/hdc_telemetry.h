@@ -0,0 +1,202 @@
+/**
+ * @file    hdc_telemetry.h
+ * @brief   HDC Telemetry - Binary Framing for Samples, Hypervectors, Results
+ * @version 1.2.0
+ * @note    Portable frame builder; the host decoder is scripts/telemetry_decode.py
+ *
+ * @details Frame layout (all multi-byte fields little-endian):
+ *
+ *            +------+------+-----+-----------------+-------+
+ *            | SYNC | TYPE | LEN | payload (LEN B) | CRC-8 |
+ *            +------+------+-----+-----------------+-------+
+ *              0xA5
+ *
+ *          CRC-8 uses polynomial 0x07 with initial value 0 and covers TYPE,
+ *          LEN and the payload. A frame carries records of one type, and
+ *          sample and result records can be batched:
+ *
+ *          - HDC_TLM_SAMPLE : channel u8, value u16             (3 B each)
+ *          - HDC_TLM_HV     : offset u16, hypervector bytes     (1 per frame)
+ *          - HDC_TLM_RESULT : class u16, distance u16           (4 B each)
+ *          - HDC_TLM_PROBE  : id u8, count u16, min u32, max u32, mean u32
+ *                                                                (15 B each)
+ *          - HDC_TLM_MEMORY : region u8, used u16, unused u16   (5 B each)
+ *          - HDC_TLM_SNAPSHOT : class u8, planes u8, offset u16, image bytes
+ *                                                                (1 per frame)
+ *
+ *          A 128-bit hypervector travels as one 22-byte frame instead of
+ *          34 ASCII characters. Wider vectors are sent as fragments.
+ *
+ *          A snapshot is the learned state of one class for a gateway to
+ *          merge (src/gateway/gw_agg.h). Its image is either the bundling
+ *          counters, an hdc_counter_t of planes bit planes (LSB plane
+ *          first), or with planes = 0 the prototype hypervector alone. Send
+ *          every fragment from the same task run, so the image is never
+ *          torn by learning in between; a receiver drops any image with a
+ *          missing fragment.
+ */
+
+#ifndef HDC_TELEMETRY_H
+#define HDC_TELEMETRY_H
+
+#include <stdint.h>
+#include "hdc_core.h"
+#include "hdc_probe.h"
+
+/* =============================================================================
+ * Constants
+ * ========================================================================== */
+
+/** @brief Frame start marker */
+#define HDC_TLM_SYNC            0xA5U
+
+/** @brief Bytes before the payload (SYNC, TYPE, LEN) */
+#define HDC_TLM_HEADER_BYTES    3U
+
+/** @brief Largest payload per frame (override with -DHDC_TLM_MAX_PAYLOAD=n) */
+#ifndef HDC_TLM_MAX_PAYLOAD
+#define HDC_TLM_MAX_PAYLOAD     32U
+#endif
+
+#if (HDC_TLM_MAX_PAYLOAD < 4U) || (HDC_TLM_MAX_PAYLOAD > 250U)
+#error "HDC_TLM_MAX_PAYLOAD must be between 4 and 250"
+#endif
+
+/** @brief Largest encoded frame */
+#define HDC_TLM_FRAME_MAX       (HDC_TLM_HEADER_BYTES + HDC_TLM_MAX_PAYLOAD + 1U)
+
+/** @brief Record sizes */
+#define HDC_TLM_SAMPLE_BYTES    3U
+#define HDC_TLM_RESULT_BYTES    4U
+#define HDC_TLM_HV_HEADER_BYTES 2U
+#define HDC_TLM_PROBE_BYTES     15U
+#define HDC_TLM_MEMORY_BYTES    5U
+#define HDC_TLM_SNAPSHOT_HEADER_BYTES 4U
+
+/** @brief Snapshot image size for a plane count (0 = prototype hypervector) */
+#define HDC_TLM_SNAPSHOT_BYTES(planes) \
+    ((uint16_t)((((planes) == 0U) ? 1U : (uint16_t)(planes)) * HV_BYTES))
+
+/* =============================================================================
+ * Types
+ * ========================================================================== */
+
+/** @brief Record types */
+typedef enum {
+    HDC_TLM_SAMPLE = 0x01,
+    HDC_TLM_HV     = 0x02,
+    HDC_TLM_RESULT = 0x03,
+    HDC_TLM_PROBE  = 0x04,
+    HDC_TLM_MEMORY = 0x05,
+    HDC_TLM_SNAPSHOT = 0x06
+} hdc_tlm_type_t;
+
+/** @brief SRAM regions of HDC_TLM_MEMORY records (see hal_mem.h) */
+typedef enum {
+    HDC_TLM_MEM_DATA  = 0x00,   /**< .data: used = bytes, unused = 0 */
+    HDC_TLM_MEM_BSS   = 0x01,   /**< .bss: used = bytes, unused = 0 */
+    HDC_TLM_MEM_STACK = 0x02    /**< used = high-water mark, unused = never touched */
+} hdc_tlm_mem_region_t;
+
+/** @brief Telemetry status codes */
+typedef enum {
+    HDC_TLM_OK = 0,
+    HDC_TLM_ERROR_FULL,     /**< Record does not fit; finish and start a new frame */
+    HDC_TLM_ERROR_TYPE      /**< Record type differs from the frame type */
+} hdc_tlm_status_t;
+
+/** @brief Frame under construction */
+typedef struct {
+    uint8_t bytes[HDC_TLM_FRAME_MAX];   /**< Encoded frame */
+    uint8_t len;                        /**< Payload bytes written */
+} hdc_tlm_frame_t;
+
+/* =============================================================================
+ * Function Declarations
+ * ========================================================================== */
+
+/**
+ * @brief   Update a CRC-8 (poly 0x07, MSB first) with one byte
+ * @param   crc Current CRC (0 to start)
+ * @param   data Byte to add
+ * @return  Updated CRC
+ */
+uint8_t hdc_tlm_crc8(uint8_t crc, uint8_t data);
+
+/**
+ * @brief   Start an empty frame
+ * @param   frame Frame to initialize
+ * @param   type Record type carried by the frame
+ */
+void hdc_tlm_begin(hdc_tlm_frame_t* frame, hdc_tlm_type_t type);
+
+/**
+ * @brief   Append a raw sample record
+ * @param   frame Frame started with HDC_TLM_SAMPLE
+ * @param   channel ADC channel
+ * @param   value Sample value
+ * @return  HDC_TLM_OK, HDC_TLM_ERROR_FULL or HDC_TLM_ERROR_TYPE
+ */
+hdc_tlm_status_t hdc_tlm_add_sample(hdc_tlm_frame_t* frame, uint8_t channel, uint16_t value);
+
+/**
+ * @brief   Append a classification result record
+ * @param   frame Frame started with HDC_TLM_RESULT
+ * @param   class_id Class ID
+ * @param   distance Hamming distance
+ * @return  HDC_TLM_OK, HDC_TLM_ERROR_FULL or HDC_TLM_ERROR_TYPE
+ */
+hdc_tlm_status_t hdc_tlm_add_result(hdc_tlm_frame_t* frame, uint16_t class_id, uint16_t distance);
+
+/**
+ * @brief   Append a probe statistics record
+ * @param   frame Frame started with HDC_TLM_PROBE
+ * @param   id Probe identifier
+ * @param   stats Probe statistics (count saturates at 0xFFFF on the wire)
+ * @return  HDC_TLM_OK, HDC_TLM_ERROR_FULL or HDC_TLM_ERROR_TYPE
+ */
+hdc_tlm_status_t hdc_tlm_add_probe(hdc_tlm_frame_t* frame, hdc_probe_id_t id,
+                                   const hdc_probe_stats_t* stats);
+
+/**
+ * @brief   Append an SRAM usage record
+ * @param   frame Frame started with HDC_TLM_MEMORY
+ * @param   region SRAM region
+ * @param   used Bytes in use (for the stack, the deepest use seen)
+ * @param   unused Bytes left (for the stack, the headroom never touched)
+ * @return  HDC_TLM_OK, HDC_TLM_ERROR_FULL or HDC_TLM_ERROR_TYPE
+ */
+hdc_tlm_status_t hdc_tlm_add_memory(hdc_tlm_frame_t* frame, hdc_tlm_mem_region_t region,
+                                    uint16_t used, uint16_t unused);
+
+/**
+ * @brief   Fill a frame with one fragment of a hypervector
+ * @param   frame Frame started with HDC_TLM_HV (its payload is replaced)
+ * @param   hv Hypervector to send
+ * @param   offset First byte of the fragment
+ * @return  Offset of the next fragment; HV_BYTES once the vector is complete
+ */
+uint16_t hdc_tlm_hv_fragment(hdc_tlm_frame_t* frame, const hv_t hv, uint16_t offset);
+
+/**
+ * @brief   Fill a frame with one fragment of a class snapshot
+ * @param   frame Frame (re-started as HDC_TLM_SNAPSHOT)
+ * @param   class_id Class the image belongs to
+ * @param   planes Counter planes in the image, or 0 for a prototype hypervector
+ * @param   image HDC_TLM_SNAPSHOT_BYTES(planes) bytes: hdc_counter_t planes,
+ *          or the hypervector
+ * @param   offset First byte of the fragment
+ * @return  Offset of the next fragment; HDC_TLM_SNAPSHOT_BYTES(planes) once
+ *          the image is complete
+ */
+uint16_t hdc_tlm_snapshot_fragment(hdc_tlm_frame_t* frame, uint8_t class_id, uint8_t planes,
+                                   const uint8_t* image, uint16_t offset);
+
+/**
+ * @brief   Write LEN and CRC, completing the frame
+ * @param   frame Frame to finish
+ * @return  Total frame length in bytes; send frame->bytes[0..length)
+ */
+uint8_t hdc_tlm_finish(hdc_tlm_frame_t* frame);
+
+#endif /* HDC_TELEMETRY_H */
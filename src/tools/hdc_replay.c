@@ -0,0 +1,170 @@
+/**
+ * @file    hdc_replay.c
+ * @brief   Trace Replay Tool - Offline Evaluation of the Device Pipeline
+ * @version 1.0.0
+ * @note    Host only. Build and run with:
+ *            pio run -e replay
+ *            .pio/build/replay/program [options] trace.csv
+ *
+ * @details Replays a recorded trace (gw_trace.h) through gw_replay_run() and
+ *          prints the accuracy, the time per stage and the throughput. The
+ *          last line is a single REPLAY,... CSV row, so a shell loop over
+ *          options (or over the replay_* widths) collects a sweep.
+ *
+ *          hdc_replay [-s seed] [-w window] [-t test_every] [-m max_value]
+ *                     [-c channels] [-k classes] [-r repeats] [-b] trace
+ *
+ *          Training follows the device's mistake-driven rule (hdc_learn.h);
+ *          -b bundles every training window instead.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "hdc_core.h"
+#include "hdc_kernel.h"
+#include "hdc_counter.h"
+#include "gw_trace.h"
+#include "gw_replay.h"
+
+/* =============================================================================
+ * Definitions
+ * ========================================================================== */
+
+/** @brief Most classes the tool allocates for */
+#define REPLAY_MAX_CLASSES      256U
+
+static hdc_counter_t s_counters[REPLAY_MAX_CLASSES];
+static hv_t s_rows[REPLAY_MAX_CLASSES];
+static hdc_counter_mask_t s_masks[2U * REPLAY_MAX_CLASSES];
+
+/* =============================================================================
+ * Helpers
+ * ========================================================================== */
+
+static void usage(const char* argv0)
+{
+    fprintf(stderr,
+            "usage: %s [-s seed] [-w window] [-t test_every] [-m max_value]\n"
+            "          [-c channels] [-k classes] [-r repeats] [-b] trace\n", argv0);
+}
+
+/** @brief Parse an unsigned option value with a range check */
+static int parse_uint(const char* text, unsigned long max, unsigned long* p_value)
+{
+    char* end = NULL;
+    unsigned long v = strtoul(text, &end, 0);
+
+    if ((end == text) || (*end != '\0') || (v > max)) {
+        return -1;
+    }
+    *p_value = v;
+    return 0;
+}
+
+static double per_window_ns(uint64_t ns, uint64_t windows)
+{
+    return (windows == 0U) ? 0.0 : ((double)ns / (double)windows);
+}
+
+/* =============================================================================
+ * Main
+ * ========================================================================== */
+
+int main(int argc, char** argv)
+{
+    gw_replay_config_t config;
+    gw_replay_report_t report, best;
+    gw_trace_t trace;
+    unsigned long v, repeats = 1U;
+    int opt;
+
+    gw_replay_defaults(&config, 2U);
+    while ((opt = getopt(argc, argv, "s:w:t:m:c:k:r:bh")) != -1) {
+        int bad = 0;
+        switch (opt) {
+            case 's': bad = parse_uint(optarg, 0xFFFFFFFFUL, &v); config.item_seed = (uint32_t)v; break;
+            case 'w': bad = parse_uint(optarg, 0xFFFFU, &v); config.window = (uint16_t)v; break;
+            case 't': bad = parse_uint(optarg, 0xFFFFU, &v); config.test_every = (uint16_t)v; break;
+            case 'm': bad = parse_uint(optarg, 0xFFFFU, &v); config.max_value = (uint16_t)v; break;
+            case 'c': bad = parse_uint(optarg, GW_TRACE_MAX_CHANNELS, &v); config.channels = (uint8_t)v; break;
+            case 'k': bad = parse_uint(optarg, REPLAY_MAX_CLASSES, &v); config.num_classes = (hdc_class_t)v; break;
+            case 'r': bad = parse_uint(optarg, 1000U, &v); repeats = (v == 0U) ? 1U : v; break;
+            case 'b': config.learn = false; break;
+            default:  usage(argv[0]); return 2;
+        }
+        if (bad != 0) {
+            fprintf(stderr, "bad value for -%c: %s\n", opt, optarg);
+            return 2;
+        }
+    }
+    if (optind != (argc - 1)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    gw_trace_status_t ts = gw_trace_open(&trace, argv[optind]);
+    if (ts != GW_TRACE_OK) {
+        fprintf(stderr, "%s: %s\n", argv[optind],
+                (ts == GW_TRACE_ERROR_IO) ? "cannot open" : "not a trace");
+        return 1;
+    }
+
+    /* Repeats warm the page cache and CPU clocks; the fastest run is kept */
+    for (unsigned long r = 0U; r < repeats; r++) {
+        gw_replay_status_t rs = gw_replay_run(&config, &trace, s_counters, s_rows, s_masks, &report);
+        if (rs != GW_REPLAY_OK) {
+            if ((rs == GW_REPLAY_ERROR_TRACE) && (trace.kind == GW_TRACE_CSV)) {
+                fprintf(stderr, "%s:%u: malformed record\n", argv[optind], (unsigned)trace.line);
+            } else if (rs == GW_REPLAY_ERROR_TRACE) {
+                fprintf(stderr, "%s: malformed record %u at byte %zu\n", argv[optind],
+                        (unsigned)trace.index, trace.pos);
+            } else {
+                fprintf(stderr, "invalid settings for this trace\n");
+            }
+            gw_trace_close(&trace);
+            return 1;
+        }
+        if ((r == 0U) || (report.total_ns < best.total_ns)) {
+            best = report;
+        }
+    }
+
+    uint8_t channels = (config.channels == 0U) ? trace.channels : config.channels;
+    double seconds = (double)best.total_ns / 1e9;
+    double accuracy = (best.tested == 0U) ? 0.0 : (100.0 * (double)best.correct / (double)best.tested);
+    double rate = (seconds > 0.0) ? ((double)(2U * best.records) / seconds) : 0.0;
+
+    printf("trace      %s (%s, %u channels, %llu records, %llu skipped)\n", argv[optind],
+           (trace.kind == GW_TRACE_BINARY) ? "binary" : "csv", (unsigned)trace.channels,
+           (unsigned long long)best.records, (unsigned long long)best.skipped);
+    printf("model      %u dims, backend %s, %u channels, %u classes, window %u, seed 0x%08lX, %s\n",
+           (unsigned)HV_DIMENSIONS, HDC_KERNEL_NAME, (unsigned)channels,
+           (unsigned)config.num_classes, (unsigned)config.window, (unsigned long)config.item_seed,
+           config.learn ? "learn" : "bundle");
+    printf("windows    %llu (%llu trained, %llu updated, %llu tested)\n",
+           (unsigned long long)best.windows, (unsigned long long)best.trained,
+           (unsigned long long)best.updated, (unsigned long long)best.tested);
+    printf("accuracy   %.2f %% (%llu / %llu)\n", accuracy,
+           (unsigned long long)best.correct, (unsigned long long)best.tested);
+    printf("read       %12.1f ns/window\n", per_window_ns(best.read_ns, best.trained + best.tested));
+    printf("encode     %12.1f ns/window\n", per_window_ns(best.encode_ns, best.trained + best.tested));
+    printf("bundle     %12.1f ns/window\n", per_window_ns(best.bundle_ns, best.trained));
+    printf("query      %12.1f ns/window\n", per_window_ns(best.query_ns, best.tested));
+    printf("total      %.6f s, %.0f records/s\n", seconds, rate);
+    printf("REPLAY,%u,%s,%u,%u,%u,%u,%llu,%llu,%llu,%.4f,%llu,%llu,%llu,%llu,%llu,%s\n",
+           (unsigned)HV_DIMENSIONS, HDC_KERNEL_NAME, (unsigned)channels,
+           (unsigned)config.window, (unsigned)config.max_value, (unsigned)config.num_classes,
+           (unsigned long long)best.records, (unsigned long long)best.tested,
+           (unsigned long long)best.correct, accuracy,
+           (unsigned long long)best.read_ns, (unsigned long long)best.encode_ns,
+           (unsigned long long)best.bundle_ns, (unsigned long long)best.query_ns,
+           (unsigned long long)best.total_ns, config.learn ? "learn" : "bundle");
+
+    gw_trace_close(&trace);
+    return 0;
+}
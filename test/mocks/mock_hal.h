@@ -17,6 +17,9 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include "hal/hal_ring.h"
+#include "hal/hal_frame.h"
+
 /* ============================================================================
  * Mock Configuration
  * ============================================================================ */
@@ -24,6 +27,7 @@
 #define MOCK_ADC_CHANNELS   8U
 #define MOCK_GPIO_PINS      20U
 #define MOCK_UART_BUFFER    256U
+#define MOCK_ADC_STREAM_BUFFER 32U
 
 /* ============================================================================
  * Types (matching real HAL)
@@ -43,9 +47,29 @@ typedef uint8_t adc_channel_t;
 #define ADC_CHANNEL_0       0U
 #define ADC_MAX_VALUE       1023U
 #define ADC_ERROR_VALUE     0xFFFFU
+#define ADC_STREAM_MAX_CHANNELS 8U
+#define ADC_OVERSAMPLE_MAX_BITS 6U
+#define ADC_SCAN_MAX_CHANNELS   HAL_FRAME_MAX_VALUES
+#define ADC_SCAN_MASK(ch)       ((uint16_t)(1U << (ch)))
+#define ADC_SAMPLE_CHANNEL(s)   ((adc_channel_t)((uint16_t)(s) >> 12))
+#define ADC_SAMPLE_VALUE(s)     ((uint16_t)((s) & 0x03FFU))
+
+/** @brief SRAM usage (matching hal_mem.h) */
+#define HAL_MEM_PAINT       0xC5U
+typedef struct {
+    uint16_t data_bytes;
+    uint16_t bss_bytes;
+    uint16_t stack_bytes;
+    uint16_t stack_peak;
+} hal_mem_usage_t;
 
 typedef enum { GPIO_OK = 0, GPIO_ERROR_INVALID_PIN } gpio_status_t;
-typedef enum { ADC_OK = 0, ADC_ERROR_INVALID_CHANNEL, ADC_ERROR_TIMEOUT } adc_status_t;
+typedef enum {
+    ADC_OK = 0, ADC_ERROR_INVALID_CHANNEL, ADC_ERROR_TIMEOUT, ADC_ERROR_BUSY, ADC_ERROR_EMPTY
+} adc_status_t;
+typedef enum {
+    ADC_SCAN_ONE_SHOT = 0, ADC_SCAN_CONTINUOUS, ADC_SCAN_QUIET_ONE_SHOT, ADC_SCAN_QUIET_CONTINUOUS
+} adc_scan_mode_t;
 typedef enum { UART_OK = 0, UART_ERROR_TIMEOUT, UART_ERROR_OVERFLOW } uart_status_t;
 
 /* ============================================================================
@@ -65,16 +89,39 @@ typedef struct {
     uint32_t     adc_read_count;
     bool         adc_timeout_enabled;
 
+    /* ADC streaming mock state (conversions driven by mock_adc_stream_convert) */
+    bool              adc_stream_active;
+    adc_channel_t     adc_stream_channels[ADC_STREAM_MAX_CHANNELS];
+    uint8_t           adc_stream_num_channels;
+    uint8_t           adc_stream_next;
+    volatile uint16_t adc_stream_storage[MOCK_ADC_STREAM_BUFFER];
+    hal_ring16_t      adc_stream_ring;
+    uint16_t          adc_stream_overruns;
+
+    /* ADC scan mock state (frames driven by mock_adc_scan_convert) */
+    bool               adc_scan_active;
+    bool               adc_scan_continuous;
+    uint16_t           adc_scan_mask;
+    hal_frame_buffer_t adc_scan_frames;
+
     /* UART mock state */
     char         uart_tx_buffer[MOCK_UART_BUFFER];
     uint16_t     uart_tx_index;
     uint32_t     uart_putc_count;
     bool         uart_timeout_enabled;
+    bool         uart_async_enabled;
+
+    /* Timer mock state (advanced by mock_timer_advance) */
+    uint32_t     timer_millis;
+
+    /* SRAM mock state (set by the test, returned by hal_mem_usage) */
+    hal_mem_usage_t mem_usage;
 
     /* Initialization tracking */
     bool         gpio_initialized;
     bool         uart_initialized;
     bool         adc_initialized;
+    bool         timer_initialized;
 
 } mock_hal_state_t;
 
@@ -116,6 +163,55 @@ static inline void mock_adc_set_timeout(bool enable)
     g_mock_hal.adc_timeout_enabled = enable;
 }
 
+/**
+ * @brief   Simulate completed streaming conversions (stands in for ADC_vect)
+ * @param   conversions Number of conversions to complete
+ */
+static inline void mock_adc_stream_convert(uint16_t conversions)
+{
+    for (uint16_t i = 0U; (i < conversions) && g_mock_hal.adc_stream_active; i++) {
+        adc_channel_t ch = g_mock_hal.adc_stream_channels[g_mock_hal.adc_stream_next];
+        uint16_t value = (ch < MOCK_ADC_CHANNELS) ? g_mock_hal.adc_values[ch] : 0U;
+
+        if (!hal_ring16_push(&g_mock_hal.adc_stream_ring,
+                             (uint16_t)(((uint16_t)ch << 12) | (value & 0x03FFU)))) {
+            g_mock_hal.adc_stream_overruns++;
+        }
+        g_mock_hal.adc_stream_next++;
+        if (g_mock_hal.adc_stream_next >= g_mock_hal.adc_stream_num_channels) {
+            g_mock_hal.adc_stream_next = 0U;
+        }
+    }
+}
+
+/**
+ * @brief   Simulate completed scan frames (stands in for ADC_vect)
+ * @param   frames Number of frames to complete; each is stamped with the
+ *          current mock tick
+ */
+static inline void mock_adc_scan_convert(uint16_t frames)
+{
+    for (uint16_t i = 0U; (i < frames) && g_mock_hal.adc_scan_active; i++) {
+        hal_frame_t* frame = hal_frame_begin(&g_mock_hal.adc_scan_frames, g_mock_hal.timer_millis);
+        for (uint8_t ch = 0U; ch < 16U; ch++) {
+            if ((g_mock_hal.adc_scan_mask & ADC_SCAN_MASK(ch)) != 0U) {
+                (void)hal_frame_put(frame, (ch < MOCK_ADC_CHANNELS) ? g_mock_hal.adc_values[ch] : 0U);
+            }
+        }
+        hal_frame_publish(&g_mock_hal.adc_scan_frames);
+        g_mock_hal.adc_scan_active = g_mock_hal.adc_scan_continuous;
+    }
+}
+
+/**
+ * @brief   Simulate elapsed system ticks (stands in for TIMER2_COMPA_vect)
+ * @param   ms Milliseconds to add
+ */
+static inline void mock_timer_advance(uint32_t ms)
+{
+    g_mock_hal.timer_millis += ms;
+}
+
 /**
  * @brief   Get UART TX buffer contents
  */
@@ -207,11 +303,111 @@ static inline uint16_t hal_adc_read_averaged(adc_channel_t channel, uint8_t samp
     return hal_adc_read(channel);
 }
 
+static inline adc_status_t hal_adc_read_oversampled(adc_channel_t channel, uint8_t extra_bits,
+                                                    uint16_t* p_value)
+{
+    /* A noiseless input decimates to the value scaled by 2^extra_bits */
+    uint16_t value = ADC_ERROR_VALUE;
+    adc_status_t status = ADC_ERROR_INVALID_CHANNEL;
+
+    if ((channel < MOCK_ADC_CHANNELS) && (extra_bits <= ADC_OVERSAMPLE_MAX_BITS)) {
+        status = g_mock_hal.adc_timeout_enabled ? ADC_ERROR_TIMEOUT : ADC_OK;
+        if (status == ADC_OK) {
+            g_mock_hal.adc_read_count++;
+            value = (uint16_t)(g_mock_hal.adc_values[channel] << extra_bits);
+        }
+    }
+    if (p_value != NULL) {
+        *p_value = value;
+    }
+    return status;
+}
+
+static inline adc_status_t hal_adc_read_quiet(adc_channel_t channel, uint16_t* p_value)
+{
+    return hal_adc_read_oversampled(channel, 0U, p_value);
+}
+
 static inline uint16_t hal_adc_to_millivolts(uint16_t adc_value)
 {
     return (uint16_t)(((uint32_t)adc_value * 5000UL) / 1024UL);
 }
 
+static inline adc_status_t hal_adc_stream_start(const adc_channel_t* channels, uint8_t num_channels)
+{
+    if ((channels == NULL) || (num_channels == 0U) || (num_channels > ADC_STREAM_MAX_CHANNELS)) {
+        return ADC_ERROR_INVALID_CHANNEL;
+    }
+    memcpy(g_mock_hal.adc_stream_channels, channels, num_channels);
+    g_mock_hal.adc_stream_num_channels = num_channels;
+    g_mock_hal.adc_stream_next = 0U;
+    g_mock_hal.adc_stream_overruns = 0U;
+    hal_ring16_init(&g_mock_hal.adc_stream_ring, g_mock_hal.adc_stream_storage, MOCK_ADC_STREAM_BUFFER);
+    g_mock_hal.adc_stream_active = true;
+    return ADC_OK;
+}
+
+static inline void hal_adc_stream_stop(void)
+{
+    g_mock_hal.adc_stream_active = false;
+}
+
+static inline adc_status_t hal_adc_stream_read(uint16_t* p_sample)
+{
+    return hal_ring16_pop(&g_mock_hal.adc_stream_ring, p_sample) ? ADC_OK : ADC_ERROR_EMPTY;
+}
+
+static inline uint8_t hal_adc_stream_available(void)
+{
+    return hal_ring16_count(&g_mock_hal.adc_stream_ring);
+}
+
+static inline uint16_t hal_adc_stream_overruns(void)
+{
+    return g_mock_hal.adc_stream_overruns;
+}
+
+static inline adc_status_t hal_adc_scan_start(uint16_t channel_mask, adc_scan_mode_t mode)
+{
+    uint8_t count = 0U;
+    for (uint8_t ch = 0U; ch < 16U; ch++) {
+        count = (uint8_t)(count + ((channel_mask >> ch) & 1U));
+    }
+    if ((count == 0U) || (count > ADC_SCAN_MAX_CHANNELS)) {
+        return ADC_ERROR_INVALID_CHANNEL;
+    }
+    g_mock_hal.adc_scan_mask = channel_mask;
+    g_mock_hal.adc_scan_continuous = (mode == ADC_SCAN_CONTINUOUS) || (mode == ADC_SCAN_QUIET_CONTINUOUS);
+    hal_frame_init(&g_mock_hal.adc_scan_frames);
+    g_mock_hal.adc_scan_active = true;
+    return ADC_OK;
+}
+
+static inline void hal_adc_scan_stop(void)
+{
+    g_mock_hal.adc_scan_active = false;
+}
+
+static inline bool hal_adc_scan_busy(void)
+{
+    return g_mock_hal.adc_scan_active;
+}
+
+static inline const hal_frame_t* hal_adc_scan_acquire(void)
+{
+    return hal_frame_acquire(&g_mock_hal.adc_scan_frames);
+}
+
+static inline void hal_adc_scan_release(void)
+{
+    hal_frame_release(&g_mock_hal.adc_scan_frames);
+}
+
+static inline uint16_t hal_adc_scan_dropped(void)
+{
+    return hal_frame_dropped(&g_mock_hal.adc_scan_frames);
+}
+
 /* UART */
 static inline void hal_uart_init(void)
 {
@@ -228,6 +424,33 @@ static inline void hal_uart_putc(uint8_t data)
     g_mock_hal.uart_putc_count++;
 }
 
+static inline void hal_uart_async_enable(void)
+{
+    g_mock_hal.uart_async_enabled = true;
+}
+
+static inline uint8_t hal_uart_tx_free(void)
+{
+    uint16_t free_bytes = (uint16_t)(MOCK_UART_BUFFER - 1U - g_mock_hal.uart_tx_index);
+    return g_mock_hal.uart_async_enabled ? (uint8_t)((free_bytes > 255U) ? 255U : free_bytes) : 0U;
+}
+
+static inline uart_status_t hal_uart_write_nb(const uint8_t* data, uint8_t len)
+{
+    if (hal_uart_tx_free() < len) {
+        return UART_ERROR_OVERFLOW;
+    }
+    for (uint8_t i = 0U; i < len; i++) {
+        hal_uart_putc(data[i]);
+    }
+    return UART_OK;
+}
+
+static inline uart_status_t hal_uart_puts_nb(const char* str)
+{
+    return hal_uart_write_nb((const uint8_t*)str, (uint8_t)strlen(str));
+}
+
 static inline void hal_uart_puts(const char* str)
 {
     while (*str != '\0') {
@@ -269,12 +492,36 @@ static inline void hal_uart_print_hex8(uint8_t byte)
     hal_uart_putc(hex[byte & 0x0FU]);
 }
 
+/* Timer */
+static inline void hal_timer_init(void)
+{
+    g_mock_hal.timer_initialized = true;
+    g_mock_hal.timer_millis = 0U;
+}
+
+static inline uint32_t hal_timer_millis(void)
+{
+    return g_mock_hal.timer_millis;
+}
+
+/* SRAM usage */
+static inline uint16_t hal_mem_stack_unused(void)
+{
+    return (uint16_t)(g_mock_hal.mem_usage.stack_bytes - g_mock_hal.mem_usage.stack_peak);
+}
+
+static inline void hal_mem_usage(hal_mem_usage_t* usage)
+{
+    *usage = g_mock_hal.mem_usage;
+}
+
 /* Master init */
 static inline void hal_init(void)
 {
     hal_gpio_init();
     hal_uart_init();
     hal_adc_init();
+    hal_timer_init();
 }
 
 #endif /* MOCK_HAL_H */
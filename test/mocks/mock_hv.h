@@ -0,0 +1,55 @@
+/**
+ * @file    mock_hv.h
+ * @brief   Deterministic Hypervector Fixtures for Unit Testing
+ * @version 1.0.0
+ *
+ * @details Test inputs and noise that must not depend on the item memory
+ *          under test (hdc_item.h). The same seed gives the same bytes on
+ *          every host and at every HV_DIMENSIONS prefix.
+ */
+
+#ifndef MOCK_HV_H
+#define MOCK_HV_H
+
+#include <stdint.h>
+
+#include "hdc/hdc_core.h"
+
+/**
+ * @brief Next value of the LCG behind fill_pseudo_random()
+ * @param state Generator state, advanced by one step
+ * @return 16 pseudo-random bits (e.g. noise on an ADC value)
+ */
+static inline uint16_t pseudo_random_next(uint32_t* state)
+{
+    *state = (*state * 1103515245UL) + 12345UL;
+    return (uint16_t)(*state >> 16);
+}
+
+/**
+ * @brief Deterministic pseudo-random fill (LCG)
+ * @param hv Vector to fill
+ * @param seed Any value; equal seeds give equal vectors
+ */
+static inline void fill_pseudo_random(hv_t hv, uint32_t seed)
+{
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        hv[i] = (uint8_t)pseudo_random_next(&seed);
+    }
+}
+
+/**
+ * @brief Flip pseudo-random bits in place (about 1/4 of the bits in mask)
+ * @param hv Vector to perturb
+ * @param seed Any value; equal seeds flip equal bits
+ * @param mask Bits of each byte that may flip
+ */
+static inline void add_noise(hv_t hv, uint32_t seed, uint8_t mask)
+{
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        seed = (seed * 1103515245UL) + 12345UL;
+        hv[i] ^= (uint8_t)((seed >> 16) & (seed >> 8) & mask);
+    }
+}
+
+#endif /* MOCK_HV_H */
@@ -0,0 +1,215 @@
+/**
+ * @file    test_app_sched.c
+ * @brief   Unit Tests for the Cooperative Task Scheduler
+ * @version 1.0.0
+ *
+ * @details Tests for the fixed-period scheduler:
+ *          - Registration: invalid arguments, full table
+ *          - Periods: release counts, phase offsets, registration order
+ *          - Lateness: missed releases are skipped, grid is kept
+ *          - Wrap: 16-bit tick counter rollover
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ *          sched.c is portable; time is driven by the test.
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "app/sched.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TRACE_MAX   64U
+
+static sched_t s_sched;
+static uint16_t s_now;
+static uint16_t s_runs_a;
+static uint16_t s_runs_b;
+static uint16_t s_last_a;
+static char s_trace[TRACE_MAX];
+static uint8_t s_trace_len;
+
+static void trace(char c)
+{
+    if (s_trace_len < (TRACE_MAX - 1U)) {
+        s_trace[s_trace_len] = c;
+        s_trace_len++;
+    }
+}
+
+static void task_a(void)
+{
+    s_runs_a++;
+    s_last_a = s_now;
+    trace('a');
+}
+
+static void task_b(void)
+{
+    s_runs_b++;
+    trace('b');
+}
+
+/**
+ * @brief Advance time one tick at a time, running the scheduler each tick
+ */
+static void run_ticks(uint16_t ticks)
+{
+    for (uint16_t i = 0U; i < ticks; i++) {
+        (void)sched_run(&s_sched, s_now);
+        s_now++;
+    }
+}
+
+void setUp(void)
+{
+    sched_init(&s_sched);
+    s_now = 0U;
+    s_runs_a = 0U;
+    s_runs_b = 0U;
+    s_last_a = 0U;
+    memset(s_trace, 0, sizeof(s_trace));
+    s_trace_len = 0U;
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/* ============================================================================
+ * Registration Tests
+ * ============================================================================ */
+
+void test_add_rejects_invalid_tasks(void)
+{
+    TEST_ASSERT_EQUAL(SCHED_ERROR_INVALID, sched_add(&s_sched, NULL, 10U, 0U));
+    TEST_ASSERT_EQUAL(SCHED_ERROR_INVALID, sched_add(&s_sched, task_a, 0U, 0U));
+    TEST_ASSERT_EQUAL(SCHED_ERROR_INVALID, sched_add(&s_sched, task_a, SCHED_MAX_PERIOD + 1U, 0U));
+    TEST_ASSERT_EQUAL_UINT8(0U, s_sched.count);
+}
+
+void test_add_rejects_when_full(void)
+{
+    for (uint8_t i = 0U; i < SCHED_MAX_TASKS; i++) {
+        TEST_ASSERT_EQUAL(SCHED_OK, sched_add(&s_sched, task_a, 10U, 0U));
+    }
+    TEST_ASSERT_EQUAL(SCHED_ERROR_FULL, sched_add(&s_sched, task_b, 10U, 0U));
+}
+
+/* ============================================================================
+ * Period Tests
+ * ============================================================================ */
+
+void test_tasks_release_at_their_period(void)
+{
+    TEST_ASSERT_EQUAL(SCHED_OK, sched_add(&s_sched, task_a, 10U, 0U));
+    TEST_ASSERT_EQUAL(SCHED_OK, sched_add(&s_sched, task_b, 25U, 0U));
+
+    run_ticks(100U);
+
+    TEST_ASSERT_EQUAL_UINT16(10U, s_runs_a);   /* 0, 10, ..., 90 */
+    TEST_ASSERT_EQUAL_UINT16(4U, s_runs_b);    /* 0, 25, 50, 75 */
+    TEST_ASSERT_EQUAL_UINT16(90U, s_last_a);
+}
+
+void test_phase_offset_and_order(void)
+{
+    /* b is registered first, so it runs first when both are due */
+    TEST_ASSERT_EQUAL(SCHED_OK, sched_add(&s_sched, task_b, 10U, 5U));
+    TEST_ASSERT_EQUAL(SCHED_OK, sched_add(&s_sched, task_a, 5U, 0U));
+
+    run_ticks(16U);
+
+    TEST_ASSERT_EQUAL_STRING("abaaba", s_trace);  /* 0:a 5:ba 10:a 15:ba */
+}
+
+void test_nothing_pending_between_releases(void)
+{
+    TEST_ASSERT_EQUAL(SCHED_OK, sched_add(&s_sched, task_a, 10U, 3U));
+
+    TEST_ASSERT_FALSE(sched_pending(&s_sched, 0U));
+    TEST_ASSERT_EQUAL_UINT8(0U, sched_run(&s_sched, 2U));
+    TEST_ASSERT_TRUE(sched_pending(&s_sched, 3U));
+    TEST_ASSERT_EQUAL_UINT8(1U, sched_run(&s_sched, 3U));
+    TEST_ASSERT_EQUAL_UINT8(0U, sched_run(&s_sched, 3U));
+    TEST_ASSERT_FALSE(sched_pending(&s_sched, 12U));
+}
+
+/* ============================================================================
+ * Lateness Tests
+ * ============================================================================ */
+
+void test_late_task_skips_missed_releases(void)
+{
+    TEST_ASSERT_EQUAL(SCHED_OK, sched_add(&s_sched, task_a, 10U, 0U));
+
+    TEST_ASSERT_EQUAL_UINT8(1U, sched_run(&s_sched, 0U));
+
+    /* Stalled until tick 37: the 10, 20, 30 releases collapse into one run */
+    TEST_ASSERT_EQUAL_UINT8(1U, sched_run(&s_sched, 37U));
+    TEST_ASSERT_EQUAL_UINT16(2U, s_runs_a);
+    TEST_ASSERT_EQUAL_UINT16(2U, s_sched.tasks[0].missed);
+
+    /* The grid is kept: next release at 40, not 47 */
+    TEST_ASSERT_EQUAL_UINT16(40U, s_sched.tasks[0].due);
+    TEST_ASSERT_EQUAL_UINT8(0U, sched_run(&s_sched, 39U));
+    TEST_ASSERT_EQUAL_UINT8(1U, sched_run(&s_sched, 40U));
+}
+
+void test_slightly_late_task_keeps_phase(void)
+{
+    TEST_ASSERT_EQUAL(SCHED_OK, sched_add(&s_sched, task_a, 10U, 0U));
+
+    TEST_ASSERT_EQUAL_UINT8(1U, sched_run(&s_sched, 4U));
+    TEST_ASSERT_EQUAL_UINT16(10U, s_sched.tasks[0].due);
+    TEST_ASSERT_EQUAL_UINT16(0U, s_sched.tasks[0].missed);
+}
+
+/* ============================================================================
+ * Wrap Tests
+ * ============================================================================ */
+
+void test_tick_counter_wraps(void)
+{
+    s_now = 0xFFF0U;
+    TEST_ASSERT_EQUAL(SCHED_OK, sched_add(&s_sched, task_a, 8U, s_now));
+
+    run_ticks(64U);
+
+    TEST_ASSERT_EQUAL_UINT16(8U, s_runs_a);
+    TEST_ASSERT_EQUAL_UINT16(0x0028U, s_last_a);
+    TEST_ASSERT_EQUAL_UINT16(0U, s_sched.tasks[0].missed);
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Registration tests */
+    RUN_TEST(test_add_rejects_invalid_tasks);
+    RUN_TEST(test_add_rejects_when_full);
+
+    /* Period tests */
+    RUN_TEST(test_tasks_release_at_their_period);
+    RUN_TEST(test_phase_offset_and_order);
+    RUN_TEST(test_nothing_pending_between_releases);
+
+    /* Lateness tests */
+    RUN_TEST(test_late_task_skips_missed_releases);
+    RUN_TEST(test_slightly_late_task_keeps_phase);
+
+    /* Wrap tests */
+    RUN_TEST(test_tick_counter_wraps);
+
+    return UNITY_END();
+}
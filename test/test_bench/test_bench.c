@@ -0,0 +1,483 @@
+/**
+ * @file    test_bench.c
+ * @brief   Benchmarks for HDC Core, Encoding and Associative Memory
+ * @version 1.2.0
+ *
+ * @details Times every hdc_core.c / hdc_encode.c entry point and the
+ *          associative-memory searches, and prints one CSV row per case:
+ *
+ *            BENCH,kernel,dims,op,param,iters,total_ticks,latency_ticks,unit
+ *
+ *          - total_ticks / iters is the throughput cost per call; the loop
+ *            doubles iters until it runs for at least BENCH_MIN_TICKS
+ *          - latency_ticks is the fastest of BENCH_LATENCY_RUNS single calls
+ *            with the clock overhead removed
+ *          - unit is "cycles" on AVR (Timer1, exact on simavr) and "ns" on
+ *            the host (CLOCK_MONOTONIC)
+ *          - param is the class count for AM searches, the channel count
+ *            for multi-channel encoding, the shift for permute, the window
+ *            length for seq_push, and 0 otherwise
+ *          - _P rows read their second operand from flash (hdc_pgm.h)
+ *          - _fixed rows use the hdc_encode_fixed.h specializations for
+ *            ADC_MAX and the same channel counts as the generic rows
+ *          - _near rows (host only) search BENCH_AMT_CLASSES classes with a
+ *            query close to one of them, row store (am_) against the
+ *            transposed store (amt_, hdc_amt.h)
+ *
+ *          On AVR a last case prints the SRAM figures from hal_mem.h,
+ *
+ *            MEMORY,data,bss,stack_bytes,stack_peak
+ *
+ *          and fails the run if the stack high-water mark of all the
+ *          benchmarked calls exceeds BENCH_STACK_BUDGET, or leaves less
+ *          than BENCH_STACK_MARGIN bytes it never touched.
+ *
+ *          Widths and backends are compile-time (HV_DIMENSIONS, HDC_KERNEL),
+ *          so each bench_* environment in platformio.ini covers one of them;
+ *          scripts/bench.sh runs a set of environments and collects the rows.
+ *
+ * @note    Run with: pio test -e bench_native   (or bench_uno on simavr)
+ *          Excluded from env:native; needs -DHDC_PROBE_CLOCK.
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_kernel.h"
+#include "hdc/hdc_encode.h"
+#include "hdc/hdc_encode_fixed.h"
+#include "hdc/hdc_am.h"
+#include "hdc/hdc_amt.h"
+#include "hdc/hdc_pgm.h"
+#include "hdc/hdc_item.h"
+#include "hdc/hdc_seq.h"
+#include "hdc/hdc_probe.h"
+
+#if defined(__AVR__)
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "hal/hal_uart.h"
+#include "hal/hal_mem.h"
+#endif
+
+#if !HDC_PROBE_CLOCK_ENABLED
+#error "test_bench needs the probe clock: build with -DHDC_PROBE_CLOCK (env:bench_*)"
+#endif
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+#if defined(__AVR__)
+#define BENCH_MIN_TICKS         160000UL    /* 10 ms at 16 MHz */
+#define BENCH_UNIT              "cycles"
+static const uint16_t s_class_counts[] = {2U, 4U, 8U, 16U};
+
+/** @brief Deepest stack use allowed (override with -DBENCH_STACK_BUDGET=n) */
+#ifndef BENCH_STACK_BUDGET
+#define BENCH_STACK_BUDGET      384U
+#endif
+
+/** @brief Painted bytes that must survive above the statics */
+#ifndef BENCH_STACK_MARGIN
+#define BENCH_STACK_MARGIN      128U
+#endif
+#else
+#define BENCH_MIN_TICKS         20000000UL  /* 20 ms */
+#define BENCH_UNIT              "ns"
+static const uint16_t s_class_counts[] = {2U, 8U, 32U, 128U};
+#endif
+
+#define BENCH_NUM_CLASS_COUNTS  (sizeof(s_class_counts) / sizeof(s_class_counts[0]))
+#define BENCH_MAX_CLASSES       s_class_counts[BENCH_NUM_CLASS_COUNTS - 1U]
+#define BENCH_MAX_ITERS         (1UL << 24)
+#define BENCH_LATENCY_RUNS      8U
+#define BENCH_BATCH             8U
+#define BENCH_TOPK              3U
+#define BENCH_MAX_CHANNELS      (2U * HDC_ENCODE_CHANNEL_BLOCK)
+
+/* ============================================================================
+ * Fixtures
+ * ============================================================================ */
+
+#if defined(__AVR__)
+#define BENCH_MAX_SEQ           4U
+static hv_t s_rows[16];
+#else
+#define BENCH_MAX_SEQ           8U
+static hv_t s_rows[128];
+#endif
+static hv_t s_queries[BENCH_BATCH];
+static hv_t s_basis[BENCH_MAX_CHANNELS];
+/* Flash operands: contents do not affect timing, only the address space */
+static const hv_t s_basis_P[BENCH_MAX_CHANNELS] HDC_FLASH = {{0x5AU}};
+static hv_t s_a, s_b, s_out;
+static uint16_t s_values[BENCH_MAX_CHANNELS];
+static hdc_level_t s_levels[BENCH_MAX_CHANNELS];
+static hdc_am_match_t s_results[BENCH_BATCH * BENCH_TOPK];
+static hdc_dist_t s_distances[sizeof(s_rows) / sizeof(s_rows[0])];
+static hdc_am_t s_am;
+static hv_t s_seq_history[BENCH_MAX_SEQ];
+static hdc_seq_t s_seq;
+static uint32_t s_rng = 0x2545F491UL;
+
+#if !defined(__AVR__)
+/** @brief Gateway-sized table for the transposed store */
+#define BENCH_AMT_CLASSES       1024U
+static hv_t s_amt_rows[BENCH_AMT_CLASSES];
+static uint64_t s_amt_planes[HDC_AMT_WORDS(BENCH_AMT_CLASSES)];
+#endif
+
+/** @brief Results are folded in here so no benchmarked call is dead code */
+static volatile uint32_t s_sink;
+
+static uint8_t bench_rand8(void)
+{
+    s_rng = (s_rng * 1664525UL) + 1013904223UL;
+    return (uint8_t)(s_rng >> 24);
+}
+
+static void bench_fill_random(uint8_t* dst, uint16_t len)
+{
+    for (uint16_t i = 0U; i < len; i++) {
+        dst[i] = bench_rand8();
+    }
+}
+
+/* ============================================================================
+ * Timing and Reporting
+ * ============================================================================ */
+
+static void bench_print_u32(uint32_t value)
+{
+    UnityPrintNumberUnsigned(value);
+}
+
+static void bench_row(const char* op, uint16_t param, uint32_t iters,
+                      hdc_probe_ticks_t total, hdc_probe_ticks_t latency)
+{
+    UnityPrint("BENCH,");
+    UnityPrint(HDC_KERNEL_NAME);
+    UnityPrint(",");
+    bench_print_u32(HV_DIMENSIONS);
+    UnityPrint(",");
+    UnityPrint(op);
+    UnityPrint(",");
+    bench_print_u32(param);
+    UnityPrint(",");
+    bench_print_u32(iters);
+    UnityPrint(",");
+    bench_print_u32(total);
+    UnityPrint(",");
+    bench_print_u32(latency);
+    UnityPrint("," BENCH_UNIT);
+    UNITY_PRINT_EOL();
+}
+
+/**
+ * @brief   Time one statement: best single-call latency, then a loop that
+ *          doubles its iteration count until it runs for BENCH_MIN_TICKS
+ * @note    A macro rather than a callback so the statement is inlined into
+ *          the timing loop and no indirect call is measured
+ */
+#define BENCH(op, param, stmt)                                                  \
+    do {                                                                        \
+        hdc_probe_ticks_t latency_ = 0U;                                        \
+        for (uint8_t r_ = 0U; r_ < BENCH_LATENCY_RUNS; r_++) {                  \
+            hdc_probe_ticks_t t0_ = hdc_probe_now();                            \
+            stmt;                                                               \
+            hdc_probe_ticks_t dt_ = (hdc_probe_ticks_t)(hdc_probe_now() - t0_); \
+            if ((r_ == 0U) || (dt_ < latency_)) {                               \
+                latency_ = dt_;                                                 \
+            }                                                                   \
+        }                                                                       \
+        latency_ = (latency_ > hdc_probe_overhead())                            \
+                   ? (hdc_probe_ticks_t)(latency_ - hdc_probe_overhead()) : 0U; \
+                                                                                \
+        uint32_t iters_ = 1U;                                                   \
+        hdc_probe_ticks_t total_ = 0U;                                          \
+        for (;;) {                                                              \
+            hdc_probe_ticks_t t0_ = hdc_probe_now();                            \
+            for (uint32_t i_ = 0U; i_ < iters_; i_++) {                         \
+                stmt;                                                           \
+            }                                                                   \
+            total_ = (hdc_probe_ticks_t)(hdc_probe_now() - t0_);                \
+            if ((total_ >= BENCH_MIN_TICKS) || (iters_ >= BENCH_MAX_ITERS)) {   \
+                break;                                                          \
+            }                                                                   \
+            iters_ *= 2U;                                                       \
+        }                                                                       \
+        bench_row((op), (param), iters_, total_, latency_);                     \
+        TEST_ASSERT_TRUE(iters_ > 0U);                                          \
+    } while (0)
+
+/* ============================================================================
+ * Test Hooks
+ * ============================================================================ */
+
+void setUp(void)
+{
+    bench_fill_random(s_a, HV_BYTES);
+    bench_fill_random(s_b, HV_BYTES);
+    bench_fill_random((uint8_t*)s_rows, (uint16_t)sizeof(s_rows));
+    bench_fill_random((uint8_t*)s_queries, (uint16_t)sizeof(s_queries));
+    bench_fill_random((uint8_t*)s_basis, (uint16_t)sizeof(s_basis));
+    for (uint8_t ch = 0U; ch < BENCH_MAX_CHANNELS; ch++) {
+        s_values[ch] = (uint16_t)(((uint16_t)bench_rand8() << 2) & ADC_MAX);
+        s_levels[ch] = hdc_level_from_adc(s_values[ch]);
+    }
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/* ============================================================================
+ * Core Benchmarks (hdc_core.c)
+ * ============================================================================ */
+
+void test_bench_core(void)
+{
+    BENCH("popcount8", 0U, s_sink += hdc_popcount8((uint8_t)s_sink));
+    BENCH("popcount", 0U, s_sink += hdc_popcount(s_a));
+    BENCH("xor", 0U, hdc_xor(s_out, s_a, s_b));
+    BENCH("or", 0U, hdc_or(s_out, s_a, s_b));
+    BENCH("and", 0U, hdc_and(s_out, s_a, s_b));
+    BENCH("bundle", 0U, hdc_bundle(s_out, s_a));
+    BENCH("hamming", 0U, s_sink += hdc_hamming(s_a, s_b));
+    BENCH("hamming_bounded", 0U, s_sink += hdc_hamming_bounded(s_a, s_b, (hdc_dist_t)(HV_DIMENSIONS / 4U)));
+    BENCH("similarity", 0U, s_sink += hdc_similarity(s_a, s_b));
+    BENCH("clear", 0U, hdc_clear(s_out));
+    BENCH("fill", 0U, hdc_fill(s_out, 0x5AU));
+    BENCH("copy", 0U, hdc_copy(s_out, s_a));
+    BENCH("permute", 1U, hdc_permute(s_out, 1U));
+    BENCH("permute", 3U, hdc_permute(s_out, 3U));
+    BENCH("permute", 8U, hdc_permute(s_out, 8U));    /* byte-aligned */
+    BENCH("copy_P", 0U, hdc_copy_P(s_out, s_basis_P[0]));
+    BENCH("xor_P", 0U, hdc_xor_P(s_out, s_a, s_basis_P[0]));
+    BENCH("hamming_P", 0U, s_sink += hdc_hamming_P(s_a, s_basis_P[0]));
+    s_sink += s_out[0];
+}
+
+/* ============================================================================
+ * Encoding Benchmarks (hdc_encode.c)
+ * ============================================================================ */
+
+HDC_ENCODE_DEFINE_LEVEL(bench_level_fixed, ADC_MAX)
+HDC_ENCODE_DEFINE_FIXED(bench_encode_fixed_1, 1U, ADC_MAX)
+HDC_ENCODE_DEFINE_FIXED(bench_encode_fixed_4, 4U, ADC_MAX)
+HDC_ENCODE_DEFINE_FIXED(bench_encode_fixed_max, BENCH_MAX_CHANNELS, ADC_MAX)
+
+void test_bench_encode(void)
+{
+    static const uint8_t channel_counts[] = {1U, 4U, BENCH_MAX_CHANNELS};
+    static const uint8_t seq_lengths[] = {3U, BENCH_MAX_SEQ};
+
+    BENCH("encode_thermometer", 0U, hdc_encode_thermometer(s_out, (uint16_t)(s_sink & 1023U), 1023U));
+    BENCH("encode_adc", 0U, hdc_encode_adc(s_out, (uint16_t)(s_sink & 1023U)));
+    BENCH("encode_bipolar", 0U, hdc_encode_bipolar(s_out, (int16_t)(s_sink & 255U), -256, 255));
+    BENCH("level_from_value", 0U, s_sink += hdc_level_from_value((uint16_t)(s_sink & 1023U), 1023U));
+    BENCH("level_from_adc", 0U, s_sink += hdc_level_from_adc((uint16_t)(s_sink & 1023U)));
+    BENCH("level_fixed", 0U, s_sink += bench_level_fixed((uint16_t)(s_sink & 1023U)));
+    BENCH("level_distance", 0U, s_sink += hdc_level_distance(s_levels[0], s_levels[1]));
+    BENCH("level_bundle", 0U, s_sink += hdc_level_bundle(s_levels[0], s_levels[1]));
+    BENCH("level_to_hv", 0U, hdc_level_to_hv(s_out, s_levels[0]));
+    BENCH("level_bind", 0U, hdc_level_bind(s_out, s_levels[0], s_a));
+    BENCH("level_hamming", 0U, s_sink += hdc_level_hamming(s_levels[0], s_a));
+    BENCH("item_generate", 0U, hdc_item_generate(s_out, s_rng, 3U));
+
+    for (uint8_t i = 0U; i < (uint8_t)sizeof(channel_counts); i++) {
+        uint8_t n = channel_counts[i];
+        BENCH("encode_multi_channel", n,
+              hdc_encode_multi_channel(s_out, s_values, n, (const hv_t*)s_basis));
+        BENCH("encode_levels", n,
+              hdc_encode_levels(s_out, s_levels, n, (const hv_t*)s_basis));
+        BENCH("encode_multi_channel_P", n,
+              hdc_encode_multi_channel_P(s_out, s_values, n, s_basis_P));
+        BENCH("encode_multi_channel_seeded", n,
+              hdc_encode_multi_channel_seeded(s_out, s_values, n, s_rng));
+    }
+
+    for (uint8_t i = 0U; i < (uint8_t)sizeof(seq_lengths); i++) {
+        uint8_t n = seq_lengths[i];
+        (void)hdc_seq_init(&s_seq, s_seq_history, n);
+        BENCH("seq_push", n, (void)hdc_seq_push(&s_seq, s_a));
+        s_sink += s_seq.gram[0];
+    }
+
+    BENCH("encode_multi_channel_fixed", 1U, bench_encode_fixed_1(s_out, s_values, (const hv_t*)s_basis));
+    BENCH("encode_multi_channel_fixed", 4U, bench_encode_fixed_4(s_out, s_values, (const hv_t*)s_basis));
+    BENCH("encode_multi_channel_fixed", BENCH_MAX_CHANNELS,
+          bench_encode_fixed_max(s_out, s_values, (const hv_t*)s_basis));
+    s_sink += s_out[0];
+}
+
+/* ============================================================================
+ * Associative Memory Benchmarks (hdc_am.c)
+ * ============================================================================ */
+
+void test_bench_am(void)
+{
+    hdc_am_match_t best;
+
+    for (uint8_t i = 0U; i < (uint8_t)BENCH_NUM_CLASS_COUNTS; i++) {
+        uint16_t classes = s_class_counts[i];
+
+        hdc_am_init(&s_am, s_rows, classes);
+        s_am.count = classes;
+
+        hdc_am_set_search(&s_am, HDC_AM_SEARCH_EXHAUSTIVE);
+        BENCH("am_query_exhaustive", classes, (void)hdc_am_query(&s_am, s_queries[0], &best));
+        BENCH("am_topk_exhaustive", classes,
+              (void)hdc_am_query_topk(&s_am, s_queries[0], s_results, BENCH_TOPK));
+
+        hdc_am_set_search(&s_am, HDC_AM_SEARCH_BOUNDED);
+        BENCH("am_query_bounded", classes, (void)hdc_am_query(&s_am, s_queries[0], &best));
+        BENCH("am_topk_bounded", classes,
+              (void)hdc_am_query_topk(&s_am, s_queries[0], s_results, BENCH_TOPK));
+        BENCH("am_query_batch", classes,
+              (void)hdc_am_query_batch(&s_am, (const hv_t*)s_queries, BENCH_BATCH, s_results, 1U));
+        BENCH("am_query_levels", classes,
+              (void)hdc_am_query_levels(&s_am, s_levels, 4U, (const hv_t*)s_basis, s_distances, &best));
+
+        s_sink += best.distance;
+    }
+}
+
+#if !defined(__AVR__)
+/* ============================================================================
+ * Transposed Associative Memory Benchmarks (hdc_amt.c)
+ * ============================================================================ */
+
+void test_bench_amt(void)
+{
+    hdc_am_t rows;
+    hdc_amt_t amt;
+    hdc_am_match_t best;
+    hv_t query;
+
+    for (uint16_t c = 0U; c < BENCH_AMT_CLASSES; c++) {
+        bench_fill_random(s_amt_rows[c], HV_BYTES);
+    }
+    hdc_am_init_view(&rows, (const hv_t*)s_amt_rows, BENCH_AMT_CLASSES);
+    hdc_amt_init(&amt, s_amt_planes, BENCH_AMT_CLASSES);
+    for (uint16_t c = 0U; c < BENCH_AMT_CLASSES; c++) {
+        (void)hdc_amt_add(&amt, s_amt_rows[c], NULL);
+    }
+
+    /* One class with every eighth byte replaced: about 6% of bits differ */
+    memcpy(query, s_amt_rows[BENCH_AMT_CLASSES / 3U], HV_BYTES);
+    for (uint16_t i = 0U; i < HV_BYTES; i += 8U) {
+        query[i] = bench_rand8();
+    }
+
+    hdc_am_set_search(&rows, HDC_AM_SEARCH_EXHAUSTIVE);
+    BENCH("am_query_near_exhaustive", BENCH_AMT_CLASSES, (void)hdc_am_query(&rows, query, &best));
+    hdc_am_set_search(&rows, HDC_AM_SEARCH_BOUNDED);
+    BENCH("am_query_near_bounded", BENCH_AMT_CLASSES, (void)hdc_am_query(&rows, query, &best));
+    BENCH("am_topk_near_bounded", BENCH_AMT_CLASSES,
+          (void)hdc_am_query_topk(&rows, query, s_results, BENCH_TOPK));
+
+    hdc_amt_set_search(&amt, HDC_AM_SEARCH_EXHAUSTIVE);
+    BENCH("amt_query_near_exhaustive", BENCH_AMT_CLASSES, (void)hdc_amt_query(&amt, query, &best));
+    hdc_amt_set_search(&amt, HDC_AM_SEARCH_BOUNDED);
+    BENCH("amt_query_near_bounded", BENCH_AMT_CLASSES, (void)hdc_amt_query(&amt, query, &best));
+    BENCH("amt_topk_near_bounded", BENCH_AMT_CLASSES,
+          (void)hdc_amt_query_topk(&amt, query, s_results, BENCH_TOPK));
+
+    s_sink += best.distance;
+}
+#endif
+
+#if defined(__AVR__)
+/* ============================================================================
+ * SRAM Budget (hal_mem.c)
+ * ============================================================================ */
+
+/**
+ * @brief   Stack high-water mark of every case above, against the budget
+ * @note    Must run last: the mark only grows
+ */
+void test_bench_memory(void)
+{
+    hal_mem_usage_t usage;
+
+    hal_mem_usage(&usage);
+    UnityPrint("MEMORY,");
+    bench_print_u32(usage.data_bytes);
+    UnityPrint(",");
+    bench_print_u32(usage.bss_bytes);
+    UnityPrint(",");
+    bench_print_u32(usage.stack_bytes);
+    UnityPrint(",");
+    bench_print_u32(usage.stack_peak);
+    UNITY_PRINT_EOL();
+
+    TEST_ASSERT_TRUE_MESSAGE(usage.stack_peak <= BENCH_STACK_BUDGET,
+                             "stack high-water mark over BENCH_STACK_BUDGET");
+    TEST_ASSERT_TRUE_MESSAGE((uint16_t)(usage.stack_bytes - usage.stack_peak) >= BENCH_STACK_MARGIN,
+                             "less than BENCH_STACK_MARGIN of stack never used");
+}
+#endif
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+#if defined(__AVR__)
+/**
+ * @brief   Unity output on the AVR target (blocking UART, see unity_config.h)
+ */
+void unity_output_char(int c)
+{
+    hal_uart_putc((uint8_t)c);
+}
+#endif
+
+static int bench_main(void)
+{
+#if defined(__AVR__)
+    /* The Arduino core's Timer0 tick would add jitter to the cycle counts */
+    TIMSK0 = 0U;
+    hal_uart_init();
+    sei();
+#endif
+    hdc_probe_init();
+
+    UNITY_BEGIN();
+
+    UnityPrint("BENCH,kernel,dims,op,param,iters,total_ticks,latency_ticks,unit");
+    UNITY_PRINT_EOL();
+
+    RUN_TEST(test_bench_core);
+    RUN_TEST(test_bench_encode);
+    RUN_TEST(test_bench_am);
+#if !defined(__AVR__)
+    RUN_TEST(test_bench_amt);
+#endif
+#if defined(__AVR__)
+    RUN_TEST(test_bench_memory);
+#endif
+
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+void setup(void)
+{
+    (void)bench_main();
+}
+
+void loop(void)
+{
+    /* Benchmarks run once */
+}
+#else
+int main(void)
+{
+    return bench_main();
+}
+#endif
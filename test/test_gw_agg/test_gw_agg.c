@@ -0,0 +1,598 @@
+/**
+ * @file    test_gw_agg.c
+ * @brief   Unit Tests for the Gateway Snapshot Aggregator
+ * @version 1.0.0
+ *
+ * @details Tests for merging device snapshots:
+ *          - Merging: one device reproduces its own prototype, prototype
+ *            snapshots merge by majority, a repeated snapshot replaces the
+ *            stream's previous one, counters add across devices
+ *          - Parsing: split and noisy streams, CRC errors, lost fragments,
+ *            rejected images, reading from a file descriptor
+ *          - Back-pressure: a full queue stops the parser, which resumes
+ *            after a drain without losing snapshots
+ *          - Concurrency: many streams fed from a worker pool through a
+ *            small queue give the same sums as a serial run
+ *          - Output: the merged model round-trips through gw_model.h
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ *          Model files are written to a mkstemp() path under /tmp.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_counter.h"
+#include "hdc/hdc_telemetry.h"
+#include "gateway/gw_agg.h"
+#include "gateway/gw_model.h"
+#include "gateway/gw_pool.h"
+#include "mock_hv.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TEST_SEED       0xA66E6A7EUL
+#define TEST_CLASSES    3U
+#define TEST_STREAMS    64U
+#define TEST_SLOTS      4U
+#define TEST_THREADS    4U
+#define TEST_STREAM_MAX (TEST_CLASSES * 2U * HDC_COUNTER_PLANES * HV_BYTES)
+
+static gw_agg_slot_t s_slots[TEST_SLOTS];
+static gw_agg_class_t s_classes[TEST_CLASSES];
+static gw_agg_contrib_t s_contribs[TEST_STREAMS * TEST_CLASSES];
+static gw_agg_config_t s_config;
+static gw_agg_t s_agg;
+static gw_agg_parser_t s_parsers[TEST_STREAMS];
+
+static hdc_counter_t s_counters[TEST_STREAMS][TEST_CLASSES];
+static uint8_t s_streams[TEST_STREAMS][TEST_STREAM_MAX];
+static size_t s_stream_len[TEST_STREAMS];
+static hv_t s_rows[TEST_CLASSES];
+
+/* Seed of the next fill_pseudo_random() vector; each test starts over */
+static uint32_t s_seed;
+
+/** @brief Train a counter on a few noisy copies of a base pattern */
+static void train(hdc_counter_t* counter, const hv_t base, uint8_t samples)
+{
+    hv_t noise, pattern;
+
+    hdc_counter_reset(counter);
+    for (uint8_t i = 0U; i < samples; i++) {
+        fill_pseudo_random(noise, s_seed++);
+        for (hdc_index_t b = 0U; b < HV_BYTES; b++) {
+            pattern[b] = (uint8_t)(base[b] ^ (noise[b] & (uint8_t)(noise[b] >> 1) & 0x55U));
+        }
+        hdc_counter_add(counter, pattern);
+    }
+}
+
+/** @brief Append every snapshot frame of one image, optionally dropping one */
+static size_t append_snapshot(uint8_t* out, size_t at, uint8_t class_id, uint8_t planes,
+                              const uint8_t* image, int16_t skip_fragment)
+{
+    hdc_tlm_frame_t frame;
+    uint16_t offset = 0U;
+    int16_t fragment = 0;
+
+    while (offset < HDC_TLM_SNAPSHOT_BYTES(planes)) {
+        offset = hdc_tlm_snapshot_fragment(&frame, class_id, planes, image, offset);
+        uint8_t len = hdc_tlm_finish(&frame);
+        if (fragment != skip_fragment) {
+            memcpy(&out[at], frame.bytes, len);
+            at += len;
+        }
+        fragment++;
+    }
+    return at;
+}
+
+static size_t append_counter(uint8_t* out, size_t at, uint8_t class_id, const hdc_counter_t* counter)
+{
+    return append_snapshot(out, at, class_id, HDC_COUNTER_PLANES, (const uint8_t*)counter, -1);
+}
+
+void setUp(void)
+{
+    s_seed = 2463534242UL;
+    s_config.slots = s_slots;
+    s_config.num_slots = TEST_SLOTS;
+    s_config.classes = s_classes;
+    s_config.num_classes = TEST_CLASSES;
+    s_config.contribs = s_contribs;
+    s_config.num_streams = TEST_STREAMS;
+    s_config.item_seed = TEST_SEED;
+    TEST_ASSERT_EQUAL(GW_AGG_OK, gw_agg_init(&s_agg, &s_config));
+    for (uint32_t s = 0U; s < TEST_STREAMS; s++) {
+        TEST_ASSERT_EQUAL(GW_AGG_OK, gw_agg_parser_init(&s_parsers[s], &s_agg, s));
+        s_stream_len[s] = 0U;
+    }
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/* ============================================================================
+ * Merging Tests
+ * ============================================================================ */
+
+void test_agg_init_rejects_bad_storage(void)
+{
+    gw_agg_config_t bad = s_config;
+    gw_agg_parser_t parser;
+
+    bad.num_slots = 3U;
+    TEST_ASSERT_EQUAL(GW_AGG_ERROR_INVALID, gw_agg_init(&s_agg, &bad));
+    bad = s_config;
+    bad.num_classes = 0U;
+    TEST_ASSERT_EQUAL(GW_AGG_ERROR_INVALID, gw_agg_init(&s_agg, &bad));
+    bad = s_config;
+    bad.contribs = NULL;
+    TEST_ASSERT_EQUAL(GW_AGG_ERROR_INVALID, gw_agg_init(&s_agg, &bad));
+
+    TEST_ASSERT_EQUAL(GW_AGG_OK, gw_agg_init(&s_agg, &s_config));
+    TEST_ASSERT_EQUAL(GW_AGG_ERROR_INVALID, gw_agg_parser_init(&parser, &s_agg, TEST_STREAMS));
+}
+
+void test_single_device_reproduces_its_prototype(void)
+{
+    hv_t base, expected;
+
+    for (uint8_t c = 0U; c < 2U; c++) {
+        fill_pseudo_random(base, s_seed++);
+        train(&s_counters[0][c], base, (uint8_t)(5U + c));
+        s_stream_len[0] = append_counter(s_streams[0], s_stream_len[0], c, &s_counters[0][c]);
+    }
+    gw_agg_parser_feed(&s_parsers[0], s_streams[0], s_stream_len[0]);
+    TEST_ASSERT_EQUAL_UINT32(2U, s_parsers[0].snapshots);
+    TEST_ASSERT_EQUAL(2U, gw_agg_drain(&s_agg));
+
+    gw_agg_prototypes(&s_agg, s_rows, NULL);
+    for (uint8_t c = 0U; c < 2U; c++) {
+        hdc_counter_threshold(expected, &s_counters[0][c], NULL);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, s_rows[c], HV_BYTES);
+        TEST_ASSERT_EQUAL_UINT32(1U, s_classes[c].streams);
+    }
+
+    /* Nobody sent class 2: all zero, even with a tiebreak */
+    hv_t ones;
+    hdc_fill(ones, 0xFFU);
+    gw_agg_prototypes(&s_agg, s_rows, ones);
+    TEST_ASSERT_EQUAL(0U, hdc_popcount(s_rows[2]));
+}
+
+void test_prototype_snapshots_merge_by_majority(void)
+{
+    hv_t protos[3];
+    hv_t majority;
+
+    for (uint8_t s = 0U; s < 3U; s++) {
+        fill_pseudo_random(protos[s], s_seed++);
+        s_stream_len[s] = append_snapshot(s_streams[s], 0U, 1U, 0U, protos[s], -1);
+        gw_agg_parser_feed(&s_parsers[s], s_streams[s], s_stream_len[s]);
+    }
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        majority[i] = (uint8_t)((protos[0][i] & protos[1][i]) | (protos[0][i] & protos[2][i]) |
+                                (protos[1][i] & protos[2][i]));
+    }
+
+    TEST_ASSERT_EQUAL(3U, gw_agg_drain(&s_agg));
+    gw_agg_prototypes(&s_agg, s_rows, NULL);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(majority, s_rows[1], HV_BYTES);
+    TEST_ASSERT_EQUAL_UINT32(3U, s_classes[1].streams);
+}
+
+void test_repeated_snapshot_replaces_previous(void)
+{
+    hv_t base, expected;
+
+    fill_pseudo_random(base, s_seed++);
+    train(&s_counters[0][0], base, 3U);
+    s_stream_len[0] = append_counter(s_streams[0], 0U, 0U, &s_counters[0][0]);
+    gw_agg_parser_feed(&s_parsers[0], s_streams[0], s_stream_len[0]);
+    (void)gw_agg_drain(&s_agg);
+
+    /* The device learns more and sends its whole state again */
+    fill_pseudo_random(base, s_seed++);
+    train(&s_counters[0][0], base, 9U);
+    s_stream_len[0] = append_counter(s_streams[0], 0U, 0U, &s_counters[0][0]);
+    gw_agg_parser_feed(&s_parsers[0], s_streams[0], s_stream_len[0]);
+    (void)gw_agg_drain(&s_agg);
+
+    TEST_ASSERT_EQUAL_UINT32(1U, s_classes[0].streams);
+    for (uint32_t d = 0U; d < HV_DIMENSIONS; d++) {
+        int32_t vote = (int32_t)hdc_counter_get(&s_counters[0][0], (hdc_dist_t)d) - HDC_COUNTER_INIT;
+        TEST_ASSERT_EQUAL_INT32(vote, s_classes[0].sum[d]);
+    }
+    gw_agg_prototypes(&s_agg, s_rows, NULL);
+    hdc_counter_threshold(expected, &s_counters[0][0], NULL);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, s_rows[0], HV_BYTES);
+}
+
+void test_counter_snapshots_add_across_devices(void)
+{
+    hv_t base;
+
+    fill_pseudo_random(base, s_seed++);
+    for (uint8_t s = 0U; s < 5U; s++) {
+        train(&s_counters[s][2], base, (uint8_t)(1U + (2U * s)));
+        s_stream_len[s] = append_counter(s_streams[s], 0U, 2U, &s_counters[s][2]);
+        gw_agg_parser_feed(&s_parsers[s], s_streams[s], s_stream_len[s]);
+        (void)gw_agg_drain(&s_agg);
+    }
+
+    for (uint32_t d = 0U; d < HV_DIMENSIONS; d++) {
+        int32_t sum = 0;
+        for (uint8_t s = 0U; s < 5U; s++) {
+            sum += (int32_t)hdc_counter_get(&s_counters[s][2], (hdc_dist_t)d) - HDC_COUNTER_INIT;
+        }
+        TEST_ASSERT_EQUAL_INT32(sum, s_classes[2].sum[d]);
+    }
+    TEST_ASSERT_EQUAL_UINT64(5U, s_agg.merged);
+}
+
+/* ============================================================================
+ * Parsing Tests
+ * ============================================================================ */
+
+void test_parser_survives_noise_and_splits(void)
+{
+    static const uint8_t banner[] = "Nano-Edge AI\r\n\xA5\xFF garbage \xA5\x06\x02ok";
+    hv_t base, expected;
+    hdc_tlm_frame_t frame;
+    size_t at = 0U;
+
+    fill_pseudo_random(base, s_seed++);
+    train(&s_counters[0][1], base, 4U);
+
+    memcpy(s_streams[0], banner, sizeof(banner) - 1U);
+    at = sizeof(banner) - 1U;
+
+    /* A sample frame in between is decoded and ignored */
+    hdc_tlm_begin(&frame, HDC_TLM_SAMPLE);
+    (void)hdc_tlm_add_sample(&frame, 0U, 512U);
+    uint8_t len = hdc_tlm_finish(&frame);
+    memcpy(&s_streams[0][at], frame.bytes, len);
+    at += len;
+
+    at = append_counter(s_streams[0], at, 1U, &s_counters[0][1]);
+
+    /* One byte at a time */
+    for (size_t i = 0U; i < at; i++) {
+        gw_agg_parser_feed(&s_parsers[0], &s_streams[0][i], 1U);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1U, s_parsers[0].snapshots);
+    TEST_ASSERT_EQUAL_UINT32(2U, s_parsers[0].crc_errors);
+    TEST_ASSERT_TRUE(s_parsers[0].skipped > 0U);
+    TEST_ASSERT_EQUAL(1U, gw_agg_drain(&s_agg));
+
+    gw_agg_prototypes(&s_agg, s_rows, NULL);
+    hdc_counter_threshold(expected, &s_counters[0][1], NULL);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, s_rows[1], HV_BYTES);
+}
+
+void test_parser_drops_broken_images(void)
+{
+    hv_t base;
+    size_t at = 0U;
+    gw_agg_parser_t* parser = &s_parsers[0];
+
+    fill_pseudo_random(base, s_seed++);
+    train(&s_counters[0][0], base, 3U);
+
+    /* Lost second fragment, when the image needs more than one */
+    if (HDC_TLM_SNAPSHOT_BYTES(HDC_COUNTER_PLANES) >
+        (HDC_TLM_MAX_PAYLOAD - HDC_TLM_SNAPSHOT_HEADER_BYTES)) {
+        at = append_snapshot(s_streams[0], at, 0U, HDC_COUNTER_PLANES,
+                             (const uint8_t*)&s_counters[0][0], 1);
+    }
+    /* Corrupted CRC on the last byte of a complete image */
+    at = append_counter(s_streams[0], at, 0U, &s_counters[0][0]);
+    s_streams[0][at - 1U] ^= 0x01U;
+    /* Unknown class and a one-plane image */
+    at = append_snapshot(s_streams[0], at, TEST_CLASSES, 0U, base, -1);
+    at = append_snapshot(s_streams[0], at, 0U, 1U, base, -1);
+    gw_agg_parser_feed(parser, s_streams[0], at);
+
+    TEST_ASSERT_EQUAL_UINT32(0U, parser->snapshots);
+    TEST_ASSERT_EQUAL_UINT32(1U, parser->crc_errors);
+    TEST_ASSERT_TRUE(parser->dropped >= 2U);
+    TEST_ASSERT_EQUAL(0U, gw_agg_drain(&s_agg));
+
+    /* A clean image afterwards still gets through */
+    at = append_counter(s_streams[0], 0U, 0U, &s_counters[0][0]);
+    gw_agg_parser_feed(parser, s_streams[0], at);
+    TEST_ASSERT_EQUAL_UINT32(1U, parser->snapshots);
+    TEST_ASSERT_EQUAL(1U, gw_agg_drain(&s_agg));
+}
+
+void test_parser_reads_file_descriptor(void)
+{
+    int fds[2];
+    hv_t proto;
+
+    fill_pseudo_random(proto, s_seed++);
+    s_stream_len[0] = append_snapshot(s_streams[0], 0U, 0U, 0U, proto, -1);
+    s_stream_len[0] = append_snapshot(s_streams[0], s_stream_len[0], 2U, 0U, proto, -1);
+
+    TEST_ASSERT_EQUAL(0, pipe(fds));
+    TEST_ASSERT_EQUAL((ssize_t)s_stream_len[0], write(fds[1], s_streams[0], s_stream_len[0]));
+    (void)close(fds[1]);
+
+    gw_agg_status_t status;
+    do {
+        status = gw_agg_parser_read(&s_parsers[0], fds[0]);
+    } while (status == GW_AGG_OK);
+    (void)close(fds[0]);
+
+    TEST_ASSERT_EQUAL(GW_AGG_END, status);
+    TEST_ASSERT_EQUAL_UINT32(2U, s_parsers[0].snapshots);
+    TEST_ASSERT_EQUAL(2U, gw_agg_drain(&s_agg));
+    gw_agg_prototypes(&s_agg, s_rows, NULL);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(proto, s_rows[2], HV_BYTES);
+    TEST_ASSERT_EQUAL_INT(GW_AGG_ERROR_IO, gw_agg_parser_read(&s_parsers[0], -1));
+}
+
+/* ============================================================================
+ * Back-pressure Tests
+ * ============================================================================ */
+
+#define TEST_BURST      (TEST_SLOTS + 2U)
+
+/** @brief Stream 0: TEST_BURST prototype snapshots cycling through the classes */
+static void append_burst(hv_t* protos)
+{
+    for (uint8_t i = 0U; i < TEST_BURST; i++) {
+        fill_pseudo_random(protos[i], s_seed++);
+        s_stream_len[0] = append_snapshot(s_streams[0], s_stream_len[0],
+                                          (uint8_t)(i % TEST_CLASSES), 0U, protos[i], -1);
+    }
+    TEST_ASSERT_TRUE(s_stream_len[0] <= TEST_STREAM_MAX);
+}
+
+/** @brief Each class holds the last prototype sent for it */
+static void assert_burst_merged(hv_t* protos)
+{
+    TEST_ASSERT_EQUAL_UINT32(TEST_BURST, s_parsers[0].snapshots);
+    TEST_ASSERT_EQUAL_UINT32(0U, s_parsers[0].dropped);
+    TEST_ASSERT_EQUAL_UINT64(TEST_BURST, s_agg.merged);
+    gw_agg_prototypes(&s_agg, s_rows, NULL);
+    for (uint8_t c = 0U; c < TEST_CLASSES; c++) {
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(protos[TEST_BURST - TEST_CLASSES + c], s_rows[c], HV_BYTES);
+    }
+}
+
+void test_try_push_reports_full(void)
+{
+    static gw_agg_snapshot_t snapshot;
+
+    memset(&snapshot, 0, sizeof(snapshot));
+    snapshot.class_id = TEST_CLASSES;
+    TEST_ASSERT_EQUAL(GW_AGG_ERROR_INVALID, gw_agg_try_push(&s_agg, &snapshot));
+
+    snapshot.class_id = 1U;
+    for (uint32_t i = 0U; i < TEST_SLOTS; i++) {
+        TEST_ASSERT_EQUAL(GW_AGG_OK, gw_agg_try_push(&s_agg, &snapshot));
+    }
+    TEST_ASSERT_EQUAL(GW_AGG_FULL, gw_agg_try_push(&s_agg, &snapshot));
+    TEST_ASSERT_EQUAL_UINT64(1U, s_agg.waits);
+
+    TEST_ASSERT_EQUAL(TEST_SLOTS, gw_agg_drain(&s_agg));
+    TEST_ASSERT_EQUAL(GW_AGG_OK, gw_agg_try_push(&s_agg, &snapshot));
+    TEST_ASSERT_EQUAL(1U, gw_agg_drain(&s_agg));
+}
+
+void test_parser_feed_stops_at_full_queue(void)
+{
+    hv_t protos[TEST_BURST];
+    gw_agg_parser_t* parser = &s_parsers[0];
+    size_t at = 0U;
+    uint32_t stops = 0U;
+
+    append_burst(protos);
+
+    /* One thread feeds and drains in turn */
+    while ((at < s_stream_len[0]) || parser->pending) {
+        at += gw_agg_parser_feed(parser, &s_streams[0][at], s_stream_len[0] - at);
+        if (parser->pending) {
+            stops++;
+            TEST_ASSERT_EQUAL(TEST_SLOTS, gw_agg_drain(&s_agg));
+        }
+    }
+    (void)gw_agg_drain(&s_agg);
+
+    TEST_ASSERT_TRUE(stops > 0U);
+    assert_burst_merged(protos);
+}
+
+void test_parser_read_resumes_after_full(void)
+{
+    int fds[2];
+    hv_t protos[TEST_BURST];
+    uint32_t stops = 0U;
+
+    append_burst(protos);
+    TEST_ASSERT_EQUAL(0, pipe(fds));
+    TEST_ASSERT_EQUAL((ssize_t)s_stream_len[0], write(fds[1], s_streams[0], s_stream_len[0]));
+    (void)close(fds[1]);
+
+    gw_agg_status_t status;
+    do {
+        status = gw_agg_parser_read(&s_parsers[0], fds[0]);
+        if (status == GW_AGG_FULL) {
+            stops++;
+            (void)gw_agg_drain(&s_agg);
+        }
+    } while ((status == GW_AGG_OK) || (status == GW_AGG_FULL));
+    (void)close(fds[0]);
+    (void)gw_agg_drain(&s_agg);
+
+    TEST_ASSERT_EQUAL(GW_AGG_END, status);
+    TEST_ASSERT_TRUE(stops > 0U);
+    assert_burst_merged(protos);
+}
+
+/* ============================================================================
+ * Concurrency Tests
+ * ============================================================================ */
+
+static volatile int s_feeding;
+
+/** @brief Merging thread: drains until the feeders are done and the queue is empty */
+static void* merger(void* arg)
+{
+    (void)arg;
+    for (;;) {
+        int feeding = __atomic_load_n(&s_feeding, __ATOMIC_ACQUIRE);
+        if ((gw_agg_drain(&s_agg) == 0U) && !feeding) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+/** @brief Pool callback: each stream fed in uneven pieces, yielding while the queue is full */
+static void feed_streams(void* ctx, uint32_t worker, size_t begin, size_t end)
+{
+    (void)ctx;
+    (void)worker;
+    for (size_t s = begin; s < end; s++) {
+        size_t at = 0U;
+        size_t piece = 1U + (s % 37U);
+        while ((at < s_stream_len[s]) || s_parsers[s].pending) {
+            size_t n = ((s_stream_len[s] - at) < piece) ? (s_stream_len[s] - at) : piece;
+            at += gw_agg_parser_feed(&s_parsers[s], &s_streams[s][at], n);
+            if (s_parsers[s].pending) {
+                (void)sched_yield();
+            }
+        }
+    }
+}
+
+void test_concurrent_streams_match_serial_sums(void)
+{
+    static int32_t reference[TEST_CLASSES][HV_DIMENSIONS];
+    hv_t bases[TEST_CLASSES];
+    gw_pool_t pool;
+    pthread_t thread;
+
+    for (uint8_t c = 0U; c < TEST_CLASSES; c++) {
+        fill_pseudo_random(bases[c], s_seed++);
+    }
+    memset(reference, 0, sizeof(reference));
+    for (uint32_t s = 0U; s < TEST_STREAMS; s++) {
+        for (uint8_t c = 0U; c < TEST_CLASSES; c++) {
+            /* Stream s trains class c unless s and c skip it */
+            if (((s + c) % 5U) == 0U) {
+                continue;
+            }
+            train(&s_counters[s][c], bases[c], (uint8_t)(1U + ((s * 3U + c) % 11U)));
+            s_stream_len[s] = append_counter(s_streams[s], s_stream_len[s], c, &s_counters[s][c]);
+            for (uint32_t d = 0U; d < HV_DIMENSIONS; d++) {
+                reference[c][d] += (int32_t)hdc_counter_get(&s_counters[s][c], (hdc_dist_t)d) -
+                                   HDC_COUNTER_INIT;
+            }
+        }
+        TEST_ASSERT_TRUE(s_stream_len[s] <= TEST_STREAM_MAX);
+    }
+
+    TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_init(&pool, TEST_THREADS));
+    s_feeding = 1;
+    TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, merger, NULL));
+    TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_run(&pool, TEST_STREAMS, 1U, feed_streams, NULL));
+    __atomic_store_n(&s_feeding, 0, __ATOMIC_RELEASE);
+    TEST_ASSERT_EQUAL(0, pthread_join(thread, NULL));
+    gw_pool_destroy(&pool);
+
+    uint32_t queued = 0U;
+    for (uint32_t s = 0U; s < TEST_STREAMS; s++) {
+        queued += s_parsers[s].snapshots;
+        TEST_ASSERT_EQUAL_UINT32(0U, s_parsers[s].dropped);
+    }
+    TEST_ASSERT_EQUAL_UINT64(queued, s_agg.merged);
+    for (uint8_t c = 0U; c < TEST_CLASSES; c++) {
+        TEST_ASSERT_EQUAL_INT32_ARRAY(reference[c], s_classes[c].sum, HV_DIMENSIONS);
+    }
+}
+
+/* ============================================================================
+ * Output Tests
+ * ============================================================================ */
+
+void test_merged_model_round_trips(void)
+{
+    char path[64];
+    gw_model_t model;
+    hv_t base;
+
+    for (uint8_t c = 0U; c < TEST_CLASSES; c++) {
+        fill_pseudo_random(base, s_seed++);
+        train(&s_counters[0][c], base, 7U);
+        s_stream_len[0] = append_counter(s_streams[0], s_stream_len[0], c, &s_counters[0][c]);
+    }
+    gw_agg_parser_feed(&s_parsers[0], s_streams[0], s_stream_len[0]);
+    (void)gw_agg_drain(&s_agg);
+
+    strcpy(path, "/tmp/gw_agg_XXXXXX");
+    int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    (void)close(fd);
+
+    TEST_ASSERT_EQUAL(GW_AGG_OK, gw_agg_write_model(&s_agg, path, s_rows));
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_open(&model, path));
+    TEST_ASSERT_EQUAL_UINT32(TEST_CLASSES, model.info.class_count);
+    TEST_ASSERT_EQUAL_UINT32(TEST_SEED, model.info.item_seed);
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_verify(&model));
+    for (uint8_t c = 0U; c < TEST_CLASSES; c++) {
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(s_rows[c], model.am.classes[c], HV_BYTES);
+    }
+    gw_model_close(&model);
+    (void)unlink(path);
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Merging tests */
+    RUN_TEST(test_agg_init_rejects_bad_storage);
+    RUN_TEST(test_single_device_reproduces_its_prototype);
+    RUN_TEST(test_prototype_snapshots_merge_by_majority);
+    RUN_TEST(test_repeated_snapshot_replaces_previous);
+    RUN_TEST(test_counter_snapshots_add_across_devices);
+
+    /* Parsing tests */
+    RUN_TEST(test_parser_survives_noise_and_splits);
+    RUN_TEST(test_parser_drops_broken_images);
+    RUN_TEST(test_parser_reads_file_descriptor);
+
+    /* Back-pressure tests */
+    RUN_TEST(test_try_push_reports_full);
+    RUN_TEST(test_parser_feed_stops_at_full_queue);
+    RUN_TEST(test_parser_read_resumes_after_full);
+
+    /* Concurrency tests */
+    RUN_TEST(test_concurrent_streams_match_serial_sums);
+
+    /* Output tests */
+    RUN_TEST(test_merged_model_round_trips);
+
+    return UNITY_END();
+}
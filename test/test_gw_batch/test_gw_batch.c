@@ -0,0 +1,269 @@
+/**
+ * @file    test_gw_batch.c
+ * @brief   Unit Tests for Parallel Batch Training and Classification
+ * @version 1.0.0
+ *
+ * @details Tests for the gateway batch API:
+ *          - Accumulators: exact counts, majority rule and tiebreak
+ *          - Training: equals a serial reference, identical for any thread
+ *            count, incremental over split batches, label validation
+ *          - Classification: equals serial hdc_am_query(), empty memory
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_am.h"
+#include "hdc/hdc_item.h"
+#include "hdc/hdc_encode.h"
+#include "gateway/gw_batch.h"
+#include "mock_hv.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TEST_SEED       0xBA7C4ED5UL
+#define TEST_CHANNELS   6U
+#define TEST_CLASSES    5U
+#define TEST_SAMPLES    600U
+#define TEST_THREADS    8U
+
+static uint16_t s_values[TEST_SAMPLES * TEST_CHANNELS];
+static hdc_class_t s_labels[TEST_SAMPLES];
+static gw_batch_t s_batch;
+
+static gw_accum_t s_reference[TEST_CLASSES];
+static gw_accum_t s_classes[TEST_CLASSES];
+static gw_accum_t s_scratch[TEST_THREADS * TEST_CLASSES];
+static gw_pool_t s_pool;
+
+/** @brief Class c centres channel ch on a fixed level; samples add noise */
+void setUp(void)
+{
+    uint32_t lcg = 12345U;
+
+    for (uint16_t i = 0U; i < TEST_SAMPLES; i++) {
+        hdc_class_t c = (hdc_class_t)((i * 7U) % TEST_CLASSES);
+        s_labels[i] = c;
+        for (uint8_t ch = 0U; ch < TEST_CHANNELS; ch++) {
+            uint16_t centre = (uint16_t)(((c * 5U) + (ch * 3U)) % 8U) * 120U;
+            s_values[(i * TEST_CHANNELS) + ch] =
+                (uint16_t)(centre + (pseudo_random_next(&lcg) % 100U));
+        }
+    }
+
+    s_batch.values = s_values;
+    s_batch.labels = s_labels;
+    s_batch.num_samples = TEST_SAMPLES;
+    s_batch.num_channels = TEST_CHANNELS;
+    s_batch.item_seed = TEST_SEED;
+
+    /* Serial reference */
+    gw_accum_reset(s_reference, TEST_CLASSES);
+    for (uint16_t i = 0U; i < TEST_SAMPLES; i++) {
+        hv_t hv;
+        hdc_encode_multi_channel_seeded(hv, &s_values[i * TEST_CHANNELS], TEST_CHANNELS, TEST_SEED);
+        gw_accum_add(&s_reference[s_labels[i]], hv);
+    }
+    gw_accum_reset(s_classes, TEST_CLASSES);
+}
+
+void tearDown(void)
+{
+    gw_pool_destroy(&s_pool);
+}
+
+/* ============================================================================
+ * Accumulator Tests
+ * ============================================================================ */
+
+void test_accum_counts_and_majority(void)
+{
+    gw_accum_t acc;
+    hv_t a, b, c, result, tiebreak;
+
+    hdc_item_generate(a, TEST_SEED, 1U);
+    hdc_item_generate(b, TEST_SEED, 2U);
+    hdc_item_generate(c, TEST_SEED, 3U);
+
+    gw_accum_reset(&acc, 1U);
+    gw_accum_add(&acc, a);
+    gw_accum_add(&acc, b);
+    gw_accum_add(&acc, c);
+    TEST_ASSERT_EQUAL_UINT32(3U, acc.count);
+
+    for (uint32_t d = 0U; d < HV_DIMENSIONS; d++) {
+        uint8_t mask = (uint8_t)(1U << (d % 8U));
+        uint32_t ones = (((a[d / 8U] & mask) != 0U) ? 1U : 0U) +
+                        (((b[d / 8U] & mask) != 0U) ? 1U : 0U) +
+                        (((c[d / 8U] & mask) != 0U) ? 1U : 0U);
+        TEST_ASSERT_EQUAL_UINT32(ones, acc.ones[d]);
+    }
+
+    /* Majority of three = bitwise (a & b) | (a & c) | (b & c) */
+    hv_t ab, ac, bc, expected;
+    hdc_and(ab, a, b);
+    hdc_and(ac, a, c);
+    hdc_and(bc, b, c);
+    hdc_or(expected, ab, ac);
+    hdc_or(expected, expected, bc);
+    gw_accum_threshold(result, &acc, NULL);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, result, HV_BYTES);
+
+    /* Two patterns: ties where they differ */
+    gw_accum_reset(&acc, 1U);
+    gw_accum_add(&acc, a);
+    gw_accum_add(&acc, b);
+    gw_accum_threshold(result, &acc, NULL);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(ab, result, HV_BYTES);
+
+    hdc_fill(tiebreak, 0xFFU);
+    gw_accum_threshold(result, &acc, tiebreak);
+    hdc_or(expected, a, b);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, result, HV_BYTES);
+}
+
+void test_accum_merge_adds(void)
+{
+    gw_accum_t whole, halves[2];
+
+    gw_accum_reset(&whole, 1U);
+    gw_accum_reset(halves, 2U);
+    for (uint16_t i = 0U; i < 40U; i++) {
+        hv_t hv;
+        hdc_item_generate(hv, TEST_SEED, i);
+        gw_accum_add(&whole, hv);
+        gw_accum_add(&halves[i & 1U], hv);
+    }
+    gw_accum_merge(&halves[0], &halves[1]);
+    TEST_ASSERT_EQUAL_MEMORY(&whole, &halves[0], sizeof(whole));
+}
+
+/* ============================================================================
+ * Training Tests
+ * ============================================================================ */
+
+void test_train_matches_serial_for_any_thread_count(void)
+{
+    static const uint32_t threads[] = {1U, 2U, 3U, 5U, TEST_THREADS};
+
+    for (uint8_t t = 0U; t < (sizeof(threads) / sizeof(threads[0])); t++) {
+        TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_init(&s_pool, threads[t]));
+        gw_accum_reset(s_classes, TEST_CLASSES);
+        TEST_ASSERT_EQUAL(GW_BATCH_OK,
+                          gw_batch_train(&s_pool, &s_batch, s_classes, TEST_CLASSES, s_scratch));
+        TEST_ASSERT_EQUAL_MEMORY(s_reference, s_classes, sizeof(s_reference));
+        gw_pool_destroy(&s_pool);
+    }
+}
+
+void test_train_incremental_batches(void)
+{
+    gw_batch_t first = s_batch;
+    gw_batch_t second = s_batch;
+
+    first.num_samples = 217U;
+    second.values = &s_values[217U * TEST_CHANNELS];
+    second.labels = &s_labels[217U];
+    second.num_samples = TEST_SAMPLES - 217U;
+
+    TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_init(&s_pool, 4U));
+    TEST_ASSERT_EQUAL(GW_BATCH_OK, gw_batch_train(&s_pool, &first, s_classes, TEST_CLASSES, s_scratch));
+    TEST_ASSERT_EQUAL(GW_BATCH_OK, gw_batch_train(&s_pool, &second, s_classes, TEST_CLASSES, s_scratch));
+    TEST_ASSERT_EQUAL_MEMORY(s_reference, s_classes, sizeof(s_reference));
+}
+
+void test_train_rejects_bad_labels(void)
+{
+    TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_init(&s_pool, 2U));
+
+    s_labels[TEST_SAMPLES - 1U] = TEST_CLASSES;
+    TEST_ASSERT_EQUAL(GW_BATCH_ERROR_INVALID,
+                      gw_batch_train(&s_pool, &s_batch, s_classes, TEST_CLASSES, s_scratch));
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        TEST_ASSERT_EQUAL_UINT32(0U, s_classes[c].count);
+    }
+
+    s_batch.labels = NULL;
+    TEST_ASSERT_EQUAL(GW_BATCH_ERROR_INVALID,
+                      gw_batch_train(&s_pool, &s_batch, s_classes, TEST_CLASSES, s_scratch));
+}
+
+/* ============================================================================
+ * Classification Tests
+ * ============================================================================ */
+
+void test_classify_matches_serial(void)
+{
+    static hv_t rows[TEST_CLASSES];
+    static hdc_am_match_t results[TEST_SAMPLES];
+    hdc_am_t am;
+    uint16_t correct = 0U;
+
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        gw_accum_threshold(rows[c], &s_reference[c], NULL);
+    }
+    hdc_am_init_view(&am, (const hv_t*)rows, TEST_CLASSES);
+
+    for (uint32_t threads = 1U; threads <= 4U; threads += 3U) {
+        TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_init(&s_pool, threads));
+        memset(results, 0xA5, sizeof(results));
+        TEST_ASSERT_EQUAL(GW_BATCH_OK, gw_batch_classify(&s_pool, &s_batch, &am, results));
+
+        correct = 0U;
+        for (uint16_t i = 0U; i < TEST_SAMPLES; i++) {
+            hv_t hv;
+            hdc_am_match_t expected;
+            hdc_encode_multi_channel_seeded(hv, &s_values[i * TEST_CHANNELS], TEST_CHANNELS, TEST_SEED);
+            TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&am, hv, &expected));
+            TEST_ASSERT_EQUAL_UINT16(expected.class_id, results[i].class_id);
+            TEST_ASSERT_EQUAL_UINT16(expected.distance, results[i].distance);
+            correct += (results[i].class_id == s_labels[i]) ? 1U : 0U;
+        }
+        gw_pool_destroy(&s_pool);
+    }
+
+    /* Well-separated classes: the bundles classify their own training set */
+    TEST_ASSERT_TRUE(correct > (TEST_SAMPLES / 2U));
+}
+
+void test_classify_empty_memory(void)
+{
+    static hv_t storage[1];
+    hdc_am_t am;
+    hdc_am_match_t result;
+
+    hdc_am_init(&am, storage, 1U);
+    TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_init(&s_pool, 2U));
+    TEST_ASSERT_EQUAL(GW_BATCH_ERROR_EMPTY, gw_batch_classify(&s_pool, &s_batch, &am, &result));
+    TEST_ASSERT_EQUAL(GW_BATCH_ERROR_INVALID, gw_batch_classify(&s_pool, &s_batch, &am, NULL));
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Accumulator tests */
+    RUN_TEST(test_accum_counts_and_majority);
+    RUN_TEST(test_accum_merge_adds);
+
+    /* Training tests */
+    RUN_TEST(test_train_matches_serial_for_any_thread_count);
+    RUN_TEST(test_train_incremental_batches);
+    RUN_TEST(test_train_rejects_bad_labels);
+
+    /* Classification tests */
+    RUN_TEST(test_classify_matches_serial);
+    RUN_TEST(test_classify_empty_memory);
+
+    return UNITY_END();
+}
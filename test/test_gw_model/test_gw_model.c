@@ -0,0 +1,433 @@
+/**
+ * @file    test_gw_model.c
+ * @brief   Unit Tests for Gateway Model Files
+ * @version 1.0.0
+ *
+ * @details Tests for the binary model format and the mapped loader:
+ *          - Format: CRC-32 check value, header fields, data alignment
+ *          - Loading: rows are searched in place, results match an SRAM AM
+ *          - Rejection: magic, header CRC, version, width, truncation
+ *          - Integrity: gw_model_verify() catches a corrupted row
+ *          - Transposed: hdc_amt.h planes are written, mapped and searched
+ *            in place; version 1 files still load
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ *          Model files are written to a mkstemp() path under /tmp.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_am.h"
+#include "hdc/hdc_amt.h"
+#include "hdc/hdc_item.h"
+#include "gateway/gw_model.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TEST_SEED       0x4D4F444CUL    /* "MODL" */
+#define TEST_CLASSES    300U
+#define TEST_TOPK       5U
+
+/* Gateway-sized model: 20000 classes, capped at 4 MiB of rows */
+#define LARGE_LIMIT     ((4UL * 1024UL * 1024UL) / HV_BYTES)
+#define LARGE_CLASSES   ((hdc_class_t)((LARGE_LIMIT < 20000UL) ? LARGE_LIMIT : 20000UL))
+
+static hv_t s_rows[TEST_CLASSES];
+static hv_t s_large[LARGE_CLASSES];
+static uint64_t s_planes[HDC_AMT_WORDS(TEST_CLASSES)];
+static char s_path[64];
+static gw_model_t s_model;
+
+void setUp(void)
+{
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        hdc_item_generate(s_rows[c], TEST_SEED, c);
+    }
+
+    strcpy(s_path, "/tmp/gw_model_XXXXXX");
+    int fd = mkstemp(s_path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    (void)close(fd);
+    memset(&s_model, 0, sizeof(s_model));
+}
+
+void tearDown(void)
+{
+    gw_model_close(&s_model);
+    (void)unlink(s_path);
+}
+
+/** @brief Rewrite header bytes in the file and fix up the header CRC */
+static void patch_header(uint8_t offset, const uint8_t* bytes, uint8_t len)
+{
+    uint8_t header[GW_MODEL_HEADER_BYTES];
+    FILE* f = fopen(s_path, "r+b");
+
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(GW_MODEL_HEADER_BYTES, fread(header, 1U, sizeof(header), f));
+    memcpy(&header[offset], bytes, len);
+
+    uint32_t crc = gw_model_crc32(0U, header, 60U);
+    for (uint8_t i = 0U; i < 4U; i++) {
+        header[60U + i] = (uint8_t)(crc >> (8U * i));
+    }
+    TEST_ASSERT_EQUAL(0, fseek(f, 0L, SEEK_SET));
+    TEST_ASSERT_EQUAL(GW_MODEL_HEADER_BYTES, fwrite(header, 1U, sizeof(header), f));
+    TEST_ASSERT_EQUAL(0, fclose(f));
+}
+
+/** @brief XOR one byte of the file */
+static void flip_byte(long offset, uint8_t mask)
+{
+    FILE* f = fopen(s_path, "r+b");
+    int value;
+
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(0, fseek(f, offset, SEEK_SET));
+    value = fgetc(f);
+    TEST_ASSERT_EQUAL(0, fseek(f, offset, SEEK_SET));
+    TEST_ASSERT_EQUAL(value ^ mask, fputc(value ^ mask, f));
+    TEST_ASSERT_EQUAL(0, fclose(f));
+}
+
+/* ============================================================================
+ * Format Tests
+ * ============================================================================ */
+
+void test_crc32_check_value(void)
+{
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926UL, gw_model_crc32(0U, (const uint8_t*)"123456789", 9U));
+
+    /* Chained updates equal one pass */
+    uint32_t crc = gw_model_crc32(0U, (const uint8_t*)"1234", 4U);
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926UL, gw_model_crc32(crc, (const uint8_t*)"56789", 5U));
+}
+
+void test_round_trip_header(void)
+{
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write(s_path, (const hv_t*)s_rows, TEST_CLASSES, TEST_SEED));
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_open(&s_model, s_path));
+
+    TEST_ASSERT_EQUAL_UINT16(GW_MODEL_VERSION, s_model.info.version);
+    TEST_ASSERT_EQUAL_UINT32(HV_DIMENSIONS, s_model.info.dimensions);
+    TEST_ASSERT_EQUAL_UINT32(HV_BYTES, s_model.info.row_bytes);
+    TEST_ASSERT_EQUAL_UINT32(TEST_CLASSES, s_model.info.class_count);
+    TEST_ASSERT_EQUAL_HEX32(TEST_SEED, s_model.info.item_seed);
+    TEST_ASSERT_EQUAL_UINT32(0U, (uint32_t)(s_model.info.data_offset % GW_MODEL_ALIGN));
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_verify(&s_model));
+}
+
+/* ============================================================================
+ * Loading Tests
+ * ============================================================================ */
+
+void test_rows_are_searched_in_place(void)
+{
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write(s_path, (const hv_t*)s_rows, TEST_CLASSES, TEST_SEED));
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_open(&s_model, s_path));
+
+    /* No copy: the AM rows are the mapped data section */
+    const uint8_t* rows = (const uint8_t*)s_model.am.classes;
+    TEST_ASSERT_EQUAL_PTR(s_model.map + s_model.info.data_offset, rows);
+    TEST_ASSERT_EQUAL_UINT32(0U, (uint32_t)((uintptr_t)rows % GW_MODEL_ALIGN));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(s_rows, rows, sizeof(s_rows));
+
+    /* Read-only view */
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_READ_ONLY, hdc_am_set(&s_model.am, 0U, s_rows[1]));
+}
+
+void test_queries_match_sram_memory(void)
+{
+    hdc_am_t ram;
+    hdc_am_match_t expected[TEST_TOPK], actual[TEST_TOPK];
+    hv_t query;
+
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write(s_path, (const hv_t*)s_rows, TEST_CLASSES, TEST_SEED));
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_open(&s_model, s_path));
+    hdc_am_init_view(&ram, (const hv_t*)s_rows, TEST_CLASSES);
+
+    for (uint8_t q = 0U; q < 16U; q++) {
+        hdc_item_generate(query, TEST_SEED + 1UL, q);
+        hdc_xor(query, query, s_rows[q * 17U]);
+        hdc_or(query, query, s_rows[q * 17U]);     /* biased towards one class */
+
+        uint8_t n = hdc_am_query_topk(&ram, query, expected, TEST_TOPK);
+        TEST_ASSERT_EQUAL_UINT8(n, hdc_am_query_topk(&s_model.am, query, actual, TEST_TOPK));
+        for (uint8_t i = 0U; i < n; i++) {
+            TEST_ASSERT_EQUAL_UINT16(expected[i].class_id, actual[i].class_id);
+            TEST_ASSERT_EQUAL_UINT16(expected[i].distance, actual[i].distance);
+        }
+    }
+}
+
+void test_large_model_matches_sram_memory(void)
+{
+    hdc_am_t ram;
+    hdc_am_match_t expected, actual;
+
+    for (hdc_class_t c = 0U; c < LARGE_CLASSES; c++) {
+        hdc_item_generate(s_large[c], TEST_SEED, c);
+    }
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write(s_path, (const hv_t*)s_large, LARGE_CLASSES, TEST_SEED));
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_open(&s_model, s_path));
+    TEST_ASSERT_EQUAL_UINT16(LARGE_CLASSES, s_model.am.count);
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_verify(&s_model));
+    hdc_am_init_view(&ram, (const hv_t*)s_large, LARGE_CLASSES);
+
+    for (hdc_class_t c = 0U; c < LARGE_CLASSES; c += (LARGE_CLASSES / 8U)) {
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&ram, s_large[c], &expected));
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&s_model.am, s_large[c], &actual));
+        TEST_ASSERT_EQUAL_UINT16(c, actual.class_id);
+        TEST_ASSERT_EQUAL_UINT16(expected.class_id, actual.class_id);
+        TEST_ASSERT_EQUAL_UINT16(expected.distance, actual.distance);
+    }
+}
+
+void test_empty_model(void)
+{
+    hdc_am_match_t best;
+
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write(s_path, NULL, 0U, 0UL));
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_open(&s_model, s_path));
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_EMPTY, hdc_am_query(&s_model.am, s_rows[0], &best));
+}
+
+/* ============================================================================
+ * Rejection Tests
+ * ============================================================================ */
+
+void test_missing_file(void)
+{
+    (void)unlink(s_path);
+    TEST_ASSERT_EQUAL(GW_MODEL_ERROR_IO, gw_model_open(&s_model, s_path));
+    TEST_ASSERT_NULL(s_model.map);
+}
+
+void test_bad_magic_and_header_crc(void)
+{
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write(s_path, (const hv_t*)s_rows, TEST_CLASSES, TEST_SEED));
+
+    flip_byte(20L, 0x01U);      /* flags: header CRC no longer matches */
+    TEST_ASSERT_EQUAL(GW_MODEL_ERROR_FORMAT, gw_model_open(&s_model, s_path));
+    flip_byte(20L, 0x01U);
+
+    flip_byte(0L, 0x20U);       /* 'H' -> 'h' */
+    TEST_ASSERT_EQUAL(GW_MODEL_ERROR_FORMAT, gw_model_open(&s_model, s_path));
+    TEST_ASSERT_NULL(s_model.map);
+}
+
+void test_version_and_width_checks(void)
+{
+    static const uint8_t version3[2] = {3U, 0U};
+    uint8_t dims[8];
+    uint32_t other = HV_DIMENSIONS + 8U;
+
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write(s_path, (const hv_t*)s_rows, TEST_CLASSES, TEST_SEED));
+    patch_header(4U, version3, 2U);
+    TEST_ASSERT_EQUAL(GW_MODEL_ERROR_VERSION, gw_model_open(&s_model, s_path));
+
+    /* A self-consistent header written for a wider model, with as many of
+     * its rows as fit in the data of 8 rows of ours */
+    uint32_t wide_bytes = (other + 7U) / 8U;
+    uint32_t wide_count = (8U * HV_BYTES) / wide_bytes;
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write(s_path, (const hv_t*)s_rows, 8U, TEST_SEED));
+    for (uint8_t i = 0U; i < 4U; i++) {
+        dims[i] = (uint8_t)(other >> (8U * i));
+        dims[4U + i] = (uint8_t)(wide_bytes >> (8U * i));
+    }
+    patch_header(8U, dims, 8U);
+    uint8_t count[4] = {(uint8_t)wide_count, 0U, 0U, 0U};
+    uint8_t bytes[8];
+    uint64_t data = (uint64_t)wide_count * wide_bytes;
+    for (uint8_t i = 0U; i < 8U; i++) {
+        bytes[i] = (uint8_t)(data >> (8U * i));
+    }
+    patch_header(16U, count, 4U);
+    patch_header(32U, bytes, 8U);
+    TEST_ASSERT_EQUAL(GW_MODEL_ERROR_DIMENSIONS, gw_model_open(&s_model, s_path));
+}
+
+void test_truncated_file(void)
+{
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write(s_path, (const hv_t*)s_rows, TEST_CLASSES, TEST_SEED));
+    TEST_ASSERT_EQUAL(0, truncate(s_path, (off_t)(GW_MODEL_ALIGN + (HV_BYTES * (TEST_CLASSES - 1U)))));
+    TEST_ASSERT_EQUAL(GW_MODEL_ERROR_FORMAT, gw_model_open(&s_model, s_path));
+
+    TEST_ASSERT_EQUAL(0, truncate(s_path, 10));
+    TEST_ASSERT_EQUAL(GW_MODEL_ERROR_FORMAT, gw_model_open(&s_model, s_path));
+}
+
+/* ============================================================================
+ * Integrity Tests
+ * ============================================================================ */
+
+void test_verify_catches_corrupted_row(void)
+{
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write(s_path, (const hv_t*)s_rows, TEST_CLASSES, TEST_SEED));
+    flip_byte((long)(GW_MODEL_ALIGN + (HV_BYTES * 123U) + 1U), 0x10U);
+
+    /* Open only checks the header; the data CRC is opt-in */
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_open(&s_model, s_path));
+    TEST_ASSERT_EQUAL(GW_MODEL_ERROR_CHECKSUM, gw_model_verify(&s_model));
+}
+
+/* ============================================================================
+ * Transposed Layout Tests
+ * ============================================================================ */
+
+/** @brief Transposed memory over s_planes holding every s_rows class */
+static void fill_transposed(hdc_amt_t* amt)
+{
+    hdc_amt_init(amt, s_planes, TEST_CLASSES);
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_amt_add(amt, s_rows[c], NULL));
+    }
+}
+
+void test_transposed_planes_are_searched_in_place(void)
+{
+    hdc_amt_t amt;
+
+    fill_transposed(&amt);
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write_transposed(s_path, &amt, TEST_SEED));
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_open(&s_model, s_path));
+
+    TEST_ASSERT_EQUAL_HEX32(GW_MODEL_FLAG_TRANSPOSED, s_model.info.flags);
+    TEST_ASSERT_EQUAL_UINT32(TEST_CLASSES, s_model.info.class_count);
+    TEST_ASSERT_EQUAL_UINT64(sizeof(s_planes), s_model.info.data_bytes);
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_verify(&s_model));
+
+    /* No copy: the planes are the mapped data section; the row view is empty */
+    TEST_ASSERT_EQUAL_PTR(s_model.map + s_model.info.data_offset, s_model.amt.planes);
+    TEST_ASSERT_EQUAL_UINT16(TEST_CLASSES, s_model.amt.count);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(s_planes, s_model.amt.planes, sizeof(s_planes));
+    TEST_ASSERT_EQUAL_UINT16(0U, s_model.am.count);
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_READ_ONLY, hdc_amt_set(&s_model.amt, 0U, s_rows[1]));
+}
+
+void test_transposed_queries_match_row_model(void)
+{
+    hdc_amt_t amt;
+    gw_model_t rows;
+    hdc_am_match_t expected[TEST_TOPK], actual[TEST_TOPK];
+    hv_t query;
+    char row_path[72];
+
+    fill_transposed(&amt);
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write_transposed(s_path, &amt, TEST_SEED));
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_open(&s_model, s_path));
+
+    (void)snprintf(row_path, sizeof(row_path), "%s.rows", s_path);
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write(row_path, (const hv_t*)s_rows, TEST_CLASSES, TEST_SEED));
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_open(&rows, row_path));
+    TEST_ASSERT_EQUAL_UINT32(0U, rows.info.flags);
+    TEST_ASSERT_NULL(rows.amt.planes);
+
+    for (uint8_t q = 0U; q < 16U; q++) {
+        hdc_item_generate(query, TEST_SEED + 1UL, q);
+        hdc_xor(query, query, s_rows[q * 17U]);
+        hdc_or(query, query, s_rows[q * 17U]);     /* biased towards one class */
+
+        uint8_t n = hdc_am_query_topk(&rows.am, query, expected, TEST_TOPK);
+        TEST_ASSERT_EQUAL_UINT8(n, hdc_amt_query_topk(&s_model.amt, query, actual, TEST_TOPK));
+        for (uint8_t i = 0U; i < n; i++) {
+            TEST_ASSERT_EQUAL_UINT16(expected[i].class_id, actual[i].class_id);
+            TEST_ASSERT_EQUAL_UINT16(expected[i].distance, actual[i].distance);
+        }
+    }
+    gw_model_close(&rows);
+    (void)unlink(row_path);
+}
+
+void test_transposed_header_checks(void)
+{
+    static const uint8_t version1[2] = {1U, 0U};
+    static const uint8_t unknown[4] = {0x03U, 0U, 0U, 0U};
+    uint8_t bytes[8];
+    uint64_t row_bytes = (uint64_t)TEST_CLASSES * HV_BYTES;
+    hdc_amt_t amt;
+
+    /* A version 1 row file (no flags) still loads */
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write(s_path, (const hv_t*)s_rows, TEST_CLASSES, TEST_SEED));
+    patch_header(4U, version1, 2U);
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_open(&s_model, s_path));
+    TEST_ASSERT_EQUAL_UINT16(1U, s_model.info.version);
+    gw_model_close(&s_model);
+
+    /* Version 1 has no transposed layout, and unknown flags are rejected */
+    fill_transposed(&amt);
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write_transposed(s_path, &amt, TEST_SEED));
+    patch_header(4U, version1, 2U);
+    TEST_ASSERT_EQUAL(GW_MODEL_ERROR_FORMAT, gw_model_open(&s_model, s_path));
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write_transposed(s_path, &amt, TEST_SEED));
+    patch_header(20U, unknown, 4U);
+    TEST_ASSERT_EQUAL(GW_MODEL_ERROR_FORMAT, gw_model_open(&s_model, s_path));
+
+    /* The data size must be the plane size, not the row size */
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write_transposed(s_path, &amt, TEST_SEED));
+    for (uint8_t i = 0U; i < 8U; i++) {
+        bytes[i] = (uint8_t)(row_bytes >> (8U * i));
+    }
+    patch_header(32U, bytes, 8U);
+    TEST_ASSERT_EQUAL(GW_MODEL_ERROR_FORMAT, gw_model_open(&s_model, s_path));
+
+    TEST_ASSERT_EQUAL(GW_MODEL_ERROR_INVALID, gw_model_write_transposed(s_path, NULL, TEST_SEED));
+}
+
+void test_transposed_empty_model(void)
+{
+    hdc_amt_t amt;
+    hdc_am_match_t best;
+
+    hdc_amt_init(&amt, s_planes, TEST_CLASSES);
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_write_transposed(s_path, &amt, 0UL));
+    TEST_ASSERT_EQUAL(GW_MODEL_OK, gw_model_open(&s_model, s_path));
+    TEST_ASSERT_EQUAL_UINT64(0U, s_model.info.data_bytes);
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_EMPTY, hdc_amt_query(&s_model.amt, s_rows[0], &best));
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Format tests */
+    RUN_TEST(test_crc32_check_value);
+    RUN_TEST(test_round_trip_header);
+
+    /* Loading tests */
+    RUN_TEST(test_rows_are_searched_in_place);
+    RUN_TEST(test_queries_match_sram_memory);
+    RUN_TEST(test_large_model_matches_sram_memory);
+    RUN_TEST(test_empty_model);
+
+    /* Rejection tests */
+    RUN_TEST(test_missing_file);
+    RUN_TEST(test_bad_magic_and_header_crc);
+    RUN_TEST(test_version_and_width_checks);
+    RUN_TEST(test_truncated_file);
+
+    /* Integrity tests */
+    RUN_TEST(test_verify_catches_corrupted_row);
+
+    /* Transposed layout tests */
+    RUN_TEST(test_transposed_planes_are_searched_in_place);
+    RUN_TEST(test_transposed_queries_match_row_model);
+    RUN_TEST(test_transposed_header_checks);
+    RUN_TEST(test_transposed_empty_model);
+
+    return UNITY_END();
+}
@@ -0,0 +1,190 @@
+/**
+ * @file    test_gw_pool.c
+ * @brief   Unit Tests for the Work-Stealing Thread Pool
+ * @version 1.0.0
+ *
+ * @details Tests for the gateway pool:
+ *          - Init: thread count limits, inline single-thread runs
+ *          - Coverage: every index runs exactly once for any thread count,
+ *            grain and batch size, including skewed per-index cost
+ *          - Reuse: many back-to-back runs on one pool
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "gateway/gw_pool.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TEST_MAX_ITEMS  4096U
+
+/** @brief Per-index record; each index is written by one worker only */
+typedef struct {
+    uint8_t  visits[TEST_MAX_ITEMS];
+    uint8_t  worker[TEST_MAX_ITEMS];
+    size_t   next[GW_POOL_MAX_THREADS];     /* Expected begin if in order */
+    uint32_t empty[GW_POOL_MAX_THREADS];    /* Chunks with begin >= end */
+    uint32_t jumps[GW_POOL_MAX_THREADS];    /* Chunks not following the last */
+    uint32_t heavy;                         /* Indices below this are slow */
+} visit_log_t;
+
+static gw_pool_t s_pool;
+static visit_log_t s_log;
+
+void setUp(void)
+{
+    memset(&s_log, 0, sizeof(s_log));
+}
+
+void tearDown(void)
+{
+    gw_pool_destroy(&s_pool);
+}
+
+/** @brief Busy work the compiler cannot drop */
+static uint32_t spin(uint32_t rounds)
+{
+    volatile uint32_t x = 1U;
+    for (uint32_t i = 0U; i < rounds; i++) {
+        x = (x * 1664525UL) + 1013904223UL;
+    }
+    return x;
+}
+
+static void record(void* ctx, uint32_t worker, size_t begin, size_t end)
+{
+    visit_log_t* log = (visit_log_t*)ctx;
+
+    /* Runs on pool threads: count problems, assert on the main thread */
+    log->empty[worker] += (begin >= end) ? 1U : 0U;
+    log->jumps[worker] += (begin != log->next[worker]) ? 1U : 0U;
+    log->next[worker] = end;
+    for (size_t i = begin; i < end; i++) {
+        if (i < log->heavy) {
+            (void)spin(20000U);
+        }
+        log->visits[i]++;
+        log->worker[i] = (uint8_t)worker;
+    }
+}
+
+static void assert_each_once(size_t count, uint32_t threads)
+{
+    for (uint32_t w = 0U; w < GW_POOL_MAX_THREADS; w++) {
+        TEST_ASSERT_EQUAL_UINT32(0U, s_log.empty[w]);
+    }
+    for (size_t i = 0U; i < count; i++) {
+        TEST_ASSERT_EQUAL_UINT8(1U, s_log.visits[i]);
+        TEST_ASSERT_TRUE(s_log.worker[i] < threads);
+    }
+    for (size_t i = count; i < TEST_MAX_ITEMS; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0U, s_log.visits[i]);
+    }
+}
+
+/* ============================================================================
+ * Init Tests
+ * ============================================================================ */
+
+void test_init_rejects_bad_thread_counts(void)
+{
+    TEST_ASSERT_EQUAL(GW_POOL_ERROR_INVALID, gw_pool_init(&s_pool, 0U));
+    TEST_ASSERT_EQUAL(GW_POOL_ERROR_INVALID, gw_pool_init(&s_pool, GW_POOL_MAX_THREADS + 1U));
+    TEST_ASSERT_EQUAL(GW_POOL_ERROR_INVALID, gw_pool_init(NULL, 2U));
+
+    TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_init(&s_pool, 3U));
+    TEST_ASSERT_EQUAL_UINT32(3U, gw_pool_threads(&s_pool));
+    TEST_ASSERT_EQUAL(GW_POOL_ERROR_INVALID, gw_pool_run(&s_pool, 10U, 1U, NULL, NULL));
+}
+
+void test_single_thread_runs_inline_in_order(void)
+{
+    TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_init(&s_pool, 1U));
+    TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_run(&s_pool, 100U, 7U, record, &s_log));
+
+    assert_each_once(100U, 1U);
+    TEST_ASSERT_EQUAL_UINT32(0U, s_log.jumps[0]);
+    TEST_ASSERT_EQUAL_UINT32(0U, gw_pool_steals(&s_pool));
+}
+
+/* ============================================================================
+ * Coverage Tests
+ * ============================================================================ */
+
+void test_every_index_once(void)
+{
+    static const uint32_t threads[] = {1U, 2U, 3U, 4U, 8U};
+    static const size_t counts[] = {0U, 1U, 5U, 97U, TEST_MAX_ITEMS};
+    static const size_t grains[] = {0U, 1U, 16U, 10000U};
+
+    for (uint8_t t = 0U; t < (sizeof(threads) / sizeof(threads[0])); t++) {
+        TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_init(&s_pool, threads[t]));
+        for (uint8_t c = 0U; c < (sizeof(counts) / sizeof(counts[0])); c++) {
+            for (uint8_t g = 0U; g < (sizeof(grains) / sizeof(grains[0])); g++) {
+                memset(&s_log, 0, sizeof(s_log));
+                TEST_ASSERT_EQUAL(GW_POOL_OK,
+                                  gw_pool_run(&s_pool, counts[c], grains[g], record, &s_log));
+                assert_each_once(counts[c], threads[t]);
+            }
+        }
+        gw_pool_destroy(&s_pool);
+    }
+}
+
+void test_skewed_batch(void)
+{
+    /* All the cost sits in worker 0's initial slice */
+    s_log.heavy = 256U;
+
+    TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_init(&s_pool, 4U));
+    TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_run(&s_pool, 1024U, 4U, record, &s_log));
+    assert_each_once(1024U, 4U);
+}
+
+/* ============================================================================
+ * Reuse Tests
+ * ============================================================================ */
+
+void test_back_to_back_runs(void)
+{
+    TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_init(&s_pool, 4U));
+
+    for (uint16_t run = 0U; run < 500U; run++) {
+        size_t count = (size_t)(run % 61U) + 1U;
+        memset(&s_log, 0, sizeof(s_log));
+        TEST_ASSERT_EQUAL(GW_POOL_OK, gw_pool_run(&s_pool, count, 1U, record, &s_log));
+        assert_each_once(count, 4U);
+    }
+
+    /* Destroy is idempotent */
+    gw_pool_destroy(&s_pool);
+    gw_pool_destroy(&s_pool);
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Init tests */
+    RUN_TEST(test_init_rejects_bad_thread_counts);
+    RUN_TEST(test_single_thread_runs_inline_in_order);
+
+    /* Coverage tests */
+    RUN_TEST(test_every_index_once);
+    RUN_TEST(test_skewed_batch);
+
+    /* Reuse tests */
+    RUN_TEST(test_back_to_back_runs);
+
+    return UNITY_END();
+}
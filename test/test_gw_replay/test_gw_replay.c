@@ -0,0 +1,301 @@
+/**
+ * @file    test_gw_replay.c
+ * @brief   Unit Tests for Offline Trace Replay
+ * @version 1.0.0
+ *
+ * @details Tests for the replay pipeline:
+ *          - Equivalence: counters, prototypes and results equal the device
+ *            steps (level, seeded encode, mistake-driven learning or plain
+ *            bundling, AM query) by hand
+ *          - Windowing: train/test split, label changes, skipped labels
+ *          - Errors: invalid settings, malformed trace records
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ *          Trace files are written to a mkstemp() path under /tmp.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_encode.h"
+#include "hdc/hdc_item.h"
+#include "hdc/hdc_counter.h"
+#include "hdc/hdc_am.h"
+#include "hdc/hdc_proto.h"
+#include "hdc/hdc_learn.h"
+#include "gateway/gw_trace.h"
+#include "gateway/gw_replay.h"
+#include "mock_hv.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TEST_CHANNELS   3U
+#define TEST_CLASSES    3U
+#define TEST_WINDOW     4U
+#define TEST_WINDOWS    60U
+#define TEST_RECORDS    (TEST_WINDOWS * TEST_WINDOW)
+
+static uint16_t s_labels[TEST_RECORDS];
+static uint16_t s_values[TEST_RECORDS * TEST_CHANNELS];
+static char s_path[64];
+static gw_trace_t s_trace;
+static gw_replay_config_t s_config;
+static gw_replay_report_t s_report;
+static hdc_counter_t s_counters[TEST_CLASSES];
+static hv_t s_rows[TEST_CLASSES];
+static hdc_counter_mask_t s_masks[2U * TEST_CLASSES];
+
+/** @brief Blocks of TEST_WINDOW records per label, noisy class levels */
+void setUp(void)
+{
+    uint32_t lcg = 99U;
+
+    for (uint16_t i = 0U; i < TEST_RECORDS; i++) {
+        uint16_t label = (uint16_t)((i / TEST_WINDOW) % TEST_CLASSES);
+        s_labels[i] = label;
+        for (uint8_t ch = 0U; ch < TEST_CHANNELS; ch++) {
+            uint16_t base = (uint16_t)((((label + ch) % TEST_CLASSES) * 400U) + 50U);
+            s_values[(i * TEST_CHANNELS) + ch] =
+                (uint16_t)(base + (pseudo_random_next(&lcg) % 150U));
+        }
+    }
+
+    strcpy(s_path, "/tmp/gw_replay_XXXXXX");
+    int fd = mkstemp(s_path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    (void)close(fd);
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_write(s_path, s_labels, s_values, TEST_RECORDS, TEST_CHANNELS));
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_open(&s_trace, s_path));
+
+    gw_replay_defaults(&s_config, TEST_CLASSES);
+    s_config.window = TEST_WINDOW;
+    s_config.test_every = 3U;
+}
+
+void tearDown(void)
+{
+    gw_trace_close(&s_trace);
+    (void)unlink(s_path);
+}
+
+/** @brief Device steps for window w of the fixture */
+static void encode_window(hv_t hv, uint16_t w, uint8_t channels)
+{
+    hdc_level_t levels[TEST_CHANNELS];
+
+    for (uint8_t ch = 0U; ch < channels; ch++) {
+        uint32_t sum = 0U;
+        for (uint16_t k = 0U; k < TEST_WINDOW; k++) {
+            sum += s_values[(((w * TEST_WINDOW) + k) * TEST_CHANNELS) + ch];
+        }
+        levels[ch] = hdc_level_from_adc((uint16_t)(sum / TEST_WINDOW));
+    }
+    hdc_encode_levels_seeded(hv, levels, channels, s_config.item_seed);
+}
+
+/* ============================================================================
+ * Equivalence Tests
+ * ============================================================================ */
+
+void test_replay_learn_equals_device_steps(void)
+{
+    const uint8_t all_classes = (uint8_t)((1U << TEST_CLASSES) - 1U);
+    hdc_counter_t counters[TEST_CLASSES];
+    hdc_counter_mask_t stale[TEST_CLASSES], unsaved[TEST_CLASSES];
+    hv_t rows[TEST_CLASSES], hv;
+    hdc_am_t am;
+    hdc_proto_t proto;
+    hdc_learn_t learn;
+    uint8_t trained_mask = 0U;
+
+    /* Every fourth window is held out, so all classes are trained */
+    TEST_ASSERT_TRUE(s_config.learn);
+    s_config.test_every = 4U;
+    TEST_ASSERT_EQUAL(GW_REPLAY_OK, gw_replay_run(&s_config, &s_trace, s_counters, s_rows, s_masks, &s_report));
+
+    /* task_infer and task_learn of src/app/main.c by hand */
+    hdc_clear(hv);
+    hdc_am_init(&am, rows, TEST_CLASSES);
+    for (uint8_t c = 0U; c < TEST_CLASSES; c++) {
+        hdc_counter_reset(&counters[c]);
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_add(&am, hv, NULL));
+    }
+    TEST_ASSERT_EQUAL(HDC_PROTO_OK, hdc_proto_init(&proto, &am, counters, stale, unsaved, NULL));
+    hdc_learn_init(&learn, &proto);
+    for (uint16_t w = 0U; w < TEST_WINDOWS; w++) {
+        hdc_class_t label = s_labels[w * TEST_WINDOW];
+        hdc_am_match_t match = { .class_id = HDC_AM_CLASS_NONE };
+
+        if ((w % 4U) == 3U) {
+            continue;
+        }
+        encode_window(hv, w, TEST_CHANNELS);
+        if (trained_mask == all_classes) {
+            (void)hdc_proto_refresh(&proto);
+            TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&am, hv, &match));
+        }
+        if ((match.class_id != label) &&
+            (hdc_learn_update(&learn, hv, label, match.class_id) == HDC_LEARN_OK)) {
+            trained_mask |= (uint8_t)(1U << label);
+        }
+    }
+    TEST_ASSERT_EQUAL_MEMORY(counters, s_counters, sizeof(counters));
+
+    /* Only the first window of each class and the mistakes retrained */
+    TEST_ASSERT_EQUAL_UINT64(45U, s_report.trained);
+    TEST_ASSERT_EQUAL_UINT64(learn.updates, s_report.updated);
+    TEST_ASSERT_TRUE(s_report.updated < s_report.trained);
+    TEST_ASSERT_EQUAL_UINT64(15U, s_report.tested);
+}
+
+void test_replay_bundle_equals_device_steps(void)
+{
+    hdc_counter_t counters[TEST_CLASSES];
+    hv_t rows[TEST_CLASSES], hv;
+    hdc_am_t am;
+    uint64_t correct = 0U;
+
+    s_config.learn = false;
+    TEST_ASSERT_EQUAL(GW_REPLAY_OK, gw_replay_run(&s_config, &s_trace, s_counters, s_rows, s_masks, &s_report));
+
+    /* Same steps by hand: windows 2, 5, 8, ... are held out */
+    for (uint8_t c = 0U; c < TEST_CLASSES; c++) {
+        hdc_counter_reset(&counters[c]);
+    }
+    for (uint16_t w = 0U; w < TEST_WINDOWS; w++) {
+        if ((w % 3U) != 2U) {
+            encode_window(hv, w, TEST_CHANNELS);
+            hdc_counter_add(&counters[s_labels[w * TEST_WINDOW]], hv);
+        }
+    }
+    for (uint8_t c = 0U; c < TEST_CLASSES; c++) {
+        hdc_counter_threshold(rows[c], &counters[c], NULL);
+    }
+    TEST_ASSERT_EQUAL_MEMORY(counters, s_counters, sizeof(counters));
+    TEST_ASSERT_EQUAL_MEMORY(rows, s_rows, sizeof(rows));
+
+    hdc_am_init_view(&am, (const hv_t*)rows, TEST_CLASSES);
+    for (uint16_t w = 2U; w < TEST_WINDOWS; w += 3U) {
+        hdc_am_match_t best;
+        encode_window(hv, w, TEST_CHANNELS);
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&am, hv, &best));
+        correct += (best.class_id == s_labels[w * TEST_WINDOW]) ? 1U : 0U;
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(TEST_RECORDS, s_report.records);
+    TEST_ASSERT_EQUAL_UINT64(TEST_WINDOWS, s_report.windows);
+    TEST_ASSERT_EQUAL_UINT64(40U, s_report.trained);
+    TEST_ASSERT_EQUAL_UINT64(40U, s_report.updated);
+    TEST_ASSERT_EQUAL_UINT64(20U, s_report.tested);
+    TEST_ASSERT_EQUAL_UINT64(correct, s_report.correct);
+    TEST_ASSERT_TRUE(s_report.total_ns >= (s_report.encode_ns + s_report.query_ns));
+}
+
+void test_replay_channel_subset_and_train_on_all(void)
+{
+    hdc_counter_t counter;
+    hv_t hv;
+
+    s_config.channels = 1U;
+    s_config.test_every = 0U;
+    s_config.learn = false;
+    TEST_ASSERT_EQUAL(GW_REPLAY_OK, gw_replay_run(&s_config, &s_trace, s_counters, s_rows, s_masks, &s_report));
+    TEST_ASSERT_EQUAL_UINT64(TEST_WINDOWS, s_report.trained);
+    TEST_ASSERT_EQUAL_UINT64(TEST_WINDOWS, s_report.tested);
+
+    hdc_counter_reset(&counter);
+    for (uint16_t w = 0U; w < TEST_WINDOWS; w += TEST_CLASSES) {
+        encode_window(hv, w, 1U);
+        hdc_counter_add(&counter, hv);
+    }
+    TEST_ASSERT_EQUAL_MEMORY(&counter, &s_counters[0], sizeof(counter));
+}
+
+/* ============================================================================
+ * Windowing Tests
+ * ============================================================================ */
+
+void test_replay_drops_split_windows_and_skips_labels(void)
+{
+    /* Window 5 is TEST_WINDOW + 1 records wide: no longer aligned */
+    s_config.window = TEST_WINDOW + 1U;
+    s_config.test_every = 0U;
+    TEST_ASSERT_EQUAL(GW_REPLAY_OK, gw_replay_run(&s_config, &s_trace, s_counters, s_rows, s_masks, &s_report));
+    TEST_ASSERT_EQUAL_UINT64(0U, s_report.windows);
+
+    /* Class 2 becomes unknown: its records are skipped, its row stays zero */
+    s_config.window = TEST_WINDOW;
+    s_config.num_classes = 2U;
+    TEST_ASSERT_EQUAL(GW_REPLAY_OK, gw_replay_run(&s_config, &s_trace, s_counters, s_rows, s_masks, &s_report));
+    TEST_ASSERT_EQUAL_UINT64(TEST_RECORDS / 3U, s_report.skipped);
+    TEST_ASSERT_EQUAL_UINT64((TEST_WINDOWS * 2U) / 3U, s_report.windows);
+}
+
+/* ============================================================================
+ * Error Tests
+ * ============================================================================ */
+
+void test_replay_rejects_bad_settings(void)
+{
+    gw_replay_config_t config = s_config;
+
+    config.window = 0U;
+    TEST_ASSERT_EQUAL(GW_REPLAY_ERROR_INVALID, gw_replay_run(&config, &s_trace, s_counters, s_rows, s_masks, &s_report));
+    config = s_config;
+    config.channels = TEST_CHANNELS + 1U;
+    TEST_ASSERT_EQUAL(GW_REPLAY_ERROR_INVALID, gw_replay_run(&config, &s_trace, s_counters, s_rows, s_masks, &s_report));
+    config = s_config;
+    config.num_classes = 0U;
+    TEST_ASSERT_EQUAL(GW_REPLAY_ERROR_INVALID, gw_replay_run(&config, &s_trace, s_counters, s_rows, s_masks, &s_report));
+
+    /* Learning needs the cache masks; bundling does not */
+    config = s_config;
+    TEST_ASSERT_EQUAL(GW_REPLAY_ERROR_INVALID, gw_replay_run(&config, &s_trace, s_counters, s_rows, NULL, &s_report));
+    config.learn = false;
+    TEST_ASSERT_EQUAL(GW_REPLAY_OK, gw_replay_run(&config, &s_trace, s_counters, s_rows, NULL, &s_report));
+}
+
+void test_replay_reports_malformed_record(void)
+{
+    FILE* f = fopen(s_path, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    fputs("0,10,20,30\n1,10,20,30\n1,10,20\n", f);
+    TEST_ASSERT_EQUAL(0, fclose(f));
+
+    gw_trace_close(&s_trace);
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_open(&s_trace, s_path));
+    TEST_ASSERT_EQUAL(GW_REPLAY_ERROR_TRACE, gw_replay_run(&s_config, &s_trace, s_counters, s_rows, s_masks, &s_report));
+    TEST_ASSERT_EQUAL_UINT32(3U, s_trace.line);
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Equivalence tests */
+    RUN_TEST(test_replay_learn_equals_device_steps);
+    RUN_TEST(test_replay_bundle_equals_device_steps);
+    RUN_TEST(test_replay_channel_subset_and_train_on_all);
+
+    /* Windowing tests */
+    RUN_TEST(test_replay_drops_split_windows_and_skips_labels);
+
+    /* Error tests */
+    RUN_TEST(test_replay_rejects_bad_settings);
+    RUN_TEST(test_replay_reports_malformed_record);
+
+    return UNITY_END();
+}
@@ -0,0 +1,255 @@
+/**
+ * @file    test_gw_trace.c
+ * @brief   Unit Tests for Recorded ADC Traces
+ * @version 1.0.0
+ *
+ * @details Tests for the mapped trace reader:
+ *          - CSV: column header (also after comments), comments, blank
+ *            lines, CRLF, spacing, channel count checks, out-of-range
+ *            values, no final newline
+ *          - Binary: write/read round trip, header and size checks
+ *          - Both formats decode the same records; rewind restarts
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ *          Trace files are written to a mkstemp() path under /tmp.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "gateway/gw_trace.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+static char s_path[64];
+static gw_trace_t s_trace;
+
+void setUp(void)
+{
+    strcpy(s_path, "/tmp/gw_trace_XXXXXX");
+    int fd = mkstemp(s_path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    (void)close(fd);
+    memset(&s_trace, 0, sizeof(s_trace));
+}
+
+void tearDown(void)
+{
+    gw_trace_close(&s_trace);
+    (void)unlink(s_path);
+}
+
+static void write_text(const char* text)
+{
+    FILE* f = fopen(s_path, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(strlen(text), fwrite(text, 1U, strlen(text), f));
+    TEST_ASSERT_EQUAL(0, fclose(f));
+}
+
+/* ============================================================================
+ * CSV Tests
+ * ============================================================================ */
+
+void test_csv_records(void)
+{
+    gw_trace_record_t r;
+
+    write_text("label,ch0,ch1\r\n"
+               "# recorded on bench 2\n"
+               "\n"
+               "0,12,1023\r\n"
+               "1, 400 ,\t7\n"
+               "65534,0,65535");
+
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_open(&s_trace, s_path));
+    TEST_ASSERT_EQUAL(GW_TRACE_CSV, s_trace.kind);
+    TEST_ASSERT_EQUAL_UINT8(2U, s_trace.channels);
+
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_next(&s_trace, &r));
+    TEST_ASSERT_EQUAL_UINT16(0U, r.label);
+    TEST_ASSERT_EQUAL_UINT16(12U, r.values[0]);
+    TEST_ASSERT_EQUAL_UINT16(1023U, r.values[1]);
+    TEST_ASSERT_EQUAL_UINT32(4U, s_trace.line);
+
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_next(&s_trace, &r));
+    TEST_ASSERT_EQUAL_UINT16(1U, r.label);
+    TEST_ASSERT_EQUAL_UINT16(400U, r.values[0]);
+    TEST_ASSERT_EQUAL_UINT16(7U, r.values[1]);
+
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_next(&s_trace, &r));
+    TEST_ASSERT_EQUAL_UINT16(65534U, r.label);
+    TEST_ASSERT_EQUAL_UINT16(65535U, r.values[1]);
+
+    TEST_ASSERT_EQUAL(GW_TRACE_END, gw_trace_next(&s_trace, &r));
+    TEST_ASSERT_EQUAL(GW_TRACE_END, gw_trace_next(&s_trace, &r));
+    TEST_ASSERT_EQUAL_UINT32(3U, s_trace.index);
+
+    gw_trace_rewind(&s_trace);
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_next(&s_trace, &r));
+    TEST_ASSERT_EQUAL_UINT16(12U, r.values[0]);
+}
+
+void test_csv_header_after_comments(void)
+{
+    gw_trace_record_t r;
+
+    write_text("# recorded on bench 2\n"
+               "\n"
+               "label,ch0\n"
+               "3,250\n");
+
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_open(&s_trace, s_path));
+    TEST_ASSERT_EQUAL_UINT8(1U, s_trace.channels);
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_next(&s_trace, &r));
+    TEST_ASSERT_EQUAL_UINT16(3U, r.label);
+    TEST_ASSERT_EQUAL_UINT16(250U, r.values[0]);
+    TEST_ASSERT_EQUAL_UINT32(4U, s_trace.line);
+    TEST_ASSERT_EQUAL(GW_TRACE_END, gw_trace_next(&s_trace, &r));
+
+    /* Only the first non-comment line may be a header */
+    gw_trace_close(&s_trace);
+    write_text("# two headers\nlabel,ch0\nlabel,ch0\n3,250\n");
+    TEST_ASSERT_EQUAL(GW_TRACE_ERROR_FORMAT, gw_trace_open(&s_trace, s_path));
+}
+
+void test_csv_malformed_lines(void)
+{
+    static const char* const bad[] = {
+        "0,1,2\n1,3\n",             /* Channel count changes */
+        "0,1,2\n1,3,x\n",           /* Not a number */
+        "0,1,2\n1,3,65536\n",       /* Out of range */
+        "0,1,2\n1,3,,4\n",          /* Empty field */
+        "0,1,2\n1,3,4,\n",          /* Trailing comma */
+        "0,1,2\nlabel,a,b\n"        /* Header after line 1 */
+    };
+    gw_trace_record_t r;
+
+    for (uint8_t i = 0U; i < (sizeof(bad) / sizeof(bad[0])); i++) {
+        write_text(bad[i]);
+        TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_open(&s_trace, s_path));
+        TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_next(&s_trace, &r));
+        TEST_ASSERT_EQUAL(GW_TRACE_ERROR_FORMAT, gw_trace_next(&s_trace, &r));
+        TEST_ASSERT_EQUAL_UINT32(2U, s_trace.line);
+        gw_trace_close(&s_trace);
+    }
+}
+
+void test_csv_open_rejects(void)
+{
+    write_text("");
+    TEST_ASSERT_EQUAL(GW_TRACE_ERROR_FORMAT, gw_trace_open(&s_trace, s_path));
+    write_text("label,a,b\n# nothing else\n");
+    TEST_ASSERT_EQUAL(GW_TRACE_ERROR_FORMAT, gw_trace_open(&s_trace, s_path));
+    write_text("3\n");          /* Label but no channels */
+    TEST_ASSERT_EQUAL(GW_TRACE_ERROR_FORMAT, gw_trace_open(&s_trace, s_path));
+    write_text("0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17\n");   /* 17 channels */
+    TEST_ASSERT_EQUAL(GW_TRACE_ERROR_FORMAT, gw_trace_open(&s_trace, s_path));
+    TEST_ASSERT_NULL(s_trace.map);
+
+    (void)unlink(s_path);
+    TEST_ASSERT_EQUAL(GW_TRACE_ERROR_IO, gw_trace_open(&s_trace, s_path));
+}
+
+/* ============================================================================
+ * Binary Tests
+ * ============================================================================ */
+
+void test_binary_round_trip_matches_csv(void)
+{
+    static const uint16_t labels[3] = {2U, 0U, 1U};
+    static const uint16_t values[9] = {1U, 2U, 3U, 1000U, 0U, 513U, 7U, 8U, 9U};
+    gw_trace_record_t a, b;
+    gw_trace_t csv;
+    char csv_path[64];
+
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_write(s_path, labels, values, 3U, 3U));
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_open(&s_trace, s_path));
+    TEST_ASSERT_EQUAL(GW_TRACE_BINARY, s_trace.kind);
+    TEST_ASSERT_EQUAL_UINT8(3U, s_trace.channels);
+    TEST_ASSERT_EQUAL_UINT32(3U, s_trace.count);
+
+    strcpy(csv_path, "/tmp/gw_trace_csv_XXXXXX");
+    int fd = mkstemp(csv_path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    const char* text = "2,1,2,3\n0,1000,0,513\n1,7,8,9\n";
+    TEST_ASSERT_EQUAL((ssize_t)strlen(text), write(fd, text, strlen(text)));
+    (void)close(fd);
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_open(&csv, csv_path));
+
+    for (uint8_t i = 0U; i < 3U; i++) {
+        TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_next(&s_trace, &a));
+        TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_next(&csv, &b));
+        TEST_ASSERT_EQUAL_UINT16(labels[i], a.label);
+        TEST_ASSERT_EQUAL_UINT16(b.label, a.label);
+        TEST_ASSERT_EQUAL_UINT16_ARRAY(&values[i * 3U], a.values, 3U);
+        TEST_ASSERT_EQUAL_UINT16_ARRAY(b.values, a.values, 3U);
+    }
+    TEST_ASSERT_EQUAL(GW_TRACE_END, gw_trace_next(&s_trace, &a));
+    TEST_ASSERT_EQUAL(GW_TRACE_END, gw_trace_next(&csv, &b));
+    TEST_ASSERT_EQUAL_UINT32(3U, s_trace.index);
+    TEST_ASSERT_EQUAL_UINT32(csv.index, s_trace.index);
+    TEST_ASSERT_EQUAL(GW_TRACE_HEADER_BYTES + (3U * 8U), s_trace.pos);
+
+    gw_trace_close(&csv);
+    (void)unlink(csv_path);
+}
+
+void test_binary_header_checks(void)
+{
+    static const uint16_t labels[4] = {0U, 1U, 0U, 1U};
+    static const uint16_t values[8] = {0U};
+
+    TEST_ASSERT_EQUAL(GW_TRACE_ERROR_INVALID, gw_trace_write(s_path, labels, values, 4U, 0U));
+    TEST_ASSERT_EQUAL(GW_TRACE_ERROR_INVALID,
+                      gw_trace_write(s_path, labels, values, 4U, GW_TRACE_MAX_CHANNELS + 1U));
+
+    /* Record count larger than the file */
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_write(s_path, labels, values, 4U, 2U));
+    TEST_ASSERT_EQUAL(0, truncate(s_path, (off_t)(GW_TRACE_HEADER_BYTES + (3U * 6U))));
+    TEST_ASSERT_EQUAL(GW_TRACE_ERROR_FORMAT, gw_trace_open(&s_trace, s_path));
+
+    /* Unknown version */
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_write(s_path, labels, values, 4U, 2U));
+    FILE* f = fopen(s_path, "r+b");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(0, fseek(f, 4L, SEEK_SET));
+    TEST_ASSERT_EQUAL(9, fputc(9, f));
+    TEST_ASSERT_EQUAL(0, fclose(f));
+    TEST_ASSERT_EQUAL(GW_TRACE_ERROR_FORMAT, gw_trace_open(&s_trace, s_path));
+
+    /* Empty but valid */
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_write(s_path, NULL, NULL, 0U, 2U));
+    TEST_ASSERT_EQUAL(GW_TRACE_OK, gw_trace_open(&s_trace, s_path));
+    gw_trace_record_t r;
+    TEST_ASSERT_EQUAL(GW_TRACE_END, gw_trace_next(&s_trace, &r));
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* CSV tests */
+    RUN_TEST(test_csv_records);
+    RUN_TEST(test_csv_header_after_comments);
+    RUN_TEST(test_csv_malformed_lines);
+    RUN_TEST(test_csv_open_rejects);
+
+    /* Binary tests */
+    RUN_TEST(test_binary_round_trip_matches_csv);
+    RUN_TEST(test_binary_header_checks);
+
+    return UNITY_END();
+}
@@ -0,0 +1,208 @@
+/**
+ * @file    test_hal_frame.c
+ * @brief   Unit Tests for the Double-Buffered Frame Exchange
+ * @version 1.0.0
+ *
+ * @details Tests for the frame buffer used by the ADC scan sequencer:
+ *          - Basics: empty, publish/acquire round trip, no repeat delivery
+ *          - Ownership: the held frame is never refilled, an unread frame
+ *            is withdrawn before reuse
+ *          - Accounting: dropped frames, sequence wrap past 0, full frame
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ *          hal_frame.h is portable; the producer side stands in for ADC_vect.
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "hal/hal_frame.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+static hal_frame_buffer_t s_buf;
+
+void setUp(void)
+{
+    hal_frame_init(&s_buf);
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/** @brief Producer: one frame of count values base, base + 1, ... */
+static void produce(uint32_t stamp, uint16_t base, uint8_t count)
+{
+    hal_frame_t* frame = hal_frame_begin(&s_buf, stamp);
+    for (uint8_t i = 0U; i < count; i++) {
+        TEST_ASSERT_TRUE(hal_frame_put(frame, (uint16_t)(base + i)));
+    }
+    hal_frame_publish(&s_buf);
+}
+
+/* ============================================================================
+ * Basic Tests
+ * ============================================================================ */
+
+void test_frame_starts_empty(void)
+{
+    TEST_ASSERT_NULL(hal_frame_acquire(&s_buf));
+    TEST_ASSERT_EQUAL_UINT16(0U, hal_frame_dropped(&s_buf));
+}
+
+void test_frame_round_trip(void)
+{
+    produce(1234U, 100U, 3U);
+
+    const hal_frame_t* frame = hal_frame_acquire(&s_buf);
+    TEST_ASSERT_NOT_NULL(frame);
+    TEST_ASSERT_EQUAL_UINT32(1234U, frame->stamp);
+    TEST_ASSERT_EQUAL_UINT8(3U, frame->count);
+    TEST_ASSERT_EQUAL_UINT16(100U, frame->values[0]);
+    TEST_ASSERT_EQUAL_UINT16(102U, frame->values[2]);
+    TEST_ASSERT_EQUAL_UINT8(1U, frame->sequence);
+    hal_frame_release(&s_buf);
+
+    /* Delivered once */
+    TEST_ASSERT_NULL(hal_frame_acquire(&s_buf));
+}
+
+/* ============================================================================
+ * Ownership Tests
+ * ============================================================================ */
+
+void test_frame_held_is_never_refilled(void)
+{
+    produce(10U, 0U, 2U);
+    const hal_frame_t* held = hal_frame_acquire(&s_buf);
+    TEST_ASSERT_NOT_NULL(held);
+
+    for (uint16_t i = 1U; i <= 5U; i++) {
+        produce(10U + i, (uint16_t)(i * 100U), 2U);
+        TEST_ASSERT_EQUAL_UINT32(10U, held->stamp);
+        TEST_ASSERT_EQUAL_UINT16(0U, held->values[0]);
+        TEST_ASSERT_EQUAL_UINT16(1U, held->values[1]);
+    }
+    hal_frame_release(&s_buf);
+
+    const hal_frame_t* newest = hal_frame_acquire(&s_buf);
+    TEST_ASSERT_NOT_NULL(newest);
+    TEST_ASSERT_TRUE(newest != held);
+    TEST_ASSERT_EQUAL_UINT32(15U, newest->stamp);
+    TEST_ASSERT_EQUAL_UINT16(500U, newest->values[0]);
+}
+
+void test_frame_unread_is_withdrawn_before_reuse(void)
+{
+    produce(1U, 0U, 1U);
+    TEST_ASSERT_NOT_NULL(hal_frame_acquire(&s_buf));
+
+    /* The only free frame is published, then refilled: no longer offered */
+    produce(2U, 20U, 1U);
+    hal_frame_t* partial = hal_frame_begin(&s_buf, 3U);
+    (void)hal_frame_put(partial, 30U);
+    hal_frame_release(&s_buf);
+    TEST_ASSERT_NULL(hal_frame_acquire(&s_buf));
+
+    hal_frame_publish(&s_buf);
+    const hal_frame_t* frame = hal_frame_acquire(&s_buf);
+    TEST_ASSERT_NOT_NULL(frame);
+    TEST_ASSERT_EQUAL_UINT32(3U, frame->stamp);
+    TEST_ASSERT_EQUAL_UINT16(30U, frame->values[0]);
+}
+
+void test_frame_acquire_releases_previous(void)
+{
+    produce(1U, 0U, 1U);
+    const hal_frame_t* first = hal_frame_acquire(&s_buf);
+    produce(2U, 0U, 1U);
+
+    /* No release in between: the next acquire hands first back */
+    const hal_frame_t* second = hal_frame_acquire(&s_buf);
+    TEST_ASSERT_NOT_NULL(second);
+    TEST_ASSERT_TRUE(second != first);
+    produce(3U, 0U, 1U);
+    TEST_ASSERT_EQUAL_UINT32(2U, second->stamp);
+}
+
+/* ============================================================================
+ * Accounting Tests
+ * ============================================================================ */
+
+void test_frame_counts_dropped(void)
+{
+    produce(1U, 0U, 1U);
+    produce(2U, 0U, 1U);
+    produce(3U, 0U, 1U);
+
+    const hal_frame_t* frame = hal_frame_acquire(&s_buf);
+    TEST_ASSERT_EQUAL_UINT32(3U, frame->stamp);
+    TEST_ASSERT_EQUAL_UINT16(2U, hal_frame_dropped(&s_buf));
+    hal_frame_release(&s_buf);
+
+    produce(4U, 0U, 1U);
+    TEST_ASSERT_NOT_NULL(hal_frame_acquire(&s_buf));
+    TEST_ASSERT_EQUAL_UINT16(2U, hal_frame_dropped(&s_buf));
+}
+
+void test_frame_sequence_wraps_past_zero(void)
+{
+    uint8_t last = 0U;
+
+    for (uint16_t i = 0U; i < 600U; i++) {
+        produce(i, 0U, 1U);
+        if ((i % 3U) == 2U) {
+            const hal_frame_t* frame = hal_frame_acquire(&s_buf);
+            TEST_ASSERT_NOT_NULL(frame);
+            TEST_ASSERT_NOT_EQUAL(0U, frame->sequence);
+            TEST_ASSERT_NOT_EQUAL(last, frame->sequence);
+            TEST_ASSERT_EQUAL_UINT32(i, frame->stamp);
+            last = frame->sequence;
+            hal_frame_release(&s_buf);
+        }
+    }
+    /* Two of every three frames were replaced unread */
+    TEST_ASSERT_EQUAL_UINT16(400U, hal_frame_dropped(&s_buf));
+}
+
+void test_frame_put_rejects_when_full(void)
+{
+    hal_frame_t* frame = hal_frame_begin(&s_buf, 0U);
+
+    for (uint8_t i = 0U; i < HAL_FRAME_MAX_VALUES; i++) {
+        TEST_ASSERT_TRUE(hal_frame_put(frame, i));
+    }
+    TEST_ASSERT_FALSE(hal_frame_put(frame, 99U));
+    TEST_ASSERT_EQUAL_UINT8(HAL_FRAME_MAX_VALUES, frame->count);
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Basic tests */
+    RUN_TEST(test_frame_starts_empty);
+    RUN_TEST(test_frame_round_trip);
+
+    /* Ownership tests */
+    RUN_TEST(test_frame_held_is_never_refilled);
+    RUN_TEST(test_frame_unread_is_withdrawn_before_reuse);
+    RUN_TEST(test_frame_acquire_releases_previous);
+
+    /* Accounting tests */
+    RUN_TEST(test_frame_counts_dropped);
+    RUN_TEST(test_frame_sequence_wraps_past_zero);
+    RUN_TEST(test_frame_put_rejects_when_full);
+
+    return UNITY_END();
+}
@@ -0,0 +1,178 @@
+/**
+ * @file    test_hal_ring.c
+ * @brief   Unit Tests for the SPSC Ring Buffer
+ * @version 1.0.0
+ *
+ * @details Tests for the lock-free rings used by the ADC and UART ISRs:
+ *          - Basics: empty, FIFO order, count
+ *          - Limits: full ring rejects, pop from empty fails
+ *          - Wrap: free-running 8-bit indices across the 256 boundary
+ *          - Byte ring: free space and wrap (UART TX path)
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ *          hal_ring.h is portable; no other HAL header is needed.
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "hal/hal_ring.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TEST_RING_SIZE  8U
+
+static volatile uint16_t s_storage[TEST_RING_SIZE];
+static hal_ring16_t s_ring;
+
+static volatile uint8_t s_bytes[TEST_RING_SIZE];
+static hal_ring8_t s_byte_ring;
+
+void setUp(void)
+{
+    hal_ring16_init(&s_ring, s_storage, TEST_RING_SIZE);
+    hal_ring8_init(&s_byte_ring, s_bytes, TEST_RING_SIZE);
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/* ============================================================================
+ * Basic Tests
+ * ============================================================================ */
+
+void test_ring_starts_empty(void)
+{
+    uint16_t value = 0xBEEFU;
+
+    TEST_ASSERT_EQUAL_UINT8(0U, hal_ring16_count(&s_ring));
+    TEST_ASSERT_FALSE(hal_ring16_pop(&s_ring, &value));
+    TEST_ASSERT_EQUAL_HEX16(0xBEEFU, value);
+}
+
+void test_ring_is_fifo(void)
+{
+    uint16_t value = 0U;
+
+    TEST_ASSERT_TRUE(hal_ring16_push(&s_ring, 0x1001U));
+    TEST_ASSERT_TRUE(hal_ring16_push(&s_ring, 0x2002U));
+    TEST_ASSERT_TRUE(hal_ring16_push(&s_ring, 0x3003U));
+    TEST_ASSERT_EQUAL_UINT8(3U, hal_ring16_count(&s_ring));
+
+    TEST_ASSERT_TRUE(hal_ring16_pop(&s_ring, &value));
+    TEST_ASSERT_EQUAL_HEX16(0x1001U, value);
+    TEST_ASSERT_TRUE(hal_ring16_pop(&s_ring, &value));
+    TEST_ASSERT_EQUAL_HEX16(0x2002U, value);
+    TEST_ASSERT_EQUAL_UINT8(1U, hal_ring16_count(&s_ring));
+}
+
+/* ============================================================================
+ * Limit Tests
+ * ============================================================================ */
+
+void test_ring_full_rejects_push(void)
+{
+    uint16_t value = 0U;
+
+    for (uint16_t i = 0U; i < TEST_RING_SIZE; i++) {
+        TEST_ASSERT_TRUE(hal_ring16_push(&s_ring, i));
+    }
+    TEST_ASSERT_EQUAL_UINT8(TEST_RING_SIZE, hal_ring16_count(&s_ring));
+    TEST_ASSERT_FALSE(hal_ring16_push(&s_ring, 0xFFFFU));
+
+    /* The rejected entry did not overwrite the oldest one */
+    TEST_ASSERT_TRUE(hal_ring16_pop(&s_ring, &value));
+    TEST_ASSERT_EQUAL_HEX16(0U, value);
+    TEST_ASSERT_TRUE(hal_ring16_push(&s_ring, 0xAAAAU));
+}
+
+/* ============================================================================
+ * Wrap Tests
+ * ============================================================================ */
+
+void test_ring_wraps_index_boundary(void)
+{
+    uint16_t expected = 0U;
+    uint16_t produced = 0U;
+    uint16_t value = 0U;
+
+    /* 1000 entries push the free-running indices past 255 several times,
+     * with the fill level varying between 0 and 5 */
+    while (expected < 1000U) {
+        uint8_t burst = (uint8_t)((produced % 5U) + 1U);
+        for (uint8_t i = 0U; i < burst; i++) {
+            TEST_ASSERT_TRUE(hal_ring16_push(&s_ring, produced));
+            produced++;
+        }
+        while (hal_ring16_pop(&s_ring, &value)) {
+            TEST_ASSERT_EQUAL_UINT16(expected, value);
+            expected++;
+        }
+        TEST_ASSERT_EQUAL_UINT8(0U, hal_ring16_count(&s_ring));
+    }
+}
+
+/* ============================================================================
+ * Byte Ring Tests
+ * ============================================================================ */
+
+void test_ring8_free_tracks_fill(void)
+{
+    uint8_t value = 0U;
+
+    TEST_ASSERT_EQUAL_UINT8(TEST_RING_SIZE, hal_ring8_free(&s_byte_ring));
+    for (uint8_t i = 0U; i < TEST_RING_SIZE; i++) {
+        TEST_ASSERT_TRUE(hal_ring8_push(&s_byte_ring, (uint8_t)('a' + i)));
+    }
+    TEST_ASSERT_EQUAL_UINT8(0U, hal_ring8_free(&s_byte_ring));
+    TEST_ASSERT_FALSE(hal_ring8_push(&s_byte_ring, 'z'));
+
+    TEST_ASSERT_TRUE(hal_ring8_pop(&s_byte_ring, &value));
+    TEST_ASSERT_EQUAL_UINT8('a', value);
+    TEST_ASSERT_EQUAL_UINT8(1U, hal_ring8_free(&s_byte_ring));
+}
+
+void test_ring8_wraps_index_boundary(void)
+{
+    uint8_t value = 0U;
+
+    for (uint16_t i = 0U; i < 700U; i++) {
+        TEST_ASSERT_TRUE(hal_ring8_push(&s_byte_ring, (uint8_t)i));
+        TEST_ASSERT_TRUE(hal_ring8_push(&s_byte_ring, (uint8_t)(i ^ 0x5AU)));
+        TEST_ASSERT_TRUE(hal_ring8_pop(&s_byte_ring, &value));
+        TEST_ASSERT_EQUAL_UINT8((uint8_t)i, value);
+        TEST_ASSERT_TRUE(hal_ring8_pop(&s_byte_ring, &value));
+        TEST_ASSERT_EQUAL_UINT8((uint8_t)(i ^ 0x5AU), value);
+    }
+    TEST_ASSERT_EQUAL_UINT8(0U, hal_ring8_count(&s_byte_ring));
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Basic tests */
+    RUN_TEST(test_ring_starts_empty);
+    RUN_TEST(test_ring_is_fifo);
+
+    /* Limit tests */
+    RUN_TEST(test_ring_full_rejects_push);
+
+    /* Wrap tests */
+    RUN_TEST(test_ring_wraps_index_boundary);
+
+    /* Byte ring tests */
+    RUN_TEST(test_ring8_free_tracks_fill);
+    RUN_TEST(test_ring8_wraps_index_boundary);
+
+    return UNITY_END();
+}
@@ -7,6 +7,12 @@
  *          - Core: XOR, OR, AND, bundle, popcount, permute
  *          - Distance: hamming, similarity
  *          - Encoding: thermometer, ADC, bipolar, multi-channel
+ *          - Levels: compact thermometer form, level distance, bind, bundle
+ *          - Specialized encoders: reciprocal levels for every value and
+ *            fixed channel counts against the generic encoders
+ *          - Kernels: every byte value and every range length against a
+ *            bit-at-a-time reference (run per backend: native, native_byte,
+ *            native_avr, native_word32, native_avx2)
  *
  * @note    Uses Unity test framework. Run with: pio test -e native
  *          For coverage: pio test -e coverage
@@ -21,6 +27,15 @@
 /* Include the HDC headers (they're portable - no AVR dependencies) */
 #include "hdc/hdc_core.h"
 #include "hdc/hdc_encode.h"
+#include "hdc/hdc_kernel.h"
+#include "hdc/hdc_encode_fixed.h"
+#include "mock_hv.h"
+
+/**
+ * @brief Scale a threshold written for 128-bit vectors to HV_DIMENSIONS
+ * @note  Tests run unchanged under any -DHV_DIMENSIONS build
+ */
+#define SCALE_128(bits)     ((hdc_dist_t)(((uint32_t)(bits) * HV_DIMENSIONS) / 128U))
 
 /* ============================================================================
  * Test Setup and Teardown
@@ -69,14 +84,105 @@ void test_popcount_full_hypervector_zeros(void)
 {
     hv_t hv;
     hdc_clear(hv);
-    TEST_ASSERT_EQUAL_UINT8(0U, hdc_popcount(hv));
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_popcount(hv));
 }
 
 void test_popcount_full_hypervector_ones(void)
 {
     hv_t hv;
     hdc_fill(hv, 0xFFU);
-    TEST_ASSERT_EQUAL_UINT8(128U, hdc_popcount(hv));
+    TEST_ASSERT_EQUAL_UINT16(HV_DIMENSIONS, hdc_popcount(hv));
+}
+
+void test_popcount8_matches_bit_reference(void)
+{
+    for (uint16_t v = 0U; v < 256U; v++) {
+        uint8_t expected = 0U;
+        for (uint8_t bit = 0U; bit < 8U; bit++) {
+            expected = (uint8_t)(expected + ((v >> bit) & 1U));
+        }
+        TEST_ASSERT_EQUAL_UINT8(expected, hdc_popcount8((uint8_t)v));
+    }
+}
+
+/* ============================================================================
+ * Kernel Range Tests
+ *
+ * The backends split a range into unrolled, word and byte steps (4-byte
+ * assembly steps for HDC_KERNEL_AVR), so every length 0..HV_BYTES is run to
+ * reach each split, with unaligned starts.
+ * ============================================================================ */
+
+/** @brief Fill with a non-periodic pattern */
+static void fill_pattern(uint8_t* p, uint16_t n, uint32_t seed)
+{
+    for (uint16_t i = 0U; i < n; i++) {
+        seed = (seed * 1103515245UL) + 12345UL;
+        p[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+static hdc_dist_t reference_hamming_n(const uint8_t* a, const uint8_t* b, uint16_t n)
+{
+    hdc_dist_t d = 0U;
+    for (uint16_t i = 0U; i < n; i++) {
+        for (uint8_t bit = 0U; bit < 8U; bit++) {
+            d = (hdc_dist_t)(d + (((a[i] ^ b[i]) >> bit) & 1U));
+        }
+    }
+    return d;
+}
+
+void test_kernel_hamming_every_length(void)
+{
+    static uint8_t a[HV_BYTES + 1U], b[HV_BYTES + 1U];
+
+    fill_pattern(a, HV_BYTES + 1U, 7U);
+    fill_pattern(b, HV_BYTES + 1U, 8U);
+    for (uint16_t n = 0U; n <= HV_BYTES; n++) {
+        TEST_ASSERT_EQUAL_UINT16(reference_hamming_n(a, b, n), hdc_kernel_hamming(a, b, (hdc_index_t)n));
+    }
+    for (uint16_t n = 0U; n < HV_BYTES; n++) {
+        TEST_ASSERT_EQUAL_UINT16(reference_hamming_n(&a[1], b, n),
+                                 hdc_kernel_hamming(&a[1], b, (hdc_index_t)n));
+    }
+}
+
+void test_kernel_xor_every_length(void)
+{
+    static uint8_t a[HV_BYTES + 1U], b[HV_BYTES + 1U];
+    static uint8_t result[HV_BYTES + 2U], expected[HV_BYTES + 2U];
+
+    fill_pattern(a, HV_BYTES + 1U, 9U);
+    fill_pattern(b, HV_BYTES + 1U, 10U);
+    for (uint16_t n = 0U; n <= HV_BYTES; n++) {
+        /* The byte after the range is a guard */
+        memset(result, 0x5AU, sizeof(result));
+        memset(expected, 0x5AU, sizeof(expected));
+        for (uint16_t i = 0U; i < n; i++) {
+            expected[i + 1U] = (uint8_t)(a[i] ^ b[i]);
+        }
+        hdc_kernel_xor(&result[1], a, b, (hdc_index_t)n);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, result, sizeof(result));
+    }
+}
+
+void test_kernel_xor_in_place(void)
+{
+    hv_t a, b, expected;
+
+    fill_pattern(a, HV_BYTES, 11U);
+    fill_pattern(b, HV_BYTES, 12U);
+    for (uint16_t i = 0U; i < HV_BYTES; i++) {
+        expected[i] = (uint8_t)(a[i] ^ b[i]);
+    }
+
+    hdc_xor(a, a, b);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, a, HV_BYTES);
+    hdc_xor(b, expected, b);
+    fill_pattern(a, HV_BYTES, 11U);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(a, b, HV_BYTES);
+    TEST_ASSERT_EQUAL_UINT16(reference_hamming_n(a, expected, HV_BYTES), hdc_hamming(a, expected));
 }
 
 /* ============================================================================
@@ -92,7 +198,7 @@ void test_xor_identical_vectors_gives_zero(void)
     hdc_xor(result, a, b);
 
     /* XOR of identical vectors = all zeros */
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(0x00U, result[i]);
     }
 }
@@ -106,7 +212,7 @@ void test_xor_with_zero_gives_same(void)
     hdc_xor(result, a, zero);
 
     /* XOR with zero = same vector */
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(0xABU, result[i]);
     }
 }
@@ -120,7 +226,7 @@ void test_xor_with_ones_inverts(void)
     hdc_xor(result, a, ones);
 
     /* XOR with all-ones = inverted */
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(0x55U, result[i]);  /* 01010101 */
     }
 }
@@ -137,7 +243,7 @@ void test_or_with_zero_gives_same(void)
 
     hdc_or(result, a, zero);
 
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(0xABU, result[i]);
     }
 }
@@ -150,7 +256,7 @@ void test_or_combines_bits(void)
 
     hdc_or(result, a, b);
 
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(0xFFU, result[i]);  /* 11111111 */
     }
 }
@@ -171,7 +277,7 @@ void test_and_with_zero_gives_zero(void)
 
     hdc_and(result, a, zero);
 
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(0x00U, result[i]);
     }
 }
@@ -188,7 +294,7 @@ void test_and_with_ones_gives_same(void)
 
     hdc_and(result, a, ones);
 
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(0xABU, result[i]);
     }
 }
@@ -206,7 +312,7 @@ void test_and_masks_bits(void)
     hdc_and(result, a, b);
 
     /* No common bits = all zeros */
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(0x00U, result[i]);
     }
 }
@@ -224,7 +330,7 @@ void test_and_is_commutative(void)
     hdc_and(result1, a, b);
     hdc_and(result2, b, a);
 
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(result1[i], result2[i]);
     }
 }
@@ -242,7 +348,7 @@ void test_and_extracts_common_bits(void)
     hdc_and(result, a, b);
 
     /* Common bits: 10001000 = 0x88 */
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(0x88U, result[i]);
     }
 }
@@ -262,7 +368,7 @@ void test_bundle_accumulates(void)
     hdc_bundle(memory, pattern2);
 
     /* Memory should have both patterns */
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(0xFFU, memory[i]);
     }
 }
@@ -277,7 +383,7 @@ void test_hamming_identical_is_zero(void)
     hdc_fill(a, 0xAAU);
     hdc_fill(b, 0xAAU);
 
-    TEST_ASSERT_EQUAL_UINT8(0U, hdc_hamming(a, b));
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_hamming(a, b));
 }
 
 void test_hamming_opposite_is_max(void)
@@ -286,7 +392,7 @@ void test_hamming_opposite_is_max(void)
     hdc_clear(a);
     hdc_fill(b, 0xFFU);
 
-    TEST_ASSERT_EQUAL_UINT8(128U, hdc_hamming(a, b));
+    TEST_ASSERT_EQUAL_UINT16(HV_DIMENSIONS, hdc_hamming(a, b));
 }
 
 void test_hamming_half_different(void)
@@ -295,8 +401,8 @@ void test_hamming_half_different(void)
     hdc_fill(a, 0xF0U);  /* 11110000 - 4 bits per byte */
     hdc_fill(b, 0x0FU);  /* 00001111 - 4 bits per byte, all different */
 
-    /* Each byte differs in 8 bits, 16 bytes = 128 */
-    TEST_ASSERT_EQUAL_UINT8(128U, hdc_hamming(a, b));
+    /* Each byte differs in 8 bits, HV_BYTES bytes = HV_DIMENSIONS */
+    TEST_ASSERT_EQUAL_UINT16(HV_DIMENSIONS, hdc_hamming(a, b));
 }
 
 void test_hamming_single_byte_different(void)
@@ -306,7 +412,30 @@ void test_hamming_single_byte_different(void)
     hdc_clear(b);
     b[0] = 0xFFU;  /* Only first byte different */
 
-    TEST_ASSERT_EQUAL_UINT8(8U, hdc_hamming(a, b));
+    TEST_ASSERT_EQUAL_UINT16(8U, hdc_hamming(a, b));
+}
+
+void test_hamming_bounded_exact_within_bound(void)
+{
+    hv_t a, b;
+    hdc_fill(a, 0xF0U);
+    hdc_fill(b, 0x0FU);
+
+    /* Bound at or above the distance returns the exact distance */
+    TEST_ASSERT_EQUAL_UINT16(HV_DIMENSIONS, hdc_hamming_bounded(a, b, (hdc_dist_t)HV_DIMENSIONS));
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_hamming_bounded(a, a, 0U));
+}
+
+void test_hamming_bounded_exceeds_bound_when_far(void)
+{
+    hv_t a, b;
+    hdc_clear(a);
+    hdc_fill(b, 0xFFU);
+
+    /* Any value above the bound may be returned, never one at or below it */
+    TEST_ASSERT_TRUE(hdc_hamming_bounded(a, b, 3U) > 3U);
+    TEST_ASSERT_TRUE(hdc_hamming_bounded(a, b, (hdc_dist_t)(HV_DIMENSIONS - 1U)) >
+                     (hdc_dist_t)(HV_DIMENSIONS - 1U));
 }
 
 /* ============================================================================
@@ -319,7 +448,7 @@ void test_similarity_identical_is_max(void)
     hdc_fill(a, 0xABU);
     hdc_fill(b, 0xABU);
 
-    TEST_ASSERT_EQUAL_UINT8(128U, hdc_similarity(a, b));
+    TEST_ASSERT_EQUAL_UINT16(HV_DIMENSIONS, hdc_similarity(a, b));
 }
 
 void test_similarity_opposite_is_zero(void)
@@ -328,7 +457,7 @@ void test_similarity_opposite_is_zero(void)
     hdc_clear(a);
     hdc_fill(b, 0xFFU);
 
-    TEST_ASSERT_EQUAL_UINT8(0U, hdc_similarity(a, b));
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_similarity(a, b));
 }
 
 /* ============================================================================
@@ -344,14 +473,14 @@ void test_permute_zero_gives_same(void)
     hv_t hv, original;
 
     /* Create a pattern */
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         hv[i] = i;
         original[i] = i;
     }
 
     hdc_permute(hv, 0U);
 
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(original[i], hv[i]);
     }
 }
@@ -374,21 +503,21 @@ void test_permute_by_8_shifts_one_byte(void)
 }
 
 /**
- * @brief Test permute by 128 wraps around to same
+ * @brief Test permute by HV_DIMENSIONS wraps around to same
  * @details Full rotation should return to original
  */
 void test_permute_full_rotation_gives_same(void)
 {
     hv_t hv, original;
 
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
-        hv[i] = i * 17U;  /* Arbitrary pattern */
-        original[i] = i * 17U;
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        hv[i] = (uint8_t)(i * 17U);  /* Arbitrary pattern */
+        original[i] = (uint8_t)(i * 17U);
     }
 
-    hdc_permute(hv, 128U);  /* Full rotation */
+    hdc_permute(hv, HV_DIMENSIONS);  /* Full rotation */
 
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(original[i], hv[i]);
     }
 }
@@ -399,7 +528,7 @@ void test_permute_full_rotation_gives_same(void)
  *
  * RATIONALE: In HDC, permutation is used for position encoding.
  * For this to work, permuted vectors must be quasi-orthogonal
- * (approximately 50% bit overlap = similarity ~64 for 128-bit vectors).
+ * (approximately 50% bit overlap = similarity ~HV_DIMENSIONS/2).
  *
  * IMPORTANT: Using a periodic pattern like 0xAA fails because rotation
  * of a periodic pattern creates anti-correlation (similarity = 0).
@@ -414,10 +543,15 @@ void test_permute_creates_orthogonal_vectors(void)
      * This simulates realistic random hypervectors used in HDC
      * Pattern has ~50% bit density (good for similarity testing)
      */
-    original[0]  = 0x12U; original[1]  = 0x34U; original[2]  = 0x56U; original[3]  = 0x78U;
-    original[4]  = 0x9AU; original[5]  = 0xBCU; original[6]  = 0xDEU; original[7]  = 0xF0U;
-    original[8]  = 0x21U; original[9]  = 0x43U; original[10] = 0x65U; original[11] = 0x87U;
-    original[12] = 0xA9U; original[13] = 0xCBU; original[14] = 0xEDU; original[15] = 0x0FU;
+    static const uint8_t pattern[16] = {
+        0x12U, 0x34U, 0x56U, 0x78U, 0x9AU, 0xBCU, 0xDEU, 0xF0U,
+        0x21U, 0x43U, 0x65U, 0x87U, 0xA9U, 0xCBU, 0xEDU, 0x0FU
+    };
+
+    /* Wider vectors repeat the pattern, perturbed per 16-byte block */
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        original[i] = pattern[i % 16U] ^ (uint8_t)((i / 16U) * 0x3BU);
+    }
 
     hdc_copy(permuted, original);
     hdc_permute(permuted, 37U);  /* Odd shift for good scrambling */
@@ -427,19 +561,19 @@ void test_permute_creates_orthogonal_vectors(void)
      * Expected similarity: approximately 64 ± 32 (25%-75% overlap)
      * We use wider bounds to account for pattern-dependent variance
      */
-    uint8_t hamming = hdc_hamming(original, permuted);
-    uint8_t similarity = hdc_similarity(original, permuted);
+    hdc_dist_t hamming = hdc_hamming(original, permuted);
+    hdc_dist_t similarity = hdc_similarity(original, permuted);
 
     /*
      * Verify vectors are different (non-zero Hamming distance)
      * and neither perfectly correlated nor anti-correlated
      */
-    TEST_ASSERT_NOT_EQUAL_UINT8(0U, hamming);      /* Not identical */
-    TEST_ASSERT_NOT_EQUAL_UINT8(128U, hamming);    /* Not anti-correlated */
+    TEST_ASSERT_NOT_EQUAL_UINT16(0U, hamming);      /* Not identical */
+    TEST_ASSERT_NOT_EQUAL_UINT16(HV_DIMENSIONS, hamming);    /* Not anti-correlated */
 
     /* Similarity should be in orthogonal range (not too similar, not too different) */
-    TEST_ASSERT_GREATER_OR_EQUAL_UINT8(16U, similarity);  /* At least 12.5% overlap */
-    TEST_ASSERT_LESS_OR_EQUAL_UINT8(112U, similarity);    /* At most 87.5% overlap */
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT16(SCALE_128(16U), similarity);  /* At least 12.5% overlap */
+    TEST_ASSERT_LESS_OR_EQUAL_UINT16(SCALE_128(112U), similarity);    /* At most 87.5% overlap */
 }
 
 /**
@@ -467,11 +601,41 @@ void test_permute_preserves_popcount(void)
     hv_t hv;
     hdc_fill(hv, 0xAAU);  /* 64 bits set */
 
-    uint8_t before = hdc_popcount(hv);
+    hdc_dist_t before = hdc_popcount(hv);
     hdc_permute(hv, 47U);
-    uint8_t after = hdc_popcount(hv);
+    hdc_dist_t after = hdc_popcount(hv);
+
+    TEST_ASSERT_EQUAL_UINT16(before, after);
+}
+
+/**
+ * @brief Test permute against a bit-by-bit reference for every shift
+ * @details Covers byte-aligned, sub-byte and mixed shifts, the wrap of the
+ *          carry from the last byte into bit 0, and shifts >= HV_DIMENSIONS
+ */
+void test_permute_matches_bit_reference(void)
+{
+    hv_t original, expected, actual;
+
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        original[i] = (uint8_t)((i * 73U) ^ 0x5CU);
+    }
 
-    TEST_ASSERT_EQUAL_UINT8(before, after);
+    for (uint16_t shifts = 0U; shifts < (2U * HV_DIMENSIONS); shifts = (uint16_t)(shifts + 1U + (shifts / 64U))) {
+        hdc_dist_t shift = (hdc_dist_t)shifts;  /* 8-bit below 256 dimensions */
+
+        hdc_clear(expected);
+        for (uint16_t bit = 0U; bit < HV_DIMENSIONS; bit++) {
+            if ((original[bit / 8U] & (1U << (bit % 8U))) != 0U) {
+                uint16_t dest = (uint16_t)((bit + shift) % HV_DIMENSIONS);
+                expected[dest / 8U] |= (uint8_t)(1U << (dest % 8U));
+            }
+        }
+
+        hdc_copy(actual, original);
+        hdc_permute(actual, shift);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, HV_BYTES);
+    }
 }
 
 /* ============================================================================
@@ -483,7 +647,7 @@ void test_thermo_zero_gives_empty(void)
     hv_t hv;
     hdc_encode_thermometer(hv, 0U, 1024U);
 
-    TEST_ASSERT_EQUAL_UINT8(0U, hdc_popcount(hv));
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_popcount(hv));
 }
 
 void test_thermo_max_gives_full(void)
@@ -491,7 +655,7 @@ void test_thermo_max_gives_full(void)
     hv_t hv;
     hdc_encode_thermometer(hv, 1024U, 1024U);
 
-    TEST_ASSERT_EQUAL_UINT8(128U, hdc_popcount(hv));
+    TEST_ASSERT_EQUAL_UINT16(HV_DIMENSIONS, hdc_popcount(hv));
 }
 
 void test_thermo_half_gives_half(void)
@@ -499,10 +663,10 @@ void test_thermo_half_gives_half(void)
     hv_t hv;
     hdc_encode_thermometer(hv, 512U, 1024U);
 
-    /* Should be approximately 64 bits (half of 128) */
-    uint8_t count = hdc_popcount(hv);
-    TEST_ASSERT_GREATER_OR_EQUAL_UINT8(60U, count);
-    TEST_ASSERT_LESS_OR_EQUAL_UINT8(68U, count);
+    /* Should be approximately half of HV_DIMENSIONS */
+    hdc_dist_t count = hdc_popcount(hv);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT16(SCALE_128(60U), count);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT16(SCALE_128(68U), count);
 }
 
 void test_thermo_preserves_order(void)
@@ -513,13 +677,13 @@ void test_thermo_preserves_order(void)
     hdc_encode_thermometer(hv_mid, 500U, 1024U);
     hdc_encode_thermometer(hv_high, 900U, 1024U);
 
-    uint8_t count_low = hdc_popcount(hv_low);
-    uint8_t count_mid = hdc_popcount(hv_mid);
-    uint8_t count_high = hdc_popcount(hv_high);
+    hdc_dist_t count_low = hdc_popcount(hv_low);
+    hdc_dist_t count_mid = hdc_popcount(hv_mid);
+    hdc_dist_t count_high = hdc_popcount(hv_high);
 
     /* Higher values should have more bits set */
-    TEST_ASSERT_LESS_THAN_UINT8(count_mid, count_low);
-    TEST_ASSERT_LESS_THAN_UINT8(count_high, count_mid);
+    TEST_ASSERT_LESS_THAN_UINT16(count_mid, count_low);
+    TEST_ASSERT_LESS_THAN_UINT16(count_high, count_mid);
 }
 
 void test_thermo_similar_values_are_close(void)
@@ -530,10 +694,10 @@ void test_thermo_similar_values_are_close(void)
     hdc_encode_thermometer(hv_a, 500U, 1024U);
     hdc_encode_thermometer(hv_b, 510U, 1024U);
 
-    uint8_t distance = hdc_hamming(hv_a, hv_b);
+    hdc_dist_t distance = hdc_hamming(hv_a, hv_b);
 
     /* Should be very similar (small distance) */
-    TEST_ASSERT_LESS_THAN_UINT8(10U, distance);
+    TEST_ASSERT_LESS_THAN_UINT16(SCALE_128(10U), distance);
 }
 
 void test_thermo_distant_values_are_far(void)
@@ -544,10 +708,10 @@ void test_thermo_distant_values_are_far(void)
     hdc_encode_thermometer(hv_a, 100U, 1024U);
     hdc_encode_thermometer(hv_b, 900U, 1024U);
 
-    uint8_t distance = hdc_hamming(hv_a, hv_b);
+    hdc_dist_t distance = hdc_hamming(hv_a, hv_b);
 
     /* Should be very different (large distance) */
-    TEST_ASSERT_GREATER_THAN_UINT8(80U, distance);
+    TEST_ASSERT_GREATER_THAN_UINT16(SCALE_128(80U), distance);
 }
 
 /* ============================================================================
@@ -563,7 +727,7 @@ void test_adc_zero_gives_empty(void)
     hv_t hv;
     hdc_encode_adc(hv, 0U);
 
-    TEST_ASSERT_EQUAL_UINT8(0U, hdc_popcount(hv));
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_popcount(hv));
 }
 
 /**
@@ -575,7 +739,7 @@ void test_adc_max_gives_full(void)
     hv_t hv;
     hdc_encode_adc(hv, 1023U);
 
-    TEST_ASSERT_EQUAL_UINT8(128U, hdc_popcount(hv));
+    TEST_ASSERT_EQUAL_UINT16(HV_DIMENSIONS, hdc_popcount(hv));
 }
 
 /**
@@ -587,10 +751,10 @@ void test_adc_mid_gives_half(void)
     hv_t hv;
     hdc_encode_adc(hv, 512U);
 
-    uint8_t count = hdc_popcount(hv);
-    /* Should be approximately 64 bits */
-    TEST_ASSERT_GREATER_OR_EQUAL_UINT8(58U, count);
-    TEST_ASSERT_LESS_OR_EQUAL_UINT8(70U, count);
+    hdc_dist_t count = hdc_popcount(hv);
+    /* Should be approximately half of HV_DIMENSIONS */
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT16(SCALE_128(58U), count);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT16(SCALE_128(70U), count);
 }
 
 /**
@@ -604,8 +768,8 @@ void test_adc_close_values_are_similar(void)
     hdc_encode_adc(hv_a, 500U);
     hdc_encode_adc(hv_b, 510U);
 
-    uint8_t distance = hdc_hamming(hv_a, hv_b);
-    TEST_ASSERT_LESS_THAN_UINT8(10U, distance);
+    hdc_dist_t distance = hdc_hamming(hv_a, hv_b);
+    TEST_ASSERT_LESS_THAN_UINT16(SCALE_128(10U), distance);
 }
 
 /* ============================================================================
@@ -621,7 +785,7 @@ void test_bipolar_min_gives_empty(void)
     hv_t hv;
     hdc_encode_bipolar(hv, -100, -100, 100);
 
-    TEST_ASSERT_EQUAL_UINT8(0U, hdc_popcount(hv));
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_popcount(hv));
 }
 
 /**
@@ -633,7 +797,7 @@ void test_bipolar_max_gives_full(void)
     hv_t hv;
     hdc_encode_bipolar(hv, 100, -100, 100);
 
-    TEST_ASSERT_EQUAL_UINT8(128U, hdc_popcount(hv));
+    TEST_ASSERT_EQUAL_UINT16(HV_DIMENSIONS, hdc_popcount(hv));
 }
 
 /**
@@ -645,10 +809,10 @@ void test_bipolar_zero_gives_half(void)
     hv_t hv;
     hdc_encode_bipolar(hv, 0, -100, 100);
 
-    uint8_t count = hdc_popcount(hv);
-    /* Should be approximately 64 bits */
-    TEST_ASSERT_GREATER_OR_EQUAL_UINT8(58U, count);
-    TEST_ASSERT_LESS_OR_EQUAL_UINT8(70U, count);
+    hdc_dist_t count = hdc_popcount(hv);
+    /* Should be approximately half of HV_DIMENSIONS */
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT16(SCALE_128(58U), count);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT16(SCALE_128(70U), count);
 }
 
 /**
@@ -662,10 +826,10 @@ void test_bipolar_asymmetric_range(void)
     /* Range from -50 to 150, test value at midpoint (50) */
     hdc_encode_bipolar(hv, 50, -50, 150);
 
-    uint8_t count = hdc_popcount(hv);
+    hdc_dist_t count = hdc_popcount(hv);
     /* 50 is exactly halfway between -50 and 150 */
-    TEST_ASSERT_GREATER_OR_EQUAL_UINT8(58U, count);
-    TEST_ASSERT_LESS_OR_EQUAL_UINT8(70U, count);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT16(SCALE_128(58U), count);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT16(SCALE_128(70U), count);
 }
 
 /**
@@ -679,8 +843,8 @@ void test_bipolar_close_values_are_similar(void)
     hdc_encode_bipolar(hv_a, 10, -100, 100);
     hdc_encode_bipolar(hv_b, 15, -100, 100);
 
-    uint8_t distance = hdc_hamming(hv_a, hv_b);
-    TEST_ASSERT_LESS_THAN_UINT8(10U, distance);
+    hdc_dist_t distance = hdc_hamming(hv_a, hv_b);
+    TEST_ASSERT_LESS_THAN_UINT16(SCALE_128(10U), distance);
 }
 
 /* ============================================================================
@@ -703,8 +867,8 @@ void test_multi_channel_single(void)
     hdc_encode_multi_channel(result, values, 1U, basis);
 
     /* Result should have bits set (not empty) */
-    uint8_t count = hdc_popcount(result);
-    TEST_ASSERT_GREATER_THAN_UINT8(0U, count);
+    hdc_dist_t count = hdc_popcount(result);
+    TEST_ASSERT_GREATER_THAN_UINT16(0U, count);
 }
 
 /**
@@ -724,8 +888,8 @@ void test_multi_channel_two_channels(void)
     hdc_encode_multi_channel(result, values, 2U, basis);
 
     /* Result should have bits set */
-    uint8_t count = hdc_popcount(result);
-    TEST_ASSERT_GREATER_THAN_UINT8(0U, count);
+    hdc_dist_t count = hdc_popcount(result);
+    TEST_ASSERT_GREATER_THAN_UINT16(0U, count);
 }
 
 /**
@@ -744,8 +908,8 @@ void test_multi_channel_max_values(void)
     hdc_encode_multi_channel(result, values, 2U, basis);
 
     /* With bundling (OR), max values XORed with basis should be near full */
-    uint8_t count = hdc_popcount(result);
-    TEST_ASSERT_GREATER_THAN_UINT8(64U, count);
+    hdc_dist_t count = hdc_popcount(result);
+    TEST_ASSERT_GREATER_THAN_UINT16(SCALE_128(64U), count);
 }
 
 /**
@@ -765,8 +929,8 @@ void test_multi_channel_zero_values(void)
 
     /* Zero value thermometer gives empty, XOR with basis gives basis */
     /* Bundle of two complementary bases = all ones */
-    uint8_t count = hdc_popcount(result);
-    TEST_ASSERT_EQUAL_UINT8(128U, count);
+    hdc_dist_t count = hdc_popcount(result);
+    TEST_ASSERT_EQUAL_UINT16(HV_DIMENSIONS, count);
 }
 
 /* ============================================================================
@@ -779,7 +943,7 @@ void test_clear_sets_all_zeros(void)
     hdc_fill(hv, 0xFFU);  /* Start with all ones */
     hdc_clear(hv);
 
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(0x00U, hv[i]);
     }
 }
@@ -789,13 +953,13 @@ void test_copy_duplicates_exactly(void)
     hv_t src, dest;
 
     /* Set up source with pattern */
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         src[i] = i;
     }
 
     hdc_copy(dest, src);
 
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(src[i], dest[i]);
     }
 }
@@ -809,11 +973,291 @@ void test_fill_sets_all_bytes(void)
     hdc_clear(hv);
     hdc_fill(hv, 0xABU);
 
-    for (uint8_t i = 0U; i < HV_BYTES; i++) {
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
         TEST_ASSERT_EQUAL_HEX8(0xABU, hv[i]);
     }
 }
 
+/* ============================================================================
+ * Kernel Backend Tests
+ * ============================================================================ */
+
+/**
+ * @brief Bit-at-a-time reference Hamming distance
+ */
+static uint16_t reference_hamming(const hv_t a, const hv_t b)
+{
+    uint16_t distance = 0U;
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        for (uint8_t bit = 0U; bit < 8U; bit++) {
+            distance += (uint16_t)(((a[i] ^ b[i]) >> bit) & 1U);
+        }
+    }
+    return distance;
+}
+
+/**
+ * @brief Test selected backend matches the bitwise reference
+ * @details Run under every kernel env (native, native_byte, native_word32,
+ *          native_avx2) to cross-check all backends against one reference.
+ */
+void test_kernel_hamming_matches_reference(void)
+{
+    hv_t a, b;
+
+    for (uint32_t seed = 1U; seed < 64U; seed++) {
+        fill_pseudo_random(a, seed);
+        fill_pseudo_random(b, seed * 7919U);
+        TEST_ASSERT_EQUAL_UINT16(reference_hamming(a, b), hdc_hamming(a, b));
+    }
+}
+
+/**
+ * @brief Test the bounded distance against the reference for every bound
+ */
+void test_kernel_hamming_bounded_matches_reference(void)
+{
+    hv_t a, b;
+
+    for (uint32_t seed = 1U; seed < 16U; seed++) {
+        fill_pseudo_random(a, seed);
+        fill_pseudo_random(b, seed * 104729U);
+        uint16_t exact = reference_hamming(a, b);
+
+        for (uint16_t bound = 0U; bound <= HV_DIMENSIONS; bound++) {
+            hdc_dist_t d = hdc_hamming_bounded(a, b, (hdc_dist_t)bound);
+            if (exact <= bound) {
+                TEST_ASSERT_EQUAL_UINT16(exact, d);
+            } else {
+                TEST_ASSERT_TRUE(d > bound);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Test popcount agrees with Hamming distance against zero
+ */
+void test_kernel_popcount_matches_reference(void)
+{
+    hv_t a, zero;
+    hdc_clear(zero);
+
+    for (uint32_t seed = 1U; seed < 64U; seed++) {
+        fill_pseudo_random(a, seed);
+        TEST_ASSERT_EQUAL_UINT16(reference_hamming(a, zero), hdc_popcount(a));
+    }
+}
+
+/**
+ * @brief Test bitwise kernels byte-for-byte, including aliased output
+ */
+void test_kernel_bitwise_matches_reference(void)
+{
+    hv_t a, b, r_xor, r_or, r_and, alias;
+
+    fill_pseudo_random(a, 42U);
+    fill_pseudo_random(b, 4242U);
+
+    hdc_xor(r_xor, a, b);
+    hdc_or(r_or, a, b);
+    hdc_and(r_and, a, b);
+    hdc_copy(alias, a);
+    hdc_bundle(alias, b);
+
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        TEST_ASSERT_EQUAL_HEX8(a[i] ^ b[i], r_xor[i]);
+        TEST_ASSERT_EQUAL_HEX8(a[i] | b[i], r_or[i]);
+        TEST_ASSERT_EQUAL_HEX8(a[i] & b[i], r_and[i]);
+        TEST_ASSERT_EQUAL_HEX8(a[i] | b[i], alias[i]);
+    }
+}
+
+/* ============================================================================
+ * Level Representation Tests
+ * ============================================================================ */
+
+/**
+ * @brief Test levels reproduce the thermometer encoder exactly
+ */
+void test_level_to_hv_matches_thermometer(void)
+{
+    hv_t expected, actual;
+
+    for (uint16_t value = 0U; value <= 1030U; value += 7U) {
+        hdc_encode_thermometer(expected, value, 1024U);
+        hdc_level_to_hv(actual, hdc_level_from_value(value, 1024U));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, actual, HV_BYTES);
+        TEST_ASSERT_EQUAL_UINT16(hdc_popcount(expected), hdc_level_from_value(value, 1024U));
+    }
+    TEST_ASSERT_EQUAL_UINT16(THERMO_LEVELS, hdc_level_from_adc(ADC_MAX));
+}
+
+/**
+ * @brief Test |a - b| equals the Hamming distance of the materialized vectors
+ */
+void test_level_distance_matches_hamming(void)
+{
+    hv_t a, b;
+
+    for (uint16_t la = 0U; la <= HV_DIMENSIONS; la += 5U) {
+        hdc_level_to_hv(a, (hdc_level_t)la);
+        for (uint16_t lb = 0U; lb <= HV_DIMENSIONS; lb += 11U) {
+            hdc_level_to_hv(b, (hdc_level_t)lb);
+            TEST_ASSERT_EQUAL_UINT16(hdc_hamming(a, b),
+                                     hdc_level_distance((hdc_level_t)la, (hdc_level_t)lb));
+        }
+    }
+}
+
+/**
+ * @brief Test level bundle equals OR of the materialized vectors
+ */
+void test_level_bundle_matches_or(void)
+{
+    hv_t a, b, expected;
+
+    hdc_level_to_hv(a, SCALE_128(37U));
+    hdc_level_to_hv(b, SCALE_128(90U));
+    hdc_or(expected, a, b);
+    hdc_level_to_hv(a, hdc_level_bundle(SCALE_128(37U), SCALE_128(90U)));
+
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, a, HV_BYTES);
+}
+
+/**
+ * @brief Test fused bind and level Hamming against materialize + XOR
+ */
+void test_level_bind_and_hamming_match_materialized(void)
+{
+    hv_t basis, thermo, expected, actual;
+    fill_pseudo_random(basis, 31337U);
+
+    for (uint16_t level = 0U; level <= HV_DIMENSIONS; level++) {
+        hdc_level_to_hv(thermo, (hdc_level_t)level);
+        hdc_xor(expected, thermo, basis);
+
+        hdc_level_bind(actual, (hdc_level_t)level, basis);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, actual, HV_BYTES);
+
+        TEST_ASSERT_EQUAL_UINT16(hdc_hamming(thermo, basis),
+                                 hdc_level_hamming((hdc_level_t)level, basis));
+    }
+
+    /* In-place bind */
+    hdc_copy(actual, basis);
+    hdc_level_bind(actual, SCALE_128(77U), actual);
+    hdc_level_to_hv(thermo, SCALE_128(77U));
+    hdc_xor(expected, thermo, basis);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, actual, HV_BYTES);
+}
+
+/**
+ * @brief Test the fused multi-channel encoder against encode/XOR/OR per channel
+ * @details Channel counts straddle HDC_ENCODE_CHANNEL_BLOCK boundaries.
+ */
+void test_multi_channel_fused_matches_reference(void)
+{
+    enum { MAX_CH = 20 };
+    hv_t basis[MAX_CH];
+    uint16_t values[MAX_CH];
+    hdc_level_t levels[MAX_CH];
+    hv_t expected, actual, temp;
+
+    for (uint8_t ch = 0U; ch < MAX_CH; ch++) {
+        fill_pseudo_random(basis[ch], 600U + ch);
+        values[ch] = (uint16_t)((ch * 211U) % (ADC_MAX + 1U));
+        levels[ch] = hdc_level_from_adc(values[ch]);
+    }
+
+    for (uint8_t n = 0U; n <= MAX_CH; n++) {
+        hdc_clear(expected);
+        for (uint8_t ch = 0U; ch < n; ch++) {
+            hdc_encode_adc(temp, values[ch]);
+            hdc_xor(temp, temp, basis[ch]);
+            hdc_bundle(expected, temp);
+        }
+
+        hdc_fill(actual, 0xA5U);
+        hdc_encode_multi_channel(actual, values, n, basis);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, actual, HV_BYTES);
+
+        hdc_fill(actual, 0xA5U);
+        hdc_encode_levels(actual, levels, n, basis);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, actual, HV_BYTES);
+    }
+}
+
+/* ============================================================================
+ * Specialized Encoder Tests
+ * ============================================================================ */
+
+HDC_ENCODE_DEFINE_LEVEL(level_adc, ADC_MAX)
+HDC_ENCODE_DEFINE_LEVEL(level_one, 1U)
+HDC_ENCODE_DEFINE_LEVEL(level_1000, 1000U)
+HDC_ENCODE_DEFINE_LEVEL(level_1024, 1024U)
+HDC_ENCODE_DEFINE_LEVEL(level_4095, 4095U)
+HDC_ENCODE_DEFINE_LEVEL(level_limit, HDC_FIXED_MAX_VALUE)
+
+HDC_ENCODE_DEFINE_FIXED(encode_fixed_1, 1U, ADC_MAX)
+HDC_ENCODE_DEFINE_FIXED(encode_fixed_2, 2U, ADC_MAX)
+HDC_ENCODE_DEFINE_FIXED(encode_fixed_13, 13U, ADC_MAX)
+
+/**
+ * @brief Every input value, past the maximum too, against the divide
+ */
+void test_fixed_level_matches_divide_for_every_value(void)
+{
+    for (uint32_t v = 0U; v <= 0xFFFFU; v++) {
+        uint16_t value = (uint16_t)v;
+        TEST_ASSERT_EQUAL_UINT32(hdc_level_from_adc(value), level_adc(value));
+        TEST_ASSERT_EQUAL_UINT32(hdc_level_from_value(value, 1U), level_one(value));
+        TEST_ASSERT_EQUAL_UINT32(hdc_level_from_value(value, 1000U), level_1000(value));
+        TEST_ASSERT_EQUAL_UINT32(hdc_level_from_value(value, 1024U), level_1024(value));
+        TEST_ASSERT_EQUAL_UINT32(hdc_level_from_value(value, 4095U), level_4095(value));
+        TEST_ASSERT_EQUAL_UINT32(hdc_level_from_value(value, HDC_FIXED_MAX_VALUE),
+                                 level_limit(value));
+    }
+}
+
+/**
+ * @brief Fixed encoders against hdc_encode_multi_channel() / hdc_encode_levels()
+ * @details 13 channels span more than one HDC_ENCODE_CHANNEL_BLOCK.
+ */
+void test_fixed_encoder_matches_generic(void)
+{
+    hv_t basis[13];
+    uint16_t values[13];
+    hdc_level_t levels[13];
+    hv_t expected, actual;
+
+    for (uint16_t round = 0U; round < 64U; round++) {
+        for (uint8_t ch = 0U; ch < 13U; ch++) {
+            fill_pseudo_random(basis[ch], 900U + (round * 13U) + ch);
+            values[ch] = (uint16_t)(((round * 37U) + (ch * 211U)) % (ADC_MAX + 8U));
+            levels[ch] = hdc_level_from_adc(values[ch]);
+        }
+
+        hdc_encode_multi_channel(expected, values, 1U, basis);
+        hdc_fill(actual, 0xA5U);
+        encode_fixed_1(actual, values, basis);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, actual, HV_BYTES);
+
+        hdc_encode_multi_channel(expected, values, 2U, basis);
+        hdc_fill(actual, 0xA5U);
+        encode_fixed_2(actual, values, basis);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, actual, HV_BYTES);
+
+        hdc_encode_multi_channel(expected, values, 13U, basis);
+        hdc_fill(actual, 0xA5U);
+        encode_fixed_13(actual, values, basis);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, actual, HV_BYTES);
+        hdc_fill(actual, 0xA5U);
+        encode_fixed_13_levels(actual, levels, basis);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, actual, HV_BYTES);
+    }
+}
+
 /* ============================================================================
  * Main Test Runner
  * ============================================================================ */
@@ -827,9 +1271,15 @@ int main(void)
     RUN_TEST(test_popcount8_all_ones);
     RUN_TEST(test_popcount8_alternating);
     RUN_TEST(test_popcount8_single_bit);
+    RUN_TEST(test_popcount8_matches_bit_reference);
     RUN_TEST(test_popcount_full_hypervector_zeros);
     RUN_TEST(test_popcount_full_hypervector_ones);
 
+    /* Kernel range tests */
+    RUN_TEST(test_kernel_hamming_every_length);
+    RUN_TEST(test_kernel_xor_every_length);
+    RUN_TEST(test_kernel_xor_in_place);
+
     /* XOR tests */
     RUN_TEST(test_xor_identical_vectors_gives_zero);
     RUN_TEST(test_xor_with_zero_gives_same);
@@ -854,6 +1304,8 @@ int main(void)
     RUN_TEST(test_hamming_opposite_is_max);
     RUN_TEST(test_hamming_half_different);
     RUN_TEST(test_hamming_single_byte_different);
+    RUN_TEST(test_hamming_bounded_exact_within_bound);
+    RUN_TEST(test_hamming_bounded_exceeds_bound_when_far);
 
     /* Similarity tests */
     RUN_TEST(test_similarity_identical_is_max);
@@ -866,6 +1318,7 @@ int main(void)
     RUN_TEST(test_permute_creates_orthogonal_vectors);
     RUN_TEST(test_permute_small_shift);
     RUN_TEST(test_permute_preserves_popcount);
+    RUN_TEST(test_permute_matches_bit_reference);
 
     /* Thermometer encoding tests */
     RUN_TEST(test_thermo_zero_gives_empty);
@@ -874,6 +1327,15 @@ int main(void)
     RUN_TEST(test_thermo_preserves_order);
     RUN_TEST(test_thermo_similar_values_are_close);
     RUN_TEST(test_thermo_distant_values_are_far);
+    RUN_TEST(test_level_to_hv_matches_thermometer);
+    RUN_TEST(test_level_distance_matches_hamming);
+    RUN_TEST(test_level_bundle_matches_or);
+    RUN_TEST(test_level_bind_and_hamming_match_materialized);
+    RUN_TEST(test_multi_channel_fused_matches_reference);
+
+    /* Specialized encoder tests */
+    RUN_TEST(test_fixed_level_matches_divide_for_every_value);
+    RUN_TEST(test_fixed_encoder_matches_generic);
 
     /* ADC encoding tests (NEW) */
     RUN_TEST(test_adc_zero_gives_empty);
@@ -899,5 +1361,11 @@ int main(void)
     RUN_TEST(test_copy_duplicates_exactly);
     RUN_TEST(test_fill_sets_all_bytes);
 
+    /* Kernel backend cross-checks */
+    RUN_TEST(test_kernel_hamming_matches_reference);
+    RUN_TEST(test_kernel_hamming_bounded_matches_reference);
+    RUN_TEST(test_kernel_popcount_matches_reference);
+    RUN_TEST(test_kernel_bitwise_matches_reference);
+
     return UNITY_END();
 }
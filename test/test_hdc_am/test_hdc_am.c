@@ -0,0 +1,449 @@
+/**
+ * @file    test_hdc_am.c
+ * @brief   Unit Tests for the HDC Associative Memory
+ * @version 1.0.0
+ *
+ * @details Tests for class storage and Hamming search:
+ *          - Management: init, add, set, get, capacity limits
+ *          - Search: nearest, top-k ordering and ties, batched top-k
+ *          - Search modes: bounded early exit agrees with exhaustive search
+ *          - Fused: scoring channel levels without materializing the query
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_am.h"
+#include "hdc/hdc_encode.h"
+#include "mock_hv.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TEST_CLASSES    13U
+
+static hv_t s_storage[TEST_CLASSES];
+static hdc_am_t s_am;
+
+/**
+ * @brief Fill the memory with TEST_CLASSES pseudo-random prototypes
+ */
+static void fill_memory(void)
+{
+    hv_t hv;
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        fill_pseudo_random(hv, 1000U + c);
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_add(&s_am, hv, NULL));
+    }
+}
+
+void setUp(void)
+{
+    memset(s_storage, 0, sizeof(s_storage));
+    hdc_am_init(&s_am, s_storage, TEST_CLASSES);
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/* ============================================================================
+ * Management Tests
+ * ============================================================================ */
+
+void test_am_init_is_empty(void)
+{
+    TEST_ASSERT_EQUAL_UINT16(0U, s_am.count);
+    TEST_ASSERT_EQUAL_UINT16(TEST_CLASSES, s_am.capacity);
+    TEST_ASSERT_NULL(hdc_am_get(&s_am, 0U));
+}
+
+void test_am_add_assigns_sequential_ids(void)
+{
+    hv_t hv;
+    hdc_class_t id = HDC_AM_CLASS_NONE;
+
+    hdc_fill(hv, 0x11U);
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_add(&s_am, hv, &id));
+    TEST_ASSERT_EQUAL_UINT16(0U, id);
+
+    hdc_fill(hv, 0x22U);
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_add(&s_am, hv, &id));
+    TEST_ASSERT_EQUAL_UINT16(1U, id);
+
+    /* Rows live contiguously in caller storage */
+    TEST_ASSERT_EQUAL_PTR(&s_storage[1], hdc_am_get(&s_am, 1U));
+    TEST_ASSERT_EQUAL_HEX8(0x22U, s_storage[1][0]);
+}
+
+void test_am_add_full_is_rejected(void)
+{
+    hv_t hv;
+    fill_memory();
+    hdc_clear(hv);
+
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_FULL, hdc_am_add(&s_am, hv, NULL));
+    TEST_ASSERT_EQUAL_UINT16(TEST_CLASSES, s_am.count);
+}
+
+void test_am_set_overwrites_and_validates(void)
+{
+    hv_t hv;
+    fill_memory();
+
+    hdc_fill(hv, 0x5AU);
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_set(&s_am, 3U, hv));
+    TEST_ASSERT_EQUAL_HEX8(0x5AU, (*hdc_am_get(&s_am, 3U))[HV_BYTES - 1U]);
+
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_INVALID_CLASS, hdc_am_set(&s_am, TEST_CLASSES, hv));
+}
+
+void test_am_view_searches_in_place_and_is_read_only(void)
+{
+    hdc_am_t view;
+    hdc_am_match_t best;
+    hv_t hv;
+
+    fill_memory();
+    hdc_am_init_view(&view, (const hv_t*)s_storage, TEST_CLASSES);
+    TEST_ASSERT_EQUAL_UINT16(TEST_CLASSES, view.count);
+
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&view, s_storage[5], &best));
+    TEST_ASSERT_EQUAL_UINT16(5U, best.class_id);
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_read(&view, 5U, hv));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(s_storage[5], hv, HV_BYTES);
+
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_READ_ONLY, hdc_am_add(&view, hv, NULL));
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_READ_ONLY, hdc_am_set(&view, 0U, hv));
+    TEST_ASSERT_NULL(hdc_am_get(&view, 0U));
+}
+
+/* ============================================================================
+ * Search Tests
+ * ============================================================================ */
+
+void test_am_query_empty_reports_error(void)
+{
+    hv_t query;
+    hdc_am_match_t best;
+    hdc_clear(query);
+
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_EMPTY, hdc_am_query(&s_am, query, &best));
+    TEST_ASSERT_EQUAL_UINT16(HDC_AM_CLASS_NONE, best.class_id);
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_am_query_topk(&s_am, query, &best, 1U));
+}
+
+void test_am_query_finds_exact_prototype(void)
+{
+    hv_t query;
+    hdc_am_match_t best;
+    fill_memory();
+
+    hdc_copy(query, *hdc_am_get(&s_am, 7U));
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&s_am, query, &best));
+    TEST_ASSERT_EQUAL_UINT16(7U, best.class_id);
+    TEST_ASSERT_EQUAL_UINT16(0U, best.distance);
+}
+
+void test_am_query_finds_nearest_after_noise(void)
+{
+    hv_t query;
+    hdc_am_match_t best;
+    fill_memory();
+
+    /* Flip a few bits of class 4: it must still be the nearest */
+    hdc_copy(query, *hdc_am_get(&s_am, 4U));
+    query[0] ^= 0x81U;
+    query[HV_BYTES - 1U] ^= 0x10U;
+
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&s_am, query, &best));
+    TEST_ASSERT_EQUAL_UINT16(4U, best.class_id);
+    TEST_ASSERT_EQUAL_UINT16(3U, best.distance);
+}
+
+void test_am_topk_is_sorted_and_matches_hamming(void)
+{
+    hv_t query;
+    hdc_am_match_t results[5];
+    fill_memory();
+    fill_pseudo_random(query, 77U);
+
+    uint8_t n = hdc_am_query_topk(&s_am, query, results, 5U);
+    TEST_ASSERT_EQUAL_UINT8(5U, n);
+
+    for (uint8_t i = 0U; i < n; i++) {
+        hdc_dist_t expected = hdc_hamming(query, *hdc_am_get(&s_am, results[i].class_id));
+        TEST_ASSERT_EQUAL_UINT16(expected, results[i].distance);
+        if (i > 0U) {
+            TEST_ASSERT_LESS_OR_EQUAL_UINT16(results[i].distance, results[i - 1U].distance);
+        }
+    }
+
+    /* Nothing outside the top-k is nearer than the k-th result */
+    for (hdc_class_t c = 0U; c < s_am.count; c++) {
+        uint8_t listed = 0U;
+        for (uint8_t i = 0U; i < n; i++) {
+            listed |= (results[i].class_id == c) ? 1U : 0U;
+        }
+        if (listed == 0U) {
+            TEST_ASSERT_GREATER_OR_EQUAL_UINT16(results[n - 1U].distance,
+                                                hdc_hamming(query, *hdc_am_get(&s_am, c)));
+        }
+    }
+}
+
+void test_am_topk_ties_prefer_lower_class(void)
+{
+    hv_t hv, query;
+    hdc_am_match_t results[3];
+
+    hdc_fill(hv, 0x0FU);
+    (void)hdc_am_add(&s_am, hv, NULL);   /* class 0: far */
+    hdc_clear(hv);
+    (void)hdc_am_add(&s_am, hv, NULL);   /* class 1: exact */
+    (void)hdc_am_add(&s_am, hv, NULL);   /* class 2: exact (tie) */
+
+    hdc_clear(query);
+    TEST_ASSERT_EQUAL_UINT8(3U, hdc_am_query_topk(&s_am, query, results, 3U));
+    TEST_ASSERT_EQUAL_UINT16(1U, results[0].class_id);
+    TEST_ASSERT_EQUAL_UINT16(2U, results[1].class_id);
+    TEST_ASSERT_EQUAL_UINT16(0U, results[2].class_id);
+}
+
+void test_am_topk_k_larger_than_count(void)
+{
+    hv_t hv;
+    hdc_am_match_t results[4];
+
+    hdc_clear(hv);
+    (void)hdc_am_add(&s_am, hv, NULL);
+    (void)hdc_am_add(&s_am, hv, NULL);
+
+    TEST_ASSERT_EQUAL_UINT8(2U, hdc_am_query_topk(&s_am, hv, results, 4U));
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_am_query_topk(&s_am, hv, results, 0U));
+}
+
+/**
+ * @brief Test batched search equals one top-k search per query
+ * @details 21 queries spans two full tiles and a partial one
+ */
+void test_am_batch_matches_single_queries(void)
+{
+    enum { NUM_QUERIES = 21, K = 3 };
+    hv_t queries[NUM_QUERIES];
+    hdc_am_match_t batch[NUM_QUERIES * K];
+    hdc_am_match_t single[K];
+    fill_memory();
+
+    for (uint16_t q = 0U; q < NUM_QUERIES; q++) {
+        fill_pseudo_random(queries[q], 5000U + q);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(K, hdc_am_query_batch(&s_am, queries, NUM_QUERIES, batch, K));
+
+    for (uint16_t q = 0U; q < NUM_QUERIES; q++) {
+        TEST_ASSERT_EQUAL_UINT8(K, hdc_am_query_topk(&s_am, queries[q], single, K));
+        for (uint8_t i = 0U; i < K; i++) {
+            TEST_ASSERT_EQUAL_UINT16(single[i].class_id, batch[(q * K) + i].class_id);
+            TEST_ASSERT_EQUAL_UINT16(single[i].distance, batch[(q * K) + i].distance);
+        }
+    }
+}
+
+/**
+ * @brief Test a tile-unaligned batch near the 16-bit count limit terminates
+ *        and scores its last queries
+ * @details The tile index must not wrap past 0xFFFF; only the tail queries
+ *          differ from zero, so only they are checked one by one
+ */
+void test_am_batch_near_max_count(void)
+{
+#if HV_BYTES <= 32U
+    enum { NUM_QUERIES = 0xFFFF, TAIL = 11 };
+    static hv_t queries[NUM_QUERIES];
+    static hdc_am_match_t batch[NUM_QUERIES];
+    hdc_am_match_t single;
+    fill_memory();
+
+    memset(queries, 0, sizeof(queries));
+    for (uint16_t q = NUM_QUERIES - TAIL; q < NUM_QUERIES; q++) {
+        fill_pseudo_random(queries[q], 7000U + q);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(1U, hdc_am_query_batch(&s_am, (const hv_t*)queries, NUM_QUERIES,
+                                                   batch, 1U));
+
+    for (uint16_t q = NUM_QUERIES - TAIL; q < NUM_QUERIES; q++) {
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&s_am, queries[q], &single));
+        TEST_ASSERT_EQUAL_UINT16(single.class_id, batch[q].class_id);
+        TEST_ASSERT_EQUAL_UINT16(single.distance, batch[q].distance);
+    }
+#else
+    TEST_IGNORE_MESSAGE("65535 queries need HV_BYTES <= 32");
+#endif
+}
+
+void test_am_batch_empty_inputs(void)
+{
+    hv_t query;
+    hdc_am_match_t results[2];
+    hdc_clear(query);
+
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_am_query_batch(&s_am, &query, 1U, results, 2U));
+    fill_memory();
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_am_query_batch(&s_am, &query, 0U, results, 2U));
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_am_query_batch(&s_am, &query, 1U, results, 0U));
+}
+
+/* ============================================================================
+ * Search Mode Tests
+ * ============================================================================ */
+
+void test_am_default_search_is_bounded(void)
+{
+    TEST_ASSERT_EQUAL(HDC_AM_SEARCH_BOUNDED, s_am.search);
+    hdc_am_set_search(&s_am, HDC_AM_SEARCH_EXHAUSTIVE);
+    TEST_ASSERT_EQUAL(HDC_AM_SEARCH_EXHAUSTIVE, s_am.search);
+}
+
+void test_am_bounded_matches_exhaustive(void)
+{
+    enum { NUM_QUERIES = 24, K = 4 };
+    hv_t queries[NUM_QUERIES];
+    hdc_am_match_t bounded[NUM_QUERIES * K];
+    hdc_am_match_t exhaustive[NUM_QUERIES * K];
+    hdc_am_match_t best_bounded;
+    hdc_am_match_t best_exhaustive;
+    fill_memory();
+
+    /* Zero both result arrays so struct padding compares equal */
+    memset(bounded, 0, sizeof(bounded));
+    memset(exhaustive, 0, sizeof(exhaustive));
+
+    /* Duplicate a row so ties at the best distance are exercised */
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_set(&s_am, 9U, s_storage[4]));
+
+    /* Half the queries are noisy prototypes (one clear winner), half random */
+    for (uint16_t q = 0U; q < NUM_QUERIES; q++) {
+        fill_pseudo_random(queries[q], 7000U + q);
+        if ((q % 2U) == 0U) {
+            hv_t noise;
+            fill_pseudo_random(noise, 9000U + q);
+            for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+                queries[q][i] = (uint8_t)(s_storage[q % TEST_CLASSES][i] ^ (noise[i] & (noise[i] >> 1) & 0x11U));
+            }
+        }
+    }
+
+    for (uint16_t q = 0U; q < NUM_QUERIES; q++) {
+        hdc_am_set_search(&s_am, HDC_AM_SEARCH_EXHAUSTIVE);
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&s_am, queries[q], &best_exhaustive));
+        TEST_ASSERT_EQUAL_UINT8(K, hdc_am_query_topk(&s_am, queries[q], &exhaustive[q * K], K));
+
+        hdc_am_set_search(&s_am, HDC_AM_SEARCH_BOUNDED);
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&s_am, queries[q], &best_bounded));
+        TEST_ASSERT_EQUAL_UINT8(K, hdc_am_query_topk(&s_am, queries[q], &bounded[q * K], K));
+
+        TEST_ASSERT_EQUAL_UINT16(best_exhaustive.class_id, best_bounded.class_id);
+        TEST_ASSERT_EQUAL_UINT16(best_exhaustive.distance, best_bounded.distance);
+    }
+    TEST_ASSERT_EQUAL_MEMORY(exhaustive, bounded, sizeof(bounded));
+
+    /* Batched bounded search agrees with the exhaustive single queries */
+    memset(bounded, 0, sizeof(bounded));
+    TEST_ASSERT_EQUAL_UINT8(K, hdc_am_query_batch(&s_am, queries, NUM_QUERIES, bounded, K));
+    TEST_ASSERT_EQUAL_MEMORY(exhaustive, bounded, sizeof(bounded));
+}
+
+/* ============================================================================
+ * Fused Encode and Search Tests
+ * ============================================================================ */
+
+void test_am_query_levels_empty_reports_error(void)
+{
+    hv_t basis[1];
+    hdc_level_t level = 0U;
+    hdc_dist_t distances[1];
+    hdc_am_match_t best;
+    hdc_clear(basis[0]);
+
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_EMPTY,
+                      hdc_am_query_levels(&s_am, &level, 1U, basis, distances, &best));
+    TEST_ASSERT_EQUAL_UINT16(HDC_AM_CLASS_NONE, best.class_id);
+}
+
+void test_am_query_levels_matches_materialized(void)
+{
+    enum { CHANNELS = 5 };
+    hv_t basis[CHANNELS];
+    hdc_level_t levels[CHANNELS];
+    hdc_dist_t distances[TEST_CLASSES];
+    hv_t query;
+    hdc_am_match_t fused;
+    hdc_am_match_t reference;
+    fill_memory();
+
+    for (uint8_t ch = 0U; ch < CHANNELS; ch++) {
+        fill_pseudo_random(basis[ch], 3000U + ch);
+    }
+
+    for (uint16_t sample = 0U; sample < 32U; sample++) {
+        for (uint8_t ch = 0U; ch < CHANNELS; ch++) {
+            levels[ch] = hdc_level_from_adc((uint16_t)(((sample * 37U) + (ch * 301U)) % (ADC_MAX + 1U)));
+        }
+
+        hdc_encode_levels(query, levels, CHANNELS, basis);
+        TEST_ASSERT_EQUAL(HDC_AM_OK,
+                          hdc_am_query_levels(&s_am, levels, CHANNELS, basis, distances, &fused));
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&s_am, query, &reference));
+
+        for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+            TEST_ASSERT_EQUAL_UINT16(hdc_hamming(query, s_storage[c]), distances[c]);
+        }
+        TEST_ASSERT_EQUAL_UINT16(reference.class_id, fused.class_id);
+        TEST_ASSERT_EQUAL_UINT16(reference.distance, fused.distance);
+    }
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Management tests */
+    RUN_TEST(test_am_init_is_empty);
+    RUN_TEST(test_am_add_assigns_sequential_ids);
+    RUN_TEST(test_am_add_full_is_rejected);
+    RUN_TEST(test_am_set_overwrites_and_validates);
+    RUN_TEST(test_am_view_searches_in_place_and_is_read_only);
+
+    /* Search tests */
+    RUN_TEST(test_am_query_empty_reports_error);
+    RUN_TEST(test_am_query_finds_exact_prototype);
+    RUN_TEST(test_am_query_finds_nearest_after_noise);
+    RUN_TEST(test_am_topk_is_sorted_and_matches_hamming);
+    RUN_TEST(test_am_topk_ties_prefer_lower_class);
+    RUN_TEST(test_am_topk_k_larger_than_count);
+    RUN_TEST(test_am_batch_matches_single_queries);
+    RUN_TEST(test_am_batch_near_max_count);
+    RUN_TEST(test_am_batch_empty_inputs);
+
+    /* Search mode tests */
+    RUN_TEST(test_am_default_search_is_bounded);
+    RUN_TEST(test_am_bounded_matches_exhaustive);
+
+    /* Fused encode and search tests */
+    RUN_TEST(test_am_query_levels_empty_reports_error);
+    RUN_TEST(test_am_query_levels_matches_materialized);
+
+    return UNITY_END();
+}
@@ -0,0 +1,297 @@
+/**
+ * @file    test_hdc_amt.c
+ * @brief   Unit Tests for the Transposed HDC Associative Memory
+ * @version 1.0.0
+ *
+ * @details Tests for the bit-sliced class store:
+ *          - Management: init, add, set, read back, capacity, views
+ *          - Search: results identical to hdc_am.h for class counts around
+ *            the 256-lane block size, in both search modes
+ *          - Ties: duplicate prototypes come back in class ID order
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_am.h"
+#include "hdc/hdc_amt.h"
+#include "mock_hv.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TEST_CLASSES    300U
+#define TEST_TOPK       8U
+
+static hv_t s_rows[TEST_CLASSES];
+static uint64_t s_planes[HDC_AMT_WORDS(TEST_CLASSES)];
+static hdc_amt_t s_amt;
+
+/**
+ * @brief Add the first count rows to the transposed memory
+ */
+static void fill_memory(hdc_class_t count)
+{
+    for (hdc_class_t c = 0U; c < count; c++) {
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_amt_add(&s_amt, s_rows[c], NULL));
+    }
+}
+
+/**
+ * @brief Query near a class: its prototype with every fourth byte replaced
+ */
+static void near_query(hv_t query, hdc_class_t c, uint32_t seed)
+{
+    fill_pseudo_random(query, seed);
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        if ((i % 4U) != 0U) {
+            query[i] = s_rows[c][i];
+        }
+    }
+}
+
+/**
+ * @brief Check top-k against hdc_am.h over the same rows in both modes
+ */
+static void assert_topk_matches_rows(hdc_class_t count, const hv_t query, uint8_t k)
+{
+    static const hdc_am_search_t modes[2] = {HDC_AM_SEARCH_EXHAUSTIVE, HDC_AM_SEARCH_BOUNDED};
+    hdc_am_match_t expected[TEST_TOPK], actual[TEST_TOPK];
+    hdc_am_t rows;
+
+    hdc_am_init_view(&rows, (const hv_t*)s_rows, count);
+    hdc_am_set_search(&rows, HDC_AM_SEARCH_EXHAUSTIVE);
+    uint8_t n = hdc_am_query_topk(&rows, query, expected, k);
+
+    for (uint8_t m = 0U; m < 2U; m++) {
+        hdc_amt_set_search(&s_amt, modes[m]);
+        memset(actual, 0xA5, sizeof(actual));
+        TEST_ASSERT_EQUAL_UINT8(n, hdc_amt_query_topk(&s_amt, query, actual, k));
+        for (uint8_t i = 0U; i < n; i++) {
+            TEST_ASSERT_EQUAL_UINT16(expected[i].class_id, actual[i].class_id);
+            TEST_ASSERT_EQUAL_UINT16(expected[i].distance, actual[i].distance);
+        }
+    }
+}
+
+void setUp(void)
+{
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        fill_pseudo_random(s_rows[c], 1000U + c);
+    }
+    memset(s_planes, 0xFF, sizeof(s_planes));
+    hdc_amt_init(&s_amt, s_planes, TEST_CLASSES);
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/* ============================================================================
+ * Management Tests
+ * ============================================================================ */
+
+void test_amt_init_is_empty_and_clears_planes(void)
+{
+    TEST_ASSERT_EQUAL_UINT16(0U, s_amt.count);
+    TEST_ASSERT_EQUAL_UINT16(TEST_CLASSES, s_amt.capacity);
+    TEST_ASSERT_EQUAL(HDC_AM_SEARCH_BOUNDED, s_amt.search);
+    for (uint32_t w = 0U; w < HDC_AMT_WORDS(TEST_CLASSES); w++) {
+        TEST_ASSERT_EQUAL_HEX64(0U, s_planes[w]);
+    }
+}
+
+void test_amt_add_read_round_trip(void)
+{
+    hdc_class_t id = HDC_AM_CLASS_NONE;
+    hv_t out;
+
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_amt_add(&s_amt, s_rows[c], &id));
+        TEST_ASSERT_EQUAL_UINT16(c, id);
+    }
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_amt_read(&s_amt, c, out));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(s_rows[c], out, HV_BYTES);
+    }
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_INVALID_CLASS, hdc_amt_read(&s_amt, TEST_CLASSES, out));
+
+    /* Layout: bit j of word w of dimension d in block b is bit d of class
+     * 256 * b + 64 * w + j */
+    hdc_class_t c = 290U;
+    uint64_t word = s_planes[((((c / HDC_AMT_LANES) * HV_DIMENSIONS) + 5U) * HDC_AMT_BLOCK_WORDS) +
+                             ((c % HDC_AMT_LANES) / 64U)];
+    TEST_ASSERT_EQUAL_UINT8((s_rows[c][0] >> 5) & 1U, (uint8_t)((word >> (c % 64U)) & 1U));
+}
+
+void test_amt_add_full_is_rejected(void)
+{
+    fill_memory(TEST_CLASSES);
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_FULL, hdc_amt_add(&s_amt, s_rows[0], NULL));
+    TEST_ASSERT_EQUAL_UINT16(TEST_CLASSES, s_amt.count);
+}
+
+void test_amt_set_overwrites_only_its_lane(void)
+{
+    hv_t out;
+
+    fill_memory(270U);
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_amt_set(&s_amt, 65U, s_rows[0]));
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_amt_set(&s_amt, 260U, s_rows[1]));
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_INVALID_CLASS, hdc_amt_set(&s_amt, 270U, s_rows[0]));
+
+    for (hdc_class_t c = 0U; c < 270U; c++) {
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_amt_read(&s_amt, c, out));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY((c == 65U) ? s_rows[0] : ((c == 260U) ? s_rows[1] : s_rows[c]),
+                                     out, HV_BYTES);
+    }
+}
+
+void test_amt_view_searches_in_place_and_is_read_only(void)
+{
+    hdc_amt_t view;
+    hdc_am_match_t best;
+
+    fill_memory(100U);
+    hdc_amt_init_view(&view, s_planes, 100U);
+    TEST_ASSERT_EQUAL_UINT16(100U, view.count);
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_READ_ONLY, hdc_amt_add(&view, s_rows[0], NULL));
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_READ_ONLY, hdc_amt_set(&view, 0U, s_rows[0]));
+
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_amt_query(&view, s_rows[77], &best));
+    TEST_ASSERT_EQUAL_UINT16(77U, best.class_id);
+    TEST_ASSERT_EQUAL_UINT16(0U, best.distance);
+}
+
+/* ============================================================================
+ * Search Tests
+ * ============================================================================ */
+
+void test_amt_query_empty_reports_error(void)
+{
+    hdc_am_match_t best;
+    hdc_am_match_t results[1];
+
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_EMPTY, hdc_amt_query(&s_amt, s_rows[0], &best));
+    TEST_ASSERT_EQUAL_UINT16(HDC_AM_CLASS_NONE, best.class_id);
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_amt_query_topk(&s_amt, s_rows[0], results, 1U));
+
+    fill_memory(1U);
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_amt_query_topk(&s_amt, s_rows[0], results, 0U));
+}
+
+void test_amt_query_finds_every_prototype(void)
+{
+    hdc_am_match_t best;
+
+    fill_memory(TEST_CLASSES);
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_amt_query(&s_amt, s_rows[c], &best));
+        TEST_ASSERT_EQUAL_UINT16(c, best.class_id);
+        TEST_ASSERT_EQUAL_UINT16(0U, best.distance);
+    }
+}
+
+void test_amt_topk_matches_row_memory(void)
+{
+    static const hdc_class_t counts[] = {1U, 63U, 64U, 65U, 255U, 256U, 257U, TEST_CLASSES};
+    static const uint8_t ks[] = {1U, 3U, TEST_TOPK};
+    hv_t query;
+
+    for (uint8_t n = 0U; n < (uint8_t)(sizeof(counts) / sizeof(counts[0])); n++) {
+        hdc_amt_init(&s_amt, s_planes, TEST_CLASSES);
+        fill_memory(counts[n]);
+
+        for (uint8_t q = 0U; q < 12U; q++) {
+            /* Half near a class in the last block, half unrelated */
+            if ((q % 2U) == 0U) {
+                near_query(query, (hdc_class_t)(counts[n] - 1U - (q % counts[n])), 7000U + q);
+            } else {
+                fill_pseudo_random(query, 9000U + q);
+            }
+            for (uint8_t i = 0U; i < (uint8_t)sizeof(ks); i++) {
+                assert_topk_matches_rows(counts[n], query, ks[i]);
+            }
+        }
+    }
+}
+
+void test_amt_topk_k_larger_than_count(void)
+{
+    hdc_am_match_t results[TEST_TOPK];
+
+    fill_memory(5U);
+    TEST_ASSERT_EQUAL_UINT8(5U, hdc_amt_query_topk(&s_amt, s_rows[3], results, TEST_TOPK));
+    TEST_ASSERT_EQUAL_UINT16(3U, results[0].class_id);
+    assert_topk_matches_rows(5U, s_rows[3], TEST_TOPK);
+}
+
+/* ============================================================================
+ * Tie Tests
+ * ============================================================================ */
+
+void test_amt_topk_ties_prefer_lower_class(void)
+{
+    static const hdc_class_t expected[] = {260U, 290U, 10U, 20U, 30U, 270U};
+    hdc_am_match_t results[TEST_TOPK];
+
+    /* Exact copies only in block 1, so a probing search starts there; the
+     * block 0 matches, and the cross-block tie at distance 2, still come
+     * back in class ID order */
+    memcpy(s_rows[260], s_rows[290], HV_BYTES);
+    memcpy(s_rows[10], s_rows[290], HV_BYTES);
+    memcpy(s_rows[20], s_rows[290], HV_BYTES);
+    memcpy(s_rows[30], s_rows[290], HV_BYTES);
+    memcpy(s_rows[270], s_rows[290], HV_BYTES);
+    s_rows[10][HV_BYTES - 1U] ^= 0x01U;
+    s_rows[20][HV_BYTES - 1U] ^= 0x02U;
+    s_rows[30][HV_BYTES - 1U] ^= 0x03U;
+    s_rows[270][HV_BYTES - 1U] ^= 0x05U;
+    fill_memory(TEST_CLASSES);
+
+    for (uint8_t m = 0U; m < 2U; m++) {
+        hdc_amt_set_search(&s_amt, (m == 0U) ? HDC_AM_SEARCH_EXHAUSTIVE : HDC_AM_SEARCH_BOUNDED);
+        TEST_ASSERT_EQUAL_UINT8(TEST_TOPK, hdc_amt_query_topk(&s_amt, s_rows[290], results, TEST_TOPK));
+        for (uint8_t i = 0U; i < 6U; i++) {
+            TEST_ASSERT_EQUAL_UINT16(expected[i], results[i].class_id);
+        }
+        TEST_ASSERT_EQUAL_UINT16(0U, results[1].distance);
+        TEST_ASSERT_EQUAL_UINT16(1U, results[3].distance);
+        TEST_ASSERT_EQUAL_UINT16(2U, results[5].distance);
+        TEST_ASSERT_TRUE(results[6].distance > 2U);
+    }
+    assert_topk_matches_rows(TEST_CLASSES, s_rows[290], TEST_TOPK);
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Management tests */
+    RUN_TEST(test_amt_init_is_empty_and_clears_planes);
+    RUN_TEST(test_amt_add_read_round_trip);
+    RUN_TEST(test_amt_add_full_is_rejected);
+    RUN_TEST(test_amt_set_overwrites_only_its_lane);
+    RUN_TEST(test_amt_view_searches_in_place_and_is_read_only);
+
+    /* Search tests */
+    RUN_TEST(test_amt_query_empty_reports_error);
+    RUN_TEST(test_amt_query_finds_every_prototype);
+    RUN_TEST(test_amt_topk_matches_row_memory);
+    RUN_TEST(test_amt_topk_k_larger_than_count);
+
+    /* Tie tests */
+    RUN_TEST(test_amt_topk_ties_prefer_lower_class);
+
+    return UNITY_END();
+}
@@ -0,0 +1,389 @@
+/**
+ * @file    test_hdc_counter.c
+ * @brief   Unit Tests for Counter-Based Majority Bundling
+ * @version 1.1.0
+ *
+ * @details Tests for the bit-sliced saturating counters:
+ *          - Counting: reset value, up/down steps, saturation at both ends,
+ *            subtraction
+ *          - Threshold: majority, ties, tie-break vector
+ *          - Tracking: changed word positions, masked re-threshold
+ *          - Reference: random pattern streams against per-bit counters
+ *          - Capacity: majority survives bundles where OR saturates
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ */
+
+#include <unity.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_counter.h"
+#include "mock_hv.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+static hdc_counter_t s_counter;
+
+/**
+ * @brief Read one bit of a hypervector
+ */
+static uint8_t get_bit(const hv_t hv, hdc_dist_t dim)
+{
+    return (uint8_t)((hv[dim / 8U] >> (dim % 8U)) & 1U);
+}
+
+void setUp(void)
+{
+    hdc_counter_reset(&s_counter);
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/* ============================================================================
+ * Counting Tests
+ * ============================================================================ */
+
+void test_counter_reset_is_tie(void)
+{
+    hv_t result;
+    hdc_fill(result, 0xFFU);
+
+    TEST_ASSERT_EQUAL_UINT8(HDC_COUNTER_INIT, hdc_counter_get(&s_counter, 0U));
+    TEST_ASSERT_EQUAL_UINT8(HDC_COUNTER_INIT,
+                            hdc_counter_get(&s_counter, (hdc_dist_t)(HV_DIMENSIONS - 1U)));
+
+    hdc_counter_threshold(result, &s_counter, NULL);
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_popcount(result));
+}
+
+void test_counter_counts_up_and_down(void)
+{
+    hv_t ones;
+    hv_t zeros;
+    hdc_fill(ones, 0xFFU);
+    hdc_clear(zeros);
+
+    hdc_counter_add(&s_counter, ones);
+    hdc_counter_add(&s_counter, ones);
+    TEST_ASSERT_EQUAL_UINT8(HDC_COUNTER_INIT + 2U, hdc_counter_get(&s_counter, 5U));
+
+    hdc_counter_add(&s_counter, zeros);
+    hdc_counter_add(&s_counter, zeros);
+    hdc_counter_add(&s_counter, zeros);
+    TEST_ASSERT_EQUAL_UINT8(HDC_COUNTER_INIT - 1U, hdc_counter_get(&s_counter, 5U));
+}
+
+void test_counter_saturates_high(void)
+{
+    hv_t ones;
+    hv_t zeros;
+    hv_t result;
+    hdc_fill(ones, 0xFFU);
+    hdc_clear(zeros);
+
+    for (uint16_t n = 0U; n < (HDC_COUNTER_MAX + 10U); n++) {
+        hdc_counter_add(&s_counter, ones);
+    }
+    TEST_ASSERT_EQUAL_UINT8(HDC_COUNTER_MAX, hdc_counter_get(&s_counter, 0U));
+
+    /* No wrap: one opposing vote leaves the majority intact */
+    hdc_counter_add(&s_counter, zeros);
+    TEST_ASSERT_EQUAL_UINT8(HDC_COUNTER_MAX - 1U, hdc_counter_get(&s_counter, 0U));
+    hdc_counter_threshold(result, &s_counter, NULL);
+    TEST_ASSERT_EQUAL_UINT16(HV_DIMENSIONS, hdc_popcount(result));
+}
+
+void test_counter_saturates_low(void)
+{
+    hv_t ones;
+    hv_t zeros;
+    hv_t result;
+    hdc_fill(ones, 0xFFU);
+    hdc_clear(zeros);
+
+    for (uint16_t n = 0U; n < (HDC_COUNTER_MAX + 10U); n++) {
+        hdc_counter_add(&s_counter, zeros);
+    }
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_counter_get(&s_counter, 0U));
+
+    hdc_counter_add(&s_counter, ones);
+    TEST_ASSERT_EQUAL_UINT8(1U, hdc_counter_get(&s_counter, 0U));
+    hdc_counter_threshold(result, &s_counter, NULL);
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_popcount(result));
+}
+
+void test_counter_sub_reverses_add(void)
+{
+    hv_t pattern;
+    hdc_counter_t before;
+
+    fill_pseudo_random(pattern, 42U);
+    hdc_counter_add(&s_counter, pattern);
+    before = s_counter;
+
+    /* Away from saturation, add and sub cancel exactly */
+    hdc_counter_add(&s_counter, pattern);
+    hdc_counter_sub(&s_counter, pattern);
+    TEST_ASSERT_EQUAL_MEMORY(&before, &s_counter, sizeof(hdc_counter_t));
+
+    /* Subtracting counts 1 bits down and 0 bits up */
+    hdc_counter_sub(&s_counter, pattern);
+    hdc_counter_sub(&s_counter, pattern);
+    for (hdc_dist_t d = 0U; d < (hdc_dist_t)HV_DIMENSIONS; d++) {
+        TEST_ASSERT_EQUAL_UINT8((get_bit(pattern, d) != 0U) ? (HDC_COUNTER_INIT - 1U)
+                                                            : (HDC_COUNTER_INIT + 1U),
+                                hdc_counter_get(&s_counter, d));
+    }
+}
+
+/* ============================================================================
+ * Threshold Tests
+ * ============================================================================ */
+
+void test_counter_majority_of_three(void)
+{
+    hv_t a;
+    hv_t b;
+    hv_t c;
+    hv_t result;
+
+    fill_pseudo_random(a, 1U);
+    fill_pseudo_random(b, 2U);
+    fill_pseudo_random(c, 3U);
+
+    hdc_counter_add(&s_counter, a);
+    hdc_counter_add(&s_counter, b);
+    hdc_counter_add(&s_counter, c);
+    hdc_counter_threshold(result, &s_counter, NULL);
+
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        uint8_t expected = (uint8_t)((a[i] & b[i]) | (a[i] & c[i]) | (b[i] & c[i]));
+        TEST_ASSERT_EQUAL_HEX8(expected, result[i]);
+    }
+}
+
+void test_counter_tie_uses_tiebreak(void)
+{
+    hv_t a;
+    hv_t b;
+    hv_t tiebreak;
+    hv_t result;
+
+    fill_pseudo_random(a, 11U);
+    fill_pseudo_random(b, 12U);
+    fill_pseudo_random(tiebreak, 13U);
+
+    hdc_counter_add(&s_counter, a);
+    hdc_counter_add(&s_counter, b);
+
+    /* Without a tie-break, disagreeing bits resolve to 0: result = a AND b */
+    hdc_counter_threshold(result, &s_counter, NULL);
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        TEST_ASSERT_EQUAL_HEX8((uint8_t)(a[i] & b[i]), result[i]);
+    }
+
+    /* With one, disagreeing bits come from the tie-break vector */
+    hdc_counter_threshold(result, &s_counter, tiebreak);
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        uint8_t agree = (uint8_t)~(a[i] ^ b[i]);
+        uint8_t expected = (uint8_t)((a[i] & agree) | (tiebreak[i] & (uint8_t)~agree));
+        TEST_ASSERT_EQUAL_HEX8(expected, result[i]);
+    }
+}
+
+/* ============================================================================
+ * Tracking Tests
+ * ============================================================================ */
+
+/**
+ * @brief Check one word position of a mask
+ */
+static bool mask_has(const hdc_counter_mask_t mask, hdc_index_t w)
+{
+    return (mask[w / 8U] & (uint8_t)(1U << (w % 8U))) != 0U;
+}
+
+void test_counter_tracked_marks_changed_words(void)
+{
+    hv_t ones;
+    hdc_counter_mask_t changed;
+    hdc_fill(ones, 0xFFU);
+
+    memset(changed, 0, sizeof(changed));
+    TEST_ASSERT_EQUAL_UINT16(HDC_COUNTER_WORDS,
+                             hdc_counter_add_tracked(&s_counter, ones, changed));
+    for (hdc_index_t w = 0U; w < HDC_COUNTER_WORDS; w++) {
+        TEST_ASSERT_TRUE(mask_has(changed, w));
+    }
+
+    for (uint16_t n = 0U; n < HDC_COUNTER_MAX; n++) {
+        hdc_counter_add(&s_counter, ones);
+    }
+
+    /* Saturated counters do not move, so nothing is marked */
+    memset(changed, 0, sizeof(changed));
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_counter_add_tracked(&s_counter, ones, changed));
+    for (hdc_index_t b = 0U; b < HDC_COUNTER_MASK_BYTES; b++) {
+        TEST_ASSERT_EQUAL_HEX8(0x00U, changed[b]);
+    }
+
+    /* Taking out a pattern with only the last dimension set moves only that
+     * counter (0 bits count up, but are saturated), so only the last word
+     * position is marked (a tail word if the width has one) */
+    hv_t last;
+    hdc_clear(last);
+    last[HV_BYTES - 1U] = 0x80U;
+    TEST_ASSERT_EQUAL_UINT16(1U, hdc_counter_sub_tracked(&s_counter, last, changed));
+    for (hdc_index_t w = 0U; w < HDC_COUNTER_WORDS; w++) {
+        TEST_ASSERT_EQUAL(w == (hdc_index_t)(HDC_COUNTER_WORDS - 1U), mask_has(changed, w));
+    }
+    TEST_ASSERT_EQUAL_UINT8(HDC_COUNTER_MAX - 1U,
+                            hdc_counter_get(&s_counter, (hdc_dist_t)(HV_DIMENSIONS - 1U)));
+}
+
+void test_counter_threshold_masked_patches_marked_words(void)
+{
+    hv_t pattern;
+    hv_t tiebreak;
+    hv_t full;
+    hv_t patched;
+    hdc_counter_mask_t mask;
+
+    fill_pseudo_random(pattern, 9U);
+    fill_pseudo_random(tiebreak, 10U);
+    hdc_counter_add(&s_counter, pattern);
+    hdc_counter_threshold(full, &s_counter, tiebreak);
+
+    /* Every other word position recomputed; the rest keep their 0xA5 fill */
+    memset(mask, 0, sizeof(mask));
+    for (uint16_t w = 0U; w < HDC_COUNTER_WORDS; w += 2U) {
+        mask[w / 8U] |= (uint8_t)(1U << (w % 8U));
+    }
+    hdc_fill(patched, 0xA5U);
+    hdc_counter_threshold_masked(patched, &s_counter, tiebreak, mask);
+
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        hdc_index_t w = (hdc_index_t)(i / HDC_WORD_BYTES);
+        TEST_ASSERT_EQUAL_HEX8(mask_has(mask, w) ? full[i] : 0xA5U, patched[i]);
+    }
+
+    /* A full mask reproduces hdc_counter_threshold() */
+    memset(mask, 0xFF, sizeof(mask));
+    hdc_counter_threshold_masked(patched, &s_counter, tiebreak, mask);
+    TEST_ASSERT_EQUAL_MEMORY(full, patched, HV_BYTES);
+}
+
+/* ============================================================================
+ * Reference Tests
+ * ============================================================================ */
+
+void test_counter_matches_per_bit_reference(void)
+{
+    static uint8_t reference[HV_DIMENSIONS];
+    hv_t pattern;
+    hv_t result;
+
+    memset(reference, HDC_COUNTER_INIT, sizeof(reference));
+
+    for (uint32_t n = 0U; n < 200U; n++) {
+        fill_pseudo_random(pattern, 0xC0FFEEU + n);
+        /* Bias runs of patterns so counters visit both saturation ends */
+        if ((n / 40U) % 2U == 0U) {
+            for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+                pattern[i] |= (uint8_t)(0x5AU ^ (uint8_t)i);
+            }
+        } else {
+            for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+                pattern[i] &= (uint8_t)(0x5AU ^ (uint8_t)i);
+            }
+        }
+
+        hdc_counter_add(&s_counter, pattern);
+
+        for (hdc_dist_t d = 0U; d < (hdc_dist_t)HV_DIMENSIONS; d++) {
+            if (get_bit(pattern, d) != 0U) {
+                if (reference[d] < HDC_COUNTER_MAX) {
+                    reference[d]++;
+                }
+            } else if (reference[d] > 0U) {
+                reference[d]--;
+            }
+        }
+    }
+
+    hdc_counter_threshold(result, &s_counter, NULL);
+    for (hdc_dist_t d = 0U; d < (hdc_dist_t)HV_DIMENSIONS; d++) {
+        TEST_ASSERT_EQUAL_UINT8(reference[d], hdc_counter_get(&s_counter, d));
+        TEST_ASSERT_EQUAL_UINT8((reference[d] > HDC_COUNTER_INIT) ? 1U : 0U,
+                                get_bit(result, d));
+    }
+}
+
+/* ============================================================================
+ * Capacity Tests
+ * ============================================================================ */
+
+void test_counter_bundle_outlasts_or(void)
+{
+    hv_t prototype;
+    hv_t sample;
+    hv_t or_bundle;
+    hv_t result;
+
+    fill_pseudo_random(prototype, 77U);
+    hdc_clear(or_bundle);
+
+    /* 64 noisy copies (~1/4 bits flipped each) of one prototype */
+    for (uint32_t n = 0U; n < 64U; n++) {
+        hdc_copy(sample, prototype);
+        add_noise(sample, 500U + n, 0xFFU);
+        hdc_counter_add(&s_counter, sample);
+        hdc_bundle(or_bundle, sample);
+    }
+
+    hdc_counter_threshold(result, &s_counter, NULL);
+
+    /* OR has drifted towards all ones; the majority stays close */
+    TEST_ASSERT_TRUE(hdc_hamming(or_bundle, prototype) > ((3U * HV_DIMENSIONS) / 8U));
+    TEST_ASSERT_TRUE(hdc_hamming(result, prototype) < (HV_DIMENSIONS / 8U));
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Counting tests */
+    RUN_TEST(test_counter_reset_is_tie);
+    RUN_TEST(test_counter_counts_up_and_down);
+    RUN_TEST(test_counter_saturates_high);
+    RUN_TEST(test_counter_saturates_low);
+    RUN_TEST(test_counter_sub_reverses_add);
+
+    /* Threshold tests */
+    RUN_TEST(test_counter_majority_of_three);
+    RUN_TEST(test_counter_tie_uses_tiebreak);
+
+    /* Tracking tests */
+    RUN_TEST(test_counter_tracked_marks_changed_words);
+    RUN_TEST(test_counter_threshold_masked_patches_marked_words);
+
+    /* Reference tests */
+    RUN_TEST(test_counter_matches_per_bit_reference);
+
+    /* Capacity tests */
+    RUN_TEST(test_counter_bundle_outlasts_or);
+
+    return UNITY_END();
+}
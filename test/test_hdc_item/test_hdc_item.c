@@ -0,0 +1,207 @@
+/**
+ * @file    test_hdc_item.c
+ * @brief   Unit Tests for the Seeded Item Memory
+ * @version 1.0.0
+ *
+ * @details Tests for on-demand basis / ID vector generation:
+ *          - Generator: known-answer vector, stream order, non-zero seeding
+ *          - Statistics: items are quasi-orthogonal, seeds are independent
+ *          - Encoding: seeded encoders equal encoding with stored vectors
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ *          The known-answer bytes pin the stream that the AVR and the
+ *          gateway must reproduce.
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_encode.h"
+#include "hdc/hdc_item.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TEST_SEED       0x12345678UL
+#define TEST_CHANNELS   12U     /* more than one HDC_ENCODE_CHANNEL_BLOCK */
+
+void setUp(void)
+{
+    /* Called before each test */
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/**
+ * @brief Largest distance from HV_DIMENSIONS / 2 expected between unrelated
+ *        vectors: five standard deviations (5 sqrt(D) / 2), kept below D / 2
+ *        so narrow widths still reject equal and complementary vectors
+ */
+static hdc_dist_t orthogonal_margin(void)
+{
+    uint32_t root = 0U;
+
+    while (((root + 1U) * (root + 1U)) <= (25UL * HV_DIMENSIONS)) {
+        root++;
+    }
+    root /= 2U;
+    return (hdc_dist_t)((root < (HV_DIMENSIONS / 2U)) ? root : ((HV_DIMENSIONS / 2U) - 1U));
+}
+
+/* ============================================================================
+ * Generator Tests
+ * ============================================================================ */
+
+void test_known_answer_vector(void)
+{
+#if (HV_BYTES >= 16U)
+    static const uint8_t expected[16] = {
+        0x4EU, 0x68U, 0xF7U, 0x7AU, 0x91U, 0x95U, 0x22U, 0x68U,
+        0xF9U, 0xB3U, 0x85U, 0x68U, 0x04U, 0x6CU, 0xA5U, 0x01U
+    };
+    hv_t hv;
+
+    TEST_ASSERT_EQUAL_HEX32(0x931A3330UL, hdc_item_seed(TEST_SEED, 3U));
+    hdc_item_generate(hv, TEST_SEED, 3U);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, hv, 16U);
+#else
+    TEST_IGNORE_MESSAGE("needs HV_DIMENSIONS >= 128");
+#endif
+}
+
+void test_stream_is_little_endian_words(void)
+{
+    hdc_item_stream_t stream;
+    hv_t hv;
+
+    hdc_item_generate(hv, TEST_SEED, 7U);
+    hdc_item_begin(&stream, TEST_SEED, 7U);
+
+    for (uint16_t i = 0U; i < HV_BYTES; i = (uint16_t)(i + 4U)) {
+        uint32_t word = hdc_item_next(&stream);
+        for (uint8_t k = 0U; (k < 4U) && ((i + k) < HV_BYTES); k++) {
+            TEST_ASSERT_EQUAL_HEX8((uint8_t)(word >> (8U * k)), hv[i + k]);
+        }
+    }
+}
+
+void test_seed_is_never_zero(void)
+{
+    /* (0, 0) mixes to the xorshift fixed point and is remapped */
+    TEST_ASSERT_EQUAL_HEX32(0x6D2B79F5UL, hdc_item_seed(0UL, 0U));
+
+    for (uint16_t id = 0U; id < 256U; id++) {
+        TEST_ASSERT_TRUE(hdc_item_seed(0UL, id) != 0UL);
+    }
+}
+
+/* ============================================================================
+ * Statistics Tests
+ * ============================================================================ */
+
+void test_items_are_quasi_orthogonal(void)
+{
+    hdc_dist_t margin = orthogonal_margin();
+    hv_t a, b;
+
+    for (hdc_item_id_t i = 0U; i < 8U; i++) {
+        hdc_item_generate(a, TEST_SEED, i);
+        for (hdc_item_id_t j = (hdc_item_id_t)(i + 1U); j < 8U; j++) {
+            hdc_item_generate(b, TEST_SEED, j);
+            hdc_dist_t d = hdc_hamming(a, b);
+            TEST_ASSERT_TRUE(d >= ((HV_DIMENSIONS / 2U) - margin));
+            TEST_ASSERT_TRUE(d <= ((HV_DIMENSIONS / 2U) + margin));
+        }
+    }
+}
+
+void test_seeds_give_independent_memories(void)
+{
+    hv_t a, b;
+
+    hdc_item_generate(a, TEST_SEED, 0U);
+    hdc_item_generate(b, TEST_SEED + 1UL, 0U);
+    TEST_ASSERT_TRUE(hdc_hamming(a, b) >= ((HV_DIMENSIONS / 2U) - orthogonal_margin()));
+
+    /* Regeneration is exact */
+    hdc_item_generate(b, TEST_SEED, 0U);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(a, b, HV_BYTES);
+}
+
+/* ============================================================================
+ * Seeded Encoding Tests
+ * ============================================================================ */
+
+void test_seeded_multi_channel_matches_stored_basis(void)
+{
+    hv_t basis[TEST_CHANNELS];
+    uint16_t values[TEST_CHANNELS];
+    hv_t expected, actual;
+
+    for (uint8_t ch = 0U; ch < TEST_CHANNELS; ch++) {
+        hdc_item_generate(basis[ch], TEST_SEED, ch);
+        values[ch] = (uint16_t)((ch * 211U) % (ADC_MAX + 1U));
+    }
+
+    for (uint8_t n = 0U; n <= TEST_CHANNELS; n++) {
+        hdc_fill(actual, 0xEEU);
+        hdc_encode_multi_channel(expected, values, n, (const hv_t*)basis);
+        hdc_encode_multi_channel_seeded(actual, values, n, TEST_SEED);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, HV_BYTES);
+    }
+}
+
+void test_seeded_levels_matches_stored_basis(void)
+{
+    hv_t basis[TEST_CHANNELS];
+    hdc_level_t levels[TEST_CHANNELS];
+    hv_t expected, actual;
+
+    for (uint8_t ch = 0U; ch < TEST_CHANNELS; ch++) {
+        hdc_item_generate(basis[ch], TEST_SEED, ch);
+        levels[ch] = (hdc_level_t)((ch * 37U) % (THERMO_LEVELS + 1U));
+    }
+
+    /* hdc_encode_levels() takes one block; the seeded form takes any count */
+    hdc_encode_levels(expected, levels, HDC_ENCODE_CHANNEL_BLOCK, (const hv_t*)basis);
+    hdc_encode_levels_seeded(actual, levels, HDC_ENCODE_CHANNEL_BLOCK, TEST_SEED);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, HV_BYTES);
+
+    hv_t tail;
+    hdc_encode_levels(tail, &levels[HDC_ENCODE_CHANNEL_BLOCK],
+                      (uint8_t)(TEST_CHANNELS - HDC_ENCODE_CHANNEL_BLOCK),
+                      (const hv_t*)&basis[HDC_ENCODE_CHANNEL_BLOCK]);
+    hdc_or(expected, expected, tail);
+    hdc_encode_levels_seeded(actual, levels, TEST_CHANNELS, TEST_SEED);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, HV_BYTES);
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Generator tests */
+    RUN_TEST(test_known_answer_vector);
+    RUN_TEST(test_stream_is_little_endian_words);
+    RUN_TEST(test_seed_is_never_zero);
+
+    /* Statistics tests */
+    RUN_TEST(test_items_are_quasi_orthogonal);
+    RUN_TEST(test_seeds_give_independent_memories);
+
+    /* Seeded encoding tests */
+    RUN_TEST(test_seeded_multi_channel_matches_stored_basis);
+    RUN_TEST(test_seeded_levels_matches_stored_basis);
+
+    return UNITY_END();
+}
@@ -0,0 +1,280 @@
+/**
+ * @file    test_hdc_learn.c
+ * @brief   Unit Tests for Online Retraining
+ * @version 1.0.0
+ *
+ * @details Tests for the perceptron-style retraining engine:
+ *          - Update: correct, missing and wrong predictions, invalid classes
+ *          - Cache: prototypes change only when queried, and then equal a
+ *            full threshold of the counters
+ *          - Retraining: a misclassified pattern is corrected without
+ *            losing the other class
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_counter.h"
+#include "hdc/hdc_am.h"
+#include "hdc/hdc_proto.h"
+#include "hdc/hdc_learn.h"
+#include "mock_hv.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TEST_CLASSES    3U
+
+static hv_t s_rows[TEST_CLASSES];
+static hdc_counter_t s_counters[TEST_CLASSES];
+static hdc_counter_mask_t s_stale[TEST_CLASSES];
+static hdc_counter_mask_t s_unsaved[TEST_CLASSES];
+static hdc_am_t s_am;
+static hdc_proto_t s_proto;
+static hdc_learn_t s_learn;
+
+/**
+ * @brief Check every prototype row against a full threshold of its counters
+ */
+static void assert_rows_match_counters(void)
+{
+    hv_t expected;
+
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        hdc_counter_threshold(expected, &s_counters[c], s_proto.tiebreak);
+        TEST_ASSERT_EQUAL_MEMORY(expected, s_rows[c], HV_BYTES);
+    }
+}
+
+void setUp(void)
+{
+    hv_t zero;
+    hdc_clear(zero);
+
+    hdc_am_init(&s_am, s_rows, TEST_CLASSES);
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        hdc_counter_reset(&s_counters[c]);
+        (void)hdc_am_add(&s_am, zero, NULL);
+    }
+    TEST_ASSERT_EQUAL(HDC_PROTO_OK,
+                      hdc_proto_init(&s_proto, &s_am, s_counters, s_stale, s_unsaved, NULL));
+    hdc_learn_init(&s_learn, &s_proto);
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/* ============================================================================
+ * Update Tests
+ * ============================================================================ */
+
+void test_learn_correct_prediction_changes_nothing(void)
+{
+    hv_t sample;
+    hdc_counter_t before[TEST_CLASSES];
+
+    fill_pseudo_random(sample, 3U);
+    (void)hdc_proto_refresh(&s_proto);
+    memcpy(before, s_counters, sizeof(before));
+
+    TEST_ASSERT_EQUAL(HDC_LEARN_OK, hdc_learn_update(&s_learn, sample, 2U, 2U));
+    TEST_ASSERT_EQUAL_MEMORY(before, s_counters, sizeof(before));
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_proto_refresh(&s_proto));
+    TEST_ASSERT_EQUAL_UINT32(0U, s_learn.updates);
+    TEST_ASSERT_EQUAL_UINT32(0U, s_learn.mistakes);
+}
+
+void test_learn_no_prediction_adds_to_label(void)
+{
+    hv_t sample;
+    hdc_counter_t expected;
+
+    fill_pseudo_random(sample, 4U);
+    hdc_counter_reset(&expected);
+    hdc_counter_add(&expected, sample);
+
+    TEST_ASSERT_EQUAL(HDC_LEARN_OK,
+                      hdc_learn_update(&s_learn, sample, 1U, (hdc_class_t)HDC_AM_CLASS_NONE));
+    TEST_ASSERT_EQUAL_MEMORY(&expected, &s_counters[1], sizeof(hdc_counter_t));
+    TEST_ASSERT_EQUAL_UINT32(1U, s_learn.updates);
+    TEST_ASSERT_EQUAL_UINT32(0U, s_learn.mistakes);
+}
+
+void test_learn_mistake_adds_and_subtracts(void)
+{
+    hv_t sample;
+    hdc_counter_t expected_label;
+    hdc_counter_t expected_predicted;
+    hdc_counter_t untouched = s_counters[2];
+
+    fill_pseudo_random(sample, 5U);
+    hdc_counter_reset(&expected_label);
+    hdc_counter_add(&expected_label, sample);
+    hdc_counter_reset(&expected_predicted);
+    hdc_counter_sub(&expected_predicted, sample);
+
+    TEST_ASSERT_EQUAL(HDC_LEARN_OK, hdc_learn_update(&s_learn, sample, 0U, 1U));
+    TEST_ASSERT_EQUAL_MEMORY(&expected_label, &s_counters[0], sizeof(hdc_counter_t));
+    TEST_ASSERT_EQUAL_MEMORY(&expected_predicted, &s_counters[1], sizeof(hdc_counter_t));
+    TEST_ASSERT_EQUAL_MEMORY(&untouched, &s_counters[2], sizeof(hdc_counter_t));
+    TEST_ASSERT_EQUAL_UINT32(1U, s_learn.updates);
+    TEST_ASSERT_EQUAL_UINT32(1U, s_learn.mistakes);
+}
+
+void test_learn_invalid_class_changes_nothing(void)
+{
+    hv_t sample;
+    hdc_counter_t before[TEST_CLASSES];
+
+    fill_pseudo_random(sample, 6U);
+    memcpy(before, s_counters, sizeof(before));
+
+    TEST_ASSERT_EQUAL(HDC_LEARN_ERROR_INVALID_CLASS,
+                      hdc_learn_update(&s_learn, sample, TEST_CLASSES, 0U));
+    TEST_ASSERT_EQUAL(HDC_LEARN_ERROR_INVALID_CLASS,
+                      hdc_learn_update(&s_learn, sample, 0U, TEST_CLASSES));
+    TEST_ASSERT_EQUAL_MEMORY(before, s_counters, sizeof(before));
+    TEST_ASSERT_EQUAL_UINT32(0U, s_learn.updates);
+}
+
+/* ============================================================================
+ * Cache Tests
+ * ============================================================================ */
+
+void test_learn_update_leaves_prototypes_until_refresh(void)
+{
+    hv_t sample;
+    hv_t stale[TEST_CLASSES];
+
+    (void)hdc_proto_refresh(&s_proto);
+    fill_pseudo_random(sample, 7U);
+    memcpy(stale, s_rows, sizeof(stale));
+
+    TEST_ASSERT_EQUAL(HDC_LEARN_OK, hdc_learn_update(&s_learn, sample, 2U, 0U));
+    TEST_ASSERT_EQUAL_MEMORY(stale, s_rows, sizeof(stale));
+
+    /* Only the two classes in the update are patched */
+    TEST_ASSERT_EQUAL_UINT16(2U, hdc_proto_refresh(&s_proto));
+    TEST_ASSERT_EQUAL_MEMORY(stale[1], s_rows[1], HV_BYTES);
+    assert_rows_match_counters();
+}
+
+void test_learn_lazy_refresh_matches_full_threshold(void)
+{
+    hv_t sample;
+    hv_t tiebreak;
+
+    fill_pseudo_random(tiebreak, 8U);
+    TEST_ASSERT_EQUAL(HDC_PROTO_OK,
+                      hdc_proto_init(&s_proto, &s_am, s_counters, s_stale, s_unsaved, tiebreak));
+
+    /* A long update stream with refreshes at irregular points */
+    for (uint32_t n = 0U; n < 300U; n++) {
+        fill_pseudo_random(sample, 1000U + n);
+        hdc_class_t label = (hdc_class_t)(n % TEST_CLASSES);
+        hdc_class_t predicted = (hdc_class_t)((n * 7U) % (TEST_CLASSES + 1U));
+        if (predicted == TEST_CLASSES) {
+            predicted = (hdc_class_t)HDC_AM_CLASS_NONE;
+        }
+        TEST_ASSERT_EQUAL(HDC_LEARN_OK, hdc_learn_update(&s_learn, sample, label, predicted));
+        if ((n % 5U) == 3U) {
+            (void)hdc_proto_refresh(&s_proto);
+            assert_rows_match_counters();
+        }
+    }
+    (void)hdc_proto_refresh(&s_proto);
+    assert_rows_match_counters();
+}
+
+/* ============================================================================
+ * Retraining Tests
+ * ============================================================================ */
+
+void test_learn_step_corrects_misclassified_pattern(void)
+{
+    hv_t base_a;
+    hv_t base_b;
+    hv_t sample;
+    hv_t hard;
+    hdc_am_match_t match;
+
+    fill_pseudo_random(base_a, 11U);
+    fill_pseudo_random(base_b, 12U);
+
+    /* Bootstrap classes 0 and 1 from noisy copies of their bases */
+    for (uint32_t n = 0U; n < 8U; n++) {
+        hdc_copy(sample, base_a);
+        add_noise(sample, 100U + n, 0xFFU);
+        (void)hdc_learn_update(&s_learn, sample, 0U, (hdc_class_t)HDC_AM_CLASS_NONE);
+        hdc_copy(sample, base_b);
+        add_noise(sample, 200U + n, 0xFFU);
+        (void)hdc_learn_update(&s_learn, sample, 1U, (hdc_class_t)HDC_AM_CLASS_NONE);
+    }
+
+    /* A class-1 pattern that lies closer to class 0: base_b with 5/8 of
+     * the bits where it differs from base_a taken from base_a, which holds
+     * at any width (class 2 is untrained and far from both) */
+    hdc_copy(hard, base_b);
+    hdc_dist_t take = (hdc_dist_t)((5U * hdc_hamming(base_a, base_b)) / 8U);
+    for (hdc_index_t i = 0U; (i < HV_BYTES) && (take > 0U); i++) {
+        for (uint8_t bit = 0x01U; (bit != 0U) && (take > 0U); bit = (uint8_t)(bit << 1U)) {
+            if (((hard[i] ^ base_a[i]) & bit) != 0U) {
+                hard[i] ^= bit;
+                take--;
+            }
+        }
+    }
+
+    TEST_ASSERT_EQUAL(HDC_LEARN_OK, hdc_learn_step(&s_learn, hard, 1U, &match));
+    TEST_ASSERT_EQUAL_UINT16(0U, match.class_id);
+
+    uint8_t steps = 1U;
+    do {
+        TEST_ASSERT_EQUAL(HDC_LEARN_OK, hdc_learn_step(&s_learn, hard, 1U, &match));
+        steps++;
+    } while ((match.class_id != 1U) && (steps < 20U));
+
+    TEST_ASSERT_EQUAL_UINT16(1U, match.class_id);
+    TEST_ASSERT_EQUAL_UINT32(s_learn.mistakes, (uint32_t)(steps - 1U));
+
+    /* Once it is learned, repeats no longer update */
+    uint32_t updates = s_learn.updates;
+    TEST_ASSERT_EQUAL(HDC_LEARN_OK, hdc_learn_step(&s_learn, hard, 1U, &match));
+    TEST_ASSERT_EQUAL_UINT16(1U, match.class_id);
+    TEST_ASSERT_EQUAL_UINT32(updates, s_learn.updates);
+
+    /* Class 0 still recognises its own pattern */
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_proto_query(&s_proto, base_a, &match));
+    TEST_ASSERT_EQUAL_UINT16(0U, match.class_id);
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Update tests */
+    RUN_TEST(test_learn_correct_prediction_changes_nothing);
+    RUN_TEST(test_learn_no_prediction_adds_to_label);
+    RUN_TEST(test_learn_mistake_adds_and_subtracts);
+    RUN_TEST(test_learn_invalid_class_changes_nothing);
+
+    /* Cache tests */
+    RUN_TEST(test_learn_update_leaves_prototypes_until_refresh);
+    RUN_TEST(test_learn_lazy_refresh_matches_full_threshold);
+
+    /* Retraining tests */
+    RUN_TEST(test_learn_step_corrects_misclassified_pattern);
+
+    return UNITY_END();
+}
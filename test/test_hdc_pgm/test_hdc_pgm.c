@@ -0,0 +1,320 @@
+/**
+ * @file    test_hdc_pgm.c
+ * @brief   Unit Tests for Flash-Resident Operands
+ * @version 1.0.0
+ *
+ * @details Tests for the _P variants and the flash associative memory:
+ *          - Core: copy, bind and (bounded) distance against flash vectors
+ *          - Encoding: _P encoders match the SRAM encoders, any channel count,
+ *            including the generated fixed-count encoders
+ *          - Associative memory: flash rows give the same results as SRAM
+ *            rows and reject writes
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ *          On the host HDC_FLASH is empty, so these check that each _P call
+ *          is a drop-in for its SRAM counterpart; the tables are declared
+ *          exactly as firmware would declare them.
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_encode.h"
+#include "hdc/hdc_am.h"
+#include "hdc/hdc_pgm.h"
+#include "hdc/hdc_encode_fixed.h"
+#include "mock_hv.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TEST_CHANNELS   12U     /* more than one HDC_ENCODE_CHANNEL_BLOCK */
+#define TEST_CLASSES    5U
+
+/* A row from its first 8 bytes: wider vectors pad with zeros, narrower
+ * ones keep the first HV_BYTES */
+#if (HV_BYTES >= 8U)
+#define TEST_ROW(a, b, c, d, e, f, g, h)    {a, b, c, d, e, f, g, h}
+#elif (HV_BYTES == 7U)
+#define TEST_ROW(a, b, c, d, e, f, g, h)    {a, b, c, d, e, f, g}
+#elif (HV_BYTES == 6U)
+#define TEST_ROW(a, b, c, d, e, f, g, h)    {a, b, c, d, e, f}
+#elif (HV_BYTES == 5U)
+#define TEST_ROW(a, b, c, d, e, f, g, h)    {a, b, c, d, e}
+#elif (HV_BYTES == 4U)
+#define TEST_ROW(a, b, c, d, e, f, g, h)    {a, b, c, d}
+#elif (HV_BYTES == 3U)
+#define TEST_ROW(a, b, c, d, e, f, g, h)    {a, b, c}
+#elif (HV_BYTES == 2U)
+#define TEST_ROW(a, b, c, d, e, f, g, h)    {a, b}
+#else
+#define TEST_ROW(a, b, c, d, e, f, g, h)    {a}
+#endif
+
+static const hv_t s_basis_P[TEST_CHANNELS] HDC_FLASH = {
+    TEST_ROW(0xA5U, 0x4DU, 0xCAU, 0x18U, 0x25U, 0x30U, 0xBBU, 0x1DU),
+    TEST_ROW(0x6DU, 0x13U, 0x2CU, 0xDEU, 0xD6U, 0x23U, 0x7BU, 0x2EU),
+    TEST_ROW(0xD9U, 0x1EU, 0x3FU, 0x72U, 0x1FU, 0xCBU, 0x19U, 0x71U),
+    TEST_ROW(0x17U, 0x44U, 0x94U, 0xD6U, 0x49U, 0x3CU, 0x9DU, 0x5CU),
+    TEST_ROW(0x34U, 0x60U, 0xBEU, 0x31U, 0x20U, 0x1EU, 0x69U, 0xFEU),
+    TEST_ROW(0xDAU, 0xA0U, 0xEEU, 0xE8U, 0xB9U, 0x99U, 0x7FU, 0x5CU),
+    TEST_ROW(0x7CU, 0x29U, 0x99U, 0xFDU, 0xAFU, 0xE5U, 0x93U, 0x25U),
+    TEST_ROW(0x3CU, 0xD6U, 0x54U, 0xAFU, 0x4DU, 0xFAU, 0xD7U, 0x14U),
+    TEST_ROW(0x27U, 0xA0U, 0xAEU, 0xB3U, 0xFEU, 0xE9U, 0x23U, 0x2FU),
+    TEST_ROW(0x8AU, 0xF2U, 0x21U, 0x1FU, 0x9EU, 0xE4U, 0x91U, 0xC5U),
+    TEST_ROW(0xB1U, 0x0BU, 0xECU, 0xB5U, 0x56U, 0x3BU, 0xFCU, 0x1EU),
+    TEST_ROW(0x6FU, 0x93U, 0x42U, 0x7EU, 0xCBU, 0xC8U, 0xFEU, 0x29U)
+};
+
+static const hv_t s_model_P[TEST_CLASSES] HDC_FLASH = {
+    TEST_ROW(0x55U, 0xE5U, 0xCDU, 0x8EU, 0x46U, 0xDCU, 0x8EU, 0xD4U),
+    TEST_ROW(0xB7U, 0xC2U, 0x76U, 0x4DU, 0x2AU, 0x5AU, 0x4DU, 0x76U),
+    TEST_ROW(0x77U, 0x06U, 0xF8U, 0x5DU, 0x86U, 0x90U, 0x02U, 0x4AU),
+    TEST_ROW(0xD6U, 0xBDU, 0xA3U, 0x40U, 0x1BU, 0xE9U, 0xC8U, 0xCBU),
+    TEST_ROW(0xCCU, 0xC9U, 0x35U, 0xF6U, 0xCDU, 0x1FU, 0x61U, 0x22U)
+};
+
+/* SRAM copies, the reference for every _P result */
+static hv_t s_basis[TEST_CHANNELS];
+static hv_t s_model[TEST_CLASSES];
+
+void setUp(void)
+{
+    for (uint8_t ch = 0U; ch < TEST_CHANNELS; ch++) {
+        hdc_copy_P(s_basis[ch], s_basis_P[ch]);
+    }
+    for (uint8_t c = 0U; c < TEST_CLASSES; c++) {
+        hdc_copy_P(s_model[c], s_model_P[c]);
+    }
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/* ============================================================================
+ * Core Tests
+ * ============================================================================ */
+
+void test_copy_P_reads_whole_vector(void)
+{
+    TEST_ASSERT_EQUAL_HEX8(0xA5U, s_basis[0][0]);
+#if (HV_BYTES >= 8U)
+    TEST_ASSERT_EQUAL_HEX8(0x1DU, s_basis[0][7]);
+    TEST_ASSERT_EQUAL_HEX8(0x29U, s_basis[TEST_CHANNELS - 1U][7]);
+#endif
+#if (HV_BYTES > 8U)
+    TEST_ASSERT_EQUAL_HEX8(0x00U, s_basis[0][HV_BYTES - 1U]);
+#endif
+}
+
+void test_xor_P_matches_xor(void)
+{
+    hv_t a, expected, actual;
+
+    fill_pseudo_random(a, 11U);
+    hdc_xor(expected, a, s_basis[3]);
+    hdc_xor_P(actual, a, s_basis_P[3]);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, HV_BYTES);
+
+    /* In place, as used when binding a query */
+    hdc_xor_P(a, a, s_basis_P[3]);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, a, HV_BYTES);
+}
+
+void test_hamming_P_matches_hamming(void)
+{
+    hv_t a;
+
+    fill_pseudo_random(a, 23U);
+    for (uint8_t c = 0U; c < TEST_CLASSES; c++) {
+        hdc_dist_t expected = hdc_hamming(a, s_model[c]);
+        TEST_ASSERT_EQUAL(expected, hdc_hamming_P(a, s_model_P[c]));
+
+        /* Exact at or below the bound, above it once the bound is passed */
+        TEST_ASSERT_EQUAL(expected, hdc_hamming_bounded_P(a, s_model_P[c], expected));
+        if (expected > 0U) {
+            TEST_ASSERT_TRUE(hdc_hamming_bounded_P(a, s_model_P[c], (hdc_dist_t)(expected - 1U)) >
+                             (hdc_dist_t)(expected - 1U));
+        }
+    }
+}
+
+/* ============================================================================
+ * Encoding Tests
+ * ============================================================================ */
+
+void test_level_bind_P_matches_level_bind(void)
+{
+    hv_t expected, actual;
+
+    for (uint16_t level = 0U; level <= THERMO_LEVELS; level = (uint16_t)(level + 3U)) {
+        hdc_level_bind(expected, (hdc_level_t)level, s_basis[5]);
+        hdc_level_bind_P(actual, (hdc_level_t)level, s_basis_P[5]);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, HV_BYTES);
+    }
+}
+
+void test_encode_multi_channel_P_matches(void)
+{
+    uint16_t values[TEST_CHANNELS];
+    hv_t expected, actual;
+
+    for (uint8_t ch = 0U; ch < TEST_CHANNELS; ch++) {
+        values[ch] = (uint16_t)((ch * 97U) % (ADC_MAX + 1U));
+    }
+
+    for (uint8_t n = 0U; n <= TEST_CHANNELS; n++) {
+        hdc_fill(actual, 0xEEU);
+        hdc_encode_multi_channel(expected, values, n, (const hv_t*)s_basis);
+        hdc_encode_multi_channel_P(actual, values, n, s_basis_P);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, HV_BYTES);
+    }
+}
+
+void test_encode_levels_P_matches(void)
+{
+    hdc_level_t levels[HDC_ENCODE_CHANNEL_BLOCK];
+    hv_t expected, actual;
+
+    for (uint8_t ch = 0U; ch < HDC_ENCODE_CHANNEL_BLOCK; ch++) {
+        levels[ch] = hdc_level_from_adc((uint16_t)(ch * 131U));
+    }
+
+    hdc_encode_levels(expected, levels, HDC_ENCODE_CHANNEL_BLOCK, (const hv_t*)s_basis);
+    hdc_encode_levels_P(actual, levels, HDC_ENCODE_CHANNEL_BLOCK, s_basis_P);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, HV_BYTES);
+}
+
+HDC_ENCODE_DEFINE_FIXED_P(encode_fixed_P, TEST_CHANNELS, ADC_MAX)
+
+void test_fixed_encoder_P_matches(void)
+{
+    uint16_t values[TEST_CHANNELS];
+    hdc_level_t levels[TEST_CHANNELS];
+    hv_t expected, actual;
+
+    for (uint8_t ch = 0U; ch < TEST_CHANNELS; ch++) {
+        values[ch] = (uint16_t)((ch * 89U) % (ADC_MAX + 1U));
+        levels[ch] = hdc_level_from_adc(values[ch]);
+    }
+
+    hdc_encode_multi_channel_P(expected, values, TEST_CHANNELS, s_basis_P);
+    hdc_fill(actual, 0xEEU);
+    encode_fixed_P(actual, values, s_basis_P);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, HV_BYTES);
+
+    hdc_fill(actual, 0xEEU);
+    encode_fixed_P_levels(actual, levels, s_basis_P);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, HV_BYTES);
+}
+
+/* ============================================================================
+ * Associative Memory Tests
+ * ============================================================================ */
+
+void test_flash_am_matches_sram_am(void)
+{
+    hdc_am_t ram, flash;
+    hdc_am_match_t ram_best, flash_best;
+    hdc_am_match_t ram_topk[3], flash_topk[3];
+    hv_t query;
+
+    hdc_am_init(&ram, s_model, TEST_CLASSES);
+    ram.count = TEST_CLASSES;
+    hdc_am_init_flash(&flash, s_model_P, TEST_CLASSES);
+    TEST_ASSERT_EQUAL_UINT16(TEST_CLASSES, flash.count);
+
+    for (uint32_t seed = 1U; seed <= 8U; seed++) {
+        fill_pseudo_random(query, seed);
+
+        for (uint8_t mode = 0U; mode < 2U; mode++) {
+            hdc_am_set_search(&ram, (hdc_am_search_t)mode);
+            hdc_am_set_search(&flash, (hdc_am_search_t)mode);
+
+            TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&ram, query, &ram_best));
+            TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&flash, query, &flash_best));
+            TEST_ASSERT_EQUAL_UINT16(ram_best.class_id, flash_best.class_id);
+            TEST_ASSERT_EQUAL(ram_best.distance, flash_best.distance);
+
+            TEST_ASSERT_EQUAL_UINT8(3U, hdc_am_query_topk(&ram, query, ram_topk, 3U));
+            TEST_ASSERT_EQUAL_UINT8(3U, hdc_am_query_topk(&flash, query, flash_topk, 3U));
+            for (uint8_t i = 0U; i < 3U; i++) {
+                TEST_ASSERT_EQUAL_UINT16(ram_topk[i].class_id, flash_topk[i].class_id);
+                TEST_ASSERT_EQUAL(ram_topk[i].distance, flash_topk[i].distance);
+            }
+        }
+    }
+}
+
+void test_flash_am_query_levels_matches(void)
+{
+    hdc_am_t ram, flash;
+    hdc_level_t levels[4] = {10U, 40U, 90U, 120U};
+    hdc_dist_t ram_dist[TEST_CLASSES], flash_dist[TEST_CLASSES];
+    hdc_am_match_t ram_best, flash_best;
+
+    hdc_am_init(&ram, s_model, TEST_CLASSES);
+    ram.count = TEST_CLASSES;
+    hdc_am_init_flash(&flash, s_model_P, TEST_CLASSES);
+
+    for (uint8_t ch = 0U; ch < 4U; ch++) {
+        levels[ch] = (hdc_level_t)(levels[ch] % (THERMO_LEVELS + 1U));
+    }
+
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query_levels(&ram, levels, 4U, (const hv_t*)s_basis,
+                                                     ram_dist, &ram_best));
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query_levels(&flash, levels, 4U, (const hv_t*)s_basis,
+                                                     flash_dist, &flash_best));
+    TEST_ASSERT_EQUAL_MEMORY(ram_dist, flash_dist, sizeof(ram_dist));
+    TEST_ASSERT_EQUAL_UINT16(ram_best.class_id, flash_best.class_id);
+}
+
+void test_flash_am_is_read_only(void)
+{
+    hdc_am_t flash;
+    hv_t hv;
+
+    hdc_am_init_flash(&flash, s_model_P, TEST_CLASSES);
+    hdc_clear(hv);
+
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_READ_ONLY, hdc_am_add(&flash, hv, NULL));
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_READ_ONLY, hdc_am_set(&flash, 0U, hv));
+    TEST_ASSERT_NULL(hdc_am_get(&flash, 0U));
+
+    /* Rows are still readable by copy */
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_read(&flash, 2U, hv));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(s_model[2], hv, HV_BYTES);
+    TEST_ASSERT_EQUAL(HDC_AM_ERROR_INVALID_CLASS, hdc_am_read(&flash, TEST_CLASSES, hv));
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Core tests */
+    RUN_TEST(test_copy_P_reads_whole_vector);
+    RUN_TEST(test_xor_P_matches_xor);
+    RUN_TEST(test_hamming_P_matches_hamming);
+
+    /* Encoding tests */
+    RUN_TEST(test_level_bind_P_matches_level_bind);
+    RUN_TEST(test_encode_multi_channel_P_matches);
+    RUN_TEST(test_fixed_encoder_P_matches);
+    RUN_TEST(test_encode_levels_P_matches);
+
+    /* Associative memory tests */
+    RUN_TEST(test_flash_am_matches_sram_am);
+    RUN_TEST(test_flash_am_query_levels_matches);
+    RUN_TEST(test_flash_am_is_read_only);
+
+    return UNITY_END();
+}
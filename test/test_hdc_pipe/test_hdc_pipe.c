@@ -0,0 +1,394 @@
+/**
+ * @file    test_hdc_pipe.c
+ * @brief   Unit Tests for the Batched Sample Pipeline
+ * @version 1.0.0
+ *
+ * @details Tests for the sample / encode / classify / result stages:
+ *          - Setup: invalid configurations are refused
+ *          - Sample: window averages and tags, short samples
+ *          - Stages: each stage waits for the one before it, takes at most
+ *            one batch, and matches the unpipelined encode and search
+ *          - Back-pressure: a full ring discards and counts windows without
+ *            touching the queued ones
+ *          - Threads: a sampler on another thread hands every window over
+ *            intact
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <unity.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_encode.h"
+#include "hdc/hdc_item.h"
+#include "hdc/hdc_am.h"
+#include "hdc/hdc_pipe.h"
+#include "mock_hv.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TEST_DEPTH      4U
+#define TEST_BATCH      3U
+#define TEST_CHANNELS   2U
+#define TEST_WINDOW     2U
+#define TEST_CLASSES    3U
+#define TEST_SEED       0x12345678UL
+
+static uint16_t s_values[TEST_DEPTH * TEST_CHANNELS];
+static hv_t s_queries[TEST_DEPTH];
+static hdc_am_match_t s_matches[TEST_DEPTH];
+static uint8_t s_tags[TEST_DEPTH];
+static hdc_pipe_config_t s_config;
+static hdc_pipe_t s_pipe;
+
+static hv_t s_rows[TEST_CLASSES];
+static hdc_am_t s_am;
+
+/**
+ * @brief Put one whole window whose every sample is (a, b)
+ */
+static hdc_pipe_status_t put_window(uint16_t a, uint16_t b, uint8_t tag)
+{
+    const uint16_t sample[TEST_CHANNELS] = {a, b};
+    hdc_pipe_status_t status = HDC_PIPE_OK;
+
+    for (uint8_t s = 0U; s < TEST_WINDOW; s++) {
+        status = hdc_pipe_put(&s_pipe, sample, TEST_CHANNELS, tag);
+    }
+    return status;
+}
+
+/**
+ * @brief Query hypervector of a window encoded outside the pipeline
+ */
+static void encode_direct(hv_t query, uint16_t a, uint16_t b)
+{
+    const hdc_level_t levels[TEST_CHANNELS] = {hdc_level_from_adc(a), hdc_level_from_adc(b)};
+
+    hdc_encode_levels_seeded(query, levels, TEST_CHANNELS, TEST_SEED);
+}
+
+void setUp(void)
+{
+    hv_t row;
+
+    s_config.values = s_values;
+    s_config.queries = s_queries;
+    s_config.matches = s_matches;
+    s_config.tags = s_tags;
+    s_config.level = hdc_level_from_adc;
+    s_config.item_seed = TEST_SEED;
+    s_config.depth = TEST_DEPTH;
+    s_config.batch = TEST_BATCH;
+    s_config.num_channels = TEST_CHANNELS;
+    s_config.window = TEST_WINDOW;
+    TEST_ASSERT_EQUAL(HDC_PIPE_OK, hdc_pipe_init(&s_pipe, &s_config));
+
+    hdc_am_init(&s_am, s_rows, TEST_CLASSES);
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        fill_pseudo_random(row, 100U + c);
+        (void)hdc_am_add(&s_am, row, NULL);
+    }
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/* ============================================================================
+ * Setup Tests
+ * ============================================================================ */
+
+void test_pipe_init_rejects_invalid_config(void)
+{
+    hdc_pipe_config_t config = s_config;
+
+    config.depth = 6U;
+    TEST_ASSERT_EQUAL(HDC_PIPE_ERROR_INVALID, hdc_pipe_init(&s_pipe, &config));
+    config.depth = 0U;
+    TEST_ASSERT_EQUAL(HDC_PIPE_ERROR_INVALID, hdc_pipe_init(&s_pipe, &config));
+
+    config = s_config;
+    config.batch = TEST_DEPTH + 1U;
+    TEST_ASSERT_EQUAL(HDC_PIPE_ERROR_INVALID, hdc_pipe_init(&s_pipe, &config));
+    config.batch = 0U;
+    TEST_ASSERT_EQUAL(HDC_PIPE_ERROR_INVALID, hdc_pipe_init(&s_pipe, &config));
+
+    config = s_config;
+    config.num_channels = HDC_PIPE_MAX_CHANNELS + 1U;
+    TEST_ASSERT_EQUAL(HDC_PIPE_ERROR_INVALID, hdc_pipe_init(&s_pipe, &config));
+
+    config = s_config;
+    config.window = 0U;
+    TEST_ASSERT_EQUAL(HDC_PIPE_ERROR_INVALID, hdc_pipe_init(&s_pipe, &config));
+
+    config = s_config;
+    config.level = NULL;
+    TEST_ASSERT_EQUAL(HDC_PIPE_ERROR_INVALID, hdc_pipe_init(&s_pipe, &config));
+}
+
+/* ============================================================================
+ * Sample Tests
+ * ============================================================================ */
+
+void test_pipe_put_averages_window(void)
+{
+    const uint16_t first[TEST_CHANNELS] = {100U, 901U};
+    const uint16_t second[TEST_CHANNELS] = {300U, 1000U};
+    hdc_pipe_result_t result;
+
+    TEST_ASSERT_EQUAL(HDC_PIPE_OK, hdc_pipe_put(&s_pipe, first, TEST_CHANNELS, 1U));
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_pipe_pending(&s_pipe));
+    TEST_ASSERT_EQUAL(HDC_PIPE_OK, hdc_pipe_put(&s_pipe, second, TEST_CHANNELS, 7U));
+    TEST_ASSERT_EQUAL_UINT8(1U, hdc_pipe_pending(&s_pipe));
+
+    TEST_ASSERT_EQUAL_UINT8(1U, hdc_pipe_encode(&s_pipe));
+    TEST_ASSERT_EQUAL_UINT8(1U, hdc_pipe_classify(&s_pipe, &s_am));
+    TEST_ASSERT_TRUE(hdc_pipe_peek(&s_pipe, &result));
+    TEST_ASSERT_EQUAL_UINT16(200U, result.values[0]);
+    TEST_ASSERT_EQUAL_UINT16(950U, result.values[1]);
+    TEST_ASSERT_EQUAL_UINT8(7U, result.tag);
+}
+
+void test_pipe_put_ignores_short_sample(void)
+{
+    const uint16_t sample[1] = {500U};
+
+    TEST_ASSERT_EQUAL(HDC_PIPE_ERROR_CHANNELS, hdc_pipe_put(&s_pipe, sample, 1U, 0U));
+    TEST_ASSERT_EQUAL_UINT8(0U, s_pipe.samples);
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_pipe_pending(&s_pipe));
+}
+
+/* ============================================================================
+ * Stage Tests
+ * ============================================================================ */
+
+void test_pipe_stages_wait_for_previous_stage(void)
+{
+    hdc_pipe_result_t result;
+
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_pipe_encode(&s_pipe));
+    TEST_ASSERT_EQUAL(HDC_PIPE_OK, put_window(10U, 20U, 0U));
+
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_pipe_classify(&s_pipe, &s_am));
+    TEST_ASSERT_FALSE(hdc_pipe_peek(&s_pipe, &result));
+    TEST_ASSERT_EQUAL_UINT8(1U, hdc_pipe_encode(&s_pipe));
+
+    TEST_ASSERT_FALSE(hdc_pipe_peek(&s_pipe, &result));
+    TEST_ASSERT_FALSE(hdc_pipe_release(&s_pipe));
+    TEST_ASSERT_EQUAL_UINT8(1U, hdc_pipe_classify(&s_pipe, &s_am));
+
+    TEST_ASSERT_TRUE(hdc_pipe_peek(&s_pipe, &result));
+    TEST_ASSERT_TRUE(hdc_pipe_release(&s_pipe));
+    TEST_ASSERT_FALSE(hdc_pipe_peek(&s_pipe, &result));
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_pipe_pending(&s_pipe));
+}
+
+void test_pipe_stages_take_one_batch(void)
+{
+    for (uint8_t w = 0U; w < TEST_DEPTH; w++) {
+        TEST_ASSERT_EQUAL(HDC_PIPE_OK, put_window(w, w, w));
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(TEST_BATCH, hdc_pipe_encode(&s_pipe));
+    TEST_ASSERT_EQUAL_UINT8(TEST_DEPTH - TEST_BATCH, hdc_pipe_encode(&s_pipe));
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_pipe_encode(&s_pipe));
+
+    TEST_ASSERT_EQUAL_UINT8(TEST_BATCH, hdc_pipe_classify(&s_pipe, &s_am));
+    TEST_ASSERT_EQUAL_UINT8(TEST_DEPTH - TEST_BATCH, hdc_pipe_classify(&s_pipe, &s_am));
+    TEST_ASSERT_EQUAL_UINT8(0U, hdc_pipe_classify(&s_pipe, &s_am));
+}
+
+void test_pipe_matches_unpipelined_search(void)
+{
+    hdc_pipe_result_t result;
+    hdc_am_match_t expected;
+    hv_t query;
+
+    /* Batches of three over a four-slot ring: most runs wrap */
+    for (uint16_t w = 0U; w < 40U; w++) {
+        uint16_t a = (uint16_t)((w * 97U) % 1024U);
+        uint16_t b = (uint16_t)((w * 331U + 17U) % 1024U);
+
+        TEST_ASSERT_EQUAL(HDC_PIPE_OK, put_window(a, b, (uint8_t)w));
+        if ((w % TEST_BATCH) != (TEST_BATCH - 1U)) {
+            continue;
+        }
+
+        (void)hdc_pipe_encode(&s_pipe);
+        (void)hdc_pipe_classify(&s_pipe, &s_am);
+        for (uint16_t n = (uint16_t)(w + 1U - TEST_BATCH); n <= w; n++) {
+            TEST_ASSERT_TRUE(hdc_pipe_peek(&s_pipe, &result));
+            TEST_ASSERT_EQUAL_UINT8((uint8_t)n, result.tag);
+
+            encode_direct(query, (uint16_t)((n * 97U) % 1024U),
+                          (uint16_t)((n * 331U + 17U) % 1024U));
+            TEST_ASSERT_EQUAL_MEMORY(query, result.query, HV_BYTES);
+            TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_am_query(&s_am, query, &expected));
+            TEST_ASSERT_EQUAL_UINT16(expected.class_id, result.match.class_id);
+            TEST_ASSERT_EQUAL_UINT16(expected.distance, result.match.distance);
+            TEST_ASSERT_TRUE(hdc_pipe_release(&s_pipe));
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT16(0U, s_pipe.dropped);
+}
+
+void test_pipe_classify_without_model_passes_windows_on(void)
+{
+    hdc_am_t empty;
+    hv_t rows[1];
+    hdc_pipe_result_t result;
+
+    hdc_am_init(&empty, rows, 1U);
+    TEST_ASSERT_EQUAL(HDC_PIPE_OK, put_window(1U, 2U, 0U));
+    TEST_ASSERT_EQUAL(HDC_PIPE_OK, put_window(3U, 4U, 0U));
+    (void)hdc_pipe_encode(&s_pipe);
+
+    s_pipe.config.batch = 1U;
+    TEST_ASSERT_EQUAL_UINT8(1U, hdc_pipe_classify(&s_pipe, NULL));
+    TEST_ASSERT_EQUAL_UINT8(1U, hdc_pipe_classify(&s_pipe, &empty));
+
+    for (uint8_t n = 0U; n < 2U; n++) {
+        TEST_ASSERT_TRUE(hdc_pipe_peek(&s_pipe, &result));
+        TEST_ASSERT_EQUAL_UINT16(HDC_AM_CLASS_NONE, result.match.class_id);
+        TEST_ASSERT_EQUAL_UINT16(HV_DIMENSIONS, result.match.distance);
+        TEST_ASSERT_TRUE(hdc_pipe_release(&s_pipe));
+    }
+}
+
+/* ============================================================================
+ * Back-Pressure Tests
+ * ============================================================================ */
+
+void test_pipe_full_ring_drops_new_windows(void)
+{
+    hdc_pipe_result_t result;
+
+    for (uint8_t w = 0U; w < TEST_DEPTH; w++) {
+        TEST_ASSERT_EQUAL(HDC_PIPE_OK, put_window(w, w, w));
+    }
+    TEST_ASSERT_EQUAL_UINT8(TEST_DEPTH, hdc_pipe_pending(&s_pipe));
+
+    /* Nothing is released: later windows are counted and discarded */
+    TEST_ASSERT_EQUAL(HDC_PIPE_ERROR_FULL, put_window(999U, 999U, 99U));
+    TEST_ASSERT_EQUAL(HDC_PIPE_ERROR_FULL, put_window(999U, 999U, 99U));
+    TEST_ASSERT_EQUAL_UINT16(2U, s_pipe.dropped);
+    TEST_ASSERT_EQUAL_UINT8(TEST_DEPTH, hdc_pipe_pending(&s_pipe));
+
+    while (hdc_pipe_encode(&s_pipe) != 0U) {
+    }
+    while (hdc_pipe_classify(&s_pipe, &s_am) != 0U) {
+    }
+    TEST_ASSERT_TRUE(hdc_pipe_peek(&s_pipe, &result));
+    TEST_ASSERT_EQUAL_UINT8(0U, result.tag);
+    TEST_ASSERT_EQUAL_UINT16(0U, result.values[0]);
+    TEST_ASSERT_TRUE(hdc_pipe_release(&s_pipe));
+
+    /* One slot back: the next window is queued behind the others */
+    TEST_ASSERT_EQUAL(HDC_PIPE_OK, put_window(50U, 60U, 42U));
+    for (uint8_t w = 1U; w < TEST_DEPTH; w++) {
+        TEST_ASSERT_TRUE(hdc_pipe_peek(&s_pipe, &result));
+        TEST_ASSERT_EQUAL_UINT8(w, result.tag);
+        TEST_ASSERT_EQUAL_UINT16(w, result.values[1]);
+        TEST_ASSERT_TRUE(hdc_pipe_release(&s_pipe));
+    }
+    TEST_ASSERT_FALSE(hdc_pipe_peek(&s_pipe, &result));
+    TEST_ASSERT_EQUAL_UINT8(1U, hdc_pipe_encode(&s_pipe));
+    TEST_ASSERT_EQUAL_UINT8(1U, hdc_pipe_classify(&s_pipe, &s_am));
+    TEST_ASSERT_TRUE(hdc_pipe_peek(&s_pipe, &result));
+    TEST_ASSERT_EQUAL_UINT8(42U, result.tag);
+    TEST_ASSERT_EQUAL_UINT16(60U, result.values[1]);
+}
+
+/* ============================================================================
+ * Thread Tests
+ * ============================================================================ */
+
+#define TEST_THREAD_WINDOWS 2000U
+
+/**
+ * @brief Sampler thread: TEST_THREAD_WINDOWS windows, each retried until
+ *        queued; window n holds (n, n ^ 0x3FF) and tag n
+ */
+static void* sampler_thread(void* arg)
+{
+    (void)arg;
+    for (uint16_t n = 0U; n < TEST_THREAD_WINDOWS; n++) {
+        uint16_t a = (uint16_t)(n & 0x3FFU);
+        while (put_window(a, (uint16_t)(a ^ 0x3FFU), (uint8_t)n) == HDC_PIPE_ERROR_FULL) {
+            (void)sched_yield();
+        }
+    }
+    return NULL;
+}
+
+void test_pipe_sampler_on_another_thread(void)
+{
+    pthread_t thread;
+    hdc_pipe_result_t result;
+    hv_t query;
+    uint16_t received = 0U;
+
+    TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, sampler_thread, NULL));
+    while (received < TEST_THREAD_WINDOWS) {
+        (void)hdc_pipe_encode(&s_pipe);
+        (void)hdc_pipe_classify(&s_pipe, &s_am);
+        if (!hdc_pipe_peek(&s_pipe, &result)) {
+            (void)sched_yield();
+            continue;
+        }
+
+        uint16_t a = (uint16_t)(received & 0x3FFU);
+        TEST_ASSERT_EQUAL_UINT8((uint8_t)received, result.tag);
+        TEST_ASSERT_EQUAL_UINT16(a, result.values[0]);
+        TEST_ASSERT_EQUAL_UINT16(a ^ 0x3FFU, result.values[1]);
+        if ((received % 97U) == 0U) {
+            encode_direct(query, a, (uint16_t)(a ^ 0x3FFU));
+            TEST_ASSERT_EQUAL_MEMORY(query, result.query, HV_BYTES);
+        }
+        TEST_ASSERT_TRUE(hdc_pipe_release(&s_pipe));
+        received++;
+    }
+    TEST_ASSERT_EQUAL(0, pthread_join(thread, NULL));
+    TEST_ASSERT_FALSE(hdc_pipe_peek(&s_pipe, &result));
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Setup tests */
+    RUN_TEST(test_pipe_init_rejects_invalid_config);
+
+    /* Sample tests */
+    RUN_TEST(test_pipe_put_averages_window);
+    RUN_TEST(test_pipe_put_ignores_short_sample);
+
+    /* Stage tests */
+    RUN_TEST(test_pipe_stages_wait_for_previous_stage);
+    RUN_TEST(test_pipe_stages_take_one_batch);
+    RUN_TEST(test_pipe_matches_unpipelined_search);
+    RUN_TEST(test_pipe_classify_without_model_passes_windows_on);
+
+    /* Back-pressure tests */
+    RUN_TEST(test_pipe_full_ring_drops_new_windows);
+
+    /* Thread tests */
+    RUN_TEST(test_pipe_sampler_on_another_thread);
+
+    return UNITY_END();
+}
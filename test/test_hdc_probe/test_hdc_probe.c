@@ -0,0 +1,185 @@
+/**
+ * @file    test_hdc_probe.c
+ * @brief   Unit Tests for Cycle-Count Probes
+ * @version 1.0.0
+ *
+ * @details Tests for the optional instrumentation layer:
+ *          - Disabled: probes compile to no-ops (default native build)
+ *          - Accumulators: count, min, max, mean, reset
+ *          - Time base: monotonic timestamps, overhead calibration
+ *          - Hot paths: instrumented HDC functions record samples
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native_profile
+ *          (the accumulator tests are ignored in the default native build).
+ */
+
+#include <unity.h>
+#include <stdint.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_encode.h"
+#include "hdc/hdc_counter.h"
+#include "hdc/hdc_probe.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+void setUp(void)
+{
+#if HDC_PROBE_ENABLED
+    hdc_probe_init();
+#endif
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/* ============================================================================
+ * Disabled Build Tests
+ * ============================================================================ */
+
+void test_probes_are_statements(void)
+{
+    hv_t a, b;
+    uint16_t runs = 0U;
+
+    hdc_fill(a, 0x0FU);
+    hdc_fill(b, 0xF0U);
+
+    /* BEGIN/END must be usable as plain statements in either build */
+    HDC_PROBE_BEGIN(HDC_PROBE_TLM_REPORT);
+    runs++;
+    HDC_PROBE_END(HDC_PROBE_TLM_REPORT);
+
+    TEST_ASSERT_EQUAL_UINT16(1U, runs);
+    TEST_ASSERT_EQUAL(HV_DIMENSIONS, hdc_hamming(a, b));
+}
+
+/* ============================================================================
+ * Accumulator Tests
+ * ============================================================================ */
+
+void test_record_tracks_min_max_mean(void)
+{
+#if HDC_PROBE_ENABLED
+    /* Raw samples include the calibrated overhead, which is subtracted */
+    hdc_probe_ticks_t base = 1000000U;
+
+    hdc_probe_record(HDC_PROBE_ADC_SAMPLE, base + 30U);
+    hdc_probe_record(HDC_PROBE_ADC_SAMPLE, base + 10U);
+    hdc_probe_record(HDC_PROBE_ADC_SAMPLE, base + 20U);
+
+    const hdc_probe_stats_t* stats = hdc_probe_get(HDC_PROBE_ADC_SAMPLE);
+    TEST_ASSERT_NOT_NULL(stats);
+    TEST_ASSERT_EQUAL_UINT32(3U, stats->count);
+    TEST_ASSERT_EQUAL_UINT32(stats->min + 20U, stats->max);
+    TEST_ASSERT_EQUAL_UINT32(stats->min + 10U, hdc_probe_mean(stats));
+    TEST_ASSERT_TRUE(stats->min <= base + 10U);
+#else
+    TEST_IGNORE_MESSAGE("built without HDC_PROFILE");
+#endif
+}
+
+void test_reset_clears_and_bounds_checked(void)
+{
+#if HDC_PROBE_ENABLED
+    hdc_probe_record(HDC_PROBE_PERMUTE, 500000U);
+    hdc_probe_record(HDC_PROBE_COUNT, 500000U);     /* ignored */
+    hdc_probe_reset();
+
+    const hdc_probe_stats_t* stats = hdc_probe_get(HDC_PROBE_PERMUTE);
+    TEST_ASSERT_EQUAL_UINT32(0U, stats->count);
+    TEST_ASSERT_EQUAL_UINT32(0U, hdc_probe_mean(stats));
+    TEST_ASSERT_NULL(hdc_probe_get(HDC_PROBE_COUNT));
+#else
+    TEST_IGNORE_MESSAGE("built without HDC_PROFILE");
+#endif
+}
+
+/* ============================================================================
+ * Time Base Tests
+ * ============================================================================ */
+
+void test_empty_probe_costs_nothing(void)
+{
+#if HDC_PROBE_ENABLED
+    hdc_probe_ticks_t prev = hdc_probe_now();
+
+    for (uint8_t i = 0U; i < 16U; i++) {
+        HDC_PROBE_BEGIN(HDC_PROBE_TLM_REPORT);
+        HDC_PROBE_END(HDC_PROBE_TLM_REPORT);
+
+        hdc_probe_ticks_t now = hdc_probe_now();
+        TEST_ASSERT_TRUE((hdc_probe_ticks_t)(now - prev) < 0x80000000UL);
+        prev = now;
+    }
+
+    /* Calibration removes the cost of an empty pair (allow clock jitter) */
+    const hdc_probe_stats_t* stats = hdc_probe_get(HDC_PROBE_TLM_REPORT);
+    TEST_ASSERT_EQUAL_UINT32(16U, stats->count);
+    TEST_ASSERT_TRUE(stats->min < 1000U);
+#else
+    TEST_IGNORE_MESSAGE("built without HDC_PROFILE");
+#endif
+}
+
+/* ============================================================================
+ * Hot Path Tests
+ * ============================================================================ */
+
+void test_hot_paths_record_samples(void)
+{
+#if HDC_PROBE_ENABLED
+    hv_t a, b, basis[2];
+    uint16_t values[2] = {100U, 900U};
+    hdc_counter_t counter;
+
+    hdc_fill(a, 0xA5U);
+    hdc_fill(b, 0x3CU);
+    hdc_copy(basis[0], a);
+    hdc_copy(basis[1], b);
+    hdc_counter_reset(&counter);
+
+    (void)hdc_hamming(a, b);
+    (void)hdc_hamming(a, a);
+    hdc_permute(a, 3U);
+    hdc_permute(a, 0U);                             /* no-op, not timed */
+    hdc_encode_multi_channel(a, values, 2U, (const hv_t*)basis);
+    hdc_counter_add(&counter, a);
+
+    TEST_ASSERT_EQUAL_UINT32(2U, hdc_probe_get(HDC_PROBE_HAMMING)->count);
+    TEST_ASSERT_EQUAL_UINT32(1U, hdc_probe_get(HDC_PROBE_PERMUTE)->count);
+    TEST_ASSERT_EQUAL_UINT32(1U, hdc_probe_get(HDC_PROBE_ENCODE_MULTI)->count);
+    TEST_ASSERT_EQUAL_UINT32(1U, hdc_probe_get(HDC_PROBE_COUNTER_ADD)->count);
+    TEST_ASSERT_EQUAL_UINT32(0U, hdc_probe_get(HDC_PROBE_AM_QUERY)->count);
+#else
+    TEST_IGNORE_MESSAGE("built without HDC_PROFILE");
+#endif
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Disabled build tests */
+    RUN_TEST(test_probes_are_statements);
+
+    /* Accumulator tests */
+    RUN_TEST(test_record_tracks_min_max_mean);
+    RUN_TEST(test_reset_clears_and_bounds_checked);
+
+    /* Time base tests */
+    RUN_TEST(test_empty_probe_costs_nothing);
+
+    /* Hot path tests */
+    RUN_TEST(test_hot_paths_record_samples);
+
+    return UNITY_END();
+}
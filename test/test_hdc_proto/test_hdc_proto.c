@@ -0,0 +1,342 @@
+/**
+ * @file    test_hdc_proto.c
+ * @brief   Unit Tests for the Prototype Cache
+ * @version 1.0.0
+ *
+ * @details Tests for lazy re-thresholding with dirty word tracking:
+ *          - Attach: read-only memories, everything stale at first
+ *          - Refresh: on read only, per class, only stale words
+ *          - State: stale and unsaved flags, invalidate, invalid classes
+ *          - Persistence: store ranges of the changed words only
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ */
+
+#include <unity.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_counter.h"
+#include "hdc/hdc_am.h"
+#include "hdc/hdc_store.h"
+#include "hdc/hdc_proto.h"
+#include "mock_hv.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TEST_CLASSES    3U
+
+static hv_t s_rows[TEST_CLASSES];
+static hdc_counter_t s_counters[TEST_CLASSES];
+static hdc_counter_mask_t s_stale[TEST_CLASSES];
+static hdc_counter_mask_t s_unsaved[TEST_CLASSES];
+static hdc_am_t s_am;
+static hdc_proto_t s_proto;
+
+/**
+ * @brief Check one class row against a full threshold of its counters
+ */
+static void assert_row_matches_counters(hdc_class_t c)
+{
+    hv_t expected;
+
+    hdc_counter_threshold(expected, &s_counters[c], s_proto.tiebreak);
+    TEST_ASSERT_EQUAL_MEMORY(expected, s_rows[c], HV_BYTES);
+}
+
+/**
+ * @brief Saturate every counter of a class high, bypassing the cache
+ */
+static void saturate_high(hdc_class_t c)
+{
+    hv_t ones;
+    hdc_fill(ones, 0xFFU);
+
+    for (uint16_t n = 0U; n < HDC_COUNTER_MAX; n++) {
+        hdc_counter_add(&s_counters[c], ones);
+    }
+}
+
+/* RAM device for the persistence tests (contents are never checked) */
+static uint8_t s_dev[4U * (HDC_STORE_HEADER_BYTES + HDC_STORE_MAX_BYTES)];
+
+static uint8_t dev_read(uint16_t addr)
+{
+    return s_dev[addr];
+}
+
+static void dev_write(uint16_t addr, uint8_t value)
+{
+    s_dev[addr] = value;
+}
+
+static bool dev_busy(void)
+{
+    return false;
+}
+
+static const hdc_store_io_t s_io = {dev_read, dev_write, dev_busy};
+
+void setUp(void)
+{
+    hv_t zero;
+    hdc_clear(zero);
+
+    hdc_am_init(&s_am, s_rows, TEST_CLASSES);
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        hdc_counter_reset(&s_counters[c]);
+        (void)hdc_am_add(&s_am, zero, NULL);
+    }
+    TEST_ASSERT_EQUAL(HDC_PROTO_OK,
+                      hdc_proto_init(&s_proto, &s_am, s_counters, s_stale, s_unsaved, NULL));
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/* ============================================================================
+ * Attach Tests
+ * ============================================================================ */
+
+void test_proto_init_rejects_read_only(void)
+{
+    hdc_am_t view;
+    hdc_proto_t cache;
+
+    hdc_am_init_view(&view, (const hv_t*)s_rows, TEST_CLASSES);
+    TEST_ASSERT_EQUAL(HDC_PROTO_ERROR_READ_ONLY,
+                      hdc_proto_init(&cache, &view, s_counters, s_stale, s_unsaved, NULL));
+    TEST_ASSERT_EQUAL(0U, cache.num_classes);
+}
+
+void test_proto_first_refresh_rebuilds_from_counters(void)
+{
+    hv_t pattern;
+    hv_t tiebreak;
+
+    /* Counters restored from storage, rows stale */
+    fill_pseudo_random(pattern, 1U);
+    hdc_counter_add(&s_counters[1], pattern);
+    fill_pseudo_random(tiebreak, 2U);
+    TEST_ASSERT_EQUAL(HDC_PROTO_OK,
+                      hdc_proto_init(&s_proto, &s_am, s_counters, s_stale, s_unsaved, tiebreak));
+
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        TEST_ASSERT_TRUE(hdc_proto_is_stale(&s_proto, c));
+        TEST_ASSERT_FALSE(hdc_proto_is_unsaved(&s_proto, c));
+    }
+    TEST_ASSERT_EQUAL_UINT16(TEST_CLASSES, hdc_proto_refresh(&s_proto));
+    for (hdc_class_t c = 0U; c < TEST_CLASSES; c++) {
+        assert_row_matches_counters(c);
+    }
+
+    /* Nothing left to do */
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_proto_refresh(&s_proto));
+}
+
+/* ============================================================================
+ * Refresh Tests
+ * ============================================================================ */
+
+void test_proto_get_refreshes_only_that_class(void)
+{
+    hv_t pattern;
+
+    (void)hdc_proto_refresh(&s_proto);
+    fill_pseudo_random(pattern, 3U);
+    TEST_ASSERT_EQUAL_UINT16(HDC_COUNTER_WORDS, hdc_proto_add(&s_proto, 0U, pattern));
+    TEST_ASSERT_EQUAL_UINT16(HDC_COUNTER_WORDS, hdc_proto_sub(&s_proto, 2U, pattern));
+
+    /* The rows are not touched by the updates */
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_popcount(s_rows[0]));
+    TEST_ASSERT_TRUE(hdc_proto_is_stale(&s_proto, 0U));
+    TEST_ASSERT_FALSE(hdc_proto_is_stale(&s_proto, 1U));
+
+    TEST_ASSERT_EQUAL_PTR(s_rows[0], hdc_proto_get(&s_proto, 0U));
+    assert_row_matches_counters(0U);
+    TEST_ASSERT_FALSE(hdc_proto_is_stale(&s_proto, 0U));
+    TEST_ASSERT_TRUE(hdc_proto_is_stale(&s_proto, 2U));
+
+    /* A query refreshes the rest */
+    hdc_am_match_t best;
+    TEST_ASSERT_EQUAL(HDC_AM_OK, hdc_proto_query(&s_proto, pattern, &best));
+    TEST_ASSERT_EQUAL_UINT16(0U, best.class_id);
+    TEST_ASSERT_FALSE(hdc_proto_is_stale(&s_proto, 2U));
+    assert_row_matches_counters(2U);
+}
+
+void test_proto_refresh_skips_clean_words(void)
+{
+    hv_t last;
+
+    saturate_high(0U);
+    (void)hdc_proto_refresh(&s_proto);
+
+    /* Corrupt the row: only words an update marks get rewritten */
+    hdc_clear(s_rows[0]);
+    hdc_clear(last);
+    last[HV_BYTES - 1U] = 0x80U;
+    for (uint16_t n = 0U; n <= HDC_COUNTER_INIT; n++) {
+        TEST_ASSERT_EQUAL_UINT16(1U, hdc_proto_sub(&s_proto, 0U, last));
+    }
+    (void)hdc_proto_get(&s_proto, 0U);
+
+    /* The last word is redone: its dimensions are 1 except the last, whose
+     * counter fell to the tie. The cleared words before it stay clear. */
+    hdc_index_t last_word = (hdc_index_t)((HDC_COUNTER_WORDS - 1U) * HDC_WORD_BYTES);
+    TEST_ASSERT_EQUAL_UINT16(((HV_BYTES - last_word) * 8U) - 1U, hdc_popcount(s_rows[0]));
+    TEST_ASSERT_EQUAL_UINT8(HDC_COUNTER_INIT,
+                            hdc_counter_get(&s_counters[0], (hdc_dist_t)(HV_DIMENSIONS - 1U)));
+}
+
+/* ============================================================================
+ * State Tests
+ * ============================================================================ */
+
+void test_proto_saturated_update_marks_nothing(void)
+{
+    hv_t ones;
+    hdc_fill(ones, 0xFFU);
+
+    saturate_high(1U);
+    (void)hdc_proto_refresh(&s_proto);
+
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_proto_add(&s_proto, 1U, ones));
+    TEST_ASSERT_FALSE(hdc_proto_is_stale(&s_proto, 1U));
+    TEST_ASSERT_FALSE(hdc_proto_is_unsaved(&s_proto, 1U));
+}
+
+void test_proto_invalidate_marks_every_word(void)
+{
+    (void)hdc_proto_refresh(&s_proto);
+    saturate_high(2U);
+
+    TEST_ASSERT_EQUAL(HDC_PROTO_OK, hdc_proto_invalidate(&s_proto, 2U));
+    TEST_ASSERT_TRUE(hdc_proto_is_stale(&s_proto, 2U));
+    TEST_ASSERT_TRUE(hdc_proto_is_unsaved(&s_proto, 2U));
+    (void)hdc_proto_get(&s_proto, 2U);
+    TEST_ASSERT_EQUAL_UINT16(HV_DIMENSIONS, hdc_popcount(s_rows[2]));
+}
+
+void test_proto_invalid_class(void)
+{
+    hv_t pattern;
+    hdc_counter_t before[TEST_CLASSES];
+
+    fill_pseudo_random(pattern, 4U);
+    memcpy(before, s_counters, sizeof(before));
+
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_proto_add(&s_proto, TEST_CLASSES, pattern));
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_proto_sub(&s_proto, TEST_CLASSES, pattern));
+    TEST_ASSERT_EQUAL(HDC_PROTO_ERROR_INVALID_CLASS, hdc_proto_invalidate(&s_proto, TEST_CLASSES));
+    TEST_ASSERT_NULL(hdc_proto_get(&s_proto, TEST_CLASSES));
+    TEST_ASSERT_FALSE(hdc_proto_is_stale(&s_proto, TEST_CLASSES));
+    TEST_ASSERT_FALSE(hdc_proto_is_unsaved(&s_proto, TEST_CLASSES));
+    TEST_ASSERT_EQUAL_MEMORY(before, s_counters, sizeof(before));
+}
+
+/* ============================================================================
+ * Persistence Tests
+ * ============================================================================ */
+
+void test_proto_persist_marks_changed_words_only(void)
+{
+    hdc_store_t store;
+    hdc_store_t expected;
+    hv_t pattern;
+
+    if (sizeof(s_counters) > HDC_STORE_MAX_BYTES) {
+        TEST_IGNORE_MESSAGE("counters exceed HDC_STORE_MAX_BYTES");
+    }
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, hdc_store_init(&store, &s_io, 0U, 2U, (uint8_t*)s_counters,
+                                                   (uint16_t)sizeof(s_counters), 1U));
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, hdc_store_init(&expected, &s_io, 0U, 2U,
+                                                   (uint8_t*)s_counters,
+                                                   (uint16_t)sizeof(s_counters), 1U));
+
+    /* First and last dimension of class 1 move; every other counter is
+     * saturated towards the pattern */
+    saturate_high(1U);
+    hdc_clear(pattern);
+    pattern[0] = 0x01U;
+    pattern[HV_BYTES - 1U] = 0x80U;
+    (void)hdc_proto_sub(&s_proto, 1U, pattern);
+    TEST_ASSERT_TRUE(hdc_proto_is_unsaved(&s_proto, 1U));
+    TEST_ASSERT_FALSE(hdc_proto_is_unsaved(&s_proto, 0U));
+
+    /* One run per plane if the two words touch, otherwise two */
+    uint16_t runs = (HDC_COUNTER_WORDS >= 3U) ? 2U : 1U;
+    TEST_ASSERT_EQUAL_UINT16(runs * HDC_COUNTER_PLANES, hdc_proto_persist(&s_proto, &store, 0U));
+    TEST_ASSERT_FALSE(hdc_proto_is_unsaved(&s_proto, 1U));
+
+    uint16_t first_len = (HDC_COUNTER_WORDS == 1U) ? HV_BYTES : HDC_WORD_BYTES;
+    uint16_t last_word = (uint16_t)((HDC_COUNTER_WORDS - 1U) * HDC_WORD_BYTES);
+    for (uint8_t j = 0U; j < HDC_COUNTER_PLANES; j++) {
+        uint16_t plane = (uint16_t)(sizeof(hdc_counter_t) + (j * HV_BYTES));
+        hdc_store_mark(&expected, plane, first_len);
+        hdc_store_mark(&expected, (uint16_t)(plane + last_word),
+                       (uint16_t)(HV_BYTES - last_word));
+    }
+    TEST_ASSERT_EQUAL_MEMORY(expected.dirty, store.dirty, sizeof(store.dirty));
+
+    /* Nothing new to hand over */
+    TEST_ASSERT_EQUAL_UINT16(0U, hdc_proto_persist(&s_proto, &store, 0U));
+}
+
+void test_proto_persist_keeps_stale_state(void)
+{
+    hdc_store_t store;
+    hv_t pattern;
+
+    if (sizeof(s_counters) > HDC_STORE_MAX_BYTES) {
+        TEST_IGNORE_MESSAGE("counters exceed HDC_STORE_MAX_BYTES");
+    }
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, hdc_store_init(&store, &s_io, 0U, 2U, (uint8_t*)s_counters,
+                                                   (uint16_t)sizeof(s_counters), 1U));
+
+    /* Persisting and refreshing are independent */
+    (void)hdc_proto_refresh(&s_proto);
+    fill_pseudo_random(pattern, 5U);
+    (void)hdc_proto_add(&s_proto, 0U, pattern);
+    (void)hdc_proto_persist(&s_proto, &store, 0U);
+    TEST_ASSERT_TRUE(hdc_proto_is_stale(&s_proto, 0U));
+
+    (void)hdc_proto_add(&s_proto, 0U, pattern);
+    (void)hdc_proto_get(&s_proto, 0U);
+    TEST_ASSERT_TRUE(hdc_proto_is_unsaved(&s_proto, 0U));
+    assert_row_matches_counters(0U);
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Attach tests */
+    RUN_TEST(test_proto_init_rejects_read_only);
+    RUN_TEST(test_proto_first_refresh_rebuilds_from_counters);
+
+    /* Refresh tests */
+    RUN_TEST(test_proto_get_refreshes_only_that_class);
+    RUN_TEST(test_proto_refresh_skips_clean_words);
+
+    /* State tests */
+    RUN_TEST(test_proto_saturated_update_marks_nothing);
+    RUN_TEST(test_proto_invalidate_marks_every_word);
+    RUN_TEST(test_proto_invalid_class);
+
+    /* Persistence tests */
+    RUN_TEST(test_proto_persist_marks_changed_words_only);
+    RUN_TEST(test_proto_persist_keeps_stale_state);
+
+    return UNITY_END();
+}
@@ -0,0 +1,177 @@
+/**
+ * @file    test_hdc_seq.c
+ * @brief   Unit Tests for the Sliding N-gram Encoder
+ * @version 1.0.0
+ *
+ * @details Tests for sequence encoding:
+ *          - Window: init validation, fill state, reset
+ *          - Incremental update equals the one-shot n-gram over a long stream
+ *          - Order sensitivity: permuted order gives a different n-gram
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_item.h"
+#include "hdc/hdc_seq.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define TEST_SEED       0x5EC0FFEEUL
+#define TEST_MAX_N      9U
+#define TEST_STREAM     40U
+
+static hv_t s_stream[TEST_STREAM];
+static hv_t s_history[TEST_MAX_N];
+static hdc_seq_t s_seq;
+
+void setUp(void)
+{
+    for (uint8_t i = 0U; i < TEST_STREAM; i++) {
+        hdc_item_generate(s_stream[i], TEST_SEED, i);
+    }
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/* ============================================================================
+ * Window Tests
+ * ============================================================================ */
+
+void test_init_rejects_invalid_length(void)
+{
+    TEST_ASSERT_EQUAL(HDC_SEQ_ERROR_INVALID, hdc_seq_init(&s_seq, s_history, 0U));
+    TEST_ASSERT_EQUAL(HDC_SEQ_ERROR_INVALID, hdc_seq_init(&s_seq, NULL, 3U));
+    TEST_ASSERT_EQUAL(HDC_SEQ_OK, hdc_seq_init(&s_seq, s_history, 3U));
+    TEST_ASSERT_FALSE(hdc_seq_ready(&s_seq));
+}
+
+void test_ready_after_n_samples(void)
+{
+    TEST_ASSERT_EQUAL(HDC_SEQ_OK, hdc_seq_init(&s_seq, s_history, 4U));
+
+    TEST_ASSERT_FALSE(hdc_seq_push(&s_seq, s_stream[0]));
+    TEST_ASSERT_FALSE(hdc_seq_push(&s_seq, s_stream[1]));
+    TEST_ASSERT_FALSE(hdc_seq_push(&s_seq, s_stream[2]));
+    TEST_ASSERT_TRUE(hdc_seq_push(&s_seq, s_stream[3]));
+    TEST_ASSERT_TRUE(hdc_seq_push(&s_seq, s_stream[4]));
+    TEST_ASSERT_TRUE(hdc_seq_ready(&s_seq));
+}
+
+void test_reset_empties_window(void)
+{
+    hv_t expected;
+
+    TEST_ASSERT_EQUAL(HDC_SEQ_OK, hdc_seq_init(&s_seq, s_history, 3U));
+    for (uint8_t i = 0U; i < 5U; i++) {
+        (void)hdc_seq_push(&s_seq, s_stream[i]);
+    }
+
+    hdc_seq_reset(&s_seq);
+    TEST_ASSERT_FALSE(hdc_seq_ready(&s_seq));
+    TEST_ASSERT_EQUAL(0, hdc_popcount(s_seq.gram));
+
+    /* The window restarts from the next sample */
+    for (uint8_t i = 10U; i < 13U; i++) {
+        (void)hdc_seq_push(&s_seq, s_stream[i]);
+    }
+    hdc_seq_encode(expected, (const hv_t*)&s_stream[10], 3U);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, s_seq.gram, HV_BYTES);
+}
+
+/* ============================================================================
+ * Incremental Update Tests
+ * ============================================================================ */
+
+void test_unigram_is_latest_sample(void)
+{
+    TEST_ASSERT_EQUAL(HDC_SEQ_OK, hdc_seq_init(&s_seq, s_history, 1U));
+
+    for (uint8_t i = 0U; i < 5U; i++) {
+        TEST_ASSERT_TRUE(hdc_seq_push(&s_seq, s_stream[i]));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(s_stream[i], s_seq.gram, HV_BYTES);
+    }
+}
+
+void test_encode_matches_definition(void)
+{
+    hv_t expected, term, actual;
+
+    /* rho^2(x0) ^ rho(x1) ^ x2 */
+    hdc_copy(expected, s_stream[2]);
+    hdc_copy(term, s_stream[1]);
+    hdc_permute(term, 1U);
+    hdc_xor(expected, expected, term);
+    hdc_copy(term, s_stream[0]);
+    hdc_permute(term, 2U);
+    hdc_xor(expected, expected, term);
+
+    hdc_seq_encode(actual, (const hv_t*)s_stream, 3U);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, HV_BYTES);
+}
+
+void test_push_matches_one_shot_encoding(void)
+{
+    static const uint8_t lengths[] = {2U, 3U, 5U, TEST_MAX_N};
+    hv_t expected;
+
+    for (uint8_t l = 0U; l < (uint8_t)sizeof(lengths); l++) {
+        uint8_t n = lengths[l];
+        TEST_ASSERT_EQUAL(HDC_SEQ_OK, hdc_seq_init(&s_seq, s_history, n));
+
+        /* Many window wraps: every output must be the n-gram of its window */
+        for (uint8_t t = 0U; t < TEST_STREAM; t++) {
+            (void)hdc_seq_push(&s_seq, s_stream[t]);
+
+            uint8_t count = (t + 1U < n) ? (uint8_t)(t + 1U) : n;
+            hdc_seq_encode(expected, (const hv_t*)&s_stream[t + 1U - count], count);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, s_seq.gram, HV_BYTES);
+        }
+    }
+}
+
+void test_order_changes_ngram(void)
+{
+    hv_t forward[3], reversed[3];
+    hv_t a, b;
+
+    for (uint8_t i = 0U; i < 3U; i++) {
+        hdc_copy(forward[i], s_stream[i]);
+        hdc_copy(reversed[i], s_stream[2U - i]);
+    }
+
+    hdc_seq_encode(a, (const hv_t*)forward, 3U);
+    hdc_seq_encode(b, (const hv_t*)reversed, 3U);
+    TEST_ASSERT_TRUE(hdc_hamming(a, b) > (HV_DIMENSIONS / 4U));
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Window tests */
+    RUN_TEST(test_init_rejects_invalid_length);
+    RUN_TEST(test_ready_after_n_samples);
+    RUN_TEST(test_reset_empties_window);
+
+    /* Incremental update tests */
+    RUN_TEST(test_unigram_is_latest_sample);
+    RUN_TEST(test_encode_matches_definition);
+    RUN_TEST(test_push_matches_one_shot_encoding);
+    RUN_TEST(test_order_changes_ngram);
+
+    return UNITY_END();
+}
@@ -0,0 +1,436 @@
+/**
+ * @file    test_hdc_store.c
+ * @brief   Unit Tests for the Wear-Levelled Model Store
+ * @version 1.0.0
+ *
+ * @details Tests against a RAM-backed EEPROM model that counts writes per
+ *          cell, keeps each write "programming" for a few polls and can cut
+ *          power after a given number of writes:
+ *          - Layout: CRC check value, empty device, round trip, schema check
+ *          - Incremental: only changed bytes written, clean commits are free
+ *          - Wear levelling: slot rotation, newest slot wins, sequence wrap
+ *          - Robustness: power loss mid-commit, corrupted slot fallback,
+ *            changes made while a commit is in progress
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "hdc/hdc_store.h"
+
+/* ============================================================================
+ * RAM EEPROM Model
+ * ============================================================================ */
+
+#define DEV_SIZE        1024U
+#define DEV_BUSY_POLLS  2U          /* busy() returns true this many times */
+
+static uint8_t s_dev[DEV_SIZE];
+static uint16_t s_dev_writes[DEV_SIZE];
+static uint32_t s_dev_total_writes;
+static uint32_t s_dev_write_limit;  /* writes beyond this are lost (power cut) */
+static uint8_t s_dev_busy;
+static bool s_dev_overlap;          /* access while busy (must never happen) */
+
+static uint8_t dev_read(uint16_t addr)
+{
+    if (s_dev_busy != 0U) {
+        s_dev_overlap = true;
+    }
+    return s_dev[addr];
+}
+
+static void dev_write(uint16_t addr, uint8_t value)
+{
+    if (s_dev_busy != 0U) {
+        s_dev_overlap = true;
+    }
+    if (s_dev_total_writes < s_dev_write_limit) {
+        s_dev[addr] = value;
+        s_dev_writes[addr]++;
+    }
+    s_dev_total_writes++;
+    s_dev_busy = DEV_BUSY_POLLS;
+}
+
+static bool dev_busy(void)
+{
+    if (s_dev_busy != 0U) {
+        s_dev_busy--;
+        return true;
+    }
+    return false;
+}
+
+static const hdc_store_io_t s_io = {dev_read, dev_write, dev_busy};
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+#define IMG_BYTES       100U
+#define IMG_SLOTS       3U
+#define IMG_SCHEMA      7U
+#define IMG_BASE        16U
+#define SLOT_BYTES      (HDC_STORE_HEADER_BYTES + IMG_BYTES)
+#define MAX_STEPS       100000UL
+
+static uint8_t s_image[IMG_BYTES];
+static hdc_store_t s_store;
+
+void setUp(void)
+{
+    memset(s_dev, 0xFF, sizeof(s_dev));     /* erased EEPROM */
+    memset(s_dev_writes, 0, sizeof(s_dev_writes));
+    s_dev_total_writes = 0U;
+    s_dev_write_limit = 0xFFFFFFFFUL;
+    s_dev_busy = 0U;
+    s_dev_overlap = false;
+
+    for (uint16_t i = 0U; i < IMG_BYTES; i++) {
+        s_image[i] = (uint8_t)(i * 7U);
+    }
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, hdc_store_init(&s_store, &s_io, IMG_BASE, IMG_SLOTS,
+                                                   s_image, IMG_BYTES, IMG_SCHEMA));
+}
+
+void tearDown(void)
+{
+    TEST_ASSERT_FALSE(s_dev_overlap);
+}
+
+/** @brief Run a started commit to completion, returning the step count */
+static uint32_t run_commit(hdc_store_t* store)
+{
+    uint32_t steps = 0U;
+
+    while ((hdc_store_step(store) == HDC_STORE_PENDING) && (steps < MAX_STEPS)) {
+        steps++;
+    }
+    TEST_ASSERT_FALSE(hdc_store_busy(store));
+    return steps;
+}
+
+/** @brief Commit the image and wait for it */
+static void commit_now(hdc_store_t* store)
+{
+    if (hdc_store_commit(store) == HDC_STORE_PENDING) {
+        (void)run_commit(store);
+    }
+}
+
+/** @brief A second store over the same device, as after a reset */
+static hdc_store_status_t reload(uint8_t* image)
+{
+    static hdc_store_t store;
+
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, hdc_store_init(&store, &s_io, IMG_BASE, IMG_SLOTS,
+                                                   image, IMG_BYTES, IMG_SCHEMA));
+    return hdc_store_load(&store);
+}
+
+/* ============================================================================
+ * Layout Tests
+ * ============================================================================ */
+
+void test_crc16_check_value(void)
+{
+    static const char check[] = "123456789";
+    uint16_t crc = 0xFFFFU;
+
+    for (uint8_t i = 0U; i < 9U; i++) {
+        crc = hdc_store_crc16(crc, (uint8_t)check[i]);
+    }
+    TEST_ASSERT_EQUAL_HEX16(0x29B1U, crc);
+}
+
+void test_init_rejects_invalid(void)
+{
+    hdc_store_t store;
+
+    TEST_ASSERT_EQUAL(HDC_STORE_ERROR_INVALID,
+                      hdc_store_init(&store, &s_io, 0U, 0U, s_image, IMG_BYTES, 0U));
+    TEST_ASSERT_EQUAL(HDC_STORE_ERROR_INVALID,
+                      hdc_store_init(&store, &s_io, 0U, HDC_STORE_MAX_SLOTS + 1U, s_image, IMG_BYTES, 0U));
+    TEST_ASSERT_EQUAL(HDC_STORE_ERROR_INVALID,
+                      hdc_store_init(&store, &s_io, 0U, 2U, s_image, 0U, 0U));
+    TEST_ASSERT_EQUAL(HDC_STORE_ERROR_INVALID,
+                      hdc_store_init(&store, &s_io, 0U, 2U, s_image, HDC_STORE_MAX_BYTES + 1U, 0U));
+}
+
+void test_load_blank_device_is_empty(void)
+{
+    TEST_ASSERT_EQUAL(HDC_STORE_ERROR_EMPTY, hdc_store_load(&s_store));
+}
+
+void test_round_trip(void)
+{
+    uint8_t loaded[IMG_BYTES];
+
+    TEST_ASSERT_EQUAL(HDC_STORE_PENDING, hdc_store_commit(&s_store));
+    (void)run_commit(&s_store);
+
+    memset(loaded, 0, sizeof(loaded));
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, reload(loaded));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(s_image, loaded, IMG_BYTES);
+
+    /* Header fields, little-endian */
+    TEST_ASSERT_EQUAL_HEX8('H', s_dev[IMG_BASE]);
+    TEST_ASSERT_EQUAL_HEX8('S', s_dev[IMG_BASE + 1U]);
+    TEST_ASSERT_EQUAL_HEX8(HDC_STORE_FORMAT, s_dev[IMG_BASE + 2U]);
+    TEST_ASSERT_EQUAL_HEX8(IMG_SCHEMA, s_dev[IMG_BASE + 3U]);
+    TEST_ASSERT_EQUAL_HEX8(1U, s_dev[IMG_BASE + 4U]);
+    TEST_ASSERT_EQUAL_HEX8(IMG_BYTES, s_dev[IMG_BASE + 6U]);
+}
+
+void test_schema_mismatch_is_ignored(void)
+{
+    hdc_store_t store;
+    uint8_t loaded[IMG_BYTES];
+
+    commit_now(&s_store);
+
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, hdc_store_init(&store, &s_io, IMG_BASE, IMG_SLOTS,
+                                                   loaded, IMG_BYTES, IMG_SCHEMA + 1U));
+    TEST_ASSERT_EQUAL(HDC_STORE_ERROR_EMPTY, hdc_store_load(&store));
+}
+
+/* ============================================================================
+ * Incremental Commit Tests
+ * ============================================================================ */
+
+void test_clean_commit_is_free(void)
+{
+    commit_now(&s_store);
+    uint32_t writes = s_dev_total_writes;
+
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, hdc_store_commit(&s_store));
+    TEST_ASSERT_EQUAL_UINT32(writes, s_dev_total_writes);
+}
+
+void test_only_changed_bytes_are_written(void)
+{
+    /* Fill every slot once so all of them hold the same image */
+    for (uint8_t s = 0U; s < IMG_SLOTS; s++) {
+        hdc_store_mark_all(&s_store);
+        commit_now(&s_store);
+    }
+    uint32_t writes = s_dev_total_writes;
+
+    s_image[42] ^= 0x01U;
+    hdc_store_mark(&s_store, 42U, 1U);
+    commit_now(&s_store);
+
+    /* The byte itself plus the header bytes that changed (seq, CRC) */
+    uint32_t delta = s_dev_total_writes - writes;
+    TEST_ASSERT_TRUE(delta >= 2U);
+    TEST_ASSERT_TRUE(delta <= 1U + 4U);
+}
+
+void test_step_starts_at_most_one_write(void)
+{
+    TEST_ASSERT_EQUAL(HDC_STORE_PENDING, hdc_store_commit(&s_store));
+
+    for (uint32_t steps = 0U; steps < MAX_STEPS; steps++) {
+        uint32_t before = s_dev_total_writes;
+        if (hdc_store_step(&s_store) != HDC_STORE_PENDING) {
+            break;
+        }
+        TEST_ASSERT_TRUE((s_dev_total_writes - before) <= 1U);
+    }
+    TEST_ASSERT_FALSE(hdc_store_busy(&s_store));
+
+    s_image[0] ^= 0xFFU;
+    hdc_store_mark(&s_store, 0U, 1U);
+    TEST_ASSERT_EQUAL(HDC_STORE_PENDING, hdc_store_commit(&s_store));
+    TEST_ASSERT_EQUAL(HDC_STORE_ERROR_BUSY, hdc_store_commit(&s_store));
+    (void)run_commit(&s_store);
+}
+
+/* ============================================================================
+ * Wear Levelling Tests
+ * ============================================================================ */
+
+void test_slots_rotate(void)
+{
+    for (uint8_t c = 0U; c < (2U * IMG_SLOTS); c++) {
+        s_image[0] = c;
+        hdc_store_mark(&s_store, 0U, 1U);
+        commit_now(&s_store);
+        TEST_ASSERT_EQUAL_UINT8(c % IMG_SLOTS, s_store.current);
+    }
+
+    /* Byte 0 changed every commit but each slot saw only every third */
+    for (uint8_t s = 0U; s < IMG_SLOTS; s++) {
+        TEST_ASSERT_EQUAL_UINT16(2U, s_dev_writes[IMG_BASE + (s * SLOT_BYTES) + HDC_STORE_HEADER_BYTES]);
+    }
+}
+
+void test_newest_slot_wins(void)
+{
+    uint8_t loaded[IMG_BYTES];
+
+    for (uint8_t c = 0U; c < 5U; c++) {
+        s_image[10] = (uint8_t)(0xA0U + c);
+        hdc_store_mark(&s_store, 10U, 1U);
+        commit_now(&s_store);
+    }
+
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, reload(loaded));
+    TEST_ASSERT_EQUAL_HEX8(0xA4U, loaded[10]);
+}
+
+void test_sequence_wraps(void)
+{
+    uint8_t loaded[IMG_BYTES];
+
+    commit_now(&s_store);
+    s_store.seq = 0xFFFEU;      /* as after 65534 commits */
+
+    for (uint8_t c = 0U; c < 3U; c++) {
+        s_image[1] = c;
+        hdc_store_mark(&s_store, 1U, 1U);
+        commit_now(&s_store);
+    }
+
+    /* Sequences 0xFFFF, 0x0000, 0x0001: the last one is newest */
+    TEST_ASSERT_EQUAL_UINT16(1U, s_store.seq);
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, reload(loaded));
+    TEST_ASSERT_EQUAL_UINT8(2U, loaded[1]);
+}
+
+/* ============================================================================
+ * Robustness Tests
+ * ============================================================================ */
+
+void test_power_loss_keeps_previous_image(void)
+{
+    uint8_t expected[IMG_BYTES];
+    uint8_t loaded[IMG_BYTES];
+
+    commit_now(&s_store);
+    memcpy(expected, s_image, IMG_BYTES);
+
+    /* Change everything, then lose power after a few writes */
+    for (uint16_t i = 0U; i < IMG_BYTES; i++) {
+        s_image[i] = (uint8_t)~s_image[i];
+    }
+    hdc_store_mark_all(&s_store);
+    s_dev_write_limit = s_dev_total_writes + 20U;
+    commit_now(&s_store);
+
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, reload(loaded));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, loaded, IMG_BYTES);
+}
+
+void test_power_loss_in_header_keeps_previous_image(void)
+{
+    uint8_t expected[IMG_BYTES];
+    uint8_t loaded[IMG_BYTES];
+
+    commit_now(&s_store);
+    memcpy(expected, s_image, IMG_BYTES);
+
+    /* Count the writes of the next commit on a copy of the store and device */
+    static uint8_t snapshot[DEV_SIZE];
+    hdc_store_t shadow;
+
+    s_image[5] ^= 0x80U;
+    hdc_store_mark(&s_store, 5U, 1U);
+    memcpy(snapshot, s_dev, DEV_SIZE);
+    shadow = s_store;
+    uint32_t before = s_dev_total_writes;
+    commit_now(&shadow);
+    uint32_t needed = s_dev_total_writes - before;
+    memcpy(s_dev, snapshot, DEV_SIZE);
+
+    /* Everything but the last header byte reaches the device */
+    s_dev_write_limit = s_dev_total_writes + needed - 1U;
+    commit_now(&s_store);
+
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, reload(loaded));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, loaded, IMG_BYTES);
+}
+
+void test_corrupted_slot_falls_back(void)
+{
+    uint8_t loaded[IMG_BYTES];
+
+    s_image[3] = 0x11U;
+    hdc_store_mark_all(&s_store);
+    commit_now(&s_store);       /* slot 0 */
+    s_image[3] = 0x22U;
+    hdc_store_mark(&s_store, 3U, 1U);
+    commit_now(&s_store);       /* slot 1 */
+
+    s_dev[IMG_BASE + SLOT_BYTES + HDC_STORE_HEADER_BYTES + 50U] ^= 0x04U;
+
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, reload(loaded));
+    TEST_ASSERT_EQUAL_HEX8(0x11U, loaded[3]);
+}
+
+void test_changes_during_commit_are_kept(void)
+{
+    uint8_t loaded[IMG_BYTES];
+
+    hdc_store_mark_all(&s_store);
+    TEST_ASSERT_EQUAL(HDC_STORE_PENDING, hdc_store_commit(&s_store));
+
+    /* Modify bytes behind and ahead of the scan part way through */
+    for (uint8_t i = 0U; i < 60U; i++) {
+        (void)hdc_store_step(&s_store);
+    }
+    s_image[0] = 0xC0U;
+    hdc_store_mark(&s_store, 0U, 1U);
+    s_image[IMG_BYTES - 1U] = 0xC1U;
+    hdc_store_mark(&s_store, IMG_BYTES - 1U, 1U);
+    (void)run_commit(&s_store);
+
+    /* The slot is self-consistent and already holds the byte ahead of the scan */
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, reload(loaded));
+    TEST_ASSERT_EQUAL_HEX8(0xC1U, loaded[IMG_BYTES - 1U]);
+
+    /* The byte behind the scan goes out with the next commit */
+    TEST_ASSERT_EQUAL(HDC_STORE_PENDING, hdc_store_commit(&s_store));
+    (void)run_commit(&s_store);
+    TEST_ASSERT_EQUAL(HDC_STORE_OK, reload(loaded));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(s_image, loaded, IMG_BYTES);
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* Layout tests */
+    RUN_TEST(test_crc16_check_value);
+    RUN_TEST(test_init_rejects_invalid);
+    RUN_TEST(test_load_blank_device_is_empty);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_schema_mismatch_is_ignored);
+
+    /* Incremental commit tests */
+    RUN_TEST(test_clean_commit_is_free);
+    RUN_TEST(test_only_changed_bytes_are_written);
+    RUN_TEST(test_step_starts_at_most_one_write);
+
+    /* Wear levelling tests */
+    RUN_TEST(test_slots_rotate);
+    RUN_TEST(test_newest_slot_wins);
+    RUN_TEST(test_sequence_wraps);
+
+    /* Robustness tests */
+    RUN_TEST(test_power_loss_keeps_previous_image);
+    RUN_TEST(test_power_loss_in_header_keeps_previous_image);
+    RUN_TEST(test_corrupted_slot_falls_back);
+    RUN_TEST(test_changes_during_commit_are_kept);
+
+    return UNITY_END();
+}
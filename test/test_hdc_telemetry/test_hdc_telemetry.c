@@ -0,0 +1,288 @@
+/**
+ * @file    test_hdc_telemetry.c
+ * @brief   Unit Tests for Binary Telemetry Framing
+ * @version 1.0.0
+ *
+ * @details Tests for the frame builder:
+ *          - CRC: CRC-8 (poly 0x07, init 0) check value
+ *          - Framing: header layout, empty frame, CRC coverage
+ *          - Records: sample, result, probe and memory records, limits,
+ *            type checks
+ *          - Hypervectors: fragmentation and reassembly, class snapshots
+ *
+ * @note    Uses Unity test framework. Run with: pio test -e native
+ *          scripts/telemetry_decode.py decodes the same format on the host.
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hdc/hdc_core.h"
+#include "hdc/hdc_telemetry.h"
+#include "hdc/hdc_counter.h"
+
+/* ============================================================================
+ * Test Fixtures
+ * ============================================================================ */
+
+static hdc_tlm_frame_t s_frame;
+
+/**
+ * @brief CRC over TYPE, LEN and payload of a finished frame
+ */
+static uint8_t frame_crc(const uint8_t* bytes, uint8_t length)
+{
+    uint8_t crc = 0U;
+    for (uint8_t i = 1U; i < (uint8_t)(length - 1U); i++) {
+        crc = hdc_tlm_crc8(crc, bytes[i]);
+    }
+    return crc;
+}
+
+void setUp(void)
+{
+    memset(&s_frame, 0, sizeof(s_frame));
+}
+
+void tearDown(void)
+{
+    /* Called after each test */
+}
+
+/* ============================================================================
+ * CRC Tests
+ * ============================================================================ */
+
+void test_crc8_check_value(void)
+{
+    const char* check = "123456789";
+    uint8_t crc = 0U;
+
+    for (uint8_t i = 0U; check[i] != '\0'; i++) {
+        crc = hdc_tlm_crc8(crc, (uint8_t)check[i]);
+    }
+    /* CRC-8 poly 0x07, init 0, no reflection, no final XOR */
+    TEST_ASSERT_EQUAL_HEX8(0xF4U, crc);
+}
+
+/* ============================================================================
+ * Framing Tests
+ * ============================================================================ */
+
+void test_empty_frame_layout(void)
+{
+    hdc_tlm_begin(&s_frame, HDC_TLM_RESULT);
+    uint8_t length = hdc_tlm_finish(&s_frame);
+
+    TEST_ASSERT_EQUAL_UINT8(4U, length);
+    TEST_ASSERT_EQUAL_HEX8(HDC_TLM_SYNC, s_frame.bytes[0]);
+    TEST_ASSERT_EQUAL_HEX8(HDC_TLM_RESULT, s_frame.bytes[1]);
+    TEST_ASSERT_EQUAL_UINT8(0U, s_frame.bytes[2]);
+    TEST_ASSERT_EQUAL_HEX8(frame_crc(s_frame.bytes, length), s_frame.bytes[3]);
+}
+
+void test_crc_detects_corruption(void)
+{
+    hdc_tlm_begin(&s_frame, HDC_TLM_SAMPLE);
+    TEST_ASSERT_EQUAL(HDC_TLM_OK, hdc_tlm_add_sample(&s_frame, 2U, 0x03FFU));
+    uint8_t length = hdc_tlm_finish(&s_frame);
+
+    TEST_ASSERT_EQUAL_HEX8(frame_crc(s_frame.bytes, length), s_frame.bytes[length - 1U]);
+    for (uint8_t i = 1U; i < (uint8_t)(length - 1U); i++) {
+        s_frame.bytes[i] ^= 0x10U;
+        TEST_ASSERT_TRUE(frame_crc(s_frame.bytes, length) != s_frame.bytes[length - 1U]);
+        s_frame.bytes[i] ^= 0x10U;
+    }
+}
+
+/* ============================================================================
+ * Record Tests
+ * ============================================================================ */
+
+void test_sample_records_are_little_endian(void)
+{
+    hdc_tlm_begin(&s_frame, HDC_TLM_SAMPLE);
+    TEST_ASSERT_EQUAL(HDC_TLM_OK, hdc_tlm_add_sample(&s_frame, 5U, 0x0312U));
+    TEST_ASSERT_EQUAL(HDC_TLM_OK, hdc_tlm_add_sample(&s_frame, 1U, 0x0007U));
+    uint8_t length = hdc_tlm_finish(&s_frame);
+
+    const uint8_t expected[] = {HDC_TLM_SYNC, HDC_TLM_SAMPLE, 6U,
+                                5U, 0x12U, 0x03U, 1U, 0x07U, 0x00U};
+    TEST_ASSERT_EQUAL_UINT8(sizeof(expected) + 1U, length);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, s_frame.bytes, sizeof(expected));
+}
+
+void test_sample_batch_fills_frame(void)
+{
+    uint8_t added = 0U;
+
+    hdc_tlm_begin(&s_frame, HDC_TLM_SAMPLE);
+    while (hdc_tlm_add_sample(&s_frame, added, (uint16_t)(added * 100U)) == HDC_TLM_OK) {
+        added++;
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(HDC_TLM_MAX_PAYLOAD / HDC_TLM_SAMPLE_BYTES, added);
+    TEST_ASSERT_EQUAL(HDC_TLM_ERROR_FULL, hdc_tlm_add_sample(&s_frame, 0U, 0U));
+    TEST_ASSERT_EQUAL_UINT8(added * HDC_TLM_SAMPLE_BYTES, s_frame.len);
+    TEST_ASSERT_TRUE(hdc_tlm_finish(&s_frame) <= HDC_TLM_FRAME_MAX);
+}
+
+void test_result_records_and_type_check(void)
+{
+    hdc_tlm_begin(&s_frame, HDC_TLM_RESULT);
+    TEST_ASSERT_EQUAL(HDC_TLM_ERROR_TYPE, hdc_tlm_add_sample(&s_frame, 0U, 0U));
+    TEST_ASSERT_EQUAL(HDC_TLM_OK, hdc_tlm_add_result(&s_frame, 0x0102U, 0x0304U));
+    (void)hdc_tlm_finish(&s_frame);
+
+    const uint8_t expected[] = {HDC_TLM_SYNC, HDC_TLM_RESULT, 4U, 0x02U, 0x01U, 0x04U, 0x03U};
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, s_frame.bytes, sizeof(expected));
+}
+
+void test_probe_record_layout(void)
+{
+    hdc_probe_stats_t stats = {70000U, 0x11U, 0x01020304U, 70000U * 0x20U};
+
+    hdc_tlm_begin(&s_frame, HDC_TLM_PROBE);
+    TEST_ASSERT_EQUAL(HDC_TLM_OK, hdc_tlm_add_probe(&s_frame, HDC_PROBE_AM_QUERY, &stats));
+    TEST_ASSERT_EQUAL(HDC_TLM_OK, hdc_tlm_add_probe(&s_frame, HDC_PROBE_HAMMING, &stats));
+    TEST_ASSERT_EQUAL(HDC_TLM_ERROR_FULL, hdc_tlm_add_probe(&s_frame, HDC_PROBE_PERMUTE, &stats));
+    (void)hdc_tlm_finish(&s_frame);
+
+    /* Count saturates at 0xFFFF; mean = total / count */
+    const uint8_t expected[] = {(uint8_t)HDC_PROBE_AM_QUERY, 0xFFU, 0xFFU,
+                                0x11U, 0x00U, 0x00U, 0x00U,
+                                0x04U, 0x03U, 0x02U, 0x01U,
+                                0x20U, 0x00U, 0x00U, 0x00U};
+    TEST_ASSERT_EQUAL_UINT8(2U * HDC_TLM_PROBE_BYTES, s_frame.len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, &s_frame.bytes[HDC_TLM_HEADER_BYTES], sizeof(expected));
+}
+
+void test_memory_records_batch(void)
+{
+    uint8_t added = 0U;
+
+    hdc_tlm_begin(&s_frame, HDC_TLM_MEMORY);
+    TEST_ASSERT_EQUAL(HDC_TLM_ERROR_TYPE, hdc_tlm_add_result(&s_frame, 0U, 0U));
+    TEST_ASSERT_EQUAL(HDC_TLM_OK, hdc_tlm_add_memory(&s_frame, HDC_TLM_MEM_BSS, 0x0123U, 0U));
+    TEST_ASSERT_EQUAL(HDC_TLM_OK, hdc_tlm_add_memory(&s_frame, HDC_TLM_MEM_STACK, 0x01A0U, 0x0456U));
+    added = 2U;
+    while (hdc_tlm_add_memory(&s_frame, HDC_TLM_MEM_DATA, 0U, 0U) == HDC_TLM_OK) {
+        added++;
+    }
+    TEST_ASSERT_EQUAL_UINT8(HDC_TLM_MAX_PAYLOAD / HDC_TLM_MEMORY_BYTES, added);
+    (void)hdc_tlm_finish(&s_frame);
+
+    const uint8_t expected[] = {HDC_TLM_SYNC, HDC_TLM_MEMORY, added * HDC_TLM_MEMORY_BYTES,
+                                (uint8_t)HDC_TLM_MEM_BSS, 0x23U, 0x01U, 0x00U, 0x00U,
+                                (uint8_t)HDC_TLM_MEM_STACK, 0xA0U, 0x01U, 0x56U, 0x04U};
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, s_frame.bytes, sizeof(expected));
+}
+
+/* ============================================================================
+ * Hypervector Tests
+ * ============================================================================ */
+
+void test_hv_fragments_reassemble(void)
+{
+    hv_t hv, rebuilt;
+    uint16_t offset = 0U;
+    uint16_t frames = 0U;
+
+    for (hdc_index_t i = 0U; i < HV_BYTES; i++) {
+        hv[i] = (uint8_t)((i * 37U) ^ 0xC3U);
+    }
+    hdc_clear(rebuilt);
+
+    while (offset < HV_BYTES) {
+        uint16_t next = hdc_tlm_hv_fragment(&s_frame, hv, offset);
+        uint8_t length = hdc_tlm_finish(&s_frame);
+        const uint8_t* payload = &s_frame.bytes[HDC_TLM_HEADER_BYTES];
+
+        TEST_ASSERT_EQUAL_HEX8(HDC_TLM_HV, s_frame.bytes[1]);
+        TEST_ASSERT_TRUE(length <= HDC_TLM_FRAME_MAX);
+        TEST_ASSERT_EQUAL_HEX8(frame_crc(s_frame.bytes, length), s_frame.bytes[length - 1U]);
+
+        uint16_t frag_offset = (uint16_t)(payload[0] | ((uint16_t)payload[1] << 8));
+        TEST_ASSERT_EQUAL_UINT16(offset, frag_offset);
+        memcpy(&rebuilt[frag_offset], &payload[2], (size_t)(s_frame.len - 2U));
+
+        TEST_ASSERT_TRUE(next > offset);
+        offset = next;
+        frames++;
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(HV_BYTES, offset);
+    TEST_ASSERT_EQUAL_UINT16(
+        (HV_BYTES + (HDC_TLM_MAX_PAYLOAD - HDC_TLM_HV_HEADER_BYTES) - 1U) /
+        (HDC_TLM_MAX_PAYLOAD - HDC_TLM_HV_HEADER_BYTES), frames);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(hv, rebuilt, HV_BYTES);
+}
+
+void test_snapshot_fragments_reassemble(void)
+{
+    hdc_counter_t counter;
+    hdc_counter_t rebuilt;
+    const uint8_t* image = (const uint8_t*)&counter;
+    uint16_t size = HDC_TLM_SNAPSHOT_BYTES(HDC_COUNTER_PLANES);
+    uint16_t offset = 0U;
+
+    TEST_ASSERT_EQUAL_UINT16(sizeof(counter), size);
+    TEST_ASSERT_EQUAL_UINT16(HV_BYTES, HDC_TLM_SNAPSHOT_BYTES(0U));
+    for (uint16_t i = 0U; i < size; i++) {
+        ((uint8_t*)&counter)[i] = (uint8_t)((i * 53U) ^ 0x5AU);
+    }
+    memset(&rebuilt, 0, sizeof(rebuilt));
+
+    while (offset < size) {
+        uint16_t next = hdc_tlm_snapshot_fragment(&s_frame, 7U, HDC_COUNTER_PLANES, image, offset);
+        uint8_t length = hdc_tlm_finish(&s_frame);
+        const uint8_t* payload = &s_frame.bytes[HDC_TLM_HEADER_BYTES];
+
+        TEST_ASSERT_EQUAL_HEX8(HDC_TLM_SNAPSHOT, s_frame.bytes[1]);
+        TEST_ASSERT_TRUE(length <= HDC_TLM_FRAME_MAX);
+        TEST_ASSERT_EQUAL_HEX8(frame_crc(s_frame.bytes, length), s_frame.bytes[length - 1U]);
+        TEST_ASSERT_EQUAL_UINT8(7U, payload[0]);
+        TEST_ASSERT_EQUAL_UINT8(HDC_COUNTER_PLANES, payload[1]);
+
+        uint16_t frag_offset = (uint16_t)(payload[2] | ((uint16_t)payload[3] << 8));
+        TEST_ASSERT_EQUAL_UINT16(offset, frag_offset);
+        memcpy(&((uint8_t*)&rebuilt)[frag_offset], &payload[HDC_TLM_SNAPSHOT_HEADER_BYTES],
+               (size_t)(s_frame.len - HDC_TLM_SNAPSHOT_HEADER_BYTES));
+
+        TEST_ASSERT_TRUE(next > offset);
+        offset = next;
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(size, offset);
+    TEST_ASSERT_EQUAL_MEMORY(&counter, &rebuilt, sizeof(counter));
+}
+
+/* ============================================================================
+ * Main Test Runner
+ * ============================================================================ */
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    /* CRC tests */
+    RUN_TEST(test_crc8_check_value);
+
+    /* Framing tests */
+    RUN_TEST(test_empty_frame_layout);
+    RUN_TEST(test_crc_detects_corruption);
+
+    /* Record tests */
+    RUN_TEST(test_sample_records_are_little_endian);
+    RUN_TEST(test_sample_batch_fills_frame);
+    RUN_TEST(test_result_records_and_type_check);
+    RUN_TEST(test_probe_record_layout);
+    RUN_TEST(test_memory_records_batch);
+
+    /* Hypervector tests */
+    RUN_TEST(test_hv_fragments_reassemble);
+    RUN_TEST(test_snapshot_fragments_reassemble);
+
+    return UNITY_END();
+}
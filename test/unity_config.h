@@ -49,7 +49,9 @@
  * ========================================================================== */
 
 #include <stdint.h>  /* Fixed-width integer types (project standard) */
+#if !defined(__AVR__)
 #include <stdio.h>   /* printf/putchar for test output */
+#endif
 
 /* =============================================================================
  * Output Configuration
@@ -59,11 +61,17 @@
  * @brief Direct test output to stdout
  * @note  Required for Unity to display test results in terminal
  *
- * On the actual ATmega328P target, we would redirect to UART.
+ * On the ATmega328P target (env:bench_uno) output goes to the UART through
+ * unity_output_char(), which the on-target test provides.
  * For native PC testing, stdout is appropriate.
  */
+#if defined(__AVR__)
+#define UNITY_OUTPUT_CHAR(c)    unity_output_char(c)
+#define UNITY_OUTPUT_CHAR_HEADER_DECLARATION unity_output_char(int c)
+#else
 #define UNITY_OUTPUT_CHAR(c)    putchar(c)
 #define UNITY_OUTPUT_FLUSH()    fflush(stdout)
+#endif
 
 /* =============================================================================
  * Integer Width Configuration
@@ -73,26 +81,34 @@
  * @brief Configure Unity's integer handling for our test environment
  *
  * RATIONALE: Our HDC code uses fixed-width types exclusively:
- *   - hv_t        = uint8_t[16]   (128-bit hypervector)
- *   - ADC values  = uint16_t      (0-1023)
- *   - Distances   = uint8_t       (0-128)
+ *   - hv_t        = uint8_t[HV_BYTES]  (128-bit hypervector by default)
+ *   - ADC values  = uint16_t           (0-1023)
+ *   - Distances   = hdc_dist_t         (uint8_t, uint16_t above 255 dims)
  *
  * Unity's TEST_ASSERT_EQUAL_UINT8/16/32 macros work correctly regardless
  * of these settings. These widths configure Unity's internal handling
  * of generic integer comparisons (TEST_ASSERT_EQUAL_INT, etc.).
  *
- * We match the native PC platform (x86_64 Linux):
+ * We match the platform being built for:
  */
+#if defined(__AVR__)
+#define UNITY_INT_WIDTH         16  /* sizeof(int) * 8 on ATmega328P */
+#define UNITY_LONG_WIDTH        32  /* sizeof(long) * 8 on ATmega328P */
+#define UNITY_POINTER_WIDTH     16  /* sizeof(void*) * 8 on ATmega328P */
+#else
 #define UNITY_INT_WIDTH         32  /* sizeof(int) * 8 on x86_64 */
 #define UNITY_LONG_WIDTH        64  /* sizeof(long) * 8 on x86_64 */
 #define UNITY_POINTER_WIDTH     64  /* sizeof(void*) * 8 on x86_64 */
+#endif
 
 /**
  * @brief Enable 64-bit integer support in Unity
  * @note  Not used by our HDC code (max is uint32_t), but allows
  *        Unity's full assertion library to function correctly
  */
+#if !defined(__AVR__)
 #define UNITY_SUPPORT_64
+#endif
 
 /* =============================================================================
  * Feature Configuration